@@ -1,7 +1,7 @@
 /**
  * MIT License
  *
- * @brief Shared config and backends for LEDC/MCPWM rotation demo:
+ * @brief Shared config and backend bindings for LEDC/MCPWM rotation demo:
  *        hold 20% duty, then 75% duty for a clear visual/thermal compare.
  *
  * @file MCPWM_Test_Rotation.h
@@ -14,8 +14,9 @@
 #include <Arduino.h>
 #include <cstdint>
 #include <cmath>
-#include <driver/mcpwm.h>
-#include <ESP32_MCPWM.h>
+// Shared with the car: MotorBackend.h lives in #7_Buttons_Fixed_Forever_v2.0/Project/include (one copy for both
+// trees). Put that directory on the include path, e.g. PlatformIO build_flags = -I ../../../#7_Buttons_Fixed_Forever_v2.0/Project/include.
+#include <MotorBackend.h>
 
 // ---------------- Pins (IBT-2 / BTS7960) ----------------
 constexpr int RPWM_PIN = 37; ///< IBT-2 RPWM pin.
@@ -24,8 +25,9 @@ constexpr int EN_PIN = 39;   ///< IBT-2 EN pin;
 
 // ---------------- Common PWM config ----------------
 constexpr uint32_t PWM_FREQ_HZ = 20000; ///< Quiet 20 kHz.
-constexpr int LEDC_BITS = 10;           ///< LEDC resolution (0..1023).
-constexpr int LEDC_CH_R = 0;            ///< LEDC channel for RPWM.
+constexpr uint8_t LEDC_BITS = 10;       ///< LEDC resolution (0..1023).
+constexpr uint8_t LEDC_CH_R = 0;        ///< LEDC channel for RPWM.
+constexpr uint8_t LEDC_CH_L = 1;        ///< LEDC channel for LPWM (held at 0).
 
 // ---------------- Rotation test config ----------------
 constexpr float LOW_DUTY_PCT = 20.0f;      ///< First hold (%).
@@ -35,174 +37,50 @@ constexpr uint32_t HOLD_HIGH_MS = 30000;   ///< Hold time at HIGH (%).
 constexpr uint32_t COAST_GAP_MS = 2000;    ///< Small settling coast between holds.
 constexpr float MIN_EFFECTIVE_LEDC = 0.0f; ///< Keep if your rig needs a floor.
 
-// ---------------- Tiny helpers ----------------
-static inline float clampPct(float p)
-{
-    return (p < 0.0f) ? 0.0f : ((p > 100.0f) ? 100.0f : p);
-}
-static inline uint32_t pctToDuty10(float pct)
-{
-    pct = clampPct(pct);
-    const uint32_t maxDuty = (1u << LEDC_BITS) - 1u;
-    return static_cast<uint32_t>(std::lroundf((pct * static_cast<float>(maxDuty)) / 100.0f));
-}
-
-// ===================================================================
-//                       Backend interface
-// ===================================================================
-struct Backend
-{
-    const char *label;           ///< "LEDC" or "MCPWM"
-    void (*begin)();             ///< Initialize/enable outputs
-    void (*drivePct)(float pct); ///< Drive with duty % (0..100)
-    void (*end)();               ///< Disable/release outputs
-};
-
 // ===================================================================
-//                       LEDC backend (RPWM-only)
+//                    Backends (MotorBackend.h, shared)
 // ===================================================================
-namespace LEDC
+static inline motor::Config rigConfig()
 {
-    static void begin()
-    {
-        if (EN_PIN >= 0)
-        {
-            pinMode(EN_PIN, OUTPUT);
-            digitalWrite(EN_PIN, LOW); ///< Open initially.
-        }
-        pinMode(LPWM_PIN, OUTPUT);
-        digitalWrite(LPWM_PIN, LOW); ///< Other leg LOW.
-
-        ledcSetup(LEDC_CH_R, PWM_FREQ_HZ, LEDC_BITS);
-        ledcAttachPin(RPWM_PIN, LEDC_CH_R);
-        ledcWrite(LEDC_CH_R, 0);
-
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, HIGH); ///< Enable bridge.
-    }
-
-    static void drivePct(float pct)
-    {
-        pct = clampPct(pct);
-        if (pct < MIN_EFFECTIVE_LEDC)
-            pct = MIN_EFFECTIVE_LEDC;
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, HIGH);
-        digitalWrite(LPWM_PIN, LOW);
-        ledcWrite(LEDC_CH_R, pctToDuty10(pct));
-    }
-
-    static void end()
-    {
-        ledcWrite(LEDC_CH_R, 0);
-        digitalWrite(LPWM_PIN, LOW);
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, LOW);
-        ledcDetachPin(RPWM_PIN);
-        pinMode(RPWM_PIN, INPUT);
-        pinMode(LPWM_PIN, INPUT);
-        delay(50);
-    }
-} // namespace LEDC
-
-// ===================================================================
-//                       MCPWM backend (library)
-// ===================================================================
-namespace MCPWM
-{
-    static Motor motor; ///< ESP32_MCPWM library motor instance.
-    static bool inited = false;
-
-    static void initOnce()
-    {
-        MotorMCPWMConfig hw{
-            /* lpwm_pin      */ LPWM_PIN,
-            /* rpwm_pin      */ RPWM_PIN,
-            /* en_pin        */ EN_PIN,
-            /* unit          */ MCPWM_UNIT_0,
-            /* timer         */ MCPWM_TIMER_0,
-            /* pwm_sig_left  */ MCPWM0A,
-            /* pwm_sig_right */ MCPWM0B};
-        hw.pwm_freq_hz = PWM_FREQ_HZ;
-        hw.input_max = (1 << LEDC_BITS) - 1;
-        hw.counter = MCPWM_UP_DOWN_COUNTER; ///< Center-aligned.
-        hw.use_deadtime = false;            ///< IBT-2 handles internally.
-
-        MotorBehaviorConfig beh{
-            FreewheelMode::HiZ, /* soft_brake_hz     */ 300,
-            /* dither_pwm        */ 0,
-            /* default_soft      */ 0,
-            /* min_phase_us      */ 1000,
-            /* dither_coast_hi_z */ true};
-
-        // Ensure pins are routed (esp. if LEDC ran first).
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0A, LPWM_PIN);
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0B, RPWM_PIN);
-
-        motor.setup(hw, beh);
-        inited = true;
-    }
-
-    static void begin()
-    {
-        if (!inited)
-            initOnce();
-
-        if (EN_PIN >= 0)
-        {
-            pinMode(EN_PIN, OUTPUT);
-            digitalWrite(EN_PIN, LOW); ///< Disabled initially.
-        }
-
-        // Re-bind pins each phase.
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0A, LPWM_PIN);
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0B, RPWM_PIN);
-
-        motor.start();
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, HIGH);
-    }
-
-    static void drivePct(float pct)
-    {
-        motor.setSpeedPercent(clampPct(pct), Dir::CCW);
-    }
+    motor::Config c{};
+    c.rpwm_pin = RPWM_PIN;
+    c.lpwm_pin = LPWM_PIN;
+    c.en_pin = EN_PIN;
+    c.pwm_hz = PWM_FREQ_HZ;
+    c.min_pct = MIN_EFFECTIVE_LEDC;
+    c.ledc_ch_r = LEDC_CH_R;
+    c.ledc_ch_l = LEDC_CH_L;
+    return c;
+}
 
-    static void end()
-    {
-        motor.applyFreewheel(FreewheelMode::HiZ);
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, LOW);
-        pinMode(RPWM_PIN, INPUT);
-        pinMode(LPWM_PIN, INPUT);
-        delay(50);
-    }
-} // namespace MCPWM
+using LedcRig = motor::LedcBackend<LEDC_BITS>;                  ///< Both legs on LEDC.
+using McpwmRig = motor::McpwmBackend<motor::Alignment::Center>; ///< Center-aligned; IBT-2 handles deadtime.
 
 // ===================================================================
 //             Demo runner: 20% hold -> coast -> 75% hold
 // ===================================================================
-static inline void runRotation(const Backend &b)
+template <typename B>
+static inline void runRotation(B &b)
 {
     Serial.printf("[%s] Hold %.1f%% for %u ms\n",
-                  b.label, LOW_DUTY_PCT, (unsigned)HOLD_LOW_MS);
-    b.drivePct(LOW_DUTY_PCT);
+                  B::kLabel, LOW_DUTY_PCT, (unsigned)HOLD_LOW_MS);
+    b.drive(LOW_DUTY_PCT, Dir::CCW);
     delay(HOLD_LOW_MS);
 
     // Brief coast/settle to make the step visually obvious on camera/scope.
-    b.drivePct(0.0f);
+    b.coast();
     delay(COAST_GAP_MS);
 
     Serial.printf("[%s] Hold %.1f%% for %u ms\n",
-                  b.label, HIGH_DUTY_PCT, (unsigned)HOLD_HIGH_MS);
-    b.drivePct(HIGH_DUTY_PCT);
+                  B::kLabel, HIGH_DUTY_PCT, (unsigned)HOLD_HIGH_MS);
+    b.drive(HIGH_DUTY_PCT, Dir::CCW);
     delay(HOLD_HIGH_MS);
 
     // finish coasting
-    b.drivePct(0.0f);
+    b.coast();
     delay(COAST_GAP_MS);
 }
 
 // Expose ready-made backends
-static Backend LEDC_BACKEND{"LEDC", &LEDC::begin, &LEDC::drivePct, &LEDC::end};
-static Backend MCPWM_BACKEND{"MCPWM", &MCPWM::begin, &MCPWM::drivePct, &MCPWM::end};
\ No newline at end of file
+static LedcRig LEDC_BACKEND{rigConfig()};
+static McpwmRig MCPWM_BACKEND{rigConfig()};
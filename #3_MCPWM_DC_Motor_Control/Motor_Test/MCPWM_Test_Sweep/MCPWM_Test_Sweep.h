@@ -1,7 +1,7 @@
 /**
  * MIT License
  *
- * @brief Shared configuration and backends for LEDC/MCPWM sweep demo.
+ * @brief Shared configuration and backend bindings for LEDC/MCPWM sweep demo.
  *
  * @file MCPWM_Test_Sweep.h
  * @author Little Man Builds (Darren Osborne)
@@ -14,8 +14,9 @@
 #include <Arduino.h>
 #include <cstdint>
 #include <cmath>
-#include <driver/mcpwm.h>
-#include <ESP32_MCPWM.h>
+// Shared with the car: MotorBackend.h lives in #7_Buttons_Fixed_Forever_v2.0/Project/include (one copy for both
+// trees). Put that directory on the include path, e.g. PlatformIO build_flags = -I ../../../#7_Buttons_Fixed_Forever_v2.0/Project/include.
+#include <MotorBackend.h>
 
 // ---------------- Pins (IBT-2 / BTS7960) ----------------
 constexpr int RPWM_PIN = 37; ///< IBT-2 RPWM pin.
@@ -24,8 +25,9 @@ constexpr int EN_PIN = 39;   ///< IBT-2 EN pin.
 
 // ---------------- Common PWM config ----------------
 constexpr uint32_t PWM_FREQ_HZ = 20000; ///< PWM frequency (Hz), quiet.
-constexpr int LEDC_BITS = 10;           ///< LEDC resolution bits (0..1023).
-constexpr int LEDC_CH_R = 0;            ///< LEDC channel used for RPWM only.
+constexpr uint8_t LEDC_BITS = 10;       ///< LEDC resolution bits (0..1023).
+constexpr uint8_t LEDC_CH_R = 0;        ///< LEDC channel on RPWM (driven leg).
+constexpr uint8_t LEDC_CH_L = 1;        ///< LEDC channel on LPWM (held at 0).
 
 // ---------------- Sweep config (unchanged behavior) ----------------
 constexpr float SWEEP_START_PCT = 11.0f;   ///< Start duty for sweep (%).
@@ -35,229 +37,336 @@ constexpr float SWEEP_HOLD_PCT = 11.0f;    ///< Low value to hold at end (%).
 constexpr uint32_t SWEEP_HOLD_MS = 1500;   ///< Hold time at each step (ms).
 constexpr float MIN_EFFECTIVE_LEDC = 0.0f; ///< Minimum LEDC duty to overcome stiction (%).
 
-// ---------------- Tiny helpers ----------------
+// ---------------- Grid mode (frequency × resolution × counter × deadtime) ----------------
+constexpr bool GRID_MODE = false;                                 ///< Run the parameter grid once instead of the LEDC/MCPWM loop.
+constexpr int TACH_PIN = -1;                                      ///< Encoder / tach input (rising edges); -1 → no stiction or response data.
+constexpr uint32_t GRID_FREQS_HZ[] = {5000, 10000, 20000, 30000}; ///< Carrier frequencies to test.
+constexpr float STICTION_START_PCT = 2.0f;                        ///< First duty tried for breakaway (%).
+constexpr float STICTION_MAX_PCT = 40.0f;                         ///< Give up above this (%).
+constexpr float STICTION_STEP_PCT = 0.5f;                         ///< Breakaway / min-run step (%).
+constexpr uint32_t STICTION_DWELL_MS = 400;                       ///< Dwell per step (ms).
+constexpr uint32_t MOTION_MIN_PULSES = 3;                         ///< Pulses per dwell that count as turning.
+constexpr float RESPONSE_PCT = 30.0f;                             ///< Step target for the response test (%).
+constexpr uint32_t RESPONSE_MS = 1500;                            ///< Response capture length (ms).
+constexpr uint32_t RESPONSE_WINDOW_MS = 20;                       ///< Rate window for the response curve (ms).
+constexpr uint32_t GRID_SETTLE_MS = 1500;                         ///< Coast between tests (motor stops).
+constexpr bool GRID_SWEEP = true;                                 ///< Also run the low-speed sweep at each point ("W," rows).
+constexpr uint32_t LEDC_APB_HZ = 80000000;                        ///< LEDC source clock: freq × 2^bits must fit.
+
+// ===================================================================
+//                    Backends (MotorBackend.h, shared)
+// ===================================================================
 
 /**
- * @brief Clamp a duty percentage to [0, 100].
+ * @brief Settings shared by both backends.
  *
- * @param p Percentage value.
- * @return float Clamped percentage within [0, 100].
+ * @return motor::Config IBT-2 pins, 20 kHz carrier and the LEDC floor.
  */
-static inline float clampPct(float p)
+static inline motor::Config rigConfig()
 {
-    return (p < 0.0f) ? 0.0f : ((p > 100.0f) ? 100.0f : p);
+    motor::Config c{};
+    c.rpwm_pin = RPWM_PIN;
+    c.lpwm_pin = LPWM_PIN;
+    c.en_pin = EN_PIN;
+    c.pwm_hz = PWM_FREQ_HZ;
+    c.min_pct = MIN_EFFECTIVE_LEDC;
+    c.ledc_ch_r = LEDC_CH_R;
+    c.ledc_ch_l = LEDC_CH_L;
+    return c;
 }
 
+using LedcRig = motor::LedcBackend<LEDC_BITS>;                  ///< Both legs on LEDC.
+using McpwmRig = motor::McpwmBackend<motor::Alignment::Center>; ///< Center-aligned; IBT-2 handles deadtime.
+
+// ===================================================================
+//                           Demo runner
+// ===================================================================
+
 /**
- * @brief Convert a percentage (0..100) to LEDC duty for the configured resolution.
+ * @brief Perform a low-speed up/down duty sweep and hold a tricky low value.
  *
- * @param pct Duty percentage.
- * @return uint32_t Duty value in range [0, (1<<LEDC_BITS)-1].
+ * @tparam B Motor backend (motor::LedcBackend / motor::McpwmBackend).
+ * @param b Started backend (begin() already called).
  */
-static inline uint32_t pctToDuty10(float pct)
+template <typename B>
+static inline void runSweep(B &b)
 {
-    pct = clampPct(pct);
-    const uint32_t maxDuty = (1u << LEDC_BITS) - 1u;
-    return static_cast<uint32_t>(std::lroundf((pct * static_cast<float>(maxDuty)) / 100.0f));
+    Serial.printf("[%s] Low-speed sweep %.1f%% → %.1f%% → %.1f%%\n",
+                  B::kLabel, SWEEP_START_PCT, SWEEP_STOP_PCT, SWEEP_START_PCT);
+
+    // Up
+    for (float p = SWEEP_START_PCT; p <= SWEEP_STOP_PCT + 0.001f; p += SWEEP_STEP_PCT)
+    {
+        b.drive(p, Dir::CCW);
+        Serial.printf("[%s] Duty = %.1f%%\n", B::kLabel, p);
+        delay(SWEEP_HOLD_MS);
+    }
+    // Down
+    for (float p = SWEEP_STOP_PCT; p >= SWEEP_START_PCT - 0.001f; p -= SWEEP_STEP_PCT)
+    {
+        b.drive(p, Dir::CCW);
+        Serial.printf("[%s] Duty = %.1f%%\n", B::kLabel, p);
+        delay(SWEEP_HOLD_MS);
+    }
+
+    // Hold tricky low value (5s)
+    b.drive(SWEEP_HOLD_PCT, Dir::CCW);
+    Serial.printf("[%s] Hold = %.1f%% (5s)\n", B::kLabel, SWEEP_HOLD_PCT);
+    delay(5000);
 }
 
+// ---------------- Ready-made backends ----------------
+
+static LedcRig LEDC_BACKEND{rigConfig()};   ///< LEDC phase.
+static McpwmRig MCPWM_BACKEND{rigConfig()}; ///< MCPWM phase.
+
 // ===================================================================
-//                       Backend interface
+//                     Grid runner (GRID_MODE)
 // ===================================================================
+//
+// For every GRID_FREQS_HZ entry, each backend type in the grid runs:
+//   stiction  → breakaway duty (first step that turns), min-run duty (lowest that keeps turning)
+//   response  → coast → RESPONSE_PCT: first edge and 90 %-of-steady-rate times
+//   sweep     → runSweep's duty steps, edges per second at each ("W," rows)
+// One "G," CSV row per point:
+//   G,backend,hz,bits,counter,deadtime,breakaway_pct,min_run_pct,first_ms,t90_ms,steady_pps
+// The lowest breakaway / min-run across the grid is the duty floor to use for
+// MIN_EFFECTIVE_LEDC (or motor::Config::min_pct) on this motor.
+
+/// @brief CSV description of a grid point's backend type.
+template <typename B>
+struct PointInfo;
+
+/// @brief LEDC: resolution is the template parameter; always up-counting, no deadtime.
+template <uint8_t Bits>
+struct PointInfo<motor::LedcBackend<Bits>>
+{
+    static constexpr uint8_t bits = Bits;        ///< Duty resolution.
+    static constexpr const char *counter = "up"; ///< Counter mode.
+    static constexpr bool deadtime = false;      ///< Deadtime insertion.
+};
 
-/**
- * @brief Simple backend interface used by the sweep runner.
- *
- * Each backend binds a begin/drive/end triplet to a label for logging.
- */
-struct Backend
+/// @brief MCPWM: resolution follows the timer clock and frequency (reported as 0).
+template <motor::Alignment Align, bool Deadtime>
+struct PointInfo<motor::McpwmBackend<Align, Deadtime>>
 {
-    const char *label;       ///< Text label for logging (e.g., "LEDC", "MCPWM").
-    void (*begin)();         ///< Initialize and enable outputs.
-    void (*drivePct)(float); ///< Drive with a percentage duty (0..100).
-    void (*end)();           ///< Disable outputs and release pins.
+    static constexpr uint8_t bits = 0;                                                            ///< Not selectable.
+    static constexpr const char *counter = (Align == motor::Alignment::Center) ? "updown" : "up"; ///< Counter mode.
+    static constexpr bool deadtime = Deadtime;                                                    ///< Deadtime insertion.
 };
 
-// ===================================================================
-//                       LEDC backend (RPWM-only)
-// ===================================================================
-namespace LEDC
+namespace grid
 {
-    /** @brief Initialize LEDC channel and enable the bridge. */
-    static void begin()
-    {
-        if (EN_PIN >= 0)
-        {
-            pinMode(EN_PIN, OUTPUT);
-            digitalWrite(EN_PIN, LOW); ///< Open-circuit initially.
-        }
-        pinMode(LPWM_PIN, OUTPUT);
-        digitalWrite(LPWM_PIN, LOW); ///< Other leg LOW.
+    static volatile uint32_t pulses = 0; ///< Tach edges (ISR).
 
-        ledcSetup(LEDC_CH_R, PWM_FREQ_HZ, LEDC_BITS);
-        ledcAttachPin(RPWM_PIN, LEDC_CH_R);
-        ledcWrite(LEDC_CH_R, 0);
+    /** @brief Tach edge ISR. */
+    static void IRAM_ATTR onTach() { pulses = pulses + 1; }
 
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, HIGH); ///< Enable bridge.
+    /** @brief Attach the tach input once. */
+    static inline void beginTach()
+    {
+        static bool attached = false;
+        if (TACH_PIN < 0 || attached)
+            return;
+        pinMode(TACH_PIN, INPUT_PULLUP);
+        attachInterrupt(digitalPinToInterrupt(TACH_PIN), onTach, RISING);
+        attached = true;
     }
 
     /**
-     * @brief Drive LEDC RPWM with a duty percentage.
+     * @brief Edges counted while holding a duty.
      *
-     * @param pct Duty percentage (0..100). Clamped internally.
+     * @param b Backend.
+     * @param pct Duty (%).
+     * @param ms Hold time (ms).
+     * @return uint32_t Edges during the hold.
      */
-    static void drivePct(float pct)
+    template <typename B>
+    static uint32_t edgesAt(B &b, float pct, uint32_t ms)
     {
-        pct = clampPct(pct);
-        if (pct < MIN_EFFECTIVE_LEDC)
-            pct = MIN_EFFECTIVE_LEDC;
-
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, HIGH);
-
-        digitalWrite(LPWM_PIN, LOW); ///< Keep other leg solid LOW.
-        ledcWrite(LEDC_CH_R, pctToDuty10(pct));
+        b.drive(pct, Dir::CCW);
+        const uint32_t start = pulses;
+        delay(ms);
+        return pulses - start;
     }
 
-    /** @brief Disable LEDC outputs and release pins. */
-    static void end()
+    /// @brief Result of one grid point.
+    struct Result
     {
-        ledcWrite(LEDC_CH_R, 0);
-        digitalWrite(LPWM_PIN, LOW);
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, LOW); ///< Hi-Z/open.
-
-        ledcDetachPin(RPWM_PIN);
-        pinMode(RPWM_PIN, INPUT);
-        pinMode(LPWM_PIN, INPUT);
-        delay(50);
-    }
-} // namespace LEDC
-
-// ===================================================================
-//                     MCPWM backend (Library)
-// ===================================================================
-namespace MCPWM
-{
-    static Motor motor;         ///< Motor instance provided by ESP32_MCPWM library.
-    static bool inited = false; ///< True once the backend is configured.
-
-    /** @brief One-time MCPWM configuration and pin routing. */
-    static void initOnce()
+        float breakaway_pct{NAN}; ///< First duty that turns.
+        float min_run_pct{NAN};   ///< Lowest duty that keeps turning.
+        float first_ms{NAN};      ///< Step → first edge.
+        float t90_ms{NAN};        ///< Step → 90 % of steady rate.
+        float steady_pps{NAN};    ///< Rate over the last quarter of the capture.
+    };
+
+    /** @brief Breakaway going up, then min-run coming back down. */
+    template <typename B>
+    static void stiction(B &b, Result &r)
     {
-        MotorMCPWMConfig hw{
-            /* lpwm_pin      */ LPWM_PIN,
-            /* rpwm_pin      */ RPWM_PIN,
-            /* en_pin        */ EN_PIN,
-            /* unit          */ MCPWM_UNIT_0,
-            /* timer         */ MCPWM_TIMER_0,
-            /* pwm_sig_left  */ MCPWM0A,
-            /* pwm_sig_right */ MCPWM0B};
-        hw.pwm_freq_hz = PWM_FREQ_HZ;
-        hw.input_max = (1 << LEDC_BITS) - 1;
-        hw.counter = MCPWM_UP_DOWN_COUNTER; ///< Center-aligned.
-        hw.use_deadtime = false;            ///< IBT-2 handles this internally.
-
-        MotorBehaviorConfig beh{
-            FreewheelMode::HiZ, // true coast (EN low)
-            /* soft_brake_hz     */ 300,
-            /* dither_pwm        */ 0,
-            /* default_soft      */ 0,
-            /* min_phase_us      */ 1000,
-            /* dither_coast_hi_z */ true};
-
-        // Route pins (re-assert ownership if LEDC ran first).
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0A, LPWM_PIN);
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0B, RPWM_PIN);
-
-        motor.setup(hw, beh);
-        inited = true;
+        float p = STICTION_START_PCT;
+        for (; p <= STICTION_MAX_PCT + 0.001f; p += STICTION_STEP_PCT)
+            if (edgesAt(b, p, STICTION_DWELL_MS) >= MOTION_MIN_PULSES)
+                break;
+        if (p > STICTION_MAX_PCT + 0.001f)
+            return;
+        r.breakaway_pct = p;
+
+        float last = p;
+        for (p -= STICTION_STEP_PCT; p > 0.0f; p -= STICTION_STEP_PCT)
+        {
+            if (edgesAt(b, p, STICTION_DWELL_MS) < MOTION_MIN_PULSES)
+                break;
+            last = p;
+        }
+        r.min_run_pct = last;
     }
 
-    /** @brief Initialize (once) and start MCPWM outputs. */
-    static void begin()
+    /** @brief Step from standstill and time the edge-rate rise. */
+    template <typename B>
+    static void response(B &b, Result &r)
     {
-        if (!inited)
-            initOnce();
-
-        if (EN_PIN >= 0)
+        constexpr uint32_t kWindows = RESPONSE_MS / RESPONSE_WINDOW_MS;
+        uint32_t counts[kWindows] = {};
+
+        const uint32_t p0 = pulses;
+        const uint32_t t0 = micros();
+        b.drive(RESPONSE_PCT, Dir::CCW);
+        uint32_t prev = p0;
+        for (uint32_t w = 0; w < kWindows; ++w)
         {
-            pinMode(EN_PIN, OUTPUT);
-            digitalWrite(EN_PIN, LOW); ///< Disabled initially.
+            const uint32_t until = (w + 1) * RESPONSE_WINDOW_MS * 1000U;
+            while (micros() - t0 < until)
+            {
+                if (std::isnan(r.first_ms) && pulses != p0)
+                    r.first_ms = (micros() - t0) / 1000.0f;
+            }
+            const uint32_t now = pulses;
+            counts[w] = now - prev;
+            prev = now;
         }
 
-        // Re-bind pins each phase in case LEDC ran first.
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0A, LPWM_PIN);
-        mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM0B, RPWM_PIN);
+        uint32_t tail = 0;
+        for (uint32_t w = kWindows - kWindows / 4; w < kWindows; ++w)
+            tail += counts[w];
+        const float tail_windows = static_cast<float>(kWindows / 4);
+        if (tail == 0 || tail_windows <= 0.0f)
+            return;
+        r.steady_pps = tail * 1000.0f / (tail_windows * RESPONSE_WINDOW_MS);
+        const float target = 0.9f * static_cast<float>(tail) / tail_windows;
+        for (uint32_t w = 0; w < kWindows; ++w)
+            if (counts[w] >= target)
+            {
+                r.t90_ms = static_cast<float>((w + 1) * RESPONSE_WINDOW_MS);
+                break;
+            }
+    }
 
-        motor.start();
+    /** @brief runSweep's duty steps with the edge rate at each. */
+    template <typename B>
+    static void sweep(B &b, uint32_t hz)
+    {
+        auto step = [&](float p) {
+            const uint32_t n = edgesAt(b, p, SWEEP_HOLD_MS);
+            Serial.printf("W,%s,%u,%u,%s,%d,%.1f,%.1f\n", B::kLabel, static_cast<unsigned>(hz),
+                          static_cast<unsigned>(PointInfo<B>::bits), PointInfo<B>::counter, PointInfo<B>::deadtime ? 1 : 0, p,
+                          n * 1000.0f / SWEEP_HOLD_MS);
+        };
+        for (float p = SWEEP_START_PCT; p <= SWEEP_STOP_PCT + 0.001f; p += SWEEP_STEP_PCT)
+            step(p);
+        for (float p = SWEEP_STOP_PCT; p >= SWEEP_START_PCT - 0.001f; p -= SWEEP_STEP_PCT)
+            step(p);
+    }
 
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, HIGH); ///< Enable bridge.
+    /** @brief Print a float CSV field (empty for NAN). */
+    static inline void field(float v)
+    {
+        if (std::isnan(v))
+            Serial.print(",");
+        else
+            Serial.printf(",%.1f", v);
     }
 
     /**
-     * @brief Drive MCPWM with a duty percentage (Dir::CCW).
+     * @brief Run every test for one backend type at one frequency.
      *
-     * @param pct Duty percentage (0..100). Clamped internally.
+     * @tparam B Backend type (fresh instance per point).
+     * @param hz Carrier frequency.
      */
-    static void drivePct(float pct)
+    template <typename B>
+    static void runPoint(uint32_t hz)
     {
-        motor.setSpeedPercent(clampPct(pct), Dir::CCW);
-    }
+        using Info = PointInfo<B>;
+        Serial.printf("[%s] %u Hz, %u bits, %s, deadtime %s\n", B::kLabel, static_cast<unsigned>(hz),
+                      static_cast<unsigned>(Info::bits), Info::counter, Info::deadtime ? "on" : "off");
+        if (Info::bits > 0 && (static_cast<uint64_t>(hz) << Info::bits) > LEDC_APB_HZ)
+        {
+            Serial.printf("[%s] skipped: %u Hz × 2^%u exceeds the LEDC clock\n", B::kLabel, static_cast<unsigned>(hz),
+                          static_cast<unsigned>(Info::bits));
+            return;
+        }
 
-    /** @brief Coast outputs and release pins. */
-    static void end()
-    {
-        motor.applyFreewheel(FreewheelMode::HiZ);
-        if (EN_PIN >= 0)
-            digitalWrite(EN_PIN, LOW);
-        pinMode(RPWM_PIN, INPUT);
-        pinMode(LPWM_PIN, INPUT);
-        delay(50);
-    }
-} // namespace MCPWM
+        motor::Config c = rigConfig();
+        c.pwm_hz = hz;
+        c.min_pct = 0.0f; ///< Measuring the floor: no lift.
+        B b{c};
+        if (!b.begin())
+        {
+            Serial.printf("[%s] begin failed\n", B::kLabel);
+            return;
+        }
 
-// ===================================================================
-//                           Demo runner
-// ===================================================================
+        Result r{};
+        if (TACH_PIN >= 0)
+        {
+            stiction(b, r);
+            b.coast();
+            delay(GRID_SETTLE_MS);
+            response(b, r);
+            b.coast();
+            delay(GRID_SETTLE_MS);
+        }
+        if (GRID_SWEEP)
+        {
+            sweep(b, hz);
+            b.coast();
+        }
+        b.end();
+
+        Serial.printf("G,%s,%u,%u,%s,%d", B::kLabel, static_cast<unsigned>(hz), static_cast<unsigned>(Info::bits), Info::counter,
+                      Info::deadtime ? 1 : 0);
+        field(r.breakaway_pct);
+        field(r.min_run_pct);
+        field(r.first_ms);
+        field(r.t90_ms);
+        field(r.steady_pps);
+        Serial.println();
+        delay(GRID_SETTLE_MS);
+    }
+} // namespace grid
 
 /**
- * @brief Perform a low-speed up/down duty sweep and hold a tricky low value.
+ * @brief Run the grid: every frequency × every backend type in Bs.
  *
- * @param b Backend used to issue begin/drive/end calls.
+ * @tparam Bs Backend types (resolution, counter mode and deadtime are template parameters).
  */
-static inline void runSweep(const Backend &b)
+template <typename... Bs>
+static inline void runGrid()
 {
-    Serial.printf("[%s] Low-speed sweep %.1f%% → %.1f%% → %.1f%%\n",
-                  b.label, SWEEP_START_PCT, SWEEP_STOP_PCT, SWEEP_START_PCT);
-
-    // Up
-    for (float p = SWEEP_START_PCT; p <= SWEEP_STOP_PCT + 0.001f; p += SWEEP_STEP_PCT)
-    {
-        b.drivePct(p);
-        Serial.printf("[%s] Duty = %.1f%%\n", b.label, p);
-        delay(SWEEP_HOLD_MS);
-    }
-    // Down
-    for (float p = SWEEP_STOP_PCT; p >= SWEEP_START_PCT - 0.001f; p -= SWEEP_STEP_PCT)
-    {
-        b.drivePct(p);
-        Serial.printf("[%s] Duty = %.1f%%\n", b.label, p);
-        delay(SWEEP_HOLD_MS);
-    }
-
-    // Hold tricky low value (5s)
-    b.drivePct(SWEEP_HOLD_PCT);
-    Serial.printf("[%s] Hold = %.1f%% (5s)\n", b.label, SWEEP_HOLD_PCT);
-    delay(5000);
+    grid::beginTach();
+    if (TACH_PIN < 0)
+        Serial.println("[GRID] TACH_PIN not set: sweep only, no stiction / response data.");
+    Serial.println("H,backend,hz,bits,counter,deadtime,breakaway_pct,min_run_pct,first_ms,t90_ms,steady_pps");
+    Serial.println("HW,backend,hz,bits,counter,deadtime,duty_pct,pps");
+    for (const uint32_t hz : GRID_FREQS_HZ)
+        (grid::runPoint<Bs>(hz), ...);
 }
 
-// ---------------- Expose ready-made backends ----------------
-
-/** @brief Ready-made LEDC backend binding. */
-static Backend LEDC_BACKEND{"LEDC", &LEDC::begin, &LEDC::drivePct, &LEDC::end};
-
-/** @brief Ready-made MCPWM backend binding. */
-static Backend MCPWM_BACKEND{"MCPWM", &MCPWM::begin, &MCPWM::drivePct, &MCPWM::end};
\ No newline at end of file
+/** @brief Default grid: LEDC at 8/10/12 bits, MCPWM edge/center × deadtime off/on. */
+static inline void runDefaultGrid()
+{
+    using motor::Alignment;
+    runGrid<motor::LedcBackend<8>, motor::LedcBackend<10>, motor::LedcBackend<12>,
+            motor::McpwmBackend<Alignment::Edge, false>, motor::McpwmBackend<Alignment::Center, false>,
+            motor::McpwmBackend<Alignment::Edge, true>, motor::McpwmBackend<Alignment::Center, true>>();
+}
@@ -20,6 +20,14 @@ void setup()
 
 void loop()
 {
+  if (GRID_MODE)
+  {
+    runDefaultGrid();
+    Serial.println("Grid done.");
+    for (;;)
+      delay(1000);
+  }
+
   // -------- LEDC PHASE (First) --------
   Serial.println("PHASE: LEDC");
   LEDC_BACKEND.begin();
@@ -10,23 +10,78 @@
  */
 
 #include "MCPWM_Test_Temp.h"
+#include <soc/gpio_reg.h>
+#if CONFIG_IDF_TARGET_ESP32S3
+#include <AdcStream.h> ///< The car's ADC1 DMA stream (#7 Project/include, on the include path).
+#endif
 
 // =================== Local state (MCPWM) ===================
 namespace
 {
-    Motor mcpwmMotor;         ///< MCPWM motor instance (library-provided).
-    bool mcpwmInited = false; ///< True if MCPWM backend initialized.
+    Motor mcpwmMotor;                   ///< MCPWM motor instance (library-provided).
+    bool mcpwmInited = false;           ///< True if MCPWM backend initialized.
+    volatile bool faultLatched = false; ///< Set by the fault ISR (held for the rest of the run).
+
+    int vbusSlot = -1;                  ///< Stream slot for SUPPLY_ADC_PIN (-1 → one-shot reads).
+    int currentSlot = -1;               ///< Stream slot for CURRENT_ADC_PIN (-1 → one-shot reads).
+    int tempSlot = -1;                  ///< Stream slot for TEMP_ADC_PIN (-1 → one-shot reads).
+    volatile uint32_t streamMv[4] = {}; ///< Latest frame mean per slot (mV); aligned word stores.
+    volatile bool streamReady = false;  ///< At least one frame cached.
+#if CONFIG_IDF_TARGET_ESP32S3
+    AdcStream<16> adcStream;            ///< ADC1 DMA stream over the sense pins.
+#endif
 }
 
 // -------------------- ADC / Fault helpers --------------------
 
+#if CONFIG_IDF_TARGET_ESP32S3
+// Reader task: reduce each DMA frame and cache the means.
+static void adcStreamTask(void *)
+{
+    for (;;)
+    {
+        AdcStream<16>::Frame f{};
+        if (!adcStream.read(f, 20))
+            continue;
+        for (std::size_t s = 0; s < AdcStream<16>::kMaxChannels; ++s)
+            if (f.n[s] != 0)
+                streamMv[s] = f.mv[s];
+        streamReady = true;
+    }
+}
+#endif
+
+// Start the ADC DMA stream (S3) so the guard and bench never block on a conversion.
+bool startAdcStream()
+{
+#if CONFIG_IDF_TARGET_ESP32S3
+    vbusSlot = adcStream.add(SUPPLY_ADC_PIN);
+    currentSlot = adcStream.add(CURRENT_ADC_PIN);
+    tempSlot = adcStream.add(TEMP_ADC_PIN);
+    if (!adcStream.begin(ADC_STREAM_HZ))
+        return false;
+    xTaskCreatePinnedToCore(adcStreamTask, "adc", 2048, nullptr, 2, nullptr, 0);
+    return true;
+#else
+    return false; ///< Classic ESP32: one-shot reads only.
+#endif
+}
+
+// Latest mV for a sense pin: cached DMA frame if streamed, else a one-shot read.
+static uint32_t pinMilliVolts(int pin, int slot)
+{
+    if (slot >= 0 && streamReady)
+        return streamMv[slot];
+    return analogReadMilliVolts(pin);
+}
+
 // Read VBUS via ADC and divider.
 float readVbusVolts()
 {
     if (SUPPLY_ADC_PIN < 0)
         return -1.0f;
 #if CONFIG_IDF_TARGET_ESP32S3
-    const uint32_t mv = analogReadMilliVolts(SUPPLY_ADC_PIN);
+    const uint32_t mv = pinMilliVolts(SUPPLY_ADC_PIN, vbusSlot);
     return (static_cast<float>(mv) / 1000.0f) * VDIV_RATIO;
 #else
     const int raw = analogRead(SUPPLY_ADC_PIN);
@@ -35,11 +90,54 @@ float readVbusVolts()
 #endif
 }
 
+// Read bridge current via the sense ADC.
+float readCurrentAmps()
+{
+    if (CURRENT_ADC_PIN < 0)
+        return -1.0f;
+    const float v = static_cast<float>(pinMilliVolts(CURRENT_ADC_PIN, currentSlot)) / 1000.0f;
+    const float a = (v - CURRENT_OFFSET_V) / CURRENT_V_PER_A;
+    return (a < 0.0f) ? 0.0f : a;
+}
+
+// Read heatsink temperature from the NTC divider (beta equation).
+float readTempC()
+{
+    if (TEMP_ADC_PIN < 0)
+        return NAN;
+    constexpr float kVref = 3.3f;   ///< Divider supply (V).
+    constexpr float kT25 = 298.15f; ///< 25 °C in kelvin.
+    const float v = static_cast<float>(pinMilliVolts(TEMP_ADC_PIN, tempSlot)) / 1000.0f;
+    if (v <= 0.01f || v >= kVref - 0.01f)
+        return NAN; ///< Open / shorted sensor.
+    const float r = NTC_SERIES_OHMS * v / (kVref - v);
+    return 1.0f / (1.0f / kT25 + logf(r / NTC_R25_OHMS) / NTC_BETA) - 273.15f;
+}
+
+// Fault edge ISR: EN low straight from the interrupt, the slew loop coasts on its next tick.
+static void IRAM_ATTR onFaultISR()
+{
+    if (EN_PIN >= 0)
+        REG_WRITE(EN_PIN < 32 ? GPIO_OUT_W1TC_REG : GPIO_OUT1_W1TC_REG, 1UL << (EN_PIN % 32));
+    faultLatched = true;
+}
+
+// Arm the fault/E-STOP edge interrupt (optional).
+void armFaultIrq()
+{
+    if (FAULT_PIN < 0)
+        return;
+    pinMode(FAULT_PIN, FAULT_ACTIVE_LOW ? INPUT_PULLUP : INPUT_PULLDOWN);
+    attachInterrupt(digitalPinToInterrupt(FAULT_PIN), onFaultISR, FAULT_ACTIVE_LOW ? FALLING : RISING);
+}
+
 // Check fault/E-STOP input (optional).
 bool faultActive()
 {
     if (FAULT_PIN < 0)
         return false;
+    if (faultLatched)
+        return true; ///< An edge between ticks still counts after the pin releases.
     const int v = digitalRead(FAULT_PIN);
     return FAULT_ACTIVE_LOW ? (v == LOW) : (v == HIGH);
 }
@@ -97,12 +195,14 @@ void mcpwm_begin_phase()
 // Drive MCPWM at percentage duty.
 void mcpwm_drive(float pct)
 {
+    bench_duty(pct);
     mcpwmMotor.setSpeedPercent(clampPct(pct), Dir::CCW);
 }
 
 // Coast MCPWM outputs.
 void mcpwm_coast()
 {
+    bench_duty(0.0f);
     mcpwmMotor.applyFreewheel(FreewheelMode::HiZ);
 }
 
@@ -152,6 +252,7 @@ void ledc_drive(float pct)
     pct = clampPct(pct);
     if (pct < MIN_EFFECTIVE_LEDC)
         pct = MIN_EFFECTIVE_LEDC;
+    bench_duty(pct);
     ledcWrite(LEDC_CH_RPWM, pctToDuty10(pct));
     if (EN_PIN >= 0)
         digitalWrite(EN_PIN, HIGH);
@@ -161,6 +262,7 @@ void ledc_drive(float pct)
 // Coast LEDC outputs.
 void ledc_coast()
 {
+    bench_duty(0.0f);
     ledcWrite(LEDC_CH_RPWM, 0);
     if (EN_PIN >= 0)
         digitalWrite(EN_PIN, LOW);
@@ -177,4 +279,167 @@ void ledc_end_phase()
     if (EN_PIN >= 0)
         pinMode(EN_PIN, INPUT);
     delay(50);
-}
\ No newline at end of file
+}
+
+// ======================================================
+//                Benchmark sampler
+// ======================================================
+
+namespace
+{
+    /// @brief Running sums for the open phase.
+    struct PhaseStats
+    {
+        const char *driver{nullptr}; ///< Driver label (nullptr → no phase open).
+        const char *phase{nullptr};  ///< Phase name.
+        uint32_t t0_ms{0};           ///< Phase start.
+        uint32_t samples{0};         ///< Samples taken.
+        double duty_sum{0};          ///< Σ duty (%).
+        uint32_t v_n{0};             ///< VBUS samples.
+        double v_sum{0};             ///< Σ VBUS (V).
+        float v_min{INFINITY};       ///< Lowest VBUS (V).
+        uint32_t i_n{0};             ///< Current samples.
+        double i_sum{0};             ///< Σ current (A).
+        float i_max{0};              ///< Peak current (A).
+        uint32_t p_n{0};             ///< Power samples (VBUS and current both present).
+        double p_sum{0};             ///< Σ power (W).
+        double energy_j{0};          ///< ∫ power dt (J).
+        float t_start{NAN};          ///< First temperature (°C).
+        float t_end{NAN};            ///< Latest temperature (°C).
+        float t_max{NAN};            ///< Peak temperature (°C).
+    };
+
+    PhaseStats stats;                                     ///< Open phase.
+    volatile float dutyNow = 0.0f;                        ///< Last commanded duty (%).
+    portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED; ///< Guards stats (sampler task vs phase calls).
+    TaskHandle_t samplerTask = nullptr;                   ///< Sampler task (nullptr → not started).
+
+    /// @brief Fold one sample into the open phase.
+    void addSample(float duty, float v, float a, float t)
+    {
+        portENTER_CRITICAL(&statsMux);
+        if (stats.driver != nullptr)
+        {
+            PhaseStats &s = stats;
+            ++s.samples;
+            s.duty_sum += duty;
+            if (v >= 0.0f)
+            {
+                ++s.v_n;
+                s.v_sum += v;
+                s.v_min = fminf(s.v_min, v);
+            }
+            if (a >= 0.0f)
+            {
+                ++s.i_n;
+                s.i_sum += a;
+                s.i_max = fmaxf(s.i_max, a);
+            }
+            if (v >= 0.0f && a >= 0.0f)
+            {
+                ++s.p_n;
+                s.p_sum += v * a;
+                s.energy_j += v * a * (BENCH_SAMPLE_MS / 1000.0);
+            }
+            if (!std::isnan(t))
+            {
+                if (std::isnan(s.t_start))
+                    s.t_start = t;
+                s.t_end = t;
+                s.t_max = std::isnan(s.t_max) ? t : fmaxf(s.t_max, t);
+            }
+        }
+        portEXIT_CRITICAL(&statsMux);
+    }
+
+    /// @brief Sampler loop at BENCH_SAMPLE_MS.
+    void samplerLoop(void *)
+    {
+        TickType_t last = xTaskGetTickCount();
+        for (;;)
+        {
+            vTaskDelayUntil(&last, pdMS_TO_TICKS(BENCH_SAMPLE_MS));
+            const float duty = dutyNow;
+            const float v = readVbusVolts();
+            const float a = readCurrentAmps();
+            const float t = readTempC();
+            addSample(duty, v, a, t);
+            if (BENCH_SAMPLE_ROWS && stats.driver != nullptr)
+                Serial.printf("S,%lu,%s,%s,%.1f,%.2f,%.2f,%.1f\n", static_cast<unsigned long>(millis()), stats.driver,
+                              stats.phase, duty, v, a, t);
+        }
+    }
+
+    /// @brief Print a float field, or nothing if there is no data.
+    void field(bool have, float value, int decimals)
+    {
+        if (have)
+            Serial.printf(",%.*f", decimals, value);
+        else
+            Serial.print(",");
+    }
+} // namespace
+
+// Start the sampler and print the CSV header.
+void bench_begin()
+{
+    if (!BENCH_ENABLED || samplerTask != nullptr)
+        return;
+    Serial.println("H,driver,pwm_hz,phase,ms,samples,duty_avg,v_avg,v_min,i_avg,i_max,w_avg,energy_j,t_start,t_end,t_max,t_rise,k_per_wh");
+    if (BENCH_SAMPLE_ROWS)
+        Serial.println("HS,ms,driver,phase,duty,v,a,c");
+    xTaskCreatePinnedToCore(samplerLoop, "bench", 4096, nullptr, 2, &samplerTask, 0);
+}
+
+// Open a phase.
+void bench_phase_begin(const char *driver, const char *phase)
+{
+    if (!BENCH_ENABLED)
+        return;
+    bench_phase_end();
+    PhaseStats fresh{};
+    fresh.driver = driver;
+    fresh.phase = phase;
+    fresh.t0_ms = millis();
+    portENTER_CRITICAL(&statsMux);
+    stats = fresh;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+// Close the open phase and print its summary row.
+void bench_phase_end()
+{
+    portENTER_CRITICAL(&statsMux);
+    const PhaseStats s = stats;
+    stats.driver = nullptr;
+    portEXIT_CRITICAL(&statsMux);
+    if (s.driver == nullptr)
+        return;
+
+    const uint32_t ms = millis() - s.t0_ms;
+    const bool have_t = !std::isnan(s.t_start);
+    const float rise = have_t ? s.t_end - s.t_start : 0.0f;
+    const double wh = s.energy_j / 3600.0;
+
+    Serial.printf("P,%s,%u,%s,%lu,%lu", s.driver, static_cast<unsigned>(PWM_FREQ_HZ), s.phase, static_cast<unsigned long>(ms),
+                  static_cast<unsigned long>(s.samples));
+    field(s.samples > 0, s.samples ? static_cast<float>(s.duty_sum / s.samples) : 0.0f, 1);
+    field(s.v_n > 0, s.v_n ? static_cast<float>(s.v_sum / s.v_n) : 0.0f, 2);
+    field(s.v_n > 0, s.v_min, 2);
+    field(s.i_n > 0, s.i_n ? static_cast<float>(s.i_sum / s.i_n) : 0.0f, 2);
+    field(s.i_n > 0, s.i_max, 2);
+    field(s.p_n > 0, s.p_n ? static_cast<float>(s.p_sum / s.p_n) : 0.0f, 2);
+    field(s.p_n > 0, static_cast<float>(s.energy_j), 1);
+    field(have_t, s.t_start, 1);
+    field(have_t, s.t_end, 1);
+    field(have_t, s.t_max, 1);
+    field(have_t, rise, 1);
+    field(have_t && wh > 0.0, wh > 0.0 ? static_cast<float>(rise / wh) : 0.0f, 2);
+    Serial.println();
+}
+
+// Record the commanded duty.
+void bench_duty(float pct)
+{
+    dutyNow = pct;
+}
@@ -15,6 +15,9 @@
 #include <cmath>
 #include <driver/mcpwm.h>
 #include <ESP32_MCPWM.h>
+// SlewEngine.h is the car's (#7_Buttons_Fixed_Forever_v2.0/Project/include, with FixedPoint.h beside it):
+// that directory goes on the include path (PlatformIO build_flags -I), as for the sweep / rotation harnesses.
+#include <SlewEngine.h>
 
 // -------------------- Pin map --------------------
 constexpr int RPWM_PIN = 37; ///< IBT-2 RPWM pin.
@@ -52,6 +55,10 @@ constexpr uint32_t SLEW_STEP_MS = 18;          ///< Time between slew steps (ms)
 constexpr float COAST_BEFORE_JUMP_PCT = 12.0f; ///< Threshold to coast before large step (%).
 constexpr uint32_t COAST_BEFORE_JUMP_MS = 90;  ///< Coast time before large step (ms).
 constexpr uint32_t COAST_AFTER_JUMP_MS = 60;   ///< Coast time after large step (ms).
+constexpr bool SLEW_SCURVE = false;            ///< Ease in/out instead of a constant rate.
+constexpr float SLEW_ACCEL_PCT_S2 = 1500.0f;   ///< S-curve rate change (%/s²).
+constexpr uint32_t CONTROL_TICK_MS = 2;        ///< Ramp / fault / OV check period (ms).
+constexpr uint32_t OV_CLEAR_TIMEOUT_MS = 3000; ///< Resume after this long even without clearing (ms).
 
 // LEDC lower bound (helps sticky rigs)
 constexpr float MIN_EFFECTIVE_LEDC = 0.0f; ///< Minimum effective LEDC duty (%).
@@ -62,6 +69,19 @@ constexpr float VDIV_RATIO = 11.0f;           ///< Divider ratio: (Rtop+Rbot)/Rb
 constexpr float VBUS_OV_LIMIT_VOLTS = 28.0f;  ///< Over-voltage trip threshold (V).
 constexpr float VBUS_CLEAR_HYS_VOLTS = 26.5f; ///< Re-enable threshold with hysteresis (V).
 
+// ---------- Benchmark (per-phase power / temperature CSV) ----------
+constexpr bool BENCH_ENABLED = true;        ///< Sample during every phase and print CSV summaries.
+constexpr bool BENCH_SAMPLE_ROWS = false;   ///< Also print every sample ("S," rows; ~10 lines/s).
+constexpr uint32_t BENCH_SAMPLE_MS = 100;   ///< Fixed sample period (ms).
+constexpr int CURRENT_ADC_PIN = -1;         ///< Current-sense ADC pin (e.g. IBT-2 R_IS); -1 to disable.
+constexpr float CURRENT_V_PER_A = 0.1176f;  ///< Sense gain (V/A): BTS7960 IS, kILIS 8500 into 1 kΩ.
+constexpr float CURRENT_OFFSET_V = 0.0f;    ///< Sense output at 0 A (V).
+constexpr int TEMP_ADC_PIN = -1;            ///< Heatsink NTC divider ADC pin; -1 to disable.
+constexpr float NTC_SERIES_OHMS = 10000.0f; ///< Fixed resistor from 3.3 V to the ADC node (NTC to GND).
+constexpr float NTC_R25_OHMS = 10000.0f;    ///< NTC resistance at 25 °C.
+constexpr float NTC_BETA = 3950.0f;         ///< NTC beta (K).
+constexpr uint32_t ADC_STREAM_HZ = 20000;   ///< S3: DMA conversion rate shared by the sense pins (one-shot reads otherwise).
+
 // -------------------- helpers --------------------
 
 /**
@@ -84,6 +104,16 @@ static inline uint32_t pctToDuty10(float pct)
     return static_cast<uint32_t>(std::lroundf(pct * (static_cast<float>((1u << LEDC_BITS) - 1)) / 100.0f));
 }
 
+/**
+ * @brief Start ADC1 DMA sampling of the sense pins (S3 only).
+ *
+ * Once running, readVbusVolts() / readCurrentAmps() / readTempC() return the
+ * latest 16-sample frame mean instead of doing a one-shot conversion.
+ *
+ * @return true If the stream is running.
+ */
+bool startAdcStream();
+
 /**
  * @brief Read the DC bus (VBUS) voltage via ADC.
  *
@@ -92,7 +122,26 @@ static inline uint32_t pctToDuty10(float pct)
 float readVbusVolts();
 
 /**
- * @brief Check whether a fault/E-STOP is currently active.
+ * @brief Read the bridge current via the current-sense ADC.
+ *
+ * @return float Current in amps, or negative if disabled.
+ */
+float readCurrentAmps();
+
+/**
+ * @brief Read the heatsink temperature from the NTC divider.
+ *
+ * @return float Temperature (°C), or NAN if disabled / open / shorted.
+ */
+float readTempC();
+
+/**
+ * @brief Arm the fault/E-STOP edge interrupt (drops EN from the ISR, latches for the run).
+ */
+void armFaultIrq();
+
+/**
+ * @brief Check whether a fault/E-STOP is active now or has fired since armFaultIrq().
  *
  * @return true If active.
  * @return false Otherwise.
@@ -139,109 +188,162 @@ void ledc_coast();
 /** @brief End the LEDC phase and release pins. */
 void ledc_end_phase();
 
+// ======================================================
+//                Benchmark sampler
+// ======================================================
+//
+// A task samples VBUS, current and heatsink temperature every
+// BENCH_SAMPLE_MS into the open phase. Closing a phase prints one row:
+//   P,driver,pwm_hz,phase,ms,samples,duty_avg,v_avg,v_min,i_avg,i_max,w_avg,energy_j,t_start,t_end,t_max,t_rise,k_per_wh
+// k_per_wh (heatsink rise per Wh drawn) is the driver-loss figure to compare
+// PWM frequencies / driver modes with: lower runs cooler for the same work.
+// Missing sensors print empty fields. Only CSV lines start with "H,", "P,"
+// or "S,", so `grep '^P,'` pulls the table out of a captured serial log.
+
+/** @brief Start the sampler task and print the CSV header (no-op unless BENCH_ENABLED). */
+void bench_begin();
+
+/**
+ * @brief Open a phase (closes any open one first).
+ *
+ * @param driver Driver label ("MCPWM", "LEDC").
+ * @param phase Phase name ("warmup", "step", ...).
+ */
+void bench_phase_begin(const char *driver, const char *phase);
+
+/** @brief Close the open phase and print its summary row. */
+void bench_phase_end();
+
+/**
+ * @brief Record the commanded duty (sampled alongside the sensors).
+ *
+ * @param pct Duty percentage.
+ */
+void bench_duty(float pct);
+
 // ======================================================
 //                  Safety + Ramps (templates)
 // ======================================================
 
 /**
- * @brief Over-voltage guard: coasts outputs if VBUS exceeds limit and waits for clear.
+ * @brief Slew profile matching the old stepped ramp (MAX_SLEW_STEP_PCT per SLEW_STEP_MS, coast around jumps).
  *
- * @tparam CoastFunc Callable of signature void().
- * @param coastFn Function to coast outputs.
- * @param label Text label for logging.
- * @return true If an over-voltage event occurred.
- * @return false Otherwise.
+ * @return SlewEngine A fresh engine at 0 %.
  */
-template <typename CoastFunc>
-bool guardOverVoltage(CoastFunc coastFn, const char *label)
+static inline SlewEngine makeSlew()
 {
-    if (SUPPLY_ADC_PIN < 0)
-        return false;
-    float vb = readVbusVolts();
-    if (vb >= 0.0f && vb > VBUS_OV_LIMIT_VOLTS)
+    SlewEngine::Config c{};
+    c.profile = SLEW_SCURVE ? SlewEngine::Profile::SCurve : SlewEngine::Profile::Linear;
+    c.rate_pct_s = MAX_SLEW_STEP_PCT * 1000.0f / SLEW_STEP_MS;
+    c.accel_pct_s2 = SLEW_ACCEL_PCT_S2;
+    c.jump_pct = COAST_BEFORE_JUMP_PCT;
+    c.coast_before_s = COAST_BEFORE_JUMP_MS / 1000.0f;
+    c.coast_after_s = COAST_AFTER_JUMP_MS / 1000.0f;
+    return SlewEngine(c);
+}
+
+/**
+ * @brief Non-blocking over-voltage latch, checked every control tick.
+ *
+ * Trips above VBUS_OV_LIMIT_VOLTS; clears below VBUS_CLEAR_HYS_VOLTS or
+ * after OV_CLEAR_TIMEOUT_MS (the old blocking guard's limit).
+ */
+class OvGuard
+{
+public:
+    /**
+     * @brief Update with this tick's reading.
+     *
+     * @param label Text label for logging.
+     * @param now_ms Current time (ms).
+     * @return true While tripped (outputs must coast).
+     */
+    bool update(const char *label, uint32_t now_ms)
     {
-        Serial.printf("[%s] OV trip: Vbus=%.2f V -> COAST...\n", label, vb);
-        coastFn();
-        const uint32_t t0 = millis();
-        while (millis() - t0 < 3000U)
+        if (SUPPLY_ADC_PIN < 0)
+            return false;
+        const float vb = readVbusVolts();
+        if (!tripped_)
         {
-            vb = readVbusVolts();
-            if (vb >= 0.0f && vb < VBUS_CLEAR_HYS_VOLTS)
-                break;
-            delay(10);
+            if (vb >= 0.0f && vb > VBUS_OV_LIMIT_VOLTS)
+            {
+                Serial.printf("[%s] OV trip: Vbus=%.2f V -> COAST...\n", label, vb);
+                tripped_ = true;
+                since_ms_ = now_ms;
+            }
+            return tripped_;
         }
-        Serial.printf("[%s] OV clear: Vbus=%.2f V\n", label, vb);
-        return true;
+        if ((vb >= 0.0f && vb < VBUS_CLEAR_HYS_VOLTS) || now_ms - since_ms_ >= OV_CLEAR_TIMEOUT_MS)
+        {
+            Serial.printf("[%s] OV clear: Vbus=%.2f V\n", label, vb);
+            tripped_ = false;
+        }
+        return tripped_;
     }
-    return false;
-}
+
+private:
+    bool tripped_{false};  ///< Currently tripped.
+    uint32_t since_ms_{0}; ///< Trip time.
+};
 
 /**
- * @brief Safe slew to a target duty with optional coast before/after large changes.
- *
- * Checks fault and over-voltage between steps.
+ * @brief Run one timed phase on the control tick: target → slew → drive, with fault and OV checks every tick.
  *
- * @tparam DriveFunc Callable of signature void(float pct).
- * @tparam CoastFunc Callable of signature void().
+ * @tparam DriveFunc Callable void(float pct).
+ * @tparam CoastFunc Callable void().
+ * @tparam TargetFunc Callable float(uint32_t elapsed_ms, const SlewEngine &): target %, or < 0 to coast.
  * @param label Text label for logging.
  * @param drive Drive function.
  * @param coast Coast function.
- * @param lastPct Reference to last commanded percentage (will be updated).
- * @param targetPct Target duty percentage (0..100).
+ * @param slew Phase-spanning slew state (value carries over between phases).
+ * @param duration_ms Phase length (ms).
+ * @param target Target schedule.
+ * @return false If the fault input ended the phase early.
  */
-template <typename DriveFunc, typename CoastFunc>
-void safeRampTo(const char *label, DriveFunc drive, CoastFunc coast,
-                float &lastPct, float targetPct)
+template <typename DriveFunc, typename CoastFunc, typename TargetFunc>
+bool runPhase(const char *label, DriveFunc drive, CoastFunc coast, SlewEngine &slew, uint32_t duration_ms, TargetFunc target)
 {
-    targetPct = clampPct(targetPct);
-    const float delta = targetPct - lastPct;
-
-    // E-STOP?
-    if (faultActive())
-    {
-        coast();
-        return;
-    }
-    // Optional OV guard
-    if (guardOverVoltage(coast, label))
-    {
-        lastPct = 0.0f;
-        return;
-    }
+    OvGuard ov;
+    const uint32_t t0 = millis();
+    uint32_t last_us = micros();
+    TickType_t wake = xTaskGetTickCount();
+    const TickType_t period = pdMS_TO_TICKS(CONTROL_TICK_MS) > 0 ? pdMS_TO_TICKS(CONTROL_TICK_MS) : 1;
 
-    if (fabsf(delta) >= COAST_BEFORE_JUMP_PCT)
+    for (uint32_t now = millis(); now - t0 < duration_ms; now = millis())
     {
-        coast();
-        delay(COAST_BEFORE_JUMP_MS);
-    }
+        const uint32_t now_us = micros();
+        const float dt_s = (now_us - last_us) / 1e6f;
+        last_us = now_us;
 
-    int steps = static_cast<int>(ceilf(fabsf(delta) / MAX_SLEW_STEP_PCT));
-    if (steps < 1)
-        steps = 1;
-
-    const float stepSize = delta / static_cast<float>(steps);
-    for (int i = 0; i < steps; ++i)
-    {
-        lastPct += stepSize;
         if (faultActive())
         {
             coast();
-            return;
+            slew.reset(0.0f);
+            return false;
         }
-        if (guardOverVoltage(coast, label))
+        if (ov.update(label, now))
         {
-            lastPct = 0.0f;
-            return;
+            coast();
+            slew.reset(0.0f); ///< Re-ramp from zero once clear.
         }
-        drive(lastPct);
-        delay(SLEW_STEP_MS);
-    }
-
-    if (fabsf(delta) >= COAST_BEFORE_JUMP_PCT)
-    {
-        coast();
-        delay(COAST_AFTER_JUMP_MS);
+        else
+        {
+            const float tgt = target(now - t0, slew);
+            if (tgt < 0.0f)
+                coast(); ///< Scheduled coast: hold the slew value (the next drive resumes from it).
+            else
+            {
+                slew.setTarget(clampPct(tgt));
+                const SlewEngine::Output out = slew.step(dt_s);
+                if (out.coast)
+                    coast();
+                else
+                    drive(out.pct);
+            }
+        }
+        vTaskDelayUntil(&wake, period);
     }
+    return true;
 }
 
 // ======================================================
@@ -256,73 +358,72 @@ void safeRampTo(const char *label, DriveFunc drive, CoastFunc coast,
  * @param label Label for logs.
  * @param drive Drive function.
  * @param coast Coast function.
- * @param lastPct Reference to last commanded duty.
+ * @param slew Slew state.
  */
 template <typename DriveFunc, typename CoastFunc>
-void do_warmup(const char *label, DriveFunc drive, CoastFunc coast, float &lastPct)
+void do_warmup(const char *label, DriveFunc drive, CoastFunc coast, SlewEngine &slew)
 {
+    bench_phase_begin(label, "warmup");
     Serial.printf("[%s] Warm-up @ %.1f%% for %u ms\n", label, WARMUP_DUTY, static_cast<unsigned>(WARMUP_MS));
-    const uint32_t t0 = millis();
-    while (millis() - t0 < WARMUP_MS)
-    {
-        safeRampTo(label, drive, coast, lastPct, WARMUP_DUTY);
-        if (faultActive())
-        {
-            coast();
-            break;
-        }
-        delay(10);
-    }
+    runPhase(label, drive, coast, slew, WARMUP_MS, [](uint32_t, const SlewEngine &) { return WARMUP_DUTY; });
+    bench_phase_end();
     coast();
     delay(BURST_COAST_MS);
 }
 
 /**
- * @brief Alternating step load between STEP_LOW and STEP_HIGH.
+ * @brief Alternating step load between STEP_LOW and STEP_HIGH (STEP_HOLD_MS once each is reached).
  */
 template <typename DriveFunc, typename CoastFunc>
-void do_step_load(const char *label, DriveFunc drive, CoastFunc coast, float &lastPct)
+void do_step_load(const char *label, DriveFunc drive, CoastFunc coast, SlewEngine &slew)
 {
+    bench_phase_begin(label, "step");
     Serial.printf("[%s] Step load %g <-> %g %% for %u ms\n", label, STEP_LOW, STEP_HIGH, static_cast<unsigned>(STEP_BLOCK_MS));
-    const uint32_t t0 = millis();
     bool hi = false;
-    while (millis() - t0 < STEP_BLOCK_MS)
-    {
-        safeRampTo(label, drive, coast, lastPct, hi ? STEP_HIGH : STEP_LOW);
-        if (faultActive())
+    uint32_t held_since = UINT32_MAX;
+    runPhase(label, drive, coast, slew, STEP_BLOCK_MS, [&](uint32_t t, const SlewEngine &s) {
+        if (!s.settled())
+            held_since = UINT32_MAX;
+        else if (held_since == UINT32_MAX)
+            held_since = t;
+        else if (t - held_since >= STEP_HOLD_MS)
         {
-            coast();
-            break;
+            hi = !hi;
+            held_since = UINT32_MAX;
         }
-        delay(STEP_HOLD_MS);
-        hi = !hi;
-    }
+        return hi ? STEP_HIGH : STEP_LOW;
+    });
+    bench_phase_end();
     coast();
     delay(BURST_COAST_MS);
 }
 
 /**
- * @brief Repeating burst pulses separated by coast gaps.
+ * @brief Repeating burst pulses (BURST_ON_MS at BURST_DUTY once reached) separated by coast gaps.
  */
 template <typename DriveFunc, typename CoastFunc>
-void do_bursts(const char *label, DriveFunc drive, CoastFunc coast, float &lastPct)
+void do_bursts(const char *label, DriveFunc drive, CoastFunc coast, SlewEngine &slew)
 {
+    bench_phase_begin(label, "burst");
     Serial.printf("[%s] Bursts: coast %ums -> %g%% %ums (repeat %u ms)\n",
                   label, static_cast<unsigned>(BURST_COAST_MS), BURST_DUTY,
                   static_cast<unsigned>(BURST_ON_MS), static_cast<unsigned>(BURST_BLOCK_MS));
-    const uint32_t t0 = millis();
-    while (millis() - t0 < BURST_BLOCK_MS)
-    {
-        coast();
-        delay(BURST_COAST_MS); ///< Let current decay.
-        safeRampTo(label, drive, coast, lastPct, BURST_DUTY);
-        if (faultActive())
+    uint32_t coast_until = BURST_COAST_MS; ///< Let current decay first.
+    uint32_t on_since = UINT32_MAX;
+    runPhase(label, drive, coast, slew, BURST_BLOCK_MS, [&](uint32_t t, const SlewEngine &s) {
+        if (t < coast_until)
+            return -1.0f;
+        if (on_since == UINT32_MAX && s.settled() && s.value() == BURST_DUTY)
+            on_since = t;
+        if (on_since != UINT32_MAX && t - on_since >= BURST_ON_MS)
         {
-            coast();
-            break;
+            coast_until = t + BURST_COAST_MS;
+            on_since = UINT32_MAX;
+            return -1.0f;
         }
-        delay(BURST_ON_MS);
-    }
+        return BURST_DUTY;
+    });
+    bench_phase_end();
     coast();
     delay(BURST_COAST_MS);
 }
@@ -331,20 +432,12 @@ void do_bursts(const char *label, DriveFunc drive, CoastFunc coast, float &lastP
  * @brief Heat soak at a fixed duty for a duration.
  */
 template <typename DriveFunc, typename CoastFunc>
-void do_soak(const char *label, DriveFunc drive, CoastFunc coast, float &lastPct)
+void do_soak(const char *label, DriveFunc drive, CoastFunc coast, SlewEngine &slew)
 {
+    bench_phase_begin(label, "soak");
     Serial.printf("[%s] Heat soak @ %.1f%% for %u ms\n", label, SOAK_DUTY, static_cast<unsigned>(SOAK_MS));
-    const uint32_t t0 = millis();
-    while (millis() - t0 < SOAK_MS)
-    {
-        safeRampTo(label, drive, coast, lastPct, SOAK_DUTY);
-        if (faultActive())
-        {
-            coast();
-            break;
-        }
-        delay(20);
-    }
+    runPhase(label, drive, coast, slew, SOAK_MS, [](uint32_t, const SlewEngine &) { return SOAK_DUTY; });
+    bench_phase_end();
     coast();
     delay(GAP_MS);
-}
\ No newline at end of file
+}
@@ -11,8 +11,8 @@
 
 #include "MCPWM_Test_Temp.h"
 
-static float mcpwmLastPct = 0.0f; ///< Last commanded duty (percent) for MCPWM phase.
-static float ledcLastPct = 0.0f;  ///< Last commanded duty (percent) for LEDC phase.
+static SlewEngine mcpwmSlew = makeSlew(); ///< Ramp state for the MCPWM phase.
+static SlewEngine ledcSlew = makeSlew();  ///< Ramp state for the LEDC phase.
 
 void setup()
 {
@@ -22,7 +22,7 @@ void setup()
 
     if (FAULT_PIN >= 0)
     {
-        pinMode(FAULT_PIN, INPUT_PULLUP);
+        armFaultIrq(); ///< EN drops from the ISR, not on the next slew tick.
         Serial.println("FAULT/E-STOP input ENABLED.");
     }
     else
@@ -42,6 +42,13 @@ void setup()
     {
         Serial.println("Over-voltage guard DISABLED (set SUPPLY_ADC_PIN to enable).");
     }
+
+    if (SUPPLY_ADC_PIN >= 0 || CURRENT_ADC_PIN >= 0 || TEMP_ADC_PIN >= 0)
+    {
+        Serial.println(startAdcStream() ? "ADC: DMA stream (frame means)." : "ADC: one-shot reads.");
+    }
+
+    bench_begin(); ///< Per-phase CSV summaries ("P," rows).
 }
 
 void loop()
@@ -49,24 +56,28 @@ void loop()
     // -------- MCPWM PHASE (First) --------
     Serial.println("PHASE: MCPWM");
     mcpwm_begin_phase();
-    do_warmup("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmLastPct);
-    do_step_load("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmLastPct);
-    do_bursts("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmLastPct);
-    do_soak("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmLastPct);
+    do_warmup("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmSlew);
+    do_step_load("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmSlew);
+    do_bursts("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmSlew);
+    do_soak("MCPWM", mcpwm_drive, mcpwm_coast, mcpwmSlew);
     mcpwm_end_phase();
 
     Serial.println("PHASE: BREAK/COOLDOWN - 5 MINS");
+    bench_phase_begin("MCPWM", "cooldown"); ///< Heatsink decay after the run.
     delay(300000);
+    bench_phase_end();
 
     // -------- LEDC PHASE (Second) --------
     Serial.println("PHASE: LEDC");
     ledc_begin_phase();
-    do_warmup("LEDC", ledc_drive, ledc_coast, ledcLastPct);
-    do_step_load("LEDC", ledc_drive, ledc_coast, ledcLastPct);
-    do_bursts("LEDC", ledc_drive, ledc_coast, ledcLastPct);
-    do_soak("LEDC", ledc_drive, ledc_coast, ledcLastPct);
+    do_warmup("LEDC", ledc_drive, ledc_coast, ledcSlew);
+    do_step_load("LEDC", ledc_drive, ledc_coast, ledcSlew);
+    do_bursts("LEDC", ledc_drive, ledc_coast, ledcSlew);
+    do_soak("LEDC", ledc_drive, ledc_coast, ledcSlew);
     ledc_end_phase();
 
     Serial.println("PHASE: BREAK/COOLDOWN - 5 MINS");
+    bench_phase_begin("LEDC", "cooldown"); ///< Heatsink decay after the run.
     delay(300000);
+    bench_phase_end();
 }
\ No newline at end of file
@@ -0,0 +1,334 @@
+/**
+ * Sketch 04 — Benchmark harness (all strategies, one run)
+ *
+ * Runs every sharing strategy from sketches 01–03 back to back, plus a
+ * 64-bit atomic (8-byte payload only) and a length-1 FreeRTOS queue
+ * (xQueueOverwrite / xQueuePeek). Each cell of the sweep
+ *
+ *   strategy × payload size × publish rate × core placement
+ *
+ * runs for CELL_MS and prints one CSV row to Serial:
+ *
+ *   strategy,payload_bytes,rate_hz,placement,writes,reads,torn,
+ *   read_p50_ns,read_p99_ns,read_max_ns,stall_p50_ns,stall_p99_ns,stall_max_ns
+ *
+ * read_* is the time for the reader to obtain one copy; stall_* is the time
+ * the writer spends inside publish. Both are measured with the CPU cycle
+ * counter. torn counts frames whose words don't all belong to one publish.
+ * Capture the Serial output (lines starting with '#' are comments) and
+ * diff it between builds to put numbers on bus regressions.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+#include <SnapshotBus.h>
+
+// ---- Sweep knobs ---- //
+static constexpr uint32_t CELL_MS = 1000;                            // Duration of one cell.
+static constexpr uint32_t RATES_HZ[] = {30, 100, 1000, 5000, 10000}; // Writer publish rates.
+static constexpr size_t MAX_SAMPLES = 4096;                          // Latency samples kept per cell (latest N).
+static constexpr uint32_t READER_YIELD_US = 1000;                    // Reader yields a tick this often (feeds idle/WDT).
+
+// ---- Frame: every word is derived from word 0 so any mix of two publishes is detectable ---- //
+template <size_t W>
+struct Frame
+{
+    uint32_t w[W];
+};
+
+static inline uint32_t mix(uint32_t seq, size_t i) { return seq ^ (0x9E3779B9u * static_cast<uint32_t>(i)); }
+
+template <size_t W>
+static inline void fill(Frame<W> &f, uint32_t seq)
+{
+    f.w[0] = seq;
+    for (size_t i = 1; i < W; ++i)
+        f.w[i] = mix(seq, i);
+}
+
+template <size_t W>
+static inline bool torn(const Frame<W> &f)
+{
+    for (size_t i = 1; i < W; ++i)
+        if (f.w[i] != mix(f.w[0], i))
+            return true;
+    return false;
+}
+
+// ---- Strategies (same interface: publish + read) ---- //
+
+// 01: no protection, word-by-word copy.
+template <size_t W>
+struct RawStore
+{
+    static constexpr const char *name = "raw";
+    Frame<W> f{};
+    void publish(const Frame<W> &v)
+    {
+        volatile uint32_t *d = f.w;
+        for (size_t i = 0; i < W; ++i)
+            d[i] = v.w[i];
+    }
+    bool read(Frame<W> &out)
+    {
+        const volatile uint32_t *s = f.w;
+        for (size_t i = 0; i < W; ++i)
+            out.w[i] = s[i];
+        return true;
+    }
+};
+
+// 02: whole-frame copy under a mutex.
+template <size_t W>
+struct MutexStore
+{
+    static constexpr const char *name = "mutex";
+    Frame<W> f{};
+    SemaphoreHandle_t mtx = xSemaphoreCreateMutex();
+    void publish(const Frame<W> &v)
+    {
+        xSemaphoreTake(mtx, portMAX_DELAY);
+        f = v;
+        xSemaphoreGive(mtx);
+    }
+    bool read(Frame<W> &out)
+    {
+        xSemaphoreTake(mtx, portMAX_DELAY);
+        out = f;
+        xSemaphoreGive(mtx);
+        return true;
+    }
+};
+
+// 03: SnapshotBus (lock-free snapshots).
+template <size_t W>
+struct SnapStore
+{
+    static constexpr const char *name = "snapshotbus";
+    snapshot::SnapshotBus<Frame<W>> bus;
+    void publish(const Frame<W> &v) { bus.publish(v); }
+    bool read(Frame<W> &out)
+    {
+        out = bus.peek();
+        return true;
+    }
+};
+
+// New: one 64-bit atomic word (8-byte payload only).
+template <size_t W>
+struct AtomicStore
+{
+    static_assert(sizeof(Frame<W>) == sizeof(uint64_t), "AtomicStore needs an 8-byte frame.");
+    static constexpr const char *name = "atomic64";
+    std::atomic<uint64_t> word{0};
+    void publish(const Frame<W> &v)
+    {
+        uint64_t x;
+        memcpy(&x, &v, sizeof(x));
+        word.store(x, std::memory_order_release);
+    }
+    bool read(Frame<W> &out)
+    {
+        const uint64_t x = word.load(std::memory_order_acquire);
+        memcpy(&out, &x, sizeof(x));
+        return true;
+    }
+};
+
+// New: length-1 mailbox queue.
+template <size_t W>
+struct QueueStore
+{
+    static constexpr const char *name = "queue";
+    QueueHandle_t q = xQueueCreate(1, sizeof(Frame<W>));
+    void publish(const Frame<W> &v) { xQueueOverwrite(q, &v); }
+    bool read(Frame<W> &out) { return xQueuePeek(q, &out, 0) == pdTRUE; }
+};
+
+// ---- Samples + percentiles ---- //
+struct Samples
+{
+    uint32_t v[MAX_SAMPLES];
+    uint32_t n = 0;   // Total recorded.
+    uint32_t max = 0;  // Exact max (not just over the kept window).
+
+    void reset()
+    {
+        n = 0;
+        max = 0;
+    }
+    void add(uint32_t cycles)
+    {
+        v[n % MAX_SAMPLES] = cycles;
+        ++n;
+        if (cycles > max)
+            max = cycles;
+    }
+    // Sorts in place; call once after the cell.
+    uint32_t pct(uint32_t p)
+    {
+        const uint32_t k = (n < MAX_SAMPLES) ? n : MAX_SAMPLES;
+        if (k == 0)
+            return 0;
+        std::sort(v, v + k);
+        return v[(k - 1) * p / 100];
+    }
+};
+
+static Samples g_read, g_stall;
+
+static inline uint32_t cyc_to_ns(uint32_t c) { return static_cast<uint32_t>((uint64_t)c * 1000ULL / getCpuFrequencyMhz()); }
+
+// ---- One cell ---- //
+template <typename Store>
+struct Cell
+{
+    Store *store;
+    TaskHandle_t runner; // Notified when a task exits.
+    TaskHandle_t writer; // Notified by the rate timer.
+    std::atomic<bool> stop{false};
+    uint32_t writes = 0;
+    uint32_t reads = 0;
+    uint32_t torn_frames = 0;
+};
+
+template <typename Store, size_t W>
+static void writer_task(void *arg)
+{
+    auto *c = static_cast<Cell<Store> *>(arg);
+    Frame<W> f{};
+    uint32_t seq = 0;
+
+    while (!c->stop.load())
+    {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)) == 0)
+            continue; // Timer tick missed/stopped: re-check stop.
+
+        fill(f, ++seq);
+        const uint32_t t0 = ESP.getCycleCount();
+        c->store->publish(f);
+        g_stall.add(ESP.getCycleCount() - t0);
+        ++c->writes;
+    }
+    xTaskNotifyGive(c->runner);
+    vTaskDelete(nullptr);
+}
+
+template <typename Store, size_t W>
+static void reader_task(void *arg)
+{
+    auto *c = static_cast<Cell<Store> *>(arg);
+    Frame<W> f{};
+    int64_t next_yield = esp_timer_get_time() + READER_YIELD_US;
+
+    while (!c->stop.load())
+    {
+        const uint32_t t0 = ESP.getCycleCount();
+        const bool ok = c->store->read(f);
+        const uint32_t dt = ESP.getCycleCount() - t0;
+
+        if (ok && f.w[0] != 0) // 0 → nothing published yet.
+        {
+            g_read.add(dt);
+            ++c->reads;
+            if (torn(f))
+                ++c->torn_frames;
+        }
+
+        if (esp_timer_get_time() >= next_yield)
+        {
+            vTaskDelay(1);
+            next_yield = esp_timer_get_time() + READER_YIELD_US;
+        }
+    }
+    xTaskNotifyGive(c->runner);
+    vTaskDelete(nullptr);
+}
+
+static void on_rate_timer(void *arg) { xTaskNotifyGive(static_cast<TaskHandle_t>(arg)); }
+
+template <typename Store, size_t W>
+static void run_cell(uint32_t rate_hz, bool cross_core)
+{
+    static Store store; // One instance per strategy/size, reused across cells.
+
+    Cell<Store> c{};
+    c.store = &store;
+    c.runner = xTaskGetCurrentTaskHandle();
+    g_read.reset();
+    g_stall.reset();
+
+    const BaseType_t w_core = cross_core ? 0 : 1;
+    xTaskCreatePinnedToCore(writer_task<Store, W>, "bw", 4096, &c, 3, &c.writer, w_core);
+    xTaskCreatePinnedToCore(reader_task<Store, W>, "br", 4096, &c, 2, nullptr, 1);
+
+    esp_timer_handle_t tmr = nullptr;
+    esp_timer_create_args_t ta{};
+    ta.callback = on_rate_timer;
+    ta.arg = c.writer;
+    ta.name = "brate";
+    esp_timer_create(&ta, &tmr);
+    esp_timer_start_periodic(tmr, 1000000ULL / rate_hz);
+
+    vTaskDelay(pdMS_TO_TICKS(CELL_MS));
+
+    esp_timer_stop(tmr);
+    esp_timer_delete(tmr);
+    c.stop.store(true);
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY); // Writer exited.
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY); // Reader exited.
+
+    Serial.printf("%s,%u,%u,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u\r\n",
+                  Store::name, (unsigned)sizeof(Frame<W>), rate_hz, cross_core ? "cross" : "same",
+                  c.writes, c.reads, c.torn_frames,
+                  cyc_to_ns(g_read.pct(50)), cyc_to_ns(g_read.pct(99)), cyc_to_ns(g_read.max),
+                  cyc_to_ns(g_stall.pct(50)), cyc_to_ns(g_stall.pct(99)), cyc_to_ns(g_stall.max));
+}
+
+template <size_t W>
+static void run_size(uint32_t rate_hz, bool cross_core)
+{
+    run_cell<RawStore<W>, W>(rate_hz, cross_core);
+    run_cell<MutexStore<W>, W>(rate_hz, cross_core);
+    run_cell<SnapStore<W>, W>(rate_hz, cross_core);
+    if constexpr (sizeof(Frame<W>) == sizeof(uint64_t))
+        run_cell<AtomicStore<W>, W>(rate_hz, cross_core);
+    run_cell<QueueStore<W>, W>(rate_hz, cross_core);
+}
+
+static void bench(void *)
+{
+    Serial.begin(115200);
+    delay(500);
+
+    Serial.printf("# Baseball bench: %u ms/cell, %u MHz, samples/cell=%u\r\n",
+                  CELL_MS, (unsigned)getCpuFrequencyMhz(), (unsigned)MAX_SAMPLES);
+    Serial.println("strategy,payload_bytes,rate_hz,placement,writes,reads,torn,"
+                   "read_p50_ns,read_p99_ns,read_max_ns,stall_p50_ns,stall_p99_ns,stall_max_ns");
+
+    for (const bool cross : {false, true})
+    {
+        for (const uint32_t hz : RATES_HZ)
+        {
+            run_size<2>(hz, cross);  //   8 B (fits atomic64).
+            run_size<16>(hz, cross); //  64 B.
+            run_size<64>(hz, cross); // 256 B.
+        }
+    }
+
+    Serial.println("# done");
+    vTaskDelete(nullptr);
+}
+
+void setup()
+{
+    // Runner sits on core 0 at low priority; it only sleeps while cells run.
+    xTaskCreatePinnedToCore(bench, "bench", 8192, nullptr, 1, nullptr, 0);
+}
+void loop() { vTaskDelete(nullptr); }
@@ -21,7 +21,32 @@
 
 #define DEBUGGING true
 
-#if DEBUGGING
+// Route debug output through dlog's ring + drain task instead of blocking on the UART.
+// The host simulation (sim/) writes straight to stdout: its Serial never blocks and there is no drain task.
+#if defined(SIM_HOST)
+#define DEBUG_DEFERRED false
+#else
+#define DEBUG_DEFERRED true
+#endif
+
+#if DEBUGGING && DEBUG_DEFERRED
+#include <DeferredLog.h>
+
+template <typename T>
+inline void debug(const T &x) { dlog::print(x, dlog::Eol::None); }
+
+template <typename T>
+inline void debugln(const T &x) { dlog::print(x, dlog::Eol::CrLf); }
+
+// Overloads for float with precision.
+inline void debug(float x, int digits) { dlog::print(x, digits, dlog::Eol::None); }
+inline void debugln(float x, int digits) { dlog::print(x, digits, dlog::Eol::CrLf); }
+
+// printf-style debug macros (format must be a string literal; args are captured, formatted later).
+#define debugf(fmt, ...) dlog::sink().emit(dlog::Eol::None, fmt, ##__VA_ARGS__)
+#define debugfln(fmt, ...) dlog::sink().emit(dlog::Eol::Lf, fmt, ##__VA_ARGS__)
+
+#elif DEBUGGING
 template <typename T>
 inline void debug(const T &x) { Serial.print(x); }
 
@@ -49,6 +74,8 @@ inline void debugln(float, int) {}
 
 // ---- SnapshotBus scheduling parameters ---- //
 
+// Only the seqlock path uses these; payloads with a snapshot::atomic_codec are wait-free.
+
 #ifndef SNAPSHOTBUS_SPIN_LIMIT
 // Bound reader spin before yielding; 32–128 is typical for ESP32.
 #define SNAPSHOTBUS_SPIN_LIMIT 64
@@ -87,33 +114,518 @@ namespace cfg
     namespace tick
     {
         constexpr uint32_t LOOP_MS = 10;                   ///< Standard loop cadence.
+        constexpr uint32_t HEARTBEAT_MS = 500;             ///< Idle republish/refresh cadence for event-driven loops (0 → off).
         constexpr uint32_t LOOP_INTERVAL_TEST_SHORT = 100; ///< Short test ms.
         constexpr uint32_t LOOP_INTERVAL_TEST_LONG = 1000; ///< Long test ms.
     } ///< Namespace tick.
 
+    // ---- Adaptive cadence (Cadence: loops slow down or park while the car sits still) ---- //
+    namespace cadence
+    {
+        constexpr bool ENABLED = true;           ///< Vary loop rates with activity (false → every loop at its fixed rate).
+        constexpr uint32_t BOOST_MS = 300;       ///< Boosted rate this long after activity (gesture / edge timing).
+        constexpr uint32_t IDLE_AFTER_MS = 2000; ///< Quiet this long → idle rate.
+        constexpr uint32_t PARK_AFTER_MS = 5000; ///< Quiet this long → park (block on the task's wake source).
+        constexpr uint32_t SM_BOOST_MS = 5;      ///< StateManager poll period while boosted.
+        constexpr uint32_t SM_IDLE_MS = 50;      ///< StateManager poll period idle / parked (bounds the first edge's extra latency).
+        constexpr uint32_t RC_IDLE_MS = 50;      ///< RcPublisher poll period with no transmitter (≤ rc::STALE_MS).
+        constexpr uint32_t DRIVE_PARK_MS = 1000; ///< PowerDriveHandler at standstill this long → timer paused, waits on ControlBus.
+        constexpr uint32_t DRIVE_BEAT_MS = 250;  ///< Parked PowerDriveHandler still steps (telemetry, encoder) this often.
+    } ///< Namespace cadence.
+
+    // ---- Power management (PowerManager: DFS + light sleep, locks held by the deadline tasks) ---- //
+    namespace power
+    {
+        constexpr bool ENABLED = true;             ///< Configure esp_pm (needs CONFIG_PM_ENABLE; otherwise full clock).
+        constexpr uint32_t MAX_MHZ = 240;          ///< Clock while a CpuMax lock is held.
+        constexpr uint32_t MIN_MHZ = 80;           ///< Idle clock (≥ 80: APB, and every UART / timer / PWM clock, never changes).
+        constexpr bool LIGHT_SLEEP = true;         ///< Light sleep when no lock is held (needs tickless idle; USB console drops).
+        constexpr bool RC_WAKE = true;             ///< A start bit on rc::UART_RX wakes the chip (that frame is lost).
+        constexpr uint32_t WAKE_BUDGET_US = 20000; ///< Wake frame origin → first drive step applying it; over → counted.
+    } ///< Namespace power.
+
+    // ---- Control-path numbers (real_t: ControlSnapshot, RcSnapshot, throttle ramp) ---- //
+    namespace numeric
+    {
+#if defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32C2) || defined(CONFIG_IDF_TARGET_ESP32C6)
+        constexpr bool FIXED_POINT = true; ///< No FPU: Q16.16 keeps soft-float out of the 1 kHz loops.
+#else
+        constexpr bool FIXED_POINT = false; ///< FPU present: float (set true to run the Q16.16 path anyway).
+#endif
+    } ///< Namespace numeric.
+
     // ---- Button Timings ---- //
     namespace button
     {
         constexpr uint32_t BTN_DEBOUNCE_MS = 50;
         constexpr uint32_t BTN_SHORT_MS = 200;
         constexpr uint32_t BTN_LONG_MS = 1000;
+        constexpr bool BTN_IRQ_WAKE = true;          ///< Wake StateManager from GPIO edges instead of polling.
+        constexpr uint32_t BTN_SETTLE_MARGIN_MS = 2; ///< Extra settle time after debounce before re-sampling.
+        constexpr uint32_t BTN_DOUBLE_MS = 250;      ///< Max gap between two short taps for a double-click event.
+        constexpr uint32_t BTN_CHORD_MS = 80;        ///< Max spread between a chord's member presses (CHORD_LIST).
+        constexpr uint32_t BTN_EVENT_QUEUE = 32;     ///< ButtonEventQueue capacity (power of two).
+        constexpr bool BTN_PORT_SCAN = false;        ///< Read BUTTON_LIST pins via GPIO registers + vertical-counter debounce (PortButtons).
     } ///< Namespace button.
 
-    // ---- Motor (MCPWM) ---- //
+    // ---- Key matrix (KeyMatrix → PortButtons → StateManager) ---- //
+    namespace matrix
+    {
+        constexpr bool ENABLED = false;                                  ///< Buttons come from the matrix (BUTTON_LIST entries = keys r * cols + c; pins unused).
+        constexpr uint8_t ROW_PINS[] = {10, 11, 12, 13, 14, 15, 16, 17}; ///< Open-drain row drives.
+        constexpr uint8_t COL_PINS[] = {1, 2, 3, 4, 5, 21, 47, 48};      ///< Pulled-up column inputs.
+        constexpr uint32_t ROW_US = 250;                                 ///< Per-row drive / settle time (8 rows → 2 ms scan).
+        constexpr int TIMER_GROUP = 1;                                   ///< GPTimer group (0/1) used for scanning.
+        constexpr int TIMER_INDEX = 1;                                   ///< GPTimer index within the group (drive pacing uses 1/0).
+    } ///< Namespace matrix.
+
+    // ---- Motor ---- //
     namespace motor
     {
+        /// @brief Drive output backend (include/MotorBackend.h), bound at compile time.
+        enum class Backend : uint8_t
+        {
+            Mcpwm = 0, ///< ESP32_MCPWM H-bridge driver.
+            Ledc,      ///< Two LEDC channels on the same H-bridge pins.
+            RmtServo,  ///< Servo / ESC pulse on RMT (SERVO_PIN).
+            McpwmArray ///< BRIDGES H-bridges across both MCPWM units, updated in one batch.
+        };
+
+        constexpr Backend BACKEND = Backend::Mcpwm; ///< Selected drive backend.
         constexpr int RPWM_PIN = 37;
         constexpr int LPWM_PIN = 38;
         constexpr int EN_PIN = 39;
+        constexpr uint32_t PWM_FREQ_HZ = 20000;     ///< H-bridge carrier (Mcpwm / Ledc).
+        constexpr uint8_t LEDC_BITS = 10;           ///< Ledc duty resolution.
+        constexpr bool CENTER_ALIGNED = false;      ///< Mcpwm up/down counter (false → up counter).
+        constexpr bool DEADTIME = false;            ///< Mcpwm deadtime insertion (IBT-2 has its own).
+        constexpr int SERVO_PIN = -1;               ///< RmtServo signal pin.
+        constexpr uint16_t SERVO_NEUTRAL_US = 1500; ///< RmtServo pulse at 0 %.
+        constexpr uint16_t SERVO_SPAN_US = 500;     ///< RmtServo pulse change at 100 %.
+        constexpr bool SERVO_REVERSIBLE = true;     ///< RmtServo: ESC has reverse (false → forward-only).
+        constexpr uint32_t SOFT_BRAKE_HZ = 300;     ///< Mcpwm library soft-brake chop rate (MotorBehaviorConfig).
+        constexpr uint32_t MIN_PHASE_US = 1000;     ///< Mcpwm library minimum leg phase time (MotorBehaviorConfig).
+
+        // ---- McpwmArray (bridge 0 = the pins above) ---- //
+        constexpr std::size_t BRIDGES = 4;                          ///< Bridges driven together (1..6; 0-2 unit 0, 3-5 unit 1).
+        constexpr int BRIDGE_RPWM[BRIDGES] = {RPWM_PIN, 6, 9, 40};  ///< RPWM per bridge.
+        constexpr int BRIDGE_LPWM[BRIDGES] = {LPWM_PIN, 7, 18, 42}; ///< LPWM per bridge.
+        constexpr int BRIDGE_EN[BRIDGES] = {EN_PIN, 8, -1, -1};     ///< EN per bridge (-1 → wired to bridge 0's EN or tied high).
     } ///< Namespace motor.
 
-    // ---- Remote Control (RCLink) ---- //
+    // ---- Drive control loop ---- //
+    namespace drive
+    {
+        constexpr bool HW_TIMER = true;                                        ///< Pace PowerDriveHandler from a GPTimer alarm.
+        constexpr uint32_t PERIOD_US = HW_TIMER ? 1000 : tick::LOOP_MS * 1000; ///< Control period (µs): 1 kHz on the timer.
+        constexpr int TIMER_GROUP = 1;                                         ///< GPTimer group (0/1) used for pacing.
+        constexpr int TIMER_INDEX = 0;                                         ///< GPTimer index within the group.
+        constexpr bool RAMP_SCURVE = false;                                    ///< Ease the throttle ramp in/out (false → linear).
+        constexpr float RAMP_ACCEL_PCT_S2 = 80.0f;                             ///< S-curve ramp-rate change (%/s²).
+
+        // ---- Direction changes (decel → brake / coast → dead time → reverse) ---- //
+        constexpr bool REVERSE_BRAKE = true;          ///< Hold both low sides on between directions (false → coast).
+        constexpr float REVERSE_DECEL_PCT_S = 200.0f; ///< Ramp-down rate ahead of a reversal (%/s).
+        constexpr uint32_t STOP_HOLD_MS = 150;        ///< Brake / coast hold after the last drive (upper bound).
+        constexpr float STOP_RPM = 30.0f;             ///< With an encoder: end the hold early below this speed.
+        constexpr uint32_t DEADTIME_US = 500;         ///< All-off gap before the other leg (raised to motor::MIN_PHASE_US).
+        constexpr float REVERSE_MAX_PCT = 60.0f;      ///< Reverse throttle ceiling (%).
+    } ///< Namespace drive.
+
+    // ---- Power sensing (AdcService: ADC1 continuous / DMA → buses::power()) ---- //
+    namespace adc
+    {
+        constexpr bool ENABLED = false;          ///< Stream Vbus / current (needs VBUS_PIN and/or CURRENT_PIN).
+        constexpr int VBUS_PIN = -1;             ///< ADC1 pin on the bus-voltage divider (GPIO1..10; -1 → none).
+        constexpr float VDIV_RATIO = 11.0f;      ///< Vbus / Vpin (100k : 10k divider).
+        constexpr int CURRENT_PIN = -1;          ///< ADC1 pin on the current-sense output (IBT-2 IS; -1 → none).
+        constexpr float CURRENT_OFFSET_V = 0.0f; ///< Sense voltage at 0 A.
+        constexpr float CURRENT_V_PER_A = 0.10f; ///< Sense gain (V per A).
+        constexpr uint32_t SAMPLE_HZ = 40000;    ///< Total conversion rate, shared round-robin by the pins.
+        constexpr uint32_t FRAME_SAMPLES = 16;   ///< Conversions per DMA frame = one PowerBus publish (400 µs).
+    } ///< Namespace adc.
+
+    // ---- Throttle envelope (PowerDriveHandler current / power limit on PowerBus frames) ---- //
+    namespace limit
+    {
+        constexpr bool ENABLED = false;        ///< Clamp the duty to the envelope (needs cfg::adc CURRENT_PIN).
+        constexpr float MAX_AMPS = 25.0f;      ///< Bridge current ceiling (A; 0 → no current limit).
+        constexpr float MAX_WATTS = 0.0f;      ///< Electrical power ceiling (W; needs VBUS_PIN; 0 → no power limit).
+        constexpr float RELEASE_PCT_S = 50.0f; ///< Ceiling recovery rate once back inside the envelope (%/s).
+        constexpr float RELEASE_RATIO = 0.95f; ///< Recover only below this fraction of the ceiling (hysteresis).
+        constexpr float FLOOR_PCT = 5.0f;      ///< Lowest ceiling: the limiter never stalls the drive outright.
+    } ///< Namespace limit.
+
+    // ---- Freshness budgets (oldest bus frame a consumer acts on; the bus stamps each publish itself) ---- //
+    namespace fresh
+    {
+        constexpr uint32_t CONTROL_MS = tick::HEARTBEAT_MS * 3; ///< PDHandler ← ControlBus: older → throttle 0 (0 → no budget).
+        constexpr uint32_t POWER_FRAMES = 10;                   ///< PDHandler limiter ← PowerBus: older than this many frames → not trusted.
+    } ///< Namespace fresh.
+
+    // ---- Bridge protection (FaultGuard: fault input + Vbus over-voltage) ---- //
+    namespace fault
+    {
+        constexpr bool ENABLED = false;      ///< Arm FaultGuard (needs FAULT_PIN and/or adc::VBUS_PIN).
+        constexpr int FAULT_PIN = -1;        ///< Driver fault input (-1 → none); also the MCPWM fault-detect input.
+        constexpr bool ACTIVE_LOW = true;    ///< FAULT_PIN asserted level (open-drain nFAULT → low, pulled up).
+        constexpr float OV_VOLTS = 30.0f;    ///< Trip when a frame's mean Vbus exceeds this.
+        constexpr float CLEAR_VOLTS = 27.0f; ///< clear() is refused above this (hysteresis).
+        constexpr uint32_t REPORT_MS = 50;   ///< Vbus publish interval while nothing changes.
+        constexpr UBaseType_t PRIORITY = 10; ///< Fixed: = graph::MAX_PRI, level with the highest graph task.
+    } ///< Namespace fault.
+
+    // ---- Task supervision (Supervisor: heartbeats, deadline misses, stalls, task watchdog) ---- //
+    namespace supervisor
+    {
+        /// @brief What an incident (a stalled task, or MISS_LIMIT misses in one scan) triggers.
+        enum class Response : uint8_t
+        {
+            Log = 0, ///< Log it (HealthBus counts it either way).
+            Degrade, ///< Log + cap the drive duty at DEGRADE_PCT until healthy for RECOVER_MS.
+            Coast    ///< Log + degrade + FaultGuard trip (EN low, latched until 'fault clear'; needs cfg::fault).
+        };
+
+        constexpr bool ENABLED = true;        ///< Run the Supervisor task (heartbeats are kept either way).
+        constexpr Response RESPONSE = Response::Degrade;
+        constexpr uint32_t PERIOD_MS = 50;    ///< Scan / HealthBus publish interval.
+        constexpr uint32_t STALL_MS = 100;    ///< No beat this long past the one due → stalled.
+        constexpr uint32_t MISS_LIMIT = 5;    ///< Deadline misses within one scan that make an incident.
+        constexpr uint32_t RECOVER_MS = 2000; ///< Healthy this long → degrade lifted.
+        constexpr float DEGRADE_PCT = 30.0f;  ///< Drive duty ceiling while degraded (%).
+        constexpr bool TWDT = true;           ///< Supervised tasks feed the task watchdog while their waits are bounded.
+        constexpr uint32_t TWDT_S = 2;        ///< Task watchdog timeout (s): a hang past it panics and reboots in coast.
+        constexpr UBaseType_t PRIORITY = 2;   ///< Fixed (services graph): level with the slowest control task.
+    } ///< Namespace supervisor.
+
+    // ---- Steering servo (SteeringHandler: RMT pulse, updated on every ControlBus publish) ---- //
+    namespace steering
+    {
+        constexpr bool ENABLED = false;      ///< Run SteeringHandler (needs PIN).
+        constexpr int PIN = -1;              ///< Servo signal pin (-1 → none).
+        constexpr uint8_t RMT_CH = 1;        ///< RMT TX channel (0 belongs to the RmtServo drive backend).
+        constexpr uint32_t FRAME_HZ = 50;    ///< Pulse rate: 50 (analogue) .. 333 (digital servos).
+        constexpr uint16_t CENTER_US = 1500; ///< Pulse at steer_cmd 0 (trim here).
+        constexpr uint16_t SPAN_US = 500;    ///< Pulse change at ±100 %.
+        constexpr float LIMIT_PCT = 100.0f;  ///< Largest |steer_cmd| passed on (mechanical end stops).
+        constexpr bool REVERSED = false;     ///< Servo mounted mirrored (left ↔ right).
+    } ///< Namespace steering.
+
+    // ---- Indicators, headlights, horn (LightsService: patterns run in the LEDC hardware) ---- //
+    namespace lights
+    {
+        constexpr bool ENABLED = false;        ///< Run LightsService (needs at least one pin below).
+        constexpr int LEFT_PIN = -1;           ///< Left indicator output (-1 → none).
+        constexpr int RIGHT_PIN = -1;          ///< Right indicator output (-1 → none).
+        constexpr int HEAD_PIN = -1;           ///< Headlight output (-1 → none).
+        constexpr int HORN_PIN = -1;           ///< Horn / piezo driver input (-1 → none).
+        constexpr uint8_t CH_LEFT = 4;         ///< LEDC channel; LEFT / RIGHT share the blink timer (2k, 2k+1).
+        constexpr uint8_t CH_RIGHT = 5;        ///< LEDC channel (blink timer: hazards flash in step).
+        constexpr uint8_t CH_HORN = 6;         ///< LEDC channel; HORN / HEAD share the tone timer (2k, 2k+1).
+        constexpr uint8_t CH_HEAD = 7;         ///< LEDC channel (tone timer: the headlight PWM carrier).
+        constexpr uint8_t BITS = 14;           ///< LEDC resolution (the slowest clock reaches ~1 Hz at 14 bits).
+        constexpr uint32_t BLINK_HZ = 2;       ///< Indicator flash rate (whole Hz: LEDC timer granularity).
+        constexpr uint8_t BLINK_DUTY_PCT = 50; ///< Lit share of each flash.
+        constexpr uint32_t HORN_HZ = 2000;     ///< Horn tone (square wave).
+        constexpr uint8_t HEAD_PCT = 100;      ///< Headlight brightness.
+    } ///< Namespace lights.
+
+    // ---- Speed encoder (PCNT) + speed loop ---- //
+    namespace encoder
+    {
+        constexpr bool ENABLED = false;         ///< Close the speed loop on the encoder (false → open-loop duty).
+        constexpr int PIN_A = 4;                ///< Encoder channel A (counted edges).
+        constexpr int PIN_B = 5;                ///< Encoder channel B (direction; -1 → single-channel tach).
+        constexpr int PCNT_UNIT = 0;            ///< PCNT unit (0..3).
+        constexpr uint32_t COUNTS_PER_REV = 20; ///< Channel A rising edges per shaft revolution.
+        constexpr uint32_t GLITCH_NS = 1000;    ///< Ignore pulses shorter than this (≤ ~12.7 µs).
+        constexpr uint32_t WINDOW_US = 10000;   ///< Speed sample / PI update / telemetry period.
+        constexpr float MAX_RPM = 3000.0f;      ///< Setpoint at 100 % throttle command.
+        constexpr float KP = 0.02f;             ///< Proportional gain (% duty per rpm).
+        constexpr float KI = 0.20f;             ///< Integral gain (% duty per rpm·s).
+        constexpr float KD = 0.0f;              ///< Derivative gain (% duty per rpm/s); 0 → PI.
+        constexpr float TRIM_PCT = 30.0f;       ///< Max |correction| added to the feed-forward duty.
+    } ///< Namespace encoder.
+
+    // ---- Remote Control (RCLink iBUS / SBUS / CRSF) ---- //
     namespace rc
     {
-        constexpr int UART_RX = 18;       ///< iBUS data in.
-        constexpr int UART_TX = -1;       ///< Not required for iBUS (disabled).
-        constexpr uint32_t BAUD = 115200; ///< iBUS baud rate.
+        /// @brief Receiver protocol on UART_RX.
+        enum class Protocol : uint8_t
+        {
+            Ibus = 0, ///< FlySky iBUS via RCLink (115200).
+            Sbus,     ///< Futaba SBUS (100000 8E2, inverted), SbusTransport.
+            Crsf,     ///< TBS Crossfire / ExpressLRS, CrsfTransport.
+            EspNow    ///< ESP-NOW packets from the pit station, EspNowTransport (needs espnow::ENABLED; no UART).
+        };
+
+        constexpr Protocol PROTOCOL = Protocol::Ibus; ///< Active receiver protocol.
+        constexpr int UART_RX = 18;                   ///< Receiver data in.
+        constexpr int UART_TX = -1;                   ///< iBUS/SBUS: unused; CRSF: set to enable the telemetry back-channel.
+        constexpr uint32_t BAUD = 115200;             ///< iBUS baud rate.
+        constexpr uint32_t CRSF_BAUD = 420000;        ///< CRSF line rate (ELRS receivers may be configured higher).
+        constexpr uint32_t LINK_TIMEOUT_MS = 50;      ///< No frame for this long → failsafe (all protocols).
+        constexpr uint32_t HEARTBEAT_MS = 50;         ///< RcPublisher republishes unchanged frames this often.
+        constexpr uint32_t STALE_MS = 150;            ///< ControlCore treats RC frames older than this as lost.
+        constexpr bool RX_EVENT = true;               ///< Wake RcPublisher per received frame (UART RX timeout) instead of polling.
+        constexpr uint8_t RX_TIMEOUT_SYM = 2;         ///< Idle symbols that end a frame (iBUS idles ~4 ms between 7 ms frames).
+        constexpr uint32_t RX_IDLE_MS = 25;           ///< Without data, still wake this often (link timeout + heartbeat).
+        constexpr uint32_t STATS_MS = 1000;           ///< RcLinkBus publish period (frame rate window).
     } ///< Namepsace rc.
+
+    // ---- RC command smoothing (ControlCore alpha-beta tracker; consumers extrapolate between frames) ---- //
+    namespace smooth
+    {
+        constexpr bool ENABLED = true;              ///< Filter Remote throttle / steering and publish their rates (false → raw, rate 0).
+        constexpr float ALPHA = 0.5f;               ///< Value gain (1 → raw stick, lower → smoother and laggier).
+        constexpr float BETA = 0.1f;                ///< Rate gain (0 → no rate, no extrapolation).
+        constexpr float MAX_RATE = 5000.0f;         ///< Published rate limit (± %/s; 100 % in 20 ms).
+        constexpr uint32_t MIN_DT_US = 1000;        ///< RC frames closer than this skip the rate update (µs).
+        constexpr uint32_t RESET_MS = rc::STALE_MS; ///< A longer gap between RC frames restarts the track.
+        constexpr uint32_t HORIZON_MS = 20;         ///< Consumers extrapolate at most this far past origin_us.
+        constexpr uint32_t STEER_MS = 5;            ///< SteeringHandler re-applies this often while steer_rate ≠ 0.
+    } ///< Namespace smooth.
+
+    // ---- ESP-NOW link (EspNowLink: RC in from the pit station, batched telemetry out) ---- //
+    namespace espnow
+    {
+        constexpr bool ENABLED = false;                                      ///< Start Wi-Fi (STA, never associated) and ESP-NOW.
+        constexpr uint8_t CHANNEL = 1;                                       ///< Wi-Fi channel shared by every car and the pit station.
+        constexpr uint8_t CAR_ID = 1;                                        ///< This car's number: tags telemetry, selects RC packets.
+        constexpr uint8_t PIT_MAC[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}; ///< Telemetry destination (broadcast: any pit receiver).
+        constexpr uint8_t RC_MAC[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};  ///< Only accept RC from this sender (all 0xFF → any sender).
+        constexpr uint32_t TX_PERIOD_MS = 20;                                ///< Telemetry packet period (one packet carries every fresh bus).
+        constexpr uint32_t DESCRIBE_MS = 2000;                               ///< Packed layouts are re-announced this often.
+        constexpr UBaseType_t PRIORITY = 2;                                  ///< Telemetry task priority (below every pipeline stage).
+    } ///< Namespace espnow.
+
+    // ---- Bus bridge (BusBridge: buses mirrored to a second board over UART) ---- //
+    namespace bridge
+    {
+        /// @brief Which half of a two-board vehicle this firmware runs.
+        enum class Role : uint8_t
+        {
+            Off = 0, ///< Single board (no bridge).
+            Front,   ///< Inputs, RC and ControlCore here: ControlBus out, TelemetryBus back.
+            Rear     ///< Drive here: ControlBus in from the front board, TelemetryBus out.
+        };
+
+        constexpr Role ROLE = Role::Off;          ///< This board's half.
+        constexpr int UART = 1;                   ///< 1: Serial1 (telemetry / OTA off); 2: Serial2 (rear only: no receiver).
+        constexpr int RX_PIN = 35;                ///< Bridge RX (peer's TX).
+        constexpr int TX_PIN = 36;                ///< Bridge TX (peer's RX).
+        constexpr uint32_t BAUD = 4000000;        ///< Line rate (both boards; S3 UARTs run to 5 Mbaud).
+        constexpr uint32_t RX_BUFFER = 1024;      ///< UART RX ring (bytes).
+        constexpr uint32_t TX_BUFFER = 1024;      ///< UART TX ring (bytes); frames that don't fit are dropped.
+        constexpr uint8_t RX_TIMEOUT_SYM = 2;     ///< Idle symbols before the RX callback fires (wakes the task per burst).
+        constexpr uint32_t KEY_MS = 500;          ///< Full (key) frame at least this often per bus; deltas in between.
+        constexpr uint32_t PING_MS = 20;          ///< Round-trip probe period (latency, clock offset, liveness).
+        constexpr uint32_t LINK_TIMEOUT_MS = 100; ///< No frame for this long → link lost (inbound buses take their safe value).
+    } ///< Namespace bridge.
+
+    // ---- Binary telemetry stream (TelemetryStream → tools/telemetry_decode.py) ---- //
+    namespace telemetry
+    {
+        constexpr bool ENABLED = false;        ///< Stream bus payloads as COBS/CRC frames on Serial1.
+        constexpr int TX_PIN = 41;             ///< Stream UART TX (no RX; wire to a USB-UART RX).
+        constexpr uint32_t BAUD = 2000000;     ///< Line rate (1 kHz drive telemetry needs ≥ 460800).
+        constexpr uint32_t TX_BUFFER = 2048;   ///< UART TX ring (bytes); frames that don't fit are dropped.
+        constexpr uint32_t IDLE_MS = 100;      ///< Longest sleep without a publish.
+        constexpr bool PACKED = true;          ///< Input / RC / control / drive as wire:: packed layouts (false: raw structs).
+        constexpr uint32_t DESCRIBE_MS = 2000; ///< Packed layouts are re-announced this often (decoders joining late, log wrap).
+    } ///< Namespace telemetry.
+
+    // ---- Flight recorder (PSRAM ring → flash dump on failsafe / fault / panic) ---- //
+    namespace recorder
+    {
+        constexpr bool ENABLED = false;             ///< Record Input/Rc/Control publishes (needs PSRAM + a data partition).
+        constexpr const char *PARTITION = "spiffs"; ///< Dump partition label (custom_*_16MB.csv: 2.8-2.9 MB → 4 dumps).
+        constexpr std::size_t RECORDS = 8192;       ///< Ring entries (72 B each; ~10 s at iBUS rate + inputs).
+        constexpr uint32_t POST_MS = 1000;          ///< Keep recording this long after a trigger.
+        constexpr uint32_t IDLE_MS = 100;           ///< Longest sleep without a publish.
+        constexpr UBaseType_t PRIORITY = 2;         ///< Fixed (services graph): above background, level with the slowest control task.
+    } ///< Namespace recorder.
+
+    // ---- Bus replay (BusReplay: a FlightRecorder dump played back into the pipeline) ---- //
+    namespace replay
+    {
+        /// @brief Which stage the recording feeds.
+        enum class Target : uint8_t
+        {
+            Control = 0, ///< Input + Rc records → ControlCore (its output is compared with the recorded Control records).
+            Drive        ///< Control records → PowerDriveHandler (ControlCore not started).
+        };
+
+        constexpr bool ENABLED = false;            ///< Bench only: replaces the button / RC producers, the motor follows the recording.
+        constexpr Target TARGET = Target::Control; ///< Stage under test.
+        constexpr uint32_t ACK_MS = 20;            ///< Longest wait for the stage to answer one record.
+        constexpr std::size_t CHUNK = 32;          ///< Records per partition read (72 B each).
+        constexpr UBaseType_t PRIORITY = 2;        ///< Fixed (critical graph): below every stage it feeds.
+    } ///< Namespace replay.
+
+    // ---- Raw flash log (FlashLog: circular log on a custom data partition) ---- //
+    namespace flashlog
+    {
+        constexpr bool ENABLED = false;             ///< Mirror telemetry frames into the rawlog partition (needs telemetry::ENABLED).
+        constexpr const char *PARTITION = "rawlog"; ///< Partition label (custom_*_16MB.csv).
+        constexpr uint8_t SUBTYPE = 0x40;           ///< Custom data subtype (0x40..0xFE are free for applications).
+        constexpr std::size_t RECORD_BYTES = 64;    ///< Fixed record size (63 records per 4 KB sector).
+        constexpr std::size_t RING_RECORDS = 256;   ///< Producer ring (16 KB; rides out one sector erase at ~100 KB/s).
+        constexpr uint32_t POLL_MS = 20;            ///< Writer wake interval without a full sector.
+        constexpr uint32_t FLUSH_MS = 1000;         ///< Longest a partial sector waits in RAM.
+        constexpr uint32_t QUIET_MS = 500;          ///< No records for this long → erase ahead.
+        constexpr uint32_t ERASE_AHEAD_KB = 2048;   ///< Blank flash kept ahead of the head (~20 s at 100 KB/s).
+    } ///< Namespace flashlog.
+
+    // ---- Calibration blob (calib::begin → tools/make_calib.py) ---- //
+    namespace calib
+    {
+        constexpr const char *PARTITION = "calib"; ///< Partition label (custom_*_16MB.csv); missing → compiled defaults.
+        constexpr uint8_t SUBTYPE = 0x41;          ///< Custom data subtype.
+    } ///< Namespace calib.
+
+    // ---- Over-the-air update (OtaService ← tools/ota_upload.py over Serial1, instead of the telemetry stream) ---- //
+    namespace ota
+    {
+        constexpr bool ENABLED = false;        ///< Accept images on Serial1; a new image stays pending until OtaService confirms it.
+        constexpr int RX_PIN = 42;             ///< Serial1 RX (from the host's TX).
+        constexpr int TX_PIN = 41;             ///< Serial1 TX (acks back to the host; the telemetry pin).
+        constexpr uint32_t BAUD = 921600;      ///< Line rate (~90 KB/s: one chunk every ~45 ms before throttling).
+        constexpr std::size_t CHUNK = 4096;    ///< Bytes per ack = one flash sector (one erase + program per write).
+        constexpr uint32_t GAP_MS = 20;        ///< Minimum pause between flash bursts.
+        constexpr uint32_t MAX_GAP_MS = 500;   ///< Back-off ceiling while bursts still cost the drive loop overruns.
+        constexpr uint32_t BASELINE_MS = 500;  ///< Drive-loop jitter baseline taken before the first write.
+        constexpr uint32_t TIMEOUT_MS = 5000;  ///< Host silence that aborts a transfer.
+        constexpr uint32_t POLL_MS = 50;       ///< Header poll interval while idle.
+        constexpr bool AUTO_REBOOT = true;     ///< Reboot into the new image once the drive is idle.
+        constexpr uint32_t CONFIRM_MS = 10000; ///< New image: still healthy this long after boot → valid, else roll back.
+    } ///< Namespace ota.
+
+    // ---- Diagnostics ---- //
+    namespace trace
+    {
+        constexpr bool LATENCY = DEBUGGING; ///< Record per-stage latency histograms (trace::latency()).
+        constexpr bool COST = DEBUGGING;    ///< Time each ControlCore / PowerDriveHandler activation (trace::cost()).
+    } ///< Namespace trace.
+
+    // ---- Levelled logging (logError .. logTrace; console output from debug* is not filtered) ---- //
+    namespace logging
+    {
+        /// @brief Severity (a site logs when its level is at or below the module's level).
+        enum class Level : uint8_t
+        {
+            Off = 0, ///< Nothing.
+            Error,   ///< Something failed; the firmware works around it or stops that feature.
+            Warn,    ///< Degraded or unexpected, still running.
+            Info,    ///< Button events, state changes and start-up configuration.
+            Debug,   ///< Detail beyond a normal bench run.
+            Trace    ///< Per-iteration detail (hot loops).
+        };
+
+        /// @brief Log sources (each module's kLogModule; sites outside a module use App).
+        enum class Module : uint8_t
+        {
+            App = 0,    ///< setup() / main.cpp.
+            Input,      ///< StateManager, button backends.
+            Rc,         ///< RcPublisher, receiver transports.
+            Control,    ///< ControlCore.
+            Drive,      ///< PowerDriveHandler, SpeedEncoder.
+            Steering,   ///< SteeringHandler.
+            Power,      ///< PowerManager, AdcService.
+            Fault,      ///< FaultGuard.
+            Lights,     ///< LightsService.
+            Storage,    ///< Calibration, FlashLog, FlightRecorder, BusReplay.
+            Ota,        ///< OtaService.
+            Radio,      ///< EspNowLink, BusBridge.
+            Tune,       ///< AutoTuner.
+            Supervisor, ///< Supervisor, TaskProfiler.
+            Count
+        };
+
+        constexpr Level BUILD = DEBUGGING ? Level::Debug : Level::Warn; ///< Compiled-in ceiling for every module not overridden below.
+
+        /// @brief Compiled-in ceiling per module (index Module): sites above it are not compiled at all.
+        constexpr Level MODULE[static_cast<std::size_t>(Module::Count)] = {
+            BUILD,                                 // App
+            BUILD,                                 // Input
+            BUILD,                                 // Rc
+            BUILD,                                 // Control
+            DEBUGGING ? Level::Info : Level::Warn, // Drive: 1 kHz loop, Debug / Trace sites stay out of the build
+            BUILD,                                 // Steering
+            BUILD,                                 // Power
+            BUILD,                                 // Fault
+            BUILD,                                 // Lights
+            BUILD,                                 // Storage
+            BUILD,                                 // Ota
+            BUILD,                                 // Radio
+            BUILD,                                 // Tune
+            BUILD,                                 // Supervisor
+        };
+
+        constexpr Level RUNTIME = DEBUGGING ? Level::Info : Level::Warn; ///< Starting runtime level, every module ('log' command changes it).
+    } ///< Namespace logging.
+
+    namespace console
+    {
+        constexpr uint32_t POLL_MS = 20; ///< DebugConsole Serial poll interval.
+    } ///< Namespace console.
+
+    namespace boot
+    {
+        constexpr uint32_t DRIVABLE_WAIT_MS = 100; ///< setup() waits this long for PowerDriveHandler's first step.
+    } ///< Namespace boot.
+
+    namespace graph
+    {
+        constexpr UBaseType_t BASE_PRI = 1; ///< rtos::TaskGraph background priority (timed tasks rank above it).
+        constexpr UBaseType_t MAX_PRI = 10; ///< Highest priority the graph assigns (keeps clear of IDF system tasks).
+        constexpr uint32_t SETTLE_MS = 5;   ///< Max wait per consumer to reach its first block at start-up.
+    } ///< Namespace graph.
+
+    namespace tune
+    {
+        constexpr bool ENABLED = DEBUGGING;   ///< 'tune' console command; a saved plan is applied to the critical graph at boot.
+        constexpr uint32_t SETTLE_MS = 2000;  ///< Boot → trial window opens (profiler samples and caches settle).
+        constexpr uint32_t TRIAL_MS = 8000;   ///< Measurement window per trial (one reboot each).
+        constexpr uint32_t MIN_GAIN_PCT = 10; ///< Same misses and p99 bucket: the mean latency must drop this much to win.
+        constexpr UBaseType_t PRIORITY = 1;   ///< Fixed (services graph): background.
+    } ///< Namespace tune.
+
+    namespace memory
+    {
+        constexpr bool STATIC_TASKS = false;    ///< Task stacks / TCBs from mem::stacks() (xTaskCreateStatic*) instead of the heap.
+        constexpr uint32_t STACK_POOL = 40960;  ///< Stack pool size, in the units of the *_STACK constants (sum of every task's stack).
+        constexpr std::size_t MAX_TASKS = 16;   ///< TCBs in the pool.
+        constexpr std::size_t MAX_REGIONS = 24; ///< Named static regions mem::report() can list.
+    } ///< Namespace memory.
+
+    namespace hotpath
+    {
+        constexpr const char *BENCH_PARTITION = "bench"; ///< Scratch data partition the 'jitter erase' bench erases (add ≥ 64 KB to the csv).
+        constexpr uint32_t BENCH_SECTORS = 16;           ///< 4 KB sectors erased per bench run.
+        constexpr uint32_t BENCH_MS = 1000;              ///< Measurement window, idle and during the erase.
+        constexpr uint32_t JITTER_TOL_US = 100;          ///< Max-period growth still counted as flat.
+    } ///< Namespace hotpath.
+
+    namespace bench
+    {
+        constexpr bool ENABLED = DEBUGGING; ///< 'bench' console command: button update() / snapshot() cycles for N = 1..64.
+        constexpr uint32_t RUNS = 500;      ///< Timed calls per table cell (min and mean reported).
+        constexpr int HC165_LOAD = -1;      ///< 74HC165 chain SH/LD pin (-1 → shift-register column skipped).
+        constexpr int HC165_CLK = -1;       ///< 74HC165 CLK pin.
+        constexpr int HC165_DATA = -1;      ///< 74HC165 QH pin of the last chip.
+        constexpr int MCP_SDA = -1;         ///< MCP23017 I2C SDA (-1 → expander column skipped).
+        constexpr int MCP_SCL = -1;         ///< MCP23017 I2C SCL.
+        constexpr uint32_t MCP_HZ = 400000; ///< I2C clock.
+        constexpr uint8_t MCP_ADDR = 0x20;  ///< First expander address (chip k at MCP_ADDR + k).
+    } ///< Namespace bench.
+
+    namespace profiler
+    {
+        constexpr bool ENABLED = DEBUGGING;        ///< Sample per-task stack / CPU / overruns onto buses::profile().
+        constexpr uint32_t PERIOD_MS = 1000;       ///< Sample interval (CPU load is averaged over it).
+        constexpr uint32_t STACK_WARN_WORDS = 256; ///< Log once when a task's free stack drops below this.
+    } ///< Namespace profiler.
 } ///< Namespace cfg.
 
 // ---- Application button mapping ---- //
@@ -123,6 +635,10 @@ namespace cfg
     X(IndicatorLeft, 8) \
     X(IndicatorRight, 9)
 
+// ---- Application button chords (name, member, member; pressed within BTN_CHORD_MS) ---- //
+#define CHORD_LIST(X) \
+    X(Hazard, IndicatorLeft, IndicatorRight)
+
 // ---- Remote control channel mapping ---- //
 #define RC_ROLES(X)             \
     X(steering)   /* Ch1_RH */  \
@@ -136,4 +652,7 @@ namespace cfg
     X(mode)       /* Ch9_SwC */ \
     X(obstacle)   /* Ch10_SwD */
 
-RC_DECLARE_ROLES(RC, RC_ROLES) ///< RCLink enum builder.
\ No newline at end of file
+RC_DECLARE_ROLES(RC, RC_ROLES) ///< RCLink enum builder.
+
+// ---- Levelled logging (after cfg::logging) ---- //
+#include <LogFilter.h>
\ No newline at end of file
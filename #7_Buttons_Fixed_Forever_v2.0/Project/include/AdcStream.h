@@ -0,0 +1,176 @@
+/**
+ * MIT License
+ *
+ * @brief ADC1 continuous (DMA) conversion of a few pins, reduced to one calibrated mean per pin per frame.
+ *
+ * @file AdcStream.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+
+/**
+ * @brief Free-running ADC1 conversions into DMA frames (ESP32-S3, IDF 4.4 adc_digi driver).
+ *
+ * The controller converts the added pins round-robin at sample_hz (total,
+ * shared by all pins) and hands over one frame of FrameSamples results per
+ * DMA interrupt. read() blocks for the next frame and reduces it to a mean
+ * per pin, converted to mV with the eFuse calibration (the same curve
+ * analogReadMilliVolts() uses). No conversion ever runs on the caller's
+ * time: a reader only pays for the frame copy and a few additions.
+ *
+ * @note There is one digital ADC controller: one AdcStream per firmware, and
+ *       no analogRead() on ADC1 pins while it runs.
+ * @tparam FrameSamples Conversions per frame (all pins together).
+ */
+template <std::size_t FrameSamples = 16>
+class AdcStream
+{
+public:
+    static constexpr std::size_t kMaxChannels = 4; ///< Pins per stream.
+
+    /// @brief One reduced frame.
+    struct Frame
+    {
+        std::array<uint32_t, kMaxChannels> mv{}; ///< Mean pin voltage per slot (mV).
+        std::array<uint8_t, kMaxChannels> n{};   ///< Samples behind each mean (0 → none this frame).
+    };
+
+    /**
+     * @brief Add a pin (before begin()).
+     *
+     * @param gpio ADC1 pin (GPIO1..10 on the S3).
+     * @return int Slot for Frame lookups, or -1 (not ADC1, full, or already running).
+     */
+    int add(int gpio) noexcept
+    {
+        if (running_ || count_ >= kMaxChannels || gpio < 0)
+            return -1;
+        const int8_t ch = digitalPinToAnalogChannel(gpio);
+        if (ch < 0 || ch > 9)
+            return -1; ///< ADC1 only: ADC2 is shared with Wi-Fi.
+        ch_[count_] = static_cast<uint8_t>(ch);
+        return static_cast<int>(count_++);
+    }
+
+    /**
+     * @brief Configure the pattern and start converting.
+     *
+     * @param sample_hz Total conversion rate (611 Hz .. 83.3 kHz).
+     * @return true If the DMA stream is running.
+     */
+    bool begin(uint32_t sample_hz) noexcept
+    {
+        if (running_ || count_ == 0)
+            return false;
+
+        adc_digi_init_config_t ic{};
+        ic.max_store_buf_size = 2 * kFrameBytes; ///< Two frames: a late reader sees recent samples, not a backlog.
+        ic.conv_num_each_intr = kFrameBytes;     ///< One DMA interrupt per frame.
+        for (std::size_t i = 0; i < count_; ++i)
+            ic.adc1_chan_mask |= 1UL << ch_[i];
+        if (adc_digi_initialize(&ic) != ESP_OK)
+            return false;
+
+        std::array<adc_digi_pattern_config_t, kMaxChannels> pat{};
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            pat[i].atten = ADC_ATTEN_DB_11;
+            pat[i].channel = ch_[i];
+            pat[i].unit = 0; ///< ADC1.
+            pat[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        }
+
+        adc_digi_configuration_t dc{};
+        dc.conv_limit_en = false;
+        dc.pattern_num = static_cast<uint32_t>(count_);
+        dc.adc_pattern = pat.data();
+        dc.sample_freq_hz = sample_hz;
+        dc.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        dc.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+        if (adc_digi_controller_configure(&dc) != ESP_OK || adc_digi_start() != ESP_OK)
+        {
+            adc_digi_deinitialize();
+            return false;
+        }
+
+        esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, kDefaultVrefMv, &cal_);
+        frame_us_ = static_cast<uint32_t>((static_cast<uint64_t>(FrameSamples) * 1000000ULL) / (sample_hz ? sample_hz : 1));
+        running_ = true;
+        return true;
+    }
+
+    /// @brief Stop converting and release the controller.
+    void end() noexcept
+    {
+        if (!running_)
+            return;
+        adc_digi_stop();
+        adc_digi_deinitialize();
+        running_ = false;
+    }
+
+    /**
+     * @brief Wait for the next frame and reduce it.
+     *
+     * @param out Means per slot.
+     * @param timeout_ms Longest wait for a frame.
+     * @return true If a frame was read.
+     */
+    bool read(Frame &out, uint32_t timeout_ms) noexcept
+    {
+        uint32_t len = 0;
+        if (!running_ || adc_digi_read_bytes(buf_.data(), kFrameBytes, &len, timeout_ms) != ESP_OK || len == 0)
+            return false;
+
+        std::array<uint32_t, kMaxChannels> sum{};
+        out = Frame{};
+        for (uint32_t i = 0; i + kBytesPerSample <= len; i += kBytesPerSample)
+        {
+            adc_digi_output_data_t d;
+            std::memcpy(&d, &buf_[i], sizeof(d));
+            for (std::size_t s = 0; s < count_; ++s)
+                if (d.type2.channel == ch_[s])
+                {
+                    sum[s] += d.type2.data;
+                    ++out.n[s];
+                    break;
+                }
+        }
+        for (std::size_t s = 0; s < count_; ++s)
+            if (out.n[s] != 0)
+                out.mv[s] = esp_adc_cal_raw_to_voltage(sum[s] / out.n[s], &cal_); ///< Mean first: one curve lookup per pin.
+        return true;
+    }
+
+    /// @brief True once begin() succeeded.
+    [[nodiscard]] bool running() const noexcept { return running_; }
+
+    /// @brief Frame period (µs; 0 before begin()).
+    [[nodiscard]] uint32_t frameUs() const noexcept { return frame_us_; }
+
+private:
+    static constexpr uint32_t kBytesPerSample = sizeof(adc_digi_output_data_t); ///< TYPE2 result size.
+    static constexpr uint32_t kFrameBytes = FrameSamples * kBytesPerSample;     ///< One DMA frame.
+    static constexpr uint32_t kDefaultVrefMv = 1100;                            ///< Used only without eFuse calibration.
+
+    static_assert(FrameSamples >= 1 && FrameSamples <= 255, "Frame::n counts samples in a uint8_t.");
+    static_assert(FrameSamples * 4 <= 4092, "One DMA frame (4 B per sample) must fit one descriptor.");
+
+    std::array<uint8_t, kMaxChannels> ch_{};  ///< ADC1 channel per slot.
+    std::size_t count_{0};                    ///< Used slots.
+    std::array<uint8_t, kFrameBytes> buf_{};  ///< Frame copy.
+    esp_adc_cal_characteristics_t cal_{};     ///< Raw → mV curve.
+    uint32_t frame_us_{0};                    ///< Frame period.
+    bool running_{false};                     ///< DMA stream running.
+};
@@ -0,0 +1,139 @@
+/**
+ * MIT License
+ *
+ * @brief Alpha-beta tracker: smoothed value and rate from irregularly stamped samples.
+ *
+ * @file AlphaBeta.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "FixedPoint.h"
+
+/**
+ * @brief Tracks a jittery command as a value plus a rate (constant-velocity model).
+ *
+ * Each sample is stamped by its source, so the step uses the real spacing
+ * between frames rather than the receiving task's wake time:
+ *
+ *     predicted = value + rate·dt
+ *     residual  = z − predicted
+ *     value     = predicted + α·residual
+ *     rate     += (β / dt)·residual
+ *
+ * α sets how hard the value follows a new sample (1 → raw), β how quickly
+ * the rate follows a trend (0 → rate stays 0, plain exponential smoothing).
+ * The rate is what lets a consumer extrapolate between frames.
+ *
+ * The track restarts at the sample (rate 0) on the first sample, on a stamp
+ * that does not move forward, and after a gap longer than max_gap_us (a
+ * stalled link must not leave a rate behind). Samples closer together than
+ * min_dt_us correct the value only: β/dt would amplify timestamp jitter.
+ * The rate is clamped to ±max_rate.
+ *
+ * Nothing here reads a clock or sleeps. All math goes through num::, so
+ * T = fixed::Q16 runs the same filter with integer arithmetic only.
+ *
+ * @tparam T Number type for values and rates (float or fixed::Fixed).
+ */
+template <typename T = float>
+class BasicAlphaBeta
+{
+public:
+    /// @brief Filter settings.
+    struct Config
+    {
+        T alpha{0.5f};               ///< Value gain (0..1].
+        T beta{0.1f};                ///< Rate gain (0..1; 0 → no rate).
+        T max_rate{5000.0f};         ///< Rate limit (± units/s).
+        uint32_t min_dt_us{1000};    ///< Closer samples skip the rate update (µs).
+        uint32_t max_gap_us{150000}; ///< Longer gaps restart the track (µs).
+    };
+
+    /// @brief Construct with the default gains, untracked.
+    BasicAlphaBeta() noexcept = default;
+
+    /**
+     * @brief Construct with settings, untracked.
+     *
+     * @param c Filter settings.
+     */
+    explicit BasicAlphaBeta(const Config &c) noexcept : c_(c) {}
+
+    /**
+     * @brief Fold in one sample.
+     *
+     * @param z Measured value.
+     * @param stamp_us Source stamp of the sample (µs).
+     */
+    void update(T z, uint64_t stamp_us) noexcept
+    {
+        if (!tracking_ || stamp_us <= stamp_us_ || (stamp_us - stamp_us_) > c_.max_gap_us)
+        {
+            reset(z, stamp_us);
+            return;
+        }
+        const uint32_t dt_us = static_cast<uint32_t>(stamp_us - stamp_us_);
+        stamp_us_ = stamp_us;
+
+        if (dt_us < c_.min_dt_us)
+        {
+            value_ = value_ + c_.alpha * (z - value_); ///< Too close to judge a rate: value correction only.
+            return;
+        }
+        const T dt = num::seconds<T>(dt_us);
+        const T predicted = value_ + rate_ * dt;
+        const T residual = z - predicted;
+        value_ = predicted + c_.alpha * residual;
+        rate_ = num::clamp(rate_ + (c_.beta * residual) / dt, -c_.max_rate, c_.max_rate);
+    }
+
+    /**
+     * @brief Restart the track at a sample (rate 0).
+     *
+     * @param z Value to hold.
+     * @param stamp_us Stamp of that value (µs).
+     */
+    void reset(T z, uint64_t stamp_us) noexcept
+    {
+        value_ = z;
+        rate_ = T{};
+        stamp_us_ = stamp_us;
+        tracking_ = true;
+    }
+
+    /// @brief Forget the track: the next sample restarts it.
+    void clear() noexcept
+    {
+        rate_ = T{};
+        tracking_ = false;
+    }
+
+    /// @brief Smoothed value at stamp().
+    [[nodiscard]] T value() const noexcept { return value_; }
+
+    /// @brief Estimated rate at stamp() (units/s).
+    [[nodiscard]] T rate() const noexcept { return rate_; }
+
+    /// @brief Stamp of the last sample (µs).
+    [[nodiscard]] uint64_t stamp() const noexcept { return stamp_us_; }
+
+    /// @brief True once a sample has started the track (and clear() has not dropped it).
+    [[nodiscard]] bool tracking() const noexcept { return tracking_; }
+
+    /// @brief Filter settings.
+    [[nodiscard]] const Config &config() const noexcept { return c_; }
+
+private:
+    Config c_{};           ///< Filter settings.
+    T value_{};            ///< Smoothed value.
+    T rate_{};             ///< Smoothed rate (units/s).
+    uint64_t stamp_us_{0}; ///< Stamp of the last sample (µs).
+    bool tracking_{false}; ///< False until the first sample.
+};
+
+using AlphaBeta = BasicAlphaBeta<float>; ///< Float tracker.
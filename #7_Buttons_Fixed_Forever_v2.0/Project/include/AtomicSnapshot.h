@@ -0,0 +1,100 @@
+/**
+ * MIT License
+ *
+ * @brief Wait-free snapshot storage for payloads that pack into one 32/64-bit word.
+ *
+ * @file AtomicSnapshot.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <SnapshotBus.h>
+#include <HotPath.h>
+
+namespace snapshot
+{
+    /**
+     * @brief Opt-in packing trait. Specialise for T to store it in a single atomic word.
+     *
+     * A specialisation provides:
+     *  - `using word = uint32_t` or `uint64_t;`
+     *  - `static constexpr word pack(const T &) noexcept;`
+     *  - `static constexpr T unpack(word) noexcept;`
+     *
+     * The primary template is empty, so unspecialised payloads keep the
+     * SnapshotBus seqlock path.
+     */
+    template <typename T>
+    struct atomic_codec
+    {
+    };
+
+    /// @brief True if atomic_codec<T> is specialised.
+    template <typename T, typename = void>
+    struct has_atomic_codec : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct has_atomic_codec<T, std::void_t<typename atomic_codec<T>::word>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool has_atomic_codec_v = has_atomic_codec<T>::value;
+
+    /**
+     * @brief SnapshotBus-compatible store: publish/peek are one atomic store/load.
+     *
+     * No sequence lock, no retry loop and no SNAPSHOTBUS_YIELD(): a reader can
+     * never observe a torn frame because the whole frame is one word.
+     *
+     * @note 32-bit words are native (lock-free) on Xtensa. 64-bit atomics are
+     *       not: GCC lowers them to the IDF's __atomic_*_8 helpers, which take a
+     *       short ISR-safe critical section. That is still bounded (a few dozen
+     *       cycles, no spinning on the writer) but prefer a 32-bit codec when the
+     *       payload fits.
+     * @tparam T Payload type with an atomic_codec specialisation.
+     */
+    template <typename T>
+    class AtomicSnapshot
+    {
+        using codec = atomic_codec<T>;
+        using word = typename codec::word;
+
+        static_assert(std::is_same_v<word, uint32_t> || std::is_same_v<word, uint64_t>,
+                      "atomic_codec<T>::word must be uint32_t or uint64_t.");
+
+    public:
+        /**
+         * @brief Publish a frame (task or ISR context).
+         *
+         * @param v Frame to publish.
+         */
+        void HOT_IRAM publish(const T &v) noexcept
+        {
+            word_.store(codec::pack(v), std::memory_order_release);
+            seq_.fetch_add(1, std::memory_order_release); ///< After the frame: a reader that sees the new sequence sees the frame.
+        }
+
+        /// @brief Latest frame.
+        [[nodiscard]] T HOT_IRAM peek() const noexcept { return codec::unpack(word_.load(std::memory_order_acquire)); }
+
+        /// @brief Number of publishes so far.
+        [[nodiscard]] uint32_t HOT_IRAM sequence() const noexcept { return seq_.load(std::memory_order_acquire); }
+
+    private:
+        std::atomic<word> word_{codec::pack(T{})}; ///< Packed frame.
+        std::atomic<uint32_t> seq_{0};             ///< Publish counter.
+    };
+
+    /// @brief Storage selected for T: AtomicSnapshot if T has a codec, else SnapshotBus.
+    template <typename T>
+    using snapshot_store_t = std::conditional_t<has_atomic_codec_v<T>, AtomicSnapshot<T>, SnapshotBus<T>>;
+} ///< Namespace snapshot.
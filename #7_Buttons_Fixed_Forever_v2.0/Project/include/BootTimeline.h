@@ -0,0 +1,109 @@
+/**
+ * MIT License
+ *
+ * @brief Staged boot helpers: hold the bridge off first, then stamp each stage up to "drivable".
+ *
+ * @file BootTimeline.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace boot
+{
+    /// @brief Boot milestones, in the order setup() reaches them.
+    enum class Mark : uint8_t
+    {
+        Outputs = 0, ///< Bridge enable / PWM pins driven low (coast).
+        Critical,    ///< Input, RC, control and drive tasks released.
+        Drivable,    ///< PowerDriveHandler's first control step (owns the bridge, RC failsafe path live).
+        Services,    ///< Console, profiler, telemetry, logging released.
+        Count
+    };
+
+    /// @brief Human-readable milestone.
+    constexpr const char *to_name(Mark m) noexcept
+    {
+        switch (m)
+        {
+        case Mark::Outputs:
+            return "outputs safe";
+        case Mark::Critical:
+            return "critical up";
+        case Mark::Drivable:
+            return "drivable";
+        case Mark::Services:
+            return "services up";
+        default:
+            return "?";
+        }
+    }
+
+    /// @brief Milestone stamps (µs since the app started; 0 → not reached).
+    inline std::array<uint64_t, static_cast<std::size_t>(Mark::Count)> &stamps() noexcept
+    {
+        static std::array<uint64_t, static_cast<std::size_t>(Mark::Count)> s{};
+        return s;
+    }
+
+    /**
+     * @brief Stamp a milestone (setup() only).
+     *
+     * @param m Milestone.
+     * @param at_us Time it happened (0 → now).
+     */
+    inline void mark(Mark m, uint64_t at_us = 0) noexcept
+    {
+        stamps()[static_cast<std::size_t>(m)] = at_us ? at_us : now_us();
+    }
+
+    /// @brief When @p m was reached (µs since the app started; 0 → not yet).
+    inline uint64_t at(Mark m) noexcept { return stamps()[static_cast<std::size_t>(m)]; }
+
+    /**
+     * @brief Force the H-bridge into coast before anything else is initialised.
+     *
+     * EN low puts BTS7960-style half-bridges in HiZ; both PWM inputs are held
+     * low as well, so nothing can drive the motor until PowerDriveHandler's
+     * first step. The pins are only this safe from the first line of setup():
+     * keep a pull-down on EN for the ROM / bootloader window before it.
+     *
+     * @param en Bridge enable pin (-1 → none).
+     * @param rpwm Right PWM pin (-1 → none).
+     * @param lpwm Left PWM pin (-1 → none).
+     */
+    inline void holdBridgeOff(int en, int rpwm, int lpwm) noexcept
+    {
+        for (const int pin : {en, rpwm, lpwm})
+        {
+            if (pin < 0)
+                continue;
+            digitalWrite(pin, LOW); ///< Latch the level first so the pin never drives high.
+            pinMode(pin, OUTPUT);
+        }
+        mark(Mark::Outputs);
+    }
+
+    /// @brief Print the timeline (ms since the app started; ROM + bootloader time not included).
+    inline void report() noexcept
+    {
+        debug("Boot:");
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Mark::Count); ++i)
+        {
+            const uint64_t t = stamps()[i];
+            if (t == 0)
+                debugf("  %s –", to_name(static_cast<Mark>(i)));
+            else
+                debugf("  %s %u.%01u ms", to_name(static_cast<Mark>(i)), static_cast<unsigned>(t / 1000),
+                       static_cast<unsigned>((t % 1000) / 100));
+        }
+        debugln("");
+    }
+} ///< Namespace boot.
@@ -0,0 +1,481 @@
+/**
+ * MIT License
+ *
+ * @brief Packed wire layouts for the bus snapshots, generated from field tables (BUTTON_LIST / CHORD_LIST / RC_ROLES).
+ *
+ * @file BusSchema.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <Real.h>
+#include <InputBus.h>
+#include <RcBus.h>
+#include <ControlBus.h>
+#include <TelemetryBus.h>
+
+namespace wire
+{
+    // ---- Layout rules ---- //
+    //
+    // A snapshot goes on the wire as its field table, in table order:
+    //   Bit      packed LSB-first into a shared byte; a run of Bits spans as many bytes as it needs,
+    //   U8       one byte,
+    //   I16/I32  little-endian two's complement, value × scale rounded (clamped to the type),
+    //   U64      little-endian.
+    // Every non-Bit field starts on a byte boundary, so the layout is fixed by the table alone.
+    // The table is also sent as descriptor frames (describe()), so decoders learn it from the
+    // stream; the hash names one table (id, types, scales, names) so a decoder can tell two apart.
+
+    /// @brief Field encodings.
+    enum class Type : uint8_t
+    {
+        Bit = 0, ///< One bit (flags, button levels / gesture latches).
+        U8,      ///< Enum or small count.
+        I16,     ///< Scaled real (engineering units × scale).
+        I32,     ///< Wide scaled real (rpm).
+        U64      ///< Stamps (µs).
+    };
+
+    static constexpr uint8_t kDescribeId = 0;   ///< Schema id of descriptor frames (one field each).
+    static constexpr std::size_t kMaxName = 20; ///< Longest field name (keeps a descriptor inside one FlashLog record).
+
+    /// @brief Wire bytes of a non-Bit field.
+    constexpr std::size_t width(Type t) noexcept
+    {
+        switch (t)
+        {
+        case Type::U8:
+            return 1;
+        case Type::I16:
+            return 2;
+        case Type::I32:
+            return 4;
+        case Type::U64:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+
+    /**
+     * @brief One field of a snapshot's wire layout.
+     *
+     * @tparam T Snapshot type.
+     */
+    template <typename T>
+    struct Field
+    {
+        const char *name;                   ///< Column name (≤ kMaxName, unique in the table).
+        Type type;                          ///< Encoding.
+        uint16_t scale;                     ///< Wire value = field × scale (1 for flags, enums, stamps).
+        int64_t (*get)(const T &) noexcept; ///< Field → wire value (before clamping).
+        void (*set)(T &, int64_t) noexcept; ///< Wire value → field.
+    };
+
+    /// @brief Where a field sits in the packed payload.
+    struct Slot
+    {
+        uint16_t byte{0}; ///< Byte offset.
+        uint8_t bit{0};   ///< Bit in that byte (Bit fields).
+    };
+
+    /**
+     * @brief Field table per snapshot (specialise below for every packed snapshot).
+     *
+     * Each specialisation holds kId (wire schema id, shared with telem::Schema: never
+     * reuse one), kName (decoder file name), kFields[] and fix() (rebuilds derived
+     * members, e.g. stamp_ms, after decode).
+     */
+    template <typename T>
+    struct Fields;
+
+    // ---- Compile-time layout ---- //
+
+    /// @brief Offset of every field (layout rules above).
+    template <typename T, std::size_t N>
+    constexpr std::array<Slot, N> slots(const Field<T> (&f)[N]) noexcept
+    {
+        std::array<Slot, N> s{};
+        std::size_t at = 0;   ///< Next free byte.
+        std::size_t open = 0; ///< Byte taking the current run of bits.
+        unsigned bit = 8;     ///< Next bit in open (8 → none open).
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (f[i].type == Type::Bit)
+            {
+                if (bit == 8)
+                {
+                    open = at++;
+                    bit = 0;
+                }
+                s[i] = Slot{static_cast<uint16_t>(open), static_cast<uint8_t>(bit++)};
+                continue;
+            }
+            bit = 8;
+            s[i] = Slot{static_cast<uint16_t>(at), 0};
+            at += width(f[i].type);
+        }
+        return s;
+    }
+
+    /// @brief Payload bytes of a table.
+    template <typename T, std::size_t N>
+    constexpr std::size_t bytes(const Field<T> (&f)[N]) noexcept
+    {
+        const std::array<Slot, N> s = slots(f);
+        return (N == 0) ? 0 : s[N - 1].byte + ((f[N - 1].type == Type::Bit) ? 1 : width(f[N - 1].type));
+    }
+
+    /// @brief Length of a field name (constexpr strlen).
+    constexpr std::size_t name_len(const char *s) noexcept
+    {
+        std::size_t n = 0;
+        while (s[n] != '\0')
+            ++n;
+        return n;
+    }
+
+    /// @brief Names equal (constexpr strcmp == 0).
+    constexpr bool name_eq(const char *a, const char *b) noexcept
+    {
+        std::size_t i = 0;
+        for (; a[i] != '\0' && a[i] == b[i]; ++i)
+        {
+        }
+        return a[i] == b[i];
+    }
+
+    /// @brief True if every name is 1..kMaxName characters, unique, and every scale is usable.
+    template <typename T, std::size_t N>
+    constexpr bool valid(const Field<T> (&f)[N]) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const std::size_t n = name_len(f[i].name);
+            if (n == 0 || n > kMaxName || f[i].scale == 0 || (f[i].type == Type::Bit && f[i].scale != 1))
+                return false;
+            for (std::size_t j = 0; j < i; ++j)
+                if (name_eq(f[i].name, f[j].name))
+                    return false;
+        }
+        return true;
+    }
+
+    /// @brief FNV-1a step.
+    constexpr uint32_t fnv(uint32_t h, uint8_t b) noexcept { return (h ^ b) * 16777619u; }
+
+    /// @brief Hash of one table: schema id and name, then per field type, scale and name.
+    template <typename T, std::size_t N>
+    constexpr uint32_t hash(uint8_t id, const char *table, const Field<T> (&f)[N]) noexcept
+    {
+        uint32_t h = fnv(2166136261u, id);
+        for (const char *c = table; *c != '\0'; ++c)
+            h = fnv(h, static_cast<uint8_t>(*c));
+        h = fnv(h, 0);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            h = fnv(h, static_cast<uint8_t>(f[i].type));
+            h = fnv(h, static_cast<uint8_t>(f[i].scale));
+            h = fnv(h, static_cast<uint8_t>(f[i].scale >> 8));
+            for (const char *c = f[i].name; *c != '\0'; ++c)
+                h = fnv(h, static_cast<uint8_t>(*c));
+            h = fnv(h, 0);
+        }
+        return h;
+    }
+
+    // ---- Field helpers ---- //
+
+    /// @brief real_t / float → scaled wire value (rounded half away from zero).
+    template <typename R>
+    inline int64_t scaled(R v, uint16_t scale) noexcept { return std::lround(num::to_float(v) * scale); }
+
+    /// @brief Scaled wire value → real_t.
+    inline real_t unscaled(int64_t v, uint16_t scale) noexcept { return real_t{static_cast<float>(v) / scale}; }
+
+    /// @brief Value clamped to what @p t holds.
+    constexpr int64_t clamp(Type t, int64_t v) noexcept
+    {
+        switch (t)
+        {
+        case Type::Bit:
+            return v != 0;
+        case Type::U8:
+            return (v < 0) ? 0 : ((v > 0xFF) ? 0xFF : v);
+        case Type::I16:
+            return (v < INT16_MIN) ? INT16_MIN : ((v > INT16_MAX) ? INT16_MAX : v);
+        case Type::I32:
+            return (v < INT32_MIN) ? INT32_MIN : ((v > INT32_MAX) ? INT32_MAX : v);
+        default:
+            return v;
+        }
+    }
+
+    /**
+     * @brief Packed codec for one snapshot type, derived entirely from Fields<T>.
+     *
+     * encode() / decode() unroll over the table at compile time: every field's
+     * accessor and offset is a constant, so they compile to the loads, shifts
+     * and stores a hand-written packer would.
+     *
+     * @tparam T Snapshot type with a Fields<T> specialisation.
+     */
+    template <typename T>
+    struct Codec
+    {
+        using F = Fields<T>;
+        static constexpr std::size_t kCount = sizeof(F::kFields) / sizeof(F::kFields[0]); ///< Fields.
+        static constexpr uint8_t kId = F::kId;                                            ///< Wire schema id.
+        static constexpr std::array<Slot, kCount> kSlots = slots(F::kFields);             ///< Field offsets.
+        static constexpr std::size_t kBytes = bytes(F::kFields);                          ///< Payload bytes.
+        static constexpr uint32_t kHash = hash(F::kId, F::kName, F::kFields);             ///< Layout identity.
+
+        static_assert(kId != kDescribeId, "Schema id 0 is reserved for descriptor frames.");
+        static_assert(kCount > 0 && kCount < 255, "Descriptors count fields in one byte.");
+        static_assert(valid(F::kFields), "Field names must be 1..kMaxName characters and unique; Bit fields take scale 1.");
+        static_assert(name_len(F::kName) > 0 && name_len(F::kName) <= kMaxName, "Table names must be 1..kMaxName characters.");
+
+        /**
+         * @brief Pack @p v.
+         *
+         * @param v Snapshot.
+         * @param out Payload (≥ kBytes).
+         */
+        static void encode(const T &v, uint8_t *out) noexcept
+        {
+            memset(out, 0, kBytes);
+            put_all(v, out, std::make_index_sequence<kCount>{});
+        }
+
+        /**
+         * @brief Unpack a payload.
+         *
+         * @param in Payload (kBytes).
+         * @return T Snapshot (members outside the table default-initialised, derived ones rebuilt).
+         */
+        static T decode(const uint8_t *in) noexcept
+        {
+            T v{};
+            get_all(v, in, std::make_index_sequence<kCount>{});
+            F::fix(v);
+            return v;
+        }
+
+    private:
+        template <std::size_t I>
+        static void put(const T &v, uint8_t *out) noexcept
+        {
+            constexpr const Field<T> &f = F::kFields[I];
+            constexpr Slot s = kSlots[I];
+            const uint64_t w = static_cast<uint64_t>(clamp(f.type, f.get(v)));
+            if constexpr (f.type == Type::Bit)
+                out[s.byte] |= static_cast<uint8_t>(w << s.bit);
+            else
+                for (std::size_t b = 0; b < width(f.type); ++b)
+                    out[s.byte + b] = static_cast<uint8_t>(w >> (8 * b));
+        }
+
+        template <std::size_t I>
+        static void get(T &v, const uint8_t *in) noexcept
+        {
+            constexpr const Field<T> &f = F::kFields[I];
+            constexpr Slot s = kSlots[I];
+            if constexpr (f.type == Type::Bit)
+            {
+                f.set(v, (in[s.byte] >> s.bit) & 1);
+                return;
+            }
+            uint64_t w = 0;
+            for (std::size_t b = 0; b < width(f.type); ++b)
+                w |= static_cast<uint64_t>(in[s.byte + b]) << (8 * b);
+            if constexpr (f.type == Type::I16)
+                f.set(v, static_cast<int16_t>(w));
+            else if constexpr (f.type == Type::I32)
+                f.set(v, static_cast<int32_t>(w));
+            else
+                f.set(v, static_cast<int64_t>(w));
+        }
+
+        template <std::size_t... I>
+        static void put_all(const T &v, uint8_t *out, std::index_sequence<I...>) noexcept { (put<I>(v, out), ...); }
+
+        template <std::size_t... I>
+        static void get_all(T &v, const uint8_t *in, std::index_sequence<I...>) noexcept { (get<I>(v, in), ...); }
+    };
+
+    /**
+     * @brief Descriptor payload @p i of T's table.
+     *
+     * Layout: id:u8 hash:u32 index:u8 count:u8 type:u8 scale:u16 name[≤ kMaxName].
+     * Indices 0..count-1 are the fields; index count names the table (type 0, scale 0).
+     *
+     * @param i Descriptor index (≤ Codec<T>::kCount).
+     * @param out Payload (≥ kMaxDescribe).
+     * @return std::size_t Payload bytes.
+     */
+    template <typename T>
+    std::size_t describe(std::size_t i, uint8_t *out) noexcept
+    {
+        using C = Codec<T>;
+        const bool table = i >= C::kCount;
+        const char *name = table ? Fields<T>::kName : Fields<T>::kFields[i].name;
+        const uint16_t scale = table ? 0 : Fields<T>::kFields[i].scale;
+        out[0] = C::kId;
+        for (std::size_t b = 0; b < 4; ++b)
+            out[1 + b] = static_cast<uint8_t>(C::kHash >> (8 * b));
+        out[5] = static_cast<uint8_t>(table ? C::kCount : i);
+        out[6] = static_cast<uint8_t>(C::kCount);
+        out[7] = table ? 0 : static_cast<uint8_t>(Fields<T>::kFields[i].type);
+        out[8] = static_cast<uint8_t>(scale);
+        out[9] = static_cast<uint8_t>(scale >> 8);
+        const std::size_t n = name_len(name);
+        memcpy(out + 10, name, n);
+        return 10 + n;
+    }
+
+    static constexpr std::size_t kMaxDescribe = 10 + kMaxName; ///< Largest descriptor payload.
+
+    // ---- Tables ---- //
+
+    // Accessor boilerplate shared by the generated entries.
+#define WIRE_GET(T, expr) [](const T &s) noexcept -> int64_t { return (expr); }
+#define WIRE_SET(T, stmt) [](T &s, int64_t v) noexcept { (void)v; stmt; }
+
+    static constexpr uint16_t kRealScale = 100; ///< Commands / RC roles: 0.01 resolution, ±327.67 range.
+
+    /// @brief InputState: levels, taps, doubles, held (one bit per BUTTON_LIST entry each), chords, origin.
+    template <>
+    struct Fields<InputState>
+    {
+        static constexpr uint8_t kId = 7;
+        static constexpr const char *kName = "input";
+
+#define WIRE_BUTTON_BIT(member, prefix, name)                                             \
+    Field<InputState>{prefix #name, Type::Bit, 1,                                         \
+                      WIRE_GET(InputState, s.member[idx(ButtonIndex::name)]),             \
+                      WIRE_SET(InputState, s.member[idx(ButtonIndex::name)] = v != 0)},
+#define WIRE_LEVEL(name, pin) WIRE_BUTTON_BIT(buttons, "", name)
+#define WIRE_TAP(name, pin) WIRE_BUTTON_BIT(taps, "tap_", name)
+#define WIRE_DOUBLE(name, pin) WIRE_BUTTON_BIT(doubles, "dbl_", name)
+#define WIRE_HELD(name, pin) WIRE_BUTTON_BIT(held, "held_", name)
+#define WIRE_CHORD(name, a, b)                                                            \
+    Field<InputState>{"chord_" #name, Type::Bit, 1,                                       \
+                      WIRE_GET(InputState, s.chords[idx(ChordIndex::name)]),              \
+                      WIRE_SET(InputState, s.chords[idx(ChordIndex::name)] = v != 0)},
+
+        static constexpr Field<InputState> kFields[] = {
+            BUTTON_LIST(WIRE_LEVEL) BUTTON_LIST(WIRE_TAP) BUTTON_LIST(WIRE_DOUBLE) BUTTON_LIST(WIRE_HELD) CHORD_LIST(WIRE_CHORD)
+            Field<InputState>{"origin_us", Type::U64, 1, WIRE_GET(InputState, static_cast<int64_t>(s.origin_us)),
+                              WIRE_SET(InputState, s.origin_us = static_cast<uint64_t>(v))},
+        };
+
+#undef WIRE_CHORD
+#undef WIRE_HELD
+#undef WIRE_DOUBLE
+#undef WIRE_TAP
+#undef WIRE_LEVEL
+#undef WIRE_BUTTON_BIT
+
+        static void fix(InputState &s) noexcept { s.stamp_ms = static_cast<uint32_t>(s.origin_us / 1000ULL); }
+    };
+
+    /// @brief RcSnapshot: one I16 per RC_ROLES entry, failsafe, stamp.
+    template <>
+    struct Fields<RcSnapshot>
+    {
+        static constexpr uint8_t kId = 8;
+        static constexpr const char *kName = "rc";
+
+#define WIRE_ROLE(role)                                                                          \
+    Field<RcSnapshot>{#role, Type::I16, kRealScale, WIRE_GET(RcSnapshot, scaled(rc_get(s, RC::role), kRealScale)), \
+                      WIRE_SET(RcSnapshot, s.out[static_cast<std::size_t>(RC::role)] = unscaled(v, kRealScale))},
+
+        static constexpr Field<RcSnapshot> kFields[] = {
+            RC_ROLES(WIRE_ROLE)
+            Field<RcSnapshot>{"failsafe", Type::Bit, 1, WIRE_GET(RcSnapshot, s.failsafe), WIRE_SET(RcSnapshot, s.failsafe = v != 0)},
+            Field<RcSnapshot>{"stamp_us", Type::U64, 1, WIRE_GET(RcSnapshot, static_cast<int64_t>(s.stamp_us)),
+                              WIRE_SET(RcSnapshot, s.stamp_us = static_cast<uint64_t>(v))},
+        };
+
+#undef WIRE_ROLE
+
+        static void fix(RcSnapshot &) noexcept {}
+    };
+
+    /// @brief ControlSnapshot: commands (0.01 %), flags, enums, rates (%/s), origin (stamp_ms is rebuilt).
+    template <>
+    struct Fields<ControlSnapshot>
+    {
+        using C = ControlSnapshot;
+        static constexpr uint8_t kId = 9;
+        static constexpr const char *kName = "control";
+
+        static constexpr Field<C> kFields[] = {
+            {"throttle_cmd_pct", Type::I16, kRealScale, WIRE_GET(C, scaled(s.throttle_cmd_pct, kRealScale)),
+             WIRE_SET(C, s.throttle_cmd_pct = unscaled(v, kRealScale))},
+            {"steer_cmd", Type::I16, kRealScale, WIRE_GET(C, scaled(s.steer_cmd, kRealScale)),
+             WIRE_SET(C, s.steer_cmd = unscaled(v, kRealScale))},
+            {"horn_cmd", Type::Bit, 1, WIRE_GET(C, s.horn_cmd), WIRE_SET(C, s.horn_cmd = v != 0)},
+            {"lights_cmd", Type::Bit, 1, WIRE_GET(C, s.lights_cmd), WIRE_SET(C, s.lights_cmd = v != 0)},
+            {"indicator_cmd", Type::U8, 1, WIRE_GET(C, static_cast<int64_t>(s.indicator_cmd)),
+             WIRE_SET(C, s.indicator_cmd = static_cast<C::Indicator>(v))},
+            {"authority", Type::U8, 1, WIRE_GET(C, static_cast<int64_t>(s.authority)),
+             WIRE_SET(C, s.authority = static_cast<C::Authority>(v))},
+            {"origin_src", Type::U8, 1, WIRE_GET(C, static_cast<int64_t>(s.origin_src)),
+             WIRE_SET(C, s.origin_src = static_cast<C::Source>(v))},
+            {"throttle_rate", Type::I16, 1, WIRE_GET(C, s.throttle_rate), WIRE_SET(C, s.throttle_rate = static_cast<int16_t>(v))},
+            {"steer_rate", Type::I16, 1, WIRE_GET(C, s.steer_rate), WIRE_SET(C, s.steer_rate = static_cast<int16_t>(v))},
+            {"origin_us", Type::U64, 1, WIRE_GET(C, static_cast<int64_t>(s.origin_us)),
+             WIRE_SET(C, s.origin_us = static_cast<uint64_t>(v))},
+        };
+
+        static void fix(C &s) noexcept { s.stamp_ms = static_cast<uint32_t>(s.origin_us / 1000ULL); }
+    };
+
+    /// @brief TelemetrySnapshot: speeds (0.1 rpm), duty / volts / amps (0.01), flags, stamps.
+    template <>
+    struct Fields<TelemetrySnapshot>
+    {
+        using S = TelemetrySnapshot;
+        static constexpr uint8_t kId = 10;
+        static constexpr const char *kName = "telemetry";
+
+        static constexpr Field<S> kFields[] = {
+            {"rpm", Type::I32, 10, WIRE_GET(S, scaled(s.rpm, 10)), WIRE_SET(S, s.rpm = static_cast<float>(v) / 10)},
+            {"setpoint_rpm", Type::I32, 10, WIRE_GET(S, scaled(s.setpoint_rpm, 10)),
+             WIRE_SET(S, s.setpoint_rpm = static_cast<float>(v) / 10)},
+            {"duty_pct", Type::I16, 100, WIRE_GET(S, scaled(s.duty_pct, 100)), WIRE_SET(S, s.duty_pct = static_cast<float>(v) / 100)},
+            {"vbus_v", Type::I16, 100, WIRE_GET(S, scaled(s.vbus_v, 100)), WIRE_SET(S, s.vbus_v = static_cast<float>(v) / 100)},
+            {"amps", Type::I16, 100, WIRE_GET(S, scaled(s.amps, 100)), WIRE_SET(S, s.amps = static_cast<float>(v) / 100)},
+            {"closed_loop", Type::Bit, 1, WIRE_GET(S, s.closed_loop), WIRE_SET(S, s.closed_loop = v != 0)},
+            {"limited", Type::Bit, 1, WIRE_GET(S, s.limited), WIRE_SET(S, s.limited = v != 0)},
+            {"stamp_us", Type::U64, 1, WIRE_GET(S, static_cast<int64_t>(s.stamp_us)),
+             WIRE_SET(S, s.stamp_us = static_cast<uint64_t>(v))},
+            {"origin_us", Type::U64, 1, WIRE_GET(S, static_cast<int64_t>(s.origin_us)),
+             WIRE_SET(S, s.origin_us = static_cast<uint64_t>(v))},
+        };
+
+        static void fix(S &) noexcept {}
+    };
+
+#undef WIRE_SET
+#undef WIRE_GET
+
+    // Hand-written tables cover every member: a struct change must update its table here.
+    static_assert(sizeof(ControlSnapshot) == 32, "ControlSnapshot layout changed: update wire::Fields<ControlSnapshot>.");
+    static_assert(sizeof(TelemetrySnapshot) == 40, "TelemetrySnapshot layout changed: update wire::Fields<TelemetrySnapshot>.");
+    static_assert(sizeof(RcSnapshot) == 56, "RcSnapshot layout changed: update wire::Fields<RcSnapshot>.");
+    static_assert(Codec<InputState>::kCount == 4 * NUM_BUTTONS + NUM_CHORDS + 1, "Fields<InputState> must cover BUTTON_LIST / CHORD_LIST.");
+    static_assert(Codec<RcSnapshot>::kCount == static_cast<std::size_t>(RC::Count) + 2, "Fields<RcSnapshot> must cover RC_ROLES.");
+} ///< Namespace wire.
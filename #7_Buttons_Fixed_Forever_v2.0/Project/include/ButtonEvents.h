@@ -0,0 +1,81 @@
+/**
+ * MIT License
+ *
+ * @brief Timestamped button events (press / release / short / long / double / chord) and their queue.
+ *
+ * @file ButtonEvents.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <app_config.h>
+#include <EventQueue.h>
+
+/**
+ * @brief One discrete button event, in the order it happened.
+ *
+ * InputBus carries levels (latest wins); this carries every edge and gesture,
+ * so a tap shorter than a consumer's period is never lost.
+ */
+struct ButtonEvent
+{
+    /// @brief What happened.
+    enum class Kind : uint8_t
+    {
+        Press = 0, ///< Debounced press edge.
+        Release,   ///< Debounced release edge.
+        Short,     ///< Released within BTN_SHORT_MS (and not the second tap of a Double).
+        Long,      ///< Still held after BTN_LONG_MS (sent once, while held).
+        Double,    ///< Second short tap within BTN_DOUBLE_MS of the first release.
+        Chord      ///< CHORD_LIST chord made (button holds the chord index).
+    };
+
+    uint64_t stamp_us{0};   ///< Origin stamp (µs since boot; same clock as InputState::origin_us).
+    uint32_t held_ms{0};    ///< Release / Short / Long: time held (ms).
+    uint8_t button{0};      ///< Button index (ButtonIndex / kButtonNames order; ChordIndex for Chord).
+    Kind kind{Kind::Press}; ///< Event type.
+};
+
+/**
+ * @brief Human-readable event name.
+ */
+constexpr const char *to_name(ButtonEvent::Kind k) noexcept
+{
+    switch (k)
+    {
+    case ButtonEvent::Kind::Press:
+        return "pressed";
+    case ButtonEvent::Kind::Release:
+        return "released";
+    case ButtonEvent::Kind::Short:
+        return "short";
+    case ButtonEvent::Kind::Long:
+        return "long";
+    case ButtonEvent::Kind::Double:
+        return "double";
+    case ButtonEvent::Kind::Chord:
+        return "chord";
+    }
+    return "?";
+}
+
+/**
+ * @brief Type alias for the queue that carries button events (StateManager → ControlCore).
+ */
+using ButtonEventQueue = snapshot::EventQueue<ButtonEvent, cfg::button::BTN_EVENT_QUEUE>;
+
+/**
+ * @brief Single, shared ButtonEventQueue instance.
+ */
+namespace buses
+{
+    inline ButtonEventQueue &buttonEvents() noexcept ///< Return reference to the shared ButtonEventQueue.
+    {
+        static ButtonEventQueue q{}; ///< One (only) ButtonEventQueue instance.
+        return q;                    ///< Return reference to shared queue.
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * MIT License
+ *
+ * @brief Activity-driven loop cadence: boosted after activity, full rate while active, slow or parked when quiet.
+ *
+ * @file Cadence.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <atomic>
+#include <cstdint>
+
+namespace cadence
+{
+    /// @brief Rate tier, fastest first.
+    enum class Tier : uint8_t
+    {
+        Boost = 0, ///< Just after activity: above the normal rate.
+        Active,    ///< Normal rate.
+        Idle,      ///< Quiet for IDLE_AFTER_MS: slow rate.
+        Park       ///< Quiet for PARK_AFTER_MS: block on a wake source where the task has one.
+    };
+
+    /// @brief Short name for consoles.
+    constexpr const char *to_name(Tier t) noexcept
+    {
+        switch (t)
+        {
+        case Tier::Boost:
+            return "boost";
+        case Tier::Active:
+            return "active";
+        case Tier::Idle:
+            return "idle";
+        case Tier::Park:
+            return "park";
+        default:
+            return "?";
+        }
+    }
+} ///< Namespace cadence.
+
+/**
+ * @brief Picks a loop's rate tier from the time since its last activity.
+ *
+ * The owning task calls touch() whenever it sees activity (an edge, a
+ * changed frame, a non-zero duty) and tier() once per iteration to choose
+ * how long to sleep. What counts as activity, and what each tier means in
+ * ticks or timer state, stays with the task: the cadence only keeps time.
+ * Any activity lands back in Boost at once, so a quiet loop costs at most
+ * one slow period of latency on its first edge.
+ *
+ * With cfg::cadence::ENABLED false every call returns Active (fixed rate).
+ *
+ * @note tier() and touch() belong to the owning task; current() and
+ *       parks() are safe from any task (console, profiler).
+ */
+class Cadence
+{
+public:
+    /**
+     * @brief Construct with the tier thresholds.
+     *
+     * @param boost_ms Boost this long after activity (0 → no boost).
+     * @param idle_after_ms Quiet this long → Idle.
+     * @param park_after_ms Quiet this long → Park (≤ idle_after_ms → straight from Active to Park).
+     */
+    explicit Cadence(uint32_t boost_ms = cfg::cadence::BOOST_MS, uint32_t idle_after_ms = cfg::cadence::IDLE_AFTER_MS,
+                     uint32_t park_after_ms = cfg::cadence::PARK_AFTER_MS) noexcept
+        : boost_us_(1000ULL * boost_ms), idle_us_(1000ULL * idle_after_ms), park_us_(1000ULL * park_after_ms) {}
+
+    /// @brief Record activity at @p now (µs).
+    void touch(uint64_t now) noexcept { last_us_ = now; }
+
+    /**
+     * @brief Tier for the next sleep.
+     *
+     * @param now Current time (µs).
+     * @return cadence::Tier Tier by quiet time (Active when disabled).
+     */
+    cadence::Tier tier(uint64_t now) noexcept
+    {
+        if constexpr (!cfg::cadence::ENABLED)
+            return cadence::Tier::Active;
+
+        if (last_us_ == 0)
+            last_us_ = now; ///< First call: quiet time starts here.
+        const uint64_t quiet = now - last_us_;
+        const cadence::Tier t = (quiet < boost_us_) ? cadence::Tier::Boost
+                                : (quiet >= park_us_) ? cadence::Tier::Park
+                                : (quiet >= idle_us_) ? cadence::Tier::Idle
+                                                      : cadence::Tier::Active;
+
+        const auto prev = static_cast<cadence::Tier>(tier_.load(std::memory_order_relaxed));
+        if (t != prev)
+        {
+            tier_.store(static_cast<uint8_t>(t), std::memory_order_relaxed);
+            if (t == cadence::Tier::Park)
+                parks_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+    /// @brief Tier of the last tier() call (any task).
+    [[nodiscard]] cadence::Tier current() const noexcept { return static_cast<cadence::Tier>(tier_.load(std::memory_order_relaxed)); }
+
+    /// @brief Times the loop entered Park (any task).
+    [[nodiscard]] uint32_t parks() const noexcept { return parks_.load(std::memory_order_relaxed); }
+
+private:
+    uint64_t boost_us_;                                                        ///< Boost window after activity.
+    uint64_t idle_us_;                                                         ///< Quiet time before Idle.
+    uint64_t park_us_;                                                         ///< Quiet time before Park.
+    uint64_t last_us_{0};                                                      ///< Last activity (0 → none yet).
+    std::atomic<uint8_t> tier_{static_cast<uint8_t>(cadence::Tier::Active)}; ///< Last tier returned.
+    std::atomic<uint32_t> parks_{0};                                           ///< Park entries.
+};
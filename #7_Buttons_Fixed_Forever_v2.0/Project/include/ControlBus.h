@@ -12,7 +12,10 @@
 #pragma once
 
 #include <cstdint>
+#include <app_config.h>
+#include <Real.h>
 #include <SnapshotBus.h>
+#include <SignalBus.h>
 
 /**
  * @brief High-level intent produced by ControlCore.
@@ -20,6 +23,14 @@
  * Services (motor, steering, lights, etc.) should consume this bus and NOT
  * consume raw input sources directly (InputBus / RcBus). That keeps policy
  * and authority decisions centralized.
+ *
+ * Under Remote, throttle and steering are ControlCore's smoothed stick
+ * values at origin_us, and the *_rate fields are their trends. A consumer
+ * that runs faster than the RC frame rate reads throttleAt() / steerAt()
+ * to carry the command forward to its own tick (at most
+ * cfg::smooth::HORIZON_MS) instead of stepping once per frame. Rates are 0
+ * whenever there is nothing to predict, so those calls return the plain
+ * command.
  */
 struct ControlSnapshot
 {
@@ -32,16 +43,85 @@ struct ControlSnapshot
         Hazard
     };
 
-    float throttle_cmd_pct{0.0f};            ///< 0..100 (%). Services may clamp.
+    /// @brief Which source currently owns the commands.
+    enum class Authority : std::uint8_t
+    {
+        Local = 0, ///< On-board buttons.
+        Remote,    ///< RC transmitter (RC::override engaged).
+        Failsafe   ///< RC link lost while Remote held authority → forced stop.
+    };
+
+    /// @brief Which input the origin stamp came from.
+    enum class Source : std::uint8_t
+    {
+        Buttons = 0, ///< InputState::origin_us.
+        Rc           ///< RcSnapshot::stamp_us.
+    };
+
+    real_t throttle_cmd_pct{0.0f};           ///< -100..100 (%; negative → reverse). Services may clamp.
+    real_t steer_cmd{0.0f};                  ///< -100..100 (%; negative → left, 0 → centred).
     bool horn_cmd{false};                    ///< True if horn is pressed.
     Indicator indicator_cmd{Indicator::Off}; ///< Indicator mode.
-    std::uint32_t stamp_ms{0};               ///< Timestamp (ms).
+    Authority authority{Authority::Local};   ///< Source that produced these commands.
+    Source origin_src{Source::Buttons};      ///< Input that origin_us belongs to.
+    std::int16_t throttle_rate{0};           ///< throttle_cmd_pct trend at origin_us (%/s; 0 → hold). See throttleAt().
+    std::int16_t steer_rate{0};              ///< steer_cmd trend at origin_us (%/s; 0 → hold). See steerAt().
+    std::uint64_t origin_us{0};              ///< Origin stamp (µs) of the newest source frame.
+    std::uint32_t stamp_ms{0};               ///< origin_us / 1000 (ms).
+    bool lights_cmd{false};                  ///< Headlights on.
+
+    /**
+     * @brief throttle_cmd_pct carried forward to @p now along throttle_rate.
+     *
+     * Holds at zero rather than crossing it: a gear change is ControlCore's
+     * call, never an extrapolation's.
+     *
+     * @param now Current time (µs).
+     * @return real_t Predicted throttle (%; unclamped).
+     */
+    [[nodiscard]] real_t throttleAt(std::uint64_t now) const noexcept
+    {
+        const real_t p = extrapolate(throttle_cmd_pct, throttle_rate, now);
+        const bool crossed = (throttle_cmd_pct > real_t{}) ? (p < real_t{}) : (throttle_cmd_pct < real_t{} && p > real_t{});
+        return crossed ? real_t{} : p;
+    }
+
+    /**
+     * @brief steer_cmd carried forward to @p now along steer_rate.
+     *
+     * @param now Current time (µs).
+     * @return real_t Predicted steering (%; unclamped).
+     */
+    [[nodiscard]] real_t steerAt(std::uint64_t now) const noexcept { return extrapolate(steer_cmd, steer_rate, now); }
+
+private:
+    /// @brief @p v + @p rate × (now − origin_us), the step capped at cfg::smooth::HORIZON_MS.
+    [[nodiscard]] real_t extrapolate(real_t v, std::int16_t rate, std::uint64_t now) const noexcept
+    {
+        if (rate == 0 || now <= origin_us)
+            return v;
+        constexpr std::uint64_t kHorizonUs = cfg::smooth::HORIZON_MS * 1000ULL;
+        const std::uint64_t dt = (now - origin_us < kHorizonUs) ? now - origin_us : kHorizonUs;
+        return v + num::from_units<real_t>(rate, 1) * num::seconds<real_t>(static_cast<std::uint32_t>(dt));
+    }
 };
 
 /**
  * @brief Type alias for the SnapshotBus that transports control frames.
+ *
+ * Bus storage: SnapshotBus seqlock, on purpose. ControlSnapshot used to
+ * carry a snapshot::atomic_codec (one 64-bit word, no reader retry); the
+ * steering command and the two rates no longer fit that word without
+ * cutting origin_us range or command resolution, so the codec was dropped
+ * rather than the frame split across buses. ControlCore is the only writer,
+ * at most once per RC frame or input edge, and every reader is a task, so a
+ * retry is rare and past SNAPSHOTBUS_SPIN_LIMIT yields instead of spinning.
+ * InputBus keeps its codec wherever the panel fits the word.
+ *
+ * Eight subscriber slots: every service consumes this bus, and a parked
+ * PowerDriveHandler waits on it too.
  */
-using ControlBus = snapshot::SnapshotBus<ControlSnapshot>;
+using ControlBus = snapshot::SignalBus<ControlSnapshot, 8>;
 
 /**
  * @brief Single, shared ControlBus instance.
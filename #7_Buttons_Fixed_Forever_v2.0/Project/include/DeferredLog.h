@@ -0,0 +1,564 @@
+/**
+ * MIT License
+ *
+ * @brief Deferred debug logging: binary records in a lock-free ring, formatted by a drain task.
+ *
+ * @file DeferredLog.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <esp_timer.h>
+#include <type_traits>
+#include <freertos/FreeRTOS.h>
+#include <freertos/portmacro.h>
+#include <freertos/task.h>
+#include <StreamRing.h>
+
+#ifndef DLOG_RING_RECORDS
+// Records buffered between producers and the drain task (power of two).
+#define DLOG_RING_RECORDS 64
+#endif
+
+#ifndef DLOG_DRAIN_POLL_MS
+// Drain task wake interval when idle.
+#define DLOG_DRAIN_POLL_MS 10
+#endif
+
+namespace dlog
+{
+    static constexpr std::size_t kMaxArgs = 8;                 ///< Arguments per record.
+    static constexpr std::size_t kStrPool = 32;                ///< Bytes for copied %s arguments per record.
+    static constexpr std::size_t kRecords = DLOG_RING_RECORDS; ///< Ring capacity.
+    static constexpr std::size_t kLineMax = 192;               ///< Longest formatted line (excess truncated).
+
+    static_assert((kRecords & (kRecords - 1)) == 0, "DLOG_RING_RECORDS must be a power of two.");
+
+    /// @brief Stored argument type (the format conversion decides the printed C type).
+    enum class Kind : std::uint8_t
+    {
+        Int = 0, ///< Signed integer (sign-extended to 64 bits).
+        UInt,    ///< Unsigned integer / pointer.
+        Float,   ///< float or double (stored as double).
+        Str      ///< Copied into the record's string pool (offset in u).
+    };
+
+    /// @brief Line terminator appended by the drain.
+    enum class Eol : std::uint8_t
+    {
+        None = 0, ///< debug() / debugf().
+        Lf,       ///< debugfln(): "\n".
+        CrLf      ///< debugln(): "\r\n" (Serial.println).
+    };
+
+    /**
+     * @brief One log call: format pointer (the format "id") + typed args.
+     *
+     * Formats must be string literals (static storage); string arguments are
+     * copied, so stack buffers are safe to log.
+     */
+    struct Record
+    {
+        const char *fmt{nullptr}; ///< Static format string.
+        uint32_t stamp_us{0};     ///< Low 32 bits of esp_timer time at the call.
+        uint8_t nargs{0};         ///< Used entries in args/kinds.
+        Eol eol{Eol::None};       ///< Terminator.
+        uint8_t pool_len{0};      ///< Used bytes in pool.
+        Kind kinds[kMaxArgs]{};   ///< Argument kinds.
+        union Arg
+        {
+            int64_t i;
+            uint64_t u;
+            double f;
+        } args[kMaxArgs]{};    ///< Argument values.
+        char pool[kStrPool]{}; ///< Copied string arguments (NUL-separated).
+
+        /// @brief Append one argument (types the debug API accepts).
+        template <typename T>
+        void put(const T &v) noexcept;
+    };
+
+    // ---- Argument encoding ---- //
+
+    template <typename T, typename = void>
+    struct has_c_str : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct has_c_str<T, std::void_t<decltype(std::declval<const T &>().c_str())>> : std::true_type
+    {
+    };
+
+    /// @brief Copy @p s into the pool; returns its offset (truncates silently when full).
+    inline uint8_t pool_copy(Record &r, const char *s) noexcept
+    {
+        const uint8_t off = r.pool_len;
+        if (s == nullptr)
+            s = "(null)";
+        while (*s != '\0' && r.pool_len < kStrPool - 1)
+            r.pool[r.pool_len++] = *s++;
+        if (r.pool_len < kStrPool)
+            r.pool[r.pool_len++] = '\0';
+        else
+            r.pool[kStrPool - 1] = '\0';
+        return off;
+    }
+
+    template <typename T>
+    void Record::put(const T &v) noexcept
+    {
+        if (nargs >= kMaxArgs)
+            return;
+
+        using U = std::decay_t<T>;
+        Kind &k = kinds[nargs];
+        Arg &a = args[nargs];
+
+        if constexpr (std::is_same_v<U, const char *> || std::is_same_v<U, char *>)
+        {
+            k = Kind::Str;
+            a.u = pool_copy(*this, v);
+        }
+        else if constexpr (has_c_str<U>::value)
+        {
+            k = Kind::Str;
+            a.u = pool_copy(*this, v.c_str());
+        }
+        else if constexpr (std::is_floating_point_v<U>)
+        {
+            k = Kind::Float;
+            a.f = static_cast<double>(v);
+        }
+        else if constexpr (std::is_enum_v<U>)
+        {
+            k = Kind::Int;
+            a.i = static_cast<int64_t>(v);
+        }
+        else if constexpr (std::is_pointer_v<U>)
+        {
+            k = Kind::UInt;
+            a.u = reinterpret_cast<uintptr_t>(v);
+        }
+        else if constexpr (std::is_signed_v<U>)
+        {
+            k = Kind::Int;
+            a.i = static_cast<int64_t>(v);
+        }
+        else
+        {
+            static_assert(std::is_integral_v<U>, "dlog: unsupported argument type.");
+            k = Kind::UInt;
+            a.u = static_cast<uint64_t>(v);
+        }
+        ++nargs;
+    }
+
+    // ---- Formatting (drain side) ---- //
+
+    /**
+     * @brief Render @p r into @p out (printf semantics, one conversion at a time).
+     *
+     * Each conversion is passed to snprintf with the C type its length
+     * modifier asks for, converted from the stored value, so a %llu fed an
+     * int or a %f fed an integer never reads the wrong vararg width.
+     *
+     * @return std::size_t Bytes written (excluding NUL).
+     */
+    inline std::size_t format(const Record &r, char *out, std::size_t cap) noexcept
+    {
+        if (cap == 0)
+            return 0;
+
+        std::size_t n = 0;
+        std::size_t argi = 0;
+        const char *p = (r.fmt != nullptr) ? r.fmt : "";
+
+        auto emit = [&](const char *s, std::size_t len)
+        {
+            const std::size_t room = cap - 1 - n;
+            const std::size_t m = (len < room) ? len : room;
+            memcpy(out + n, s, m);
+            n += m;
+        };
+        auto next_int = [&]() -> long long
+        {
+            if (argi >= r.nargs)
+                return 0;
+            const auto &a = r.args[argi];
+            const Kind k = r.kinds[argi++];
+            return (k == Kind::Float) ? static_cast<long long>(a.f) : a.i;
+        };
+
+        while (*p != '\0' && n < cap - 1)
+        {
+            if (*p != '%')
+            {
+                const char *q = p;
+                while (*q != '\0' && *q != '%')
+                    ++q;
+                emit(p, static_cast<std::size_t>(q - p));
+                p = q;
+                continue;
+            }
+
+            if (p[1] == '%')
+            {
+                emit("%", 1);
+                p += 2;
+                continue;
+            }
+
+            // ---- Parse one conversion, rewriting '*' into literal digits ---- //
+            char spec[24];
+            std::size_t sl = 0;
+            spec[sl++] = *p++;
+
+            while (*p != '\0' && strchr("-+ #0", *p) != nullptr && sl < sizeof(spec) - 8)
+                spec[sl++] = *p++;
+
+            auto copy_num = [&]()
+            {
+                if (*p == '*')
+                {
+                    sl += static_cast<std::size_t>(snprintf(spec + sl, sizeof(spec) - sl, "%d", static_cast<int>(next_int())));
+                    ++p;
+                    return;
+                }
+                while (*p >= '0' && *p <= '9' && sl < sizeof(spec) - 8)
+                    spec[sl++] = *p++;
+            };
+
+            copy_num(); ///< Width.
+            if (*p == '.')
+            {
+                spec[sl++] = *p++;
+                copy_num(); ///< Precision.
+            }
+
+            int longs = 0;
+            bool size_mod = false;
+            while (*p != '\0' && strchr("hlLqjzt", *p) != nullptr)
+            {
+                if (*p == 'l' || *p == 'q' || *p == 'j' || *p == 'L')
+                    ++longs;
+                if (*p == 'z' || *p == 't')
+                    size_mod = true;
+                ++p; ///< Length modifiers are re-emitted below to match the C type we pass.
+            }
+
+            const char conv = *p;
+            if (conv == '\0')
+                break;
+            ++p;
+
+            char buf[48];
+            int w = 0;
+            const bool have = argi < r.nargs;
+            const Kind k = have ? r.kinds[argi] : Kind::Int;
+            const Record::Arg a = have ? r.args[argi] : Record::Arg{0};
+            if (have)
+                ++argi;
+
+            switch (conv)
+            {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            {
+                const long long iv = (k == Kind::Float) ? static_cast<long long>(a.f) : a.i;
+                if (longs >= 2 || (longs == 1 && sizeof(long) == 8))
+                {
+                    spec[sl++] = 'l';
+                    spec[sl++] = 'l';
+                    spec[sl++] = conv;
+                    spec[sl] = '\0';
+                    w = snprintf(buf, sizeof(buf), spec, iv);
+                }
+                else if (longs == 1 || size_mod)
+                {
+                    spec[sl++] = 'l';
+                    spec[sl++] = conv;
+                    spec[sl] = '\0';
+                    w = snprintf(buf, sizeof(buf), spec, static_cast<long>(iv));
+                }
+                else
+                {
+                    spec[sl++] = conv;
+                    spec[sl] = '\0';
+                    w = snprintf(buf, sizeof(buf), spec, static_cast<int>(iv));
+                }
+                break;
+            }
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+            {
+                double dv = a.f;
+                if (k == Kind::Int)
+                    dv = static_cast<double>(a.i);
+                else if (k != Kind::Float)
+                    dv = static_cast<double>(a.u);
+                spec[sl++] = conv;
+                spec[sl] = '\0';
+                w = snprintf(buf, sizeof(buf), spec, dv);
+                break;
+            }
+            case 'c':
+                spec[sl++] = conv;
+                spec[sl] = '\0';
+                w = snprintf(buf, sizeof(buf), spec, static_cast<int>(a.i));
+                break;
+            case 's':
+                spec[sl++] = conv;
+                spec[sl] = '\0';
+                w = snprintf(buf, sizeof(buf), spec, (k == Kind::Str && a.u < kStrPool) ? &r.pool[a.u] : "?");
+                break;
+            case 'p':
+                spec[sl++] = conv;
+                spec[sl] = '\0';
+                w = snprintf(buf, sizeof(buf), spec, reinterpret_cast<void *>(static_cast<uintptr_t>(a.u)));
+                break;
+            default:
+                buf[0] = '%';
+                buf[1] = conv;
+                w = 2; ///< Unknown conversion: echo it.
+                break;
+            }
+
+            if (w > 0)
+                emit(buf, (static_cast<std::size_t>(w) < sizeof(buf)) ? static_cast<std::size_t>(w) : sizeof(buf) - 1);
+        }
+
+        if (r.eol == Eol::Lf)
+            emit("\n", 1);
+        else if (r.eol == Eol::CrLf)
+            emit("\r\n", 2);
+
+        out[n] = '\0';
+        return n;
+    }
+
+    // ---- Ring + drain ---- //
+
+    /**
+     * @brief Bounded multi-producer / single-consumer record ring and its drain task.
+     *
+     * Records go through a snapshot::MpscRing: producers (any task on either
+     * core, or an ISR) encode straight into a reserved slot, so they never
+     * take a lock or wait on the UART. When the ring is full:
+     *  - ISRs and tasks above the drain priority drop the record (counted, and
+     *    reported by the drain as "[dlog] N dropped");
+     *  - tasks at or below the drain priority (console dumps, setup code) wait
+     *    a tick for space instead, so bulk output is not lost.
+     * Before start() the ring is bypassed and task-context calls print directly.
+     */
+    class Sink
+    {
+    public:
+        /**
+         * @brief Encode and enqueue (or print, before start()) one call.
+         *
+         * @param eol Terminator.
+         * @param fmt Static format string.
+         * @param args Arguments.
+         */
+        template <typename... Args>
+        void emit(Eol eol, const char *fmt, const Args &...args) noexcept
+        {
+            static_assert(sizeof...(Args) <= kMaxArgs, "dlog: too many arguments (raise kMaxArgs).");
+
+            const bool in_isr = xPortInIsrContext();
+
+            if (!running_.load(std::memory_order_acquire) && !in_isr)
+            {
+                Record r{};
+                fill(r, eol, fmt, args...);
+                write(r); ///< No drain yet: synchronous, like the old macros.
+                return;
+            }
+
+            for (;;)
+            {
+                const bool queued = ring_.produce([&](Record &r)
+                                                  {
+                                                      r = Record{};
+                                                      fill(r, eol, fmt, args...);
+                                                  });
+                if (queued)
+                    return;
+
+                if (in_isr || uxTaskPriorityGet(nullptr) > drain_pri_)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed); ///< Hot path: never block.
+                    return;
+                }
+                vTaskDelay(1); ///< Low-priority producer: let the drain catch up.
+            }
+        }
+
+        /**
+         * @brief Start the drain task (call after Serial.begin()).
+         *
+         * @param stack_words Drain task stack (words).
+         * @param priority Drain task priority (keep lowest).
+         * @param core Core to pin the drain to.
+         * @param handle Optional: receives the drain task handle.
+         * @return true If the task was created.
+         */
+        bool start(uint32_t stack_words, UBaseType_t priority, BaseType_t core, TaskHandle_t *handle = nullptr) noexcept
+        {
+            if (running_.load(std::memory_order_acquire))
+                return true;
+
+            drain_pri_ = priority;
+            if (xTaskCreatePinnedToCore(&Sink::task, "dlog", stack_words, this, priority, handle, core) != pdPASS)
+                return false;
+            running_.store(true, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Start the drain task on caller-owned storage (xTaskCreateStaticPinnedToCore, no heap).
+         *
+         * @param stack Stack buffer (@p stack_words entries; must outlive the task).
+         * @param tcb Task control block (must outlive the task).
+         * @param stack_words Drain task stack (words).
+         * @param priority Drain task priority (keep lowest).
+         * @param core Core to pin the drain to.
+         * @param handle Optional: receives the drain task handle.
+         * @return true If the task was created.
+         */
+        bool start(StackType_t *stack, StaticTask_t *tcb, uint32_t stack_words, UBaseType_t priority, BaseType_t core,
+                   TaskHandle_t *handle = nullptr) noexcept
+        {
+            if (running_.load(std::memory_order_acquire))
+                return true;
+
+            drain_pri_ = priority;
+            const TaskHandle_t t = xTaskCreateStaticPinnedToCore(&Sink::task, "dlog", stack_words, this, priority, stack, tcb, core);
+            if (t == nullptr)
+                return false;
+            if (handle != nullptr)
+                *handle = t;
+            running_.store(true, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Records dropped because the ring was full.
+        [[nodiscard]] uint32_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        /// @brief FreeRTOS task trampoline.
+        static void task(void *self) { static_cast<Sink *>(self)->drain(); }
+
+        template <typename... Args>
+        static void fill(Record &r, Eol eol, const char *fmt, const Args &...args) noexcept
+        {
+            r.fmt = fmt;
+            r.eol = eol;
+            r.stamp_us = static_cast<uint32_t>(esp_timer_get_time());
+            (r.put(args), ...);
+        }
+
+        /// @brief Format and send one record.
+        static void write(const Record &r) noexcept
+        {
+            char line[kLineMax];
+            const std::size_t n = format(r, line, sizeof(line));
+            Serial.write(reinterpret_cast<const uint8_t *>(line), n);
+        }
+
+        /// @brief Drain loop: format everything queued, then sleep.
+        void drain() noexcept
+        {
+            const TickType_t idle = pdMS_TO_TICKS(DLOG_DRAIN_POLL_MS) > 0 ? pdMS_TO_TICKS(DLOG_DRAIN_POLL_MS) : 1;
+            uint32_t reported = 0;
+
+            for (;;)
+            {
+                ring_.drain(&Sink::write); ///< Up to the first record still being filled.
+
+                const uint32_t d = dropped();
+                if (d != reported)
+                {
+                    char msg[40];
+                    const int n = snprintf(msg, sizeof(msg), "[dlog] %u dropped\r\n", static_cast<unsigned>(d - reported));
+                    Serial.write(reinterpret_cast<const uint8_t *>(msg), static_cast<std::size_t>(n));
+                    reported = d;
+                }
+
+                vTaskDelay(idle);
+            }
+        }
+
+        snapshot::MpscRing<Record, kRecords> ring_{}; ///< Records between producers and the drain.
+        std::atomic<uint32_t> dropped_{0};            ///< Full-ring drops.
+        std::atomic<bool> running_{false};            ///< Drain task started.
+        UBaseType_t drain_pri_{0};                    ///< Producers at/below this priority wait instead of dropping.
+    };
+
+    /**
+     * @brief Single, shared log sink.
+     */
+    inline Sink &sink() noexcept
+    {
+        static Sink s{}; ///< One (only) sink instance.
+        return s;
+    }
+
+    /// @brief Start the drain task on the shared sink.
+    inline bool start(uint32_t stack_words, UBaseType_t priority, BaseType_t core, TaskHandle_t *handle = nullptr) noexcept
+    {
+        return sink().start(stack_words, priority, core, handle);
+    }
+
+    /// @brief Start the drain task on the shared sink, on caller-owned storage.
+    inline bool start(StackType_t *stack, StaticTask_t *tcb, uint32_t stack_words, UBaseType_t priority, BaseType_t core,
+                      TaskHandle_t *handle = nullptr) noexcept
+    {
+        return sink().start(stack, tcb, stack_words, priority, core, handle);
+    }
+
+    // ---- Front-end used by the debug*() API ---- //
+
+    /// @brief Print one value the way Serial.print() would.
+    template <typename T>
+    inline void print(const T &x, Eol eol) noexcept
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, char>)
+            sink().emit(eol, "%c", x);
+        else if constexpr (std::is_same_v<U, bool>)
+            sink().emit(eol, "%d", static_cast<int>(x));
+        else if constexpr (std::is_floating_point_v<U>)
+            sink().emit(eol, "%.2f", x); ///< Serial.print(float) default: 2 digits.
+        else if constexpr (std::is_same_v<U, const char *> || std::is_same_v<U, char *> || has_c_str<U>::value)
+            sink().emit(eol, "%s", x);
+        else if constexpr (std::is_signed_v<U> || std::is_enum_v<U>)
+            sink().emit(eol, "%lld", x);
+        else
+            sink().emit(eol, "%llu", x);
+    }
+
+    /// @brief Serial.print(float, digits) equivalent.
+    inline void print(float x, int digits, Eol eol) noexcept { sink().emit(eol, "%.*f", digits, x); }
+} ///< Namespace dlog.
@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ *
+ * @brief Lock-free single-producer / single-consumer event queue that wakes its consumer task.
+ *
+ * @file EventQueue.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <StreamRing.h>
+
+namespace snapshot
+{
+    /**
+     * @brief Bounded SPSC ring of discrete events (every event is delivered, unlike a snapshot bus).
+     *
+     * The producer pushes from one task (or ISR); the consumer task claims the
+     * queue once with consume() and drains it in batches. push() never blocks:
+     * a full queue drops the new event and counts it. Storage is an SpscRing
+     * that notifies the consumer task when it goes from empty to non-empty,
+     * so the Consumer handle can sit in snapshot::wait_any() next to bus
+     * subscriptions (one wake per burst rather than per event).
+     *
+     * @tparam T Event type (trivially copyable).
+     * @tparam N Capacity (power of two).
+     */
+    template <typename T, std::size_t N>
+    class EventQueue
+    {
+    public:
+        using value_type = T; ///< Event type.
+
+        class Consumer;
+
+        /**
+         * @brief Append an event and wake the consumer (producer side).
+         *
+         * @param e Event.
+         * @return true If queued; false if full (dropped() counts it).
+         */
+        bool push(const T &e) noexcept
+        {
+            if (ring_.push(e))
+                return true;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false; ///< Never block the producer.
+        }
+
+        /// @brief Events waiting (approximate from a third task).
+        [[nodiscard]] std::size_t size() const noexcept { return ring_.size(); }
+
+        /// @brief Events dropped on a full queue since boot.
+        [[nodiscard]] uint32_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+        /// @brief Capacity.
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+
+        /**
+         * @brief Claim the consumer side for the calling task.
+         *
+         * @return Consumer Handle (invalid if another task already holds it).
+         */
+        [[nodiscard]] Consumer consume() noexcept
+        {
+            TaskHandle_t expected = nullptr;
+            const bool ok = consumer_.compare_exchange_strong(expected, xTaskGetCurrentTaskHandle(), std::memory_order_acq_rel);
+            configASSERT(ok); ///< SPSC: one consumer at a time.
+            if (!ok)
+                return Consumer{nullptr};
+            ring_.notify(xTaskGetCurrentTaskHandle());
+            return Consumer{this};
+        }
+
+        /**
+         * @brief Consumer-side handle (move-only, releases the queue on destruction).
+         */
+        class Consumer
+        {
+        public:
+            Consumer() noexcept = default;
+            Consumer(Consumer &&o) noexcept : q_(o.q_) { o.q_ = nullptr; }
+            Consumer &operator=(Consumer &&o) noexcept
+            {
+                if (this != &o)
+                {
+                    release();
+                    q_ = o.q_;
+                    o.q_ = nullptr;
+                }
+                return *this;
+            }
+            Consumer(const Consumer &) = delete;
+            Consumer &operator=(const Consumer &) = delete;
+            ~Consumer() { release(); }
+
+            /// @brief True if bound to a queue.
+            [[nodiscard]] bool valid() const noexcept { return q_ != nullptr; }
+
+            /// @brief True if at least one event is waiting (wait_any() compatible).
+            [[nodiscard]] bool fresh() const noexcept { return q_ != nullptr && q_->ring_.fresh(); }
+
+            /**
+             * @brief Take the oldest event.
+             *
+             * @param out Destination (untouched when empty).
+             * @return true If an event was taken.
+             */
+            bool pop(T &out) noexcept { return q_ != nullptr && q_->ring_.pop(out); }
+
+            /**
+             * @brief Hand every waiting event to @p fn in order, then free the slots in one step.
+             *
+             * @param fn Callable taking const T&.
+             * @return std::size_t Events delivered.
+             */
+            template <typename Fn>
+            std::size_t drain(Fn &&fn) noexcept { return (q_ != nullptr) ? q_->ring_.drain(fn) : 0; }
+
+        private:
+            friend class EventQueue;
+
+            explicit Consumer(EventQueue *q) noexcept : q_(q) {}
+
+            void release() noexcept
+            {
+                if (q_ != nullptr)
+                {
+                    q_->ring_.notify(nullptr);
+                    q_->consumer_.store(nullptr, std::memory_order_release);
+                }
+                q_ = nullptr;
+            }
+
+            EventQueue *q_{nullptr}; ///< Non-owning queue.
+        };
+
+    private:
+        SpscRing<T, N> ring_{};                       ///< Event slots (wakes the consumer on empty → non-empty).
+        std::atomic<uint32_t> dropped_{0};            ///< Events lost to a full queue.
+        std::atomic<TaskHandle_t> consumer_{nullptr}; ///< Claimed consumer task.
+    };
+} ///< Namespace snapshot.
@@ -0,0 +1,65 @@
+/**
+ * MIT License
+ *
+ * @brief Snapshot payload and bus for drive faults (FaultGuard → PowerDriveHandler, console, recorder).
+ *
+ * @file FaultBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+
+/**
+ * @brief Protection state published by FaultGuard on every trip, clear and Vbus report.
+ *
+ * The bridge is already off in hardware by the time a trip is published;
+ * the bus tells the drive loop to stop commanding it and everyone else why.
+ */
+struct FaultSnapshot
+{
+    /// @brief Trip causes (bitmask).
+    enum Cause : std::uint8_t
+    {
+        None = 0,
+        Pin = 1u << 0,         ///< Driver fault input asserted (FAULT_PIN).
+        OverVoltage = 1u << 1, ///< Bus voltage above cfg::fault::OV_VOLTS.
+        Watchdog = 1u << 2     ///< Supervisor: a control task stalled (cfg::supervisor::Response::Coast).
+    };
+
+    std::uint8_t latched{None}; ///< Causes held since the last clear (≠ 0 → bridge locked off).
+    std::uint8_t active{None};  ///< Causes still present right now.
+    std::uint16_t trips{0};     ///< Trips since boot.
+    float vbus_v{0.0f};         ///< Last measured bus voltage (V; 0 without a monitor).
+    std::uint64_t trip_us{0};   ///< When the latest trip fired (µs since boot, ISR time; 0 → never).
+    std::uint64_t stamp_us{0};  ///< Publish time (µs since boot).
+
+    /// @brief Human-readable cause mask ("pin+ov+wd", "pin+ov", ..., "none").
+    static constexpr const char *causeName(std::uint8_t causes) noexcept
+    {
+        constexpr const char *kNames[8] = {"none", "pin", "ov", "pin+ov", "wd", "pin+wd", "ov+wd", "pin+ov+wd"};
+        return kNames[causes & (Pin | OverVoltage | Watchdog)];
+    }
+};
+
+/**
+ * @brief Type alias for the bus that transports fault state.
+ */
+using FaultBus = snapshot::SignalBus<FaultSnapshot>;
+
+/**
+ * @brief Single, shared FaultBus instance.
+ */
+namespace buses
+{
+    inline FaultBus &fault() noexcept ///< Return reference to the shared FaultBus.
+    {
+        static FaultBus bus{}; ///< One (only) FaultBus instance.
+        return bus;            ///< Return reference to shared bus.
+    }
+}
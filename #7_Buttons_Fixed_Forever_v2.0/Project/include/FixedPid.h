@@ -0,0 +1,120 @@
+/**
+ * MIT License
+ *
+ * @brief Q16.16 fixed-point PID controller for the speed loop.
+ *
+ * @file FixedPid.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief Q16.16 fixed-point value (1.0 == 65536).
+using q16_t = int32_t;
+
+/// @brief float → Q16.16 (compile-time friendly; truncates toward zero).
+constexpr q16_t to_q16(float f) noexcept { return static_cast<q16_t>(f * 65536.0f); }
+
+/// @brief Q16.16 → float.
+constexpr float from_q16(q16_t q) noexcept { return static_cast<float>(q) / 65536.0f; }
+
+/**
+ * @brief PID controller in Q16.16 with derivative-on-measurement.
+ *
+ * All products are widened to 64 bit before shifting back, so gains with
+ * small magnitudes (e.g. 0.01 %/rpm) keep their resolution. The integrator
+ * is stored already scaled by ki and clamped to the output range, which is
+ * the anti-windup: it can never hold more authority than the output allows.
+ */
+class FixedPid
+{
+public:
+    /// @brief Controller gains (Q16.16): output units per error unit (·s / ·1/s for ki / kd).
+    struct Gains
+    {
+        q16_t kp{0}; ///< Proportional gain.
+        q16_t ki{0}; ///< Integral gain (per second).
+        q16_t kd{0}; ///< Derivative gain (seconds); 0 → PI.
+    };
+
+    /**
+     * @brief Construct with gains and a symmetric or asymmetric output clamp.
+     *
+     * @param g Gains (Q16.16).
+     * @param out_min Lower output clamp (Q16.16).
+     * @param out_max Upper output clamp (Q16.16).
+     */
+    constexpr FixedPid(Gains g, q16_t out_min, q16_t out_max) noexcept
+        : g_(g), out_min_(out_min), out_max_(out_max) {}
+
+    /**
+     * @brief Advance the controller by one sample.
+     *
+     * @param setpoint Target (Q16.16).
+     * @param measured Measurement (Q16.16).
+     * @param dt Sample interval (Q16.16 seconds, > 0).
+     * @return q16_t Clamped controller output.
+     */
+    q16_t update(q16_t setpoint, q16_t measured, q16_t dt) noexcept
+    {
+        if (dt <= 0)
+            return last_out_; ///< No time elapsed: hold.
+
+        const int64_t err = static_cast<int64_t>(setpoint) - measured;
+
+        // ---- P ---- //
+        const int64_t p = (g_.kp * err) >> 16;
+
+        // ---- I (pre-scaled by ki, clamped → anti-windup) ---- //
+        const int64_t di = (((g_.ki * err) >> 16) * dt) >> 16;
+        integ_ = clamp(integ_ + di);
+
+        // ---- D on measurement (no setpoint kick) ---- //
+        int64_t d = 0;
+        if (g_.kd != 0 && has_prev_)
+        {
+            const int64_t rate = ((static_cast<int64_t>(measured) - prev_meas_) << 16) / dt;
+            d = -((g_.kd * rate) >> 16);
+        }
+        prev_meas_ = measured;
+        has_prev_ = true;
+
+        last_out_ = static_cast<q16_t>(clamp(p + integ_ + d));
+        return last_out_;
+    }
+
+    /// @brief Clear integrator and derivative history (e.g. on stop).
+    void reset() noexcept
+    {
+        integ_ = 0;
+        prev_meas_ = 0;
+        has_prev_ = false;
+        last_out_ = 0;
+    }
+
+    /// @brief Most recent output (Q16.16).
+    [[nodiscard]] q16_t output() const noexcept { return last_out_; }
+
+private:
+    /// @brief Clamp to [out_min_, out_max_].
+    int64_t clamp(int64_t v) const noexcept
+    {
+        if (v < out_min_)
+            return out_min_;
+        if (v > out_max_)
+            return out_max_;
+        return v;
+    }
+
+    Gains g_{};            ///< Gains (Q16.16).
+    q16_t out_min_{0};     ///< Lower output clamp.
+    q16_t out_max_{0};     ///< Upper output clamp.
+    int64_t integ_{0};     ///< Integrator (output units, Q16.16).
+    q16_t prev_meas_{0};   ///< Previous measurement (D term).
+    bool has_prev_{false}; ///< True once prev_meas_ is valid.
+    q16_t last_out_{0};    ///< Last output.
+};
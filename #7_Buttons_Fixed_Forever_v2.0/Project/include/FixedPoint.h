@@ -0,0 +1,203 @@
+/**
+ * MIT License
+ *
+ * @brief Qm.n fixed-point number and float / fixed agnostic math helpers for the control path.
+ *
+ * @file FixedPoint.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace fixed
+{
+    /**
+     * @brief Signed fixed-point value, 32-bit storage with Frac fractional bits.
+     *
+     * Products and quotients widen to 64 bit before shifting back, so nothing
+     * here touches the FPU (or soft-float on cores without one). There is no
+     * saturation: keep values inside ±2^(31-Frac) (Q16: ±32767, Q15: ±65535).
+     * The float constructor is constexpr and meant for constants; at run time
+     * stay in fixed point and convert once at the boundary (toFloat()).
+     *
+     * @tparam Frac Fractional bits (1..30).
+     */
+    template <int Frac>
+    class Fixed
+    {
+        static_assert(Frac > 0 && Frac < 31, "Fixed: 1..30 fractional bits.");
+
+    public:
+        static constexpr int kFrac = Frac;                  ///< Fractional bits.
+        static constexpr int32_t kOne = int32_t{1} << Frac; ///< 1.0 in raw units.
+
+        constexpr Fixed() noexcept = default;
+
+        /// @brief From float (rounds to nearest; compile-time constants).
+        constexpr explicit Fixed(float f) noexcept
+            : v_(static_cast<int32_t>(f * static_cast<float>(kOne) + (f >= 0.0f ? 0.5f : -0.5f))) {}
+
+        /// @brief From a whole number.
+        constexpr explicit Fixed(int i) noexcept : v_(static_cast<int32_t>(i) * kOne) {}
+
+        /// @brief From raw units (value × 2^Frac).
+        static constexpr Fixed fromRaw(int32_t raw) noexcept
+        {
+            Fixed f;
+            f.v_ = raw;
+            return f;
+        }
+
+        /// @brief Raw units (value × 2^Frac).
+        [[nodiscard]] constexpr int32_t raw() const noexcept { return v_; }
+
+        /// @brief To float (boundary conversion).
+        [[nodiscard]] constexpr float toFloat() const noexcept { return static_cast<float>(v_) / static_cast<float>(kOne); }
+
+        // ---- Arithmetic ---- //
+        constexpr Fixed operator-() const noexcept { return fromRaw(-v_); }
+        constexpr Fixed operator+(Fixed o) const noexcept { return fromRaw(v_ + o.v_); }
+        constexpr Fixed operator-(Fixed o) const noexcept { return fromRaw(v_ - o.v_); }
+        constexpr Fixed operator*(Fixed o) const noexcept
+        {
+            const int64_t p = static_cast<int64_t>(v_) * o.v_;
+            return fromRaw(static_cast<int32_t>((p + (int64_t{1} << (Frac - 1))) >> Frac)); ///< Round half up.
+        }
+        constexpr Fixed operator/(Fixed o) const noexcept
+        {
+            return fromRaw(static_cast<int32_t>((static_cast<int64_t>(v_) << Frac) / o.v_)); ///< Truncates toward zero.
+        }
+        constexpr Fixed &operator+=(Fixed o) noexcept { return *this = *this + o; }
+        constexpr Fixed &operator-=(Fixed o) noexcept { return *this = *this - o; }
+        constexpr Fixed &operator*=(Fixed o) noexcept { return *this = *this * o; }
+
+        // ---- Comparison ---- //
+        constexpr bool operator==(Fixed o) const noexcept { return v_ == o.v_; }
+        constexpr bool operator!=(Fixed o) const noexcept { return v_ != o.v_; }
+        constexpr bool operator<(Fixed o) const noexcept { return v_ < o.v_; }
+        constexpr bool operator<=(Fixed o) const noexcept { return v_ <= o.v_; }
+        constexpr bool operator>(Fixed o) const noexcept { return v_ > o.v_; }
+        constexpr bool operator>=(Fixed o) const noexcept { return v_ >= o.v_; }
+
+    private:
+        int32_t v_{0}; ///< Value × 2^Frac.
+    };
+
+    using Q15 = Fixed<15>; ///< Normalised quantities (±65535, 1/32768 steps).
+    using Q16 = Fixed<16>; ///< Percent, rates, seconds (±32767, 1/65536 steps).
+
+    /// @brief True for Fixed<N>.
+    template <typename T>
+    struct is_fixed : std::false_type
+    {
+    };
+    template <int Frac>
+    struct is_fixed<Fixed<Frac>> : std::true_type
+    {
+    };
+    template <typename T>
+    inline constexpr bool is_fixed_v = is_fixed<T>::value;
+} ///< Namespace fixed.
+
+/**
+ * @brief The same control math for float and fixed::Fixed (one code path, chosen by type).
+ */
+namespace num
+{
+    /// @brief To float (boundary conversion).
+    constexpr float to_float(float v) noexcept { return v; }
+    template <int F>
+    constexpr float to_float(fixed::Fixed<F> v) noexcept { return v.toFloat(); }
+
+    template <typename T>
+    constexpr T min(T a, T b) noexcept { return (b < a) ? b : a; }
+
+    template <typename T>
+    constexpr T max(T a, T b) noexcept { return (a < b) ? b : a; }
+
+    template <typename T>
+    constexpr T clamp(T v, T lo, T hi) noexcept { return (v < lo) ? lo : ((hi < v) ? hi : v); }
+
+    template <typename T>
+    constexpr T abs(T v) noexcept { return (v < T{}) ? -v : v; }
+
+    /// @brief |mag| with the sign of @p sign.
+    template <typename T>
+    constexpr T copysign(T mag, T sign) noexcept { return (sign < T{}) ? -abs(mag) : abs(mag); }
+
+    /// @brief Integer square root of a 64-bit value (floor).
+    constexpr uint64_t isqrt(uint64_t x) noexcept
+    {
+        uint64_t r = 0;
+        for (uint64_t bit = uint64_t{1} << 62; bit != 0; bit >>= 2)
+        {
+            if (x >= r + bit)
+            {
+                x -= r + bit;
+                r = (r >> 1) + bit;
+            }
+            else
+                r >>= 1;
+        }
+        return r;
+    }
+
+    /// @brief Square root (negative → 0).
+    inline float sqrt(float v) noexcept { return (v > 0.0f) ? std::sqrt(v) : 0.0f; }
+    template <int F>
+    constexpr fixed::Fixed<F> sqrt(fixed::Fixed<F> v) noexcept
+    {
+        return (v.raw() > 0) ? fixed::Fixed<F>::fromRaw(static_cast<int32_t>(isqrt(static_cast<uint64_t>(v.raw()) << F)))
+                             : fixed::Fixed<F>{};
+    }
+
+    /// @brief Elapsed microseconds as seconds.
+    template <typename T>
+    constexpr T seconds(uint32_t us) noexcept
+    {
+        if constexpr (fixed::is_fixed_v<T>)
+            return T::fromRaw(static_cast<int32_t>(((static_cast<int64_t>(us) << T::kFrac) + 500000) / 1000000)); ///< Nearest.
+        else
+            return static_cast<T>(us) * 1e-6f;
+    }
+
+    /// @brief round(v × per) as an integer count (e.g. percent → codec counts).
+    template <typename T>
+    constexpr int32_t to_units(T v, int32_t per) noexcept
+    {
+        if constexpr (fixed::is_fixed_v<T>)
+            return static_cast<int32_t>((static_cast<int64_t>(v.raw()) * per + (int64_t{1} << (T::kFrac - 1))) >> T::kFrac);
+        else
+            return static_cast<int32_t>(v * static_cast<float>(per) + (v < 0.0f ? -0.5f : 0.5f));
+    }
+
+    /// @brief n / per (inverse of to_units()).
+    template <typename T>
+    constexpr T from_units(int32_t n, int32_t per) noexcept
+    {
+        if constexpr (fixed::is_fixed_v<T>)
+            return T::fromRaw(static_cast<int32_t>(static_cast<int64_t>(n) * (int64_t{1} << T::kFrac) / per)); ///< n may be negative.
+        else
+            return static_cast<T>(n) / static_cast<T>(per);
+    }
+} ///< Namespace num.
+
+// ---- Compile-time checks against the float results (exact where float is exact) ---- //
+static_assert((fixed::Q16{1.5f} * fixed::Q16{2.25f}) == fixed::Q16{3.375f}, "Q16 multiply");
+static_assert((fixed::Q16{100.0f} / fixed::Q16{8.0f}) == fixed::Q16{12.5f}, "Q16 divide");
+static_assert((fixed::Q16{-3.0f} * fixed::Q16{0.5f}) == fixed::Q16{-1.5f}, "Q16 signed multiply");
+static_assert(num::sqrt(fixed::Q16{400.0f}) == fixed::Q16{20.0f}, "Q16 sqrt");
+static_assert(num::sqrt(fixed::Q15{2.25f}) == fixed::Q15{1.5f}, "Q15 sqrt");
+static_assert(num::seconds<fixed::Q16>(500000) == fixed::Q16{0.5f}, "Q16 seconds");
+static_assert(num::to_units(fixed::Q16{37.5f}, 500) == 18750 && num::to_units(37.5f, 500) == 18750, "to_units");
+static_assert(num::to_units(fixed::Q16{-37.5f}, 250) == -9375 && num::to_units(-37.5f, 250) == -9375, "signed to_units");
+static_assert(num::from_units<fixed::Q16>(18750, 500) == fixed::Q16{37.5f}, "from_units");
+static_assert(num::from_units<fixed::Q16>(-9375, 250) == fixed::Q16{-37.5f}, "signed from_units");
+static_assert(num::clamp(fixed::Q16{120.0f}, fixed::Q16{0.0f}, fixed::Q16{100.0f}) == fixed::Q16{100.0f}, "clamp");
+static_assert(num::copysign(fixed::Q16{2.0f}, fixed::Q16{-1.0f}) == fixed::Q16{-2.0f}, "copysign");
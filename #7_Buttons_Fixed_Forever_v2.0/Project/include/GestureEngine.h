@@ -0,0 +1,303 @@
+/**
+ * MIT License
+ *
+ * @brief Table-driven button gesture recognizer (short / long / double / chord), run once per scan.
+ *
+ * @file GestureEngine.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <app_config.h>
+#include <ButtonEvents.h>
+
+/**
+ * @brief Turns debounced level changes into gesture events and gesture bits.
+ *
+ * Each button runs the same small state machine; transitions live in one
+ * constant table indexed by [state][input], so adding a gesture is a table
+ * edit rather than another timer in some consumer:
+ *
+ *   state    | Press  | Release ≤ short | Release > short | Long due
+ *   ---------|--------|-----------------|-----------------|-----------
+ *   Idle     | Down   | -               | -               | -
+ *   Down     | -      | Tapped  (Short) | Idle            | Held (Long)
+ *   Tapped   | Down2  | -               | -               | -
+ *   Down2    | -      | Idle   (Double) | Idle            | Held (Long)
+ *   Held     | -      | Idle            | Idle            | -
+ *   Chorded  | -      | Idle            | Idle            | -
+ *
+ * Tapped falls back to Idle once the double gap has passed (checked at the
+ * next press, so it needs no timer). A chord is made when all its members
+ * are down and their presses landed within chord_ms of each other. Its
+ * members then move to Chorded and produce no Short / Double / Long of their
+ * own, so a chord never also fires its members' single-button actions.
+ *
+ * Gesture bits, copied into every InputState:
+ *  - taps / doubles: flip on each Short / Double (a free latch).
+ *  - held: set while a button is held past long_ms.
+ *  - chords: flip each time a chord is made.
+ * Consumers XOR against their previous frame to see new gestures. A toggle
+ * is never lost to a slow reader, unlike a one-frame pulse.
+ *
+ * @tparam N Button count.
+ * @tparam M Chord count.
+ */
+template <std::size_t N, std::size_t M>
+class GestureEngine
+{
+public:
+    static_assert(N <= 64 && M <= 64, "Chord masks hold 64 buttons.");
+
+    /**
+     * @brief Construct with chord masks and gesture timings.
+     *
+     * @param chords Member mask per chord (bit i → button i).
+     * @param short_ms Longest hold that still counts as a short press (ms).
+     * @param long_ms Hold time that triggers Long (ms).
+     * @param double_ms Longest gap between two short taps for a Double (ms).
+     * @param chord_ms Longest spread between a chord's member presses (ms).
+     */
+    constexpr explicit GestureEngine(const std::array<uint64_t, M> &chords, uint32_t short_ms = cfg::button::BTN_SHORT_MS,
+                                     uint32_t long_ms = cfg::button::BTN_LONG_MS, uint32_t double_ms = cfg::button::BTN_DOUBLE_MS,
+                                     uint32_t chord_ms = cfg::button::BTN_CHORD_MS) noexcept
+        : chord_mask_(chords), short_us_(short_ms * 1000ULL), long_us_(long_ms * 1000ULL), double_us_(double_ms * 1000ULL),
+          chord_us_(chord_ms * 1000ULL) {}
+
+    /**
+     * @brief Step every button that differs between @p prev and @p cur, then look for chords.
+     *
+     * @param prev Previous debounced levels.
+     * @param cur New debounced levels.
+     * @param t_us Origin stamp of the change (µs).
+     * @param emit Callable taking const ButtonEvent&.
+     */
+    template <typename Emit>
+    void edges(const std::bitset<N> &prev, const std::bitset<N> &cur, uint64_t t_us, Emit &&emit) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (prev.test(i) == cur.test(i))
+                continue;
+
+            Track &b = t_[i];
+            if (cur.test(i))
+            {
+                if (b.state == State::Tapped && (t_us - b.up_us) > double_us_)
+                    b.state = State::Idle; ///< Gap expired: this press starts a new sequence.
+                b.down_us = t_us;
+                emit(make(i, ButtonEvent::Kind::Press, t_us, 0));
+                apply(i, Input::Press, t_us, 0, emit);
+                continue;
+            }
+
+            const uint64_t held_us = t_us - b.down_us;
+            const uint32_t held_ms = static_cast<uint32_t>(held_us / 1000ULL);
+            emit(make(i, ButtonEvent::Kind::Release, t_us, held_ms));
+            b.up_us = t_us;
+            apply(i, (held_us <= short_us_) ? Input::ReleaseShort : Input::ReleaseSlow, t_us, held_ms, emit);
+        }
+
+        for (std::size_t c = 0; c < M; ++c)
+        {
+            const std::bitset<N> members(chord_mask_[c]);
+            if ((cur & members) != members)
+            {
+                chord_on_.reset(c); ///< A member let go: the chord can be made again.
+                continue;
+            }
+            if (!chord_on_.test(c) && chordFormed(members))
+                makeChord(c, members, t_us, emit);
+        }
+    }
+
+    /**
+     * @brief Advance held buttons past the long-press threshold.
+     *
+     * @param now_us Current time (µs).
+     * @param emit Callable taking const ButtonEvent&.
+     */
+    template <typename Emit>
+    void poll(uint64_t now_us, Emit &&emit) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const Track &b = t_[i];
+            if (timing(b.state) && now_us - b.down_us >= long_us_)
+                apply(i, Input::LongDue, now_us, static_cast<uint32_t>((now_us - b.down_us) / 1000ULL), emit);
+        }
+    }
+
+    /// @brief Earliest pending Long threshold (µs since boot), or 0 if none.
+    [[nodiscard]] uint64_t nextDeadline() const noexcept
+    {
+        uint64_t next = 0;
+        for (const Track &b : t_)
+        {
+            if (!timing(b.state))
+                continue;
+            const uint64_t d = b.down_us + long_us_;
+            next = (next == 0 || d < next) ? d : next;
+        }
+        return next;
+    }
+
+    [[nodiscard]] const std::bitset<N> &taps() const noexcept { return taps_; }       ///< Flip on every Short.
+    [[nodiscard]] const std::bitset<N> &doubles() const noexcept { return doubles_; } ///< Flip on every Double.
+    [[nodiscard]] const std::bitset<N> &held() const noexcept { return held_; }       ///< Held past the long threshold.
+    [[nodiscard]] const std::bitset<M> &chords() const noexcept { return chords_; }   ///< Flip on every chord.
+
+private:
+    /// @brief Per-button state.
+    enum class State : uint8_t
+    {
+        Idle = 0, ///< Released, no sequence pending.
+        Down,     ///< Pressed.
+        Tapped,   ///< Released after a short press (a Double may follow).
+        Down2,    ///< Pressed again within the double gap.
+        Held,     ///< Long already reported for this hold.
+        Chorded,  ///< Member of a chord made during this hold.
+        Count
+    };
+
+    /// @brief State machine input.
+    enum class Input : uint8_t
+    {
+        Press = 0,    ///< Debounced press edge.
+        ReleaseShort, ///< Release within short_ms.
+        ReleaseSlow,  ///< Release after short_ms.
+        LongDue,      ///< Still held at long_ms.
+        Count
+    };
+
+    /// @brief Gesture produced by a transition.
+    enum class Out : uint8_t
+    {
+        None = 0,
+        Short,
+        Double,
+        Long
+    };
+
+    /// @brief One table cell.
+    struct Step
+    {
+        State next; ///< Next state.
+        Out out;    ///< Gesture to report.
+    };
+
+    static constexpr std::size_t kStates = static_cast<std::size_t>(State::Count);
+    static constexpr std::size_t kInputs = static_cast<std::size_t>(Input::Count);
+
+    // clang-format off
+    static constexpr Step kTable[kStates][kInputs] = {
+        //             Press                         ReleaseShort                  ReleaseSlow                  LongDue
+        /* Idle    */ {{State::Down, Out::None},     {State::Idle, Out::None},     {State::Idle, Out::None},    {State::Idle, Out::None}},
+        /* Down    */ {{State::Down, Out::None},     {State::Tapped, Out::Short},  {State::Idle, Out::None},    {State::Held, Out::Long}},
+        /* Tapped  */ {{State::Down2, Out::None},    {State::Tapped, Out::None},   {State::Tapped, Out::None},  {State::Tapped, Out::None}},
+        /* Down2   */ {{State::Down2, Out::None},    {State::Idle, Out::Double},   {State::Idle, Out::None},    {State::Held, Out::Long}},
+        /* Held    */ {{State::Held, Out::None},     {State::Idle, Out::None},     {State::Idle, Out::None},    {State::Held, Out::None}},
+        /* Chorded */ {{State::Chorded, Out::None},  {State::Idle, Out::None},     {State::Idle, Out::None},    {State::Chorded, Out::None}},
+    };
+    // clang-format on
+
+    /// @brief Per-button timing.
+    struct Track
+    {
+        uint64_t down_us{0};      ///< Last press stamp.
+        uint64_t up_us{0};        ///< Last release stamp (double gap reference).
+        State state{State::Idle}; ///< Machine state.
+    };
+
+    /// @brief True while the long-press threshold is still pending.
+    static constexpr bool timing(State s) noexcept { return s == State::Down || s == State::Down2; }
+
+    /// @brief Run one transition; report its gesture as an event and a bit.
+    template <typename Emit>
+    void apply(std::size_t i, Input in, uint64_t t_us, uint32_t held_ms, Emit &&emit) noexcept
+    {
+        Track &b = t_[i];
+        const Step s = kTable[static_cast<std::size_t>(b.state)][static_cast<std::size_t>(in)];
+        if (b.state == State::Held && s.next != State::Held)
+            held_.reset(i);
+        b.state = s.next;
+
+        switch (s.out)
+        {
+        case Out::Short:
+            taps_.flip(i);
+            emit(make(i, ButtonEvent::Kind::Short, t_us, held_ms));
+            break;
+        case Out::Double:
+            doubles_.flip(i);
+            emit(make(i, ButtonEvent::Kind::Double, t_us, held_ms));
+            break;
+        case Out::Long:
+            held_.set(i);
+            emit(make(i, ButtonEvent::Kind::Long, t_us, held_ms));
+            break;
+        case Out::None:
+        default:
+            break;
+        }
+    }
+
+    /// @brief All members pressed in this same hold, within chord_us_ of each other.
+    bool chordFormed(const std::bitset<N> &members) const noexcept
+    {
+        uint64_t first = UINT64_MAX;
+        uint64_t last = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (!members.test(i))
+                continue;
+            const Track &b = t_[i];
+            if (!timing(b.state))
+                return false; ///< Already long-held or claimed by another chord.
+            first = (b.down_us < first) ? b.down_us : first;
+            last = (b.down_us > last) ? b.down_us : last;
+        }
+        return last - first <= chord_us_;
+    }
+
+    /// @brief Claim the members and report the chord.
+    template <typename Emit>
+    void makeChord(std::size_t c, const std::bitset<N> &members, uint64_t t_us, Emit &&emit) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            if (members.test(i))
+                t_[i].state = State::Chorded;
+        chord_on_.set(c);
+        chords_.flip(c);
+        emit(make(c, ButtonEvent::Kind::Chord, t_us, 0));
+    }
+
+    static ButtonEvent make(std::size_t i, ButtonEvent::Kind k, uint64_t t_us, uint32_t held_ms) noexcept
+    {
+        ButtonEvent e{};
+        e.stamp_us = t_us;
+        e.held_ms = held_ms;
+        e.button = static_cast<uint8_t>(i);
+        e.kind = k;
+        return e;
+    }
+
+    std::array<uint64_t, M> chord_mask_; ///< Members per chord.
+    uint64_t short_us_;                  ///< Short-press limit (µs).
+    uint64_t long_us_;                   ///< Long-press threshold (µs).
+    uint64_t double_us_;                 ///< Double-click gap limit (µs).
+    uint64_t chord_us_;                  ///< Chord press spread limit (µs).
+    std::array<Track, N> t_{};           ///< Per-button state.
+    std::bitset<N> taps_{};              ///< Short toggles.
+    std::bitset<N> doubles_{};           ///< Double toggles.
+    std::bitset<N> held_{};              ///< Long-held levels.
+    std::bitset<M> chords_{};            ///< Chord toggles.
+    std::bitset<M> chord_on_{};          ///< Chord made and still held (no repeat until released).
+};
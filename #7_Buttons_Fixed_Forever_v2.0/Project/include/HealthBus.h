@@ -0,0 +1,64 @@
+/**
+ * MIT License
+ *
+ * @brief Task health published by the Supervisor: heartbeats, deadline misses, stalls and the response in force.
+ *
+ * @file HealthBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+
+/**
+ * @brief One supervised task, as of the last scan.
+ */
+struct TaskHealth
+{
+    const char *name{""};   ///< Task name.
+    uint32_t beats{0};      ///< Heartbeats since boot.
+    uint32_t misses{0};     ///< Beats more than 1.5x their deadline late, since boot.
+    uint32_t stalls{0};     ///< Times the task was found stalled.
+    uint32_t age_us{0};     ///< Since the latest beat (µs).
+    uint32_t due_us{0};     ///< Deadline the latest beat announced (µs; 0 → unbounded wait).
+    uint32_t max_gap_us{0}; ///< Longest gap between supervised beats (µs).
+    bool stalled{false};    ///< No beat STALL_MS past the one due.
+};
+
+/**
+ * @brief Whole-system health published by the Supervisor every scan.
+ */
+struct HealthSnapshot
+{
+    static constexpr std::size_t kMaxTasks = 6; ///< Supervised-task capacity.
+
+    std::array<TaskHealth, kMaxTasks> tasks{}; ///< Supervised tasks (first @ref count valid).
+    uint8_t count{0};                          ///< Used entries in tasks.
+    bool degraded{false};                      ///< Drive duty capped (cfg::supervisor::DEGRADE_PCT).
+    uint16_t incidents{0};                     ///< Stalls + miss bursts since boot.
+    uint64_t stamp_us{0};                      ///< Scan time (µs since boot).
+};
+
+/**
+ * @brief Type alias for the bus that transports task health.
+ */
+using HealthBus = snapshot::SignalBus<HealthSnapshot>;
+
+/**
+ * @brief Single, shared HealthBus instance.
+ */
+namespace buses
+{
+    inline HealthBus &health() noexcept ///< Return reference to the shared HealthBus.
+    {
+        static HealthBus bus{}; ///< One (only) HealthBus instance.
+        return bus;             ///< Return reference to shared bus.
+    }
+}
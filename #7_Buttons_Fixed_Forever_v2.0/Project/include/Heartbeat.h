@@ -0,0 +1,142 @@
+/**
+ * MIT License
+ *
+ * @brief Per-task heartbeat: beat counter, next-beat deadline, deadline misses and task watchdog feed.
+ *
+ * @file Heartbeat.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <atomic>
+#include <cstdint>
+#include <esp_task_wdt.h>
+#include <HotPath.h>
+
+/**
+ * @brief One supervised task's proof of life.
+ *
+ * The owning task calls beat() once per iteration, just before it blocks,
+ * with the longest it expects to block (its period, its park beat, its
+ * idle fallback; 0 when it waits without bound). The next beat landing
+ * more than half that again late counts as a deadline miss; the Supervisor
+ * reads the same fields from its own task and calls a task stalled once no
+ * beat came cfg::supervisor::STALL_MS after the one due.
+ *
+ * With cfg::supervisor::TWDT the first bounded beat also subscribes the task
+ * to the task watchdog, and later ones feed it (at most every kFeedUs). A
+ * task going into an unbounded wait unsubscribes, and subscribes again on
+ * its next bounded beat, so an edge-driven task that waits for a button is
+ * never "hung" by sitting still.
+ *
+ * @note Times are the low 32 bits of now_us() (wrap after ~71 minutes;
+ *       differences stay correct). beat() belongs to the owning task; every
+ *       getter is safe from any task.
+ */
+class Heartbeat
+{
+public:
+    static constexpr uint32_t kFeedUs = 100000; ///< Task watchdog feed interval (µs).
+
+    /**
+     * @brief Construct (no RTOS call).
+     *
+     * @param name Task name (console, HealthBus).
+     */
+    explicit Heartbeat(const char *name) noexcept : name_(name) {}
+
+    /**
+     * @brief Record one iteration (owning task, just before it blocks).
+     *
+     * @param now Current time (µs).
+     * @param next_within_us Longest block before the next beat (µs; 0 → unbounded: not supervised until then).
+     */
+    void HOT_IRAM beat(uint64_t now, uint32_t next_within_us) noexcept
+    {
+        const uint32_t t = static_cast<uint32_t>(now);
+        const uint32_t due = due_us_.load(std::memory_order_relaxed);
+        if (beats_.load(std::memory_order_relaxed) != 0 && due != 0)
+        {
+            const uint32_t gap = t - last_us_.load(std::memory_order_relaxed);
+            if (gap > due + due / 2)
+                misses_.fetch_add(1, std::memory_order_relaxed);
+            if (gap > max_gap_us_.load(std::memory_order_relaxed))
+                max_gap_us_.store(gap, std::memory_order_relaxed); ///< Single writer.
+        }
+        due_us_.store(next_within_us, std::memory_order_relaxed);
+        last_us_.store(t, std::memory_order_relaxed);
+        beats_.fetch_add(1, std::memory_order_release); ///< Last: a reader that sees the count sees the stamp.
+        feed(t, next_within_us != 0);
+    }
+
+    /// @brief FreeRTOS wait → beat() deadline (portMAX_DELAY → 0).
+    static uint32_t ticksUs(TickType_t ticks) noexcept
+    {
+        return (ticks == portMAX_DELAY) ? 0U : static_cast<uint32_t>(ticks) * portTICK_PERIOD_MS * 1000U;
+    }
+
+    /// @brief Task name.
+    [[nodiscard]] const char *name() const noexcept { return name_; }
+
+    /// @brief Beats since boot.
+    [[nodiscard]] uint32_t beats() const noexcept { return beats_.load(std::memory_order_acquire); }
+
+    /// @brief Beats that came more than 1.5x their deadline late.
+    [[nodiscard]] uint32_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+    /// @brief Time of the latest beat (low 32 bits of now_us()).
+    [[nodiscard]] uint32_t last() const noexcept { return last_us_.load(std::memory_order_relaxed); }
+
+    /// @brief Next beat expected within this long of last() (µs; 0 → unbounded wait).
+    [[nodiscard]] uint32_t due() const noexcept { return due_us_.load(std::memory_order_relaxed); }
+
+    /// @brief Longest gap between two supervised beats (µs).
+    [[nodiscard]] uint32_t maxGap() const noexcept { return max_gap_us_.load(std::memory_order_relaxed); }
+
+private:
+    /// @brief Task watchdog state of the owning task.
+    enum class Wdt : uint8_t
+    {
+        Off = 0, ///< Not subscribed.
+        On,      ///< Subscribed, fed by beat().
+        Failed   ///< esp_task_wdt_add() refused (TWDT not running): never retried.
+    };
+
+    /// @brief Subscribe / feed / unsubscribe the owning task.
+    void feed(uint32_t t, bool bounded) noexcept
+    {
+        if constexpr (!cfg::supervisor::ENABLED || !cfg::supervisor::TWDT)
+            return;
+
+        if (!bounded)
+        {
+            if (wdt_ == Wdt::On && esp_task_wdt_delete(nullptr) == ESP_OK)
+                wdt_ = Wdt::Off; ///< Unbounded wait ahead: sitting still is not a hang.
+            return;
+        }
+        if (wdt_ == Wdt::Off)
+        {
+            wdt_ = (esp_task_wdt_add(nullptr) == ESP_OK) ? Wdt::On : Wdt::Failed;
+            fed_us_ = t;
+            return;
+        }
+        if (wdt_ == Wdt::On && (t - fed_us_) >= kFeedUs)
+        {
+            esp_task_wdt_reset();
+            fed_us_ = t;
+        }
+    }
+
+    const char *name_;                    ///< Task name.
+    std::atomic<uint32_t> beats_{0};      ///< Beats since boot.
+    std::atomic<uint32_t> misses_{0};     ///< Late beats.
+    std::atomic<uint32_t> last_us_{0};    ///< Latest beat (µs, low 32 bits).
+    std::atomic<uint32_t> due_us_{0};     ///< Deadline announced by the latest beat (µs).
+    std::atomic<uint32_t> max_gap_us_{0}; ///< Longest supervised gap (µs).
+    Wdt wdt_{Wdt::Off};                   ///< Owning task's watchdog subscription.
+    uint32_t fed_us_{0};                  ///< Last watchdog feed (µs, low 32 bits).
+};
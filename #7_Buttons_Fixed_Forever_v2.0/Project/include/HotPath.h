@@ -0,0 +1,36 @@
+/**
+ * MIT License
+ *
+ * @brief Opt-in IRAM placement for the control hot path (bus publish / peek, drive step, duty update).
+ *
+ * @file HotPath.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <esp_attr.h>
+
+/**
+ * Flash-resident code runs through the instruction cache: a miss costs a
+ * flash fetch, and other code can evict the control loop at any time. With
+ * HOT_PATH_IRAM set (build flag: -DHOT_PATH_IRAM=1) every function tagged
+ * HOT_IRAM is linked into IRAM instead, so the drive step's timing no longer
+ * depends on what ran before it. The drive timer interrupt is then also
+ * allocated IRAM-safe, so its alarms keep being counted while a flash write
+ * has the cache disabled.
+ *
+ * @note Only repo-owned code is tagged. The SnapshotBus seqlock and the IDF
+ *       MCPWM / PCNT driver calls underneath it still execute from flash.
+ */
+#ifndef HOT_PATH_IRAM
+#define HOT_PATH_IRAM 0
+#endif
+
+#if HOT_PATH_IRAM
+#define HOT_IRAM IRAM_ATTR ///< Link this hot-path function into IRAM.
+#else
+#define HOT_IRAM ///< Hot-path function (flash: HOT_PATH_IRAM not set).
+#endif
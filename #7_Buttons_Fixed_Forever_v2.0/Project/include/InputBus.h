@@ -11,21 +11,126 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <bitset>
 #include <app_config.h>
 #include <Universal_Button.h>
 #include <ButtonHandler_Config.h>
 #include <SnapshotBus.h>
+#include <SignalBus.h>
 #include <InputModel.h>
 
 // ---- Aliases ---- //
 
-using Button = ButtonHandler<NUM_BUTTONS>;              ///< Concrete button handler bound to NUM_BUTTONS.
-using InputState = snapshot::input::State<NUM_BUTTONS>; ///< Snapshot payload: bitset of button states + timestamp.
-using InputBus = snapshot::SnapshotBus<InputState>;     ///< Snapshot bus that transports InputState frames.
-using snapshot::input::for_each_edge;                   ///< Import edge-iteration helper for brevity.
-using snapshot::input::idx;                             ///< Import generic enum→index caster for brevity.
+using Button = ButtonHandler<NUM_BUTTONS>; ///< Concrete button handler bound to NUM_BUTTONS.
+using snapshot::input::for_each_edge;      ///< Import edge-iteration helper for brevity.
+using snapshot::input::idx;                ///< Import generic enum→index caster for brevity.
+
+// ---- Chords (generated from CHORD_LIST) ---- //
+
+#define INPUTTYPES_CHORD_ENUM(name, a, b) name,
+enum class ChordIndex : std::size_t ///< Chord order = CHORD_LIST order.
+{
+    CHORD_LIST(INPUTTYPES_CHORD_ENUM) Count
+};
+#undef INPUTTYPES_CHORD_ENUM
+
+constexpr std::size_t NUM_CHORDS = static_cast<std::size_t>(ChordIndex::Count); ///< Chords in CHORD_LIST.
+
+/**
+ * @brief Member mask per chord (bit i → ButtonIndex i), index-aligned with ChordIndex.
+ */
+#define INPUTTYPES_CHORD_MASK(name, a, b) ((uint64_t{1} << idx(ButtonIndex::a)) | (uint64_t{1} << idx(ButtonIndex::b))),
+static constexpr std::array<uint64_t, NUM_CHORDS> kChordMasks = {{CHORD_LIST(INPUTTYPES_CHORD_MASK)}};
+#undef INPUTTYPES_CHORD_MASK
+
+/**
+ * @brief String names for each chord (index-aligned with ChordIndex).
+ */
+#define INPUTTYPES_CHORD_NAME(name, a, b) #name,
+static constexpr const char *kChordNames[NUM_CHORDS + 1] = {CHORD_LIST(INPUTTYPES_CHORD_NAME) ""}; ///< +1: CHORD_LIST may be empty.
+#undef INPUTTYPES_CHORD_NAME
+
+/**
+ * @brief Snapshot payload: bitset of button states + timestamps.
+ *
+ * origin_us is the now_us() of the physical event behind the frame (first GPIO
+ * edge in interrupt mode, the sampling pass in poll mode). It is carried
+ * unchanged into ControlSnapshot so every stage measures against one clock.
+ * stamp_ms is origin_us / 1000, kept for the InputModel helpers.
+ *
+ * The gesture bits come from StateManager's GestureEngine, computed once per
+ * scan. taps / doubles / chords are toggles: XOR with the previous frame
+ * gives the gestures since then, and each bit on its own is a latch.
+ */
+struct InputState : snapshot::input::State<NUM_BUTTONS>
+{
+    std::bitset<NUM_BUTTONS> taps{};    ///< Flips on every Short press.
+    std::bitset<NUM_BUTTONS> doubles{}; ///< Flips on every Double.
+    std::bitset<NUM_BUTTONS> held{};    ///< Held past BTN_LONG_MS (level).
+    std::bitset<NUM_CHORDS> chords{};   ///< Flips each time a CHORD_LIST chord is made.
+    uint64_t origin_us{0};              ///< Origin stamp (µs since boot).
+};
+
+// ---- Atomic packing (wait-free InputBus) ---- //
+
+namespace snapshot
+{
+    /// @brief Button + gesture bits in the packed word (levels, taps, doubles, held, chords).
+    inline constexpr std::size_t kInputBits = 4 * NUM_BUTTONS + NUM_CHORDS;
+
+    /**
+     * @brief Wider panels (kInputBits > 22) don't fit the word: no codec → InputBus falls back to the seqlock.
+     */
+    template <bool Packable>
+    struct input_state_codec
+    {
+    };
+
+    /**
+     * @brief InputState in one 64-bit word: buttons, taps, doubles, held (NUM_BUTTONS bits each)
+     * and chords from bit 0 up, origin_us in bits 22..63.
+     * @note 42 bits of µs wrap after ~50 days (like a 32-bit millis()); stamp_ms is rebuilt from origin_us.
+     */
+    template <>
+    struct input_state_codec<true>
+    {
+        using word = uint64_t;
+
+        static constexpr unsigned kOriginShift = 22;
+        static constexpr word kOriginMask = (word{1} << (64 - kOriginShift)) - 1;
+        static constexpr unsigned kN = NUM_BUTTONS;
+
+        static word pack(const InputState &s) noexcept
+        {
+            return static_cast<word>(s.buttons.to_ullong()) | (static_cast<word>(s.taps.to_ullong()) << kN) |
+                   (static_cast<word>(s.doubles.to_ullong()) << (2 * kN)) | (static_cast<word>(s.held.to_ullong()) << (3 * kN)) |
+                   (static_cast<word>(s.chords.to_ullong()) << (4 * kN)) | ((s.origin_us & kOriginMask) << kOriginShift);
+        }
+
+        static InputState unpack(word w) noexcept
+        {
+            InputState s{};
+            s.buttons = std::bitset<NUM_BUTTONS>(w);
+            s.taps = std::bitset<NUM_BUTTONS>(w >> kN);
+            s.doubles = std::bitset<NUM_BUTTONS>(w >> (2 * kN));
+            s.held = std::bitset<NUM_BUTTONS>(w >> (3 * kN));
+            s.chords = std::bitset<NUM_CHORDS>(w >> (4 * kN));
+            s.origin_us = w >> kOriginShift;
+            s.stamp_ms = static_cast<std::uint32_t>(s.origin_us / 1000ULL);
+            return s;
+        }
+    };
+
+    template <>
+    struct atomic_codec<InputState> : input_state_codec<(kInputBits <= 22)>
+    {
+    };
+} ///< Namespace snapshot.
+
+using InputBus = snapshot::SignalBus<InputState>; ///< Snapshot bus that transports InputState frames (atomic word while kInputBits ≤ 22, e.g. 5 buttons + 2 chords).
 
 // ---- Names table (generated from BUTTON_LIST) ---- //
 
@@ -37,11 +142,21 @@ using snapshot::input::idx;                             ///< Import generic enum
 static constexpr const char *kButtonNames[NUM_BUTTONS] = {BUTTON_LIST(INPUTTYPES_NAME_EXPAND)};
 #undef INPUTTYPES_NAME_EXPAND
 
+/**
+ * @brief GPIO numbers for each logical button (index-aligned with kButtonNames).
+ * Generated from the BUTTON_LIST macro so interrupt wiring follows the same mapping.
+ */
+#define INPUTTYPES_PIN_EXPAND(name, pin) pin,
+static constexpr std::uint8_t kButtonPins[NUM_BUTTONS] = {BUTTON_LIST(INPUTTYPES_PIN_EXPAND)};
+#undef INPUTTYPES_PIN_EXPAND
+
 // ---- Static checks ---- //
 
 static_assert(NUM_BUTTONS > 0, "Expected at least one button.");
 static_assert(sizeof(kButtonNames) / sizeof(kButtonNames[0]) == NUM_BUTTONS,
               "kButtonNames must match NUM_BUTTONS.");
+static_assert(sizeof(kButtonPins) / sizeof(kButtonPins[0]) == NUM_BUTTONS,
+              "kButtonPins must match NUM_BUTTONS.");
 
 // ---- Utilities ---- //
 
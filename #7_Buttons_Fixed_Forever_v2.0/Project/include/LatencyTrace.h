@@ -0,0 +1,228 @@
+/**
+ * MIT License
+ *
+ * @brief Lock-free end-to-end latency tracing (origin stamp → pipeline stage).
+ *
+ * @file LatencyTrace.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <HotPath.h>
+
+namespace trace
+{
+    /// @brief Pipeline checkpoints. Each records now_us() - origin_us of the frame passing it.
+    enum class Stage : std::uint8_t
+    {
+        InputBus = 0,  ///< Button edge → InputBus publish (debounce + settle).
+        ControlButton, ///< Button edge → ControlBus publish.
+        ControlRc,     ///< RC frame → ControlBus publish.
+        MotorButton,   ///< Button edge → motor drive().
+        MotorRc,       ///< RC frame → motor drive().
+        SteerRc,       ///< RC frame → steering pulse update.
+        Count
+    };
+
+    /// @brief Stage names (index-aligned with Stage).
+    inline constexpr const char *kStageNames[static_cast<std::size_t>(Stage::Count)] = {
+        "edge->input", "edge->control", "rc->control", "edge->motor", "rc->motor", "rc->steer"};
+
+    /// @brief One stage's figures (p99 at histogram resolution: a power-of-two bound).
+    struct Summary
+    {
+        uint32_t count{0};   ///< Samples.
+        uint32_t mean_us{0}; ///< Mean latency (µs).
+        uint32_t p99_us{0};  ///< 99th percentile bucket bound (µs).
+        uint32_t max_us{0};  ///< Largest sample (µs).
+    };
+
+    /**
+     * @brief Per-stage log2 latency histograms plus a ring of the most recent samples.
+     *
+     * record() takes no lock and never blocks, from any number of writer tasks:
+     * every counter is a relaxed atomic, min/max use a short CAS loop, and each
+     * ring entry is a single 64-bit word (stage | latency | low origin bits)
+     * claimed with one fetch_add. (64-bit atomics on Xtensa go through the
+     * IDF's brief atomic critical section, see AtomicSnapshot.h.) dump() prints
+     * from whichever task runs the debug console.
+     */
+    class LatencyTrace
+    {
+    public:
+        static constexpr std::size_t kBuckets = 24;       ///< Bucket b holds [2^(b-1), 2^b) µs; b = 0 → < 1 µs.
+        static constexpr std::size_t kRing = 64;          ///< Recent samples kept (power of two).
+        static constexpr uint32_t kMaxValidUs = 1U << 28; ///< Larger gaps are stale/wrapped stamps, not latency.
+
+        static_assert((kRing & (kRing - 1)) == 0, "kRing must be a power of two.");
+
+        /**
+         * @brief Record one frame passing @p stage.
+         *
+         * @param stage Checkpoint.
+         * @param origin_us Frame's origin stamp (now_us() at the physical event).
+         * @param now Current time (µs).
+         */
+        void HOT_IRAM record(Stage stage, uint64_t origin_us, uint64_t now) noexcept
+        {
+            if constexpr (!cfg::trace::LATENCY)
+                return;
+
+            if (origin_us == 0 || now < origin_us || (now - origin_us) >= kMaxValidUs)
+                return; ///< Unstamped or wrapped.
+
+            const uint32_t lat = static_cast<uint32_t>(now - origin_us);
+            Hist &h = hist_[static_cast<std::size_t>(stage)];
+
+            h.count.fetch_add(1, std::memory_order_relaxed);
+            h.sum_us.fetch_add(lat, std::memory_order_relaxed);
+            h.bucket[bucket(lat)].fetch_add(1, std::memory_order_relaxed);
+
+            uint32_t m = h.max_us.load(std::memory_order_relaxed);
+            while (lat > m && !h.max_us.compare_exchange_weak(m, lat, std::memory_order_relaxed))
+            {
+            }
+            m = h.min_us.load(std::memory_order_relaxed);
+            while (lat < m && !h.min_us.compare_exchange_weak(m, lat, std::memory_order_relaxed))
+            {
+            }
+
+            const uint32_t slot = head_.fetch_add(1, std::memory_order_relaxed) & (kRing - 1);
+            ring_[slot].store((static_cast<uint64_t>(stage) << 60) | (static_cast<uint64_t>(lat) << 32) |
+                                  static_cast<uint32_t>(origin_us),
+                              std::memory_order_relaxed);
+        }
+
+        /// @brief Clear all histograms and the ring.
+        void reset() noexcept
+        {
+            for (auto &h : hist_)
+            {
+                h.count.store(0, std::memory_order_relaxed);
+                h.sum_us.store(0, std::memory_order_relaxed);
+                h.min_us.store(UINT32_MAX, std::memory_order_relaxed);
+                h.max_us.store(0, std::memory_order_relaxed);
+                for (auto &b : h.bucket)
+                    b.store(0, std::memory_order_relaxed);
+            }
+            for (auto &r : ring_)
+                r.store(0, std::memory_order_relaxed);
+            head_.store(0, std::memory_order_relaxed);
+        }
+
+        /// @brief Figures for @p stage since the last reset() (any task).
+        [[nodiscard]] Summary summary(Stage stage) const noexcept
+        {
+            const Hist &h = hist_[static_cast<std::size_t>(stage)];
+            Summary s{};
+            s.count = h.count.load(std::memory_order_relaxed);
+            if (s.count == 0)
+                return s;
+            s.mean_us = static_cast<uint32_t>(h.sum_us.load(std::memory_order_relaxed) / s.count);
+            s.p99_us = percentile(h, s.count, 99);
+            s.max_us = h.max_us.load(std::memory_order_relaxed);
+            return s;
+        }
+
+        /// @brief Print per-stage summaries, non-empty buckets and the recent-sample ring.
+        void dump() const noexcept
+        {
+            debugln("stage          count    min    avg   p50<=  p99<=    max  (us)");
+            for (std::size_t s = 0; s < hist_.size(); ++s)
+            {
+                const Hist &h = hist_[s];
+                const uint32_t n = h.count.load(std::memory_order_relaxed);
+                if (n == 0)
+                {
+                    debugfln("%-13s %6u      -      -      -      -      -", kStageNames[s], 0u);
+                    continue;
+                }
+                debugfln("%-13s %6u %6u %6u %6u %6u %6u", kStageNames[s], static_cast<unsigned>(n),
+                         static_cast<unsigned>(h.min_us.load(std::memory_order_relaxed)),
+                         static_cast<unsigned>(h.sum_us.load(std::memory_order_relaxed) / n),
+                         static_cast<unsigned>(percentile(h, n, 50)), static_cast<unsigned>(percentile(h, n, 99)),
+                         static_cast<unsigned>(h.max_us.load(std::memory_order_relaxed)));
+
+                for (std::size_t b = 0; b < kBuckets; ++b)
+                {
+                    const uint32_t c = h.bucket[b].load(std::memory_order_relaxed);
+                    if (c > 0)
+                        debugfln("    <%8u us : %u", static_cast<unsigned>(upper(b)), static_cast<unsigned>(c));
+                }
+            }
+
+            debugln("recent (oldest first): stage latency_us origin_lo");
+            const uint32_t head = head_.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < kRing; ++i)
+            {
+                const uint64_t r = ring_[(head + i) & (kRing - 1)].load(std::memory_order_relaxed);
+                if (r == 0)
+                    continue;
+                debugfln("  %-13s %8u %10u", kStageNames[(r >> 60) & 0xF], static_cast<unsigned>((r >> 32) & 0x0FFFFFFF),
+                         static_cast<unsigned>(r & 0xFFFFFFFF));
+            }
+        }
+
+    private:
+        struct Hist
+        {
+            std::atomic<uint32_t> count{0};                       ///< Samples.
+            std::atomic<uint64_t> sum_us{0};                      ///< Sum (for the mean).
+            std::atomic<uint32_t> min_us{UINT32_MAX};             ///< Smallest sample.
+            std::atomic<uint32_t> max_us{0};                      ///< Largest sample.
+            std::array<std::atomic<uint32_t>, kBuckets> bucket{}; ///< log2 histogram.
+        };
+
+        /// @brief log2 bucket index for @p us.
+        static std::size_t bucket(uint32_t us) noexcept
+        {
+            const std::size_t b = (us == 0) ? 0 : static_cast<std::size_t>(32 - __builtin_clz(us));
+            return (b < kBuckets) ? b : (kBuckets - 1);
+        }
+
+        /// @brief Exclusive upper bound of bucket @p b (µs).
+        static uint32_t upper(std::size_t b) noexcept { return 1U << b; }
+
+        /// @brief Bucket upper bound containing the @p p-th percentile.
+        static uint32_t percentile(const Hist &h, uint32_t n, uint32_t p) noexcept
+        {
+            const uint64_t target = (static_cast<uint64_t>(n) * p + 99) / 100;
+            uint64_t acc = 0;
+            for (std::size_t b = 0; b < kBuckets; ++b)
+            {
+                acc += h.bucket[b].load(std::memory_order_relaxed);
+                if (acc >= target)
+                    return upper(b);
+            }
+            return h.max_us.load(std::memory_order_relaxed);
+        }
+
+        std::array<Hist, static_cast<std::size_t>(Stage::Count)> hist_{}; ///< Per-stage histograms.
+        std::array<std::atomic<uint64_t>, kRing> ring_{};                 ///< Recent samples (0 = empty).
+        std::atomic<uint32_t> head_{0};                                   ///< Next ring slot.
+    };
+
+    /**
+     * @brief Single, shared latency trace.
+     */
+    inline LatencyTrace &latency() noexcept
+    {
+        static LatencyTrace t{}; ///< One (only) trace instance.
+        return t;
+    }
+
+    /// @brief Shorthand: record @p stage for a frame stamped @p origin_us, now.
+    inline void mark(Stage stage, uint64_t origin_us) noexcept
+    {
+        if constexpr (cfg::trace::LATENCY)
+            latency().record(stage, origin_us, now_us());
+    }
+} ///< Namespace trace.
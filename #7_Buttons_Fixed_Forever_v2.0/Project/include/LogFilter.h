@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ *
+ * @brief Levelled logging: per-module compile-time ceilings plus a runtime level per module.
+ *
+ * @file LogFilter.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+/**
+ * @brief Log filtering for the logError / logWarn / logInfo / logDebug / logTrace macros.
+ *
+ * Two gates, both per module:
+ *  - compiled(): cfg::logging::MODULE[m]. A site above it sits in a discarded
+ *    `if constexpr` branch: no format string, no argument capture, no branch
+ *    in the binary. This is how a 1 kHz loop keeps its trace sites in the
+ *    source for free.
+ *  - enabled(): a runtime level (starts at cfg::logging::RUNTIME, set from the
+ *    'log' console command). One relaxed byte load per surviving site.
+ *
+ * A site picks its module through the unqualified name kLogModule: a class
+ * declares `static constexpr logx::Module kLogModule` (a free-function module
+ * declares it in its own namespace), which hides the App default below.
+ *
+ * Surviving sites go to debugfln (deferred ring when DEBUG_DEFERRED) while
+ * DEBUGGING is on, and straight to Serial otherwise, so warnings and errors
+ * still reach the UART in a production build.
+ */
+namespace logx
+{
+    using Level = cfg::logging::Level;   ///< Severity.
+    using Module = cfg::logging::Module; ///< Log source.
+
+    static constexpr std::size_t kModules = static_cast<std::size_t>(Module::Count); ///< Module count.
+
+    /// @brief Module names (index-aligned with Module; 'log' command).
+    inline constexpr const char *kModuleNames[kModules] = {"app",   "input",  "rc",      "control", "drive",
+                                                           "steering", "power", "fault", "lights", "storage",
+                                                           "ota",   "radio",  "tune",    "supervisor"};
+
+    /// @brief Level names (index-aligned with Level).
+    inline constexpr const char *kLevelNames[] = {"off", "error", "warn", "info", "debug", "trace"};
+
+    /// @brief True if sites of level @p l in @p m are compiled in.
+    constexpr bool compiled(Module m, Level l) noexcept
+    {
+        return l != Level::Off && l <= cfg::logging::MODULE[static_cast<std::size_t>(m)];
+    }
+
+    /// @brief Runtime level per module (constant-initialised: valid before any constructor logs).
+    struct Levels
+    {
+        std::atomic<uint8_t> v[kModules]; ///< Level per module.
+
+        constexpr Levels() noexcept : Levels(std::make_index_sequence<kModules>{}) {}
+
+    private:
+        template <std::size_t... I>
+        constexpr explicit Levels(std::index_sequence<I...>) noexcept : v{((void)I, static_cast<uint8_t>(cfg::logging::RUNTIME))...} {}
+    };
+
+    inline Levels g_levels{}; ///< Any task; relaxed: a level change shows up within a few sites.
+
+    /// @brief True if a compiled-in site of level @p l in @p m logs now.
+    inline bool enabled(Module m, Level l) noexcept
+    {
+        return static_cast<uint8_t>(l) <= g_levels.v[static_cast<std::size_t>(m)].load(std::memory_order_relaxed);
+    }
+
+    /// @brief Set @p m's runtime level (sites above its compiled ceiling stay out regardless).
+    inline void setLevel(Module m, Level l) noexcept
+    {
+        g_levels.v[static_cast<std::size_t>(m)].store(static_cast<uint8_t>(l), std::memory_order_relaxed);
+    }
+
+    /// @brief Runtime level of @p m.
+    inline Level level(Module m) noexcept
+    {
+        return static_cast<Level>(g_levels.v[static_cast<std::size_t>(m)].load(std::memory_order_relaxed));
+    }
+
+    /// @brief Module by name (false → unknown).
+    inline bool parse(const char *name, Module &out) noexcept
+    {
+        for (std::size_t i = 0; i < kModules; ++i)
+        {
+            if (std::strcmp(name, kModuleNames[i]) == 0)
+            {
+                out = static_cast<Module>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Level by name (false → unknown).
+    inline bool parse(const char *name, Level &out) noexcept
+    {
+        for (std::size_t i = 0; i < sizeof(kLevelNames) / sizeof(kLevelNames[0]); ++i)
+        {
+            if (std::strcmp(name, kLevelNames[i]) == 0)
+            {
+                out = static_cast<Level>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+} ///< Namespace logx.
+
+static_assert(sizeof(logx::kModuleNames) / sizeof(logx::kModuleNames[0]) == logx::kModules, "kModuleNames must match cfg::logging::Module.");
+
+/// @brief Default module for sites outside any module (hidden by a class / namespace kLogModule).
+inline constexpr logx::Module kLogModule = logx::Module::App;
+
+#if DEBUGGING
+#define LOG_EMIT(fmt, ...) debugfln(fmt, ##__VA_ARGS__)
+#else
+#define LOG_EMIT(fmt, ...) Serial.printf(fmt "\n", ##__VA_ARGS__) ///< Production: rare (warn / error) lines, straight to the UART.
+#endif
+
+// Levelled printf-style logging (format must be a string literal). Sites above the module's compiled
+// ceiling are discarded at compile time; the rest check the module's runtime level first.
+#define LOG_AT(lvl, fmt, ...)                                           \
+    do                                                                  \
+    {                                                                   \
+        if constexpr (logx::compiled(kLogModule, lvl))                  \
+        {                                                               \
+            if (logx::enabled(kLogModule, lvl))                         \
+                LOG_EMIT(fmt, ##__VA_ARGS__);                           \
+        }                                                               \
+    } while (0)
+
+#define logError(fmt, ...) LOG_AT(logx::Level::Error, fmt, ##__VA_ARGS__)
+#define logWarn(fmt, ...) LOG_AT(logx::Level::Warn, fmt, ##__VA_ARGS__)
+#define logInfo(fmt, ...) LOG_AT(logx::Level::Info, fmt, ##__VA_ARGS__)
+#define logDebug(fmt, ...) LOG_AT(logx::Level::Debug, fmt, ##__VA_ARGS__)
+#define logTrace(fmt, ...) LOG_AT(logx::Level::Trace, fmt, ##__VA_ARGS__)
@@ -0,0 +1,137 @@
+/**
+ * MIT License
+ *
+ * @brief Loop period / jitter statistics for periodic control tasks.
+ *
+ * @file LoopStats.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <HotPath.h>
+
+/**
+ * @brief Summary of a loop's measured periods.
+ */
+struct LoopStats
+{
+    uint32_t nominal_us{0}; ///< Expected period (µs).
+    uint32_t count{0};      ///< Periods measured since reset.
+    uint32_t overruns{0};   ///< Periods over budget + missed wakeups.
+    uint32_t min_us{0};     ///< Shortest measured period (µs).
+    uint32_t max_us{0};     ///< Longest measured period (µs).
+    uint32_t p99_us{0};     ///< 99th percentile period (µs, histogram resolution).
+    uint32_t last_us{0};    ///< Most recent period (µs).
+};
+
+/**
+ * @brief Measures the period between successive loop wakeups.
+ *
+ * Call tick() once per iteration with a monotonic µs time. Periods are kept in
+ * a fixed linear histogram (kBins bins covering 0..2x nominal) so p99 costs no
+ * allocation or sorting on the hot path.
+ */
+class LoopTimer
+{
+public:
+    static constexpr std::size_t kBins = 64; ///< Histogram bins (last bin = overflow).
+
+    /**
+     * @brief Construct for a loop with the given nominal period.
+     *
+     * @param nominal_us Expected period (µs).
+     * @param budget_us Period above which an iteration counts as an overrun (0 → 1.5x nominal).
+     */
+    explicit LoopTimer(uint32_t nominal_us = 1000, uint32_t budget_us = 0) noexcept
+        : nominal_us_(nominal_us ? nominal_us : 1),
+          budget_us_(budget_us ? budget_us : nominal_us_ + nominal_us_ / 2),
+          bin_us_((2 * nominal_us_) / kBins ? (2 * nominal_us_) / kBins : 1) {}
+
+    /**
+     * @brief Record one loop wakeup.
+     *
+     * @param now_us Monotonic time (µs).
+     * @return uint32_t Measured period (µs), or 0 on the first call.
+     */
+    uint32_t HOT_IRAM tick(uint64_t now_us) noexcept
+    {
+        if (last_us_ == 0)
+        {
+            last_us_ = now_us;
+            return 0; ///< First wakeup: no period yet.
+        }
+
+        const uint32_t period = static_cast<uint32_t>(now_us - last_us_);
+        last_us_ = now_us;
+
+        if (count_ == 0 || period < min_us_)
+            min_us_ = period;
+        if (period > max_us_)
+            max_us_ = period;
+        if (period > budget_us_)
+            ++overruns_;
+
+        const std::size_t bin = period / bin_us_;
+        ++hist_[(bin < kBins) ? bin : (kBins - 1)];
+        ++count_;
+        last_period_us_ = period;
+        return period;
+    }
+
+    /// @brief Count wakeups that never happened (e.g. coalesced timer notifications).
+    void missed(uint32_t n) noexcept { overruns_ += n; }
+
+    /// @brief The loop slept longer on purpose (adaptive cadence): the next tick() starts a new period.
+    void pause() noexcept { last_us_ = 0; }
+
+    /// @brief Snapshot the current statistics.
+    [[nodiscard]] LoopStats stats() const noexcept
+    {
+        LoopStats s{};
+        s.nominal_us = nominal_us_;
+        s.count = count_;
+        s.overruns = overruns_;
+        s.min_us = min_us_;
+        s.max_us = max_us_;
+        s.last_us = last_period_us_;
+
+        // p99: first bin whose cumulative count reaches 99% of samples.
+        const uint32_t target = count_ - count_ / 100;
+        uint32_t acc = 0;
+        for (std::size_t i = 0; i < kBins; ++i)
+        {
+            acc += hist_[i];
+            if (acc >= target && count_ > 0)
+            {
+                s.p99_us = (i + 1 < kBins) ? static_cast<uint32_t>((i + 1) * bin_us_) : max_us_;
+                break;
+            }
+        }
+        return s;
+    }
+
+    /// @brief Clear all statistics (keeps the period reference).
+    void reset() noexcept
+    {
+        count_ = overruns_ = min_us_ = max_us_ = last_period_us_ = 0;
+        hist_.fill(0);
+    }
+
+private:
+    uint32_t nominal_us_;                ///< Expected period (µs).
+    uint32_t budget_us_;                 ///< Overrun threshold (µs).
+    uint32_t bin_us_;                    ///< Histogram bin width (µs).
+    uint64_t last_us_{0};                ///< Previous wakeup time (µs).
+    uint32_t count_{0};                  ///< Periods measured.
+    uint32_t overruns_{0};               ///< Over-budget periods + missed wakeups.
+    uint32_t min_us_{0};                 ///< Shortest period (µs).
+    uint32_t max_us_{0};                 ///< Longest period (µs).
+    uint32_t last_period_us_{0};         ///< Most recent period (µs).
+    std::array<uint32_t, kBins> hist_{}; ///< Period histogram.
+};
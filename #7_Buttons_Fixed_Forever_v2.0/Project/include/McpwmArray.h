@@ -0,0 +1,230 @@
+/**
+ * MIT License
+ *
+ * @brief Up to six H-bridges on both MCPWM units, all duty changes landing on the same PWM period.
+ *
+ * @file McpwmArray.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <driver/mcpwm.h>
+#include <soc/mcpwm_struct.h>
+#include <freertos/FreeRTOS.h>
+#include <MotorBackend.h>
+#include <HotPath.h>
+
+namespace motor
+{
+    /**
+     * @brief N bridges (N ≤ 6) on MCPWM timers, one bridge per timer/operator.
+     *
+     * Bridge i uses unit i / 3, timer (and operator) i % 3: A → LPWM, B → RPWM.
+     *
+     * Synchronised updates:
+     *  - Timers 1 and 2 of each unit re-phase to timer 0 on every TEZ, and both
+     *    units' timer 0 are soft-synced together in begin(). All carriers run
+     *    from the same clock at the same period, so their TEZ stay aligned.
+     *  - setSpeedPercent() clears UPDATE_CFG.global_up_en on the units in use,
+     *    writes every compare shadow register, then sets it again in one
+     *    critical section. The active compares only reload at TEZ with the
+     *    enable set, so a batch lands on one period boundary or not at all.
+     *
+     * Same contract as the single-bridge backends (bound as DriveBackend);
+     * drive() applies one duty to every bridge.
+     *
+     * @tparam N Number of bridges.
+     */
+    template <std::size_t N>
+    class McpwmArray
+    {
+    public:
+        static_assert(N >= 1 && N <= 6, "Two MCPWM units × three timers: at most six bridges.");
+
+        static constexpr const char *kLabel = "MCPWMx"; ///< Log label.
+        static constexpr std::size_t kChannels = N;     ///< Bridges driven per batch.
+
+        /// @brief One bridge.
+        struct Bridge
+        {
+            int rpwm_pin{-1}; ///< Right PWM input (generator B).
+            int lpwm_pin{-1}; ///< Left PWM input (generator A).
+            int en_pin{-1};   ///< Enable (-1 → tied high).
+        };
+
+        /**
+         * @brief Construct (no hardware access).
+         *
+         * @param bridges Pins, in bridge order.
+         * @param c Shared settings (pwm_hz, min_pct).
+         */
+        McpwmArray(const std::array<Bridge, N> &bridges, const Config &c) noexcept : bridges_(bridges), c_(c) {}
+
+        /// @brief Configure every timer, align the carriers and start in coast.
+        bool begin() noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const Bridge &b = bridges_[i];
+                if (b.rpwm_pin < 0 || b.lpwm_pin < 0)
+                    return false;
+                if (b.en_pin >= 0)
+                {
+                    digitalWrite(b.en_pin, LOW);
+                    pinMode(b.en_pin, OUTPUT);
+                }
+
+                const mcpwm_unit_t u = unit(i);
+                const mcpwm_timer_t t = timer(i);
+                mcpwm_gpio_init(u, static_cast<mcpwm_io_signals_t>(MCPWM0A + 2 * t), b.lpwm_pin);
+                mcpwm_gpio_init(u, static_cast<mcpwm_io_signals_t>(MCPWM0B + 2 * t), b.rpwm_pin);
+
+                mcpwm_config_t pc{};
+                pc.frequency = c_.pwm_hz;
+                pc.cmpr_a = 0.0f;
+                pc.cmpr_b = 0.0f;
+                pc.duty_mode = MCPWM_DUTY_MODE_0;
+                pc.counter_mode = MCPWM_UP_COUNTER;
+                if (mcpwm_init(u, t, &pc) != ESP_OK)
+                    return false;
+
+                // Timer 0 leads its unit; 1 and 2 reload phase 0 on its TEZ.
+                mcpwm_sync_config_t sc{};
+                sc.sync_sig = (t == MCPWM_TIMER_0) ? MCPWM_SELECT_NO_INPUT : MCPWM_SELECT_TIMER0_SYNC;
+                sc.timer_val = 0;
+                sc.count_direction = MCPWM_TIMER_DIRECTION_UP;
+                mcpwm_sync_configure(u, t, &sc);
+                if (t == MCPWM_TIMER_0)
+                    mcpwm_set_timer_sync_output(u, t, MCPWM_SWSYNC_SOURCE_TEZ);
+            }
+
+            // Align the two units (a few APB cycles apart; same clock keeps them there).
+            portENTER_CRITICAL(&mux_);
+            mcpwm_timer_trigger_soft_sync(MCPWM_UNIT_0, MCPWM_TIMER_0);
+            if constexpr (N > 3)
+                mcpwm_timer_trigger_soft_sync(MCPWM_UNIT_1, MCPWM_TIMER_0);
+            portEXIT_CRITICAL(&mux_);
+
+            duty_.fill(-1.0f);
+            coast();
+            return true;
+        }
+
+        /**
+         * @brief Drive every bridge from one batch, applied on a single PWM period boundary.
+         *
+         * @param pct Duty per bridge (clamped; non-zero lifted to min_pct).
+         * @param dir Direction for all bridges (CCW → RPWM).
+         */
+        void HOT_IRAM setSpeedPercent(const std::array<float, N> &pct, Dir dir) noexcept
+        {
+            std::array<float, N> next{};
+            bool changed = dir != dir_;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                next[i] = shapePct(pct[i], c_.min_pct);
+                changed |= next[i] != duty_[i];
+            }
+            if (!changed)
+                return;
+
+            hold(true);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const mcpwm_generator_t on = (dir == Dir::CCW) ? MCPWM_GEN_B : MCPWM_GEN_A;
+                const mcpwm_generator_t off = (dir == Dir::CCW) ? MCPWM_GEN_A : MCPWM_GEN_B;
+                mcpwm_set_duty(unit(i), timer(i), off, 0.0f);
+                mcpwm_set_duty(unit(i), timer(i), on, next[i]);
+            }
+            hold(false);
+
+            duty_ = next;
+            dir_ = dir;
+            enable(true);
+        }
+
+        /**
+         * @brief Same duty on every bridge (single-bridge backend contract).
+         *
+         * @param pct Duty percentage.
+         * @param dir Direction.
+         */
+        void drive(float pct, Dir dir) noexcept
+        {
+            std::array<float, N> all{};
+            all.fill(pct);
+            setSpeedPercent(all, dir);
+        }
+
+        /// @brief All bridges to 0 % and disabled (HiZ).
+        void coast() noexcept
+        {
+            std::array<float, N> zero{};
+            setSpeedPercent(zero, dir_);
+            enable(false);
+        }
+
+        /// @brief All bridges to 0 % and enabled: low sides on (dynamic brake).
+        void brake() noexcept
+        {
+            std::array<float, N> zero{};
+            setSpeedPercent(zero, dir_);
+            enable(true); ///< setSpeedPercent() skips unchanged duty, so assert EN here.
+        }
+
+        /// @brief Coast, stop the timers and float the pins.
+        void end() noexcept
+        {
+            coast();
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                mcpwm_stop(unit(i), timer(i));
+                pinMode(bridges_[i].rpwm_pin, INPUT);
+                pinMode(bridges_[i].lpwm_pin, INPUT);
+            }
+        }
+
+        /// @brief Last applied duty per bridge (%).
+        [[nodiscard]] const std::array<float, N> &duty() const noexcept { return duty_; }
+
+    private:
+        static constexpr mcpwm_unit_t unit(std::size_t i) noexcept { return i < 3 ? MCPWM_UNIT_0 : MCPWM_UNIT_1; }
+        static constexpr mcpwm_timer_t timer(std::size_t i) noexcept { return static_cast<mcpwm_timer_t>(i % 3); }
+
+        /// @brief Gate the shadow → active reload on the units in use.
+        void HOT_IRAM hold(bool on) noexcept
+        {
+            portENTER_CRITICAL(&mux_);
+            MCPWM0.update_cfg.global_up_en = on ? 0 : 1;
+            if constexpr (N > 3)
+                MCPWM1.update_cfg.global_up_en = on ? 0 : 1;
+            portEXIT_CRITICAL(&mux_);
+        }
+
+        /// @brief Drive every EN pin (only on change).
+        void enable(bool on) noexcept
+        {
+            if (enabled_ == on)
+                return;
+            for (const Bridge &b : bridges_)
+                if (b.en_pin >= 0)
+                    digitalWrite(b.en_pin, on ? HIGH : LOW);
+            enabled_ = on;
+        }
+
+        std::array<Bridge, N> bridges_;                   ///< Pins per bridge.
+        Config c_;                                        ///< Shared settings copy.
+        std::array<float, N> duty_{};                     ///< Last applied duty (-1 → unknown).
+        Dir dir_{Dir::CW};                                ///< Last applied direction.
+        bool enabled_{true};                              ///< EN level (true so begin()'s coast drives it low).
+        portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED; ///< Guards the UPDATE_CFG writes.
+    };
+} ///< Namespace motor.
@@ -0,0 +1,387 @@
+/**
+ * MIT License
+ *
+ * @brief Compile-time motor backends (LEDC, MCPWM, RMT servo/ESC) with one non-virtual drive interface.
+ *
+ * @file MotorBackend.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <driver/mcpwm.h>
+#include <driver/rmt.h>
+#include <ESP32_MCPWM.h>
+
+// The #3 Motor_Test sweep / rotation harnesses include this file too (no app_config.h here).
+namespace motor
+{
+    // ---- Backend contract ---- //
+    //
+    // Every backend is a plain class with the same members, so callers bind
+    // to one as a template parameter (no vtable, the drive call inlines):
+    //   static constexpr const char *kLabel;           log label
+    //   static constexpr std::size_t kChannels;        outputs per batch
+    //   explicit B(const Config &);                     keeps a copy, touches no hardware
+    //   bool begin();                                   claim the pins, outputs in coast
+    //   void drive(float pct, Dir dir);                 0..100 % in dir (hot path)
+    //   void setSpeedPercent(array<float, kChannels>, Dir);  batch form of drive()
+    //   void coast();                                   outputs off / neutral
+    //   void brake();                                   both low sides on (motor shorted) / neutral
+    //   void end();                                     coast and release the pins
+    // Dir::CCW drives the RPWM leg, matching the MCPWM library and test rigs.
+    // Neither drive() nor brake() guards a direction change: callers stop,
+    // brake or coast and wait out a dead time before driving the other leg.
+
+    /// @brief Settings shared by all backends (each reads the fields it needs).
+    struct Config
+    {
+        // ---- H-bridge pins (IBT-2 / BTS7960) ---- //
+        int rpwm_pin{-1}; ///< Right PWM input.
+        int lpwm_pin{-1}; ///< Left PWM input.
+        int en_pin{-1};   ///< Bridge enable (-1 → tied high).
+
+        // ---- PWM ---- //
+        uint32_t pwm_hz{20000}; ///< Carrier frequency (20 kHz: inaudible).
+        float min_pct{0.0f};    ///< Floor for any non-zero command (stiction).
+
+        // ---- LEDC ---- //
+        uint8_t ledc_ch_r{0}; ///< Channel on RPWM.
+        uint8_t ledc_ch_l{1}; ///< Channel on LPWM.
+
+        // ---- MCPWM ---- //
+        mcpwm_unit_t mcpwm_unit{MCPWM_UNIT_0}; ///< Unit (timer 0, A → LPWM, B → RPWM).
+        MotorBehaviorConfig behavior{};        ///< Freewheel / soft-brake behaviour.
+
+        // ---- RMT servo / ESC ---- //
+        int servo_pin{-1};                   ///< Signal pin.
+        rmt_channel_t rmt_ch{RMT_CHANNEL_0}; ///< TX channel.
+        uint16_t neutral_us{1500};           ///< Pulse at 0 % (stopped / centred).
+        uint16_t span_us{500};               ///< Pulse change at 100 %.
+        bool reversible{true};               ///< Dir::CCW goes below neutral (false → forward-only ESC).
+    };
+
+    /// @brief Clamp a duty percentage to [0, 100].
+    constexpr float clampPct(float p) noexcept { return (p < 0.0f) ? 0.0f : ((p > 100.0f) ? 100.0f : p); }
+
+    /// @brief Clamp, then lift non-zero commands to @p floor.
+    constexpr float shapePct(float p, float floor) noexcept
+    {
+        p = clampPct(p);
+        return (p > 0.0f && p < floor) ? floor : p;
+    }
+
+    /**
+     * @brief Two LEDC channels, one per bridge leg; the idle leg is held at 0 %.
+     *
+     * @tparam Bits Duty resolution (10 → 0..1023).
+     */
+    template <uint8_t Bits = 10>
+    class LedcBackend
+    {
+    public:
+        static constexpr const char *kLabel = "LEDC"; ///< Log label.
+        static constexpr std::size_t kChannels = 1;   ///< Outputs per batch.
+
+        /// @brief Construct (no hardware access).
+        explicit LedcBackend(const Config &c) noexcept : c_(c) {}
+
+        /// @brief Attach both legs at 0 % with the bridge disabled.
+        bool begin() noexcept
+        {
+            enable(false);
+            for (const auto &[pin, ch] : {std::pair<int, uint8_t>{c_.rpwm_pin, c_.ledc_ch_r}, {c_.lpwm_pin, c_.ledc_ch_l}})
+            {
+                if (pin < 0)
+                    return false;
+                ledcSetup(ch, c_.pwm_hz, Bits);
+                ledcAttachPin(pin, ch);
+                ledcWrite(ch, 0);
+            }
+            duty_r_ = duty_l_ = 0;
+            return true;
+        }
+
+        /**
+         * @brief Drive one leg, hold the other at 0 and enable the bridge.
+         *
+         * @param pct Duty percentage (clamped; non-zero lifted to min_pct).
+         * @param dir Direction (CCW → RPWM).
+         */
+        void drive(float pct, Dir dir) noexcept
+        {
+            const uint32_t duty = toDuty(shapePct(pct, c_.min_pct));
+            const bool right = dir == Dir::CCW;
+            write(right ? c_.ledc_ch_l : c_.ledc_ch_r, right ? duty_l_ : duty_r_, 0); ///< Idle leg first: never both high.
+            write(right ? c_.ledc_ch_r : c_.ledc_ch_l, right ? duty_r_ : duty_l_, duty);
+            enable(true);
+        }
+
+        /// @brief Batch form of drive() (one output).
+        void setSpeedPercent(const std::array<float, kChannels> &pct, Dir dir) noexcept { drive(pct[0], dir); }
+
+        /// @brief Both legs to 0 and the bridge disabled (HiZ).
+        void coast() noexcept
+        {
+            write(c_.ledc_ch_r, duty_r_, 0);
+            write(c_.ledc_ch_l, duty_l_, 0);
+            enable(false);
+        }
+
+        /// @brief Both legs to 0 with the bridge enabled: low sides on, the motor brakes on its own back-EMF.
+        void brake() noexcept
+        {
+            write(c_.ledc_ch_r, duty_r_, 0);
+            write(c_.ledc_ch_l, duty_l_, 0);
+            enable(true);
+        }
+
+        /// @brief Coast, detach and float the pins.
+        void end() noexcept
+        {
+            coast();
+            for (const int pin : {c_.rpwm_pin, c_.lpwm_pin})
+            {
+                ledcDetachPin(pin);
+                pinMode(pin, INPUT);
+            }
+            delay(50);
+        }
+
+    private:
+        static constexpr uint32_t kMaxDuty = (1u << Bits) - 1u; ///< Full-scale duty.
+
+        /// @brief Percent → duty count.
+        static uint32_t toDuty(float pct) noexcept
+        {
+            return static_cast<uint32_t>(std::lroundf(pct * static_cast<float>(kMaxDuty) / 100.0f));
+        }
+
+        /// @brief ledcWrite only on change (each write is a peripheral register update).
+        static void write(uint8_t ch, uint32_t &cached, uint32_t duty) noexcept
+        {
+            if (cached == duty)
+                return;
+            ledcWrite(ch, duty);
+            cached = duty;
+        }
+
+        /// @brief Drive EN (only on change).
+        void enable(bool on) noexcept
+        {
+            if (c_.en_pin < 0 || (enabled_ == on && en_init_))
+                return;
+            if (!en_init_)
+            {
+                digitalWrite(c_.en_pin, LOW);
+                pinMode(c_.en_pin, OUTPUT);
+                en_init_ = true;
+            }
+            digitalWrite(c_.en_pin, on ? HIGH : LOW);
+            enabled_ = on;
+        }
+
+        Config c_;                    ///< Settings copy.
+        uint32_t duty_r_{UINT32_MAX}; ///< Last RPWM duty (MAX → unknown).
+        uint32_t duty_l_{UINT32_MAX}; ///< Last LPWM duty (MAX → unknown).
+        bool enabled_{false};         ///< EN level.
+        bool en_init_{false};         ///< EN pin configured.
+    };
+
+    /// @brief MCPWM carrier alignment.
+    enum class Alignment : uint8_t
+    {
+        Edge = 0, ///< Up counter: both legs switch on the period edge.
+        Center    ///< Up/down counter: pulses centred in the period (the test rigs' setting).
+    };
+
+    /**
+     * @brief ESP32_MCPWM Motor on one MCPWM timer.
+     *
+     * drive() calls setSpeedPercent on the concrete Motor member, so the call
+     * binds statically even though Motor implements IMotorDriver.
+     *
+     * @tparam Align Carrier alignment.
+     * @tparam Deadtime Let the library insert deadtime (bridges without their own shoot-through guard).
+     */
+    template <Alignment Align = Alignment::Edge, bool Deadtime = false>
+    class McpwmBackend
+    {
+    public:
+        static constexpr const char *kLabel = "MCPWM"; ///< Log label.
+        static constexpr std::size_t kChannels = 1;    ///< Outputs per batch.
+
+        /// @brief Construct (no hardware access).
+        explicit McpwmBackend(const Config &c) noexcept : c_(c) {}
+
+        /// @brief Configure once, (re)route the pins and start in coast.
+        bool begin() noexcept
+        {
+            if (c_.rpwm_pin < 0 || c_.lpwm_pin < 0)
+                return false;
+            if (!configured_)
+            {
+                MotorMCPWMConfig hw{};
+                hw.lpwm_pin = c_.lpwm_pin;
+                hw.rpwm_pin = c_.rpwm_pin;
+                hw.en_pin = c_.en_pin;
+                hw.unit = c_.mcpwm_unit;
+                hw.pwm_freq_hz = c_.pwm_hz;
+                hw.counter = (Align == Alignment::Center) ? MCPWM_UP_DOWN_COUNTER : MCPWM_UP_COUNTER;
+                hw.use_deadtime = Deadtime;
+                motor_.setup(hw, c_.behavior);
+                configured_ = true;
+            }
+
+            // Re-assert pin ownership (another backend may have held them last).
+            mcpwm_gpio_init(c_.mcpwm_unit, MCPWM0A, c_.lpwm_pin);
+            mcpwm_gpio_init(c_.mcpwm_unit, MCPWM0B, c_.rpwm_pin);
+            motor_.start();
+            coast();
+            return true;
+        }
+
+        /**
+         * @brief Drive at a duty percentage.
+         *
+         * @param pct Duty percentage (clamped; non-zero lifted to min_pct).
+         * @param dir Direction.
+         */
+        void drive(float pct, Dir dir) noexcept { motor_.setSpeedPercent(shapePct(pct, c_.min_pct), dir); }
+
+        /// @brief Batch form of drive() (one output).
+        void setSpeedPercent(const std::array<float, kChannels> &pct, Dir dir) noexcept { drive(pct[0], dir); }
+
+        /// @brief Freewheel in HiZ (EN low).
+        void coast() noexcept { motor_.applyFreewheel(FreewheelMode::HiZ); }
+
+        /// @brief Both generators to 0 % with EN high: low sides on (dynamic brake).
+        void brake() noexcept
+        {
+            mcpwm_set_duty(c_.mcpwm_unit, MCPWM_TIMER_0, MCPWM_GEN_A, 0.0f);
+            mcpwm_set_duty(c_.mcpwm_unit, MCPWM_TIMER_0, MCPWM_GEN_B, 0.0f);
+            if (c_.en_pin >= 0)
+                digitalWrite(c_.en_pin, HIGH); ///< The library's next drive() / coast() takes EN back.
+        }
+
+        /// @brief Coast and float the pins.
+        void end() noexcept
+        {
+            coast();
+            for (const int pin : {c_.rpwm_pin, c_.lpwm_pin})
+                pinMode(pin, INPUT);
+            delay(50);
+        }
+
+        /// @brief Underlying library motor (brake modes, dithering).
+        Motor &raw() noexcept { return motor_; }
+
+    private:
+        Config c_;               ///< Settings copy.
+        Motor motor_;            ///< ESP32_MCPWM driver.
+        bool configured_{false}; ///< setup() ran.
+    };
+
+    /**
+     * @brief Servo / ESC pulse on one RMT channel (1 µs ticks, looped in hardware).
+     *
+     * The channel repeats one item (high pulse, low rest of the period), so
+     * the signal needs no CPU once started; drive() rewrites the item only
+     * when the pulse width changes.
+     *
+     * @tparam PeriodUs Frame period (20000 → 50 Hz).
+     */
+    template <uint32_t PeriodUs = 20000>
+    class RmtServoBackend
+    {
+    public:
+        static constexpr const char *kLabel = "RMT"; ///< Log label.
+        static constexpr std::size_t kChannels = 1;  ///< Outputs per batch.
+
+        static_assert(PeriodUs > 2500 && PeriodUs <= 32767, "One RMT item must hold the low part of the period.");
+
+        /// @brief Construct (no hardware access).
+        explicit RmtServoBackend(const Config &c) noexcept : c_(c) {}
+
+        /// @brief Install the channel and start looping the neutral pulse.
+        bool begin() noexcept
+        {
+            if (c_.servo_pin < 0)
+                return false;
+            rmt_config_t rc = RMT_DEFAULT_CONFIG_TX(static_cast<gpio_num_t>(c_.servo_pin), c_.rmt_ch);
+            rc.clk_div = 80; ///< 80 MHz APB → 1 µs per tick.
+            rc.tx_config.loop_en = true;
+            rc.tx_config.carrier_en = false;
+            rc.tx_config.idle_output_en = true;
+            rc.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+            if (rmt_config(&rc) != ESP_OK || rmt_driver_install(c_.rmt_ch, 0, 0) != ESP_OK)
+                return false;
+
+            installed_ = true;
+            items_[1].val = 0; ///< End marker: loop back to item 0.
+            pulse_us_ = 0;
+            setPulse(c_.neutral_us);
+            return rmt_tx_start(c_.rmt_ch, true) == ESP_OK;
+        }
+
+        /**
+         * @brief Pulse = neutral ± pct·span (CCW below neutral when reversible).
+         *
+         * @param pct Command percentage (clamped; non-zero lifted to min_pct).
+         * @param dir Direction.
+         */
+        void drive(float pct, Dir dir) noexcept
+        {
+            const float off = shapePct(pct, c_.min_pct) * static_cast<float>(c_.span_us) / 100.0f;
+            const bool reverse = c_.reversible && dir == Dir::CCW;
+            const long us = std::lroundf(reverse ? c_.neutral_us - off : c_.neutral_us + off);
+            setPulse(static_cast<uint16_t>(us < 1 ? 1 : (us >= static_cast<long>(PeriodUs) ? PeriodUs - 1 : us)));
+        }
+
+        /// @brief Batch form of drive() (one output).
+        void setSpeedPercent(const std::array<float, kChannels> &pct, Dir dir) noexcept { drive(pct[0], dir); }
+
+        /// @brief Neutral pulse (ESC stopped / servo centred).
+        void coast() noexcept { setPulse(c_.neutral_us); }
+
+        /// @brief Neutral pulse (the ESC applies its own brake).
+        void brake() noexcept { coast(); }
+
+        /// @brief Stop the signal and release the channel.
+        void end() noexcept
+        {
+            if (!installed_)
+                return;
+            rmt_tx_stop(c_.rmt_ch);
+            rmt_driver_uninstall(c_.rmt_ch);
+            installed_ = false;
+        }
+
+    private:
+        /// @brief Rewrite item 0 if the width changed.
+        void setPulse(uint16_t us) noexcept
+        {
+            if (!installed_ || us == pulse_us_)
+                return;
+            items_[0].level0 = 1;
+            items_[0].duration0 = us;
+            items_[0].level1 = 0;
+            items_[0].duration1 = PeriodUs - us;
+            rmt_fill_tx_items(c_.rmt_ch, items_, 2, 0);
+            pulse_us_ = us;
+        }
+
+        Config c_;                ///< Settings copy.
+        rmt_item32_t items_[2]{}; ///< Pulse item + end marker.
+        uint16_t pulse_us_{0};    ///< Current pulse width (0 → none yet).
+        bool installed_{false};   ///< RMT driver installed.
+    };
+} ///< Namespace motor.
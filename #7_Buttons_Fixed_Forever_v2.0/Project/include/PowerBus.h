@@ -0,0 +1,47 @@
+/**
+ * MIT License
+ *
+ * @brief Snapshot payload and bus for bus voltage / motor current (AdcService → drive, protection).
+ *
+ * @file PowerBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+
+/**
+ * @brief Electrical state averaged over one ADC DMA frame.
+ */
+struct PowerSnapshot
+{
+    float vbus_v{0.0f};    ///< Bus voltage (V; 0 without a Vbus pin).
+    float amps{0.0f};      ///< Bridge current (A, ≥ 0; 0 without a current pin).
+    float watts{0.0f};     ///< vbus_v × amps (W).
+    uint16_t samples{0};   ///< Conversions behind this frame (all pins).
+    bool has_vbus{false};  ///< vbus_v is measured.
+    bool has_amps{false};  ///< amps is measured.
+    uint64_t stamp_us{0};  ///< Frame read time (µs since boot).
+};
+
+/**
+ * @brief Type alias for the bus that transports power frames.
+ */
+using PowerBus = snapshot::SignalBus<PowerSnapshot>;
+
+/**
+ * @brief Single, shared PowerBus instance.
+ */
+namespace buses
+{
+    inline PowerBus &power() noexcept ///< Return reference to the shared PowerBus.
+    {
+        static PowerBus bus{}; ///< One (only) PowerBus instance.
+        return bus;            ///< Return reference to shared bus.
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * MIT License
+ *
+ * @brief Snapshot payload and bus for per-task runtime profiling (stack, CPU, overruns).
+ *
+ * @file ProfileBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+#include <LoopStats.h>
+
+/**
+ * @brief One watched RTOS task, as of the last profiler sample.
+ */
+struct TaskProfile
+{
+    static constexpr uint16_t kNoCpu = 0xFFFF; ///< cpu_permille when run-time stats are disabled.
+    static constexpr uint8_t kAnyCore = 0xFF;  ///< core for unpinned tasks.
+
+    const char *name{""};          ///< FreeRTOS task name.
+    uint32_t stack_words{0};       ///< Stack size the task was created with (words).
+    uint32_t stack_free_words{0};  ///< Lowest free stack ever seen (high-water mark, same unit as stack_words).
+    uint16_t cpu_permille{kNoCpu}; ///< Share of one core over the last sample period (‰).
+    uint8_t priority{0};           ///< Current priority.
+    uint8_t core{kAnyCore};        ///< Pinned core (kAnyCore → either).
+    bool has_loop{false};          ///< True if @ref loop is populated (periodic tasks).
+    LoopStats loop{};              ///< Loop period / overrun statistics since boot.
+};
+
+/**
+ * @brief Whole-system profile published by TaskProfiler every sample period.
+ */
+struct ProfileSnapshot
+{
+    static constexpr std::size_t kMaxTasks = 12; ///< Watched-task capacity (every optional task enabled + self).
+    static constexpr std::size_t kCores = 2;     ///< ESP32-S3 cores.
+
+    std::array<TaskProfile, kMaxTasks> tasks{};        ///< Watched tasks (first @ref count valid).
+    uint8_t count{0};                                  ///< Used entries in tasks.
+    bool run_time_stats{false};                        ///< True if cpu_permille / core_load_permille are measured.
+    std::array<uint16_t, kCores> core_load_permille{}; ///< Non-idle time per core over the period (‰).
+    uint32_t heap_free{0};                             ///< Free heap now (bytes).
+    uint32_t heap_min_free{0};                         ///< Lowest free heap since boot (bytes).
+    uint64_t stamp_us{0};                              ///< Sample timestamp (µs since boot).
+};
+
+/**
+ * @brief Type alias for the SnapshotBus that transports profile samples.
+ */
+using ProfileBus = snapshot::SignalBus<ProfileSnapshot>;
+
+/**
+ * @brief Single, shared ProfileBus instance.
+ */
+namespace buses
+{
+    inline ProfileBus &profile() noexcept ///< Return reference to the shared ProfileBus.
+    {
+        static ProfileBus bus{}; ///< One (only) ProfileBus instance.
+        return bus;              ///< Return reference to shared bus.
+    }
+}
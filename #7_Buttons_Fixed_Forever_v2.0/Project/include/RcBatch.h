@@ -0,0 +1,301 @@
+/**
+ * MIT License
+ *
+ * @brief Whole-frame RC channel kernels: change detection and int16 → float / Q16 mapping in one pass.
+ *
+ * @file RcBatch.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <FixedPoint.h>
+
+namespace rc_batch
+{
+    /**
+     * @brief Per-channel Q16.16 scale / offset, applied while converting to float.
+     *
+     * out[i] = (src[i] * scale[i] + offset[i]) / 65536. The default is the
+     * identity, i.e. RcLink's mapped units are published unchanged. Keep
+     * |src * gain + bias| below 32768 so the product stays in 32 bits.
+     *
+     * @tparam N Channel count.
+     */
+    template <std::size_t N>
+    struct Table
+    {
+        static constexpr int32_t kOne = 1 << 16; ///< 1.0 in Q16.16.
+
+        std::array<int32_t, N> scale{};  ///< Q16.16 gain per channel.
+        std::array<int32_t, N> offset{}; ///< Q16.16 offset per channel (output units).
+
+        constexpr Table() noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                scale[i] = kOne;
+        }
+
+        /**
+         * @brief Set channel @p i to out = src * gain + bias.
+         *
+         * @param i Channel index.
+         * @param gain Multiplier.
+         * @param bias Offset (output units).
+         */
+        constexpr void set(std::size_t i, float gain, float bias) noexcept
+        {
+            scale[i] = static_cast<int32_t>(gain * kOne);
+            offset[i] = static_cast<int32_t>(bias * kOne);
+        }
+    };
+
+    /**
+     * @brief Unpack 16 × 11-bit channels (SBUS / CRSF layout, LSB first) to µs-equivalent.
+     *
+     * 172 → 988, 992 → 1500, 1811 → 2012 µs (5/8 µs per count), matching iBUS
+     * so one role mapping serves every protocol.
+     *
+     * @param p Packed payload (22 bytes; one more readable byte must follow).
+     * @param out 16 channel values (µs).
+     */
+    inline void unpack11_us(const uint8_t *p, uint16_t *out) noexcept
+    {
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const std::size_t bit = i * 11;
+            const std::size_t byte = bit >> 3;
+            const uint32_t word = p[byte] | (p[byte + 1] << 8) | (p[byte + 2] << 16); ///< Read in place: no frame copy.
+            const int32_t v = static_cast<int32_t>((word >> (bit & 7)) & 0x7FF);
+            out[i] = static_cast<uint16_t>(1500 + ((v - 992) * 5) / 8);
+        }
+    }
+
+    /**
+     * @brief True if any channel differs from @p ref by more than @p eps counts.
+     *
+     * Integer compare over the whole frame, so unchanged frames are rejected
+     * before anything is converted or written to the bus.
+     *
+     * @param cur Current frame.
+     * @param ref Reference (last published) frame.
+     * @param n Channels.
+     * @param eps Allowed |delta| (0 → any change).
+     */
+    inline bool moved(const int16_t *cur, const int16_t *ref, std::size_t n, int32_t eps) noexcept
+    {
+        int32_t worst = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            int32_t d = static_cast<int32_t>(cur[i]) - ref[i];
+            d = (d < 0) ? -d : d;
+            worst = (d > worst) ? d : worst; ///< Branch-free max: the loop unrolls cleanly.
+        }
+        return worst > eps;
+    }
+
+    /**
+     * @brief Map a whole frame straight into the publish buffer.
+     *
+     * @param src RcLink channel values.
+     * @param dst Output (e.g. RcSnapshot::out).
+     * @param n Channels (≤ N).
+     * @param t Scale / offset table.
+     */
+    template <std::size_t N>
+    inline void map(const int16_t *src, float *dst, std::size_t n, const Table<N> &t) noexcept
+    {
+        constexpr float kInv = 1.0f / static_cast<float>(Table<N>::kOne);
+        const std::size_t m = (n < N) ? n : N;
+        for (std::size_t i = 0; i < m; ++i)
+            dst[i] = static_cast<float>(static_cast<int32_t>(src[i]) * t.scale[i] + t.offset[i]) * kInv;
+    }
+
+    /// @brief Q16.16 overload: the table product already is the result, so no conversion at all.
+    template <std::size_t N>
+    inline void map(const int16_t *src, fixed::Q16 *dst, std::size_t n, const Table<N> &t) noexcept
+    {
+        static_assert(Table<N>::kOne == fixed::Q16::kOne, "Table and Q16 share the 16-bit fraction.");
+        const std::size_t m = (n < N) ? n : N;
+        for (std::size_t i = 0; i < m; ++i)
+            dst[i] = fixed::Q16::fromRaw(static_cast<int32_t>(src[i]) * t.scale[i] + t.offset[i]);
+    }
+
+    // ---- Role mapping for transports without RcLink (SBUS / CRSF) ---- //
+
+    /**
+     * @brief How one role is mapped from µs to output units (mirrors an RcLink axis / switch).
+     */
+    struct RoleSpec
+    {
+        enum class Kind : uint8_t
+        {
+            Axis = 0, ///< Linear around a centre with a deadband.
+            Switch    ///< Nearest raw level → discrete value.
+        };
+
+        Kind kind{Kind::Axis};               ///< Mapping type.
+        int16_t raw_min{1000};               ///< Axis: raw at out_min (µs).
+        int16_t raw_max{2000};               ///< Axis: raw at out_max (µs).
+        int16_t raw_center{1500};            ///< Axis: raw at rest (µs).
+        int16_t deadband{0};                 ///< Axis: ± µs around raw_center that read as rest.
+        float out_min{-100.0f};              ///< Axis: output at raw_min.
+        float out_max{100.0f};               ///< Axis: output at raw_max.
+        uint8_t levels{0};                   ///< Switch: used entries in raw_levels / values.
+        std::array<int16_t, 3> raw_levels{}; ///< Switch: raw positions (µs).
+        std::array<float, 3> values{};       ///< Switch: output per position.
+        float failsafe{0.0f};                ///< Output while the link is in failsafe.
+
+        /// @brief Axis spec (same arguments as RcLink's raw() / deadband_us() / out()).
+        static constexpr RoleSpec axis(int16_t lo, int16_t hi, int16_t center, int16_t db, float out_lo, float out_hi,
+                                       float fs) noexcept
+        {
+            RoleSpec r{};
+            r.kind = Kind::Axis;
+            r.raw_min = lo;
+            r.raw_max = hi;
+            r.raw_center = center;
+            r.deadband = db;
+            r.out_min = out_lo;
+            r.out_max = out_hi;
+            r.failsafe = fs;
+            return r;
+        }
+
+        /// @brief Switch spec (same arguments as RcLink's raw_levels() / values()).
+        static constexpr RoleSpec sw(std::array<int16_t, 3> raw, std::array<float, 3> vals, uint8_t n, float fs) noexcept
+        {
+            RoleSpec r{};
+            r.kind = Kind::Switch;
+            r.levels = n;
+            r.raw_levels = raw;
+            r.values = vals;
+            r.failsafe = fs;
+            return r;
+        }
+
+        /// @brief Output at rest (raw_center) for an axis.
+        constexpr float rest() const noexcept
+        {
+            if (raw_center <= raw_min)
+                return out_min;
+            if (raw_center >= raw_max)
+                return out_max;
+            return 0.5f * (out_min + out_max);
+        }
+    };
+
+    /**
+     * @brief Maps a whole µs frame to int16 role values with a table built once at start-up.
+     *
+     * Output matches RcLink's frame().vals (integer output units), so the
+     * change gate and rc_batch::map() downstream are protocol-agnostic.
+     *
+     * @tparam N Role count.
+     */
+    template <std::size_t N>
+    class Mapper
+    {
+    public:
+        /**
+         * @brief Precompute Q16.16 gains from @p spec.
+         *
+         * @param spec One entry per role, in role order (role i ← channel i).
+         */
+        void build(const std::array<RoleSpec, N> &spec) noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const RoleSpec &r = spec[i];
+                Entry &e = e_[i];
+                e.spec = &r;
+                e.fs = round16(r.failsafe);
+                if (r.kind != RoleSpec::Kind::Axis)
+                    continue;
+
+                const float rest = r.rest();
+                const int32_t up = r.raw_max - r.raw_center - r.deadband;
+                const int32_t dn = r.raw_center - r.deadband - r.raw_min;
+                e.rest_q16 = static_cast<int32_t>(rest * 65536.0f);
+                e.gain_hi_q16 = (up > 0) ? static_cast<int32_t>(((r.out_max - rest) / up) * 65536.0f) : 0;
+                e.gain_lo_q16 = (dn > 0) ? static_cast<int32_t>(((rest - r.out_min) / dn) * 65536.0f) : 0;
+            }
+        }
+
+        /**
+         * @brief Map channels @p us (role i ← channel i) into @p out.
+         *
+         * @param us Channel values (µs).
+         * @param n Channels available (roles beyond n read as failsafe).
+         * @param failsafe Link lost: every role takes its failsafe value.
+         * @param out N role values.
+         */
+        void map(const uint16_t *us, std::size_t n, bool failsafe, int16_t *out) const noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const Entry &e = e_[i];
+                if (failsafe || i >= n || e.spec == nullptr)
+                {
+                    out[i] = e.fs;
+                    continue;
+                }
+
+                const RoleSpec &r = *e.spec;
+                int32_t v = us[i];
+                if (r.kind == RoleSpec::Kind::Switch)
+                {
+                    out[i] = nearest(r, v);
+                    continue;
+                }
+
+                v = (v < r.raw_min) ? r.raw_min : (v > r.raw_max) ? r.raw_max : v;
+                const int32_t d = v - r.raw_center;
+                int32_t q = e.rest_q16;
+                if (d > r.deadband)
+                    q += (d - r.deadband) * e.gain_hi_q16;
+                else if (d < -r.deadband)
+                    q += (d + r.deadband) * e.gain_lo_q16;
+                out[i] = static_cast<int16_t>((q + ((q >= 0) ? 0x8000 : -0x8000)) / 65536); ///< Round to nearest.
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            const RoleSpec *spec{nullptr}; ///< Source spec (static storage).
+            int32_t rest_q16{0};           ///< Output at rest (Q16.16).
+            int32_t gain_hi_q16{0};        ///< Output per µs above the deadband (Q16.16).
+            int32_t gain_lo_q16{0};        ///< Output per µs below the deadband (Q16.16).
+            int16_t fs{0};                 ///< Failsafe output.
+        };
+
+        static int16_t round16(float x) noexcept { return static_cast<int16_t>((x >= 0.0f) ? x + 0.5f : x - 0.5f); }
+
+        /// @brief Switch: value of the raw level closest to @p v.
+        static int16_t nearest(const RoleSpec &r, int32_t v) noexcept
+        {
+            std::size_t best = 0;
+            int32_t best_d = INT32_MAX;
+            for (std::size_t k = 0; k < r.levels; ++k)
+            {
+                int32_t d = v - r.raw_levels[k];
+                d = (d < 0) ? -d : d;
+                if (d < best_d)
+                {
+                    best_d = d;
+                    best = k;
+                }
+            }
+            return round16(r.values[best]);
+        }
+
+        std::array<Entry, N> e_{}; ///< Per-role tables.
+    };
+} ///< Namespace rc_batch.
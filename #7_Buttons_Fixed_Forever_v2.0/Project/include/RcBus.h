@@ -15,16 +15,18 @@
 #include <cstdint>
 #include <array>
 #include <app_config.h>
+#include <Real.h>
 #include <SnapshotBus.h>
+#include <ViewBus.h>
 
 /**
  * @brief Application-owned RC snapshot payload transported on SnapshotBus.
  */
 struct RcSnapshot
 {
-    std::array<float, static_cast<size_t>(RC::Count)> out{}; ///< Per-role mapped outputs (engineering units).
-    bool failsafe{false};                                    ///< True if the link is in failsafe state.
-    uint64_t stamp_us{0};                                    ///< Snapshot timestamp (µs since boot).
+    std::array<real_t, static_cast<size_t>(RC::Count)> out{}; ///< Per-role mapped outputs (engineering units).
+    bool failsafe{false};                                     ///< True if the link is in failsafe state.
+    uint64_t stamp_us{0};                                     ///< Origin stamp: now_us() when the frame was decoded.
 };
 
 /**
@@ -32,17 +34,19 @@ struct RcSnapshot
  *
  * @param f Snapshot frame to read from.
  * @param role Logical RC role (enum value).
- * @return float Engineering-unit value for role (raw input units).
+ * @return real_t Engineering-unit value for role (raw input units).
  */
-[[nodiscard]] inline float rc_get(const RcSnapshot &f, RC role) noexcept
+[[nodiscard]] inline real_t rc_get(const RcSnapshot &f, RC role) noexcept
 {
     return f.out[static_cast<size_t>(role)];
 }
 
 /**
- * @brief Type alias for the snapshotbus that transports RC input frames.
+ * @brief Type alias for the bus that transports RC input frames.
+ * @note Zero-copy: RcPublisher decodes straight into begin_write() and readers
+ *       pin frames with read_view() / Subscription::view() instead of copying.
  */
-using RcBus = snapshot::SnapshotBus<RcSnapshot>;
+using RcBus = snapshot::ViewBus<RcSnapshot>;
 
 /**
  * @brief Single, shared RcBus instance (created on first use).
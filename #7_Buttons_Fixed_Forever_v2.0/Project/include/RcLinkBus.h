@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ *
+ * @brief Snapshot payload and bus for receiver link-quality statistics (frame rate, gaps, failsafe entries).
+ *
+ * @file RcLinkBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+
+/**
+ * @brief Receiver link statistics, published by RcPublisher every cfg::rc::STATS_MS.
+ *
+ * The inter-frame gap histogram is cumulative since boot: the bin holding the
+ * tail of the distribution is the floor for cfg::rc::LINK_TIMEOUT_MS (and the
+ * failsafe signature hold) that won't trip on a healthy link.
+ */
+struct RcLinkSnapshot
+{
+    static constexpr std::size_t kGapBins = 9; ///< Gap histogram bins (last bin = overflow).
+
+    /// @brief Upper edge of each gap bin except the overflow bin (µs).
+    static constexpr std::array<uint32_t, kGapBins - 1> kGapEdgesUs{2500, 5000, 7500, 10000, 15000, 20000, 50000, 100000};
+
+    uint32_t frames{0};                        ///< Good frames since boot.
+    uint32_t crc_errors{0};                    ///< Frames rejected on an integrity check since boot.
+    bool has_crc{false};                       ///< True if crc_errors is measured by this protocol.
+    float rate_hz{0.0f};                       ///< Good frames per second over the last stats period.
+    std::array<uint32_t, kGapBins> gap_hist{}; ///< Inter-frame gap histogram since boot.
+    uint32_t gap_max_us{0};                    ///< Longest inter-frame gap since boot (µs).
+    uint32_t since_good_ms{0};                 ///< Time since the last good frame (ms).
+    bool failsafe{true};                       ///< Link in failsafe at the sample.
+    uint32_t failsafe_entries{0};              ///< OK → failsafe transitions since boot.
+    uint64_t stamp_us{0};                      ///< Sample timestamp (µs since boot).
+};
+
+/**
+ * @brief Accumulates RcLinkSnapshot fields from the RC task's loop.
+ *
+ * Call frames() with the cumulative good-frame count each iteration and
+ * link() with the current failsafe state; sample() fills a snapshot and
+ * starts the next rate window. Single-writer, no locking.
+ */
+class LinkMeter
+{
+public:
+    /**
+     * @brief Record the cumulative good-frame count.
+     *
+     * @param total Good frames since boot (protocol counter).
+     * @param now_us Current time (µs).
+     */
+    void frames(uint32_t total, uint64_t now_us) noexcept
+    {
+        const uint32_t fresh = total - frames_;
+        if (fresh == 0)
+            return;
+
+        if (last_good_us_ != 0)
+        {
+            // Several frames in one wake (poll mode): split the gap evenly between them.
+            const uint32_t gap = static_cast<uint32_t>((now_us - last_good_us_) / fresh);
+            std::size_t bin = 0;
+            while (bin < s_.kGapEdgesUs.size() && gap >= s_.kGapEdgesUs[bin])
+                ++bin;
+            s_.gap_hist[bin] += fresh;
+            if (gap > s_.gap_max_us)
+                s_.gap_max_us = gap;
+        }
+
+        frames_ = total;
+        last_good_us_ = now_us;
+    }
+
+    /// @brief Record the current link state (counts failsafe entries).
+    void link(bool failsafe) noexcept
+    {
+        if (failsafe && !s_.failsafe)
+            ++s_.failsafe_entries;
+        s_.failsafe = failsafe;
+    }
+
+    /// @brief Record the protocol's cumulative integrity-check failures.
+    void crcErrors(uint32_t total, bool measured) noexcept
+    {
+        s_.crc_errors = total;
+        s_.has_crc = measured;
+    }
+
+    /**
+     * @brief Fill a snapshot and start the next rate window.
+     *
+     * @param now_us Current time (µs).
+     */
+    [[nodiscard]] RcLinkSnapshot sample(uint64_t now_us) noexcept
+    {
+        RcLinkSnapshot out = s_;
+        out.frames = frames_;
+        out.since_good_ms = (last_good_us_ != 0) ? static_cast<uint32_t>((now_us - last_good_us_) / 1000ULL) : UINT32_MAX;
+        if (window_us_ != 0 && now_us > window_us_)
+            out.rate_hz = static_cast<float>(frames_ - window_frames_) * 1e6f / static_cast<float>(now_us - window_us_);
+        out.stamp_us = now_us;
+
+        window_us_ = now_us;
+        window_frames_ = frames_;
+        return out;
+    }
+
+private:
+    RcLinkSnapshot s_{};        ///< Running totals.
+    uint32_t frames_{0};        ///< Last cumulative frame count seen.
+    uint64_t last_good_us_{0};  ///< Time the last good frame was noticed (µs).
+    uint64_t window_us_{0};     ///< Start of the current rate window (µs).
+    uint32_t window_frames_{0}; ///< frames_ at the window start.
+};
+
+/**
+ * @brief Type alias for the SnapshotBus that transports link statistics.
+ */
+using RcLinkBus = snapshot::SignalBus<RcLinkSnapshot>;
+
+/**
+ * @brief Single, shared RcLinkBus instance.
+ */
+namespace buses
+{
+    inline RcLinkBus &rcLink() noexcept ///< Return reference to the shared RcLinkBus.
+    {
+        static RcLinkBus bus{}; ///< One (only) RcLinkBus instance.
+        return bus;             ///< Return reference to shared bus.
+    }
+}
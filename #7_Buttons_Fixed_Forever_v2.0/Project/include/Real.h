@@ -0,0 +1,26 @@
+/**
+ * MIT License
+ *
+ * @brief Control-path number type (float, or Q16.16 on targets without an FPU).
+ *
+ * @file Real.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <app_config.h>
+#include <FixedPoint.h>
+
+/**
+ * @brief Number used for commands and mapped RC values (cfg::numeric::FIXED_POINT).
+ *
+ * Write control code against real_t with the num:: helpers and it compiles
+ * to float or to integer-only Q16.16 unchanged. Constants are spelled
+ * real_t{100.0f} (folded at compile time either way); num::to_float() is
+ * for the boundaries (motor backend, logging).
+ */
+using real_t = std::conditional_t<cfg::numeric::FIXED_POINT, fixed::Q16, float>;
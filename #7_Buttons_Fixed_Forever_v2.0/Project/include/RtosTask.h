@@ -0,0 +1,41 @@
+/**
+ * MIT License
+ *
+ * @brief CRTP base that gives a module its FreeRTOS task entry trampoline.
+ *
+ * @file RtosTask.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+namespace rtos
+{
+    /**
+     * @brief Supplies `static void task(void *self)` for a module with a `void run()` loop.
+     *
+     * Derive as `class StateManager : public rtos::Task<StateManager>` and keep
+     * run() private with `friend class rtos::Task<StateManager>;`. The entry is
+     * then `StateManager::task` with `pvParameters = &instance`, as before.
+     *
+     * @tparam Derived Module type.
+     */
+    template <typename Derived>
+    class Task
+    {
+    public:
+        /**
+         * @brief FreeRTOS task trampoline. Call with `pvParameters = this`.
+         */
+        static inline void task(void *self) noexcept
+        {
+            static_cast<Derived *>(self)->run();
+        }
+
+    protected:
+        Task() = default;
+        ~Task() = default;
+    };
+} ///< Namespace rtos.
@@ -0,0 +1,514 @@
+/**
+ * MIT License
+ *
+ * @brief SnapshotBus extension that wakes subscribed readers on publish and keeps its own publish clock.
+ *
+ * @file SignalBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <freertos/FreeRTOS.h>
+#include <freertos/portmacro.h>
+#include <freertos/task.h>
+#include <SnapshotBus.h>
+#include <AtomicSnapshot.h>
+#include <HotPath.h>
+
+namespace snapshot
+{
+    template <typename Bus>
+    class Subscription;
+
+    /**
+     * @brief Fixed table of tasks to notify when a bus publishes.
+     *
+     * Shared by SignalBus and ViewBus. Slots are claimed with a CAS, so
+     * subscribe/unsubscribe is safe from any task while the writer notifies.
+     *
+     * @tparam N Number of slots.
+     */
+    template <std::size_t N>
+    class SubscriberSet
+    {
+    public:
+        /// @brief Claim a free subscriber slot for @p t (-1 if full).
+        int attach(TaskHandle_t t) noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                TaskHandle_t expected = nullptr;
+                if (subs_[i].compare_exchange_strong(expected, t, std::memory_order_acq_rel))
+                    return static_cast<int>(i);
+            }
+            configASSERT(false); ///< Raise MaxSubscribers if this trips.
+            return -1;
+        }
+
+        /// @brief Release a subscriber slot.
+        void detach(int slot) noexcept
+        {
+            if (slot >= 0)
+                subs_[static_cast<std::size_t>(slot)].store(nullptr, std::memory_order_release);
+        }
+
+        /// @brief Give a notification to every subscriber (task or ISR context).
+        void HOT_IRAM notify() noexcept
+        {
+            const bool in_isr = xPortInIsrContext();
+            BaseType_t woken = pdFALSE;
+
+            for (auto &s : subs_)
+            {
+                const TaskHandle_t t = s.load(std::memory_order_acquire);
+                if (t == nullptr)
+                    continue;
+                if (in_isr)
+                    vTaskNotifyGiveFromISR(t, &woken);
+                else
+                    xTaskNotifyGive(t);
+            }
+
+            if (in_isr)
+                portYIELD_FROM_ISR(woken);
+        }
+
+    private:
+        std::array<std::atomic<TaskHandle_t>, N> subs_{}; ///< Subscribed tasks (nullptr = free).
+    };
+
+    /// @brief Frame age before the first publish (never fresh).
+    inline constexpr uint32_t kNeverPublished = UINT32_MAX;
+
+    /// @brief A stamp up to this far past the caller's now is a publish that raced the read (age 0), not a wrap.
+    inline constexpr uint32_t kAheadUs = 1000000;
+
+    /**
+     * @brief Publish time of a bus's latest frame, stamped by the bus itself.
+     *
+     * Shared by SignalBus and ViewBus. The stamp is the low 32 bits of
+     * now_us() (ages up to ~71 minutes; differences stay correct across the
+     * wrap) and is stored after the frame, so a reader racing a publish sees
+     * the new frame with the old stamp at worst: an age that errs old, never
+     * young. A publish that lands after the reader sampled now has a stamp in
+     * the reader's future; age_us() reads that as 0 (just published), not as
+     * a ~71 minute old frame (anything up to kAheadUs ahead).
+     */
+    class PublishClock
+    {
+    public:
+        /// @brief Latest publish (low 32 bits of now_us(); meaningless before the first one).
+        [[nodiscard]] uint32_t published_us() const noexcept { return at_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Age of the latest frame.
+         *
+         * @param now Current time (µs).
+         * @return uint32_t Since the latest publish (µs; 0 if it landed after @p now, kNeverPublished before the first).
+         */
+        [[nodiscard]] uint32_t HOT_IRAM age_us(uint64_t now) const noexcept
+        {
+            if (!any_.load(std::memory_order_acquire))
+                return kNeverPublished;
+            const uint32_t age = static_cast<uint32_t>(now) - at_.load(std::memory_order_acquire);
+            if (age > kNeverPublished - kAheadUs)
+                return 0; ///< Stamped after the caller sampled now: the newest frame there is.
+            return age;
+        }
+
+    protected:
+        /// @brief Stamp a publish that just landed (writer, task or ISR context).
+        void HOT_IRAM stamp() noexcept
+        {
+            at_.store(static_cast<uint32_t>(now_us()), std::memory_order_release);
+            any_.store(true, std::memory_order_release); ///< After the stamp: age_us() never pairs "published" with 0.
+        }
+
+    private:
+        std::atomic<uint32_t> at_{0};  ///< Latest publish (µs, low 32 bits).
+        std::atomic<bool> any_{false}; ///< Published at least once.
+    };
+
+    /**
+     * @brief A consumer's freshness budget for one bus, plus the age of everything it read.
+     *
+     * The consumer declares how old a frame may be before acting on it is
+     * wrong (max_age_us) and passes every read through check(); the ages land
+     * in a log2 histogram and the ones over budget are counted, so late data
+     * shows up as a metric. One writer (the owning task); getters from any
+     * task.
+     */
+    class Freshness
+    {
+    public:
+        static constexpr std::size_t kBuckets = 24; ///< Bucket b holds [2^(b-1), 2^b) µs; b = 0 → < 1 µs.
+
+        /// @brief Figures since the last reset().
+        struct Stats
+        {
+            uint32_t reads{0};     ///< Frames checked.
+            uint32_t stale{0};     ///< Over budget (or never published).
+            uint32_t max_us{0};    ///< Oldest frame checked (µs; never-published reads excluded).
+            uint32_t p99_us{0};    ///< 99th percentile bucket bound (µs).
+            uint32_t budget_us{0}; ///< max_age_us (0 → no budget, ages recorded only).
+        };
+
+        /**
+         * @brief Construct (no RTOS call).
+         *
+         * @param name Consumer / bus label (console).
+         * @param max_age_us Budget (µs; 0 → no budget: every frame is fresh, ages still recorded).
+         */
+        constexpr Freshness(const char *name, uint32_t max_age_us) noexcept : name_(name), budget_us_(max_age_us) {}
+
+        /**
+         * @brief Record the age of a frame about to be used.
+         *
+         * @param age_us Bus age_us() at the read.
+         * @return true If within budget.
+         */
+        bool HOT_IRAM check(uint32_t age_us) noexcept
+        {
+            reads_.store(reads_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); ///< Single writer.
+            const bool fresh = age_us != kNeverPublished && (budget_us_ == 0 || age_us <= budget_us_);
+            if (!fresh)
+                stale_.store(stale_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (age_us == kNeverPublished)
+                return false;
+
+            auto &b = bucket_[bucket(age_us)];
+            b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (age_us > max_us_.load(std::memory_order_relaxed))
+                max_us_.store(age_us, std::memory_order_relaxed);
+            return fresh;
+        }
+
+        /// @brief Figures since the last reset() (any task).
+        [[nodiscard]] Stats stats() const noexcept
+        {
+            Stats s{};
+            s.reads = reads_.load(std::memory_order_relaxed);
+            s.stale = stale_.load(std::memory_order_relaxed);
+            s.max_us = max_us_.load(std::memory_order_relaxed);
+            s.budget_us = budget_us_;
+
+            uint32_t total = 0;
+            for (const auto &b : bucket_)
+                total += b.load(std::memory_order_relaxed);
+            const uint32_t want = total - total / 100; ///< Samples at or below p99.
+            uint32_t run = 0;
+            for (std::size_t i = 0; i < kBuckets && total != 0; ++i)
+            {
+                run += bucket_[i].load(std::memory_order_relaxed);
+                if (run >= want)
+                {
+                    s.p99_us = (i == 0) ? 1U : (1U << i);
+                    break;
+                }
+            }
+            return s;
+        }
+
+        /// @brief Clear the figures (owning task, or while it is idle: a racing check() may survive).
+        void reset() noexcept
+        {
+            reads_.store(0, std::memory_order_relaxed);
+            stale_.store(0, std::memory_order_relaxed);
+            max_us_.store(0, std::memory_order_relaxed);
+            for (auto &b : bucket_)
+                b.store(0, std::memory_order_relaxed);
+        }
+
+        /// @brief Consumer / bus label.
+        [[nodiscard]] const char *name() const noexcept { return name_; }
+
+        /// @brief Budget (µs; 0 → none).
+        [[nodiscard]] uint32_t budget() const noexcept { return budget_us_; }
+
+    private:
+        /// @brief Histogram bucket for @p us (log2, clamped to the last bucket).
+        static constexpr std::size_t bucket(uint32_t us) noexcept
+        {
+            std::size_t b = 0;
+            while (us != 0 && b < kBuckets - 1)
+            {
+                us >>= 1;
+                ++b;
+            }
+            return b;
+        }
+
+        const char *name_;                                     ///< Label.
+        uint32_t budget_us_;                                   ///< Freshness budget (µs; 0 → none).
+        std::atomic<uint32_t> reads_{0};                       ///< Frames checked.
+        std::atomic<uint32_t> stale_{0};                       ///< Over budget.
+        std::atomic<uint32_t> max_us_{0};                      ///< Oldest frame checked.
+        std::array<std::atomic<uint32_t>, kBuckets> bucket_{}; ///< Age histogram.
+    };
+
+    /**
+     * @brief SnapshotBus that notifies subscribed reader tasks on every publish.
+     *
+     * Each consumer task calls subscribe() once and keeps the returned handle.
+     * The handle tracks its own last-seen sequence, so "has anything changed?"
+     * is a sequence compare instead of a frame copy, and the task can sleep in
+     * Subscription::wait() (or wait_any() across several buses) until the
+     * writer publishes again.
+     *
+     * Storage is chosen at compile time: payloads with an atomic_codec
+     * specialisation live in one atomic word (AtomicSnapshot, wait-free);
+     * everything else uses the SnapshotBus seqlock.
+     *
+     * The bus stamps every publish itself (PublishClock), so a consumer can
+     * ask how old the latest frame is (age_us()) or read it only if it is
+     * young enough (peek_if_fresh()), whatever the payload's own stamp_us
+     * says (a replayed or bridged frame carries its origin's clock).
+     *
+     * @note Wakeups use the subscriber task's direct-to-task notification value.
+     *       A task may hold subscriptions on several buses; any of them wakes it.
+     * @note The codec must be visible wherever SignalBus<T> is first instantiated
+     *       (declare it next to the payload).
+     * @tparam T Payload type.
+     * @tparam MaxSubscribers Maximum concurrent subscribers (including wait_newer() callers).
+     */
+    template <typename T, std::size_t MaxSubscribers = 6>
+    class SignalBus : public snapshot_store_t<T>, public PublishClock
+    {
+        using Base = snapshot_store_t<T>;
+
+    public:
+        using value_type = T;                                            ///< Payload type.
+        using seq_t = decltype(std::declval<const Base &>().sequence()); ///< Underlying sequence type.
+
+        /**
+         * @brief Publish a frame and wake every subscriber.
+         *
+         * @param v Frame to publish.
+         */
+        void HOT_IRAM publish(const T &v) noexcept
+        {
+            Base::publish(v);
+            stamp();
+            notify_subscribers();
+        }
+
+        /**
+         * @brief Copy the latest frame only if it is at most @p max_age_us old.
+         *
+         * @param out Destination frame (untouched when stale).
+         * @param max_age_us Budget (µs).
+         * @param now Current time (µs).
+         * @return true If @p out was updated.
+         */
+        bool HOT_IRAM peek_if_fresh(T &out, uint32_t max_age_us, uint64_t now) const noexcept
+        {
+            if (age_us(now) > max_age_us)
+                return false; ///< Also covers "never published".
+            out = this->peek();
+            return true;
+        }
+
+        /**
+         * @brief Copy the latest frame, recording its age against @p budget.
+         *
+         * @param out Destination frame (always updated: the caller decides what a stale frame means).
+         * @param budget Consumer's freshness budget / age histogram.
+         * @param now Current time (µs).
+         * @return true If the frame was within budget.
+         */
+        bool HOT_IRAM peek_checked(T &out, Freshness &budget, uint64_t now) const noexcept
+        {
+            const bool fresh = budget.check(age_us(now)); ///< Age first: a racing publish only makes the copy younger.
+            out = this->peek();
+            return fresh;
+        }
+
+        /**
+         * @brief Subscribe the calling task to publish notifications.
+         *
+         * @return Subscription Handle (invalid if all slots are taken).
+         */
+        [[nodiscard]] Subscription<SignalBus> subscribe() noexcept
+        {
+            return Subscription<SignalBus>{*this, subs_.attach(xTaskGetCurrentTaskHandle())};
+        }
+
+        /**
+         * @brief Block until the bus sequence differs from @p seen, or @p timeout expires.
+         *
+         * One-shot convenience for callers that do not keep a Subscription.
+         *
+         * @param seen Sequence the caller has already consumed.
+         * @param timeout Maximum time to block (ticks, portMAX_DELAY → forever).
+         * @return true A newer frame is available.
+         * @return false Timed out with nothing new.
+         */
+        bool wait_newer(seq_t seen, TickType_t timeout) noexcept
+        {
+            if (this->sequence() != seen)
+                return true; ///< Fast path: already behind.
+
+            Subscription<SignalBus> sub = subscribe(); ///< Register before re-checking (no lost wakeup).
+            sub.mark_seen(seen);
+            return sub.wait(timeout);
+        }
+
+    private:
+        friend class Subscription<SignalBus>;
+
+        /// @brief Release a subscriber slot.
+        void detach(int slot) noexcept { subs_.detach(slot); }
+
+        /// @brief Give a notification to every subscriber (task or ISR context).
+        void notify_subscribers() noexcept { subs_.notify(); }
+
+        SubscriberSet<MaxSubscribers> subs_{}; ///< Subscribed tasks.
+    };
+
+    /**
+     * @brief Per-consumer handle on a SignalBus / ViewBus (move-only, unsubscribes on destruction).
+     *
+     * @tparam Bus SignalBus or ViewBus type.
+     */
+    template <typename Bus>
+    class Subscription
+    {
+    public:
+        using T = typename Bus::value_type;
+        using seq_t = typename Bus::seq_t;
+
+        Subscription() noexcept = default;
+
+        Subscription(Subscription &&o) noexcept : bus_(o.bus_), slot_(o.slot_), seen_(o.seen_)
+        {
+            o.bus_ = nullptr;
+            o.slot_ = -1;
+        }
+
+        Subscription &operator=(Subscription &&o) noexcept
+        {
+            if (this != &o)
+            {
+                release();
+                bus_ = o.bus_;
+                slot_ = o.slot_;
+                seen_ = o.seen_;
+                o.bus_ = nullptr;
+                o.slot_ = -1;
+            }
+            return *this;
+        }
+
+        Subscription(const Subscription &) = delete;
+        Subscription &operator=(const Subscription &) = delete;
+
+        ~Subscription() { release(); }
+
+        /// @brief True if bound to a bus slot.
+        [[nodiscard]] bool valid() const noexcept { return bus_ != nullptr && slot_ >= 0; }
+
+        /// @brief True if the bus has published since this subscriber last consumed.
+        [[nodiscard]] bool HOT_IRAM fresh() const noexcept { return bus_ != nullptr && bus_->sequence() != seen_; }
+
+        /**
+         * @brief Copy the latest frame if it is new to this subscriber.
+         *
+         * @param out Destination frame (untouched when nothing new).
+         * @return true If @p out was updated.
+         */
+        bool HOT_IRAM take(T &out) noexcept
+        {
+            if (!fresh())
+                return false;
+            seen_ = bus_->sequence(); ///< Read sequence first: a racing publish shows up as fresh next time.
+            out = bus_->peek();
+            return true;
+        }
+
+        /**
+         * @brief Block until fresh() or @p timeout expires.
+         *
+         * @param timeout Maximum time to block (ticks, portMAX_DELAY → forever).
+         * @return true If a new frame is available.
+         */
+        bool wait(TickType_t timeout) noexcept;
+
+        /**
+         * @brief Pin the latest frame without copying and mark it consumed (ViewBus only).
+         *
+         * @return auto Bus::ReadView guarding the frame.
+         */
+        [[nodiscard]] auto view() noexcept
+        {
+            auto v = bus_->read_view();
+            seen_ = v.sequence();
+            return v;
+        }
+
+        /// @brief Treat @p s as already consumed.
+        void mark_seen(seq_t s) noexcept { seen_ = s; }
+
+        /// @brief Last sequence consumed by this subscriber.
+        [[nodiscard]] seq_t seen() const noexcept { return seen_; }
+
+    private:
+        friend Bus;
+
+        Subscription(Bus &bus, int slot) noexcept : bus_(slot >= 0 ? &bus : nullptr), slot_(slot), seen_(bus.sequence()) {}
+
+        void release() noexcept
+        {
+            if (bus_ != nullptr)
+                bus_->detach(slot_);
+            bus_ = nullptr;
+            slot_ = -1;
+        }
+
+        Bus *bus_{nullptr}; ///< Non-owning bus.
+        int slot_{-1};      ///< Subscriber slot on bus_.
+        seq_t seen_{};      ///< Last sequence consumed.
+    };
+
+    /**
+     * @brief Block the calling task until any of @p subs is fresh, or @p timeout expires.
+     *
+     * All subscriptions must belong to the calling task (they share its notification value).
+     *
+     * @param timeout Maximum time to block (ticks, portMAX_DELAY → forever).
+     * @param subs Subscriptions to watch.
+     * @return true If at least one subscription has a new frame.
+     */
+    template <typename... Subs>
+    bool wait_any(TickType_t timeout, const Subs &...subs) noexcept
+    {
+        const TickType_t t0 = xTaskGetTickCount();
+
+        for (;;)
+        {
+            if ((subs.fresh() || ...))
+                return true;
+
+            const TickType_t elapsed = xTaskGetTickCount() - t0;
+            if (timeout != portMAX_DELAY && elapsed >= timeout)
+                return false; ///< Timed out.
+
+            ulTaskNotifyTake(pdTRUE, (timeout == portMAX_DELAY) ? portMAX_DELAY : (timeout - elapsed)); ///< Re-check on any wake.
+        }
+    }
+
+    // Block until fresh() or timeout expires.
+    template <typename Bus>
+    bool Subscription<Bus>::wait(TickType_t timeout) noexcept
+    {
+        return wait_any(timeout, *this);
+    }
+} ///< Namespace snapshot.
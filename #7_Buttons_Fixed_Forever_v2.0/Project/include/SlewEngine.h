@@ -0,0 +1,224 @@
+/**
+ * MIT License
+ *
+ * @brief Tick-driven duty slew profiles (linear, S-curve, coast-before-jump) with no blocking waits.
+ *
+ * @file SlewEngine.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "FixedPoint.h"
+
+/**
+ * @brief Moves a duty value toward a target, one control tick at a time.
+ *
+ * The caller owns the timing: it calls setTarget() whenever the command
+ * changes and step(dt) once per tick, then applies the Output (drive at
+ * pct, or coast). Nothing here sleeps, so fault / over-voltage checks in
+ * the same loop run at the full tick rate.
+ *
+ * Profiles:
+ *  - Linear: constant rate (rate_pct_s).
+ *  - SCurve: the slew velocity ramps at accel_pct_s2 up to rate_pct_s and
+ *    back down before the target, so duty eases in and out.
+ *
+ * Coast-before-jump (jump_pct > 0): a target change of at least jump_pct
+ * first coasts for coast_before_s, slews, then coasts for coast_after_s
+ * before holding the target (lets current decay around large steps).
+ *
+ * All math goes through num::, so T = fixed::Q16 runs the same profile with
+ * integer arithmetic only (cores without an FPU).
+ *
+ * @tparam T Number type for duty, rates and seconds (float or fixed::Fixed).
+ */
+template <typename T = float>
+class BasicSlewEngine
+{
+public:
+    /// @brief Slew shape.
+    enum class Profile : uint8_t
+    {
+        Linear = 0, ///< Constant rate.
+        SCurve      ///< Acceleration-limited rate (eases in and out).
+    };
+
+    /// @brief Where the engine is in a move.
+    enum class Phase : uint8_t
+    {
+        Idle = 0,    ///< Holding the target.
+        CoastBefore, ///< Coasting ahead of a jump.
+        Slewing,     ///< Moving toward the target.
+        CoastAfter   ///< Coasting after a jump, before the hold.
+    };
+
+    /// @brief Profile settings.
+    struct Config
+    {
+        Profile profile{Profile::Linear}; ///< Slew shape.
+        T rate_pct_s{40.0f};              ///< Peak slew rate (%/s).
+        T accel_pct_s2{200.0f};           ///< SCurve rate change (%/s²).
+        T jump_pct{0.0f};                 ///< Coast around target changes ≥ this (0 → never).
+        T coast_before_s{0.0f};           ///< Coast ahead of a jump (s).
+        T coast_after_s{0.0f};            ///< Coast after a jump (s).
+    };
+
+    /// @brief What to apply this tick.
+    struct Output
+    {
+        T pct;      ///< Duty to drive (valid when !coast).
+        bool coast; ///< Outputs off this tick.
+    };
+
+    /// @brief Construct with the default (linear, 40 %/s) profile at 0.
+    BasicSlewEngine() noexcept = default;
+
+    /**
+     * @brief Construct with a profile.
+     *
+     * @param c Profile settings.
+     * @param start_pct Initial value and target.
+     */
+    explicit BasicSlewEngine(const Config &c, T start_pct = T{}) noexcept
+        : c_(c), value_(start_pct), target_(start_pct), brake_k_(brakeGain(c)) {}
+
+    /**
+     * @brief Set the target (unchanged target → no effect; safe to call every tick).
+     *
+     * @param pct Target duty.
+     */
+    void setTarget(T pct) noexcept
+    {
+        if (pct == target_)
+            return;
+        if (pct == value_ || target_ == value_ || ((pct < value_) != (target_ < value_)))
+            velocity_ = T{}; ///< Reversal (or fresh move): SCurve restarts from rest.
+        target_ = pct;
+        if (c_.jump_pct > T{} && num::abs(pct - value_) >= c_.jump_pct)
+        {
+            jump_ = true;
+            enter(c_.coast_before_s > T{} ? Phase::CoastBefore : Phase::Slewing);
+        }
+        else if (phase_ == Phase::Idle || phase_ == Phase::CoastAfter)
+        {
+            jump_ = false;
+            enter(Phase::Slewing);
+        }
+    }
+
+    /**
+     * @brief Advance one tick.
+     *
+     * @param dt_s Time since the previous step (s).
+     * @return Output Duty to apply, or coast.
+     */
+    Output step(T dt_s) noexcept
+    {
+        timer_s_ += dt_s;
+        switch (phase_)
+        {
+        case Phase::CoastBefore:
+            if (timer_s_ >= c_.coast_before_s)
+                enter(Phase::Slewing);
+            return {value_, true};
+
+        case Phase::Slewing:
+            advance(dt_s);
+            if (value_ == target_)
+            {
+                velocity_ = T{};
+                enter((jump_ && c_.coast_after_s > T{}) ? Phase::CoastAfter : Phase::Idle);
+                if (phase_ == Phase::Idle)
+                    jump_ = false;
+            }
+            return {value_, phase_ == Phase::CoastAfter};
+
+        case Phase::CoastAfter:
+            if (timer_s_ < c_.coast_after_s)
+                return {value_, true};
+            jump_ = false;
+            enter(Phase::Idle);
+            return {value_, false};
+
+        case Phase::Idle:
+        default:
+            return {value_, false};
+        }
+    }
+
+    /**
+     * @brief Jump straight to a value and hold it (e.g. after a fault forced a coast).
+     *
+     * @param pct New value and target.
+     */
+    void reset(T pct = T{}) noexcept
+    {
+        value_ = target_ = pct;
+        velocity_ = T{};
+        jump_ = false;
+        enter(Phase::Idle);
+    }
+
+    /// @brief Current duty.
+    [[nodiscard]] T value() const noexcept { return value_; }
+
+    /// @brief Current target.
+    [[nodiscard]] T target() const noexcept { return target_; }
+
+    /// @brief Current phase.
+    [[nodiscard]] Phase phase() const noexcept { return phase_; }
+
+    /// @brief True when holding the target.
+    [[nodiscard]] bool settled() const noexcept { return phase_ == Phase::Idle; }
+
+    /// @brief Profile settings.
+    [[nodiscard]] const Config &config() const noexcept { return c_; }
+
+private:
+    /// @brief Switch phase and restart its timer.
+    void enter(Phase p) noexcept
+    {
+        phase_ = p;
+        timer_s_ = T{};
+    }
+
+    /// @brief √(2·accel): the braking speed is brake_k_·√dist (one root per tick, no overflowing product).
+    static T brakeGain(const Config &c) noexcept
+    {
+        return (c.accel_pct_s2 > T{}) ? num::sqrt(T{2.0f} * c.accel_pct_s2) : T{};
+    }
+
+    /// @brief Move value_ toward target_ by one tick of the profile.
+    void advance(T dt_s) noexcept
+    {
+        const T remaining = target_ - value_;
+        const T dist = num::abs(remaining);
+        T speed = c_.rate_pct_s;
+        if (c_.profile == Profile::SCurve && c_.accel_pct_s2 > T{})
+        {
+            const T brake = brake_k_ * num::sqrt(dist); ///< Fastest speed that can still stop in dist.
+            speed = num::min(num::min(velocity_ + c_.accel_pct_s2 * dt_s, c_.rate_pct_s), brake);
+            speed = num::max(speed, c_.accel_pct_s2 * dt_s); ///< Always progress (no stall just short of the target).
+            velocity_ = speed;
+        }
+        const T move = speed * dt_s;
+        value_ = (move >= dist) ? target_ : value_ + num::copysign(move, remaining);
+    }
+
+    Config c_{};                     ///< Profile settings.
+    T value_{};                      ///< Current duty.
+    T target_{};                     ///< Target duty.
+    T velocity_{};                   ///< SCurve slew speed (%/s).
+    T timer_s_{};                    ///< Time in the current phase (s).
+    T brake_k_{brakeGain(Config{})}; ///< √(2·accel_pct_s2).
+    Phase phase_{Phase::Idle};       ///< Current phase.
+    bool jump_{false};               ///< The current move started as a jump.
+};
+
+/// @brief Float slew engine (the default everywhere an FPU is available).
+using SlewEngine = BasicSlewEngine<float>;
@@ -0,0 +1,199 @@
+/**
+ * MIT License
+ *
+ * @brief Per-stage execution cost (CPU time of one activation of a pipeline task).
+ *
+ * @file StageCost.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <HotPath.h>
+#if defined(SIM_HOST)
+#include <ctime>
+#endif
+
+namespace trace
+{
+    /// @brief Stages whose activations are timed. Each records the length of one wake → done pass.
+    enum class Work : std::uint8_t
+    {
+        Control = 0, ///< ControlCore: wake → ControlBus publish.
+        Drive,       ///< PowerDriveHandler: one step().
+        Count
+    };
+
+    /// @brief Stage names (index-aligned with Work).
+    inline constexpr const char *kWorkNames[static_cast<std::size_t>(Work::Count)] = {"control", "drive"};
+
+    /**
+     * @brief CPU clock for cost measurement (ns).
+     *
+     * On the target this is now_us(): the timed stages are high-priority tasks,
+     * so one activation is rarely preempted (ISRs it absorbs are counted). The
+     * host build has no meaningful wall clock (virtual time stands still while
+     * code runs), so it reads the calling thread's CPU time instead: every
+     * simulated task is one host thread.
+     */
+    inline uint64_t HOT_IRAM cpu_ns() noexcept
+    {
+#if defined(SIM_HOST)
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#else
+        return now_us() * 1000ULL;
+#endif
+    }
+
+    /**
+     * @brief Per-stage log2 histograms of activation cost.
+     *
+     * One writer per stage (the stage's own task), any number of readers:
+     * relaxed atomics only, no CAS. dump() prints from the console task.
+     */
+    class StageCost
+    {
+    public:
+        static constexpr std::size_t kBuckets = 32; ///< Bucket b holds [2^(b-1), 2^b) ns.
+
+        /**
+         * @brief Record one activation of @p w.
+         *
+         * @param w Stage.
+         * @param ns Activation cost (ns).
+         */
+        void HOT_IRAM record(Work w, uint64_t ns) noexcept
+        {
+            if constexpr (!cfg::trace::COST)
+                return;
+
+            Hist &h = hist_[static_cast<std::size_t>(w)];
+            const uint32_t v = (ns < UINT32_MAX) ? static_cast<uint32_t>(ns) : UINT32_MAX;
+            h.count.store(h.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            h.sum_ns.store(h.sum_ns.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+            h.bucket[bucket(v)].fetch_add(1, std::memory_order_relaxed);
+            if (v > h.max_ns.load(std::memory_order_relaxed))
+                h.max_ns.store(v, std::memory_order_relaxed);
+        }
+
+        /// @brief Clear every histogram (a writer racing the clear may keep one sample).
+        void reset() noexcept
+        {
+            for (auto &h : hist_)
+            {
+                h.count.store(0, std::memory_order_relaxed);
+                h.sum_ns.store(0, std::memory_order_relaxed);
+                h.max_ns.store(0, std::memory_order_relaxed);
+                for (auto &b : h.bucket)
+                    b.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Activations of @p w since the last reset().
+        [[nodiscard]] uint32_t count(Work w) const noexcept { return hist_[static_cast<std::size_t>(w)].count.load(std::memory_order_relaxed); }
+
+        /// @brief Mean cost of @p w (ns; 0 before the first sample).
+        [[nodiscard]] uint32_t mean_ns(Work w) const noexcept
+        {
+            const Hist &h = hist_[static_cast<std::size_t>(w)];
+            const uint32_t n = h.count.load(std::memory_order_relaxed);
+            return (n > 0) ? static_cast<uint32_t>(h.sum_ns.load(std::memory_order_relaxed) / n) : 0;
+        }
+
+        /// @brief Print one line per stage (µs).
+        void dump() const noexcept
+        {
+            debugln("stage      count     avg_us   p99<=_us     max_us");
+            for (std::size_t s = 0; s < hist_.size(); ++s)
+            {
+                const Hist &h = hist_[s];
+                const uint32_t n = h.count.load(std::memory_order_relaxed);
+                if (n == 0)
+                {
+                    debugfln("%-8s %7u          -          -          -", kWorkNames[s], 0u);
+                    continue;
+                }
+                debugfln("%-8s %7u %10.2f %10.2f %10.2f", kWorkNames[s], static_cast<unsigned>(n),
+                         static_cast<double>(h.sum_ns.load(std::memory_order_relaxed)) / n / 1000.0,
+                         static_cast<double>(p99(h, n)) / 1000.0,
+                         static_cast<double>(h.max_ns.load(std::memory_order_relaxed)) / 1000.0);
+            }
+        }
+
+    private:
+        struct Hist
+        {
+            std::atomic<uint32_t> count{0};                       ///< Activations.
+            std::atomic<uint64_t> sum_ns{0};                      ///< Sum (for the mean).
+            std::atomic<uint32_t> max_ns{0};                      ///< Longest activation.
+            std::array<std::atomic<uint32_t>, kBuckets> bucket{}; ///< log2 histogram.
+        };
+
+        /// @brief log2 bucket index for @p ns.
+        static std::size_t bucket(uint32_t ns) noexcept
+        {
+            const std::size_t b = (ns == 0) ? 0 : static_cast<std::size_t>(32 - __builtin_clz(ns));
+            return (b < kBuckets) ? b : (kBuckets - 1);
+        }
+
+        /// @brief Bucket upper bound holding the 99th percentile (ns).
+        static uint32_t p99(const Hist &h, uint32_t n) noexcept
+        {
+            const uint64_t target = (static_cast<uint64_t>(n) * 99 + 99) / 100;
+            uint64_t acc = 0;
+            for (std::size_t b = 0; b + 1 < kBuckets; ++b)
+            {
+                acc += h.bucket[b].load(std::memory_order_relaxed);
+                if (acc >= target)
+                    return 1U << b;
+            }
+            return h.max_ns.load(std::memory_order_relaxed);
+        }
+
+        std::array<Hist, static_cast<std::size_t>(Work::Count)> hist_{}; ///< Per-stage histograms.
+    };
+
+    /**
+     * @brief Single, shared cost table.
+     */
+    inline StageCost &cost() noexcept
+    {
+        static StageCost c{}; ///< One (only) cost table.
+        return c;
+    }
+
+    /**
+     * @brief Times its own lifetime into cost() (declare at the top of the activation).
+     */
+    class CostScope
+    {
+    public:
+        explicit HOT_IRAM CostScope(Work w) noexcept : w_(w)
+        {
+            if constexpr (cfg::trace::COST)
+                t0_ = cpu_ns();
+        }
+
+        HOT_IRAM ~CostScope()
+        {
+            if constexpr (cfg::trace::COST)
+                cost().record(w_, cpu_ns() - t0_);
+        }
+
+        CostScope(const CostScope &) = delete;
+        CostScope &operator=(const CostScope &) = delete;
+
+    private:
+        Work w_;          ///< Stage.
+        uint64_t t0_{0}; ///< Start (ns).
+    };
+} ///< Namespace trace.
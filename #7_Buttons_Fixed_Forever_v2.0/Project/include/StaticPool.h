@@ -0,0 +1,257 @@
+/**
+ * MIT License
+ *
+ * @brief Boot-time static memory: a compile-time task stack pool, named static regions and a memory map report.
+ *
+ * @file StaticPool.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <esp_heap_caps.h>
+#include <soc/soc_memory_layout.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace mem
+{
+    /// @brief Stack + TCB handed to xTaskCreateStatic*().
+    struct Stack
+    {
+        StackType_t *stack{nullptr}; ///< Stack buffer (depth entries).
+        StaticTask_t *tcb{nullptr};  ///< Task control block.
+    };
+
+    /**
+     * @brief Fixed pool of task stacks and TCBs, carved out once at boot.
+     *
+     * A bump allocator over one internal-RAM array: take() hands out the next
+     * @p depth entries and a TCB, nothing is ever returned. Tasks in this
+     * firmware are created once in setup() and never deleted, so the pool
+     * cannot fragment and every stack's address is fixed by the boot order.
+     * seal() closes the pool; a take() after it is a bug (asserted).
+     *
+     * @tparam Depth Pool size (StackType_t entries, the unit xTaskCreate*() takes).
+     * @tparam MaxTasks TCB capacity.
+     */
+    template <std::size_t Depth, std::size_t MaxTasks>
+    class StackPool
+    {
+    public:
+        /**
+         * @brief Reserve a stack and a TCB.
+         *
+         * @param depth Stack depth (same unit as xTaskCreatePinnedToCore()).
+         * @param out Receives the buffers.
+         * @return true If the pool had room (false → raise cfg::memory::STACK_POOL / MAX_TASKS).
+         */
+        bool take(uint32_t depth, Stack &out) noexcept
+        {
+            configASSERT(!sealed_); ///< No task creation after boot.
+            const std::size_t n = (depth + kAlign - 1) / kAlign * kAlign;
+            if (sealed_ || tasks_ >= MaxTasks || n > Depth - used_)
+            {
+                configASSERT(false); ///< Pool exhausted.
+                return false;
+            }
+            out.stack = &stack_[used_];
+            out.tcb = &tcb_[tasks_++];
+            used_ += n;
+            return true;
+        }
+
+        /// @brief Refuse further take() calls.
+        void seal() noexcept { sealed_ = true; }
+
+        /// @brief Entries handed out (including alignment padding).
+        [[nodiscard]] std::size_t used() const noexcept { return used_; }
+
+        /// @brief Pool size (entries).
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Depth; }
+
+        /// @brief TCBs handed out.
+        [[nodiscard]] std::size_t tasks() const noexcept { return tasks_; }
+
+        /// @brief Pool footprint (stacks + TCBs, bytes).
+        [[nodiscard]] static constexpr std::size_t bytes() noexcept
+        {
+            return Depth * sizeof(StackType_t) + MaxTasks * sizeof(StaticTask_t);
+        }
+
+    private:
+        static constexpr std::size_t kAlign = 16 / sizeof(StackType_t); ///< Keep every stack 16-byte aligned.
+
+        alignas(16) std::array<StackType_t, Depth> stack_{}; ///< Stack storage.
+        std::array<StaticTask_t, MaxTasks> tcb_{};           ///< TCB storage.
+        std::size_t used_{0};                                ///< Next free entry.
+        std::size_t tasks_{0};                               ///< Next free TCB.
+        bool sealed_{false};                                 ///< seal() called.
+    };
+
+    /// @brief Pool type (empty unless cfg::memory::STATIC_TASKS).
+    using Stacks = StackPool<cfg::memory::STATIC_TASKS ? cfg::memory::STACK_POOL : 0,
+                             cfg::memory::STATIC_TASKS ? cfg::memory::MAX_TASKS : 0>;
+
+    /// @brief The firmware's task stack pool (.bss, internal RAM).
+    inline Stacks &stacks() noexcept
+    {
+        static Stacks s{};
+        return s;
+    }
+
+    /**
+     * @brief Create a pinned task: from stacks() when cfg::memory::STATIC_TASKS, else from the heap.
+     *
+     * @param entry Task function.
+     * @param name Task name (static storage).
+     * @param depth Stack depth.
+     * @param arg Task parameter.
+     * @param priority Task priority.
+     * @param out Receives the handle.
+     * @param core Core to pin to.
+     * @return true If the task was created.
+     */
+    inline bool createTask(TaskFunction_t entry, const char *name, uint32_t depth, void *arg, UBaseType_t priority,
+                           TaskHandle_t *out, BaseType_t core) noexcept
+    {
+        if constexpr (cfg::memory::STATIC_TASKS)
+        {
+            Stack s{};
+            if (!stacks().take(depth, s))
+                return false;
+            *out = xTaskCreateStaticPinnedToCore(entry, name, depth, arg, priority, s.stack, s.tcb, core);
+            return *out != nullptr;
+        }
+        else
+            return xTaskCreatePinnedToCore(entry, name, depth, arg, priority, out, core) == pdPASS;
+    }
+
+    /// @brief One named static object (bus, ring, log buffer) in the memory map.
+    struct Region
+    {
+        const char *name{""};      ///< Label (static storage).
+        const void *addr{nullptr}; ///< Start address.
+        std::size_t bytes{0};      ///< Size.
+    };
+
+    /// @brief Heap state recorded by seal().
+    struct Seal
+    {
+        bool done{false};    ///< seal() called.
+        std::size_t free{0}; ///< Free 8-bit heap at seal() (bytes).
+    };
+
+    /// @brief Registered regions.
+    inline std::array<Region, cfg::memory::MAX_REGIONS> &regions() noexcept
+    {
+        static std::array<Region, cfg::memory::MAX_REGIONS> r{};
+        return r;
+    }
+
+    /// @brief Used entries in regions().
+    inline std::size_t &regionCount() noexcept
+    {
+        static std::size_t n = 0;
+        return n;
+    }
+
+    /// @brief Heap state at the end of boot.
+    inline Seal &sealState() noexcept
+    {
+        static Seal s{};
+        return s;
+    }
+
+    /**
+     * @brief List a static region in the memory map (setup() only).
+     *
+     * @param name Label (static storage).
+     * @param addr Start address.
+     * @param bytes Size.
+     */
+    inline void region(const char *name, const void *addr, std::size_t bytes) noexcept
+    {
+        std::size_t &n = regionCount();
+        configASSERT(n < cfg::memory::MAX_REGIONS); ///< Raise cfg::memory::MAX_REGIONS.
+        if (n < cfg::memory::MAX_REGIONS)
+            regions()[n++] = Region{name, addr, bytes};
+    }
+
+    /// @brief List a static object in the memory map (setup() only).
+    template <typename T>
+    inline void region(const char *name, const T &obj) noexcept
+    {
+        region(name, &obj, sizeof(T));
+    }
+
+    /**
+     * @brief End of boot: close the stack pool and record the heap.
+     *
+     * Anything the heap loses after this point is reported by report() as
+     * "since boot", so a stray allocation on a hot path shows up as a number
+     * instead of as fragmentation hours later.
+     */
+    inline void seal() noexcept
+    {
+        stacks().seal();
+        Seal &s = sealState();
+        s.free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        s.done = true;
+    }
+
+    /// @brief Heap bytes taken since seal() (0 before it, or if more is free now).
+    inline std::size_t heapSinceSeal() noexcept
+    {
+        const Seal &s = sealState();
+        const std::size_t now = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        return (s.done && now < s.free) ? s.free - now : 0;
+    }
+
+    /// @brief Print the memory map: static regions, stack pool and heap per capability.
+    inline void report() noexcept
+    {
+        std::size_t internal = 0;
+        std::size_t external = 0;
+
+        debugln("Memory map:");
+        if constexpr (cfg::memory::STATIC_TASKS)
+        {
+            const Stacks &p = stacks();
+            debugfln("  %-12s %-8s %8u B  @%p  (%u / %u used, %u tasks)", "stacks", "internal",
+                     static_cast<unsigned>(Stacks::bytes()), static_cast<const void *>(&p),
+                     static_cast<unsigned>(p.used() * sizeof(StackType_t)),
+                     static_cast<unsigned>(Stacks::capacity() * sizeof(StackType_t)), static_cast<unsigned>(p.tasks()));
+            internal += Stacks::bytes();
+        }
+        for (std::size_t i = 0; i < regionCount(); ++i)
+        {
+            const Region &r = regions()[i];
+            const bool ext = esp_ptr_external_ram(r.addr);
+            debugfln("  %-12s %-8s %8u B  @%p", r.name, ext ? "psram" : "internal", static_cast<unsigned>(r.bytes), r.addr);
+            (ext ? external : internal) += r.bytes;
+        }
+        debugfln("  static total: %u B internal, %u B psram", static_cast<unsigned>(internal), static_cast<unsigned>(external));
+
+        debugfln("  heap internal: %u free  %u min  %u largest", static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL)),
+                 static_cast<unsigned>(heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL)),
+                 static_cast<unsigned>(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL)));
+        if (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0)
+            debugfln("  heap psram:    %u free  %u min  %u largest", static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_SPIRAM)),
+                     static_cast<unsigned>(heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM)),
+                     static_cast<unsigned>(heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM)));
+
+        const Seal &s = sealState();
+        if (s.done)
+            debugfln("  heap since boot: %u B taken (sealed at %u free)", static_cast<unsigned>(heapSinceSeal()),
+                     static_cast<unsigned>(s.free));
+        else
+            debugln("  heap since boot: not sealed yet");
+    }
+} ///< Namespace mem.
@@ -0,0 +1,406 @@
+/**
+ * MIT License
+ *
+ * @brief Lock-free SPSC / MPSC rings: the lossless streaming counterpart to SnapshotBus.
+ *
+ * @file StreamRing.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <freertos/FreeRTOS.h>
+#include <freertos/portmacro.h>
+#include <freertos/task.h>
+
+namespace snapshot
+{
+    /// @brief Data cache line (ESP32-S3 default; the counters below never share one).
+    inline constexpr std::size_t kCacheLine = 32;
+
+    namespace detail
+    {
+        /// @brief Give @p t a task notification (task or ISR context).
+        inline void wake(TaskHandle_t t) noexcept
+        {
+            if (xPortInIsrContext())
+            {
+                BaseType_t woken = pdFALSE;
+                vTaskNotifyGiveFromISR(t, &woken);
+                portYIELD_FROM_ISR(woken);
+            }
+            else
+            {
+                xTaskNotifyGive(t);
+            }
+        }
+    } ///< Namespace detail.
+
+    // ---- Common contract ---- //
+    //
+    // SnapshotBus keeps the latest value; these rings keep every value until
+    // the consumer takes it (a full ring rejects the write: callers decide
+    // whether to count, retry or drop). Capacity is a power of two and the
+    // indices are free-running 32-bit counters, so wrap-around is a mask.
+    //
+    // Wake-up is optional: notify(task) makes producers give that task a
+    // notification when the ring goes from empty to non-empty (one per
+    // burst, not per item). fresh() re-checks behind a full fence, so the
+    // ring can sit in snapshot::wait_any() next to bus subscriptions without
+    // ever sleeping on queued data.
+    //
+    // Both counters sit on their own cache line. Internal SRAM is uncached
+    // on ESP32, so this only matters for rings placed in PSRAM, but it costs
+    // nothing and keeps producer and consumer traffic apart either way.
+
+    /**
+     * @brief Bounded single-producer / single-consumer ring.
+     *
+     * One producer (a task or an ISR) and one consumer task. push / pop are
+     * one load, one copy and one release store each; no CAS, no lock.
+     *
+     * @tparam T Element type (trivially copyable).
+     * @tparam N Capacity (power of two).
+     */
+    template <typename T, std::size_t N>
+    class SpscRing
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two.");
+        static_assert(std::is_trivially_copyable_v<T>, "SpscRing elements are copied as plain bytes.");
+
+    public:
+        using value_type = T; ///< Element type.
+
+        // ---- Producer side ---- //
+
+        /**
+         * @brief Append one element.
+         *
+         * @param v Element.
+         * @return true If queued; false if full.
+         */
+        bool push(const T &v) noexcept { return push_n(&v, 1) == 1; }
+
+        /**
+         * @brief Append up to @p n elements in order (one publish for the batch).
+         *
+         * @param src Elements.
+         * @param n Count.
+         * @return std::size_t Elements queued (fewer than n when the ring fills).
+         */
+        std::size_t push_n(const T *src, std::size_t n) noexcept
+        {
+            const uint32_t head = head_.load(std::memory_order_relaxed);
+            const uint32_t room = static_cast<uint32_t>(N) - (head - tail_.load(std::memory_order_acquire));
+            const uint32_t k = (n < room) ? static_cast<uint32_t>(n) : room;
+            if (k == 0)
+                return 0;
+
+            for (uint32_t i = 0; i < k; ++i)
+                ring_[(head + i) & kMask] = src[i];
+            head_.store(head + k, std::memory_order_release); ///< Publish the batch.
+            wakeIfDrained(head);
+            return k;
+        }
+
+        // ---- Consumer side ---- //
+
+        /**
+         * @brief Take the oldest element.
+         *
+         * @param out Destination (untouched when empty).
+         * @return true If an element was taken.
+         */
+        bool pop(T &out) noexcept { return pop_n(&out, 1) == 1; }
+
+        /**
+         * @brief Take up to @p max elements, oldest first (one release for the batch).
+         *
+         * @param dst Destination.
+         * @param max Room in dst.
+         * @return std::size_t Elements taken.
+         */
+        std::size_t pop_n(T *dst, std::size_t max) noexcept
+        {
+            const uint32_t tail = tail_.load(std::memory_order_relaxed);
+            const uint32_t ready = head_.load(std::memory_order_acquire) - tail;
+            const uint32_t k = (max < ready) ? static_cast<uint32_t>(max) : ready;
+            for (uint32_t i = 0; i < k; ++i)
+                dst[i] = ring_[(tail + i) & kMask];
+            if (k != 0)
+                tail_.store(tail + k, std::memory_order_release); ///< Free the slots.
+            return k;
+        }
+
+        /**
+         * @brief Hand every queued element to @p fn in order, then free the slots in one step.
+         *
+         * @param fn Callable taking const T&.
+         * @return std::size_t Elements delivered.
+         */
+        template <typename Fn>
+        std::size_t drain(Fn &&fn) noexcept
+        {
+            const uint32_t tail = tail_.load(std::memory_order_relaxed);
+            const uint32_t head = head_.load(std::memory_order_acquire); ///< Snapshot: later pushes wait for the next batch.
+            for (uint32_t i = tail; i != head; ++i)
+                fn(ring_[i & kMask]);
+            tail_.store(head, std::memory_order_release);
+            return head - tail;
+        }
+
+        /**
+         * @brief Set (or clear, nullptr) the task woken when the ring goes from empty to non-empty.
+         *
+         * @param consumer Consumer task.
+         */
+        void notify(TaskHandle_t consumer) noexcept { consumer_.store(consumer, std::memory_order_release); }
+
+        /// @brief True if at least one element is queued (consumer side; wait_any() compatible).
+        [[nodiscard]] bool fresh() const noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst); ///< Pairs with wakeIfDrained(): never sleep on data.
+            return head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Elements queued (approximate from a third task).
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+
+        /// @brief Capacity.
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+
+    private:
+        static constexpr uint32_t kMask = static_cast<uint32_t>(N - 1); ///< Index mask.
+
+        /// @brief Wake the consumer if it had taken everything before @p old_head.
+        void wakeIfDrained(uint32_t old_head) noexcept
+        {
+            const TaskHandle_t t = consumer_.load(std::memory_order_acquire);
+            if (t == nullptr)
+                return;
+            std::atomic_thread_fence(std::memory_order_seq_cst); ///< Head store before the tail check (see fresh()).
+            if (tail_.load(std::memory_order_relaxed) == old_head)
+                detail::wake(t);
+        }
+
+        alignas(kCacheLine) std::atomic<uint32_t> head_{0}; ///< Next slot to write (producer).
+        alignas(kCacheLine) std::atomic<uint32_t> tail_{0}; ///< Next slot to read (consumer).
+        std::atomic<TaskHandle_t> consumer_{nullptr};       ///< Wake target (nullptr → none).
+        alignas(kCacheLine) std::array<T, N> ring_{};       ///< Slots.
+    };
+
+    /**
+     * @brief Bounded multi-producer / single-consumer ring.
+     *
+     * Producers (any task on either core, or an ISR) reserve slots with one
+     * CAS on the enqueue counter, fill them in place and publish each with a
+     * per-slot sequence store; the consumer frees slots in order. A producer
+     * pre-empted between reserve and publish holds up the consumer at that
+     * slot (later slots stay queued behind it) but never blocks another
+     * producer.
+     *
+     * @tparam T Element type (trivially copyable).
+     * @tparam N Capacity (power of two).
+     */
+    template <typename T, std::size_t N>
+    class MpscRing
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscRing capacity must be a power of two.");
+        static_assert(std::is_trivially_copyable_v<T>, "MpscRing elements are copied as plain bytes.");
+
+    public:
+        using value_type = T; ///< Element type.
+
+        MpscRing() noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                cells_[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+
+        // ---- Producer side (any task or ISR) ---- //
+
+        /**
+         * @brief Reserve one slot, let @p fill write it in place, then publish it.
+         *
+         * @param fill Callable taking T& (keep it short: the consumer waits on this slot).
+         * @return true If queued; false if full (fill not called).
+         */
+        template <typename Fill>
+        bool produce(Fill &&fill) noexcept
+        {
+            uint32_t pos = 0;
+            if (reserve(1, pos) == 0)
+                return false;
+            Cell &c = cells_[pos & kMask];
+            fill(c.value);
+            c.seq.store(pos + 1, std::memory_order_release); ///< Publish to the consumer.
+            wakeIfDrained(pos);
+            return true;
+        }
+
+        /**
+         * @brief Append one element.
+         *
+         * @param v Element.
+         * @return true If queued; false if full.
+         */
+        bool push(const T &v) noexcept
+        {
+            return produce([&v](T &slot) { slot = v; });
+        }
+
+        /**
+         * @brief Append up to @p n elements as one contiguous run (no other producer interleaves).
+         *
+         * @param src Elements.
+         * @param n Count.
+         * @return std::size_t Elements queued (fewer than n when the ring fills).
+         */
+        std::size_t push_n(const T *src, std::size_t n) noexcept
+        {
+            uint32_t pos = 0;
+            const uint32_t k = reserve(n, pos);
+            for (uint32_t i = 0; i < k; ++i)
+            {
+                Cell &c = cells_[(pos + i) & kMask];
+                c.value = src[i];
+                c.seq.store(pos + i + 1, std::memory_order_release);
+            }
+            if (k != 0)
+                wakeIfDrained(pos);
+            return k;
+        }
+
+        // ---- Consumer side (one task) ---- //
+
+        /**
+         * @brief Take the oldest element.
+         *
+         * @param out Destination (untouched when empty).
+         * @return true If an element was taken.
+         */
+        bool pop(T &out) noexcept { return pop_n(&out, 1) == 1; }
+
+        /**
+         * @brief Take up to @p max published elements, oldest first.
+         *
+         * @param dst Destination.
+         * @param max Room in dst.
+         * @return std::size_t Elements taken.
+         */
+        std::size_t pop_n(T *dst, std::size_t max) noexcept
+        {
+            std::size_t k = 0;
+            drain([&](const T &v) { dst[k++] = v; }, max);
+            return k;
+        }
+
+        /**
+         * @brief Hand published elements to @p fn in order, freeing each slot as it goes.
+         *
+         * Stops at the first slot still being filled. Slots are released one by
+         * one, so producers regain room even if @p fn is slow (e.g. a flash write).
+         *
+         * @param fn Callable taking const T&.
+         * @param max Element limit.
+         * @return std::size_t Elements delivered.
+         */
+        template <typename Fn>
+        std::size_t drain(Fn &&fn, std::size_t max = SIZE_MAX) noexcept
+        {
+            uint32_t deq = deq_.load(std::memory_order_relaxed);
+            std::size_t k = 0;
+            while (k < max)
+            {
+                Cell &c = cells_[deq & kMask];
+                if (c.seq.load(std::memory_order_acquire) != deq + 1)
+                    break; ///< Empty (or the next producer is still filling).
+                fn(c.value);
+                c.seq.store(deq + static_cast<uint32_t>(N), std::memory_order_relaxed); ///< Not ready for the next lap.
+                deq_.store(++deq, std::memory_order_release);                           ///< Free the slot.
+                ++k;
+            }
+            return k;
+        }
+
+        /**
+         * @brief Set (or clear, nullptr) the task woken when the ring goes from empty to non-empty.
+         *
+         * @param consumer Consumer task.
+         */
+        void notify(TaskHandle_t consumer) noexcept { consumer_.store(consumer, std::memory_order_release); }
+
+        /// @brief True if the next element is published (consumer side; wait_any() compatible).
+        [[nodiscard]] bool fresh() const noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst); ///< Pairs with wakeIfDrained(): never sleep on data.
+            const uint32_t deq = deq_.load(std::memory_order_relaxed);
+            return cells_[deq & kMask].seq.load(std::memory_order_acquire) == deq + 1;
+        }
+
+        /// @brief Slots reserved and not yet taken (approximate from a third task).
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return enq_.load(std::memory_order_acquire) - deq_.load(std::memory_order_acquire);
+        }
+
+        /// @brief Capacity.
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+
+    private:
+        static constexpr uint32_t kMask = static_cast<uint32_t>(N - 1); ///< Index mask.
+
+        struct Cell
+        {
+            std::atomic<uint32_t> seq{0}; ///< == pos + 1 → published for this lap.
+            T value{};                    ///< Payload.
+        };
+
+        /// @brief Reserve up to @p n contiguous slots from @p pos; returns the count (0 → full).
+        uint32_t reserve(std::size_t n, uint32_t &pos) noexcept
+        {
+            pos = enq_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const int32_t used = static_cast<int32_t>(pos - deq_.load(std::memory_order_acquire));
+                if (used < 0)
+                {
+                    pos = enq_.load(std::memory_order_relaxed); ///< Stale pos: the consumer already passed it.
+                    continue;
+                }
+                const uint32_t room = static_cast<uint32_t>(N) - static_cast<uint32_t>(used);
+                const uint32_t k = (n < room) ? static_cast<uint32_t>(n) : room;
+                if (k == 0)
+                    return 0;
+                if (enq_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                    return k; ///< Lost races reload pos and retry.
+            }
+        }
+
+        /// @brief Wake the consumer if it was waiting on slot @p pos.
+        void wakeIfDrained(uint32_t pos) noexcept
+        {
+            const TaskHandle_t t = consumer_.load(std::memory_order_acquire);
+            if (t == nullptr)
+                return;
+            std::atomic_thread_fence(std::memory_order_seq_cst); ///< Slot publish before the deq check (see fresh()).
+            if (deq_.load(std::memory_order_relaxed) == pos)
+                detail::wake(t);
+        }
+
+        alignas(kCacheLine) std::atomic<uint32_t> enq_{0}; ///< Next slot to reserve (producers).
+        alignas(kCacheLine) std::atomic<uint32_t> deq_{0}; ///< Next slot to take (consumer).
+        std::atomic<TaskHandle_t> consumer_{nullptr};      ///< Wake target (nullptr → none).
+        std::array<Cell, N> cells_{};                      ///< Slots.
+    };
+} ///< Namespace snapshot.
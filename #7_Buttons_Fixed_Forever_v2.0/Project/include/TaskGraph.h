@@ -0,0 +1,424 @@
+/**
+ * MIT License
+ *
+ * @brief Declarative task graph: modules + bus dependencies + timing → priorities, cores, start order.
+ *
+ * @file TaskGraph.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <StaticPool.h>
+
+namespace rtos
+{
+    static constexpr int kAnyCore = -1; ///< Let the graph pick the core.
+
+    /**
+     * @brief Builds and starts a fixed set of RTOS tasks from declarations.
+     *
+     * Each node names its entry, stack, timing and the buses it reads/writes:
+     *
+     * @code
+     * graph.add("ControlCore", cc, CC_STACK).deadline_us(2000).reads(inputBus).writes(controlBus);
+     * @endcode
+     *
+     * create() then:
+     *  - assigns priorities deadline-monotonically (rate-monotonic when only a period
+     *    is given): a shorter deadline/period gives a higher priority, equal ones
+     *    share a level, nodes with neither run at the base (background) priority;
+     *  - applies any bump() on top (a measured correction, see AutoTuner);
+     *  - places unpinned nodes, highest priority first, on the core with the lowest
+     *    declared utilisation (budget / period);
+     *  - creates every task parked on a start gate, so handles exist before anything runs
+     *    (stacks from mem::stacks() when cfg::memory::STATIC_TASKS).
+     * release() opens the gates consumers-first (a node is released only after every
+     * node reading a bus it writes), waiting for each consumer to reach its first
+     * block instead of a fixed delay.
+     *
+     * @tparam MaxNodes Task capacity.
+     * @tparam MaxBuses Buses per node and direction.
+     */
+    template <std::size_t MaxNodes = 8, std::size_t MaxBuses = 4>
+    class TaskGraph
+    {
+    public:
+        /**
+         * @brief One task declaration (fluent setters).
+         */
+        class Node
+        {
+        public:
+            /// @brief Periodic task: wakes every @p us.
+            Node &every_us(uint32_t us) noexcept { period_us_ = us; return *this; }
+
+            /// @brief Periodic task: wakes every @p ms.
+            Node &every_ms(uint32_t ms) noexcept { return every_us(ms * 1000U); }
+
+            /// @brief Must react within @p us of its input (event-driven nodes); orders before period.
+            Node &deadline_us(uint32_t us) noexcept { deadline_us_ = us; return *this; }
+
+            /// @brief Expected execution time per activation (µs), used for core balancing.
+            Node &budget_us(uint32_t us) noexcept { budget_us_ = us; return *this; }
+
+            /// @brief Pin to @p core (kAnyCore → graph decides).
+            Node &pin(int core) noexcept { core_ = core; pinned_ = core != kAnyCore; return *this; }
+
+            /// @brief Fixed priority (skips the deadline-monotonic assignment).
+            Node &priority(UBaseType_t p) noexcept { fixed_pri_ = true; priority_ = p; return *this; }
+
+            /// @brief Move the assigned priority by @p levels (after the deadline-monotonic pass, clamped to the band).
+            Node &bump(int levels) noexcept { bump_ = static_cast<int8_t>(levels); return *this; }
+
+            /// @brief Receive the task handle on create().
+            Node &handle(TaskHandle_t *out) noexcept { out_ = out; return *this; }
+
+            /// @brief This node consumes @p bus.
+            template <typename Bus>
+            Node &reads(const Bus &bus) noexcept { return link(reads_, n_reads_, &bus); }
+
+            /// @brief This node publishes to @p bus.
+            template <typename Bus>
+            Node &writes(const Bus &bus) noexcept { return link(writes_, n_writes_, &bus); }
+
+            /// @brief Task name.
+            [[nodiscard]] const char *name() const noexcept { return name_; }
+
+            /// @brief Assigned core (requested core before create()).
+            [[nodiscard]] int core() const noexcept { return core_; }
+
+            /// @brief Assigned priority (valid after create()).
+            [[nodiscard]] UBaseType_t level() const noexcept { return priority_; }
+
+            /// @brief True if the declaration pinned the core (false → placed by the graph).
+            [[nodiscard]] bool pinned() const noexcept { return pinned_; }
+
+        private:
+            friend class TaskGraph;
+
+            Node &link(std::array<const void *, MaxBuses> &set, uint8_t &n, const void *bus) noexcept
+            {
+                configASSERT(n < MaxBuses); ///< Raise MaxBuses.
+                if (n < MaxBuses)
+                    set[n++] = bus;
+                return *this;
+            }
+
+            /// @brief Deadline-monotonic key (0 → background).
+            uint32_t key() const noexcept { return deadline_us_ ? deadline_us_ : period_us_; }
+
+            /// @brief Declared utilisation (‰ of one core).
+            uint32_t load() const noexcept
+            {
+                const uint32_t k = key();
+                return (k > 0) ? static_cast<uint32_t>((uint64_t{budget_us_} * 1000U) / k) : 0U;
+            }
+
+            /// @brief True if this node reads any bus @p producer writes.
+            bool consumes(const Node &producer) const noexcept
+            {
+                for (uint8_t r = 0; r < n_reads_; ++r)
+                    for (uint8_t w = 0; w < producer.n_writes_; ++w)
+                        if (reads_[r] == producer.writes_[w])
+                            return true;
+                return false;
+            }
+
+            static void gate(void *self) noexcept
+            {
+                Node *n = static_cast<Node *>(self);
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY); ///< Parked until release().
+                n->entry_(n->arg_);
+                vTaskDelete(nullptr); ///< Entries normally never return.
+            }
+
+            const char *name_{""};                      ///< Task name.
+            TaskFunction_t entry_{nullptr};             ///< Module entry.
+            void *arg_{nullptr};                        ///< Entry argument.
+            uint32_t stack_words_{0};                   ///< Stack size (words).
+            uint32_t period_us_{0};                     ///< Wake period (0 → event-driven).
+            uint32_t deadline_us_{0};                   ///< Reaction deadline (0 → = period).
+            uint32_t budget_us_{0};                     ///< Execution budget per activation.
+            int core_{kAnyCore};                        ///< Requested / assigned core.
+            bool pinned_{false};                        ///< pin() chose the core.
+            bool fixed_pri_{false};                     ///< priority() was called.
+            int8_t bump_{0};                            ///< Levels added after assignment.
+            UBaseType_t priority_{0};                   ///< Requested / assigned priority.
+            TaskHandle_t *out_{nullptr};                ///< Optional handle output.
+            TaskHandle_t task_{nullptr};                ///< Created task.
+            std::array<const void *, MaxBuses> reads_{};  ///< Consumed buses.
+            std::array<const void *, MaxBuses> writes_{}; ///< Published buses.
+            uint8_t n_reads_{0};                        ///< Used entries in reads_.
+            uint8_t n_writes_{0};                       ///< Used entries in writes_.
+        };
+
+        /**
+         * @brief Construct with the priority band available to the graph.
+         *
+         * @param base_priority Background priority; timed nodes get base+1 upward.
+         * @param max_priority Highest priority the graph may assign.
+         */
+        explicit TaskGraph(UBaseType_t base_priority = cfg::graph::BASE_PRI,
+                           UBaseType_t max_priority = cfg::graph::MAX_PRI) noexcept
+            : base_pri_(base_priority), max_pri_(max_priority) {}
+
+        /**
+         * @brief Declare a module task (entry = Module::task, argument = &module).
+         *
+         * @param name Task name (static storage).
+         * @param module Module instance (must outlive the task).
+         * @param stack_words Stack size (words).
+         * @return Node& Declaration to chain timing / bus setters on.
+         */
+        template <typename Module>
+        Node &add(const char *name, Module &module, uint32_t stack_words) noexcept
+        {
+            return add(name, &Module::task, &module, stack_words);
+        }
+
+        /**
+         * @brief Declare a task from a raw entry point.
+         *
+         * @param name Task name (static storage).
+         * @param entry Task function.
+         * @param arg Task parameter.
+         * @param stack_words Stack size (words).
+         * @return Node& Declaration to chain timing / bus setters on.
+         */
+        Node &add(const char *name, TaskFunction_t entry, void *arg, uint32_t stack_words) noexcept
+        {
+            configASSERT(count_ < MaxNodes); ///< Raise MaxNodes.
+            if (count_ >= MaxNodes)
+            {
+                overflow_ = true;
+                spare_ = Node{};
+                return spare_; ///< Absorb the setters; create() will fail.
+            }
+
+            Node &n = nodes_[count_++];
+            n.name_ = name;
+            n.entry_ = entry;
+            n.arg_ = arg;
+            n.stack_words_ = stack_words;
+            return n;
+        }
+
+        /**
+         * @brief Declared node called @p name.
+         *
+         * @param name Task name.
+         * @return Node* Declaration, or nullptr if no node has that name.
+         */
+        Node *find(const char *name) noexcept
+        {
+            for (std::size_t i = 0; i < count_; ++i)
+                if (strcmp(nodes_[i].name_, name) == 0)
+                    return &nodes_[i];
+            return nullptr;
+        }
+
+        /// @copydoc find(const char *)
+        const Node *find(const char *name) const noexcept { return const_cast<TaskGraph *>(this)->find(name); }
+
+        /**
+         * @brief Assign priorities and cores, then create every task parked on its gate.
+         *
+         * @return true If every task was created.
+         */
+        bool create() noexcept
+        {
+            if (overflow_ || created_)
+                return !overflow_;
+
+            assignPriorities();
+            assignCores();
+
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                Node &n = nodes_[i];
+                if (!mem::createTask(&Node::gate, n.name_, n.stack_words_, &n, n.priority_, &n.task_, n.core_))
+                    return false;
+                if (n.out_ != nullptr)
+                    *n.out_ = n.task_;
+            }
+            created_ = true;
+            return true;
+        }
+
+        /**
+         * @brief Open the start gates, consumers before their producers.
+         */
+        void release() noexcept
+        {
+            if (!created_)
+                return;
+
+            std::array<bool, MaxNodes> done{};
+            const TickType_t settle = to_ticks_ms(cfg::graph::SETTLE_MS);
+
+            for (std::size_t started = 0; started < count_; ++started)
+            {
+                std::size_t pick = count_;
+                for (std::size_t i = 0; i < count_ && pick == count_; ++i)
+                {
+                    if (done[i])
+                        continue;
+                    bool ready = true; ///< Every consumer of i's outputs already released?
+                    for (std::size_t j = 0; j < count_ && ready; ++j)
+                        ready = done[j] || j == i || !nodes_[j].consumes(nodes_[i]);
+                    if (ready)
+                        pick = i;
+                }
+                if (pick == count_)
+                {
+                    pick = 0; ///< Cycle: fall back to declaration order.
+                    while (done[pick])
+                        ++pick;
+                }
+
+                Node &n = nodes_[pick];
+                done[pick] = true;
+                xTaskNotifyGive(n.task_);
+
+                if (n.n_reads_ == 0)
+                    continue; ///< Pure producers need no settle.
+
+                // Let the consumer reach its first wait (subscriptions are taken in run()).
+                for (TickType_t t = 0; t < settle; ++t)
+                {
+                    const eTaskState st = eTaskGetState(n.task_);
+                    if (st != eReady && st != eRunning)
+                        break;
+                    vTaskDelay(1);
+                }
+            }
+        }
+
+        /**
+         * @brief create() + release().
+         *
+         * @return true If every task was created and released.
+         */
+        bool start() noexcept
+        {
+            if (!create())
+                return false;
+            release();
+            return true;
+        }
+
+        /// @brief Print the resolved plan (name, priority, core, timing).
+        void print() const noexcept
+        {
+            debugln("Task graph:");
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                const Node &n = nodes_[i];
+                debugfln("  %-12s pri %2u core %d period %6u us deadline %6u us load %3u‰", n.name_,
+                         static_cast<unsigned>(n.priority_), n.core_, static_cast<unsigned>(n.period_us_),
+                         static_cast<unsigned>(n.deadline_us_), static_cast<unsigned>(n.load()));
+            }
+        }
+
+    private:
+        /// @brief Deadline-monotonic priorities: distinct keys, longest → base+1, shortest → highest.
+        void assignPriorities() noexcept
+        {
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                Node &n = nodes_[i];
+                if (n.fixed_pri_)
+                    continue;
+
+                const uint32_t k = n.key();
+                if (k == 0)
+                {
+                    n.priority_ = base_pri_; ///< Background.
+                    continue;
+                }
+
+                UBaseType_t level = base_pri_ + 1;
+                for (std::size_t j = 0; j < count_; ++j)
+                {
+                    const uint32_t kj = nodes_[j].key();
+                    if (nodes_[j].fixed_pri_ || kj == 0 || kj <= k)
+                        continue;
+                    bool first = true; ///< Count each longer key once.
+                    for (std::size_t m = 0; m < j; ++m)
+                        if (!nodes_[m].fixed_pri_ && nodes_[m].key() == kj)
+                            first = false;
+                    if (first)
+                        ++level;
+                }
+                n.priority_ = (level < max_pri_) ? level : max_pri_;
+            }
+
+            // bump(): relative to the assigned level, so the other nodes keep theirs.
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                Node &n = nodes_[i];
+                if (n.bump_ == 0)
+                    continue;
+                const int p = static_cast<int>(n.priority_) + n.bump_;
+                const int lo = static_cast<int>(base_pri_);
+                const int hi = static_cast<int>(max_pri_);
+                n.priority_ = static_cast<UBaseType_t>((p < lo) ? lo : (p > hi) ? hi : p);
+            }
+        }
+
+        /// @brief Greedy placement of unpinned nodes, highest priority first, onto the least-loaded core.
+        void assignCores() noexcept
+        {
+            std::array<uint32_t, portNUM_PROCESSORS> load{};
+            std::array<bool, MaxNodes> placed{};
+
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                const Node &n = nodes_[i];
+                if (n.core_ >= 0 && n.core_ < portNUM_PROCESSORS)
+                {
+                    load[n.core_] += n.load();
+                    placed[i] = true;
+                }
+            }
+
+            for (;;)
+            {
+                std::size_t next = count_;
+                for (std::size_t i = 0; i < count_; ++i)
+                    if (!placed[i] && (next == count_ || nodes_[i].priority_ > nodes_[next].priority_))
+                        next = i;
+                if (next == count_)
+                    break;
+
+                int best = 0;
+                for (int c = 1; c < portNUM_PROCESSORS; ++c)
+                    if (load[c] < load[best])
+                        best = c;
+
+                nodes_[next].core_ = best;
+                load[best] += nodes_[next].load();
+                placed[next] = true;
+            }
+        }
+
+        // ---- Internal state ---- //
+        std::array<Node, MaxNodes> nodes_{}; ///< Declared tasks.
+        Node spare_{};                       ///< Sink for add() past capacity.
+        std::size_t count_{0};               ///< Used entries in nodes_.
+        UBaseType_t base_pri_{1};            ///< Background priority.
+        UBaseType_t max_pri_{1};             ///< Priority ceiling.
+        bool overflow_{false};               ///< add() ran out of nodes.
+        bool created_{false};                ///< create() succeeded.
+    };
+} ///< Namespace rtos.
@@ -0,0 +1,49 @@
+/**
+ * MIT License
+ *
+ * @brief Snapshot payload and bus for drive telemetry (measured speed, duty).
+ *
+ * @file TelemetryBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+
+/**
+ * @brief Drive state published by PowerDriveHandler after each speed sample.
+ */
+struct TelemetrySnapshot
+{
+    float rpm{0.0f};          ///< Measured shaft speed (rpm, unsigned; 0 without an encoder).
+    float setpoint_rpm{0.0f}; ///< Ramped speed setpoint (rpm; negative in reverse).
+    float duty_pct{0.0f};     ///< Duty actually applied to the motor (-100..100 %; negative in reverse).
+    float vbus_v{0.0f};       ///< Bus voltage (V; PowerBus, 0 without power sensing).
+    float amps{0.0f};         ///< Bridge current (A; PowerBus, 0 without power sensing).
+    bool closed_loop{false};  ///< True if the encoder speed loop is active.
+    bool limited{false};      ///< True if the current / power envelope is holding the duty down.
+    uint64_t stamp_us{0};     ///< Sample timestamp (µs since boot).
+    uint64_t origin_us{0};    ///< Origin stamp of the control frame being applied.
+};
+
+/**
+ * @brief Type alias for the SnapshotBus that transports telemetry frames.
+ */
+using TelemetryBus = snapshot::SignalBus<TelemetrySnapshot>;
+
+/**
+ * @brief Single, shared TelemetryBus instance.
+ */
+namespace buses
+{
+    inline TelemetryBus &telemetry() noexcept ///< Return reference to the shared TelemetryBus.
+    {
+        static TelemetryBus bus{}; ///< One (only) TelemetryBus instance.
+        return bus;                ///< Return reference to shared bus.
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * MIT License
+ *
+ * @brief Bit-parallel debouncer: one 2-bit vertical counter per input, a whole word per step.
+ *
+ * @file VerticalDebounce.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Debounces every bit of a word at once.
+ *
+ * Bit i of c0_/c1_ is a 2-bit counter of consecutive samples in which input
+ * i disagreed with its debounced state. A disagreement seen kSamples times
+ * in a row flips the state; any agreeing sample resets the counter. Each
+ * clock() is a handful of bitwise ops whatever the word width, so the
+ * cost is the same for 4 inputs or 64.
+ *
+ * @tparam Word uint32_t or uint64_t.
+ */
+template <typename Word>
+class VerticalDebounce
+{
+    static_assert(std::is_unsigned_v<Word>, "VerticalDebounce needs an unsigned word.");
+
+public:
+    static constexpr uint32_t kSamples = 4; ///< Consecutive samples needed to accept a change.
+
+    /// @brief Start with @p initial as the debounced state (counters cleared).
+    constexpr explicit VerticalDebounce(Word initial = 0) noexcept : state_(initial) {}
+
+    /**
+     * @brief Feed one sample of every input.
+     *
+     * @param sample Raw levels (1 = active).
+     * @return Word Bits whose debounced state flipped on this sample.
+     */
+    Word clock(Word sample) noexcept
+    {
+        const Word delta = sample ^ state_;      ///< Inputs disagreeing with their state.
+        const Word flip = delta & c0_ & c1_;     ///< Counter already at 3: this is the 4th sample.
+        const Word keep = delta & ~flip;         ///< Still counting.
+        c1_ = (c1_ ^ c0_) & keep;                ///< Increment (carry from c0).
+        c0_ = ~c0_ & keep;                       ///< Increment; agreeing / flipped inputs reset.
+        state_ ^= flip;
+        return flip;
+    }
+
+    /// @brief Debounced levels.
+    [[nodiscard]] Word state() const noexcept { return state_; }
+
+    /// @brief Force the state (e.g. at start-up) and clear the counters.
+    void reset(Word s) noexcept
+    {
+        state_ = s;
+        c0_ = c1_ = 0;
+    }
+
+private:
+    Word state_{0}; ///< Debounced levels.
+    Word c0_{0};    ///< Counter bit 0 per input.
+    Word c1_{0};    ///< Counter bit 1 per input.
+};
@@ -0,0 +1,221 @@
+/**
+ * MIT License
+ *
+ * @brief Zero-copy snapshot bus: writers fill a back buffer in place, readers pin frames.
+ *
+ * @file ViewBus.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <SignalBus.h>
+
+namespace snapshot
+{
+    /**
+     * @brief Single-writer, multi-reader bus for large payloads without per-frame copies.
+     *
+     * SnapshotBus::publish(v) copies v into the bus and peek() copies it back out,
+     * so a frame built on the stack is copied twice. ViewBus instead keeps
+     * MaxReaders + 2 slots:
+     *  - begin_write() hands the writer a slot that is neither the latest frame nor
+     *    pinned by any reader; commit() makes it the latest in one index store.
+     *  - read_view() pins the latest slot (reference count) and returns a guard;
+     *    the writer never reuses a pinned slot, so the reference stays stable for
+     *    as long as the guard lives.
+     *
+     * With at most MaxReaders guards alive there is always a free slot, so the
+     * writer never waits and readers never retry more than once per commit.
+     * Subscriptions, notifications and the publish clock (age_us()) work
+     * exactly like SignalBus.
+     *
+     * @note The back buffer holds an older frame, not the latest: writers must
+     *       overwrite every field. Calling begin_write() again before commit()
+     *       returns the same buffer (a dropped write costs nothing).
+     * @tparam T Payload type.
+     * @tparam MaxReaders Maximum ReadView guards alive at once (across all tasks).
+     * @tparam MaxSubscribers Maximum concurrent subscribers.
+     */
+    template <typename T, std::size_t MaxReaders = 4, std::size_t MaxSubscribers = 6>
+    class ViewBus : public PublishClock
+    {
+    public:
+        using value_type = T;   ///< Payload type.
+        using seq_t = uint32_t; ///< Publish sequence type.
+
+        static constexpr std::size_t kSlots = MaxReaders + 2; ///< Latest + in-progress write + one per reader.
+        static_assert(kSlots < 0xFF, "ViewBus: too many readers.");
+
+        /**
+         * @brief Read guard: a stable const reference to one published frame (move-only).
+         */
+        class ReadView
+        {
+        public:
+            ReadView() noexcept = default;
+
+            ReadView(ReadView &&o) noexcept : bus_(o.bus_), slot_(o.slot_), seq_(o.seq_) { o.bus_ = nullptr; }
+
+            ReadView &operator=(ReadView &&o) noexcept
+            {
+                if (this != &o)
+                {
+                    release();
+                    bus_ = o.bus_;
+                    slot_ = o.slot_;
+                    seq_ = o.seq_;
+                    o.bus_ = nullptr;
+                }
+                return *this;
+            }
+
+            ReadView(const ReadView &) = delete;
+            ReadView &operator=(const ReadView &) = delete;
+
+            ~ReadView() { release(); }
+
+            /// @brief True if this guard pins a frame.
+            [[nodiscard]] bool valid() const noexcept { return bus_ != nullptr; }
+
+            /// @brief Sequence at which the pinned frame was committed (0 → initial frame).
+            [[nodiscard]] seq_t sequence() const noexcept { return seq_; }
+
+            const T &operator*() const noexcept { return bus_->slots_[slot_]; }
+            const T *operator->() const noexcept { return &bus_->slots_[slot_]; }
+
+        private:
+            friend class ViewBus;
+
+            ReadView(const ViewBus &bus, uint8_t slot, seq_t seq) noexcept : bus_(&bus), slot_(slot), seq_(seq) {}
+
+            void release() noexcept
+            {
+                if (bus_ != nullptr)
+                    bus_->refs_[slot_].fetch_sub(1, std::memory_order_release);
+                bus_ = nullptr;
+            }
+
+            const ViewBus *bus_{nullptr}; ///< Non-owning bus (nullptr → empty guard).
+            uint8_t slot_{0};             ///< Pinned slot.
+            seq_t seq_{0};                ///< Sequence of the pinned frame.
+        };
+
+        /**
+         * @brief Reserve the back buffer for in-place construction of the next frame.
+         *
+         * Single writer only. Task context (may yield if more than MaxReaders guards are alive).
+         *
+         * @return T& Back buffer (contents are an older frame).
+         */
+        T &begin_write() noexcept
+        {
+            if (back_ == kNone)
+                back_ = claim();
+            return slots_[back_];
+        }
+
+        /**
+         * @brief Publish the buffer returned by begin_write() and wake subscribers.
+         */
+        void commit() noexcept
+        {
+            if (back_ == kNone)
+                return; ///< Nothing reserved.
+
+            const seq_t next = seq_.load(std::memory_order_relaxed) + 1;
+            slot_seq_[back_] = next;
+            latest_.store(back_, std::memory_order_seq_cst); ///< Frame + slot_seq_ visible before the index.
+            seq_.store(next, std::memory_order_release);
+            back_ = kNone;
+
+            stamp();
+            subs_.notify();
+        }
+
+        /**
+         * @brief Copying publish, for small writers that already hold a frame.
+         *
+         * @param v Frame to publish.
+         */
+        void publish(const T &v) noexcept
+        {
+            begin_write() = v;
+            commit();
+        }
+
+        /**
+         * @brief Pin the latest frame.
+         *
+         * @return ReadView Guard; the frame cannot be overwritten while it lives.
+         */
+        [[nodiscard]] ReadView read_view() const noexcept
+        {
+            for (;;)
+            {
+                const uint8_t i = latest_.load(std::memory_order_seq_cst);
+                refs_[i].fetch_add(1, std::memory_order_seq_cst);
+                if (latest_.load(std::memory_order_seq_cst) == i)
+                    return ReadView{*this, i, slot_seq_[i]};      ///< Still latest after pinning → writer will skip it.
+                refs_[i].fetch_sub(1, std::memory_order_release); ///< Lost a race with commit(): retry on the new slot.
+            }
+        }
+
+        /// @brief Copy of the latest frame (SnapshotBus-compatible).
+        [[nodiscard]] T peek() const noexcept { return *read_view(); }
+
+        /// @brief Number of commits so far.
+        [[nodiscard]] seq_t sequence() const noexcept { return seq_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Subscribe the calling task to commit notifications.
+         *
+         * @return Subscription Handle (invalid if all slots are taken).
+         */
+        [[nodiscard]] Subscription<ViewBus> subscribe() noexcept
+        {
+            return Subscription<ViewBus>{*this, subs_.attach(xTaskGetCurrentTaskHandle())};
+        }
+
+    private:
+        friend class Subscription<ViewBus>;
+
+        static constexpr uint8_t kNone = 0xFF; ///< No back buffer reserved.
+
+        /// @brief Find a slot that is not the latest and not pinned.
+        uint8_t claim() noexcept
+        {
+            for (;;)
+            {
+                const uint8_t latest = latest_.load(std::memory_order_relaxed); ///< Only this writer changes it.
+                for (uint8_t i = 0; i < kSlots; ++i)
+                {
+                    if (i != latest && refs_[i].load(std::memory_order_seq_cst) == 0)
+                        return i;
+                }
+#ifdef SNAPSHOTBUS_YIELD
+                SNAPSHOTBUS_YIELD(); ///< More than MaxReaders guards alive: wait for one to drop.
+#endif
+            }
+        }
+
+        /// @brief Release a subscriber slot.
+        void detach(int slot) noexcept { subs_.detach(slot); }
+
+        std::array<T, kSlots> slots_{};                            ///< Frame storage.
+        mutable std::array<std::atomic<uint16_t>, kSlots> refs_{}; ///< Live ReadView guards per slot.
+        std::array<seq_t, kSlots> slot_seq_{};                     ///< Commit sequence of each slot's frame.
+        std::atomic<uint8_t> latest_{0};                           ///< Index of the latest committed slot.
+        std::atomic<seq_t> seq_{0};                                ///< Commit counter.
+        uint8_t back_{kNone};                                      ///< Slot reserved by begin_write() (writer-only).
+        SubscriberSet<MaxSubscribers> subs_{};                     ///< Subscribed tasks.
+    };
+} ///< Namespace snapshot.
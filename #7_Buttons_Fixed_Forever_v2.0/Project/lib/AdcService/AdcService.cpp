@@ -0,0 +1,62 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of AdcService (ADC1 DMA → PowerBus).
+ *
+ * @file AdcService.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "AdcService.h"
+
+// Claim the pins and start the DMA stream.
+bool AdcService::begin() noexcept
+{
+    vbus_slot_ = stream_.add(vbus_pin_);
+    amps_slot_ = stream_.add(current_pin_);
+    if (vbus_pin_ >= 0 && vbus_slot_ < 0)
+        logError("AdcService: Vbus GPIO %d is not an ADC1 pin.", vbus_pin_);
+    if (current_pin_ >= 0 && amps_slot_ < 0)
+        logError("AdcService: current GPIO %d is not an ADC1 pin.", current_pin_);
+
+    if (!stream_.begin(cfg::adc::SAMPLE_HZ))
+        return false;
+
+    logInfo("AdcService: Vbus %d, current %d at %u Hz, %u us frames.", vbus_pin_, current_pin_,
+            static_cast<unsigned>(cfg::adc::SAMPLE_HZ), static_cast<unsigned>(stream_.frameUs()));
+    return true;
+}
+
+// Main run loop.
+void AdcService::run() noexcept
+{
+    configASSERT(bus_ != nullptr && stream_.running()); ///< Sanity check: begin() must have succeeded.
+
+    for (;;)
+    {
+        Stream::Frame f{};
+        if (!stream_.read(f, kReadTimeoutMs)) ///< Blocks on the DMA ring: paced by the hardware.
+            continue;
+        ++frames_;
+
+        PowerSnapshot p{};
+        if (vbus_slot_ >= 0 && f.n[vbus_slot_] != 0)
+        {
+            p.vbus_v = static_cast<float>(f.mv[vbus_slot_]) * 1e-3f * cfg::adc::VDIV_RATIO;
+            p.has_vbus = true;
+        }
+        if (amps_slot_ >= 0 && f.n[amps_slot_] != 0)
+        {
+            const float a = (static_cast<float>(f.mv[amps_slot_]) * 1e-3f - cfg::adc::CURRENT_OFFSET_V) / cfg::adc::CURRENT_V_PER_A;
+            p.amps = (a > 0.0f) ? a : 0.0f; ///< Sense output is unipolar: below the offset is noise.
+            p.has_amps = true;
+        }
+        p.watts = p.vbus_v * p.amps;
+        for (const uint8_t n : f.n)
+            p.samples = static_cast<uint16_t>(p.samples + n);
+        p.stamp_us = now_us();
+        bus_->publish(p);
+    }
+}
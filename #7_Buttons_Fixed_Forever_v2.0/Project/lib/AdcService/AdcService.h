@@ -0,0 +1,75 @@
+/**
+ * MIT License
+ *
+ * @brief Bus voltage / motor current acquisition: ADC1 DMA frames averaged onto PowerBus.
+ *
+ * @file AdcService.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <cstdint>
+#include <AdcStream.h>
+#include <PowerBus.h>
+
+/**
+ * @brief Owns the ADC1 continuous stream and publishes one PowerSnapshot per frame.
+ *
+ * Vbus and current are converted round-robin at cfg::adc::SAMPLE_HZ; each
+ * DMA frame (cfg::adc::FRAME_SAMPLES conversions) is averaged per pin,
+ * scaled (divider ratio, sense offset / gain) and published. Consumers never
+ * start a conversion: PowerDriveHandler peeks the latest frame, FaultGuard
+ * subscribes and checks every frame as it lands.
+ */
+class AdcService : public rtos::Task<AdcService>
+{
+public:
+    /// @brief ADC stream type (one frame → one PowerBus publish).
+    using Stream = AdcStream<cfg::adc::FRAME_SAMPLES>;
+
+    /**
+     * @brief Construct with pin mapping (no hardware access).
+     *
+     * @param bus Power bus to publish on (non-owning).
+     * @param vbus_pin ADC1 pin on the Vbus divider (-1 → none).
+     * @param current_pin ADC1 pin on the current-sense output (-1 → none).
+     */
+    explicit AdcService(PowerBus &bus, int vbus_pin = cfg::adc::VBUS_PIN, int current_pin = cfg::adc::CURRENT_PIN) noexcept
+        : bus_(&bus), vbus_pin_(vbus_pin), current_pin_(current_pin) {}
+
+    /**
+     * @brief Claim the pins and start the DMA stream.
+     *
+     * @return true If at least one pin is being sampled.
+     */
+    bool begin() noexcept;
+
+    /// @brief Frame (and publish) period (µs; 0 before begin()).
+    [[nodiscard]] uint32_t periodUs() const noexcept { return stream_.frameUs(); }
+
+    /// @brief Frames read since begin().
+    [[nodiscard]] uint32_t frames() const noexcept { return frames_; }
+
+private:
+    friend class rtos::Task<AdcService>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Power; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    static constexpr uint32_t kReadTimeoutMs = 20; ///< Longer than any frame: timing out means the stream stalled.
+
+    PowerBus *bus_{nullptr}; ///< Non-owning power bus.
+    int vbus_pin_{-1};       ///< Vbus ADC pin.
+    int current_pin_{-1};    ///< Current-sense ADC pin.
+    int vbus_slot_{-1};      ///< Stream slot for Vbus (-1 → none).
+    int amps_slot_{-1};      ///< Stream slot for current (-1 → none).
+    Stream stream_{};        ///< ADC1 DMA stream.
+    uint32_t frames_{0};     ///< Frames read.
+};
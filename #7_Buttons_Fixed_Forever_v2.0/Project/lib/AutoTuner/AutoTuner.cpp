@@ -0,0 +1,343 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of AutoTuner (NVS run state, trial windows, greedy plan selection).
+ *
+ * @file AutoTuner.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "AutoTuner.h"
+#include <cstring>
+#include <esp_ota_ops.h>
+#include <esp_system.h>
+#include <LatencyTrace.h>
+#include <nvs.h>
+#include <ProfileBus.h>
+
+namespace
+{
+    constexpr uint32_t kMagic = 0x314E5554; ///< "TUN1".
+    constexpr uint16_t kVersion = 1;        ///< Record layout version.
+    constexpr const char *kNamespace = "tune";
+    constexpr const char *kKey = "rec";
+
+    /// @brief Stages a placement can speed up or slow down (input → control → motor).
+    constexpr trace::Stage kStages[] = {trace::Stage::ControlButton, trace::Stage::ControlRc, trace::Stage::MotorButton,
+                                        trace::Stage::MotorRc};
+
+    /// @brief Move names, by (trial - 1) % kMoves.
+    constexpr const char *kMoveNames[tune::kMoves] = {"other core", "priority +1", "priority -1"};
+
+    constexpr const char *kStateNames[] = {"idle", "running", "done"};
+
+    static_assert(!cfg::tune::ENABLED || cfg::profiler::ENABLED, "The tuner scores plans from the profiler's loop statistics.");
+    static_assert(tune::kTrials <= 0xFF, "Trial index is a uint8_t.");
+    static_assert(tune::kTasks <= 8, "Node masks are a uint8_t.");
+
+    /// @brief FNV-1a over the names of the tunable nodes declared in this build.
+    uint32_t layoutOf(const std::array<bool, tune::kTasks> &present) noexcept
+    {
+        uint32_t h = 2166136261u;
+        for (std::size_t i = 0; i < tune::kTasks; ++i)
+        {
+            if (!present[i])
+                continue;
+            for (const char *c = tune::kTaskNames[i]; *c != '\0'; ++c)
+                h = (h ^ static_cast<uint8_t>(*c)) * 16777619u;
+            h = (h ^ 0u) * 16777619u;
+        }
+        return h;
+    }
+
+    /// @brief Score the window between two profiler samples plus the latency recorded since reset().
+    tune::Score measure(const ProfileSnapshot &from, const ProfileSnapshot &to) noexcept
+    {
+        tune::Score s{};
+        for (uint8_t i = 0; i < to.count; ++i)
+        {
+            const TaskProfile &t = to.tasks[i];
+            if (!t.has_loop)
+                continue;
+            uint32_t before = 0;
+            for (uint8_t j = 0; j < from.count; ++j)
+                if (strcmp(from.tasks[j].name, t.name) == 0)
+                    before = from.tasks[j].loop.overruns;
+            if (t.loop.overruns >= before)
+                s.misses += t.loop.overruns - before; ///< Lower → statistics were reset mid-window: not counted.
+        }
+
+        for (const trace::Stage st : kStages)
+        {
+            const trace::Summary l = trace::latency().summary(st);
+            if (l.count == 0)
+                continue;
+            s.samples += l.count;
+            if (l.p99_us > s.p99_us)
+                s.p99_us = l.p99_us;
+            if (l.mean_us > s.mean_us)
+                s.mean_us = l.mean_us;
+        }
+        return s;
+    }
+} // namespace
+
+// Load the saved plan / run progress.
+bool AutoTuner::begin() noexcept
+{
+    if constexpr (!cfg::tune::ENABLED)
+        return false;
+
+    nvs_handle_t h{};
+    if (nvs_open(kNamespace, NVS_READONLY, &h) != ESP_OK)
+        return false; ///< Namespace never written: nothing saved.
+
+    Record r{};
+    size_t len = sizeof(r);
+    const esp_err_t err = nvs_get_blob(h, kKey, &r, &len);
+    nvs_close(h);
+    if (err != ESP_OK || len != sizeof(r) || r.magic != kMagic || r.version != kVersion)
+        return false;
+
+    rec_ = r;
+    return true;
+}
+
+// Plan to apply this boot.
+const tune::Plan *AutoTuner::select(const std::array<bool, tune::kTasks> &present) noexcept
+{
+    if constexpr (!cfg::tune::ENABLED)
+        return nullptr;
+
+    layout_ = layoutOf(present);
+    const auto state = static_cast<tune::State>(rec_.state);
+    if (state == tune::State::Idle)
+        return nullptr;
+    if (rec_.layout != layout_)
+    {
+        logWarn("Tune: tunable tasks changed since the plan was made, dropped ('tune start' to re-tune).");
+        clear();
+        return nullptr;
+    }
+
+    if (state == tune::State::Done)
+        plan_ = rec_.best;
+    else
+    {
+        plan_ = rec_.trials[rec_.trial].plan; ///< Trial 0 is all kGraphCore / no bump: the graph's own plan.
+        logInfo("Tune: trial %u of %u on this boot.", static_cast<unsigned>(rec_.trial), static_cast<unsigned>(tune::kTrials - 1));
+    }
+    return &plan_;
+}
+
+// Record node i's graph-assigned placement.
+void AutoTuner::note(std::size_t i, int core, UBaseType_t level, bool pinned) noexcept
+{
+    rec_.present |= static_cast<uint8_t>(1U << i);
+    if (!pinned)
+        rec_.movable |= static_cast<uint8_t>(1U << i);
+    rec_.core[i] = static_cast<int8_t>(core);
+    rec_.level[i] = static_cast<uint8_t>(level);
+}
+
+// Plan for trial t.
+bool AutoTuner::candidate(std::size_t t, tune::Plan &out) const noexcept
+{
+    if (t == 0 || t >= tune::kTrials)
+        return false;
+    const std::size_t i = (t - 1) / tune::kMoves;
+    const uint8_t bit = static_cast<uint8_t>(1U << i);
+    if ((rec_.present & bit) == 0)
+        return false; ///< Not in this build.
+
+    out = rec_.best;
+    tune::Placement &p = out[i];
+    const int level = static_cast<int>(rec_.level[i]) + p.bump;
+    switch ((t - 1) % tune::kMoves)
+    {
+    case 0:
+    {
+        if ((rec_.movable & bit) == 0)
+            return false; ///< Pinned in the declaration for a reason given there.
+        const int now = (p.core != tune::kGraphCore) ? p.core : rec_.core[i];
+        const int other = (now == 0) ? 1 : 0;
+        p.core = (other == rec_.core[i]) ? tune::kGraphCore : static_cast<int8_t>(other);
+        return true;
+    }
+    case 1:
+        if (level + 1 > static_cast<int>(cfg::graph::MAX_PRI))
+            return false;
+        ++p.bump;
+        return true;
+    default:
+        if (level - 1 <= static_cast<int>(cfg::graph::BASE_PRI))
+            return false; ///< Timed tasks stay above background.
+        --p.bump;
+        return true;
+    }
+}
+
+// True if a beats b.
+bool AutoTuner::better(const tune::Score &a, const tune::Score &b) noexcept
+{
+    if (a.misses != b.misses)
+        return a.misses < b.misses;
+    if (a.samples == 0 || b.samples == 0)
+        return false; ///< No inputs in one of the windows: latency can't decide.
+    if (a.p99_us != b.p99_us)
+        return a.p99_us < b.p99_us;
+    return uint64_t{a.mean_us} * 100U < uint64_t{b.mean_us} * (100U - cfg::tune::MIN_GAIN_PCT);
+}
+
+// Main run loop.
+void AutoTuner::run() noexcept
+{
+    if (hold_ != nullptr)
+        hold_(true); ///< A parked drive loop has no periods to overrun.
+    vTaskDelay(to_ticks_ms(cfg::tune::SETTLE_MS));
+
+    static ProfileSnapshot from{}; ///< Two whole snapshots: off the task stack.
+    static ProfileSnapshot to{};
+    from = buses::profile().peek();
+    trace::latency().reset();
+    vTaskDelay(to_ticks_ms(cfg::tune::TRIAL_MS));
+    to = buses::profile().peek();
+    const tune::Score s = measure(from, to);
+    if (hold_ != nullptr)
+        hold_(false);
+
+    const uint8_t t = rec_.trial;
+    tune::Trial &tr = rec_.trials[t];
+    tr.plan = plan_;
+    tr.score = s;
+    tr.ran = 1;
+    if (t == 0 || better(s, rec_.trials[rec_.best_trial].score))
+    {
+        rec_.best = plan_;
+        rec_.best_trial = t;
+        tr.kept = 1;
+    }
+    logInfo("Tune: trial %u  misses %u  p99 %u us  mean %u us  (%u samples)%s", static_cast<unsigned>(t),
+            static_cast<unsigned>(s.misses), static_cast<unsigned>(s.p99_us), static_cast<unsigned>(s.mean_us),
+            static_cast<unsigned>(s.samples), tr.kept ? "  best so far" : "");
+
+    std::size_t next = t + 1U;
+    tune::Plan plan{};
+    while (next < tune::kTrials && !candidate(next, plan))
+        ++next;
+
+    if (next < tune::kTrials)
+    {
+        rec_.trial = static_cast<uint8_t>(next);
+        rec_.trials[next].plan = plan;
+    }
+    else
+        rec_.state = static_cast<uint8_t>(tune::State::Done);
+
+    if (!save())
+    {
+        logError("Tune: NVS write failed, run abandoned.");
+        vTaskDelete(nullptr);
+    }
+    if (rec_.state == static_cast<uint8_t>(tune::State::Done))
+    {
+        report();
+        if (rec_.best_trial == t)
+            vTaskDelete(nullptr); ///< Already running the winner.
+    }
+    restart();
+}
+
+// Start a tuning run.
+bool AutoTuner::start() noexcept
+{
+    if constexpr (!cfg::tune::ENABLED)
+        return false;
+
+    esp_ota_img_states_t img{};
+    if (esp_ota_get_state_partition(esp_ota_get_running_partition(), &img) == ESP_OK && img == ESP_OTA_IMG_PENDING_VERIFY)
+    {
+        logWarn("Tune: OTA image not confirmed yet (a restart now rolls it back).");
+        return false;
+    }
+
+    rec_ = Record{};
+    rec_.magic = kMagic;
+    rec_.version = kVersion;
+    rec_.state = static_cast<uint8_t>(tune::State::Running);
+    rec_.layout = layout_;
+    if (!save())
+    {
+        logError("Tune: NVS write failed.");
+        rec_ = Record{};
+        return false;
+    }
+    logInfo("Tune: %u trials of %u ms, one restart each (keep inputs coming, wheels off the ground).",
+            static_cast<unsigned>(tune::kTrials), static_cast<unsigned>(cfg::tune::SETTLE_MS + cfg::tune::TRIAL_MS));
+    restart();
+}
+
+// Drop the saved plan and any run in progress.
+void AutoTuner::clear() noexcept
+{
+    rec_ = Record{};
+    nvs_handle_t h{};
+    if (nvs_open(kNamespace, NVS_READWRITE, &h) != ESP_OK)
+        return;
+    nvs_erase_key(h, kKey);
+    nvs_commit(h);
+    nvs_close(h);
+}
+
+// Print the run state, trials and saved plan.
+void AutoTuner::report() const noexcept
+{
+    debugfln("Tune: %s", kStateNames[rec_.state < 3 ? rec_.state : 0]);
+    if (rec_.state == static_cast<uint8_t>(tune::State::Idle))
+        return;
+
+    debugln("  trial  node          move          misses  p99<= us  mean us  samples");
+    for (std::size_t t = 0; t < tune::kTrials; ++t)
+    {
+        const tune::Trial &tr = rec_.trials[t];
+        if (!tr.ran)
+            continue;
+        debugfln("  %5u  %-12s  %-12s  %6u  %8u  %7u  %7u%s", static_cast<unsigned>(t),
+                 (t == 0) ? "-" : tune::kTaskNames[(t - 1) / tune::kMoves], (t == 0) ? "baseline" : kMoveNames[(t - 1) % tune::kMoves],
+                 static_cast<unsigned>(tr.score.misses), static_cast<unsigned>(tr.score.p99_us),
+                 static_cast<unsigned>(tr.score.mean_us), static_cast<unsigned>(tr.score.samples), tr.kept ? "  kept" : "");
+    }
+
+    debugfln("  best: trial %u", static_cast<unsigned>(rec_.best_trial));
+    for (std::size_t i = 0; i < tune::kTasks; ++i)
+    {
+        if ((rec_.present & (1U << i)) == 0)
+            continue;
+        const tune::Placement &p = rec_.best[i];
+        debugfln("    %-12s core %d  priority %d (%+d)", tune::kTaskNames[i], (p.core != tune::kGraphCore) ? p.core : rec_.core[i],
+                 static_cast<int>(rec_.level[i]) + p.bump, static_cast<int>(p.bump));
+    }
+}
+
+// Write the record to NVS.
+bool AutoTuner::save() const noexcept
+{
+    nvs_handle_t h{};
+    if (nvs_open(kNamespace, NVS_READWRITE, &h) != ESP_OK)
+        return false;
+    const bool ok = nvs_set_blob(h, kKey, &rec_, sizeof(rec_)) == ESP_OK && nvs_commit(h) == ESP_OK;
+    nvs_close(h);
+    return ok;
+}
+
+// Wait for the restart gate, then restart.
+void AutoTuner::restart() const noexcept
+{
+    while (idle_ != nullptr && !idle_())
+        vTaskDelay(to_ticks_ms(100)); ///< Never restart under power.
+    logInfo("Tune: restarting.");
+    vTaskDelay(to_ticks_ms(50)); ///< Let the log drain.
+    esp_restart();
+}
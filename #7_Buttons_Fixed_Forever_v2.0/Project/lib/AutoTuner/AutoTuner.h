@@ -0,0 +1,240 @@
+/**
+ * MIT License
+ *
+ * @brief Core / priority auto-tuner for the critical task graph, driven by measured overruns and latency.
+ *
+ * @file AutoTuner.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <TaskGraph.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tune
+{
+    static constexpr std::size_t kTasks = 4;                    ///< Tunable nodes.
+    static constexpr std::size_t kMoves = 3;                    ///< Per node: other core, one level up, one level down.
+    static constexpr std::size_t kTrials = 1 + kTasks * kMoves; ///< Baseline + every move once.
+    static constexpr int8_t kGraphCore = -1;                    ///< Placement::core: leave it to the graph.
+
+    /// @brief Tunable critical-graph nodes (by node name; absent ones are skipped).
+    inline constexpr const char *kTaskNames[kTasks] = {"StateManager", "RcPub", "ControlCore", "PDHandler"};
+
+    /// @brief One node's correction on top of the graph's own plan.
+    struct Placement
+    {
+        int8_t core{kGraphCore}; ///< Core override (kGraphCore → as declared / placed).
+        int8_t bump{0};          ///< Priority levels added (TaskGraph::Node::bump()).
+    };
+
+    /// @brief Corrections for every tunable node (kTaskNames order).
+    using Plan = std::array<Placement, kTasks>;
+
+    /// @brief One trial window's measurements (lower is better, misses first).
+    struct Score
+    {
+        uint32_t misses{0};  ///< Loop overruns + missed wakeups over the window, every watched periodic task.
+        uint32_t p99_us{0};  ///< Worst p99 over the control / motor latency stages (bucket bound, µs).
+        uint32_t mean_us{0}; ///< Worst mean over the same stages (µs).
+        uint32_t samples{0}; ///< Latency samples behind p99 / mean (0 → latency not compared).
+    };
+
+    /// @brief Progress of a tuning run.
+    enum class State : uint8_t
+    {
+        Idle = 0, ///< Nothing saved: the graph's own plan.
+        Running,  ///< A trial is measured on this boot.
+        Done      ///< Best plan saved and applied at every boot.
+    };
+
+    /// @brief One trial's result.
+    struct Trial
+    {
+        Plan plan{};      ///< Plan measured.
+        Score score{};    ///< What it scored.
+        uint8_t ran{0};   ///< 1 → measured (0 → move not applicable, skipped).
+        uint8_t kept{0};  ///< 1 → became the best plan.
+        uint8_t pad[2]{}; ///< Zero.
+    };
+} ///< Namespace tune.
+
+/**
+ * @brief Tries core and priority corrections for the critical tasks and keeps the best.
+ *
+ * The graph's deadline-monotonic priorities and greedy core placement come
+ * from declared budgets; this measures them. 'tune start' runs a greedy
+ * coordinate descent over kTaskNames: the graph's own plan first, then for
+ * each node in turn the other core (graph-placed nodes only; a pin() in the
+ * declaration is kept), one priority level up and one down, each measured for
+ * cfg::tune::TRIAL_MS and kept when it beats the best so far. A plan wins on
+ * fewer loop overruns (every periodic task the profiler watches), then a lower
+ * p99 latency bucket on the edge / RC → control / motor stages, then a mean
+ * latency lower by MIN_GAIN_PCT. The winner is saved to NVS and applied on
+ * every boot before the critical graph is created; 'tune clear' drops it.
+ *
+ * IDF FreeRTOS cannot move a created task to the other core, so each trial is
+ * one boot: the run's progress lives in NVS, apply() shapes the graph for the
+ * trial due, the tuner task measures it and restarts the chip (at zero duty
+ * only, see restartWhen()). A saved plan or a run in progress is dropped when
+ * the set of tunable nodes in this build changes.
+ *
+ * @note The drive loop is kept awake for the window (holdWith()); the control
+ *       latency only counts if inputs arrive, so keep the transmitter on (or
+ *       press buttons) during a run, with the wheels off the ground. Without
+ *       inputs the plans are compared on overruns alone.
+ */
+class AutoTuner : public rtos::Task<AutoTuner>
+{
+public:
+    using HoldFn = void (*)(bool on); ///< Keep the drive loop running (true) for the window.
+    using IdleFn = bool (*)();        ///< True when the chip may restart (e.g. duty is 0).
+
+    /**
+     * @brief Load the saved plan / run progress (call once from setup(), before apply()).
+     *
+     * @return true If NVS holds a valid record.
+     */
+    bool begin() noexcept;
+
+    /**
+     * @brief Shape @p graph with the trial due or the saved plan (before create()).
+     *
+     * @tparam Graph rtos::TaskGraph instantiation.
+     * @param graph Critical graph, every node declared.
+     */
+    template <typename Graph>
+    void apply(Graph &graph) noexcept
+    {
+        std::array<bool, tune::kTasks> present{};
+        for (std::size_t i = 0; i < tune::kTasks; ++i)
+            present[i] = graph.find(tune::kTaskNames[i]) != nullptr;
+
+        const tune::Plan *plan = select(present);
+        if (plan == nullptr)
+            return;
+        for (std::size_t i = 0; i < tune::kTasks; ++i)
+        {
+            auto *n = graph.find(tune::kTaskNames[i]);
+            if (n == nullptr)
+                continue;
+            if ((*plan)[i].core != tune::kGraphCore)
+                n->pin((*plan)[i].core);
+            if ((*plan)[i].bump != 0)
+                n->bump((*plan)[i].bump);
+        }
+    }
+
+    /**
+     * @brief Record the graph's own plan on the baseline trial (after create()).
+     *
+     * @tparam Graph rtos::TaskGraph instantiation.
+     * @param graph Created critical graph.
+     */
+    template <typename Graph>
+    void observe(const Graph &graph) noexcept
+    {
+        if (!baseline())
+            return;
+        for (std::size_t i = 0; i < tune::kTasks; ++i)
+        {
+            const auto *n = graph.find(tune::kTaskNames[i]);
+            if (n != nullptr)
+                note(i, n->core(), n->level(), n->pinned());
+        }
+    }
+
+    /// @brief Keep the drive loop awake during a window (@p hold(true) / hold(false)).
+    void holdWith(HoldFn hold) noexcept { hold_ = hold; }
+
+    /// @brief Restart for the next trial only while @p idle holds (checked every 100 ms).
+    void restartWhen(IdleFn idle) noexcept { idle_ = idle; }
+
+    /**
+     * @brief Start a tuning run (restarts the chip into the baseline trial).
+     *
+     * @return true If started (false → disabled, OTA image awaiting confirmation, or NVS failed).
+     */
+    bool start() noexcept;
+
+    /// @brief Drop the saved plan and any run in progress (takes effect at the next boot).
+    void clear() noexcept;
+
+    /// @brief True if this boot measures a trial (add the task to the services graph).
+    [[nodiscard]] bool running() const noexcept { return rec_.state == static_cast<uint8_t>(tune::State::Running); }
+
+    /// @brief Print the run state, every measured trial and the saved plan.
+    void report() const noexcept;
+
+private:
+    friend class rtos::Task<AutoTuner>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Tune; ///< Filter for this class's log* sites.
+
+    /// @brief NVS record (kept whole in RAM).
+    struct Record
+    {
+        uint32_t magic{0};                               ///< kMagic.
+        uint16_t version{0};                             ///< kVersion.
+        uint8_t state{0};                                ///< tune::State.
+        uint8_t trial{0};                                ///< Trial due / being measured.
+        uint32_t layout{0};                              ///< Hash of the tunable nodes present.
+        uint8_t present{0};                              ///< Bit i: node i is declared in this build.
+        uint8_t movable{0};                              ///< Bit i: node i was placed by the graph (core may move).
+        uint8_t best_trial{0};                           ///< Trial whose plan is best.
+        uint8_t pad{0};                                  ///< Zero.
+        std::array<int8_t, tune::kTasks> core{};         ///< Graph-assigned core per node (baseline).
+        std::array<uint8_t, tune::kTasks> level{};       ///< Graph-assigned priority per node (baseline).
+        tune::Plan best{};                               ///< Best plan so far / saved.
+        std::array<tune::Trial, tune::kTrials> trials{}; ///< Per-trial results.
+    };
+
+    /// @brief Main run loop: one trial window, then the restart.
+    void run() noexcept;
+
+    /**
+     * @brief Plan to apply this boot (validates the record against the nodes present).
+     *
+     * @param present Tunable node i is declared.
+     * @return const tune::Plan* Plan, or nullptr to leave the graph as declared.
+     */
+    const tune::Plan *select(const std::array<bool, tune::kTasks> &present) noexcept;
+
+    /// @brief True on the baseline trial of a run.
+    [[nodiscard]] bool baseline() const noexcept { return running() && rec_.trial == 0; }
+
+    /// @brief Record node @p i's graph-assigned placement.
+    void note(std::size_t i, int core, UBaseType_t level, bool pinned) noexcept;
+
+    /**
+     * @brief Plan for trial @p t (the best plan with that trial's move).
+     *
+     * @param t Trial index (≥ 1).
+     * @param out Plan.
+     * @return true If the move applies (node present, other core allowed, level inside the band).
+     */
+    bool candidate(std::size_t t, tune::Plan &out) const noexcept;
+
+    /// @brief True if @p a beats @p b.
+    static bool better(const tune::Score &a, const tune::Score &b) noexcept;
+
+    /// @brief Write rec_ to NVS.
+    bool save() const noexcept;
+
+    /// @brief Wait for restartWhen()'s gate, then restart the chip.
+    [[noreturn]] void restart() const noexcept;
+
+    // ---- Internal state ---- //
+    Record rec_{};         ///< Saved plan / run progress.
+    uint32_t layout_{0};   ///< Hash of the nodes present in this build.
+    tune::Plan plan_{};    ///< Plan applied this boot.
+    HoldFn hold_{nullptr}; ///< Drive loop keep-awake.
+    IdleFn idle_{nullptr}; ///< Restart gate.
+};
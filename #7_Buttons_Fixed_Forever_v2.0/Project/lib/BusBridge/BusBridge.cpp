@@ -0,0 +1,232 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of BusBridge (UART framing, dispatch, round-trip probes, link-loss handling).
+ *
+ * @file BusBridge.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "BusBridge.h"
+
+// Start the UART.
+void BusBridge::begin() noexcept
+{
+    port_->setRxBufferSize(cfg::bridge::RX_BUFFER); ///< Both must precede begin().
+    port_->setTxBufferSize(cfg::bridge::TX_BUFFER);
+    port_->begin(cfg::bridge::BAUD, SERIAL_8N1, cfg::bridge::RX_PIN, cfg::bridge::TX_PIN);
+
+    // One callback per burst: the task decodes a frame as soon as its last byte lands.
+    port_->setRxTimeout(cfg::bridge::RX_TIMEOUT_SYM);
+    port_->onReceive(
+        [this]()
+        {
+            TaskHandle_t t = task_.load(std::memory_order_acquire);
+            if (t != nullptr)
+                xTaskNotifyGive(t); ///< Runs in the UART event task, not an ISR.
+        },
+        /*onlyOnTimeout=*/true);
+}
+
+// Send a bus to the peer.
+bool BusBridge::add(Mirror &m) noexcept
+{
+    if (n_mirrors_ >= kMaxMirrors)
+        return false;
+    mirrors_[n_mirrors_++] = &m;
+    return true;
+}
+
+// Publish a peer bus here.
+bool BusBridge::add(Sink &s) noexcept
+{
+    if (n_sinks_ >= kMaxSinks)
+        return false;
+    sinks_[n_sinks_++] = &s;
+    return true;
+}
+
+// Frame and send one payload now.
+bool BusBridge::send(uint8_t schema, const void *payload, std::size_t len, bool key) noexcept
+{
+    uint8_t frame[telem::kMaxFrame];
+    const std::size_t n = telem::encodeFrame(schema, tx_seq_, payload, len, frame);
+    if (n == 0 || static_cast<std::size_t>(port_->availableForWrite()) < n)
+    {
+        count(stats_.tx_dropped);
+        return false; ///< Never wait on the UART; the peer sees no gap (seq not spent).
+    }
+
+    port_->write(frame, n);
+    ++tx_seq_;
+    ++stats_.tx_frames;
+    if (key)
+        ++stats_.tx_keys;
+    return true;
+}
+
+// Read and dispatch complete frames.
+void BusBridge::drain(uint64_t now) noexcept
+{
+    uint8_t buf[64];
+    for (int avail = port_->available(); avail > 0; avail = port_->available())
+    {
+        const std::size_t got = port_->read(buf, std::min<std::size_t>(sizeof(buf), static_cast<std::size_t>(avail)));
+        for (std::size_t i = 0; i < got; ++i)
+        {
+            const uint8_t b = buf[i];
+            if (b != 0x00)
+            {
+                if (rx_n_ < rx_.size())
+                    rx_[rx_n_++] = b;
+                else
+                    rx_skip_ = true; ///< Overlong: line noise or a lost delimiter.
+                continue;
+            }
+
+            // Delimiter: one frame complete.
+            telem::Frame f{};
+            if (rx_skip_ || (rx_n_ > 0 && !telem::decodeFrame(rx_.data(), rx_n_, f)))
+                count(stats_.rx_bad);
+            else if (rx_n_ > 0)
+                dispatch(f, now);
+            rx_n_ = 0;
+            rx_skip_ = false;
+        }
+    }
+}
+
+// Handle one decoded frame.
+void BusBridge::dispatch(const telem::Frame &f, uint64_t now) noexcept
+{
+    if (has_rx_seq_)
+        stats_.rx_lost += static_cast<uint8_t>(f.seq - rx_seq_ - 1); ///< Wraps with the sender's counter.
+    has_rx_seq_ = true;
+    rx_seq_ = f.seq;
+    ++stats_.rx_frames;
+    rx_us_ = now;
+    if (!stats_.up)
+    {
+        stats_.up = true; ///< Link (back) up.
+        dirty_ = true;
+    }
+
+    if (f.schema == bridge::kPing)
+    {
+        if (f.len != sizeof(uint64_t))
+        {
+            count(stats_.rx_bad);
+            return;
+        }
+        uint8_t p[2 * sizeof(uint64_t)];
+        memcpy(p, f.payload, sizeof(uint64_t)); ///< Echo t0.
+        const uint64_t t1 = now_us();
+        memcpy(p + sizeof(uint64_t), &t1, sizeof(t1));
+        send(bridge::kPong, p, sizeof(p));
+        return;
+    }
+    if (f.schema == bridge::kPong)
+    {
+        pong(f.payload, f.len, now);
+        return;
+    }
+
+    for (std::size_t i = 0; i < n_sinks_; ++i)
+        if (sinks_[i]->id() == f.schema)
+        {
+            sinks_[i]->receive(*this, f.payload, f.len);
+            return;
+        }
+    // A topic nobody here takes: the peer mirrors more than we sink. Not an error.
+}
+
+// Pong: round trip and clock offset.
+void BusBridge::pong(const uint8_t *p, std::size_t n, uint64_t now) noexcept
+{
+    if (n != 2 * sizeof(uint64_t))
+    {
+        count(stats_.rx_bad);
+        return;
+    }
+    uint64_t t0 = 0;
+    uint64_t t1 = 0;
+    memcpy(&t0, p, sizeof(t0));
+    memcpy(&t1, p + sizeof(t0), sizeof(t1));
+    if (t0 > now)
+    {
+        count(stats_.rx_bad); ///< Not one of our probes.
+        return;
+    }
+
+    const uint64_t rtt64 = now - t0;
+    const uint32_t rtt = rtt64 > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(rtt64);
+    stats_.rtt_us = rtt;
+    if (stats_.rtt_min_us == 0 || rtt < stats_.rtt_min_us)
+        stats_.rtt_min_us = rtt;
+    if (rtt > stats_.rtt_max_us)
+        stats_.rtt_max_us = rtt;
+
+    // Peer stamped t1 half a round trip before we saw it (symmetric link); the fastest
+    // round trip in a window had the least queueing in it, so its offset wins.
+    const int64_t offset = static_cast<int64_t>(t1) - static_cast<int64_t>(t0 + rtt64 / 2);
+    if (rtt < win_rtt_)
+    {
+        win_rtt_ = rtt;
+        win_offset_ = offset;
+    }
+    if (!has_offset_ || ++win_n_ >= kOffsetWindow)
+    {
+        stats_.offset_us = win_offset_;
+        has_offset_ = true;
+        win_n_ = 0;
+        win_rtt_ = UINT32_MAX;
+    }
+    dirty_ = true;
+}
+
+// Main run loop.
+void BusBridge::run() noexcept
+{
+    for (std::size_t i = 0; i < n_mirrors_; ++i)
+        mirrors_[i]->attach(); ///< Subscriptions belong to this task.
+    task_.store(xTaskGetCurrentTaskHandle(), std::memory_order_release); ///< RX callback target.
+
+    for (;;)
+    {
+        bool any = port_->available() > 0;
+        for (std::size_t i = 0; i < n_mirrors_ && !any; ++i)
+            any = mirrors_[i]->fresh();
+        if (!any)
+            ulTaskNotifyTake(pdTRUE, idle_ticks_); ///< A mirrored publish, a received burst, or the next probe.
+
+        const uint64_t now = now_us();
+        drain(now);
+
+        for (std::size_t i = 0; i < n_mirrors_; ++i)
+            mirrors_[i]->poll(*this, now);
+
+        if (now - ping_at_us_ >= ping_us_)
+        {
+            send(bridge::kPing, &now, sizeof(now));
+            ping_at_us_ = now;
+        }
+
+        if (stats_.up && now - rx_us_ > timeout_us_)
+        {
+            stats_.up = false; ///< Link lost: inbound buses fall back once, until a frame arrives again.
+            ++stats_.link_losses;
+            has_rx_seq_ = false;
+            dirty_ = true;
+            for (std::size_t i = 0; i < n_sinks_; ++i)
+                sinks_[i]->lost();
+        }
+
+        if (dirty_)
+        {
+            pub_.publish(stats_);
+            dirty_ = false;
+        }
+    }
+}
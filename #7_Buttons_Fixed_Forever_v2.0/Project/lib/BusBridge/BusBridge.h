@@ -0,0 +1,448 @@
+/**
+ * MIT License
+ *
+ * @brief Bus bridge: SignalBus topics mirrored between two boards over a UART (key + delta frames).
+ *
+ * @file BusBridge.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <Arduino.h>
+#include <RtosTask.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+#include <BusSchema.h>
+#include <TelemetryStream/TelemetryStream.h>
+
+namespace bridge
+{
+    // ---- Wire format ---- //
+    //
+    // Every frame is a telem frame (COBS + CRC-16, telem::encodeFrame()); the frame seq is one
+    // counter per link, so the receiver counts every lost frame whatever topic it carried.
+    //
+    // schema = wire::Fields<T>::kId   topic frame:
+    //   key    kKey:u8   key:u8 hash:u32 packed[Codec::kBytes]
+    //   delta  kDelta:u8 key:u8 mask[(kBytes + 7) / 8] changed bytes (mask bit set, in order)
+    // schema = kPing                  t0:u64 (sender's clock)
+    // schema = kPong                  t0:u64 (echoed) t1:u64 (replier's clock)
+    //
+    // A delta is taken against the last key, not the last delta: a lost delta costs one update,
+    // never a corrupted value. A delta no smaller than a key goes out as a new key instead.
+    // hash (wire::Codec::kHash) catches two boards flashed with different field tables.
+
+    static constexpr uint8_t kPing = 0xF0; ///< Round-trip probe.
+    static constexpr uint8_t kPong = 0xF1; ///< Probe reply.
+    static constexpr uint8_t kKey = 0;     ///< Topic frame: full packed value.
+    static constexpr uint8_t kDelta = 1;   ///< Topic frame: bytes changed since the key.
+
+    /// @brief Link statistics (published on BusBridge::stats() after every pong and link change).
+    struct Stats
+    {
+        uint32_t tx_frames{0};   ///< Frames written.
+        uint32_t tx_dropped{0};  ///< Frames dropped for lack of TX room.
+        uint32_t tx_keys{0};     ///< ...of which keys.
+        uint32_t rx_frames{0};   ///< Good frames received.
+        uint32_t rx_lost{0};     ///< Frames missing (link seq gaps).
+        uint32_t rx_bad{0};      ///< Frames failing COBS / length / CRC, or overlong.
+        uint32_t rx_stale{0};    ///< Deltas whose key never arrived (dropped until the next key).
+        uint32_t rx_mismatch{0}; ///< Keys whose field-table hash differs from ours (topic ignored).
+        uint32_t rtt_us{0};      ///< Last round trip (µs; one-way latency ≈ rtt / 2).
+        uint32_t rtt_min_us{0};  ///< Shortest round trip.
+        uint32_t rtt_max_us{0};  ///< Longest round trip.
+        int64_t offset_us{0};    ///< Peer clock - our clock (µs; from the fastest recent round trip).
+        uint32_t link_losses{0}; ///< Times the link went silent for cfg::bridge::LINK_TIMEOUT_MS.
+        bool up{false};          ///< A frame arrived within the link timeout.
+    };
+} ///< Namespace bridge.
+
+/**
+ * @brief Mirrors chosen buses to a second board and publishes the peer's buses here.
+ *
+ * The same task runs on both boards. Outbound, each Mirror subscribes to a
+ * local bus and sends its packed wire::Codec layout: a key frame, then
+ * deltas against that key until cfg::bridge::KEY_MS passes or a delta would
+ * be no smaller. Inbound, each Sink rebuilds the value and publishes it on
+ * a local bus, so consumers on the far board (PowerDriveHandler reading
+ * ControlBus) cannot tell the producer is on the other side of a cable.
+ *
+ * The task sleeps until a mirrored bus publishes or the UART reports the end
+ * of a burst (RX timeout), so a frame is forwarded or published as soon as
+ * it exists. Writes never wait: a full TX ring drops the frame (counted; the
+ * next delta still carries the change, since deltas are key-relative).
+ *
+ * Pings every cfg::bridge::PING_MS measure the round trip and the peer's clock
+ * offset. A Sink may restamp origin stamps into the local clock, so latency
+ * traces on the far board still measure from the physical event. If nothing
+ * arrives for cfg::bridge::LINK_TIMEOUT_MS, every Sink with a safe() hook
+ * publishes its safe value once (ControlBus: stop), until the link returns.
+ *
+ * @note Values cross in their packed layout: real_t commands at 0.01 resolution, as the field tables define.
+ */
+class BusBridge : public rtos::Task<BusBridge>
+{
+public:
+    static constexpr std::size_t kMaxMirrors = 4; ///< Outbound buses.
+    static constexpr std::size_t kMaxSinks = 4;   ///< Inbound buses.
+
+    /**
+     * @brief One outbound bus (type-erased so the bridge can hold a mixed list).
+     */
+    class Mirror
+    {
+    public:
+        virtual ~Mirror() = default;
+
+        /// @brief Subscribe from the bridge task.
+        virtual void attach() noexcept = 0;
+
+        /// @brief True if the bus published since the last poll().
+        [[nodiscard]] virtual bool fresh() const noexcept = 0;
+
+        /**
+         * @brief Send the newest value if it is new, or re-send the key if it is due.
+         *
+         * @param link Bridge to send on.
+         * @param now Current time (µs).
+         */
+        virtual void poll(BusBridge &link, uint64_t now) noexcept = 0;
+    };
+
+    /**
+     * @brief One inbound bus.
+     */
+    class Sink
+    {
+    public:
+        virtual ~Sink() = default;
+
+        /// @brief Topic id (wire::Fields<T>::kId) this sink takes.
+        [[nodiscard]] virtual uint8_t id() const noexcept = 0;
+
+        /**
+         * @brief Apply one topic frame and publish the result.
+         *
+         * @param link Bridge (clock offset, counters).
+         * @param p Payload.
+         * @param n Payload length.
+         */
+        virtual void receive(BusBridge &link, const uint8_t *p, std::size_t n) noexcept = 0;
+
+        /// @brief The link went silent: publish the safe value (if any).
+        virtual void lost() noexcept = 0;
+    };
+
+    /**
+     * @brief Outbound mirror of a SignalBus / ViewBus.
+     *
+     * @tparam Bus Bus type; Bus::value_type needs a wire::Fields specialisation.
+     */
+    template <typename Bus>
+    class BusMirror final : public Mirror
+    {
+    public:
+        using T = typename Bus::value_type;
+        using Codec = wire::Codec<T>;
+        static constexpr std::size_t kMask = (Codec::kBytes + 7) / 8; ///< Delta mask bytes.
+        static_assert(6 + Codec::kBytes <= telem::kMaxPayload, "Packed payload too large for one bridge frame.");
+
+        /// @brief Mirror @p bus (non-owning).
+        explicit BusMirror(Bus &bus) noexcept : bus_(&bus) {}
+
+        void attach() noexcept override { sub_ = bus_->subscribe(); }
+
+        [[nodiscard]] bool fresh() const noexcept override { return sub_.fresh(); }
+
+        void poll(BusBridge &link, uint64_t now) noexcept override
+        {
+            T v{};
+            const bool got = sub_.take(v);
+            if (got)
+            {
+                Codec::encode(v, cur_);
+                has_value_ = true;
+            }
+            if (!has_value_)
+                return; ///< Nothing published yet.
+
+            if (!has_key_ || now - key_us_ >= link.keyUs())
+            {
+                sendKey(link, now); ///< Due (also when idle: a late-joining peer needs a key).
+                return;
+            }
+            if (!got)
+                return;
+
+            // Delta against the key: mask, then every byte that differs.
+            uint8_t p[2 + kMask + Codec::kBytes];
+            p[0] = bridge::kDelta;
+            p[1] = key_;
+            uint8_t *mask = p + 2;
+            memset(mask, 0, kMask);
+            std::size_t n = 2 + kMask;
+            for (std::size_t i = 0; i < Codec::kBytes; ++i)
+                if (cur_[i] != ref_[i])
+                {
+                    mask[i / 8] |= static_cast<uint8_t>(1U << (i % 8));
+                    p[n++] = cur_[i];
+                }
+            if (n >= 6 + Codec::kBytes)
+                sendKey(link, now); ///< Drifted too far from the key: re-key instead.
+            else
+                link.send(Codec::kId, p, n);
+        }
+
+    private:
+        /// @brief Send cur_ as a new key; it becomes the delta reference once it is on the wire.
+        void sendKey(BusBridge &link, uint64_t now) noexcept
+        {
+            uint8_t p[6 + Codec::kBytes];
+            p[0] = bridge::kKey;
+            p[1] = static_cast<uint8_t>(key_ + 1);
+            const uint32_t h = Codec::kHash;
+            memcpy(p + 2, &h, sizeof(h));
+            memcpy(p + 6, cur_, Codec::kBytes);
+            if (!link.send(Codec::kId, p, sizeof(p), /*key=*/true))
+                return; ///< Not sent: deltas stay on the old key, retried next poll.
+            memcpy(ref_, cur_, Codec::kBytes);
+            key_ = p[1];
+            key_us_ = now;
+            has_key_ = true;
+        }
+
+        Bus *bus_;                          ///< Non-owning bus.
+        snapshot::Subscription<Bus> sub_{}; ///< Bridge task's subscription.
+        uint8_t cur_[Codec::kBytes]{};      ///< Newest value (packed).
+        uint8_t ref_[Codec::kBytes]{};      ///< Last key sent (delta reference).
+        uint8_t key_{0};                    ///< Last key number.
+        bool has_value_{false};             ///< cur_ valid.
+        bool has_key_{false};               ///< ref_ valid.
+        uint64_t key_us_{0};                ///< When the last key went out.
+    };
+
+    /**
+     * @brief Inbound sink publishing the peer's bus on a local one (the bridge is its only writer).
+     *
+     * @tparam Bus Bus type; Bus::value_type needs a wire::Fields specialisation.
+     */
+    template <typename Bus>
+    class BusSink final : public Sink
+    {
+    public:
+        using T = typename Bus::value_type;
+        using Codec = wire::Codec<T>;
+        static constexpr std::size_t kMask = BusMirror<Bus>::kMask; ///< Delta mask bytes.
+
+        /// @brief Move the peer's stamps into the local clock (@p offset_us = peer - local).
+        using Restamp = void (*)(T &v, int64_t offset_us);
+
+        /// @brief Turn the last value into the one to hold while the link is down.
+        using Safe = void (*)(T &v);
+
+        /**
+         * @brief Publish into @p bus (non-owning).
+         *
+         * @param bus Local bus.
+         * @param restamp Stamp translation (nullptr → stamps stay in the peer's clock).
+         * @param safe Link-loss value (nullptr → the last value stands).
+         */
+        explicit BusSink(Bus &bus, Restamp restamp = nullptr, Safe safe = nullptr) noexcept
+            : bus_(&bus), restamp_(restamp), safe_(safe) {}
+
+        [[nodiscard]] uint8_t id() const noexcept override { return Codec::kId; }
+
+        void receive(BusBridge &link, const uint8_t *p, std::size_t n) noexcept override
+        {
+            if (n < 2)
+            {
+                link.count(link.stats_.rx_bad);
+                return;
+            }
+            if (p[0] == bridge::kKey)
+            {
+                uint32_t h = 0;
+                if (n != 6 + Codec::kBytes)
+                {
+                    link.count(link.stats_.rx_bad);
+                    return;
+                }
+                memcpy(&h, p + 2, sizeof(h));
+                if (h != Codec::kHash)
+                {
+                    link.count(link.stats_.rx_mismatch); ///< Other firmware's table: applying it would scramble fields.
+                    return;
+                }
+                memcpy(ref_, p + 6, Codec::kBytes);
+                key_ = p[1];
+                has_key_ = true;
+                publish(link, ref_);
+                return;
+            }
+
+            if (p[0] != bridge::kDelta || n < 2 + kMask)
+            {
+                link.count(link.stats_.rx_bad);
+                return;
+            }
+            if (!has_key_ || p[1] != key_)
+            {
+                link.count(link.stats_.rx_stale); ///< Its key was lost: wait for the next one.
+                return;
+            }
+            uint8_t cur[Codec::kBytes];
+            memcpy(cur, ref_, Codec::kBytes);
+            std::size_t at = 2 + kMask;
+            for (std::size_t i = 0; i < Codec::kBytes; ++i)
+                if (p[2 + i / 8] & (1U << (i % 8)))
+                {
+                    if (at >= n)
+                    {
+                        link.count(link.stats_.rx_bad);
+                        return;
+                    }
+                    cur[i] = p[at++];
+                }
+            publish(link, cur);
+        }
+
+        void lost() noexcept override
+        {
+            if (safe_ == nullptr || !has_value_)
+                return;
+            T v = last_;
+            safe_(v);
+            bus_->publish(v);
+        }
+
+    private:
+        /// @brief Decode, restamp and publish one packed value.
+        void publish(const BusBridge &link, const uint8_t *packed) noexcept
+        {
+            last_ = Codec::decode(packed);
+            has_value_ = true;
+            T v = last_;
+            if (restamp_ != nullptr)
+                restamp_(v, link.offsetUs());
+            bus_->publish(v);
+        }
+
+        Bus *bus_;                     ///< Non-owning bus.
+        Restamp restamp_;              ///< Stamp translation (optional).
+        Safe safe_;                    ///< Link-loss value (optional).
+        uint8_t ref_[Codec::kBytes]{}; ///< Last key received.
+        uint8_t key_{0};               ///< Its number.
+        bool has_key_{false};          ///< ref_ valid.
+        T last_{};                     ///< Last value as received (peer stamps).
+        bool has_value_{false};        ///< last_ valid.
+    };
+
+    /**
+     * @brief Construct for a UART.
+     *
+     * @param port UART to the peer (begun by begin()).
+     * @param key_ms Key refresh interval (ms).
+     * @param ping_ms Round-trip probe period (ms).
+     * @param timeout_ms Link-loss timeout (ms).
+     */
+    explicit BusBridge(HardwareSerial &port, uint32_t key_ms = cfg::bridge::KEY_MS, uint32_t ping_ms = cfg::bridge::PING_MS,
+                       uint32_t timeout_ms = cfg::bridge::LINK_TIMEOUT_MS) noexcept
+        : port_(&port), key_us_(1000ULL * key_ms), ping_us_(1000ULL * ping_ms), timeout_us_(1000ULL * timeout_ms),
+          idle_ticks_(to_ticks_ms(ping_ms) > 0 ? to_ticks_ms(ping_ms) : 1) {}
+
+    /// @brief Start the UART (both directions) and the burst-end callback.
+    void begin() noexcept;
+
+    /**
+     * @brief Send a bus to the peer (call before the task starts; @p m must outlive the bridge).
+     *
+     * @return true If there was a free slot.
+     */
+    bool add(Mirror &m) noexcept;
+
+    /**
+     * @brief Publish a peer bus here (call before the task starts; @p s must outlive the bridge).
+     *
+     * @return true If there was a free slot.
+     */
+    bool add(Sink &s) noexcept;
+
+    /**
+     * @brief Frame and send one payload now (non-blocking; bridge task).
+     *
+     * @param schema Schema id.
+     * @param payload Bytes.
+     * @param len Length (≤ telem::kMaxPayload).
+     * @param key True for a key frame (counted separately).
+     * @return true If the whole frame fit in the TX buffer.
+     */
+    bool send(uint8_t schema, const void *payload, std::size_t len, bool key = false) noexcept;
+
+    /// @brief Key refresh interval (µs).
+    [[nodiscard]] uint64_t keyUs() const noexcept { return key_us_; }
+
+    /// @brief Peer clock - local clock (µs; 0 until the first pong).
+    [[nodiscard]] int64_t offsetUs() const noexcept { return stats_.offset_us; }
+
+    /// @brief Link statistics (any task).
+    [[nodiscard]] bridge::Stats stats() const noexcept { return pub_.peek(); }
+
+private:
+    friend class rtos::Task<BusBridge>; ///< Task entry calls run().
+
+    static constexpr std::size_t kOffsetWindow = 16; ///< Pongs per clock-offset window (fastest one wins).
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /// @brief Read whatever the UART holds and dispatch every complete frame.
+    void drain(uint64_t now) noexcept;
+
+    /// @brief Handle one decoded frame.
+    void dispatch(const telem::Frame &f, uint64_t now) noexcept;
+
+    /// @brief Pong: round trip and clock offset.
+    void pong(const uint8_t *p, std::size_t n, uint64_t now) noexcept;
+
+    /// @brief Bump a stats_ counter (republished with the next pong or link change).
+    void count(uint32_t &c) noexcept
+    {
+        ++c;
+        dirty_ = true;
+    }
+
+    HardwareSerial *port_{nullptr};               ///< Non-owning UART.
+    uint64_t key_us_;                             ///< Key refresh interval.
+    uint64_t ping_us_;                            ///< Probe period.
+    uint64_t timeout_us_;                         ///< Link-loss timeout.
+    TickType_t idle_ticks_{1};                    ///< Longest block (one probe period).
+    std::array<Mirror *, kMaxMirrors> mirrors_{}; ///< Outbound buses.
+    std::size_t n_mirrors_{0};                    ///< Used mirrors.
+    std::array<Sink *, kMaxSinks> sinks_{};       ///< Inbound buses.
+    std::size_t n_sinks_{0};                      ///< Used sinks.
+    std::atomic<TaskHandle_t> task_{nullptr};     ///< Own task handle (RX callback notification target).
+    uint8_t tx_seq_{0};                           ///< Next frame seq.
+    uint8_t rx_seq_{0};                           ///< Last frame seq received.
+    bool has_rx_seq_{false};                      ///< rx_seq_ valid.
+    std::array<uint8_t, telem::kMaxFrame> rx_{};  ///< Frame being received.
+    std::size_t rx_n_{0};                         ///< Bytes in rx_.
+    bool rx_skip_{false};                         ///< Overlong frame: discard up to the next delimiter.
+    uint64_t rx_us_{0};                           ///< Last good frame.
+    uint64_t ping_at_us_{0};                      ///< Last probe sent.
+    uint32_t win_n_{0};                           ///< Pongs in the current offset window.
+    uint32_t win_rtt_{UINT32_MAX};                ///< Fastest round trip in the window.
+    int64_t win_offset_{0};                       ///< Its offset.
+    bool has_offset_{false};                      ///< offset_us valid.
+    bridge::Stats stats_{};                       ///< Working copy (bridge task).
+    bool dirty_{false};                           ///< stats_ changed since the last publish.
+    snapshot::SnapshotBus<bridge::Stats> pub_{};  ///< Published copy (stats()).
+};
@@ -0,0 +1,248 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of BusReplay (FlightRecorder dump → pipeline buses, lock-stepped with the stage).
+ *
+ * @file BusReplay.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "BusReplay.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <StageCost.h>
+
+namespace
+{
+    constexpr uint64_t kTickUs = 1000ULL * portTICK_PERIOD_MS; ///< One scheduler tick (µs).
+} // namespace
+
+// Find the dump partition.
+bool BusReplay::begin(const char *label) noexcept
+{
+    part_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (part_ == nullptr)
+    {
+        logWarn("BusReplay: no '%s' partition.", label);
+        return false;
+    }
+    return true;
+}
+
+// Read the dump header at one block.
+bool BusReplay::header(uint32_t block, blackbox::DumpHeader &out) const noexcept
+{
+    if (part_ == nullptr || block >= blocks())
+        return false;
+
+    const uint32_t at = block * blackbox::kBlock;
+    if (esp_partition_read(part_, at, &out, sizeof(out)) != ESP_OK)
+        return false;
+    return out.magic == blackbox::kDumpMagic && out.record_bytes == sizeof(blackbox::Record) && out.slot_bytes > 0 &&
+           at % out.slot_bytes == 0 && out.count <= (out.slot_bytes - blackbox::kSector) / sizeof(blackbox::Record);
+}
+
+// Start playing a dump.
+bool BusReplay::play(uint32_t seq, replay::Pace pace) noexcept
+{
+    if (part_ == nullptr || task_ == nullptr)
+        return false;
+    bool idle = false;
+    if (!busy_.compare_exchange_strong(idle, true, std::memory_order_acq_rel))
+        return false; ///< One playback at a time.
+
+    // The requested dump (torn ones too: they replay up to the tear), or the newest complete one.
+    bool found = false;
+    blackbox::DumpHeader best{};
+    uint32_t at = 0;
+    for (uint32_t b = 0; b < blocks(); ++b)
+    {
+        blackbox::DumpHeader h{};
+        if (!header(b, h))
+            continue;
+        const bool pick = (seq != 0) ? h.seq == seq : (h.commit == blackbox::kCommitted && (!found || h.seq > best.seq));
+        if (pick)
+        {
+            best = h;
+            at = b * blackbox::kBlock;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        busy_.store(false, std::memory_order_release);
+        return false;
+    }
+
+    base_ = at + blackbox::kSector;
+    count_ = best.count;
+    seq_ = best.seq;
+    pace_ = pace;
+    xTaskNotifyGive(task_);
+    return true;
+}
+
+// Main run loop.
+void BusReplay::run() noexcept
+{
+    task_ = xTaskGetCurrentTaskHandle();
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!busy())
+            continue; ///< Leftover bus notification from the last playback.
+
+        if (target_ == cfg::replay::Target::Drive)
+        {
+            auto ack = tel_->subscribe();
+            playback(ack);
+        }
+        else
+        {
+            auto ack = ctl_->subscribe();
+            playback(ack);
+        }
+        busy_.store(false, std::memory_order_release);
+    }
+}
+
+// Play base_ / count_ / pace_ into the stage.
+template <typename Sub>
+void BusReplay::playback(Sub &ack) noexcept
+{
+    replay::Report r{};
+    r.seq = seq_;
+    r.pace = pace_;
+    trace::cost().reset();
+
+    const uint64_t t0 = now_us();
+    uint64_t first = 0;
+    for (uint32_t i = 0; i < count_; ++i)
+    {
+        const std::size_t k = i % cfg::replay::CHUNK;
+        if (k == 0 && !load(i))
+        {
+            logError("BusReplay: partition read failed.");
+            break;
+        }
+        const blackbox::Record &rec = chunk_[k];
+        if (rec.stamp_us == UINT64_MAX)
+            break; ///< Torn dump: erased flash from here on.
+        if (i == 0)
+            first = r.first_us = rec.stamp_us;
+        ++r.records;
+        r.span_us = rec.stamp_us - first;
+
+        if (pace_ == replay::Pace::Recorded)
+        {
+            const uint64_t due = t0 + r.span_us;
+            uint64_t now = now_us();
+            if (due > now)
+            {
+                vTaskDelay(static_cast<TickType_t>((due - now + kTickUs - 1) / kTickUs)); ///< Tick resolution: within a tick either way.
+                now = now_us();
+            }
+            if (now > due)
+                r.late_max_us = std::max(r.late_max_us, static_cast<uint32_t>(std::min<uint64_t>(now - due, UINT32_MAX)));
+        }
+
+        feed(rec, i, now_us() - rec.stamp_us, ack, r);
+    }
+
+    r.took_us = now_us() - t0;
+    report_ = r;
+    logInfo("BusReplay: dump #%u played (%s): %u records, %u published, %u unanswered, %u / %u diverged.",
+            static_cast<unsigned>(r.seq), replay::to_name(r.pace), static_cast<unsigned>(r.records),
+            static_cast<unsigned>(r.published), static_cast<unsigned>(r.unanswered), static_cast<unsigned>(r.diverged),
+            static_cast<unsigned>(r.compared));
+}
+
+// Publish one record and wait for the stage's answer.
+template <typename Sub>
+void BusReplay::feed(const blackbox::Record &rec, uint32_t index, uint64_t shift, Sub &ack, replay::Report &r) noexcept
+{
+    const bool control = target_ == cfg::replay::Target::Control;
+    typename Sub::T scratch{};
+    (void)ack.take(scratch); ///< Whatever the stage published since (heartbeats) is not an answer to this record.
+
+    switch (rec.kind)
+    {
+    case blackbox::Kind::Input:
+    {
+        if (!control || (rec.len != sizeof(blackbox::InputRecord) && rec.len != blackbox::kInputV1Bytes))
+            return;
+        blackbox::InputRecord in{};
+        memcpy(&in, rec.payload, rec.len); ///< Old dumps: no gesture bits.
+
+        InputState s{};
+        s.buttons = std::bitset<NUM_BUTTONS>(in.buttons);
+        s.taps = std::bitset<NUM_BUTTONS>(in.taps);
+        s.doubles = std::bitset<NUM_BUTTONS>(in.doubles);
+        s.held = std::bitset<NUM_BUTTONS>(in.held);
+        s.chords = std::bitset<NUM_CHORDS>(in.chords);
+        s.origin_us = (in.origin_us != 0) ? in.origin_us + shift : 0;
+        s.stamp_ms = static_cast<uint32_t>(s.origin_us / 1000ULL);
+        in_->publish(s);
+        break;
+    }
+
+    case blackbox::Kind::Rc:
+    {
+        if (!control || rec.len != sizeof(RcSnapshot))
+            return;
+        RcSnapshot &f = rc_->begin_write();
+        memcpy(&f, rec.payload, sizeof(f));
+        if (f.stamp_us != 0)
+            f.stamp_us += shift;
+        rc_->commit();
+        break;
+    }
+
+    case blackbox::Kind::Control:
+    {
+        if (rec.len != sizeof(ControlSnapshot))
+            return;
+        ControlSnapshot c{};
+        memcpy(&c, rec.payload, sizeof(c));
+        if (control)
+        {
+            ++r.compared; ///< Reference frame: ControlCore has answered everything recorded before it.
+            if (!same(c, ctl_->peek()) && r.diverged++ == 0)
+                r.first_diverged = index;
+            return;
+        }
+        if (c.origin_us != 0)
+            c.origin_us += shift;
+        c.stamp_ms = static_cast<uint32_t>(c.origin_us / 1000ULL);
+        ctl_->publish(c);
+        break;
+    }
+
+    default:
+        return;
+    }
+
+    ++r.published;
+    if (!ack.wait(ack_ticks_))
+        ++r.unanswered;
+}
+
+// Read one chunk of records.
+bool BusReplay::load(uint32_t first) noexcept
+{
+    const uint32_t n = std::min<uint32_t>(cfg::replay::CHUNK, count_ - first);
+    return esp_partition_read(part_, base_ + first * sizeof(blackbox::Record), chunk_.data(), n * sizeof(blackbox::Record)) ==
+           ESP_OK;
+}
+
+// Command fields equal.
+bool BusReplay::same(const ControlSnapshot &a, const ControlSnapshot &b) noexcept
+{
+    return a.throttle_cmd_pct == b.throttle_cmd_pct && a.steer_cmd == b.steer_cmd && a.horn_cmd == b.horn_cmd &&
+           a.indicator_cmd == b.indicator_cmd && a.authority == b.authority && a.lights_cmd == b.lights_cmd &&
+           a.throttle_rate == b.throttle_rate && a.steer_rate == b.steer_rate;
+}
@@ -0,0 +1,199 @@
+/**
+ * MIT License
+ *
+ * @brief Deterministic playback of FlightRecorder dumps into ControlCore / PowerDriveHandler.
+ *
+ * @file BusReplay.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <esp_partition.h>
+#include <InputBus.h>
+#include <RcBus.h>
+#include <ControlBus.h>
+#include <TelemetryBus.h>
+#include <FlightRecorder/FlightRecorder.h>
+
+namespace replay
+{
+    /// @brief Playback timing.
+    enum class Pace : uint8_t
+    {
+        Recorded = 0, ///< Each record at its recorded offset from the first.
+        Fast          ///< Next record as soon as the stage has answered the last one.
+    };
+
+    /// @brief Human-readable pace.
+    constexpr const char *to_name(Pace p) noexcept { return (p == Pace::Fast) ? "fast" : "recorded"; }
+
+    /// @brief Outcome of one playback.
+    struct Report
+    {
+        uint32_t seq{0};            ///< Dump played (DumpHeader::seq).
+        Pace pace{Pace::Recorded};  ///< Timing used.
+        uint32_t records{0};        ///< Records read.
+        uint32_t published{0};      ///< Records published into the stage.
+        uint32_t unanswered{0};     ///< Publishes the stage did not answer within cfg::replay::ACK_MS.
+        uint32_t compared{0};       ///< Recorded Control frames checked against ControlCore's output (Target::Control).
+        uint32_t diverged{0};       ///< ...that differed in a command field.
+        uint32_t first_diverged{0}; ///< Record index of the first difference (valid when diverged > 0).
+        uint32_t late_max_us{0};    ///< Worst lag behind the recorded timeline (µs).
+        uint64_t first_us{0};       ///< Recorded stamp of the first record (µs since that boot).
+        uint64_t span_us{0};        ///< Recorded time covered (first → last record).
+        uint64_t took_us{0};        ///< Playback time (µs).
+    };
+} ///< Namespace replay.
+
+/**
+ * @brief Plays a FlightRecorder dump back into the pipeline, in recorded order.
+ *
+ * The recording is the capture: dumps are written by FlightRecorder on the
+ * car (failsafe, fault, 'bbox mark'), read back in place from the same
+ * partition, or on the host from an esptool image of it (sim/). Records
+ * are read cfg::replay::CHUNK at a time, restamped onto this boot's clock
+ * and published on the bus they came from:
+ *
+ *   Target::Control  Input + Rc records → InputBus / RcBus → ControlCore.
+ *                    Recorded Control records are the reference: each is
+ *                    compared with ControlCore's latest output, so a policy
+ *                    change shows up as a divergence count.
+ *   Target::Drive    Control records → ControlBus → PowerDriveHandler.
+ *
+ * Playback runs in lock-step with the stage: after every publish the task
+ * waits (up to cfg::replay::ACK_MS) for the stage's answer, ControlBus for
+ * ControlCore, the next TelemetryBus step for PowerDriveHandler. That keeps
+ * Pace::Fast deterministic whatever the core layout (no frame is ever
+ * coalesced), and Pace::Fast then runs as fast as the stage itself. The
+ * stages time every activation into trace::cost(), which each playback
+ * clears first, so afterwards it holds the cost of that recording alone.
+ *
+ * @note Pace::Fast collapses the gaps in the recording: transitions that
+ *       ControlCore derives from silence (a stale RC link) only reproduce at
+ *       Pace::Recorded. Latches (indicator taps, headlights) start from
+ *       whatever state the stage is in, so the first frames of a recording
+ *       that began mid-latch count as divergent.
+ * @note Restamping keeps every origin_us / stamp_us at its recorded distance
+ *       from the record's own stamp, so trace::latency() stays meaningful.
+ */
+class BusReplay : public rtos::Task<BusReplay>
+{
+public:
+    /**
+     * @brief Construct for the pipeline buses.
+     *
+     * @param in Button input bus (Target::Control writes it).
+     * @param rc RC frames (Target::Control writes it).
+     * @param ctl Control commands (Target::Control reads it, Target::Drive writes it).
+     * @param tel Drive loop output (Target::Drive waits on it).
+     * @param target Stage under test.
+     */
+    BusReplay(InputBus &in, RcBus &rc, ControlBus &ctl, TelemetryBus &tel,
+              cfg::replay::Target target = cfg::replay::TARGET) noexcept
+        : in_(&in), rc_(&rc), ctl_(&ctl), tel_(&tel), target_(target),
+          ack_ticks_(to_ticks_ms(cfg::replay::ACK_MS) > 0 ? to_ticks_ms(cfg::replay::ACK_MS) : 1) {}
+
+    /**
+     * @brief Find the dump partition (call from setup()).
+     *
+     * @param label Data partition label (FlightRecorder's).
+     * @return true If the partition exists.
+     */
+    bool begin(const char *label = cfg::recorder::PARTITION) noexcept;
+
+    /**
+     * @brief Start playing a dump (any task; refused while one is playing).
+     *
+     * @param seq Dump sequence number (0 → newest complete dump).
+     * @param pace Timing.
+     * @return true If the dump was found and playback started.
+     */
+    bool play(uint32_t seq = 0, replay::Pace pace = replay::Pace::Recorded) noexcept;
+
+    /// @brief True while a playback runs.
+    [[nodiscard]] bool busy() const noexcept { return busy_.load(std::memory_order_acquire); }
+
+    /// @brief Last finished playback (stable while !busy()).
+    [[nodiscard]] const replay::Report &report() const noexcept { return report_; }
+
+    /// @brief Stage under test.
+    [[nodiscard]] cfg::replay::Target target() const noexcept { return target_; }
+
+    /// @brief 64 KB blocks in the partition (dump headers sit on block boundaries).
+    [[nodiscard]] uint32_t blocks() const noexcept { return (part_ != nullptr) ? part_->size / blackbox::kBlock : 0; }
+
+    /**
+     * @brief Read the dump header at one block, if any.
+     *
+     * @param block Block index (< blocks()).
+     * @param out Header.
+     * @return true If a dump starts there.
+     */
+    bool header(uint32_t block, blackbox::DumpHeader &out) const noexcept;
+
+private:
+    friend class rtos::Task<BusReplay>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Storage; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop: one playback per play().
+    void run() noexcept;
+
+    /**
+     * @brief Play base_ / count_ / pace_ into the stage.
+     *
+     * @tparam Sub Subscription on the bus the stage answers on.
+     * @param ack That subscription.
+     */
+    template <typename Sub>
+    void playback(Sub &ack) noexcept;
+
+    /**
+     * @brief Publish one record (restamped by @p shift) and wait for the stage's answer.
+     *
+     * @tparam Sub Subscription on the bus the stage answers on.
+     * @param rec Record.
+     * @param index Record index in the dump.
+     * @param shift Recorded clock → this boot's clock (µs, modular).
+     * @param ack Answer subscription.
+     * @param r Report to update.
+     */
+    template <typename Sub>
+    void feed(const blackbox::Record &rec, uint32_t index, uint64_t shift, Sub &ack, replay::Report &r) noexcept;
+
+    /// @brief Read records [@p first, @p first + CHUNK) into chunk_ (clipped to count_).
+    bool load(uint32_t first) noexcept;
+
+    /// @brief Command fields equal (stamps differ by construction).
+    static bool same(const ControlSnapshot &a, const ControlSnapshot &b) noexcept;
+
+    // ---- Buses ---- //
+    InputBus *in_;               ///< Non-owning input bus.
+    RcBus *rc_;                  ///< Non-owning RC bus.
+    ControlBus *ctl_;            ///< Non-owning control bus.
+    TelemetryBus *tel_;          ///< Non-owning drive output bus.
+    cfg::replay::Target target_; ///< Stage under test.
+    TickType_t ack_ticks_;       ///< Answer timeout.
+
+    // ---- Source ---- //
+    const esp_partition_t *part_{nullptr};                     ///< Dump partition.
+    uint32_t base_{0};                                         ///< First record's offset in part_.
+    uint32_t count_{0};                                        ///< Records in the dump.
+    std::array<blackbox::Record, cfg::replay::CHUNK> chunk_{}; ///< Read buffer.
+
+    // ---- Control ---- //
+    TaskHandle_t task_{nullptr};                ///< Replay task (play() wakes it).
+    std::atomic<bool> busy_{false};             ///< Playback running.
+    replay::Report report_{};                   ///< Written by playback, read once !busy().
+    uint32_t seq_{0};                           ///< Dump play() armed.
+    replay::Pace pace_{replay::Pace::Recorded}; ///< Timing play() armed.
+};
@@ -0,0 +1,240 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the button scan microbenchmark (bench::buttons()).
+ *
+ * @file ButtonBench.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "ButtonBench.h"
+#include <Arduino.h>
+#include <Wire.h>
+#include <bitset>
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+#include <InputBus.h>
+#include <PortButtons/PortButtons.h>
+#include <PowerManager/PowerManager.h>
+#include <VerticalDebounce.h>
+
+namespace
+{
+    using Sizes = std::index_sequence<1, 2, 4, 8, 16, 24, 32, 48, 64>; ///< Table rows (input counts).
+
+    /// @brief Per-sample input words: a bounce, then a settle, so the counters both reset and flip.
+    constexpr uint64_t kBounce[8] = {~0ULL, 0, ~0ULL, ~0ULL, ~0ULL, ~0ULL, 0, 0};
+
+    volatile uint32_t s_sink = 0; ///< Timed results land here, so no call is optimised away.
+
+    /// @brief One table cell.
+    struct Cost
+    {
+        uint32_t min{0};  ///< Fastest call (cycles).
+        uint32_t mean{0}; ///< Average call (cycles).
+    };
+
+    /// @brief CPU cycle counter (CCOUNT).
+    inline uint32_t cycles() noexcept { return ESP.getCycleCount(); }
+
+    /// @brief Cycles between two back-to-back counter reads (subtracted from every sample).
+    uint32_t overhead() noexcept
+    {
+        uint32_t best = UINT32_MAX;
+        for (int i = 0; i < 64; ++i)
+        {
+            const uint32_t t0 = cycles();
+            const uint32_t d = cycles() - t0;
+            best = (d < best) ? d : best;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Time @p fn over cfg::bench::RUNS calls.
+     *
+     * @param fn Call under test.
+     * @param base Counter read cost (overhead()).
+     * @return Cost min / mean cycles per call.
+     */
+    template <typename Fn>
+    Cost measure(Fn &&fn, uint32_t base) noexcept
+    {
+        uint32_t best = UINT32_MAX;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < cfg::bench::RUNS; ++i)
+        {
+            const uint32_t t0 = cycles();
+            fn();
+            const uint32_t d = cycles() - t0;
+            const uint32_t c = (d > base) ? d - base : 0;
+            best = (c < best) ? c : best;
+            sum += c;
+            if ((i & 63U) == 63U)
+                vTaskDelay(1); ///< Let the idle task feed the task watchdog.
+        }
+        return {best, static_cast<uint32_t>(sum / cfg::bench::RUNS)};
+    }
+
+    /// @brief Reader returning a fixed word (snapshot() column: no I/O).
+    struct WordReader
+    {
+        uint64_t word{0}; ///< Value read() returns.
+
+        [[nodiscard]] uint64_t read() const noexcept { return word; }
+    };
+
+    /// @brief "min/mean", or "-" for a skipped column.
+    void cell(char (&out)[24], const Cost &c, bool ran) noexcept
+    {
+        if (ran)
+            snprintf(out, sizeof(out), "%u/%u", static_cast<unsigned>(c.min), static_cast<unsigned>(c.mean));
+        else
+            snprintf(out, sizeof(out), "-");
+    }
+
+    /// @brief Time every backend at @p N inputs and print one table row.
+    template <std::size_t N>
+    void row(uint32_t base, uint32_t mhz) noexcept
+    {
+        using Word = typename PortButtons<N, WordReader>::Word;
+
+        // Debounce alone: one vertical-counter clock per sample.
+        VerticalDebounce<Word> deb{};
+        Word flips = 0;
+        uint32_t k = 0;
+        const Cost clock = measure([&] { flips ^= deb.clock(static_cast<Word>(kBounce[k++ & 7U])); }, base);
+
+        // snapshot(): debounced word → bitset (the same for every reader).
+        WordReader word{};
+        PortButtons<N, WordReader> fixed(word, cfg::button::BTN_DEBOUNCE_MS, /*active_low=*/false);
+        fixed.begin();
+        std::bitset<N> out{};
+        const Cost snap = measure([&] { fixed.snapshot(out); }, base);
+
+        Cost gpio{}, hc165{}, mcp{};
+        if constexpr (!cfg::matrix::ENABLED)
+        {
+            uint8_t pins[N];
+            for (std::size_t i = 0; i < N; ++i)
+                pins[i] = kButtonPins[i % NUM_BUTTONS]; ///< Past NUM_BUTTONS the pins repeat: per-bit gather.
+            GpioPortReader reader;
+            reader.begin(pins, N);
+            PortButtons<N, GpioPortReader> h(reader);
+            h.begin();
+            gpio = measure([&] { h.update(); }, base);
+        }
+        if constexpr (cfg::bench::HC165_LOAD >= 0)
+        {
+            Hc165Reader reader(cfg::bench::HC165_LOAD, cfg::bench::HC165_CLK, cfg::bench::HC165_DATA, static_cast<uint8_t>(N));
+            reader.begin();
+            PortButtons<N, Hc165Reader> h(reader);
+            h.begin();
+            hc165 = measure([&] { h.update(); }, base);
+        }
+        if constexpr (cfg::bench::MCP_SDA >= 0)
+        {
+            constexpr std::size_t chips = (N + 15) / 16;
+            uint8_t addrs[chips];
+            for (std::size_t i = 0; i < chips; ++i)
+                addrs[i] = static_cast<uint8_t>(cfg::bench::MCP_ADDR + i);
+            Mcp23017Reader reader(Wire, addrs, chips);
+            reader.begin();
+            PortButtons<N, Mcp23017Reader> h(reader);
+            h.begin();
+            mcp = measure([&] { h.update(); }, base);
+        }
+        s_sink = s_sink ^ static_cast<uint32_t>(flips) ^ static_cast<uint32_t>(out.count());
+
+        char c_clock[24], c_snap[24], c_gpio[24], c_hc165[24], c_mcp[24];
+        cell(c_clock, clock, true);
+        cell(c_snap, snap, true);
+        cell(c_gpio, gpio, !cfg::matrix::ENABLED);
+        cell(c_hc165, hc165, cfg::bench::HC165_LOAD >= 0);
+        cell(c_mcp, mcp, cfg::bench::MCP_SDA >= 0);
+
+        // One GPIO scan: update() (read + bookkeeping) plus a clock and a snapshot, at the mean.
+        const float scan_us = static_cast<float>(gpio.mean + clock.mean + snap.mean) / static_cast<float>(mhz);
+        if constexpr (!cfg::matrix::ENABLED)
+            debugfln("  %2u  %-11s %-11s %-11s %-11s %-11s %7.2f", static_cast<unsigned>(N), c_clock, c_snap, c_gpio, c_hc165,
+                     c_mcp, static_cast<double>(scan_us));
+        else
+            debugfln("  %2u  %-11s %-11s %-11s %-11s %-11s       -", static_cast<unsigned>(N), c_clock, c_snap, c_gpio, c_hc165,
+                     c_mcp);
+    }
+
+    /// @brief One row per entry of @p Ns.
+    template <std::size_t... Ns>
+    void table(std::index_sequence<Ns...>, uint32_t base, uint32_t mhz) noexcept
+    {
+        (row<Ns>(base, mhz), ...);
+    }
+
+    /// @brief Universal_Button's handler at NUM_BUTTONS (per pin: digitalRead + debounce).
+    void library(uint32_t base) noexcept
+    {
+        if constexpr (cfg::matrix::ENABLED)
+            return; ///< BUTTON_LIST pins are not wired to buttons.
+
+        static Button lib = makeButtons(ButtonTimingConfig{cfg::button::BTN_DEBOUNCE_MS, cfg::button::BTN_SHORT_MS,
+                                                           cfg::button::BTN_LONG_MS});
+        std::bitset<NUM_BUTTONS> out{};
+        const Cost upd = measure([&] { lib.update(); }, base);
+        const Cost snap = measure([&] { lib.snapshot(out); }, base);
+        s_sink = s_sink ^ static_cast<uint32_t>(out.count());
+
+        debugfln("ButtonHandler<%u>: update %u/%u  snapshot %u/%u  (%u per button per update)", static_cast<unsigned>(NUM_BUTTONS),
+                 static_cast<unsigned>(upd.min), static_cast<unsigned>(upd.mean), static_cast<unsigned>(snap.min),
+                 static_cast<unsigned>(snap.mean), static_cast<unsigned>(upd.mean / NUM_BUTTONS));
+    }
+
+    /// @brief for_each_edge<NUM_BUTTONS> on a quiet diff, one edge and every button changing.
+    void edges(uint32_t base) noexcept
+    {
+        InputState prev{};
+        InputState quiet{};
+        InputState one{};
+        InputState all{};
+        one.buttons.set(0);
+        all.buttons.set();
+
+        uint32_t seen = 0;
+        const auto diff = [&](const InputState &cur)
+        {
+            for_each_edge<NUM_BUTTONS>(prev, cur, [&](std::size_t, bool, std::uint32_t) { ++seen; });
+        };
+
+        const Cost c_quiet = measure([&] { diff(quiet); }, base);
+        const Cost c_one = measure([&] { diff(one); }, base);
+        const Cost c_all = measure([&] { diff(all); }, base);
+        s_sink = s_sink ^ seen;
+
+        debugfln("for_each_edge<%u>: quiet %u/%u  one edge %u/%u  all edges %u/%u", static_cast<unsigned>(NUM_BUTTONS),
+                 static_cast<unsigned>(c_quiet.min), static_cast<unsigned>(c_quiet.mean), static_cast<unsigned>(c_one.min),
+                 static_cast<unsigned>(c_one.mean), static_cast<unsigned>(c_all.min), static_cast<unsigned>(c_all.mean));
+    }
+} // namespace
+
+// Time every backend and print the scaling table.
+void bench::buttons() noexcept
+{
+    static pm::Lock lock("bench"); ///< Full clock: cycle counts stay comparable between cells.
+    lock.acquire();
+
+    if constexpr (cfg::bench::MCP_SDA >= 0)
+        Wire.begin(cfg::bench::MCP_SDA, cfg::bench::MCP_SCL, cfg::bench::MCP_HZ);
+
+    const uint32_t base = overhead();
+    const uint32_t mhz = getCpuFrequencyMhz();
+    debugfln("Button scan cost, CPU cycles per call (min/mean of %u) at %u MHz:", static_cast<unsigned>(cfg::bench::RUNS),
+             static_cast<unsigned>(mhz));
+    debugln("   N  clock       snapshot    gpio upd    hc165 upd   mcp upd     scan us");
+    table(Sizes{}, base, mhz);
+    library(base);
+    edges(base);
+
+    lock.release();
+}
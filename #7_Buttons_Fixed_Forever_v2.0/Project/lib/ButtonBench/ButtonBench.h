@@ -0,0 +1,52 @@
+/**
+ * MIT License
+ *
+ * @brief Button scan microbenchmark: update() / snapshot() CPU cycles per backend for N = 1..64 inputs.
+ *
+ * @file ButtonBench.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <cstdint>
+
+/**
+ * @brief Cycle counts for sizing an input panel against the scan budget.
+ *
+ * Every cell is RUNS timed calls, read from the CPU cycle counter (CCOUNT)
+ * with the counter's own read cost subtracted. min is the cost of the code
+ * itself; mean adds cache misses and preemption by higher-priority tasks.
+ * The CPU is held at full clock for the run.
+ *
+ * Backends, one column each, N = 1, 2, 4, 8, 16, 24, 32, 48, 64:
+ *  - debounce: PortButtons<N> over a synthetic bouncing word. This is the
+ *    bit-parallel debounce alone, with no I/O.
+ *  - gpio: PortButtons<N, GpioPortReader> on the BUTTON_LIST pins, reused
+ *    in turn past NUM_BUTTONS. Repeated pins take the per-bit gather path,
+ *    the worst case for a scattered panel. The column is skipped while the
+ *    key matrix owns the inputs.
+ *  - hc165: PortButtons<N, Hc165Reader> on cfg::bench::HC165_* (skipped at -1).
+ *  - mcp: PortButtons<N, Mcp23017Reader>, ceil(N / 16) expanders from
+ *    cfg::bench::MCP_ADDR (skipped at -1). A missing chip reads as no ACK,
+ *    which is faster than a real transfer.
+ *
+ * snapshot() is one column: it copies the debounced word and does not depend
+ * on the reader.
+ *
+ * Universal_Button's ButtonHandler<N> is only built through makeButtons(),
+ * for the configured NUM_BUTTONS, so it gets one line: one digitalRead and
+ * one debounce per pin. for_each_edge<NUM_BUTTONS> is timed on a quiet
+ * diff, one edge, and every button changing.
+ *
+ * @note Runs on the calling task (the console) for well under a second per
+ *       column. Drive and control tasks keep running at their own priorities.
+ */
+namespace bench
+{
+    /// @brief Time every backend and print the scaling table (console).
+    void buttons() noexcept;
+} ///< Namespace bench.
@@ -0,0 +1,101 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the calibration blob (compiled defaults, partition mmap + CRC check).
+ *
+ * @file Calibration.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "Calibration.h"
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+namespace
+{
+    using rc_batch::RoleSpec;
+
+    /// @brief Built-in calibration, one role entry per RC role in declared order.
+    constexpr calib::Blob kDefaults = {
+        {calib::kMagic, calib::kVersion, static_cast<uint16_t>(sizeof(calib::Blob)), 0, 0},
+        {{
+            RoleSpec::axis(1000, 2000, 1500, 8, -100.f, 100.f, 0.f),   ///< steering
+            RoleSpec::axis(1000, 2000, 1500, 8, -100.f, 100.f, 0.f),   ///< direction
+            RoleSpec::axis(1000, 2000, 1000, 8, 0.f, 100.f, 0.f),      ///< speed
+            RoleSpec::axis(1000, 2000, 1500, 8, -100.f, 100.f, 0.f),   ///< indicators
+            RoleSpec::axis(1000, 2000, 1500, 4, 0.f, 100.f, 0.f),      ///< volume
+            RoleSpec::axis(1000, 2000, 1500, 4, 0.f, 100.f, 0.f),      ///< power
+            RoleSpec::sw({1000, 2000}, {0.f, 1.f}, 2, 1.f),            ///< override (failsafe: override car settings)
+            RoleSpec::sw({1000, 2000}, {0.f, 1.f}, 2, 0.f),            ///< lights
+            RoleSpec::sw({1000, 1500, 2000}, {0.f, 1.f, 2.f}, 3, 0.f), ///< mode (failsafe: default mode)
+            RoleSpec::sw({1000, 2000}, {0.f, 1.f}, 2, 0.f),            ///< obstacle
+        }},
+        {cfg::rc::LINK_TIMEOUT_MS, /*tol*/ 2, 0, /*hold_ms*/ 50, {+100, +100, +100, -100}},
+        {static_cast<uint16_t>(cfg::button::BTN_DEBOUNCE_MS), static_cast<uint16_t>(cfg::button::BTN_SHORT_MS),
+         static_cast<uint16_t>(cfg::button::BTN_LONG_MS), 0},
+    };
+
+    const calib::Blob *s_active = &kDefaults; ///< Set once by begin(); the mapping is never released.
+} // namespace
+
+namespace calib
+{
+    static constexpr logx::Module kLogModule = logx::Module::Storage; ///< Filter for this module's log* sites.
+}
+
+// Map the calib partition and validate the blob.
+bool calib::begin(const char *label, uint8_t subtype) noexcept
+{
+    const esp_partition_t *part =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, static_cast<esp_partition_subtype_t>(subtype), label);
+    if (part == nullptr || part->size < sizeof(Blob))
+    {
+        logInfo("Calibration: no '%s' partition, using compiled defaults.", label);
+        return false;
+    }
+
+    // Read in place through the data cache: no copy, no parse.
+    const void *ptr = nullptr;
+    esp_partition_mmap_handle_t handle{};
+    if (esp_partition_mmap(part, 0, sizeof(Blob), ESP_PARTITION_MMAP_DATA, &ptr, &handle) != ESP_OK)
+    {
+        logError("Calibration: mmap failed, using compiled defaults.");
+        return false;
+    }
+
+    const auto *blob = static_cast<const Blob *>(ptr);
+    const Header &h = blob->header;
+    const auto *body = reinterpret_cast<const uint8_t *>(blob) + sizeof(Header);
+    const bool ok = h.magic == kMagic && h.version == kVersion && h.bytes == sizeof(Blob) &&
+                    esp_rom_crc32_le(0, body, sizeof(Blob) - sizeof(Header)) == h.crc32;
+    if (!ok)
+    {
+        logWarn("Calibration: '%s' holds no valid v%u blob, using compiled defaults.", label, static_cast<unsigned>(kVersion));
+        esp_partition_munmap(handle);
+        return false;
+    }
+
+    s_active = blob;
+    logInfo("Calibration: loaded from '%s' (crc %08x).", label, static_cast<unsigned>(h.crc32));
+    return true;
+}
+
+// Calibration in use.
+const calib::Blob &calib::active() noexcept
+{
+    return *s_active;
+}
+
+// Compiled-in calibration.
+const calib::Blob &calib::defaults() noexcept
+{
+    return kDefaults;
+}
+
+// True if active() points into flash.
+bool calib::mapped() noexcept
+{
+    return s_active != &kDefaults;
+}
@@ -0,0 +1,96 @@
+/**
+ * MIT License
+ *
+ * @brief Read-only calibration blob (RC roles, link failsafe, button timings) mapped in place from flash.
+ *
+ * @file Calibration.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <RcBatch.h>
+
+namespace calib
+{
+    // ---- Blob layout ---- //
+    //
+    // One little-endian struct at offset 0 of the calib partition, produced by
+    // tools/make_calib.py and flashed with parttool / esptool:
+    //   Header (16 B)  roles[RC::Count]  RcLinkCal  ButtonCal
+    // The CRC covers everything after the header, so a half-written or stale
+    // blob is ignored and the compiled defaults are used instead.
+
+    static constexpr uint32_t kMagic = 0x314C4143;                             ///< "CAL1".
+    static constexpr uint16_t kVersion = 1;                                    ///< Layout version.
+    static constexpr std::size_t kRoles = static_cast<std::size_t>(RC::Count); ///< One RoleSpec per RC role.
+    static constexpr std::size_t kSignatureRoles = 4;                          ///< steering, direction, speed, indicators.
+
+    /// @brief First bytes of the blob.
+    struct Header
+    {
+        uint32_t magic;    ///< kMagic (0xFFFFFFFF → erased partition).
+        uint16_t version;  ///< kVersion.
+        uint16_t bytes;    ///< sizeof(Blob).
+        uint32_t crc32;    ///< CRC-32 (zlib) of the bytes after the header.
+        uint32_t reserved; ///< Zero.
+    };
+
+    /// @brief Link-level settings RcLink takes outside the per-role config.
+    struct RcLinkCal
+    {
+        uint32_t link_timeout_ms;                 ///< No frame for this long → failsafe.
+        uint8_t sig_tol;                          ///< Receiver failsafe signature tolerance (output units).
+        uint8_t reserved;                         ///< Zero.
+        uint16_t sig_hold_ms;                     ///< Signature must hold this long.
+        std::array<int16_t, kSignatureRoles> sig; ///< Signature values, in kSignatureRoles order.
+    };
+
+    /// @brief Button timings handed to the button backends at start-up.
+    struct ButtonCal
+    {
+        uint16_t debounce_ms; ///< Debounce window.
+        uint16_t short_ms;    ///< Short-press limit.
+        uint16_t long_ms;     ///< Long-press threshold.
+        uint16_t reserved;    ///< Zero.
+    };
+
+    /// @brief The whole calibration, read in place (never copied).
+    struct Blob
+    {
+        Header header;                                ///< Magic / version / CRC.
+        std::array<rc_batch::RoleSpec, kRoles> roles; ///< Role mapping + failsafe value, in RC order.
+        RcLinkCal link;                               ///< Link timeout + failsafe signature.
+        ButtonCal buttons;                            ///< Button timings.
+    };
+
+    static_assert(sizeof(rc_batch::RoleSpec) == 44, "RoleSpec layout changed: update tools/make_calib.py.");
+    static_assert(sizeof(Header) == 16 && sizeof(RcLinkCal) == 16 && sizeof(ButtonCal) == 8,
+                  "Calibration layout changed: update tools/make_calib.py.");
+    static_assert(sizeof(Blob) == sizeof(Header) + kRoles * sizeof(rc_batch::RoleSpec) + sizeof(RcLinkCal) + sizeof(ButtonCal),
+                  "Blob must have no padding (tools/make_calib.py packs it field by field).");
+
+    /**
+     * @brief Map the calib partition and validate the blob (call once from setup(), before anything reads active()).
+     *
+     * @param label Partition label.
+     * @param subtype Data subtype (the custom partition CSVs use cfg::calib::SUBTYPE).
+     * @return true If a valid blob is mapped (false → compiled defaults stay active).
+     */
+    bool begin(const char *label = cfg::calib::PARTITION, uint8_t subtype = cfg::calib::SUBTYPE) noexcept;
+
+    /// @brief Calibration in use: the mapped blob, or defaults() when none was found.
+    const Blob &active() noexcept;
+
+    /// @brief Compiled-in calibration (what tools/make_calib.py writes with no overrides).
+    const Blob &defaults() noexcept;
+
+    /// @brief True if active() points into flash.
+    bool mapped() noexcept;
+} ///< Namespace calib.
@@ -14,41 +14,225 @@
 // Main run loop.
 void ControlCore::run() noexcept
 {
-    configASSERT(in_ != nullptr && out_ != nullptr); ///< Sanity check: buses in_ and out_ must be valid.
-    configASSERT(loop_ticks_ > 0);                   ///< Timing must be configured.
+    configASSERT(in_ != nullptr && rc_ != nullptr && out_ != nullptr && events_ != nullptr); ///< Sanity check: buses must be valid.
+    configASSERT(idle_ticks_ > 0);                                                           ///< Timing must be configured.
 
-    TickType_t last_wake = xTaskGetTickCount();
+    auto in_sub = in_->subscribe();   ///< Woken on every InputBus publish.
+    auto rc_sub = rc_->subscribe();   ///< Woken on every RcBus publish.
+    auto ev_sub = events_->consume(); ///< Woken on every button event.
+    configASSERT(in_sub.valid() && rc_sub.valid() && ev_sub.valid());
+
+    InputState cur = in_->peek(); ///< Seed with the StateManager's initial frame.
+    rc_last_ = rc_->read_view();  ///< Always hold a valid view (has_rc_ gates its use).
 
     for (;;)
     {
-        const InputState cur = in_->peek();
+        // Sleep until either source publishes. While Remote holds authority, also wake
+        // often enough to catch a silent RC link.
+        const TickType_t wait = (authority_ == ControlSnapshot::Authority::Remote) ? kRcStaleTicks : idle_ticks_;
+        beat_.beat(now_us(), Heartbeat::ticksUs(wait));
+        snapshot::wait_any(wait, in_sub, rc_sub, ev_sub);
+        const trace::CostScope cost(trace::Work::Control); ///< This pass, up to the prev_ update.
 
-        // Input event logging.
-        if (has_prev_)
+        const bool in_new = in_sub.take(cur);
+        const bool rc_new = rc_sub.fresh();
+        if (rc_new)
         {
-            logButtonEvents(prev_, cur);
+            rc_last_ = rc_sub.view(); ///< Re-pin the newest frame; the old one is released.
+            has_rc_ = true;
         }
 
-        // Build control commands.
-        ControlSnapshot out{};
-        out.throttle_cmd_pct = cur.buttons.test(idx(kBtnAccel)) ? kMaxPct : kMinPct;
-        out.horn_cmd = cur.buttons.test(idx(kBtnHorn));
+        const bool in_edge = in_new && (!has_prev_ || cur.buttons != prev_.buttons);
+        if (in_edge)
+            in_origin_ = cur.origin_us; ///< Heartbeat frames don't count as events.
+        if (in_new && has_prev_)
+            latch(cur);
+
+        // Input event logging: every queued event, in one batch.
+        ev_sub.drain(&ControlCore::logEvent);
+
+        arbitrate(now_us());
+        track(rc_new);
+        const ControlSnapshot frame = build(cur);
+        out_->publish(frame);
+
+        // Latency: source event → ControlBus (only for frames that carry a new event).
+        if (rc_new && frame.origin_src == ControlSnapshot::Source::Rc)
+            trace::mark(trace::Stage::ControlRc, frame.origin_us);
+        else if (in_edge && frame.origin_src == ControlSnapshot::Source::Buttons)
+            trace::mark(trace::Stage::ControlButton, frame.origin_us);
+
+        // Update previous snapshot for next edge detection.
+        if (in_new)
+        {
+            prev_ = cur;
+            has_prev_ = true;
+        }
+    }
+}
+
+// Log one discrete button event.
+void ControlCore::logEvent(const ButtonEvent &e) noexcept
+{
+    if (e.kind == ButtonEvent::Kind::Press)
+        logInfo("%s pressed @ %u", kButtonNames[e.button], static_cast<unsigned>(e.stamp_us / 1000ULL));
+    else if (e.kind == ButtonEvent::Kind::Chord)
+        logInfo("%s chord @ %u", kChordNames[e.button], static_cast<unsigned>(e.stamp_us / 1000ULL));
+    else
+        logInfo("%s %s @ %u (%u ms)", kButtonNames[e.button], to_name(e.kind), static_cast<unsigned>(e.stamp_us / 1000ULL),
+                static_cast<unsigned>(e.held_ms));
+}
+
+// Update authority_ (and the Remote gear) from the latest RC frame.
+void ControlCore::arbitrate(uint64_t now) noexcept
+{
+    const RcSnapshot &rc = *rc_last_;
+    const bool stale = !has_rc_ || !rc_age_.check(rc_->age_us(now)); ///< Bus clock: a bridged / replayed frame keeps its origin stamp.
+    const bool link_ok = !stale && !rc.failsafe;
 
-        out.indicator_cmd = ControlSnapshot::Indicator::Off;
+    if (link_ok)
+    {
+        authority_ = (rc_get(rc, RC::override) >= kOverrideOn) ? ControlSnapshot::Authority::Remote
+                                                               : ControlSnapshot::Authority::Local;
+    }
+    else if (authority_ == ControlSnapshot::Authority::Remote)
+    {
+        authority_ = ControlSnapshot::Authority::Failsafe; ///< Lost the link mid-drive: stop until it returns.
+        logWarn("RC link lost → failsafe stop.");
+    }
+
+    if (authority_ != ControlSnapshot::Authority::Remote)
+    {
+        reverse_ = false; ///< Every handover starts in forward.
+        return;
+    }
+    const real_t gear = rc_get(rc, RC::direction);
+    if (gear <= -kDirectionThreshold)
+        reverse_ = true;
+    else if (gear >= kDirectionThreshold)
+        reverse_ = false;
+}
+
+// Apply tap / double / chord toggles since the previous frame to the local latches.
+void ControlCore::latch(const InputState &in) noexcept
+{
+    using Indicator = ControlSnapshot::Indicator;
+    const auto toggle = [this](Indicator want) { ind_latch_ = (ind_latch_ == want) ? Indicator::Off : want; };
+
+    const auto tapped = in.taps ^ prev_.taps;
+    if (tapped.test(idx(kBtnLeft)))
+        toggle(Indicator::Left);
+    if (tapped.test(idx(kBtnRight)))
+        toggle(Indicator::Right);
+    if ((in.chords ^ prev_.chords).test(idx(kChordHazard)))
+        toggle(Indicator::Hazard);
+    if ((in.doubles ^ prev_.doubles).test(idx(kBtnHorn)))
+        lights_latch_ = !lights_latch_;
+}
+
+// Feed a new RC frame to the command trackers (Remote only; any other authority drops them).
+void ControlCore::track(bool rc_new) noexcept
+{
+    if constexpr (!cfg::smooth::ENABLED)
+        return;
 
-        if (cur.buttons.test(idx(kBtnLeft)))
+    if (authority_ != ControlSnapshot::Authority::Remote)
+    {
+        speed_f_.clear(); ///< The next takeover starts from the stick, not from an old trend.
+        steer_f_.clear();
+        return;
+    }
+    if (!rc_new && speed_f_.tracking())
+        return; ///< Woken by buttons / timeout: the RC frame was already folded in.
+
+    const RcSnapshot &rc = *rc_last_;
+    speed_f_.update(num::clamp(rc_get(rc, RC::speed), kMinPct, kMaxPct), rc.stamp_us);
+    steer_f_.update(num::clamp(rc_get(rc, RC::steering), -kSteerPct, kSteerPct), rc.stamp_us);
+}
+
+// Build the control frame for the current authority.
+ControlSnapshot ControlCore::build(const InputState &in) const noexcept
+{
+    ControlSnapshot out{};
+    out.authority = authority_;
+    out.horn_cmd = in.buttons.test(idx(kBtnHorn)); ///< Horn stays local in every mode.
+
+    // Origin: newest source event, one µs clock end to end.
+    const RcSnapshot &rc = *rc_last_;
+    if (has_rc_ && rc.stamp_us > in_origin_)
+    {
+        out.origin_us = rc.stamp_us;
+        out.origin_src = ControlSnapshot::Source::Rc;
+    }
+    else
+    {
+        out.origin_us = in_origin_;
+        out.origin_src = ControlSnapshot::Source::Buttons;
+    }
+    out.stamp_ms = static_cast<uint32_t>(out.origin_us / 1000ULL);
+
+    switch (authority_)
+    {
+    case ControlSnapshot::Authority::Remote:
+    {
+        real_t speed = num::clamp(rc_get(rc, RC::speed), kMinPct, kMaxPct);
+        real_t steer = num::clamp(rc_get(rc, RC::steering), -kSteerPct, kSteerPct);
+        real_t speed_rate{};
+        real_t steer_rate{};
+        if (cfg::smooth::ENABLED && speed_f_.tracking())
+        {
+            speed = num::clamp(speed_f_.value(), kMinPct, kMaxPct);
+            steer = num::clamp(steer_f_.value(), -kSteerPct, kSteerPct);
+            if (out.origin_src == ControlSnapshot::Source::Rc && out.origin_us == speed_f_.stamp())
+            {
+                // Trends run from origin_us; one pinned at a limit and pushing past it predicts nothing.
+                speed_rate = speed_f_.rate();
+                if ((speed <= kMinPct && speed_rate < real_t{}) || (speed >= kMaxPct && speed_rate > real_t{}))
+                    speed_rate = real_t{};
+                steer_rate = steer_f_.rate();
+                if ((steer <= -kSteerPct && steer_rate < real_t{}) || (steer >= kSteerPct && steer_rate > real_t{}))
+                    steer_rate = real_t{};
+            }
+        }
+        out.throttle_cmd_pct = reverse_ ? -speed : speed;
+        out.throttle_rate = static_cast<int16_t>(num::to_units(reverse_ ? -speed_rate : speed_rate, 1));
+        out.steer_cmd = steer;
+        out.steer_rate = static_cast<int16_t>(num::to_units(steer_rate, 1));
+        out.lights_cmd = rc_get(rc, RC::lights) >= kLightsOn;
+
+        const real_t ind = rc_get(rc, RC::indicators);
+        if (ind <= -kIndicatorThreshold)
             out.indicator_cmd = ControlSnapshot::Indicator::Left;
-        else if (cur.buttons.test(idx(kBtnRight)))
+        else if (ind >= kIndicatorThreshold)
             out.indicator_cmd = ControlSnapshot::Indicator::Right;
+        break;
+    }
 
-        out.stamp_ms = cur.stamp_ms;
-
-        out_->publish(out);
+    case ControlSnapshot::Authority::Failsafe:
+        out.throttle_cmd_pct = kMinPct;
+        out.indicator_cmd = ControlSnapshot::Indicator::Hazard; ///< Make the stop visible.
+        out.lights_cmd = true;
+        break;
 
-        // Update previous snapshot for next edge detection.
-        prev_ = cur;
-        has_prev_ = true;
+    case ControlSnapshot::Authority::Local:
+    default:
+    {
+        out.throttle_cmd_pct = in.buttons.test(idx(kBtnAccel)) ? kMaxPct : kMinPct;
+        out.lights_cmd = lights_latch_;
 
-        vTaskDelayUntil(&last_wake, loop_ticks_);
+        const bool left = in.buttons.test(idx(kBtnLeft));
+        const bool right = in.buttons.test(idx(kBtnRight));
+        if (left && right)
+            out.indicator_cmd = ControlSnapshot::Indicator::Hazard;
+        else if (left)
+            out.indicator_cmd = ControlSnapshot::Indicator::Left;
+        else if (right)
+            out.indicator_cmd = ControlSnapshot::Indicator::Right;
+        else
+            out.indicator_cmd = ind_latch_; ///< Released: whatever the taps / chord latched.
+        break;
+    }
     }
-}
\ No newline at end of file
+
+    return out;
+}
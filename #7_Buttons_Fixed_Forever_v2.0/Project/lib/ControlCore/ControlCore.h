@@ -1,7 +1,7 @@
 /**
  * MIT License
  *
- * @brief Control core (InputBus → ControlBus).
+ * @brief Control core (InputBus + RcBus → ControlBus).
  *
  * @file ControlCore.h
  * @author Little Man Builds (Darren Osborne)
@@ -12,56 +12,178 @@
 #pragma once
 
 #include <app_config.h>
+#include <RtosTask.h>
 #include <cmath>
 #include <InputBus.h>
+#include <ButtonEvents.h>
+#include <RcBus.h>
 #include <ControlBus.h>
+#include <AlphaBeta.h>
+#include <LatencyTrace.h>
+#include <StageCost.h>
+#include <Heartbeat.h>
 
 /**
  * @brief Applies control policy to raw inputs and emits resolved commands.
  *
- * This layer interprets button state, applies simple rules (latching,
- * toggling), and produces concrete control commands for downstream handlers.
+ * This layer interprets button state and RC frames, applies simple rules
+ * (latching, toggling, authority arbitration), and produces one concrete
+ * ControlSnapshot per cycle for downstream handlers. A cycle runs whenever
+ * InputBus or RcBus publishes, so there is a single hop from stick or button
+ * to ControlBus.
+ *
+ * Authority:
+ *  - Local: buttons drive (default, and whenever RC::override is released).
+ *  - Remote: RC link healthy and RC::override engaged.
+ *  - Failsafe: link lost (failsafe flag or stamp_us older than cfg::rc::STALE_MS)
+ *    while Remote held authority. Latched until the link recovers.
+ *
+ * Local indicators use StateManager's gesture bits: holding a button shows
+ * it while held (both → Hazard), a short tap latches it on or off, and the
+ * Hazard chord latches hazards. A double tap on Horn toggles the
+ * headlights. The latch only XORs a few bitsets per frame; all timing stays
+ * in the GestureEngine. Remote takes the headlights from RC::lights;
+ * Failsafe forces them on with the hazards.
+ *
+ * Throttle is signed (negative → reverse). Remote: RC::speed sets the
+ * magnitude and RC::direction selects the gear, latched past
+ * ±kDirectionThreshold so a centred stick keeps the last choice. Local
+ * buttons drive forward only. PowerDriveHandler owns the reversal sequence.
+ *
+ * Steering follows RC::steering under Remote and centres in every other
+ * mode (no steering buttons; Failsafe must not hold a turn).
+ *
+ * Smoothing (cfg::smooth): under Remote, RC::speed and RC::steering each
+ * run through an alpha-beta tracker stepped on the RC frames' own stamps
+ * (not this task's wake time), so receiver jitter and frame-rate aliasing
+ * are filtered and the frame carries a rate alongside each command.
+ * Consumers extrapolate from origin_us with it (ControlSnapshot::
+ * throttleAt() / steerAt()); this task still publishes once per source
+ * event, which keeps the recorder and BusReplay deterministic. The speed
+ * magnitude is tracked, so a gear change never smears through zero.
+ * Button throttle is not filtered: PowerDriveHandler's slew already ramps
+ * its 0 / 100 % steps.
+ *
+ * Each ControlSnapshot carries the origin stamp of the newest source event
+ * (button edge or RC frame); input heartbeats do not move it.
+ *
+ * Discrete button events (ButtonEventQueue) wake the same loop and are
+ * drained in one batch per cycle, so taps shorter than a cycle still reach
+ * the event log.
  */
-class ControlCore
+class ControlCore : public rtos::Task<ControlCore>
 {
 public:
     /**
-     * @brief Construct with input bus and output bus.
+     * @brief Construct with input buses and output bus.
      *
      * @param in Input bus (non-owning).
+     * @param rc RC bus (non-owning).
      * @param out Control bus (non-owning).
-     * @param period_ms Loop period (milliseconds).
+     * @param idle_ms Maximum sleep while no input arrives (milliseconds, 0 → forever).
+     * @param events Button event queue this task consumes (non-owning).
      */
-    ControlCore(InputBus &in, ControlBus &out, std::uint32_t period_ms = cfg::tick::LOOP_MS) noexcept
-        : in_(&in), out_(&out), loop_ticks_(to_ticks_ms(period_ms)) {}
+    ControlCore(InputBus &in, RcBus &rc, ControlBus &out, std::uint32_t idle_ms = cfg::tick::HEARTBEAT_MS,
+                ButtonEventQueue &events = buses::buttonEvents()) noexcept
+        : in_(&in), rc_(&rc), out_(&out), events_(&events),
+          idle_ticks_(idle_ms > 0 ? to_ticks_ms(idle_ms) : portMAX_DELAY) {}
 
-    /**
-     * @brief FreeRTOS task trampoline. Call with `pvParameters = this`.
-     */
-    static inline void task(void *self) noexcept
-    {
-        static_cast<ControlCore *>(self)->run();
-    }
+    /// @brief Loop heartbeat (Supervisor).
+    [[nodiscard]] const Heartbeat &heartbeat() const noexcept { return beat_; }
+
+    /// @brief Age of the RC frame behind every arbitration, against cfg::rc::STALE_MS (any task).
+    [[nodiscard]] const snapshot::Freshness &rcAge() const noexcept { return rc_age_; }
 
 private:
+    friend class rtos::Task<ControlCore>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Control; ///< Filter for this class's log* sites.
+
     /// @brief Main run loop.
     void run() noexcept;
 
+    /**
+     * @brief Update authority_ (and the Remote gear) from the latest RC frame.
+     *
+     * @param now Current time (µs).
+     */
+    void arbitrate(uint64_t now) noexcept;
+
+    /**
+     * @brief Apply tap / double / chord toggles since the previous frame to the local latches.
+     *
+     * @param in New input snapshot (prev_ still holds the previous one).
+     */
+    void latch(const InputState &in) noexcept;
+
+    /**
+     * @brief Feed a new RC frame to the command trackers (Remote only; any other authority drops them).
+     *
+     * @param rc_new True if rc_last_ was re-pinned this cycle.
+     */
+    void track(bool rc_new) noexcept;
+
+    /**
+     * @brief Build the control frame for the current authority.
+     *
+     * @param in Latest input snapshot.
+     * @return ControlSnapshot Resolved commands.
+     */
+    ControlSnapshot build(const InputState &in) const noexcept;
+
+    /// @brief Log one discrete button event.
+    static void logEvent(const ButtonEvent &e) noexcept;
+
     // ---- Button roles (policy-level) ---- //
     static constexpr ButtonIndex kBtnAccel = ButtonIndex::Accelerator;
     static constexpr ButtonIndex kBtnHorn = ButtonIndex::Horn;
     static constexpr ButtonIndex kBtnLeft = ButtonIndex::IndicatorLeft;
     static constexpr ButtonIndex kBtnRight = ButtonIndex::IndicatorRight;
+    static constexpr ChordIndex kChordHazard = ChordIndex::Hazard;
 
     // ---- Policy knobs ---- //
-    static constexpr float kMinPct = 0.0f;   ///< Minimum throttle command (%).
-    static constexpr float kMaxPct = 100.0f; ///< Maximum throttle command (%).
+    static constexpr real_t kMinPct{0.0f};                                        ///< Minimum throttle command (%).
+    static constexpr real_t kMaxPct{100.0f};                                      ///< Maximum throttle command (%).
+    static constexpr real_t kSteerPct{100.0f};                                    ///< Steering command limit (± %).
+    static constexpr real_t kOverrideOn{0.5f};                                    ///< RC::override switch threshold.
+    static constexpr real_t kIndicatorThreshold{50.0f};                           ///< |RC::indicators| needed to signal.
+    static constexpr real_t kDirectionThreshold{50.0f};                           ///< |RC::direction| needed to change gear.
+    static constexpr real_t kLightsOn{0.5f};                                      ///< RC::lights switch threshold.
+    static constexpr uint32_t kRcStaleUs = cfg::rc::STALE_MS * 1000U;             ///< RC frame age limit (µs).
+    static constexpr TickType_t kRcStaleTicks = pdMS_TO_TICKS(cfg::rc::STALE_MS); ///< Wake cadence while Remote.
+    static constexpr real_t kRateMax{cfg::smooth::MAX_RATE};                      ///< Published rate limit (± %/s).
+
+    static_assert(cfg::smooth::MAX_RATE > 0.0f && cfg::smooth::MAX_RATE <= 32767.0f, "cfg::smooth::MAX_RATE must fit int16_t.");
+    static_assert(cfg::smooth::ALPHA > 0.0f && cfg::smooth::ALPHA <= 1.0f, "cfg::smooth::ALPHA: 0 < α ≤ 1.");
+    static_assert(cfg::smooth::BETA >= 0.0f && cfg::smooth::BETA * 200.0f * 1e6f / cfg::smooth::MIN_DT_US < 32767.0f,
+                  "cfg::smooth::BETA / MIN_DT_US: one rate step must fit Q16.16.");
+
+    /// @brief Tracker settings from cfg::smooth.
+    static constexpr BasicAlphaBeta<real_t>::Config kTrack{real_t{cfg::smooth::ALPHA}, real_t{cfg::smooth::BETA}, kRateMax,
+                                                           cfg::smooth::MIN_DT_US, cfg::smooth::RESET_MS * 1000U};
 
     // ---- Internal state ---- //
-    InputBus *in_{nullptr};    ///< Non-owning input bus (raw button snapshots).
-    ControlBus *out_{nullptr}; ///< Non-owning output bus (resolved control commands).
-    TickType_t loop_ticks_{0}; ///< Loop period in FreeRTOS ticks.
+    InputBus *in_{nullptr};                        ///< Non-owning input bus (raw button snapshots).
+    RcBus *rc_{nullptr};                           ///< Non-owning RC bus (mapped RC frames).
+    ControlBus *out_{nullptr};                     ///< Non-owning output bus (resolved control commands).
+    ButtonEventQueue *events_{nullptr};            ///< Non-owning button event queue (single consumer: this task).
+    TickType_t idle_ticks_{0};                     ///< Maximum wait for new input (ticks).
+    Heartbeat beat_{"ControlCore"};                ///< One beat per wait.
+    snapshot::Freshness rc_age_{"rc", kRcStaleUs}; ///< RcBus age at each arbitration.
+
+    InputState prev_{};     ///< Previous input snapshot (for edge detection).
+    bool has_prev_{false};  ///< True once prev_ is valid.
+    uint64_t in_origin_{0}; ///< Origin of the last input frame that changed the buttons.
+
+    ControlSnapshot::Indicator ind_latch_{ControlSnapshot::Indicator::Off}; ///< Local indicator latched by taps / chord.
+    bool lights_latch_{false};                                              ///< Local headlights latched by a Horn double tap.
+
+    RcBus::ReadView rc_last_{}; ///< Latest RC frame (pinned on the bus, not copied).
+    bool has_rc_{false};        ///< True once an RC frame has been received.
+
+    ControlSnapshot::Authority authority_{ControlSnapshot::Authority::Local}; ///< Current command owner.
+    bool reverse_{false};                                                     ///< Remote gear latched in reverse.
 
-    InputState prev_{};    ///< Previous input snapshot (for edge detection + event logging).
-    bool has_prev_{false}; ///< True once prev_ is valid.
-};
\ No newline at end of file
+    BasicAlphaBeta<real_t> speed_f_{kTrack}; ///< RC::speed magnitude tracker (Remote).
+    BasicAlphaBeta<real_t> steer_f_{kTrack}; ///< RC::steering tracker (Remote).
+};
@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of CrsfTransport (CRSF / ELRS frame decoding + telemetry).
+ *
+ * @file CrsfTransport.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "CrsfTransport.h"
+#include <cstring>
+#include <RcBatch.h>
+
+// Configure the UART (8N1).
+bool CrsfTransport::begin(HardwareSerial &port, int rx, int tx, uint32_t baud) noexcept
+{
+    port_ = &port;
+    can_send_ = (tx >= 0);
+    port.begin(baud, SERIAL_8N1, rx, tx);
+    ch_.fill(1500);
+    len_ = 0;
+    return true;
+}
+
+// Consume every waiting byte; decode complete frames.
+bool CrsfTransport::update(uint64_t now_us) noexcept
+{
+    if (port_ == nullptr)
+        return false;
+
+    const uint32_t before = frames_;
+    for (;;)
+    {
+        const int avail = port_->available();
+        bool more = false; ///< Bytes were read this pass (else stop once a frame is incomplete).
+        if (avail > 0 && len_ < kMaxFrame)
+        {
+            const std::size_t room = kMaxFrame - len_;
+            const std::size_t got = static_cast<std::size_t>(avail);
+            const std::size_t n = port_->read(buf_.data() + len_, (got < room) ? got : room);
+            len_ += n;
+            more = (n > 0);
+        }
+
+        // Drop leading bytes that can't start a frame.
+        std::size_t skip = 0;
+        while (skip < len_ && !isSync(buf_[skip]))
+            ++skip;
+        if (skip > 0)
+        {
+            memmove(buf_.data(), buf_.data() + skip, len_ - skip);
+            len_ -= skip;
+        }
+
+        if (len_ < 2)
+        {
+            if (!more)
+                break;
+            continue;
+        }
+
+        const std::size_t flen = static_cast<std::size_t>(buf_[1]) + 2; ///< Address + len byte + len.
+        if (buf_[1] < 2 || flen > kMaxFrame)
+        {
+            ++crc_errors_;
+            memmove(buf_.data(), buf_.data() + 1, len_ - 1); ///< Bad length: resync one byte on.
+            --len_;
+            continue;
+        }
+
+        if (len_ < flen)
+        {
+            if (!more)
+                break; ///< Rest of the frame hasn't arrived yet.
+            continue;
+        }
+
+        if (crc8(buf_.data() + 2, flen - 3) == buf_[flen - 1])
+        {
+            dispatch(now_us);
+            memmove(buf_.data(), buf_.data() + flen, len_ - flen);
+            len_ -= flen;
+        }
+        else
+        {
+            ++crc_errors_;
+            memmove(buf_.data(), buf_.data() + 1, len_ - 1);
+            --len_;
+        }
+    }
+    return frames_ != before;
+}
+
+// Handle one validated frame.
+void CrsfTransport::dispatch(uint64_t now_us) noexcept
+{
+    const uint8_t type = buf_[2];
+    const uint8_t *p = buf_.data() + 3;
+    const std::size_t plen = static_cast<std::size_t>(buf_[1]) - 2;
+
+    if (type == kTypeRcChannels && plen >= 22)
+    {
+        rc_batch::unpack11_us(p, ch_.data()); ///< CRC byte follows the 22-byte payload.
+        last_frame_us_ = now_us;
+        ++frames_;
+    }
+    else if (type == kTypeLinkStats && plen >= 10)
+    {
+        stats_.uplink_rssi1 = p[0];
+        stats_.uplink_rssi2 = p[1];
+        stats_.uplink_lq = p[2];
+        stats_.uplink_snr = static_cast<int8_t>(p[3]);
+        stats_.active_antenna = p[4];
+        stats_.rf_mode = p[5];
+        stats_.tx_power = p[6];
+        stats_.downlink_rssi = p[7];
+        stats_.downlink_lq = p[8];
+        stats_.downlink_snr = static_cast<int8_t>(p[9]);
+        have_stats_ = true;
+    }
+}
+
+// Failsafe: link timeout or zero uplink LQ.
+bool CrsfTransport::failsafe(uint64_t now_us) const noexcept
+{
+    if (frames_ == 0)
+        return true;
+    if (have_stats_ && stats_.uplink_lq == 0)
+        return true;
+    return (now_us - last_frame_us_) > static_cast<uint64_t>(cfg::rc::LINK_TIMEOUT_MS) * 1000ULL;
+}
+
+// Send a BATTERY_SENSOR frame.
+bool CrsfTransport::sendBattery(float volts, float amps, uint32_t used_mah, uint8_t remaining_pct) noexcept
+{
+    const uint16_t dv = static_cast<uint16_t>((volts > 0.0f) ? volts * 10.0f + 0.5f : 0.0f); ///< 0.1 V units, big-endian.
+    const uint16_t da = static_cast<uint16_t>((amps > 0.0f) ? amps * 10.0f + 0.5f : 0.0f);   ///< 0.1 A units.
+    const uint8_t payload[8] = {
+        static_cast<uint8_t>(dv >> 8), static_cast<uint8_t>(dv),
+        static_cast<uint8_t>(da >> 8), static_cast<uint8_t>(da),
+        static_cast<uint8_t>(used_mah >> 16), static_cast<uint8_t>(used_mah >> 8), static_cast<uint8_t>(used_mah),
+        remaining_pct};
+    return sendFrame(kTypeBattery, payload, sizeof(payload));
+}
+
+// Send an arbitrary telemetry frame.
+bool CrsfTransport::sendFrame(uint8_t type, const uint8_t *payload, std::size_t len) noexcept
+{
+    if (port_ == nullptr || !can_send_ || len > kMaxPayload)
+        return false;
+
+    uint8_t f[kMaxFrame];
+    f[0] = kAddrFc;
+    f[1] = static_cast<uint8_t>(len + 2); ///< Type + payload + CRC.
+    f[2] = type;
+    memcpy(f + 3, payload, len);
+    f[3 + len] = crc8(f + 2, len + 1);
+
+    const std::size_t n = len + 4;
+    if (static_cast<std::size_t>(port_->availableForWrite()) < n)
+        return false; ///< Never block the RC task on telemetry.
+    return port_->write(f, n) == n;
+}
+
+// CRC-8/DVB-S2.
+uint8_t CrsfTransport::crc8(const uint8_t *p, std::size_t n) noexcept
+{
+    uint8_t crc = 0;
+    while (n-- > 0)
+    {
+        crc ^= *p++;
+        for (int b = 0; b < 8; ++b)
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0xD5) : static_cast<uint8_t>(crc << 1);
+    }
+    return crc;
+}
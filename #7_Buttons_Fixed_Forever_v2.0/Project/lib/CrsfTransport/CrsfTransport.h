@@ -0,0 +1,142 @@
+/**
+ * MIT License
+ *
+ * @brief CRSF / ELRS receiver transport (RC channels, link statistics, telemetry back-channel).
+ *
+ * @file CrsfTransport.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Decodes CRSF frames straight from the UART; can send telemetry frames back.
+ *
+ * Frame: [address][len][type][payload (len - 2)][crc8], CRC-8/DVB-S2 over
+ * type + payload. RC_CHANNELS_PACKED (0x16) is unpacked in place from the
+ * receive buffer into 16 µs-equivalent channels; LINK_STATISTICS (0x14) is
+ * kept for link-quality gating. ExpressLRS receivers speak the same protocol
+ * (commonly at a higher baud; see cfg::rc::CRSF_BAUD).
+ *
+ * CRSF carries no failsafe flag: the link counts as lost when no RC frame
+ * arrives within cfg::rc::LINK_TIMEOUT_MS or the receiver reports 0 % LQ.
+ */
+class CrsfTransport
+{
+public:
+    static constexpr std::size_t kChannels = 16; ///< RC_CHANNELS_PACKED channel count.
+
+    /// @brief Latest LINK_STATISTICS payload.
+    struct LinkStats
+    {
+        uint8_t uplink_rssi1{0};     ///< Antenna 1 RSSI (−dBm).
+        uint8_t uplink_rssi2{0};     ///< Antenna 2 RSSI (−dBm).
+        uint8_t uplink_lq{0};        ///< Uplink link quality (%).
+        int8_t uplink_snr{0};        ///< Uplink SNR (dB).
+        uint8_t active_antenna{0};   ///< Diversity antenna in use.
+        uint8_t rf_mode{0};          ///< Packet-rate index.
+        uint8_t tx_power{0};         ///< TX power index.
+        uint8_t downlink_rssi{0};    ///< Downlink RSSI (−dBm).
+        uint8_t downlink_lq{0};      ///< Downlink link quality (%).
+        int8_t downlink_snr{0};      ///< Downlink SNR (dB).
+    };
+
+    /**
+     * @brief Configure the UART (8N1).
+     *
+     * @param port UART to use.
+     * @param rx RX pin.
+     * @param tx TX pin (-1 → receive only, no telemetry).
+     * @param baud Line rate (CRSF 420000; ELRS receivers are often set higher).
+     * @return true If the port was started.
+     */
+    bool begin(HardwareSerial &port, int rx, int tx, uint32_t baud = cfg::rc::CRSF_BAUD) noexcept;
+
+    /**
+     * @brief Consume every waiting byte; decode complete frames.
+     *
+     * @param now_us Current time (µs).
+     * @return true If at least one new RC channels frame was decoded.
+     */
+    bool update(uint64_t now_us) noexcept;
+
+    /// @brief Latest channel values (µs-equivalent).
+    [[nodiscard]] const uint16_t *channels() const noexcept { return ch_.data(); }
+
+    /// @brief Number of channels in channels().
+    [[nodiscard]] static constexpr std::size_t count() noexcept { return kChannels; }
+
+    /**
+     * @brief True if no RC frame arrived within the link timeout or uplink LQ is 0.
+     *
+     * @param now_us Current time (µs).
+     */
+    [[nodiscard]] bool failsafe(uint64_t now_us) const noexcept;
+
+    /// @brief Latest link statistics (zeros until the first 0x14 frame).
+    [[nodiscard]] const LinkStats &linkStats() const noexcept { return stats_; }
+
+    /// @brief RC frames decoded since begin().
+    [[nodiscard]] uint32_t frames() const noexcept { return frames_; }
+
+    /// @brief Frames dropped on a bad length or CRC.
+    [[nodiscard]] uint32_t crcErrors() const noexcept { return crc_errors_; }
+
+    /**
+     * @brief Send a BATTERY_SENSOR telemetry frame (0x08) to the receiver.
+     *
+     * @param volts Pack voltage (V).
+     * @param amps Current draw (A).
+     * @param used_mah Capacity used (mAh).
+     * @param remaining_pct Remaining charge (%).
+     * @return true If the frame was queued on the UART.
+     */
+    bool sendBattery(float volts, float amps, uint32_t used_mah, uint8_t remaining_pct) noexcept;
+
+    /**
+     * @brief Send an arbitrary telemetry frame (address = flight controller).
+     *
+     * @param type CRSF frame type.
+     * @param payload Payload bytes.
+     * @param len Payload length (≤ kMaxPayload).
+     * @return true If the frame was queued on the UART.
+     */
+    bool sendFrame(uint8_t type, const uint8_t *payload, std::size_t len) noexcept;
+
+    static constexpr std::size_t kMaxPayload = 60; ///< Largest payload (64-byte frame limit).
+
+private:
+    static constexpr std::size_t kMaxFrame = 64;      ///< Protocol frame limit (address + len + 62).
+    static constexpr uint8_t kAddrFc = 0xC8;          ///< Flight controller address (sync byte).
+    static constexpr uint8_t kTypeLinkStats = 0x14;   ///< LINK_STATISTICS.
+    static constexpr uint8_t kTypeRcChannels = 0x16;  ///< RC_CHANNELS_PACKED.
+    static constexpr uint8_t kTypeBattery = 0x08;     ///< BATTERY_SENSOR.
+
+    /// @brief True if @p b can start a frame.
+    static bool isSync(uint8_t b) noexcept { return b == kAddrFc || b == 0xEE || b == 0xEA; }
+
+    /// @brief CRC-8/DVB-S2 (poly 0xD5).
+    static uint8_t crc8(const uint8_t *p, std::size_t n) noexcept;
+
+    /// @brief Handle one validated frame at buf_ (type at [2], payload at [3]).
+    void dispatch(uint64_t now_us) noexcept;
+
+    // ---- Internal state ---- //
+    HardwareSerial *port_{nullptr};        ///< Non-owning UART.
+    bool can_send_{false};                 ///< TX pin configured.
+    std::array<uint8_t, kMaxFrame> buf_{}; ///< Receive buffer (frames decode in place).
+    std::size_t len_{0};                   ///< Bytes in buf_.
+    std::array<uint16_t, kChannels> ch_{}; ///< Decoded channels (µs).
+    LinkStats stats_{};                    ///< Latest link statistics.
+    bool have_stats_{false};               ///< At least one 0x14 frame seen.
+    uint64_t last_frame_us_{0};            ///< Time of the last RC frame.
+    uint32_t frames_{0};                   ///< RC frames decoded.
+    uint32_t crc_errors_{0};               ///< Rejected frames.
+};
@@ -0,0 +1,93 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of DebugConsole (serial debug commands).
+ *
+ * @file DebugConsole.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "DebugConsole.h"
+#include <cstring>
+
+// Register a command.
+bool DebugConsole::add(const char *name, Handler fn, const char *help) noexcept
+{
+    if (name == nullptr || fn == nullptr || count_ >= kMaxCommands)
+        return false;
+
+    cmds_[count_++] = Command{name, fn, help ? help : ""};
+    return true;
+}
+
+// Main run loop.
+void DebugConsole::run() noexcept
+{
+    for (;;)
+    {
+        while (Serial.available() > 0)
+        {
+            const int c = Serial.read();
+            if (c < 0)
+                break;
+
+            if (c == '\r' || c == '\n')
+            {
+                if (len_ > 0)
+                {
+                    line_[len_] = '\0';
+                    dispatch(line_);
+                    len_ = 0;
+                }
+                continue;
+            }
+
+            if (len_ < kLineMax - 1)
+                line_[len_++] = static_cast<char>(c); ///< Overlong lines are truncated.
+        }
+
+        vTaskDelay(poll_ticks_); ///< Low-rate poll: the console is never latency critical.
+    }
+}
+
+// Split line into command + args and call the matching handler.
+void DebugConsole::dispatch(char *line) noexcept
+{
+    while (*line == ' ')
+        ++line; ///< Skip leading blanks.
+
+    char *args = line;
+    while (*args != '\0' && *args != ' ')
+        ++args;
+    if (*args != '\0')
+        *args++ = '\0'; ///< Terminate the command word.
+    while (*args == ' ')
+        ++args;
+
+    if (strcmp(line, "help") == 0)
+    {
+        printHelp();
+        return;
+    }
+
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        if (strcmp(line, cmds_[i].name) == 0)
+        {
+            cmds_[i].fn(args);
+            return;
+        }
+    }
+
+    debugfln("Unknown command '%s' (try 'help').", line);
+}
+
+// Print every registered command.
+void DebugConsole::printHelp() const noexcept
+{
+    debugln("Commands:");
+    for (std::size_t i = 0; i < count_; ++i)
+        debugfln("  %-10s %s", cmds_[i].name, cmds_[i].help);
+}
@@ -0,0 +1,85 @@
+/**
+ * MIT License
+ *
+ * @brief Line-based serial debug console with a fixed command table.
+ *
+ * @file DebugConsole.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Reads newline-terminated commands from Serial and dispatches them.
+ *
+ * Modules register `name → handler` pairs with add() during setup(); the
+ * console task then polls Serial at a low priority. The first word of a line
+ * selects the command and the remainder is passed to the handler as @c args
+ * ("" when absent). `help` lists everything registered.
+ */
+class DebugConsole : public rtos::Task<DebugConsole>
+{
+public:
+    /// @brief Command callback. @p args is the text after the command name (never null).
+    using Handler = void (*)(const char *args);
+
+    /**
+     * @brief Construct with the Serial poll interval.
+     *
+     * @param poll_ms How often to check Serial for input (milliseconds).
+     */
+    explicit DebugConsole(uint32_t poll_ms = cfg::console::POLL_MS) noexcept
+        : poll_ticks_(to_ticks_ms(poll_ms) > 0 ? to_ticks_ms(poll_ms) : 1) {}
+
+    /**
+     * @brief Register a command (call before the task starts).
+     *
+     * @param name Command word (static storage).
+     * @param fn Handler.
+     * @param help One-line description (static storage).
+     * @return true If registered (false → table full).
+     */
+    bool add(const char *name, Handler fn, const char *help) noexcept;
+
+private:
+    friend class rtos::Task<DebugConsole>; ///< Task entry calls run().
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /**
+     * @brief Split @p line into command + args and call the matching handler.
+     *
+     * @param line NUL-terminated input line (modified in place).
+     */
+    void dispatch(char *line) noexcept;
+
+    /// @brief Print every registered command.
+    void printHelp() const noexcept;
+
+    // ---- Limits ---- //
+    static constexpr std::size_t kMaxCommands = 16; ///< Command table size.
+    static constexpr std::size_t kLineMax = 64;     ///< Longest accepted line (excess is dropped).
+
+    struct Command
+    {
+        const char *name{nullptr}; ///< Command word.
+        Handler fn{nullptr};       ///< Callback.
+        const char *help{nullptr}; ///< Description.
+    };
+
+    // ---- Internal state ---- //
+    std::array<Command, kMaxCommands> cmds_{}; ///< Registered commands.
+    std::size_t count_{0};                     ///< Used entries in cmds_.
+    char line_[kLineMax]{};                    ///< Line being assembled.
+    std::size_t len_{0};                       ///< Characters in line_.
+    TickType_t poll_ticks_{1};                 ///< Delay (in ticks) between Serial polls.
+};
@@ -0,0 +1,266 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of EspNowLink (Wi-Fi / ESP-NOW bring-up, RC packet intake, telemetry batching).
+ *
+ * @file EspNowLink.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "EspNowLink.h"
+#include <cstring>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+
+namespace
+{
+    std::atomic<bool> s_started{false};             ///< start() succeeded.
+    std::atomic<EspNowTransport *> s_rc{nullptr};   ///< RC packet sink (EspNowTransport::begin()).
+    std::atomic<uint32_t> s_rejected{0};            ///< Packets nobody takes (no sink / unknown magic).
+    std::atomic<uint32_t> s_tx_failed{0};           ///< Send callback: not delivered.
+    std::atomic<uint32_t> s_tx_packets{0};          ///< Telemetry packets queued.
+    std::atomic<uint32_t> s_tx_dropped{0};          ///< esp_now_send() refused.
+
+    /// @brief True if @p mac is the broadcast address.
+    bool broadcast(const uint8_t *mac) noexcept
+    {
+        for (std::size_t i = 0; i < 6; ++i)
+            if (mac[i] != 0xFF)
+                return false;
+        return true;
+    }
+
+    /// @brief ESP-NOW receive callback (Wi-Fi task).
+    void onReceive(const uint8_t *mac, const uint8_t *data, int len)
+    {
+        EspNowTransport *rc = s_rc.load(std::memory_order_acquire);
+        if (rc != nullptr && len > 0 && data[0] == espnow::kRcMagic)
+            rc->deliver(mac, data, len);
+        else
+            s_rejected.fetch_add(1, std::memory_order_relaxed); ///< Other cars' telemetry lands here too.
+    }
+
+    /// @brief ESP-NOW send callback (Wi-Fi task).
+    void onSent(const uint8_t *mac, esp_now_send_status_t status)
+    {
+        (void)mac;
+        if (status != ESP_NOW_SEND_SUCCESS)
+            s_tx_failed.fetch_add(1, std::memory_order_relaxed); ///< Broadcasts are never acknowledged: only "not sent".
+    }
+} // namespace
+
+namespace espnow
+{
+    static constexpr logx::Module kLogModule = logx::Module::Radio; ///< Filter for this module's log* sites.
+}
+
+// ---- espnow ---- //
+
+// Bring up Wi-Fi and ESP-NOW.
+bool espnow::start() noexcept
+{
+    if (s_started.load(std::memory_order_acquire))
+        return true;
+
+    WiFi.mode(WIFI_STA); ///< Radio on; never associates.
+    WiFi.disconnect();
+    esp_wifi_set_ps(WIFI_PS_NONE); ///< Modem sleep would add up to a DTIM period of receive latency.
+    if (esp_wifi_set_channel(cfg::espnow::CHANNEL, WIFI_SECOND_CHAN_NONE) != ESP_OK || esp_now_init() != ESP_OK)
+    {
+        logError("EspNow: radio start failed.");
+        return false;
+    }
+    esp_now_register_recv_cb(&onReceive);
+    esp_now_register_send_cb(&onSent);
+
+    esp_now_peer_info_t peer{};
+    memcpy(peer.peer_addr, cfg::espnow::PIT_MAC, sizeof(peer.peer_addr));
+    peer.channel = cfg::espnow::CHANNEL;
+    peer.ifidx = WIFI_IF_STA;
+    peer.encrypt = false;
+    if (!esp_now_is_peer_exist(peer.peer_addr) && esp_now_add_peer(&peer) != ESP_OK)
+    {
+        logError("EspNow: pit peer not added.");
+        return false;
+    }
+
+    s_started.store(true, std::memory_order_release);
+    logInfo("EspNow: car %u on channel %u.", static_cast<unsigned>(cfg::espnow::CAR_ID), static_cast<unsigned>(cfg::espnow::CHANNEL));
+    return true;
+}
+
+// Link counters.
+espnow::Stats espnow::stats() noexcept
+{
+    Stats s{};
+    if (EspNowTransport *rc = s_rc.load(std::memory_order_acquire))
+    {
+        s.rc_packets = rc->frames();
+        s.rc_rejected = rc->crcErrors();
+    }
+    s.rc_rejected += s_rejected.load(std::memory_order_relaxed);
+    s.tx_packets = s_tx_packets.load(std::memory_order_relaxed);
+    s.tx_failed = s_tx_failed.load(std::memory_order_relaxed);
+    s.tx_dropped = s_tx_dropped.load(std::memory_order_relaxed);
+    return s;
+}
+
+// ---- EspNowTransport ---- //
+
+// Start ESP-NOW and take over the RC packets.
+bool EspNowTransport::begin() noexcept
+{
+    ch_.fill(1500);
+    EspNowTransport *none = nullptr;
+    configASSERT(s_rc.compare_exchange_strong(none, this, std::memory_order_acq_rel) || none == this); ///< One RC sink.
+    return espnow::start();
+}
+
+// Frame hook.
+void EspNowTransport::onFrame(FrameHook hook, void *ctx) noexcept
+{
+    hook_ctx_.store(ctx, std::memory_order_relaxed);
+    hook_.store(hook, std::memory_order_release);
+}
+
+// Wi-Fi task: one received RC packet.
+void EspNowTransport::deliver(const uint8_t *mac, const uint8_t *data, int len) noexcept
+{
+    espnow::RcPacket p{};
+    if (len != static_cast<int>(sizeof(p)))
+    {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    memcpy(&p, data, sizeof(p));
+    if (p.car != cfg::espnow::CAR_ID || p.count > espnow::kRcChannels ||
+        (!broadcast(cfg::espnow::RC_MAC) && memcmp(mac, cfg::espnow::RC_MAC, 6) != 0))
+    {
+        rejected_.fetch_add(1, std::memory_order_relaxed); ///< Another car's frame, or a sender we are not paired with.
+        return;
+    }
+
+    inbox_.publish(p);
+    if (FrameHook hook = hook_.load(std::memory_order_acquire))
+        hook(hook_ctx_.load(std::memory_order_relaxed));
+}
+
+// Take the newest packet.
+bool EspNowTransport::update(uint64_t now_us) noexcept
+{
+    const uint32_t seq = inbox_.sequence();
+    if (seq == seen_)
+        return false;
+    seen_ = seq;
+
+    const espnow::RcPacket p = inbox_.peek();
+    for (std::size_t i = 0; i < kChannels; ++i)
+        ch_[i] = (i < p.count) ? p.ch[i] : 1500;
+    pit_failsafe_ = (p.flags & espnow::kRcFailsafe) != 0;
+
+    if (has_seq_)
+        lost_ += static_cast<uint16_t>(p.seq - last_seq_ - 1); ///< Wraps with the sender's counter.
+    has_seq_ = true;
+    last_seq_ = p.seq;
+
+    last_frame_us_ = now_us;
+    ++frames_;
+    return true;
+}
+
+// Failsafe: pit flag or link timeout.
+bool EspNowTransport::failsafe(uint64_t now_us) const noexcept
+{
+    if (frames_ == 0)
+        return true;
+    return pit_failsafe_ || (now_us - last_frame_us_) > static_cast<uint64_t>(cfg::rc::LINK_TIMEOUT_MS) * 1000ULL;
+}
+
+// ---- EspNowTelemetry ---- //
+
+// Watch a bus.
+bool EspNowTelemetry::add(Tap &tap) noexcept
+{
+    if (n_taps_ >= kMaxTaps)
+        return false;
+    taps_[n_taps_++] = &tap;
+    return true;
+}
+
+// Fill buf_ with this period's entries.
+std::size_t EspNowTelemetry::fill(uint64_t now) noexcept
+{
+    espnow::TelHeader h{};
+    h.car = cfg::espnow::CAR_ID;
+    h.seq = seq_;
+    std::size_t at = sizeof(h);
+    uint32_t n = 0;
+
+    // Fresh payloads first, starting one tap further on each packet.
+    for (std::size_t k = 0; k < n_taps_; ++k)
+    {
+        Tap &tap = *taps_[(next_tap_ + k) % n_taps_];
+        if (const std::size_t w = tap.poll(buf_.data() + at, buf_.size() - at))
+        {
+            at += w;
+            ++n;
+        }
+    }
+    next_tap_ = (n_taps_ > 0) ? (next_tap_ + 1) % n_taps_ : 0;
+
+    // Then descriptors into the room left, resuming where the last packet stopped.
+    if (!describing_ && now - described_us_ >= describe_us_)
+        describing_ = true;
+    while (describing_ && desc_tap_ < n_taps_)
+    {
+        const Tap &tap = *taps_[desc_tap_];
+        const std::size_t w = tap.describe(desc_i_, buf_.data() + at, buf_.size() - at);
+        if (w == 0)
+            break; ///< Packet full: carry on next period.
+        at += w;
+        ++n;
+        if (++desc_i_ >= tap.descriptors())
+        {
+            desc_i_ = 0;
+            ++desc_tap_;
+        }
+    }
+    if (describing_ && desc_tap_ >= n_taps_)
+    {
+        describing_ = false;
+        desc_tap_ = 0;
+        described_us_ = now;
+    }
+
+    if (n == 0)
+        return 0;
+    h.entries = static_cast<uint8_t>(n);
+    memcpy(buf_.data(), &h, sizeof(h));
+    entries_.fetch_add(n, std::memory_order_relaxed);
+    return at;
+}
+
+// Main run loop.
+void EspNowTelemetry::run() noexcept
+{
+    for (std::size_t i = 0; i < n_taps_; ++i)
+        taps_[i]->attach(); ///< Subscriptions belong to this task.
+
+    TickType_t last_wake = xTaskGetTickCount();
+    for (;;)
+    {
+        const std::size_t n = fill(now_us());
+        if (n > 0)
+        {
+            if (esp_now_send(cfg::espnow::PIT_MAC, buf_.data(), n) == ESP_OK)
+                s_tx_packets.fetch_add(1, std::memory_order_relaxed);
+            else
+                s_tx_dropped.fetch_add(1, std::memory_order_relaxed); ///< Wi-Fi queue full: never wait for it.
+            ++seq_;
+        }
+        vTaskDelayUntil(&last_wake, period_ticks_);
+    }
+}
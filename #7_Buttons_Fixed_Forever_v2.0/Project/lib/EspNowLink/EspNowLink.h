@@ -0,0 +1,320 @@
+/**
+ * MIT License
+ *
+ * @brief ESP-NOW link: RC frames in from the pit station (RcPublisher source), batched packed telemetry out.
+ *
+ * @file EspNowLink.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <SnapshotBus.h>
+#include <SignalBus.h>
+#include <BusSchema.h>
+
+namespace espnow
+{
+    // ---- Wire format ---- //
+    //
+    // Pit → car   RcPacket (one RC frame; channels in iBUS-equivalent µs, like SbusTransport).
+    // Car → pit   TelHeader, then `entries` × (schema:u8 len:u8 payload[len]), ≤ kMaxPacket in all.
+    //             Payloads are wire::Codec layouts or wire::describe() descriptors (schema 0), the
+    //             same (schema, payload) pairs TelemetryStream frames: a pit receiver re-frames
+    //             each entry with telem::encodeFrame() and tools/telemetry_decode.py reads it.
+    // ESP-NOW frames carry the MAC CRC, so neither direction adds a checksum.
+
+    static constexpr std::size_t kMaxPacket = 250; ///< ESP_NOW_MAX_DATA_LEN.
+    static constexpr std::size_t kRcChannels = 16; ///< Channels per RcPacket.
+    static constexpr uint8_t kRcMagic = 0xC5;      ///< RcPacket::magic.
+    static constexpr uint8_t kTelMagic = 0x7E;     ///< TelHeader::magic.
+    static constexpr uint8_t kRcFailsafe = 0x01;   ///< RcPacket::flags: transmitter-side failsafe.
+
+    /// @brief Pit → car: one RC frame.
+    struct RcPacket
+    {
+        uint8_t magic{kRcMagic};                ///< kRcMagic.
+        uint8_t car{0};                         ///< Addressed car (cfg::espnow::CAR_ID).
+        uint16_t seq{0};                        ///< Sender's frame counter (gaps = lost packets).
+        uint8_t flags{0};                       ///< kRcFailsafe.
+        uint8_t count{0};                       ///< Channels used (≤ kRcChannels; the rest stay centred).
+        std::array<uint16_t, kRcChannels> ch{}; ///< Channel values (µs, 1000..2000).
+    };
+
+    /// @brief Car → pit: packet header.
+    struct TelHeader
+    {
+        uint8_t magic{kTelMagic}; ///< kTelMagic.
+        uint8_t car{0};           ///< Sending car (cfg::espnow::CAR_ID).
+        uint16_t seq{0};          ///< Packet counter (gaps = packets the radio dropped).
+        uint8_t entries{0};       ///< Entries that follow.
+        uint8_t reserved{0};      ///< Zero.
+    };
+
+    static_assert(sizeof(RcPacket) == 38, "RcPacket is wire format: update the pit station together.");
+    static_assert(sizeof(TelHeader) == 6, "TelHeader is wire format: update the pit station together.");
+
+    /// @brief Link counters.
+    struct Stats
+    {
+        uint32_t rc_packets{0};  ///< RC packets accepted.
+        uint32_t rc_rejected{0}; ///< Packets ignored (size, magic, car, sender).
+        uint32_t tx_packets{0};  ///< Telemetry packets queued.
+        uint32_t tx_failed{0};   ///< ...the radio reported undelivered (unicast) / not sent.
+        uint32_t tx_dropped{0};  ///< Packets esp_now_send() refused (queue full).
+    };
+
+    /**
+     * @brief Bring up Wi-Fi (STA, never associated) and ESP-NOW, and register the pit peer.
+     *
+     * Call from setup() before either end of the link starts. Idempotent.
+     *
+     * @return true If ESP-NOW is running.
+     */
+    bool start() noexcept;
+
+    /// @brief Link counters since start().
+    [[nodiscard]] Stats stats() noexcept;
+} ///< Namespace espnow.
+
+/**
+ * @brief RC receiver over ESP-NOW (rc::PROTOCOL == EspNow), for RcPublisher's MappedSource.
+ *
+ * The radio receive callback runs in the Wi-Fi task (core 0): it checks the
+ * packet, publishes it into a one-slot SnapshotBus and calls the frame hook,
+ * nothing more. update() then copies the newest packet on the publisher's
+ * own task, so the role mapping, change gate and link statistics are the
+ * same as for SBUS / CRSF.
+ *
+ * @note ESP-NOW has a single receive callback: one EspNowTransport per firmware.
+ */
+class EspNowTransport
+{
+public:
+    static constexpr std::size_t kChannels = espnow::kRcChannels; ///< Channels per packet.
+
+    /// @brief Frame hook (Wi-Fi task; keep it short).
+    using FrameHook = void (*)(void *ctx);
+
+    /**
+     * @brief Start ESP-NOW and take over the RC packets.
+     *
+     * @return true If ESP-NOW is running.
+     */
+    bool begin() noexcept;
+
+    /**
+     * @brief Call @p hook after every accepted packet (RcPublisher's wake-up).
+     *
+     * @param hook Function (nullptr → none).
+     * @param ctx Passed back.
+     */
+    void onFrame(FrameHook hook, void *ctx) noexcept;
+
+    /**
+     * @brief Take the newest packet, if one arrived.
+     *
+     * @param now_us Current time (µs).
+     * @return true If a new frame was taken.
+     */
+    bool update(uint64_t now_us) noexcept;
+
+    /// @brief Latest channel values (µs).
+    [[nodiscard]] const uint16_t *channels() const noexcept { return ch_.data(); }
+
+    /// @brief Number of channels in channels().
+    [[nodiscard]] static constexpr std::size_t count() noexcept { return kChannels; }
+
+    /**
+     * @brief True if the pit flags failsafe or no packet arrived within the link timeout.
+     *
+     * @param now_us Current time (µs).
+     */
+    [[nodiscard]] bool failsafe(uint64_t now_us) const noexcept;
+
+    /// @brief Packets taken since begin().
+    [[nodiscard]] uint32_t frames() const noexcept { return frames_; }
+
+    /// @brief Packets lost on the air (sequence gaps).
+    [[nodiscard]] uint32_t lostFrames() const noexcept { return lost_; }
+
+    /// @brief Packets rejected (wrong size / magic / car / sender).
+    [[nodiscard]] uint32_t crcErrors() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+    /// @brief Wi-Fi task: one received RC packet (called by the ESP-NOW receive callback).
+    void deliver(const uint8_t *mac, const uint8_t *data, int len) noexcept;
+
+private:
+    // ---- Wi-Fi task side ---- //
+    snapshot::SnapshotBus<espnow::RcPacket> inbox_{}; ///< Newest packet (single writer: Wi-Fi task).
+    std::atomic<uint32_t> rejected_{0};               ///< Packets ignored.
+    std::atomic<FrameHook> hook_{nullptr};            ///< Frame hook.
+    std::atomic<void *> hook_ctx_{nullptr};           ///< Its argument.
+
+    // ---- Publisher side ---- //
+    uint32_t seen_{0};                     ///< inbox_ sequence taken last.
+    std::array<uint16_t, kChannels> ch_{}; ///< Channels (µs).
+    bool pit_failsafe_{true};              ///< kRcFailsafe of the last packet.
+    bool has_seq_{false};                  ///< last_seq_ valid.
+    uint16_t last_seq_{0};                 ///< Last packet's seq.
+    uint64_t last_frame_us_{0};            ///< Time the last packet was taken.
+    uint32_t frames_{0};                   ///< Packets taken.
+    uint32_t lost_{0};                     ///< Sequence gaps.
+};
+
+/**
+ * @brief Batched telemetry over ESP-NOW: every fresh tapped bus in one packet per period.
+ *
+ * A fixed-rate task (cfg::espnow::TX_PERIOD_MS) on the radio core. Each
+ * pass copies the newest value of every tapped bus that published since the
+ * last packet, packs it with wire::Codec and appends it to one ≤ 250-byte
+ * packet; descriptors fill whatever room is left until the layout has gone
+ * out again (every cfg::espnow::DESCRIBE_MS). esp_now_send() only queues the
+ * packet for the Wi-Fi task, so a pass costs the copies and encodes and never
+ * waits on the air; a full queue drops the packet (counted; the seq gap shows
+ * it at the pit).
+ *
+ * Producers never wait on the link: the task reads through its own
+ * subscriptions only. Pin it to core 0 with the Wi-Fi stack and the control
+ * core never runs radio code.
+ */
+class EspNowTelemetry : public rtos::Task<EspNowTelemetry>
+{
+public:
+    static constexpr std::size_t kMaxTaps = 6; ///< Watched buses.
+
+    /**
+     * @brief One watched bus (type-erased so the task can hold a mixed list).
+     */
+    class Tap
+    {
+    public:
+        virtual ~Tap() = default;
+
+        /// @brief Subscribe from the telemetry task.
+        virtual void attach() noexcept = 0;
+
+        /**
+         * @brief Append one entry for the newest value, if it is new and fits.
+         *
+         * @param out Entry position.
+         * @param room Bytes left in the packet.
+         * @return std::size_t Bytes written (0: nothing new, or no room: the value waits for the next packet).
+         */
+        virtual std::size_t poll(uint8_t *out, std::size_t room) noexcept = 0;
+
+        /// @brief Descriptor entries (fields + table name).
+        [[nodiscard]] virtual std::size_t descriptors() const noexcept = 0;
+
+        /**
+         * @brief Append descriptor @p i as one entry.
+         *
+         * @return std::size_t Bytes written (0 if it does not fit).
+         */
+        virtual std::size_t describe(std::size_t i, uint8_t *out, std::size_t room) const noexcept = 0;
+    };
+
+    /**
+     * @brief Tap on a SignalBus / ViewBus, streamed in its wire::Codec layout.
+     *
+     * @tparam Bus Bus type; Bus::value_type needs a wire::Fields specialisation.
+     */
+    template <typename Bus>
+    class PackedTap final : public Tap
+    {
+    public:
+        using T = typename Bus::value_type;
+        using Codec = wire::Codec<T>;
+        static_assert(2 + Codec::kBytes <= espnow::kMaxPacket - sizeof(espnow::TelHeader),
+                      "Packed payload does not fit one ESP-NOW packet.");
+
+        /// @brief Watch @p bus (non-owning).
+        explicit PackedTap(Bus &bus) noexcept : bus_(&bus) {}
+
+        void attach() noexcept override { sub_ = bus_->subscribe(); }
+
+        std::size_t poll(uint8_t *out, std::size_t room) noexcept override
+        {
+            if (room < 2 + Codec::kBytes || !sub_.fresh())
+                return 0;
+            T v{};
+            if (!sub_.take(v))
+                return 0;
+            out[0] = Codec::kId;
+            out[1] = static_cast<uint8_t>(Codec::kBytes);
+            Codec::encode(v, out + 2);
+            return 2 + Codec::kBytes;
+        }
+
+        [[nodiscard]] std::size_t descriptors() const noexcept override { return Codec::kCount + 1; }
+
+        std::size_t describe(std::size_t i, uint8_t *out, std::size_t room) const noexcept override
+        {
+            if (room < 2 + wire::kMaxDescribe)
+                return 0;
+            const std::size_t n = wire::describe<T>(i, out + 2);
+            out[0] = wire::kDescribeId;
+            out[1] = static_cast<uint8_t>(n);
+            return 2 + n;
+        }
+
+    private:
+        Bus *bus_;                          ///< Non-owning bus.
+        snapshot::Subscription<Bus> sub_{}; ///< Telemetry task's subscription.
+    };
+
+    /**
+     * @brief Construct with a packet period.
+     *
+     * @param period_ms Packet period (ms).
+     * @param describe_ms Descriptor repeat interval (ms).
+     */
+    explicit EspNowTelemetry(uint32_t period_ms = cfg::espnow::TX_PERIOD_MS,
+                             uint32_t describe_ms = cfg::espnow::DESCRIBE_MS) noexcept
+        : period_ticks_(to_ticks_ms(period_ms) > 0 ? to_ticks_ms(period_ms) : 1), describe_us_(1000ULL * describe_ms) {}
+
+    /**
+     * @brief Watch a bus (call before the task starts; @p tap must outlive the task).
+     *
+     * @return true If there was a free slot.
+     */
+    bool add(Tap &tap) noexcept;
+
+    /// @brief Entries packed since start (payloads + descriptors).
+    [[nodiscard]] uint32_t entries() const noexcept { return entries_.load(std::memory_order_relaxed); }
+
+private:
+    friend class rtos::Task<EspNowTelemetry>; ///< Task entry calls run().
+
+    /// @brief Main run loop: one packet per period.
+    void run() noexcept;
+
+    /**
+     * @brief Fill buf_ with this period's entries.
+     *
+     * @param now Current time (µs).
+     * @return std::size_t Packet bytes (0: nothing to send).
+     */
+    std::size_t fill(uint64_t now) noexcept;
+
+    TickType_t period_ticks_;                       ///< Packet period.
+    uint64_t describe_us_;                          ///< Descriptor repeat interval.
+    std::array<Tap *, kMaxTaps> taps_{};            ///< Watched buses.
+    std::size_t n_taps_{0};                         ///< Used taps.
+    std::array<uint8_t, espnow::kMaxPacket> buf_{}; ///< Packet being built.
+    uint16_t seq_{0};                               ///< Next packet seq.
+    std::size_t next_tap_{0};                       ///< Round-robin start (a full packet never starves the last tap).
+    bool describing_{true};                         ///< A descriptor pass is under way.
+    std::size_t desc_tap_{0};                       ///< Descriptor cursor: tap...
+    std::size_t desc_i_{0};                         ///< ...and entry.
+    uint64_t described_us_{0};                      ///< When the last descriptor pass finished.
+    std::atomic<uint32_t> entries_{0};              ///< Entries packed.
+};
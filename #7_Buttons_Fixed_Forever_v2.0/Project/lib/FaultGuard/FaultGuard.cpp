@@ -0,0 +1,212 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of FaultGuard (bridge fault / over-voltage protection).
+ *
+ * @file FaultGuard.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "FaultGuard.h"
+#include <soc/gpio_reg.h>
+
+// Add a bridge enable pin the trip path drives low.
+void FaultGuard::killPin(int en_pin) noexcept
+{
+    if (en_pin < 0)
+        return;
+    if (en_pin < 32)
+        kill_lo_ |= 1UL << en_pin;
+    else
+        kill_hi_ |= 1UL << (en_pin - 32);
+}
+
+// Add an MCPWM timer whose outputs the fault input forces low.
+void FaultGuard::mcpwmTimer(mcpwm_unit_t unit, mcpwm_timer_t timer) noexcept
+{
+    configASSERT(n_timers_ < kMaxTimers);
+    if (n_timers_ < kMaxTimers)
+        timers_[n_timers_++] = {unit, timer};
+}
+
+// Arm the fault input and MCPWM fault actions.
+bool FaultGuard::begin() noexcept
+{
+    bool armed = false;
+
+    if (fault_pin_ >= 0)
+    {
+        pinMode(fault_pin_, active_low_ ? INPUT_PULLUP : INPUT_PULLDOWN);
+
+        // Hardware layer: FAULT0 of each unit in use, both generators forced low while asserted.
+        // Cycle-by-cycle (not one-shot): the latch lives in software, so clear() needs no register poking.
+        bool unit_armed[2] = {false, false};
+        for (std::size_t i = 0; i < n_timers_; ++i)
+        {
+            const Timer &t = timers_[i];
+            if (!unit_armed[t.unit])
+            {
+                mcpwm_gpio_init(t.unit, MCPWM_FAULT_0, fault_pin_);
+                mcpwm_fault_init(t.unit, active_low_ ? MCPWM_LOW_LEVEL_TGR : MCPWM_HIGH_LEVEL_TGR, MCPWM_SELECT_F0);
+                unit_armed[t.unit] = true;
+            }
+            mcpwm_fault_set_cyc_mode(t.unit, t.timer, MCPWM_SELECT_F0, MCPWM_ACTION_FORCE_LOW, MCPWM_ACTION_FORCE_LOW);
+        }
+
+        // ISR layer: drops EN for every backend (the interrupt lands on the calling core).
+        attachInterruptArg(fault_pin_, &FaultGuard::onFaultISR, this, active_low_ ? FALLING : RISING);
+        if (pinActive())
+            trip(FaultSnapshot::Pin); ///< Asserted before the edge could be seen.
+        armed = true;
+    }
+
+    if (power_ != nullptr)
+        armed = true; ///< Frames start arriving once AdcService runs.
+
+    if (cfg::supervisor::ENABLED && cfg::supervisor::RESPONSE == cfg::supervisor::Response::Coast && (kill_lo_ | kill_hi_) != 0)
+        armed = true; ///< force() is a layer of its own.
+
+    logInfo("FaultGuard: fault pin %d (%u MCPWM timers), Vbus %s (trip %.1f V, clear %.1f V).", fault_pin_,
+            static_cast<unsigned>(n_timers_), power_ != nullptr ? "monitored" : "not monitored",
+            static_cast<double>(cfg::fault::OV_VOLTS), static_cast<double>(cfg::fault::CLEAR_VOLTS));
+    return armed;
+}
+
+// Ask the guard task to clear the latch.
+bool FaultGuard::clear() noexcept
+{
+    const bool ok = !pinActive() && vbusClear();
+    if (ok)
+    {
+        clear_req_.store(true, std::memory_order_release);
+        if (task_ != nullptr)
+            xTaskNotifyGive(task_);
+    }
+    return ok;
+}
+
+// Trip from software.
+void FaultGuard::force(uint8_t causes) noexcept
+{
+    trip(causes);
+    if (task_ != nullptr)
+        xTaskNotifyGive(task_); ///< Publish now, not at the next report.
+}
+
+// Main run loop.
+void FaultGuard::run() noexcept
+{
+    configASSERT(bus_ != nullptr); ///< Sanity check: bus_ must be valid.
+
+    task_ = xTaskGetCurrentTaskHandle(); ///< ISR / clear() notification target.
+
+    const uint64_t report_us = static_cast<uint64_t>(cfg::fault::REPORT_MS) * 1000ULL;
+    uint8_t last_latched = 0xFF; ///< Forces the first publish.
+    uint32_t last_trips = 0;     ///< Trips already handed to the hook.
+    uint64_t last_report = 0;    ///< Time of the previous publish.
+
+    snapshot::Subscription<PowerBus> power_sub{}; ///< Woken on every frame (shares the ISR / clear() notification).
+    if (power_ != nullptr)
+        power_sub = power_->subscribe();
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, to_ticks_ms(cfg::fault::REPORT_MS)); ///< Frame, fault edge, clear() or report time.
+
+        PowerSnapshot p{};
+        if (power_sub.take(p) && p.has_vbus)
+        {
+            vbus_v_.store(p.vbus_v, std::memory_order_relaxed);
+            if (p.vbus_v > cfg::fault::OV_VOLTS)
+                trip(FaultSnapshot::OverVoltage);
+        }
+
+        // Clear only if nothing re-tripped since the check (the ISR may fetch_or at any time).
+        if (clear_req_.exchange(false, std::memory_order_acq_rel) && !pinActive() && vbusClear())
+        {
+            uint8_t seen = latched_.load(std::memory_order_acquire);
+            if (latched_.compare_exchange_strong(seen, 0, std::memory_order_acq_rel))
+                logInfo("FaultGuard: cleared.");
+        }
+
+        const uint8_t latched = latched_.load(std::memory_order_acquire);
+        const uint32_t trips = trips_.load(std::memory_order_acquire);
+        const uint64_t now = now_us();
+        if (latched == last_latched && trips == last_trips && (now - last_report) < report_us)
+            continue;
+
+        publish(now);
+        last_latched = latched;
+        last_report = now;
+
+        if (trips != last_trips)
+        {
+            last_trips = trips;
+            logError("FaultGuard: TRIP (%s), bridge off.", FaultSnapshot::causeName(latched));
+            if (hook_ != nullptr)
+                hook_(latched);
+        }
+    }
+}
+
+// Fault input asserted right now.
+bool FaultGuard::pinActive() const noexcept
+{
+    return fault_pin_ >= 0 && digitalRead(fault_pin_) == (active_low_ ? LOW : HIGH);
+}
+
+// True if Vbus is known and at or below CLEAR_VOLTS (or not monitored).
+bool FaultGuard::vbusClear() const noexcept
+{
+    if (power_ == nullptr)
+        return true;
+    return power_->sequence() != 0 && vbus_v_.load(std::memory_order_relaxed) <= cfg::fault::CLEAR_VOLTS;
+}
+
+// Drop EN and latch causes.
+void IRAM_ATTR FaultGuard::trip(uint8_t causes) noexcept
+{
+    if (kill_lo_ != 0)
+        REG_WRITE(GPIO_OUT_W1TC_REG, kill_lo_); ///< One store per bank: every EN pin low at once.
+    if (kill_hi_ != 0)
+        REG_WRITE(GPIO_OUT1_W1TC_REG, kill_hi_);
+
+    const uint8_t before = latched_.fetch_or(causes, std::memory_order_acq_rel);
+    if (before == 0)
+    {
+        trip_us_.store(now_us(), std::memory_order_relaxed);
+        trips_.fetch_add(1, std::memory_order_release); ///< After the stamp: the task reads both once it sees the count.
+    }
+}
+
+// Publish the current state.
+void FaultGuard::publish(uint64_t now) noexcept
+{
+    const float vbus = vbus_v_.load(std::memory_order_relaxed);
+
+    FaultSnapshot s{};
+    s.latched = latched_.load(std::memory_order_acquire);
+    s.active = static_cast<uint8_t>((pinActive() ? FaultSnapshot::Pin : 0) |
+                                    ((power_ != nullptr && vbus > cfg::fault::OV_VOLTS) ? FaultSnapshot::OverVoltage : 0));
+    s.trips = static_cast<uint16_t>(trips_.load(std::memory_order_acquire));
+    s.vbus_v = vbus;
+    s.trip_us = trip_us_.load(std::memory_order_relaxed);
+    s.stamp_us = now;
+    bus_->publish(s);
+}
+
+// Fault input edge ISR.
+void IRAM_ATTR FaultGuard::onFaultISR(void *self) noexcept
+{
+    auto *g = static_cast<FaultGuard *>(self);
+    g->trip(FaultSnapshot::Pin); ///< Bridge off first; everything else can wait for the task.
+
+    if (g->task_ == nullptr)
+        return; ///< Task not started yet: it publishes the latch on its first pass.
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(g->task_, &woken);
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,163 @@
+/**
+ * MIT License
+ *
+ * @brief Bridge protection: fault-input ISR / MCPWM fault detect and PowerBus over-voltage trip.
+ *
+ * @file FaultGuard.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <driver/mcpwm.h>
+#include <FaultBus.h>
+#include <PowerBus.h>
+
+/**
+ * @brief Turns the bridge off on a driver fault or bus over-voltage without waiting for a task.
+ *
+ * Three layers, fastest first:
+ *  - MCPWM fault detect (Mcpwm / McpwmArray backends): FAULT_PIN is routed to
+ *    the unit's FAULT0 input and every registered timer forces both outputs
+ *    low cycle-by-cycle while it is asserted. Pure hardware, no CPU.
+ *  - GPIO ISR: the FAULT_PIN edge writes every registered EN pin low through
+ *    the W1TC registers (a few µs, any backend), latches the cause and wakes
+ *    the guard task.
+ *  - Over-voltage: the guard subscribes to PowerBus (AdcService, one DMA
+ *    frame per publish) and compares every frame's mean Vbus with OV_VOLTS
+ *    as it lands; a trip drops EN the same way. The check interval is one
+ *    frame (cfg::adc::FRAME_SAMPLES / cfg::adc::SAMPLE_HZ).
+ *
+ * A fourth, software-only path: force() (the Supervisor, when a control
+ * task stalls) drops EN and latches like the others.
+ *
+ * The guard task then publishes FaultSnapshot on FaultBus (PowerDriveHandler
+ * coasts and holds until cleared) and calls the trip hook. A trip stays
+ * latched until clear() succeeds: the fault input released and Vbus below
+ * CLEAR_VOLTS.
+ */
+class FaultGuard : public rtos::Task<FaultGuard>
+{
+public:
+    /// @brief Called from the guard task after a trip is published (e.g. arm the flight recorder).
+    using TripHook = void (*)(uint8_t causes);
+
+    static constexpr std::size_t kMaxTimers = 6; ///< MCPWM timers with fault actions (both units).
+
+    /**
+     * @brief Construct with pin mapping (no hardware access).
+     *
+     * @param bus Fault bus to publish on (non-owning).
+     * @param fault_pin Driver fault input (-1 → none).
+     * @param active_low Fault input asserted level.
+     * @param power Power bus with Vbus (non-owning; nullptr → no over-voltage monitor).
+     */
+    explicit FaultGuard(FaultBus &bus, int fault_pin = cfg::fault::FAULT_PIN, bool active_low = cfg::fault::ACTIVE_LOW,
+                        PowerBus *power = nullptr) noexcept
+        : bus_(&bus), fault_pin_(fault_pin), active_low_(active_low), power_(power) {}
+
+    /**
+     * @brief Add a bridge enable pin the trip path drives low (before begin()).
+     *
+     * @param en_pin Enable GPIO (-1 → ignored).
+     */
+    void killPin(int en_pin) noexcept;
+
+    /**
+     * @brief Add an MCPWM timer whose outputs the fault input forces low (before begin(), after the backend's begin()).
+     *
+     * @param unit MCPWM unit.
+     * @param timer Timer / operator driving one bridge.
+     */
+    void mcpwmTimer(mcpwm_unit_t unit, mcpwm_timer_t timer) noexcept;
+
+    /// @brief Hook run by the guard task after each trip (optional).
+    void onTrip(TripHook hook) noexcept { hook_ = hook; }
+
+    /**
+     * @brief Arm the fault input and MCPWM fault actions.
+     *
+     * @return true If at least one protection layer is armed (force() counts when an EN pin is registered
+     *              and cfg::supervisor answers stalls with Coast).
+     */
+    bool begin() noexcept;
+
+    /**
+     * @brief Ask the guard task to clear the latch (any task).
+     *
+     * @return true If the fault input is released and Vbus is below CLEAR_VOLTS now
+     *              (the guard task re-checks before it publishes the clear).
+     */
+    bool clear() noexcept;
+
+    /**
+     * @brief Trip from software (any task): EN low now, @p causes latched until clear().
+     *
+     * @param causes FaultSnapshot::Cause bits (e.g. Watchdog).
+     */
+    void force(uint8_t causes) noexcept;
+
+    /// @brief True while a trip is latched (ISR-updated; any task).
+    [[nodiscard]] bool tripped() const noexcept { return latched_.load(std::memory_order_acquire) != 0; }
+
+    /// @brief True if the over-voltage monitor is running.
+    [[nodiscard]] bool monitoring() const noexcept { return power_ != nullptr && power_->sequence() != 0; }
+
+private:
+    friend class rtos::Task<FaultGuard>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Fault; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /// @brief True if Vbus is known and at or below CLEAR_VOLTS (or not monitored).
+    [[nodiscard]] bool vbusClear() const noexcept;
+
+    /// @brief Fault input asserted right now.
+    [[nodiscard]] bool pinActive() const noexcept;
+
+    /// @brief Drop EN and latch @p causes (ISR or task).
+    void trip(uint8_t causes) noexcept;
+
+    /// @brief Publish the current state.
+    void publish(uint64_t now) noexcept;
+
+    /// @brief Fault input edge ISR. Arg is `this`.
+    static void onFaultISR(void *self) noexcept;
+
+    FaultBus *bus_{nullptr};     ///< Non-owning fault bus.
+    int fault_pin_{-1};          ///< Fault input GPIO.
+    bool active_low_{true};      ///< Fault input polarity.
+    PowerBus *power_{nullptr};   ///< Non-owning power bus (nullptr → no OV monitor).
+    TripHook hook_{nullptr};     ///< Post-trip callback.
+    TaskHandle_t task_{nullptr}; ///< Guard task (ISR notification target).
+
+    // ---- Trip path (ISR-visible) ---- //
+    uint32_t kill_lo_{0};                ///< EN pins 0..31 (GPIO_OUT_W1TC mask).
+    uint32_t kill_hi_{0};                ///< EN pins 32..48 (GPIO_OUT1_W1TC mask).
+    std::atomic<uint8_t> latched_{0};    ///< Latched causes.
+    std::atomic<uint32_t> trips_{0};     ///< Trips since boot.
+    std::atomic<uint64_t> trip_us_{0};   ///< Latest trip time.
+    std::atomic<bool> clear_req_{false}; ///< clear() asked the task to drop the latch.
+
+    // ---- MCPWM fault actions ---- //
+    struct Timer
+    {
+        mcpwm_unit_t unit;   ///< Unit.
+        mcpwm_timer_t timer; ///< Timer.
+    };
+    std::array<Timer, kMaxTimers> timers_{}; ///< Registered timers.
+    std::size_t n_timers_{0};                ///< Used entries.
+
+    // ---- Over-voltage monitor ---- //
+    std::atomic<float> vbus_v_{0.0f}; ///< Latest frame Vbus (V).
+};
@@ -0,0 +1,224 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of FlashLog (MPSC record ring, sector-image writer, erase-ahead).
+ *
+ * @file FlashLog.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "FlashLog.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t kErased = 0xFFFFFFFF; ///< Blank flash word.
+} // namespace
+
+// Construct.
+FlashLog::FlashLog() noexcept
+{
+    image_.fill(0xFF);
+}
+
+// Find the partition and locate the log head.
+bool FlashLog::begin(const char *label, uint8_t subtype) noexcept
+{
+    part_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, static_cast<esp_partition_subtype_t>(subtype), label);
+    if (part_ == nullptr)
+    {
+        logWarn("FlashLog: no '%s' partition (data, 0x%02x).", label, static_cast<unsigned>(subtype));
+        return false;
+    }
+    sectors_ = part_->size / flashlog::kSector;
+    if (sectors_ < 2)
+        return false;
+
+    // Sectors are written in order, so the block whose first sector is newest holds the head.
+    uint32_t best_seq = 0;
+    uint32_t best_block = 0;
+    for (uint32_t s = 0; s < sectors_; s += flashlog::kSectorsPerBlock)
+    {
+        flashlog::SectorHeader h{};
+        if (esp_partition_read(part_, s * flashlog::kSector, &h, sizeof(h)) != ESP_OK)
+            return false;
+        if (h.magic == flashlog::kMagic && h.seq >= best_seq)
+        {
+            best_seq = h.seq;
+            best_block = s;
+        }
+    }
+
+    head_ = 0;
+    seq_ = 1;
+    if (best_seq != 0)
+    {
+        uint32_t newest = best_block;
+        for (uint32_t s = best_block + 1; s < best_block + flashlog::kSectorsPerBlock && s < sectors_; ++s)
+        {
+            flashlog::SectorHeader h{};
+            if (esp_partition_read(part_, s * flashlog::kSector, &h, sizeof(h)) != ESP_OK)
+                return false;
+            if (h.magic != flashlog::kMagic || h.seq != best_seq + (s - best_block))
+                break; ///< First sector not continuing the run: the head is here.
+            newest = s;
+        }
+        head_ = (newest + 1) % sectors_;
+        seq_ = best_seq + (newest - best_block) + 1;
+    }
+
+    logInfo("FlashLog: %u KB, head sector %u, next seq %u.", static_cast<unsigned>(part_->size / 1024),
+            static_cast<unsigned>(head_), static_cast<unsigned>(seq_));
+    return true;
+}
+
+// Queue one record.
+bool FlashLog::append(const void *rec) noexcept
+{
+    if (!ring_.produce([rec](Slot &s) { memcpy(s.rec.data(), rec, flashlog::kRecordBytes); }))
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false; ///< Full: the writer is behind.
+    }
+
+    const uint32_t n = appended_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (n % flashlog::kPerSector == 0 && task_ != nullptr)
+        xTaskNotifyGive(task_); ///< One sector's worth queued.
+    return true;
+}
+
+// Ask for a partial-sector write.
+void FlashLog::flush() noexcept
+{
+    flush_req_.store(true, std::memory_order_release);
+    if (task_ != nullptr)
+        xTaskNotifyGive(task_);
+}
+
+// Main run loop.
+void FlashLog::run() noexcept
+{
+    configASSERT(part_ != nullptr); ///< begin() must have succeeded.
+
+    task_ = xTaskGetCurrentTaskHandle();
+    const TickType_t poll = to_ticks_ms(cfg::flashlog::POLL_MS) > 0 ? to_ticks_ms(cfg::flashlog::POLL_MS) : 1;
+    const uint32_t ahead_target = std::min<uint32_t>(cfg::flashlog::ERASE_AHEAD_KB * 1024 / flashlog::kSector, sectors_ - 1);
+
+    uint32_t seen = appended_.load(std::memory_order_relaxed);
+    uint32_t first_ms = 0;                ///< When the current sector image got its first record.
+    uint32_t last_append_ms = now_ms32(); ///< Last time the ring saw a new record.
+
+    for (;;)
+    {
+        const bool erase_next = ahead_.load(std::memory_order_relaxed) < ahead_target && idle(last_append_ms);
+        ulTaskNotifyTake(pdTRUE, erase_next ? 0 : poll); ///< Keep erasing back-to-back while idle.
+
+        const uint16_t before = fill_;
+        drain();
+        if (before == 0 && fill_ > 0)
+            first_ms = now_ms32();
+
+        const uint32_t n = appended_.load(std::memory_order_relaxed);
+        if (n != seen)
+        {
+            seen = n;
+            last_append_ms = now_ms32();
+        }
+
+        // ---- Partial sector: on request, or once it has waited FLUSH_MS ---- //
+        const bool asked = flush_req_.exchange(false, std::memory_order_acq_rel);
+        if (fill_ > 0 && (asked || now_ms32() - first_ms >= cfg::flashlog::FLUSH_MS))
+            writeSector();
+
+        // ---- Idle: erase ahead so the next run programs into blank flash ---- //
+        if (ahead_.load(std::memory_order_relaxed) < ahead_target && idle(last_append_ms))
+            eraseAhead();
+    }
+}
+
+// True if a background erase may run now.
+bool FlashLog::idle(uint32_t last_append_ms) const noexcept
+{
+    if (idle_ != nullptr)
+        return idle_();
+    return now_ms32() - last_append_ms >= cfg::flashlog::QUIET_MS;
+}
+
+// Move ready records into the sector image.
+bool FlashLog::drain() noexcept
+{
+    const std::size_t n = ring_.drain([this](const Slot &s)
+                                      {
+                                          memcpy(image_.data() + flashlog::kHeaderBytes + fill_ * flashlog::kRecordBytes, s.rec.data(),
+                                                 flashlog::kRecordBytes);
+                                          if (++fill_ == flashlog::kPerSector)
+                                              writeSector(); ///< Slots already taken are free again while this programs.
+                                      });
+    return n != 0;
+}
+
+// Write the sector image at the head and advance.
+bool FlashLog::writeSector() noexcept
+{
+    flashlog::SectorHeader h{};
+    h.magic = flashlog::kMagic;
+    h.seq = seq_;
+    h.record_bytes = static_cast<uint16_t>(flashlog::kRecordBytes);
+    h.count = fill_;
+    memcpy(image_.data(), &h, sizeof(h));
+
+    const uint32_t off = head_ * flashlog::kSector;
+    bool ok = true;
+    const uint32_t ahead = ahead_.load(std::memory_order_relaxed);
+    if (ahead > 0)
+    {
+        ahead_.store(ahead - 1, std::memory_order_relaxed); ///< Pre-erased.
+    }
+    else if (headerMagic(head_) != kErased)
+    {
+        // Header bytes are programmed first, so a blank header means a blank sector.
+        ok = esp_partition_erase_range(part_, off, flashlog::kSector) == ESP_OK;
+        late_erases_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (ok)
+        ok = esp_partition_write(part_, off, image_.data(), flashlog::kSector) == ESP_OK;
+    if (ok)
+        written_.fetch_add(static_cast<uint32_t>(fill_ * flashlog::kRecordBytes), std::memory_order_relaxed);
+
+    head_ = (head_ + 1) % sectors_; ///< A failed sector is skipped, never retried in place.
+    ++seq_;
+    fill_ = 0;
+    image_.fill(0xFF);
+    return ok;
+}
+
+// Erase one step ahead of the head.
+void FlashLog::eraseAhead() noexcept
+{
+    const uint32_t ahead = ahead_.load(std::memory_order_relaxed);
+    const uint32_t s = (head_ + ahead) % sectors_;
+
+    if (s % flashlog::kSectorsPerBlock == 0 && s + flashlog::kSectorsPerBlock <= sectors_ &&
+        ahead + flashlog::kSectorsPerBlock < sectors_)
+    {
+        if (esp_partition_erase_range(part_, s * flashlog::kSector, flashlog::kBlock) == ESP_OK)
+            ahead_.store(ahead + flashlog::kSectorsPerBlock, std::memory_order_relaxed);
+        return;
+    }
+
+    if (headerMagic(s) == kErased || esp_partition_erase_range(part_, s * flashlog::kSector, flashlog::kSector) == ESP_OK)
+        ahead_.store(ahead + 1, std::memory_order_relaxed);
+}
+
+// Read the header word of a sector.
+uint32_t FlashLog::headerMagic(uint32_t sector) const noexcept
+{
+    uint32_t magic = 0;
+    if (esp_partition_read(part_, sector * flashlog::kSector, &magic, sizeof(magic)) != ESP_OK)
+        return 0;
+    return magic;
+}
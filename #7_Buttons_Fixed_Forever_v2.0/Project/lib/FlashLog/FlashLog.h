@@ -0,0 +1,181 @@
+/**
+ * MIT License
+ *
+ * @brief Log-structured raw flash writer: fixed-size records appended sector by sector to a data partition.
+ *
+ * @file FlashLog.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <esp_partition.h>
+#include <StreamRing.h>
+
+namespace flashlog
+{
+    // ---- Flash layout ---- //
+    //
+    // The partition is one circular log of 4 KB sectors. Each sector that has
+    // been written holds:
+    //   SectorHeader (16 B)  records[count] (kRecordBytes each)  0xFF slack
+    // Sectors are written in increasing seq order and wrap at the end of the
+    // partition, so every sector is erased once per pass (wear levelling by
+    // construction). tools/flashlog_read.py sorts an image back into order.
+
+    static constexpr uint32_t kSector = 4096;                                          ///< Flash erase sector (bytes).
+    static constexpr uint32_t kBlock = 65536;                                          ///< Flash erase block (bytes).
+    static constexpr uint32_t kSectorsPerBlock = kBlock / kSector;                     ///< 16.
+    static constexpr uint32_t kMagic = 0x474C4652;                                     ///< "RFLG".
+    static constexpr std::size_t kRecordBytes = cfg::flashlog::RECORD_BYTES;           ///< Fixed record size.
+    static constexpr std::size_t kHeaderBytes = 16;                                    ///< SectorHeader size.
+    static constexpr std::size_t kPerSector = (kSector - kHeaderBytes) / kRecordBytes; ///< Records per sector.
+
+    /// @brief First bytes of every written sector.
+    struct SectorHeader
+    {
+        uint32_t magic;        ///< kMagic (0xFFFFFFFF → erased).
+        uint32_t seq;          ///< Sector sequence number (newest = highest).
+        uint16_t record_bytes; ///< kRecordBytes.
+        uint16_t count;        ///< Records in this sector (≤ kPerSector).
+        uint32_t reserved;     ///< Zero.
+    };
+
+    static_assert(sizeof(SectorHeader) == kHeaderBytes, "SectorHeader layout changed: update tools/flashlog_read.py.");
+    static_assert(kRecordBytes % 4 == 0 && kPerSector > 0, "RECORD_BYTES must be a word multiple below one sector.");
+} ///< Namespace flashlog.
+
+/**
+ * @brief Appends fixed-size records to a raw data partition without a filesystem.
+ *
+ * Producers (any task) copy a record into a snapshot::MpscRing and return;
+ * the ring is the double buffer: it absorbs records while the writer task is
+ * programming flash. The writer packs records into sector images and writes
+ * each sector with one esp_partition_write, so the only flash traffic is
+ * sequential whole-sector programs plus the erases ahead of them: no
+ * metadata updates, no garbage collection.
+ *
+ * Erasing is what stalls: while the system is idle (no records for
+ * cfg::flashlog::QUIET_MS, or the predicate given to eraseWhen()) the writer
+ * erases up to cfg::flashlog::ERASE_AHEAD_KB ahead of the head in 64 KB
+ * blocks, so a logging run programs into pre-erased flash. Only when a run
+ * outlasts that window does the writer erase single sectors on demand
+ * (counted in lateErases()).
+ *
+ * @note Every flash program / erase briefly stops flash-resident code on both
+ *       cores; run the writer on the core that isn't running PowerDriveHandler
+ *       and keep the drive's timer ISR in IRAM.
+ */
+class FlashLog : public rtos::Task<FlashLog>
+{
+public:
+    /// @brief True when a background erase may stall flash code (e.g. the motor is off).
+    using IdleFn = bool (*)();
+
+    static constexpr std::size_t kRingRecords = cfg::flashlog::RING_RECORDS; ///< Producer ring (power of two).
+    static_assert((kRingRecords & (kRingRecords - 1)) == 0, "RING_RECORDS must be a power of two.");
+
+    /// @brief Construct (nothing touches flash until begin()).
+    FlashLog() noexcept;
+
+    /**
+     * @brief Find the partition and locate the log head (call from setup()).
+     *
+     * @param label Partition label.
+     * @param subtype Data subtype (the custom partition CSVs use cfg::flashlog::SUBTYPE).
+     * @return true If the log is usable.
+     */
+    bool begin(const char *label = cfg::flashlog::PARTITION,
+               uint8_t subtype = cfg::flashlog::SUBTYPE) noexcept;
+
+    /**
+     * @brief Queue one record (any task; never blocks).
+     *
+     * @param rec kRecordBytes bytes.
+     * @return true If queued (false → ring full, counted in dropped()).
+     */
+    bool append(const void *rec) noexcept;
+
+    /// @brief Ask the writer to write out a partly filled sector now (e.g. before power-off).
+    void flush() noexcept;
+
+    /**
+     * @brief Decide when erase-ahead may run (call before the task starts).
+     *
+     * @param idle Predicate polled by the writer; nullptr → record quiet time only.
+     */
+    void eraseWhen(IdleFn idle) noexcept { idle_ = idle; }
+
+    /// @brief Bytes of records written to flash this boot.
+    [[nodiscard]] uint32_t bytesWritten() const noexcept { return written_.load(std::memory_order_relaxed); }
+
+    /// @brief Records dropped because the ring was full.
+    [[nodiscard]] uint32_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /// @brief Sectors erased on the write path (erase-ahead window ran out).
+    [[nodiscard]] uint32_t lateErases() const noexcept { return late_erases_.load(std::memory_order_relaxed); }
+
+    /// @brief Sectors currently erased ahead of the head.
+    [[nodiscard]] uint32_t aheadSectors() const noexcept { return ahead_.load(std::memory_order_relaxed); }
+
+    /// @brief Partition size in sectors (0 before begin()).
+    [[nodiscard]] uint32_t sectors() const noexcept { return sectors_; }
+
+private:
+    friend class rtos::Task<FlashLog>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Storage; ///< Filter for this class's log* sites.
+
+    /// @brief One queued record.
+    struct Slot
+    {
+        alignas(4) std::array<uint8_t, flashlog::kRecordBytes> rec; ///< Payload.
+    };
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /// @brief Move ready records from the ring into the sector image; true if any.
+    bool drain() noexcept;
+
+    /// @brief Write the sector image at the head and advance.
+    bool writeSector() noexcept;
+
+    /// @brief True if a background erase may run now.
+    [[nodiscard]] bool idle(uint32_t last_append_ms) const noexcept;
+
+    /// @brief Erase one step (block when aligned, else sector) ahead of the head.
+    void eraseAhead() noexcept;
+
+    /// @brief Read the header word of @p sector.
+    [[nodiscard]] uint32_t headerMagic(uint32_t sector) const noexcept;
+
+    // ---- Producer ring ---- //
+    snapshot::MpscRing<Slot, kRingRecords> ring_{}; ///< Records waiting for the writer.
+
+    // ---- Writer state ---- //
+    const esp_partition_t *part_{nullptr};                      ///< Log partition.
+    uint32_t sectors_{0};                                       ///< Sectors in the partition.
+    uint32_t head_{0};                                          ///< Next sector to write.
+    uint32_t seq_{1};                                           ///< Sequence number of the next sector.
+    alignas(4) std::array<uint8_t, flashlog::kSector> image_{}; ///< Sector being filled.
+    uint16_t fill_{0};                                          ///< Records in image_.
+    TaskHandle_t task_{nullptr};                                ///< Writer (producers wake it).
+    IdleFn idle_{nullptr};                                      ///< Erase-ahead gate (nullptr → quiet time).
+
+    // ---- Shared counters ---- //
+    std::atomic<bool> flush_req_{false};   ///< flush() asked for a partial write.
+    std::atomic<uint32_t> appended_{0};    ///< Records queued (quiet detection).
+    std::atomic<uint32_t> written_{0};     ///< Record bytes programmed.
+    std::atomic<uint32_t> dropped_{0};     ///< Ring-full drops.
+    std::atomic<uint32_t> late_erases_{0}; ///< On-demand sector erases.
+    std::atomic<uint32_t> ahead_{0};       ///< Known-erased sectors from head_ on.
+};
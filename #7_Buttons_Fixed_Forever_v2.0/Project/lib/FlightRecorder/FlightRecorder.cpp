@@ -0,0 +1,293 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of FlightRecorder (PSRAM ring, slot-per-dump flash writer).
+ *
+ * @file FlightRecorder.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "FlightRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_system.h>
+#include <StaticPool.h>
+
+namespace
+{
+    constexpr std::size_t kCapacity = cfg::recorder::RECORDS; ///< Ring entries.
+
+#if CONFIG_SPIRAM_ALLOW_NOINIT_SEG_EXTERNAL_MEMORY
+    constexpr bool kSurvivesReset = true; ///< Ring left untouched across a software / panic reset.
+    EXT_RAM_NOINIT_ATTR blackbox::Record s_ring[kCapacity];
+    EXT_RAM_NOINIT_ATTR blackbox::RingState s_state;
+#elif CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY
+    constexpr bool kSurvivesReset = false; ///< PSRAM .bss ring: zeroed at boot, but never from the heap.
+    EXT_RAM_ATTR blackbox::Record s_ring[kCapacity];
+    EXT_RAM_ATTR blackbox::RingState s_state;
+#else
+    constexpr bool kSurvivesReset = false; ///< Heap ring: contents die with the boot.
+#endif
+
+    uint8_t s_sector[blackbox::kSector]; ///< Internal-RAM staging: PSRAM ring → whole-sector flash writes.
+
+    /// @brief Resets that leave PSRAM contents intact and mean something went wrong.
+    bool wasCrash(esp_reset_reason_t r) noexcept
+    {
+        return r == ESP_RST_PANIC || r == ESP_RST_INT_WDT || r == ESP_RST_TASK_WDT || r == ESP_RST_WDT;
+    }
+} // namespace
+
+// Find the partition, allocate the ring and recover a crash dump.
+bool FlightRecorder::begin(const char *label) noexcept
+{
+    part_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (part_ == nullptr)
+    {
+        logWarn("FlightRecorder: no '%s' partition.", label);
+        return false;
+    }
+
+    const uint32_t need = blackbox::kSector + static_cast<uint32_t>(kCapacity * sizeof(blackbox::Record));
+    slot_bytes_ = (need + blackbox::kBlock - 1) / blackbox::kBlock * blackbox::kBlock;
+    slots_ = part_->size / slot_bytes_;
+    if (slots_ == 0)
+    {
+        logError("FlightRecorder: '%s' (%u B) smaller than one %u B slot.", label, static_cast<unsigned>(part_->size),
+                 static_cast<unsigned>(slot_bytes_));
+        return false;
+    }
+
+#if CONFIG_SPIRAM_ALLOW_NOINIT_SEG_EXTERNAL_MEMORY || CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY
+    ring_ = s_ring;
+    state_ = &s_state;
+#else
+    ring_ = static_cast<blackbox::Record *>(heap_caps_malloc(kCapacity * sizeof(blackbox::Record), MALLOC_CAP_SPIRAM));
+    static blackbox::RingState state{};
+    state_ = &state;
+    if (ring_ == nullptr)
+    {
+        logError("FlightRecorder: PSRAM ring allocation failed.");
+        return false;
+    }
+#endif
+    mem::region("recorder", ring_, kCapacity * sizeof(blackbox::Record));
+
+    // Newest dump decides where the next one goes.
+    uint32_t newest = 0;
+    for (uint32_t s = 0; s < slots_; ++s)
+    {
+        blackbox::DumpHeader h{};
+        if (header(s, h) && h.seq >= newest)
+        {
+            newest = h.seq;
+            next_slot_ = (s + 1) % slots_;
+        }
+    }
+    next_seq_ = newest + 1;
+
+    if (!prepare(next_slot_))
+        return false;
+
+    const bool intact = state_->magic == blackbox::kRingMagic && state_->count <= kCapacity && state_->head < kCapacity;
+    if (kSurvivesReset && intact && state_->count > 0 && wasCrash(esp_reset_reason()))
+    {
+        logWarn("FlightRecorder: recovering %u records from before the reset.", static_cast<unsigned>(state_->count));
+        const uint32_t last = (state_->head + kCapacity - 1) % kCapacity;
+        dump(blackbox::Reason::Panic, static_cast<uint32_t>(esp_reset_reason()), ring_[last].stamp_us); ///< Last record ≈ time of death.
+    }
+
+    state_->head = 0;
+    state_->count = 0;
+    state_->magic = blackbox::kRingMagic;
+    return true;
+}
+
+// Arm a dump.
+void FlightRecorder::trigger(blackbox::Reason reason, uint32_t code) noexcept
+{
+    uint8_t none = 0;
+    if (!pending_.compare_exchange_strong(none, static_cast<uint8_t>(reason), std::memory_order_acq_rel))
+        return; ///< Already armed: keep the first cause.
+
+    code_.store(code, std::memory_order_relaxed);
+    if (task_ != nullptr)
+        xTaskNotifyGive(task_);
+}
+
+// Read one slot's header.
+bool FlightRecorder::header(uint32_t slot, blackbox::DumpHeader &out) const noexcept
+{
+    if (part_ == nullptr || slot >= slots_)
+        return false;
+    if (esp_partition_read(part_, slot * slot_bytes_, &out, sizeof(out)) != ESP_OK)
+        return false;
+    return out.magic == blackbox::kDumpMagic && out.record_bytes == sizeof(blackbox::Record) && out.slot_bytes == slot_bytes_;
+}
+
+// Main run loop.
+void FlightRecorder::run() noexcept
+{
+    configASSERT(ring_ != nullptr); ///< begin() must have succeeded.
+
+    task_ = xTaskGetCurrentTaskHandle();
+    auto in_sub = in_->subscribe();
+    auto rc_sub = rc_->subscribe();
+    auto ctl_sub = ctl_->subscribe();
+
+    const TickType_t idle = to_ticks_ms(cfg::recorder::IDLE_MS) > 0 ? to_ticks_ms(cfg::recorder::IDLE_MS) : 1;
+    bool rc_fs = true;     ///< Last RC failsafe flag (starts true: no trigger before the link first comes up).
+    bool ctl_fs = false;   ///< Last ControlSnapshot::Authority::Failsafe state.
+    uint64_t armed_us = 0; ///< When the pending trigger was first seen (0 → none).
+
+    for (;;)
+    {
+        snapshot::wait_any(idle, in_sub, rc_sub, ctl_sub);
+
+        InputState in{};
+        if (in_sub.take(in))
+        {
+            blackbox::InputRecord r{};
+            r.origin_us = in.origin_us;
+            r.buttons = static_cast<uint64_t>(in.buttons.to_ullong());
+            r.taps = static_cast<uint64_t>(in.taps.to_ullong());
+            r.doubles = static_cast<uint64_t>(in.doubles.to_ullong());
+            r.held = static_cast<uint64_t>(in.held.to_ullong());
+            r.chords = static_cast<uint64_t>(in.chords.to_ullong());
+            append(blackbox::Kind::Input, &r, sizeof(r));
+        }
+
+        RcSnapshot rc{};
+        if (rc_sub.take(rc))
+        {
+            append(blackbox::Kind::Rc, &rc, sizeof(rc));
+            if (rc.failsafe && !rc_fs)
+                trigger(blackbox::Reason::Failsafe);
+            rc_fs = rc.failsafe;
+        }
+
+        ControlSnapshot ctl{};
+        if (ctl_sub.take(ctl))
+        {
+            append(blackbox::Kind::Control, &ctl, sizeof(ctl));
+            const bool fs = ctl.authority == ControlSnapshot::Authority::Failsafe;
+            if (fs && !ctl_fs)
+                trigger(blackbox::Reason::Failsafe);
+            ctl_fs = fs;
+        }
+
+        // ---- Post-trigger window, then dump ---- //
+        const auto reason = static_cast<blackbox::Reason>(pending_.load(std::memory_order_acquire));
+        if (reason == blackbox::Reason::None)
+            continue;
+
+        const uint64_t now = now_us();
+        if (armed_us == 0)
+            armed_us = now;
+        if (now - armed_us < post_us_)
+            continue;
+
+        if (!dump(reason, code_.load(std::memory_order_relaxed), armed_us))
+            logError("FlightRecorder: dump failed.");
+        state_->head = 0;
+        state_->count = 0;
+        armed_us = 0;
+        pending_.store(0, std::memory_order_release);
+    }
+}
+
+// Append one payload to the ring.
+void FlightRecorder::append(blackbox::Kind kind, const void *payload, std::size_t len) noexcept
+{
+    blackbox::Record &r = ring_[state_->head];
+    r.stamp_us = now_us();
+    r.kind = kind;
+    r.len = static_cast<uint8_t>(len);
+    memset(r.reserved, 0, sizeof(r.reserved));
+    memcpy(r.payload, payload, len);
+    memset(r.payload + len, 0, blackbox::kPayloadBytes - len);
+
+    state_->head = (state_->head + 1 < kCapacity) ? state_->head + 1 : 0;
+    if (state_->count < kCapacity)
+        ++state_->count;
+}
+
+// Write the ring to the current slot and erase the next one.
+bool FlightRecorder::dump(blackbox::Reason reason, uint32_t code, uint64_t trigger_us) noexcept
+{
+    const uint32_t base = next_slot_ * slot_bytes_;
+    const uint32_t count = state_->count;
+
+    // Header first (uncommitted): a reset mid-dump leaves a recognisably torn slot, never a blank-looking dirty one.
+    blackbox::DumpHeader h{};
+    h.magic = blackbox::kDumpMagic;
+    h.version = cfg::numeric::FIXED_POINT ? 2 : 1; ///< Payload real_t: float (1) or Q16.16 (2).
+    h.record_bytes = sizeof(blackbox::Record);
+    h.seq = next_seq_;
+    h.count = count;
+    h.slot_bytes = slot_bytes_;
+    h.reason = static_cast<uint8_t>(reason);
+    h.code = code;
+    h.trigger_us = trigger_us;
+    h.commit = 0xFFFFFFFF;
+    bool ok = esp_partition_write(part_, base, &h, sizeof(h)) == ESP_OK;
+
+    // Records oldest-first, staged into whole sectors.
+    uint32_t src = (state_->head + kCapacity - count) % kCapacity;
+    uint32_t off = base + blackbox::kSector;
+    std::size_t fill = 0;
+    for (uint32_t i = 0; ok && i < count; ++i)
+    {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&ring_[src]);
+        src = (src + 1 < kCapacity) ? src + 1 : 0;
+
+        for (std::size_t b = 0; ok && b < sizeof(blackbox::Record);)
+        {
+            const std::size_t n = std::min(sizeof(blackbox::Record) - b, std::size_t{blackbox::kSector} - fill);
+            memcpy(s_sector + fill, bytes + b, n);
+            fill += n;
+            b += n;
+            if (fill == blackbox::kSector)
+            {
+                ok = esp_partition_write(part_, off, s_sector, blackbox::kSector) == ESP_OK;
+                off += blackbox::kSector;
+                fill = 0;
+            }
+        }
+    }
+    if (ok && fill > 0)
+        ok = esp_partition_write(part_, off, s_sector, fill) == ESP_OK; ///< Records are word multiples.
+
+    // Commit (1 → 0 bits only, no erase).
+    const uint32_t commit = blackbox::kCommitted;
+    if (ok)
+        ok = esp_partition_write(part_, base + offsetof(blackbox::DumpHeader, commit), &commit, sizeof(commit)) == ESP_OK;
+
+    if (ok)
+    {
+        logInfo("FlightRecorder: dump #%u (%s, %u records) → slot %u.", static_cast<unsigned>(next_seq_),
+                blackbox::to_name(reason), static_cast<unsigned>(count), static_cast<unsigned>(next_slot_));
+        dumps_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Even a failed dump used the slot: move on so the next one starts erased.
+    ++next_seq_;
+    next_slot_ = (next_slot_ + 1) % slots_;
+    return prepare(next_slot_) && ok;
+}
+
+// Erase a slot unless its header sector is already blank.
+bool FlightRecorder::prepare(uint32_t slot) noexcept
+{
+    uint32_t magic = 0;
+    if (esp_partition_read(part_, slot * slot_bytes_, &magic, sizeof(magic)) != ESP_OK)
+        return false;
+    if (magic == 0xFFFFFFFF)
+        return true; ///< Header is written first after every erase, so a blank header means a blank slot.
+
+    return esp_partition_erase_range(part_, slot * slot_bytes_, slot_bytes_) == ESP_OK;
+}
@@ -0,0 +1,240 @@
+/**
+ * MIT License
+ *
+ * @brief Black-box recorder: last N bus snapshots in a PSRAM ring, dumped to flash on failsafe / fault / panic.
+ *
+ * @file FlightRecorder.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <esp_partition.h>
+#include <InputBus.h>
+#include <RcBus.h>
+#include <ControlBus.h>
+
+namespace blackbox
+{
+    // ---- Flash layout ---- //
+    //
+    // The partition is split into equal slots (one dump each, used round-robin):
+    //   sector 0   DumpHeader (written first, committed last)
+    //   sector 1.. Record[count], oldest first
+    // tools/flight_decode.py reads a partition image back into CSV.
+
+    static constexpr uint32_t kSector = 4096;          ///< Flash erase sector (bytes).
+    static constexpr uint32_t kBlock = 65536;          ///< Flash erase block; slots are block-aligned.
+    static constexpr uint32_t kDumpMagic = 0x31425246; ///< "FRB1".
+    static constexpr uint32_t kCommitted = 0x00000000; ///< DumpHeader::commit once every record is written.
+    static constexpr std::size_t kPayloadBytes = 56;   ///< Largest recorded payload (RcSnapshot).
+
+    /// @brief What a record holds.
+    enum class Kind : uint8_t
+    {
+        Input = 1, ///< InputRecord.
+        Rc,        ///< RcSnapshot.
+        Control    ///< ControlSnapshot.
+    };
+
+    /// @brief Why a dump was written.
+    enum class Reason : uint8_t
+    {
+        None = 0,
+        Failsafe, ///< RC link lost / control fell back to Failsafe authority.
+        Fault,    ///< FlightRecorder::trigger() from a fault handler.
+        Panic,    ///< Ring recovered after a panic / watchdog reset.
+        Manual    ///< Console or test trigger.
+    };
+
+    /// @brief Human-readable reason.
+    constexpr const char *to_name(Reason r) noexcept
+    {
+        switch (r)
+        {
+        case Reason::Failsafe:
+            return "failsafe";
+        case Reason::Fault:
+            return "fault";
+        case Reason::Panic:
+            return "panic";
+        case Reason::Manual:
+            return "manual";
+        default:
+            return "none";
+        }
+    }
+
+    /// @brief Portable InputState (button bitset layout belongs to InputModel).
+    /// @note Dumps from before the gesture fields carry only the first 16 bytes (Record::len tells them apart).
+    struct InputRecord
+    {
+        uint64_t origin_us{0}; ///< InputState::origin_us.
+        uint64_t buttons{0};   ///< Bit i = button i pressed.
+        uint64_t taps{0};      ///< InputState::taps.
+        uint64_t doubles{0};   ///< InputState::doubles.
+        uint64_t held{0};      ///< InputState::held.
+        uint64_t chords{0};    ///< InputState::chords.
+    };
+
+    static constexpr std::size_t kInputV1Bytes = 16; ///< InputRecord without the gesture fields.
+
+    /// @brief One ring / flash entry (fixed size so the ring and the slots index directly).
+    struct Record
+    {
+        uint64_t stamp_us;              ///< Recorder time of the bus publish (µs since boot).
+        Kind kind;                      ///< Payload type.
+        uint8_t len;                    ///< Payload bytes used.
+        uint8_t reserved[6];            ///< Zero.
+        uint8_t payload[kPayloadBytes]; ///< Raw struct bytes.
+    };
+
+    /// @brief First bytes of a slot.
+    struct DumpHeader
+    {
+        uint32_t magic;        ///< kDumpMagic (0xFFFFFFFF → erased slot).
+        uint16_t version;      ///< Layout version (1: float payloads, 2: Q16.16 real_t).
+        uint16_t record_bytes; ///< sizeof(Record).
+        uint32_t seq;          ///< Dump sequence number (newest = highest).
+        uint32_t count;        ///< Records that follow.
+        uint32_t slot_bytes;   ///< Slot size (bytes).
+        uint8_t reason;        ///< Reason.
+        uint8_t reserved[3];   ///< Zero.
+        uint32_t code;         ///< Fault code given to trigger().
+        uint32_t commit;       ///< kCommitted once complete (else torn by a reset mid-dump).
+        uint64_t trigger_us;   ///< When the dump was armed (µs since the boot that recorded it).
+        uint64_t reserved2;    ///< Zero.
+    };
+
+    static constexpr uint32_t kRingMagic = 0x474E4952; ///< "RING": RingState is valid.
+
+    /// @brief Ring bookkeeping (kept next to the ring so it survives a reset with it).
+    struct RingState
+    {
+        uint32_t magic; ///< kRingMagic when head / count are valid.
+        uint32_t head;  ///< Next index to write.
+        uint32_t count; ///< Valid records (≤ capacity).
+    };
+
+    static_assert(sizeof(InputRecord) <= kPayloadBytes && sizeof(RcSnapshot) <= kPayloadBytes &&
+                      sizeof(ControlSnapshot) <= kPayloadBytes,
+                  "Grow kPayloadBytes (and tools/flight_decode.py) for the larger snapshot.");
+    static_assert(sizeof(Record) == 72, "Record layout changed: update tools/flight_decode.py.");
+    static_assert(sizeof(DumpHeader) == 48, "DumpHeader layout changed: update tools/flight_decode.py.");
+    static_assert(NUM_BUTTONS <= 64 && NUM_CHORDS <= 64, "InputRecord holds 64 buttons / chords.");
+} ///< Namespace blackbox.
+
+/**
+ * @brief Records every InputBus / RcBus / ControlBus publish into a PSRAM ring
+ *        and dumps the ring to a flash partition when something goes wrong.
+ *
+ * The ring holds cfg::recorder::RECORDS entries (the last several seconds of
+ * activity). A failsafe edge on RcBus / ControlBus, or trigger() from any
+ * task, arms a dump: recording continues for cfg::recorder::POST_MS so the
+ * aftermath is captured, then the ring is written oldest-first into the next
+ * pre-erased slot as whole 4 KB sectors, and the following slot is erased
+ * ready for the next dump. A dump never erases on the trigger path.
+ *
+ * Panics and watchdog resets are covered when the build places the ring in
+ * no-init PSRAM (CONFIG_SPIRAM_ALLOW_NOINIT_SEG_EXTERNAL_MEMORY): begin()
+ * finds the previous boot's ring intact and dumps it as Reason::Panic before
+ * recording resumes. Without that option only in-run triggers are captured;
+ * the ring then sits in PSRAM .bss (CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY)
+ * or, failing that, is heap-allocated once in begin().
+ *
+ * @note Flash writes stall flash-resident code on both cores while each sector
+ *       is programmed. Automatic dumps only run after a failsafe (drive
+ *       already commanded to stop); callers of trigger() should do the same.
+ */
+class FlightRecorder : public rtos::Task<FlightRecorder>
+{
+public:
+    /**
+     * @brief Construct for the three recorded buses.
+     *
+     * @param in Button input bus.
+     * @param rc RC frames.
+     * @param ctl Resolved control commands.
+     * @param post_ms Recording continues this long after a trigger before the dump.
+     */
+    FlightRecorder(InputBus &in, RcBus &rc, ControlBus &ctl, uint32_t post_ms = cfg::recorder::POST_MS) noexcept
+        : in_(&in), rc_(&rc), ctl_(&ctl), post_us_(static_cast<uint64_t>(post_ms) * 1000ULL) {}
+
+    /**
+     * @brief Find the partition, allocate the ring and recover a crash dump (call from setup()).
+     *
+     * @param label Data partition label.
+     * @return true If recording can start.
+     */
+    bool begin(const char *label = cfg::recorder::PARTITION) noexcept;
+
+    /**
+     * @brief Arm a dump (any task; the first trigger wins until it is written).
+     *
+     * @param reason Why.
+     * @param code Caller-defined detail stored in the header.
+     */
+    void trigger(blackbox::Reason reason, uint32_t code = 0) noexcept;
+
+    /// @brief Dump slots in the partition (0 before begin()).
+    [[nodiscard]] uint32_t slots() const noexcept { return slots_; }
+
+    /**
+     * @brief Read one slot's header.
+     *
+     * @param slot Slot index (< slots()).
+     * @param out Header.
+     * @return true If the slot holds a dump.
+     */
+    bool header(uint32_t slot, blackbox::DumpHeader &out) const noexcept;
+
+    /// @brief Dumps written this boot.
+    [[nodiscard]] uint32_t dumps() const noexcept { return dumps_.load(std::memory_order_relaxed); }
+
+private:
+    friend class rtos::Task<FlightRecorder>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Storage; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /// @brief Append one payload to the ring.
+    void append(blackbox::Kind kind, const void *payload, std::size_t len) noexcept;
+
+    /// @brief Write the ring to the current slot and erase the next one.
+    bool dump(blackbox::Reason reason, uint32_t code, uint64_t trigger_us) noexcept;
+
+    /// @brief Erase @p slot unless its header sector is already blank.
+    bool prepare(uint32_t slot) noexcept;
+
+    // ---- Sources ---- //
+    InputBus *in_;     ///< Non-owning input bus.
+    RcBus *rc_;        ///< Non-owning RC bus.
+    ControlBus *ctl_;  ///< Non-owning control bus.
+    uint64_t post_us_; ///< Post-trigger recording window (µs).
+
+    // ---- Ring (PSRAM) ---- //
+    blackbox::Record *ring_{nullptr};     ///< Capacity cfg::recorder::RECORDS.
+    blackbox::RingState *state_{nullptr}; ///< Head / count.
+
+    // ---- Flash ---- //
+    const esp_partition_t *part_{nullptr}; ///< Dump partition.
+    uint32_t slot_bytes_{0};               ///< Bytes per slot (block-aligned).
+    uint32_t slots_{0};                    ///< Slots in the partition.
+    uint32_t next_slot_{0};                ///< Pre-erased slot for the next dump.
+    uint32_t next_seq_{1};                 ///< Sequence number for the next dump.
+
+    // ---- Triggering ---- //
+    TaskHandle_t task_{nullptr};      ///< Recorder task (trigger() wakes it).
+    std::atomic<uint8_t> pending_{0}; ///< Armed Reason (0 → none).
+    std::atomic<uint32_t> code_{0};   ///< Armed fault code.
+    std::atomic<uint32_t> dumps_{0};  ///< Dumps written this boot.
+};
@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of KeyMatrix (timer-driven matrix scan with ghosting detection).
+ *
+ * @file KeyMatrix.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "KeyMatrix.h"
+#include <soc/gpio_reg.h>
+
+// Construct for a matrix.
+KeyMatrix::KeyMatrix(const uint8_t *rows, std::size_t n_rows, const uint8_t *cols, std::size_t n_cols,
+                     uint32_t row_us) noexcept
+    : n_rows_(n_rows), n_cols_(n_cols), row_us_(row_us ? row_us : 1)
+{
+    configASSERT(n_rows <= kMaxLines && n_cols <= kMaxLines && n_rows * n_cols <= kMaxKeys); ///< One frame word.
+    for (std::size_t i = 0; i < n_rows; ++i)
+        row_pins_[i] = rows[i];
+    for (std::size_t i = 0; i < n_cols; ++i)
+        col_pins_[i] = cols[i];
+}
+
+// Configure the pins and start the scan timer.
+bool KeyMatrix::begin() noexcept
+{
+    for (std::size_t r = 0; r < n_rows_; ++r)
+    {
+        pinMode(row_pins_[r], OUTPUT_OPEN_DRAIN);
+        driveRow(row_pins_[r], false); ///< All released (high-Z).
+    }
+    cols_.begin(col_pins_.data(), n_cols_, /*pullup=*/true);
+
+    row_ = 0;
+    driveRow(row_pins_[0], true); ///< First row settles until the first alarm.
+
+    const auto group = static_cast<timer_group_t>(cfg::matrix::TIMER_GROUP);
+    const auto index = static_cast<timer_idx_t>(cfg::matrix::TIMER_INDEX);
+
+    timer_config_t tc{};
+    tc.divider = 80;                      ///< 80 MHz APB / 80 → 1 µs timer resolution.
+    tc.counter_dir = TIMER_COUNT_UP;      ///< Count up from 0.
+    tc.counter_en = TIMER_PAUSE;          ///< Start explicitly below.
+    tc.alarm_en = TIMER_ALARM_EN;         ///< Alarm every row_us_.
+    tc.auto_reload = TIMER_AUTORELOAD_EN; ///< Hardware reload: even row timing.
+    tc.intr_type = TIMER_INTR_LEVEL;
+
+    if (timer_init(group, index, &tc) != ESP_OK)
+        return false;
+
+    timer_set_counter_value(group, index, 0);
+    timer_set_alarm_value(group, index, row_us_);
+    timer_enable_intr(group, index);
+    if (timer_isr_callback_add(group, index, &KeyMatrix::onTimerISR, this, HOT_PATH_IRAM ? ESP_INTR_FLAG_IRAM : 0) != ESP_OK)
+        return false;
+
+    return timer_start(group, index) == ESP_OK;
+}
+
+// Latest unambiguous frame.
+uint64_t KeyMatrix::read() const noexcept
+{
+    for (;;)
+    {
+        const uint32_t s0 = seq_.load(std::memory_order_acquire);
+        if (s0 & 1U)
+            continue; ///< ISR mid-write on the other core: retry.
+        const uint32_t lo = lo_.load(std::memory_order_relaxed);
+        const uint32_t hi = hi_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == s0)
+            return static_cast<uint64_t>(lo) | (static_cast<uint64_t>(hi) << 32);
+    }
+}
+
+// GPTimer alarm ISR.
+bool HOT_IRAM KeyMatrix::onTimerISR(void *self) noexcept
+{
+    static_cast<KeyMatrix *>(self)->step();
+    return false; ///< Nobody to wake: readers poll read().
+}
+
+// Sample the driven row, advance, and publish a frame after the last row.
+void HOT_IRAM KeyMatrix::step() noexcept
+{
+    const uint16_t mask = static_cast<uint16_t>((1U << n_cols_) - 1);
+    rows_[row_] = static_cast<uint16_t>(~cols_.read()) & mask; ///< Pull-ups: pressed reads low.
+
+    driveRow(row_pins_[row_], false);
+    row_ = (row_ + 1 < n_rows_) ? row_ + 1 : 0;
+    driveRow(row_pins_[row_], true); ///< Settles for one full period before it is sampled.
+
+    if (row_ == 0)
+        finishScan();
+}
+
+// Resolve ghosting and publish rows_ as a frame.
+void HOT_IRAM KeyMatrix::finishScan() noexcept
+{
+    uint16_t blocked = 0; ///< Bit r: row r is part of an ambiguous rectangle.
+    for (std::size_t i = 0; i < n_rows_; ++i)
+    {
+        for (std::size_t j = i + 1; j < n_rows_; ++j)
+        {
+            const uint16_t shared = rows_[i] & rows_[j];
+            if (shared & (shared - 1)) ///< Two or more shared columns.
+                blocked |= static_cast<uint16_t>((1U << i) | (1U << j));
+        }
+    }
+
+    uint64_t frame = 0;
+    for (std::size_t r = 0; r < n_rows_; ++r)
+    {
+        if (!(blocked & (1U << r)))
+            good_[r] = rows_[r];
+        frame |= static_cast<uint64_t>(good_[r]) << (r * n_cols_);
+    }
+
+    const uint32_t s = seq_.load(std::memory_order_relaxed);
+    seq_.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    lo_.store(static_cast<uint32_t>(frame), std::memory_order_relaxed);
+    hi_.store(static_cast<uint32_t>(frame >> 32), std::memory_order_relaxed);
+    seq_.store(s + 2, std::memory_order_release);
+
+    scans_.fetch_add(1, std::memory_order_relaxed);
+    if (blocked != 0)
+        ghosts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Select (low) or release (high-Z) a row.
+void HOT_IRAM KeyMatrix::driveRow(uint8_t pin, bool select) noexcept
+{
+    if (pin < 32)
+        REG_WRITE(select ? GPIO_OUT_W1TC_REG : GPIO_OUT_W1TS_REG, 1UL << pin);
+    else
+        REG_WRITE(select ? GPIO_OUT1_W1TC_REG : GPIO_OUT1_W1TS_REG, 1UL << (pin - 32));
+}
@@ -0,0 +1,118 @@
+/**
+ * MIT License
+ *
+ * @brief Timer-driven key-matrix scanner with ghosting detection (reader for PortButtons).
+ *
+ * @file KeyMatrix.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <Arduino.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <driver/timer.h>
+#include <HotPath.h>
+#include <PortButtons/PortButtons.h>
+
+/**
+ * @brief Scans a rows × columns key matrix from a GPTimer alarm, one row per alarm.
+ *
+ * Each alarm samples the columns of the row driven on the previous alarm
+ * (one full period to settle), releases it and drives the next, so the scan
+ * cost per tick is fixed whatever the key count. Rows are open-drain (driven
+ * low = selected, released = high-Z) and columns use pull-ups; two pressed
+ * keys in one column therefore never short two driven outputs.
+ *
+ * Without per-key diodes, three keys on the corners of a rectangle make the
+ * fourth corner read as pressed. After every full scan, any two rows that
+ * share two or more pressed columns are treated as ambiguous: both rows keep
+ * their last unambiguous value until the rectangle clears, and the scan is
+ * counted in ghostScans().
+ *
+ * read() returns the latest complete frame (bit r * cols + c, 1 = pressed);
+ * wrap it in PortButtons<N, KeyMatrix> (active_low = false) to debounce it
+ * and feed StateManager / InputBus like any other button source.
+ *
+ * The whole alarm path (onTimerISR → step → finishScan, driveRow and
+ * GpioPortReader::read) is HOT_IRAM. With HOT_PATH_IRAM set, the interrupt is
+ * also allocated IRAM-safe, so the scan keeps running while a flash write
+ * has the cache disabled. Without it, every part of the path stays in flash
+ * and the interrupt is deferred during such writes.
+ */
+class KeyMatrix
+{
+public:
+    static constexpr std::size_t kMaxLines = 16; ///< Rows or columns per side.
+    static constexpr std::size_t kMaxKeys = 64;  ///< rows × columns limit (one frame word).
+
+    /**
+     * @brief Construct for a matrix.
+     *
+     * @param rows Row GPIOs (copied).
+     * @param n_rows Row count.
+     * @param cols Column GPIOs (copied).
+     * @param n_cols Column count (n_rows × n_cols ≤ kMaxKeys).
+     * @param row_us Time each row is driven before its columns are sampled (µs).
+     */
+    KeyMatrix(const uint8_t *rows, std::size_t n_rows, const uint8_t *cols, std::size_t n_cols,
+              uint32_t row_us = cfg::matrix::ROW_US) noexcept;
+
+    /**
+     * @brief Configure the pins and start the scan timer (interrupt lands on the calling core).
+     *
+     * @return true If the timer is running.
+     */
+    bool begin() noexcept;
+
+    /// @brief Latest unambiguous frame (bit r * cols + c, 1 = pressed).
+    [[nodiscard]] uint64_t read() const noexcept;
+
+    /// @brief Key count (rows × columns).
+    [[nodiscard]] std::size_t keys() const noexcept { return n_rows_ * n_cols_; }
+
+    /// @brief Full scans completed.
+    [[nodiscard]] uint32_t scans() const noexcept { return scans_.load(std::memory_order_relaxed); }
+
+    /// @brief Full scans in which ghosting blocked at least one row.
+    [[nodiscard]] uint32_t ghostScans() const noexcept { return ghosts_.load(std::memory_order_relaxed); }
+
+private:
+    /// @brief GPTimer alarm ISR. Arg is `this`.
+    static bool onTimerISR(void *self) noexcept;
+
+    /// @brief Sample the driven row, advance, and publish a frame after the last row.
+    void step() noexcept;
+
+    /// @brief Resolve ghosting and publish rows_ as a frame.
+    void finishScan() noexcept;
+
+    /// @brief Select (low) or release (high-Z) a row through the W1TS / W1TC registers.
+    static void driveRow(uint8_t pin, bool select) noexcept;
+
+    // ---- Configuration ---- //
+    std::array<uint8_t, kMaxLines> row_pins_{}; ///< Row GPIOs.
+    std::array<uint8_t, kMaxLines> col_pins_{}; ///< Column GPIOs.
+    std::size_t n_rows_{0};                     ///< Rows.
+    std::size_t n_cols_{0};                     ///< Columns.
+    uint32_t row_us_{0};                        ///< Alarm period (µs).
+    GpioPortReader cols_{};                     ///< Column sampler (one register read).
+
+    // ---- Scan state (ISR only) ---- //
+    std::size_t row_{0};                     ///< Row currently driven.
+    std::array<uint16_t, kMaxLines> rows_{}; ///< Pressed columns per row, this scan.
+    std::array<uint16_t, kMaxLines> good_{}; ///< Last unambiguous value per row.
+
+    // ---- Published frame (seqlock: ISR writes, tasks read) ---- //
+    std::atomic<uint32_t> seq_{0};     ///< Odd while the ISR is writing.
+    std::atomic<uint32_t> lo_{0};      ///< Frame bits 0..31.
+    std::atomic<uint32_t> hi_{0};      ///< Frame bits 32..63.
+    std::atomic<uint32_t> scans_{0};   ///< Full scans.
+    std::atomic<uint32_t> ghosts_{0};  ///< Scans with a blocked row.
+};
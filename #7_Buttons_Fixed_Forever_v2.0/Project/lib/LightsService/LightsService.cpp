@@ -0,0 +1,114 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of LightsService (ControlBus → LEDC indicator / headlight / horn patterns).
+ *
+ * @file LightsService.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "LightsService.h"
+#include <driver/ledc.h>
+
+namespace
+{
+    /// @brief LEDC timer behind a channel (Arduino-ESP32 mapping: channels 2k, 2k+1 → timer k % 4).
+    constexpr uint8_t timerOf(uint8_t ch) noexcept { return static_cast<uint8_t>((ch / 2U) % 4U); }
+
+    static_assert(timerOf(cfg::lights::CH_LEFT) == timerOf(cfg::lights::CH_RIGHT), "Indicators must share the blink timer.");
+    static_assert(timerOf(cfg::lights::CH_HORN) == timerOf(cfg::lights::CH_HEAD), "Horn and headlights share the tone timer.");
+    static_assert(timerOf(cfg::lights::CH_LEFT) != timerOf(cfg::lights::CH_HORN), "Blink and tone need separate timers.");
+} // namespace
+
+// Set up the LEDC timers and attach the configured pins (all outputs off).
+bool LightsService::begin() noexcept
+{
+    using namespace cfg::lights;
+    has_left_ = attach(LEFT_PIN, CH_LEFT, BLINK_HZ);
+    has_right_ = attach(RIGHT_PIN, CH_RIGHT, BLINK_HZ);
+    has_horn_ = attach(HORN_PIN, CH_HORN, HORN_HZ);
+    has_head_ = attach(HEAD_PIN, CH_HEAD, HORN_HZ);
+
+    logInfo("LightsService: indicators %d / %d at %u Hz, head %d, horn %d at %u Hz.", has_left_ ? LEFT_PIN : -1,
+            has_right_ ? RIGHT_PIN : -1, static_cast<unsigned>(BLINK_HZ), has_head_ ? HEAD_PIN : -1,
+            has_horn_ ? HORN_PIN : -1, static_cast<unsigned>(HORN_HZ));
+    return has_left_ || has_right_ || has_head_ || has_horn_;
+}
+
+// Main run loop.
+void LightsService::run() noexcept
+{
+    configASSERT(bus_ != nullptr); ///< Sanity check: bus_ must be valid.
+
+    auto sub = bus_->subscribe(); ///< Woken on every ControlBus publish.
+    apply(bus_->peek());          ///< Outputs match the current frame before the first publish.
+
+    for (;;)
+    {
+        sub.wait(portMAX_DELAY);
+        ControlSnapshot c{};
+        if (sub.take(c))
+            apply(c);
+    }
+}
+
+// Write the outputs whose command differs from the last applied frame.
+void LightsService::apply(const ControlSnapshot &c) noexcept
+{
+    using Indicator = ControlSnapshot::Indicator;
+    using namespace cfg::lights;
+
+    if (!applied_ || c.indicator_cmd != last_.indicator_cmd)
+    {
+        const bool left = c.indicator_cmd == Indicator::Left || c.indicator_cmd == Indicator::Hazard;
+        const bool right = c.indicator_cmd == Indicator::Right || c.indicator_cmd == Indicator::Hazard;
+        if (has_left_)
+            ledcWrite(CH_LEFT, left ? duty(BLINK_DUTY_PCT) : 0);
+        if (has_right_)
+            ledcWrite(CH_RIGHT, right ? duty(BLINK_DUTY_PCT) : 0);
+        if ((has_left_ || has_right_) && (left || right))
+            ledc_timer_rst(static_cast<ledc_mode_t>(CH_LEFT / 8), static_cast<ledc_timer_t>(timerOf(CH_LEFT))); ///< Flash now.
+        ++changes_;
+    }
+
+    if (has_horn_ && (!applied_ || c.horn_cmd != last_.horn_cmd))
+    {
+        ledcWrite(CH_HORN, c.horn_cmd ? duty(50) : 0);
+        ++changes_;
+    }
+
+    if (has_head_ && (!applied_ || c.lights_cmd != last_.lights_cmd))
+    {
+        ledcWrite(CH_HEAD, c.lights_cmd ? duty(HEAD_PCT) : 0);
+        ++changes_;
+    }
+
+    // LEDC stops in light sleep: a lit lamp or a sounding horn keeps the chip awake.
+    const bool on = (c.indicator_cmd != ControlSnapshot::Indicator::Off && (has_left_ || has_right_)) ||
+                    (has_horn_ && c.horn_cmd) || (has_head_ && c.lights_cmd);
+    if (on)
+        lock_.acquire();
+    else
+        lock_.release();
+
+    last_ = c;
+    applied_ = true;
+}
+
+// Set up one channel and attach its pin (duty 0).
+bool LightsService::attach(int pin, uint8_t ch, uint32_t hz) noexcept
+{
+    if (pin < 0)
+        return false;
+    if (ledcSetup(ch, hz, cfg::lights::BITS) == 0)
+    {
+        logError("LightsService: LEDC channel %u cannot run %u Hz at %u bits.", static_cast<unsigned>(ch),
+                 static_cast<unsigned>(hz), static_cast<unsigned>(cfg::lights::BITS));
+        return false;
+    }
+    ledcAttachPin(pin, ch);
+    ledcWrite(ch, 0);
+    return true;
+}
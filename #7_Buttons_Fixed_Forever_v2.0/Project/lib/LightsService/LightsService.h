@@ -0,0 +1,98 @@
+/**
+ * MIT License
+ *
+ * @brief Indicator / headlight / horn outputs: ControlBus modes turned into LEDC hardware patterns.
+ *
+ * @file LightsService.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <cstdint>
+#include <ControlBus.h>
+#include <PowerManager/PowerManager.h>
+
+/**
+ * @brief Drives indicators, headlights and horn from ControlSnapshot modes.
+ *
+ * The CPU never toggles a pin. Each output is an LEDC channel:
+ *  - Indicators: a BLINK_HZ timer at BLINK_DUTY_PCT duty flashes the lamps;
+ *    both share one timer so hazards flash in step.
+ *  - Horn: a HORN_HZ square wave (50 % duty) for a piezo or horn driver.
+ *  - Headlights: HEAD_PCT duty on the horn's timer (used as a PWM carrier).
+ * The task wakes on each ControlBus publish but only touches LEDC when the
+ * indicator, horn or headlight command changed. An indicator change also
+ * restarts the blink timer, so a new pattern lights at once instead of
+ * waiting out the rest of the current flash.
+ *
+ * While any output is on the task holds a pm::Lock against light sleep
+ * (LEDC stops with its clock); with everything off the chip may sleep.
+ *
+ * @note Channels 2k and 2k+1 share LEDC timer k % 4: the channel pairs in
+ *       cfg::lights must not share a timer with the motor's LEDC channels.
+ */
+class LightsService : public rtos::Task<LightsService>
+{
+public:
+    /**
+     * @brief Construct with the control bus (no hardware access).
+     *
+     * @param bus Control bus to follow (non-owning).
+     */
+    explicit LightsService(ControlBus &bus) noexcept : bus_(&bus) {}
+
+    /**
+     * @brief Set up the LEDC timers and attach the configured pins (all outputs off).
+     *
+     * @return true If at least one output is attached.
+     */
+    bool begin() noexcept;
+
+    /// @brief LEDC updates applied since begin() (mode changes, not publishes).
+    [[nodiscard]] uint32_t changes() const noexcept { return changes_; }
+
+private:
+    friend class rtos::Task<LightsService>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Lights; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /**
+     * @brief Write the outputs whose command differs from the last applied frame.
+     *
+     * @param c New control frame.
+     */
+    void apply(const ControlSnapshot &c) noexcept;
+
+    /**
+     * @brief Set up one channel and attach its pin (duty 0).
+     *
+     * @param pin Output pin (-1 → skipped).
+     * @param ch LEDC channel.
+     * @param hz Timer frequency.
+     * @return true If the pin is attached.
+     */
+    static bool attach(int pin, uint8_t ch, uint32_t hz) noexcept;
+
+    /// @brief Duty counts for a percentage at cfg::lights::BITS.
+    static constexpr uint32_t duty(uint8_t pct) noexcept { return ((uint32_t{1} << cfg::lights::BITS) - 1U) * pct / 100U; }
+
+    static_assert(cfg::lights::BLINK_DUTY_PCT <= 100 && cfg::lights::HEAD_PCT <= 100, "Duty is a percentage.");
+
+    ControlBus *bus_{nullptr};                   ///< Non-owning control bus.
+    bool has_left_{false};                       ///< Left indicator attached.
+    bool has_right_{false};                      ///< Right indicator attached.
+    bool has_head_{false};                       ///< Headlight attached.
+    bool has_horn_{false};                       ///< Horn attached.
+    ControlSnapshot last_{};                     ///< Last applied modes.
+    bool applied_{false};                        ///< True once last_ is valid.
+    uint32_t changes_{0};                        ///< LEDC updates applied.
+    pm::Lock lock_{"lights", pm::Hold::NoSleep}; ///< Held while any output is on.
+};
@@ -0,0 +1,299 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of OtaService (UART image stream → inactive OTA slot, paced around the drive loop).
+ *
+ * @file OtaService.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "OtaService.h"
+#include <algorithm>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+
+namespace
+{
+    constexpr uint32_t kWaitReplyMs = 1000; ///< Keep-alive period while a chunk is held back.
+
+    /// @brief Ticks for a non-zero delay (at least one).
+    TickType_t ticks(uint32_t ms) noexcept { return to_ticks_ms(ms) > 0 ? to_ticks_ms(ms) : 1; }
+} // namespace
+
+// Find the inactive slot, read the running image's state and open the UART.
+bool OtaService::begin() noexcept
+{
+    running_ = esp_ota_get_running_partition();
+    slot_ = esp_ota_get_next_update_partition(nullptr);
+
+    esp_ota_img_states_t st{};
+    pending_ = running_ != nullptr && esp_ota_get_state_partition(running_, &st) == ESP_OK && st == ESP_OTA_IMG_PENDING_VERIFY;
+
+    if (slot_ == nullptr)
+    {
+        logWarn("OtaService: no inactive OTA slot (use custom_dual_16MB.csv).");
+        return false;
+    }
+
+    port_->setRxBufferSize(2 * cfg::ota::CHUNK); ///< Must precede begin(): one chunk in flight plus slack.
+    port_->begin(cfg::ota::BAUD, SERIAL_8N1, cfg::ota::RX_PIN, cfg::ota::TX_PIN);
+
+    logInfo("OtaService: running '%s'%s, updates go to '%s' (%u KB) at %u baud.", running(),
+            pending_ ? " (pending verify)" : "", slot_->label, static_cast<unsigned>(slot_->size / 1024),
+            static_cast<unsigned>(cfg::ota::BAUD));
+    return true;
+}
+
+// Progress and drive-loop effect of the current / last transfer.
+ota::Status OtaService::status() const noexcept
+{
+    portENTER_CRITICAL(&mux_);
+    const ota::Status s = status_;
+    portEXIT_CRITICAL(&mux_);
+    return s;
+}
+
+// Main run loop.
+void OtaService::run() noexcept
+{
+    configASSERT(port_ != nullptr && slot_ != nullptr); ///< Sanity check: begin() must have succeeded.
+
+    if (pending_)
+        verifyRunning(); ///< No new image is taken until this one has proven itself.
+
+    for (;;)
+    {
+        ota::Header h{};
+        if (!readHeader(h))
+            continue;
+
+        const ota::Error e = transfer(h);
+        if (e != ota::Error::None)
+        {
+            reply(ota::Reply::Error, e);
+            edit([e](ota::Status &s)
+                 {
+                     s.state = ota::State::Failed;
+                     s.error = e;
+                 });
+            logError("OtaService: transfer failed (%s).", ota::to_name(e));
+            continue;
+        }
+
+        reply(ota::Reply::Done);
+        const ota::Status s = status();
+        logInfo("OtaService: %u B into '%s' in %u bursts (%u cost an overrun, longest %u us).",
+                static_cast<unsigned>(s.size), slot_->label, static_cast<unsigned>(s.bursts),
+                static_cast<unsigned>(s.costly), static_cast<unsigned>(s.burst_max_us));
+        logInfo("OtaService: drive loop max %u → %u us, p99 %u → %u us, overruns %u → %u.",
+                static_cast<unsigned>(s.before.max_us), static_cast<unsigned>(s.during.max_us),
+                static_cast<unsigned>(s.before.p99_us), static_cast<unsigned>(s.during.p99_us),
+                static_cast<unsigned>(s.before.overruns), static_cast<unsigned>(s.during.overruns));
+
+        if constexpr (cfg::ota::AUTO_REBOOT)
+        {
+            while (idle_ != nullptr && !idle_())
+                vTaskDelay(ticks(cfg::ota::POLL_MS)); ///< Never reset under a running motor.
+            logInfo("OtaService: rebooting into the new image.");
+            vTaskDelay(ticks(100)); ///< Let the log drain.
+            esp_restart();
+        }
+    }
+}
+
+// Mark the running image valid, or roll back, after CONFIRM_MS.
+void OtaService::verifyRunning() noexcept
+{
+    vTaskDelay(ticks(cfg::ota::CONFIRM_MS));
+
+    if (healthy_ != nullptr && !healthy_())
+    {
+        logError("OtaService: '%s' failed its self-test, rolling back.", running());
+        vTaskDelay(ticks(100)); ///< Let the log drain.
+        esp_ota_mark_app_invalid_rollback_and_reboot(); ///< Does not return when the other slot is valid.
+        return;
+    }
+
+    if (esp_ota_mark_app_valid_cancel_rollback() == ESP_OK)
+    {
+        pending_ = false;
+        logInfo("OtaService: '%s' confirmed.", running());
+    }
+}
+
+// Wait (polling) for a transfer header.
+bool OtaService::readHeader(ota::Header &h) noexcept
+{
+    // Hunt for the magic a byte at a time, so stray bytes on the line are skipped.
+    uint32_t window = 0;
+    while (window != ota::kMagic)
+    {
+        if (port_->available() <= 0)
+        {
+            vTaskDelay(ticks(cfg::ota::POLL_MS));
+            continue;
+        }
+        window = (window >> 8) | (static_cast<uint32_t>(port_->read() & 0xFF) << 24); ///< Little-endian word.
+    }
+
+    h.magic = window;
+    uint8_t rest[sizeof(ota::Header) - sizeof(h.magic)];
+    if (!readExact(rest, sizeof(rest), cfg::ota::TIMEOUT_MS))
+        return false;
+    memcpy(&h.size, rest, sizeof(h.size));
+    memcpy(&h.crc32, rest + sizeof(h.size), sizeof(h.crc32));
+    return true;
+}
+
+// Run one transfer into slot_.
+ota::Error OtaService::transfer(const ota::Header &h) noexcept
+{
+    if (h.size == 0 || h.size > slot_->size)
+        return ota::Error::TooBig;
+
+    edit([&h](ota::Status &s)
+         {
+             s = ota::Status{};
+             s.state = ota::State::Baseline;
+             s.size = h.size;
+             s.gap_ms = cfg::ota::GAP_MS;
+         });
+
+    // Drive loop alone first: the reference the transfer is judged against.
+    LoopStats before{};
+    if (stats_ != nullptr)
+    {
+        if (reset_ != nullptr)
+            reset_();
+        vTaskDelay(ticks(cfg::ota::BASELINE_MS));
+        before = stats_();
+        if (reset_ != nullptr)
+            reset_();
+    }
+
+    esp_ota_handle_t oh = 0;
+    if (esp_ota_begin(slot_, OTA_WITH_SEQUENTIAL_WRITES, &oh) != ESP_OK)
+        return ota::Error::Begin; ///< Sequential writes: sectors are erased as chunks arrive, not all up front.
+
+    gap_ms_ = cfg::ota::GAP_MS;
+    last_burst_ = xTaskGetTickCount();
+    edit([&before](ota::Status &s)
+         {
+             s.state = ota::State::Receiving;
+             s.before = before;
+         });
+    logInfo("OtaService: receiving %u B into '%s'.", static_cast<unsigned>(h.size), slot_->label);
+    reply(ota::Reply::Ready);
+
+    uint32_t crc = 0;
+    for (uint32_t got = 0; got < h.size;)
+    {
+        const std::size_t n = std::min<std::size_t>(cfg::ota::CHUNK, h.size - got);
+        if (!readExact(buf_.data(), n, cfg::ota::TIMEOUT_MS))
+        {
+            esp_ota_abort(oh);
+            return ota::Error::Timeout;
+        }
+        crc = esp_rom_crc32_le(crc, buf_.data(), n);
+        if (!writeChunk(oh, n))
+        {
+            esp_ota_abort(oh);
+            return ota::Error::Write;
+        }
+        got += n;
+        edit([got](ota::Status &s) { s.received = got; });
+        reply(ota::Reply::Ack);
+    }
+
+    const LoopStats during = (stats_ != nullptr) ? stats_() : LoopStats{};
+    edit([&during](ota::Status &s) { s.during = during; });
+
+    if (crc != h.crc32)
+    {
+        esp_ota_abort(oh);
+        return ota::Error::Crc;
+    }
+    if (esp_ota_end(oh) != ESP_OK)
+        return ota::Error::Image; ///< Checks the image header and its appended SHA-256.
+    if (esp_ota_set_boot_partition(slot_) != ESP_OK)
+        return ota::Error::Boot; ///< otadata now points at slot_; it boots pending-verify.
+
+    edit([](ota::Status &s) { s.state = ota::State::Done; });
+    return ota::Error::None;
+}
+
+// Read exactly n bytes.
+bool OtaService::readExact(uint8_t *dst, std::size_t n, uint32_t timeout_ms) noexcept
+{
+    const TickType_t limit = ticks(timeout_ms);
+    TickType_t quiet = 0;
+    std::size_t got = 0;
+
+    while (got < n)
+    {
+        const int avail = port_->available();
+        if (avail <= 0)
+        {
+            if (quiet >= limit)
+                return false;
+            vTaskDelay(1);
+            ++quiet;
+            continue;
+        }
+        got += port_->read(dst + got, std::min<std::size_t>(static_cast<std::size_t>(avail), n - got));
+        quiet = 0;
+    }
+    return true;
+}
+
+// Write one chunk once the drive allows it, and adapt the gap to its cost.
+bool OtaService::writeChunk(esp_ota_handle_t h, std::size_t n) noexcept
+{
+    // Hold the chunk while the drive is busy (the host waits on Wait keep-alives).
+    TickType_t held = 0;
+    while (idle_ != nullptr && !idle_())
+    {
+        vTaskDelay(ticks(cfg::ota::POLL_MS));
+        held += ticks(cfg::ota::POLL_MS);
+        if (held >= ticks(kWaitReplyMs))
+        {
+            reply(ota::Reply::Wait);
+            held = 0;
+        }
+    }
+
+    const TickType_t since = xTaskGetTickCount() - last_burst_;
+    if (since < ticks(gap_ms_))
+        vTaskDelay(ticks(gap_ms_) - since);
+
+    const uint32_t overruns = (stats_ != nullptr) ? stats_().overruns : 0;
+    const uint64_t t0 = now_us();
+    const bool ok = esp_ota_write(h, buf_.data(), n) == ESP_OK; ///< Erases the next sector when the write crosses into it.
+    const uint32_t burst_us = static_cast<uint32_t>(now_us() - t0);
+
+    vTaskDelay(1); ///< Let the drive loop take its post-stall step before judging the burst.
+    last_burst_ = xTaskGetTickCount();
+
+    const bool costly = stats_ != nullptr && stats_().overruns > overruns;
+    gap_ms_ = costly ? std::min(gap_ms_ * 2U, cfg::ota::MAX_GAP_MS)
+                     : std::max(gap_ms_ - gap_ms_ / 8U, cfg::ota::GAP_MS); ///< Back off fast, recover slowly.
+
+    edit([&](ota::Status &s)
+         {
+             ++s.bursts;
+             s.costly += costly ? 1U : 0U;
+             s.burst_max_us = std::max(s.burst_max_us, burst_us);
+             s.gap_ms = gap_ms_;
+         });
+    return ok;
+}
+
+// Send one reply byte (and the error code after Reply::Error).
+void OtaService::reply(ota::Reply r, ota::Error e) noexcept
+{
+    port_->write(static_cast<uint8_t>(r));
+    if (r == ota::Reply::Error)
+        port_->write(static_cast<uint8_t>(e));
+}
@@ -0,0 +1,280 @@
+/**
+ * MIT License
+ *
+ * @brief Streaming over-the-air update: UART chunks → inactive OTA slot, throttled around the drive loop.
+ *
+ * @file OtaService.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <Arduino.h>
+#include <RtosTask.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <LoopStats.h>
+
+namespace ota
+{
+    // ---- Wire protocol (tools/ota_upload.py) ---- //
+    //
+    // host → Header, then Header::size image bytes in cfg::ota::CHUNK pieces
+    // device → one Reply byte per step: Ready after the header, Ack after each
+    //          chunk is in flash, Done once the slot is set to boot. Wait is a
+    //          keep-alive while the device holds a chunk back (drive busy);
+    //          Error is followed by one Error code byte and ends the transfer.
+
+    static constexpr uint32_t kMagic = 0x3141544F; ///< "OTA1".
+
+    /// @brief Transfer header.
+    struct Header
+    {
+        uint32_t magic; ///< kMagic.
+        uint32_t size;  ///< Image bytes that follow.
+        uint32_t crc32; ///< CRC-32 (zlib) of the image.
+    };
+
+    static_assert(sizeof(Header) == 12, "Header layout changed: update tools/ota_upload.py.");
+
+    /// @brief Device → host reply bytes.
+    enum class Reply : uint8_t
+    {
+        Ready = 'R', ///< Slot open, send the first chunk.
+        Ack = 'A',   ///< Chunk written, send the next.
+        Wait = 'W',  ///< Still holding the chunk (keep-alive).
+        Done = 'D',  ///< Image verified and set to boot.
+        Error = 'E'  ///< Transfer ended (an Error byte follows).
+    };
+
+    /// @brief Why a transfer ended.
+    enum class Error : uint8_t
+    {
+        None = 0, ///< No error.
+        NoSlot,   ///< No inactive OTA slot in the partition table.
+        TooBig,   ///< Header size is 0 or larger than the slot.
+        Begin,    ///< esp_ota_begin() failed.
+        Timeout,  ///< Host went quiet mid-transfer.
+        Write,    ///< esp_ota_write() failed.
+        Crc,      ///< Image CRC mismatch.
+        Image,    ///< esp_ota_end() rejected the image (header / SHA-256).
+        Boot      ///< esp_ota_set_boot_partition() failed.
+    };
+
+    /// @brief Human-readable error.
+    constexpr const char *to_name(Error e) noexcept
+    {
+        switch (e)
+        {
+        case Error::None:
+            return "none";
+        case Error::NoSlot:
+            return "no slot";
+        case Error::TooBig:
+            return "too big";
+        case Error::Begin:
+            return "begin";
+        case Error::Timeout:
+            return "timeout";
+        case Error::Write:
+            return "write";
+        case Error::Crc:
+            return "crc";
+        case Error::Image:
+            return "image";
+        case Error::Boot:
+            return "boot";
+        default:
+            return "?";
+        }
+    }
+
+    /// @brief Service state.
+    enum class State : uint8_t
+    {
+        Idle = 0,  ///< Waiting for a header.
+        Baseline,  ///< Measuring the drive loop before the first write.
+        Receiving, ///< Streaming chunks into the slot.
+        Done,      ///< New image set to boot.
+        Failed     ///< Last transfer ended with an error.
+    };
+
+    /// @brief Progress and the update's measured effect on the drive loop.
+    struct Status
+    {
+        State state{State::Idle}; ///< Current state.
+        Error error{Error::None}; ///< Last error.
+        uint32_t size{0};         ///< Image size (bytes).
+        uint32_t received{0};     ///< Bytes in flash.
+        uint32_t gap_ms{0};       ///< Current pause between bursts.
+        uint32_t bursts{0};       ///< Flash writes so far.
+        uint32_t costly{0};       ///< Bursts that cost the drive loop an overrun.
+        uint32_t burst_max_us{0}; ///< Longest single write (µs).
+        LoopStats before{};       ///< Drive loop over BASELINE_MS before the first write.
+        LoopStats during{};       ///< Drive loop over the transfer.
+    };
+} ///< Namespace ota.
+
+/**
+ * @brief Receives a firmware image over a UART and streams it into the inactive OTA slot.
+ *
+ * Runs as a background task on core 0, away from PowerDriveHandler. Each
+ * chunk is one flash sector: esp_ota_begin(OTA_WITH_SEQUENTIAL_WRITES)
+ * erases sector by sector as the image arrives, so every write is one
+ * bounded burst instead of a multi-second erase of the whole slot up front.
+ *
+ * Flash bursts stall flash-resident code on both cores, so they are paced:
+ *  - a chunk is only written while writeWhen()'s predicate holds (e.g. the
+ *    motor is at zero duty); the host is sent Wait keep-alives meanwhile;
+ *  - bursts are at least gap_ms apart. The gap doubles (up to MAX_GAP_MS)
+ *    whenever a burst shows up as a drive loop overrun in watch()'s
+ *    statistics, and eases back towards GAP_MS while bursts are free.
+ * Before the first write the drive loop is measured alone for BASELINE_MS,
+ * and again over the whole transfer, so status() reports what the update
+ * cost (period max / p99 / overruns before vs during).
+ *
+ * After a verified image is set to boot, the device reboots once the drive
+ * is idle (cfg::ota::AUTO_REBOOT). The new image boots pending-verify
+ * (needs CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE): this service marks it
+ * valid after CONFIRM_MS if healthyWhen()'s self-test passes, otherwise it
+ * marks it invalid and the bootloader rolls back to the previous slot via
+ * otadata.
+ */
+class OtaService : public rtos::Task<OtaService>
+{
+public:
+    using IdleFn = bool (*)();       ///< True when a flash burst may stall the drive (e.g. duty is 0).
+    using StatsFn = LoopStats (*)(); ///< Drive loop statistics.
+    using ResetFn = void (*)();      ///< Restart the drive loop statistics window.
+    using HealthFn = bool (*)();     ///< New image self-test.
+
+    /**
+     * @brief Construct with the host UART (no hardware access).
+     *
+     * @param port UART the image arrives on (non-owning).
+     */
+    explicit OtaService(HardwareSerial &port) noexcept : port_(&port) {}
+
+    /**
+     * @brief Find the inactive slot, read the running image's state and open the UART.
+     *
+     * @return true If an update slot exists.
+     */
+    bool begin() noexcept;
+
+    /**
+     * @brief Gate flash bursts (call before the task starts).
+     *
+     * @param idle Predicate polled before each chunk; nullptr → always.
+     */
+    void writeWhen(IdleFn idle) noexcept { idle_ = idle; }
+
+    /**
+     * @brief Drive loop to keep clear of (call before the task starts).
+     *
+     * @param stats Statistics source (nullptr → fixed GAP_MS pacing, no report).
+     * @param reset Window restart (nullptr → cumulative statistics).
+     */
+    void watch(StatsFn stats, ResetFn reset = nullptr) noexcept
+    {
+        stats_ = stats;
+        reset_ = reset;
+    }
+
+    /**
+     * @brief Self-test for a freshly booted image (call before the task starts).
+     *
+     * @param healthy Checked after CONFIRM_MS; nullptr → reaching CONFIRM_MS is enough.
+     */
+    void healthyWhen(HealthFn healthy) noexcept { healthy_ = healthy; }
+
+    /// @brief Progress and drive-loop effect of the current / last transfer.
+    [[nodiscard]] ota::Status status() const noexcept;
+
+    /// @brief True while the running image still awaits confirmation.
+    [[nodiscard]] bool pendingVerify() const noexcept { return pending_; }
+
+    /// @brief Running slot label.
+    [[nodiscard]] const char *running() const noexcept { return running_ ? running_->label : "?"; }
+
+    /// @brief Slot the next image goes to.
+    [[nodiscard]] const char *target() const noexcept { return slot_ ? slot_->label : "-"; }
+
+private:
+    friend class rtos::Task<OtaService>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Ota; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /// @brief Mark the running image valid, or roll back, after CONFIRM_MS.
+    void verifyRunning() noexcept;
+
+    /**
+     * @brief Wait (polling) for a transfer header.
+     *
+     * @param h Receives the header.
+     * @return true If a complete header arrived.
+     */
+    bool readHeader(ota::Header &h) noexcept;
+
+    /**
+     * @brief Run one transfer into slot_.
+     *
+     * @param h Transfer header.
+     * @return Error Error::None on success.
+     */
+    ota::Error transfer(const ota::Header &h) noexcept;
+
+    /**
+     * @brief Read exactly @p n bytes.
+     *
+     * @param dst Destination.
+     * @param n Bytes to read.
+     * @param timeout_ms Longest silence between bytes.
+     * @return true If all bytes arrived.
+     */
+    bool readExact(uint8_t *dst, std::size_t n, uint32_t timeout_ms) noexcept;
+
+    /**
+     * @brief Write one chunk once the drive allows it, and adapt the gap to its cost.
+     *
+     * @param h OTA handle.
+     * @param n Bytes in buf_.
+     * @return true If written.
+     */
+    bool writeChunk(esp_ota_handle_t h, std::size_t n) noexcept;
+
+    /// @brief Send one reply byte (and the error code after Reply::Error).
+    void reply(ota::Reply r, ota::Error e = ota::Error::None) noexcept;
+
+    /// @brief Update the shared status under the lock.
+    template <typename F>
+    void edit(F f) noexcept
+    {
+        portENTER_CRITICAL(&mux_);
+        f(status_);
+        portEXIT_CRITICAL(&mux_);
+    }
+
+    HardwareSerial *port_{nullptr};                           ///< Host UART.
+    const esp_partition_t *running_{nullptr};                 ///< Running slot.
+    const esp_partition_t *slot_{nullptr};                    ///< Inactive slot (update target).
+    bool pending_{false};                                     ///< Running image boots pending-verify.
+    IdleFn idle_{nullptr};                                    ///< Flash burst gate.
+    StatsFn stats_{nullptr};                                  ///< Drive loop statistics.
+    ResetFn reset_{nullptr};                                  ///< Drive loop window restart.
+    HealthFn healthy_{nullptr};                               ///< Self-test.
+    uint32_t gap_ms_{cfg::ota::GAP_MS};                       ///< Current pause between bursts.
+    TickType_t last_burst_{0};                                ///< Tick the previous burst ended.
+    alignas(4) std::array<uint8_t, cfg::ota::CHUNK> buf_{};   ///< One chunk.
+    ota::Status status_{};                                    ///< Shared with status().
+    mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED; ///< Guards status_.
+};
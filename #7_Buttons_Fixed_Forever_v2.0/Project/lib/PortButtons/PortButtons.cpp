@@ -0,0 +1,140 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the PortButtons input readers (GPIO registers, 74HC165, MCP23017).
+ *
+ * @file PortButtons.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "PortButtons.h"
+#include <soc/gpio_reg.h>
+
+// ---- GpioPortReader ---- //
+
+// Configure the pins as inputs.
+void GpioPortReader::begin(const uint8_t *pins, std::size_t n, bool pullup) noexcept
+{
+    configASSERT(pins != nullptr && n > 0 && n <= kMaxInputs);
+
+    n_ = n;
+    bank1_ = false;
+    contiguous_ = true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        pins_[i] = pins[i];
+        pinMode(pins[i], pullup ? INPUT_PULLUP : INPUT);
+        bank1_ = bank1_ || (pins[i] >= 32);
+        contiguous_ = contiguous_ && (pins[i] == pins[0] + i);
+    }
+    contiguous_ = contiguous_ && ((pins[0] >> 5) == ((pins[0] + n - 1) >> 5)); ///< One bank only.
+}
+
+// Sample every input.
+uint64_t HOT_IRAM GpioPortReader::read() const noexcept
+{
+    const uint32_t in0 = REG_READ(GPIO_IN_REG);               ///< GPIO 0..31.
+    const uint32_t in1 = bank1_ ? REG_READ(GPIO_IN1_REG) : 0; ///< GPIO 32..48.
+    const uint64_t all = static_cast<uint64_t>(in0) | (static_cast<uint64_t>(in1) << 32);
+
+    if (contiguous_)
+        return (all >> pins_[0]) & ((n_ >= 64) ? ~0ULL : ((1ULL << n_) - 1)); ///< One shift + mask.
+
+    uint64_t out = 0;
+    for (std::size_t i = 0; i < n_; ++i)
+        out |= ((all >> pins_[i]) & 1ULL) << i;
+    return out;
+}
+
+// ---- Hc165Reader ---- //
+
+// Configure the pins.
+void Hc165Reader::begin() noexcept
+{
+    pinMode(load_, OUTPUT);
+    pinMode(clk_, OUTPUT);
+    pinMode(data_, INPUT);
+    digitalWrite(load_, HIGH);
+    digitalWrite(clk_, LOW);
+}
+
+// Latch and shift every input.
+uint64_t Hc165Reader::read() const noexcept
+{
+    digitalWrite(load_, LOW); ///< Parallel load.
+    delayMicroseconds(1);
+    digitalWrite(load_, HIGH);
+
+    uint64_t out = 0;
+    for (uint8_t i = 0; i < n_; ++i)
+    {
+        out |= static_cast<uint64_t>(digitalRead(data_) ? 1 : 0) << i;
+        digitalWrite(clk_, HIGH); ///< Next bit.
+        digitalWrite(clk_, LOW);
+    }
+    return out;
+}
+
+// ---- Mcp23017Reader ---- //
+
+namespace
+{
+    constexpr uint8_t kIodirA = 0x00; ///< Direction register A (B follows with IOCON.BANK = 0).
+    constexpr uint8_t kGppuA = 0x0C;  ///< Pull-up register A.
+    constexpr uint8_t kGpioA = 0x12;  ///< Port register A.
+} // namespace
+
+// Construct for a set of expanders.
+Mcp23017Reader::Mcp23017Reader(TwoWire &bus, const uint8_t *addrs, std::size_t chips) noexcept
+    : bus_(&bus), chips_((chips <= kMaxChips) ? chips : kMaxChips)
+{
+    for (std::size_t i = 0; i < chips_; ++i)
+        addr_[i] = addrs[i];
+}
+
+// Configure every pin as an input with pull-up.
+void Mcp23017Reader::begin() noexcept
+{
+    for (std::size_t i = 0; i < chips_; ++i)
+    {
+        bus_->beginTransmission(addr_[i]);
+        bus_->write(kIodirA);
+        bus_->write(0xFF); ///< IODIRA: inputs.
+        bus_->write(0xFF); ///< IODIRB: inputs.
+        bus_->endTransmission();
+
+        bus_->beginTransmission(addr_[i]);
+        bus_->write(kGppuA);
+        bus_->write(0xFF); ///< GPPUA.
+        bus_->write(0xFF); ///< GPPUB.
+        bus_->endTransmission();
+    }
+}
+
+// Read GPIOA/B of every chip.
+uint64_t Mcp23017Reader::read() const noexcept
+{
+    uint64_t out = 0;
+    for (std::size_t i = 0; i < chips_; ++i)
+    {
+        bus_->beginTransmission(addr_[i]);
+        bus_->write(kGpioA);
+        if (bus_->endTransmission(false) != 0)
+        {
+            out |= 0xFFFFULL << (16 * i); ///< No ACK: read as released (pull-ups).
+            continue;
+        }
+
+        uint16_t w = 0xFFFF;
+        if (bus_->requestFrom(addr_[i], static_cast<uint8_t>(2)) == 2)
+        {
+            const uint8_t a = static_cast<uint8_t>(bus_->read());
+            const uint8_t b = static_cast<uint8_t>(bus_->read());
+            w = static_cast<uint16_t>(a | (b << 8));
+        }
+        out |= static_cast<uint64_t>(w) << (16 * i);
+    }
+    return out;
+}
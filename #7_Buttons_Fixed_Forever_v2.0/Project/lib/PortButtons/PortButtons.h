@@ -0,0 +1,218 @@
+/**
+ * MIT License
+ *
+ * @brief Word-at-a-time button backend: one port / expander read + vertical-counter debounce per update().
+ *
+ * @file PortButtons.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <Arduino.h>
+#include <Wire.h>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <HotPath.h>
+#include <Universal_Button.h>
+#include <VerticalDebounce.h>
+
+// ---- Readers: read every input in one transfer, bit i = button i (1 = raw level high) ---- //
+
+/**
+ * @brief Native GPIOs read through the input registers (GPIO.in / GPIO.in1).
+ *
+ * At most two register reads per update. If the pins are ascending and
+ * contiguous within one bank the gather is a single shift + mask; otherwise
+ * it is one bit test per input.
+ */
+class GpioPortReader
+{
+public:
+    static constexpr std::size_t kMaxInputs = 64; ///< Inputs per reader.
+
+    /**
+     * @brief Configure @p n pins as inputs.
+     *
+     * @param pins GPIO numbers in button order (copied).
+     * @param n Pin count (≤ kMaxInputs).
+     * @param pullup Enable the internal pull-ups (active-low buttons).
+     */
+    void begin(const uint8_t *pins, std::size_t n, bool pullup = true) noexcept;
+
+    /// @brief Sample every input (HOT_IRAM: KeyMatrix calls it from its alarm ISR).
+    [[nodiscard]] uint64_t read() const noexcept;
+
+private:
+    std::array<uint8_t, kMaxInputs> pins_{}; ///< GPIO per input.
+    std::size_t n_{0};                       ///< Inputs.
+    bool bank1_{false};                      ///< Any pin ≥ 32 (second read needed).
+    bool contiguous_{false};                 ///< Fast path: pins_[0] .. pins_[0]+n-1 in one bank.
+};
+
+/**
+ * @brief 74HC165 parallel-in / serial-out chain (8 inputs per chip).
+ *
+ * One latch pulse, then one clock per input. Input 0 is the first bit out
+ * (H of the chip nearest the MCU).
+ */
+class Hc165Reader
+{
+public:
+    /**
+     * @brief Construct for a chain.
+     *
+     * @param load SH/LD pin (active low).
+     * @param clock CLK pin.
+     * @param data QH pin of the last chip.
+     * @param inputs Total inputs (8 per chip, ≤ 64).
+     */
+    constexpr Hc165Reader(uint8_t load, uint8_t clock, uint8_t data, uint8_t inputs) noexcept
+        : load_(load), clk_(clock), data_(data), n_(inputs) {}
+
+    /// @brief Configure the pins.
+    void begin() noexcept;
+
+    /// @brief Latch and shift every input.
+    [[nodiscard]] uint64_t read() const noexcept;
+
+private:
+    uint8_t load_; ///< SH/LD pin.
+    uint8_t clk_;  ///< CLK pin.
+    uint8_t data_; ///< QH pin.
+    uint8_t n_;    ///< Inputs.
+};
+
+/**
+ * @brief MCP23017 I2C expanders (16 inputs each), GPIOA + GPIOB in one 2-byte read per chip.
+ */
+class Mcp23017Reader
+{
+public:
+    static constexpr std::size_t kMaxChips = 4; ///< 64 inputs.
+
+    /**
+     * @brief Construct for @p chips expanders on @p bus.
+     *
+     * @param bus I2C bus (begun by the caller).
+     * @param addrs 7-bit addresses in input order (copied).
+     * @param chips Expander count (≤ kMaxChips).
+     */
+    Mcp23017Reader(TwoWire &bus, const uint8_t *addrs, std::size_t chips) noexcept;
+
+    /// @brief Configure every pin as an input with pull-up.
+    void begin() noexcept;
+
+    /// @brief Read GPIOA/B of every chip.
+    [[nodiscard]] uint64_t read() const noexcept;
+
+private:
+    TwoWire *bus_;                          ///< Non-owning I2C bus.
+    std::array<uint8_t, kMaxChips> addr_{}; ///< Chip addresses.
+    std::size_t chips_{0};                  ///< Chips.
+};
+
+// ---- Handler ---- //
+
+/**
+ * @brief Button handler that debounces all inputs in one word per step.
+ *
+ * update() takes one reading and clocks the vertical counters once per
+ * elapsed sample period (debounce_ms / VerticalDebounce::kSamples). When
+ * several periods have passed since the last call (interrupt wake after an
+ * idle spell) the previous reading is replayed for the missed periods, which
+ * is what the inputs held while nobody looked. This keeps the debounce time
+ * the same in StateManager's poll and interrupt modes.
+ *
+ * snapshot() fills the bitset straight from the debounced word, so the cost
+ * of both calls is flat in the button count. Exposes the same update() /
+ * snapshot() pair as ButtonHandler, so StateManager takes it unchanged.
+ *
+ * @tparam N Button count (≤ 64).
+ * @tparam Reader GpioPortReader, Hc165Reader, Mcp23017Reader or anything with read() → uint64_t.
+ */
+template <std::size_t N, typename Reader>
+class PortButtons : public IButtonHandler
+{
+    static_assert(N > 0 && N <= 64, "PortButtons handles 1..64 inputs.");
+
+public:
+    using Word = std::conditional_t<(N <= 32), uint32_t, uint64_t>; ///< Counter word.
+
+    /**
+     * @brief Construct around a configured reader.
+     *
+     * @param reader Input reader (begun by the caller).
+     * @param debounce_ms Time an input must be stable to change state (ms).
+     * @param active_low Buttons pull the line low when pressed.
+     */
+    PortButtons(Reader &reader, uint32_t debounce_ms = cfg::button::BTN_DEBOUNCE_MS, bool active_low = true) noexcept
+        : reader_(&reader),
+          period_ms_((debounce_ms / VerticalDebounce<Word>::kSamples) ? (debounce_ms / VerticalDebounce<Word>::kSamples) : 1),
+          invert_(active_low ? kMask : 0) {}
+
+    /// @brief Seed the debounced state from the current levels (call once after the reader's begin()).
+    void begin() noexcept
+    {
+        last_raw_ = sample();
+        deb_.reset(last_raw_);
+        last_ms_ = millis();
+    }
+
+    /// @brief Sample and debounce every input.
+    void update() override
+    {
+        const uint32_t now = millis();
+        const Word raw = sample();
+
+        uint32_t steps = (now - last_ms_) / period_ms_;
+        if (steps > 0)
+        {
+            last_ms_ += steps * period_ms_;
+            steps = (steps < VerticalDebounce<Word>::kSamples) ? steps : VerticalDebounce<Word>::kSamples;
+            for (uint32_t i = 1; i < steps; ++i)
+                deb_.clock(last_raw_); ///< Missed periods: the level held before this reading.
+            deb_.clock(raw);
+        }
+        last_raw_ = raw;
+    }
+
+    /// @brief Debounced levels (1 = pressed), bit i = button i (IButtonHandler; bits past N read 0).
+    void snapshot(std::bitset<NUM_BUTTONS> &out) const override { fill(out); }
+
+    /// @brief The same at the panel's own width, for N ≠ NUM_BUTTONS (ButtonBench).
+    template <std::size_t M = N, typename = std::enable_if_t<M != NUM_BUTTONS>>
+    void snapshot(std::bitset<N> &out) const { fill(out); }
+
+    /// @brief True if button @p i is pressed (debounced).
+    [[nodiscard]] bool isPressed(std::size_t i) const noexcept { return (deb_.state() >> i) & 1U; }
+
+private:
+    static constexpr Word kMask = (N >= sizeof(Word) * 8) ? ~Word{0} : ((Word{1} << N) - 1); ///< Used bits.
+
+    /// @brief Copy the debounced word into @p out (truncated or zero-extended to M bits).
+    template <std::size_t M>
+    void fill(std::bitset<M> &out) const noexcept
+    {
+        if constexpr (N <= 32)
+            out = std::bitset<M>(static_cast<unsigned long>(deb_.state()));
+        else
+            out = std::bitset<M>(static_cast<unsigned long long>(deb_.state()));
+    }
+
+    /// @brief One reading, active-high.
+    Word sample() const noexcept { return (static_cast<Word>(reader_->read()) ^ invert_) & kMask; }
+
+    Reader *reader_;               ///< Non-owning input reader.
+    uint32_t period_ms_;           ///< Sample period (ms).
+    Word invert_;                  ///< XOR mask: active-low → active-high.
+    Word last_raw_{0};             ///< Previous reading.
+    uint32_t last_ms_{0};          ///< Time of the last clocked period (ms).
+    VerticalDebounce<Word> deb_{}; ///< Bit-parallel counters.
+};
@@ -10,40 +10,396 @@
  */
 
 #include "PowerDriveHandler.h"
+#include <esp_intr_alloc.h>
 
 // Main run loop.
-void PowerDriveHandler::run() noexcept
+void HOT_IRAM PowerDriveHandler::run() noexcept
 {
     configASSERT(motor_ != nullptr && bus_ != nullptr); ///< Sanity check: motor_ and bus_ must be valid.
-    configASSERT(loop_ticks_ > 0);                      ///< Timing must be configured.
+    configASSERT(period_us_ > 0);                       ///< Timing must be configured.
+
+    task_ = xTaskGetCurrentTaskHandle(); ///< Timer ISR notification target (set before arming).
+
+    if (pacing_ == Pacing::HwTimer && !startTimer())
+    {
+        logWarn("PDHandler: GPTimer unavailable, falling back to tick pacing.");
+        pacing_ = Pacing::Tick;
+    }
 
     TickType_t last_wake = xTaskGetTickCount(); ///< Reference tick for periodic task scheduling.
+    uint64_t last_us = now_us();                ///< Previous update time (dt reference).
 
     for (;;)
     {
-        const ControlSnapshot cur = bus_->peek();
+        const uint64_t top = now_us();
+        const bool parked = cadence_.tier(top) == cadence::Tier::Park;
+        const uint32_t due_us = parked                         ? kParkBeatMs * 1000U
+                                : (pacing_ == Pacing::HwTimer) ? period_us_
+                                                               : Heartbeat::ticksUs(loop_ticks_); ///< Longest block ahead.
+        beat_.beat(top, due_us);
+        if (parked)
+        {
+            park();                          ///< Standstill: no alarms until something changes.
+            last_wake = xTaskGetTickCount(); ///< Tick pacing restarts from the wakeup.
+        }
+        else if (pacing_ == Pacing::HwTimer)
+        {
+            lock_.acquire();                                                 ///< No-op while held.
+            const uint32_t alarms = ulTaskNotifyTake(pdTRUE, portMAX_DELAY); ///< Block until the next alarm.
+            if (alarms > 1)
+                timing_.missed(alarms - 1); ///< Alarms that fired while we were still busy.
+        }
+        else
+        {
+            lock_.acquire();                          ///< No-op while held.
+            vTaskDelayUntil(&last_wake, loop_ticks_); ///< Pace loop.
+        }
+
+        // Measured dt: scheduling jitter changes the step size, not the ramp rate.
+        const uint64_t now = now_us();
+        if (reset_.exchange(false, std::memory_order_relaxed))
+            timing_.reset(); ///< Requested by a bench / console: restart the window here, on the loop's own task.
+        timing_.tick(now);
+        const uint32_t dt_us = static_cast<uint32_t>((now - last_us) < kMaxDtUs ? (now - last_us) : kMaxDtUs);
+        last_us = now;
+
+        {
+            const trace::CostScope cost(trace::Work::Drive);
+            step(dt_us, now);
+        }
+
+        if (woke_)
+        {
+            woke_ = false;
+            if (cadence_.tier(now) != cadence::Tier::Park)
+                pm::woke(last_origin_us_, now_us()); ///< The frame that got the car moving (not a parked heartbeat).
+        }
+    }
+}
+
+// One control update: clamp target, ramp, speed trim, drive.
+void HOT_IRAM PowerDriveHandler::step(uint32_t dt_us, uint64_t now) noexcept
+{
+    ctl_seq_ = bus_->sequence(); ///< Before the copy: a racing publish wakes a parked loop.
+    ControlSnapshot cur{};
+    if (!bus_->peek_checked(cur, control_age_, now))
+    {
+        cur.throttle_cmd_pct = real_t{}; ///< ControlCore went quiet (or never published): ramp to a stop, not on old data.
+        cur.throttle_rate = 0;
+    }
+
+    // ---- Protection: a latched trip holds the bridge off until FaultGuard clears it ---- //
+    if (fault_ != nullptr && fault_->peek().latched != FaultSnapshot::None)
+    {
+        holdFaulted(cur, now);
+        return;
+    }
+    faulted_ = false;
+
+    // Target selection: the sign picks the direction, reverse is capped.
+    const real_t cmd = num::clamp(cur.throttleAt(now), real_t{-kMaxPct}, real_t{kMaxPct}); ///< Predicted to this tick; clamp to avoid nonsense values.
+    const bool back = cmd < real_t{};
+    const Dir want = back ? kReverse : ((cmd > real_t{}) ? kForward : dir_); ///< Zero keeps the current direction.
+    const real_t targetPct = back ? num::min(-cmd, real_t{cfg::drive::REVERSE_MAX_PCT}) : cmd;
+
+    // ---- Direction change: decel → brake / coast → dead time, then the other leg ---- //
+    float ceiling = kMaxPct;
+    const bool sequencing = sequenceReversal(want, dt_us, now);
+    if (!sequencing)
+    {
+        // ---- Acceleration/deceleration (SlewEngine, advanced once per tick) ---- //
+        ramp_.setTarget(targetPct);
+        current_pct_ = num::to_float(ramp_.step(num::seconds<real_t>(dt_us)).pct); ///< No jump coasting: never asks for coast.
 
-        // Target selection.
-        const float targetPct = fminf(fmaxf(cur.throttle_cmd_pct, kMinPct), kMaxPct); ///< Clamp to avoid nonsense values.
+        // ---- Current / power envelope (every new PowerBus frame) ---- //
+        ceiling = updateLimit(now);
+        if (limp_.load(std::memory_order_relaxed))
+            ceiling = fminf(ceiling, cfg::supervisor::DEGRADE_PCT); ///< A supervised task is stalling: limp.
+        limited_ = current_pct_ > ceiling;
+        if (limited_)
+        {
+            current_pct_ = ceiling;
+            ramp_.reset(real_t{ceiling}); ///< Resume ramping from the ceiling, not from where the ramp would have been.
+        }
+    }
 
-        // ---- Simple acceleration/deceleration (rate-based) ---- //
-        const float dt_sec =
-            (static_cast<float>(loop_ticks_) * static_cast<float>(portTICK_PERIOD_MS)) / 1000.0f;
+    // ---- Speed loop + telemetry (every kSampleUs) ---- //
+    const float sign = (dir_ == kReverse) ? -1.0f : 1.0f; ///< The encoder rpm is signed: so are the setpoint and telemetry.
+    const bool sample_due = (now - last_sample_us_) >= kSampleUs;
+    if (sample_due)
+    {
+        last_sample_us_ = now;
+        measured_rpm_ = updateSpeedLoop(sign * current_pct_ * kRpmPerPct, now);
+    }
+
+    float duty_pct = current_pct_; ///< What the sequence applied (no trim while reversing).
+    if (!sequencing)
+    {
+        duty_pct = fminf(fmaxf(current_pct_ + trim_pct_, kMinPct), ceiling); ///< Trim can't push past the envelope.
+        bridge_pct_.fill(duty_pct);
+        motor_->setSpeedPercent(bridge_pct_, dir_); ///< One batch: every bridge updates on the same PWM period.
+        if (duty_pct > kMinPct)
+            last_drive_us_ = now;
+    }
+    logTrace("Speed: %.1f %%", duty_pct); ///< Compiled out unless cfg::logging::MODULE[Drive] is Trace.
 
-        const float ramp_step_pct = kRampRatePctPerSec * dt_sec;
+    // Standstill (nothing commanded, applied, sequencing or still turning) lets the loop park.
+    if (cmd != real_t{} || duty_pct > kMinPct || phase_ != Phase::Drive || (now - last_drive_us_) < kHoldUs ||
+        fabsf(measured_rpm_) >= cfg::drive::STOP_RPM || awake_.load(std::memory_order_relaxed))
+        cadence_.touch(now);
 
-        if (current_pct_ < targetPct)
+    if (cur.origin_us != last_origin_us_)
+    {
+        last_origin_us_ = cur.origin_us; ///< First application of this event → stick/button-to-wheel.
+        trace::mark((cur.origin_src == ControlSnapshot::Source::Rc) ? trace::Stage::MotorRc : trace::Stage::MotorButton,
+                    cur.origin_us);
+    }
+
+    if (sample_due)
+    {
+        TelemetrySnapshot t{};
+        t.rpm = measured_rpm_;
+        t.setpoint_rpm = sign * current_pct_ * kRpmPerPct;
+        t.duty_pct = sign * duty_pct;
+        publishTelemetry(t, cur, now);
+    }
+}
+
+// Advance the direction-change sequence.
+bool HOT_IRAM PowerDriveHandler::sequenceReversal(Dir want, uint32_t dt_us, uint64_t now) noexcept
+{
+    if (want == dir_)
+    {
+        if (phase_ != Phase::Drive)
         {
-            current_pct_ = fminf(current_pct_ + ramp_step_pct, targetPct);
+            ramp_.reset(real_t{current_pct_}); ///< Same leg as before: pick up from the current duty, no gap needed.
+            enterPhase(Phase::Drive, now);
         }
-        else if (current_pct_ > targetPct)
+        return false;
+    }
+
+    if (phase_ == Phase::Drive)
+    {
+        stop_ramp_.reset(real_t{current_pct_});
+        stop_ramp_.setTarget(real_t{});
+        limited_ = false;
+        enterPhase(Phase::Stopping, now);
+    }
+
+    switch (phase_)
+    {
+    case Phase::Stopping:
+        current_pct_ = num::to_float(stop_ramp_.step(num::seconds<real_t>(dt_us)).pct);
+        bridge_pct_.fill(current_pct_);
+        motor_->setSpeedPercent(bridge_pct_, dir_); ///< Still the old leg: slow decay brakes through the off time.
+        if (current_pct_ > kMinPct)
         {
-            current_pct_ = fmaxf(current_pct_ - ramp_step_pct, targetPct);
+            last_drive_us_ = now;
+            return true;
         }
+        enterPhase(Phase::Holding, now);
+        [[fallthrough]];
 
-        motor_->setSpeedPercent(current_pct_, kDir);
-        // debugfln("Speed: %.1f %%", current_pct_);
+    case Phase::Holding:
+    {
+        const bool slow = encoder_ != nullptr && encoder_->ready() && last_sample_us_ > phase_us_ &&
+                          fabsf(measured_rpm_) < cfg::drive::STOP_RPM; ///< Only a sample taken since the hold began counts.
+        if (!slow && (now - last_drive_us_) < kHoldUs)
+            return true;
+        enterPhase(Phase::DeadTime, now);
+        return true;
+    }
+
+    case Phase::DeadTime:
+        if ((now - phase_us_) < kDeadUs)
+            return true;
+        dir_ = want;
+        ramp_.reset();
+        enterPhase(Phase::Drive, now);
+        return false; ///< The new leg is driven by the normal path this same step.
+
+    case Phase::Drive:
+    default:
+        return false;
+    }
+}
+
+// Enter a sequence phase and set its bridge state.
+void HOT_IRAM PowerDriveHandler::enterPhase(Phase p, uint64_t now) noexcept
+{
+    phase_ = p;
+    phase_us_ = now;
+    if (p == Phase::Holding || p == Phase::DeadTime)
+    {
+        current_pct_ = 0.0f;
+        trim_pct_ = 0.0f;
+        pid_.reset();
+        bridge_pct_.fill(0.0f);
+    }
+    if (p == Phase::Holding && cfg::drive::REVERSE_BRAKE)
+        motor_->brake(); ///< Both low sides on: back-EMF into the motor's own resistance.
+    else if (p == Phase::Holding || p == Phase::DeadTime)
+        motor_->coast(); ///< Every switch off: nothing can conduct across the bridge.
+}
+
+// Latched trip: coast once, reset the ramp and speed loop, keep telemetry alive.
+void HOT_IRAM PowerDriveHandler::holdFaulted(const ControlSnapshot &cur, uint64_t now) noexcept
+{
+    if (!faulted_)
+    {
+        faulted_ = true;
+        motor_->coast(); ///< EN is already low (FaultGuard): bring the backend's own state in line.
+        ramp_.reset();
+        pid_.reset();
+        current_pct_ = 0.0f;
+        trim_pct_ = 0.0f;
+        bridge_pct_.fill(0.0f);
+        limit_pct_ = kMaxPct;
+        limited_ = false;
+        phase_ = Phase::Drive;
+        last_drive_us_ = now; ///< Still spinning when the trip hit: a reversal after the clear waits out the hold.
+    }
+
+    if ((now - last_sample_us_) < kSampleUs)
+        return;
+    last_sample_us_ = now;
+
+    TelemetrySnapshot t{}; ///< Zero duty / setpoint while held.
+    publishTelemetry(t, cur, now);
+}
+
+// Fill the common telemetry fields and publish.
+void HOT_IRAM PowerDriveHandler::publishTelemetry(TelemetrySnapshot &t, const ControlSnapshot &cur, uint64_t now) noexcept
+{
+    if (power_ != nullptr)
+    {
+        const PowerSnapshot p = power_->peek(); ///< Latest DMA frame: no conversion on the control core.
+        t.vbus_v = p.vbus_v;
+        t.amps = p.amps;
+    }
+    t.closed_loop = (encoder_ != nullptr && encoder_->ready());
+    t.limited = limited_;
+    t.stamp_us = now;
+    t.origin_us = cur.origin_us;
+    telemetry_->publish(t);
+}
+
+// Advance the current / power envelope on a new PowerBus frame.
+float HOT_IRAM PowerDriveHandler::updateLimit(uint64_t now) noexcept
+{
+    if (!kLimitOn || power_ == nullptr)
+        return kMaxPct;
+
+    PowerSnapshot p{};
+    if (!power_->peek_checked(p, power_age_, now))
+    {
+        limit_pct_ = fminf(limit_pct_, cfg::limit::FLOOR_PCT); ///< Envelope blind: limp until frames return (then RELEASE_PCT_S).
+        return limit_pct_;
+    }
+    if (p.stamp_us == last_power_us_ || !p.has_amps)
+        return limit_pct_; ///< No new frame: hold the ceiling.
+    const uint64_t frame_us = (last_power_us_ != 0) ? p.stamp_us - last_power_us_ : 0;
+    const float frame_dt = static_cast<float>(frame_us < kMaxDtUs ? frame_us : kMaxDtUs) * 1e-6f;
+    last_power_us_ = p.stamp_us;
+
+    float ratio = 0.0f; ///< Measured / limit, worst of current and power.
+    if (cfg::limit::MAX_AMPS > 0.0f)
+        ratio = p.amps / cfg::limit::MAX_AMPS;
+    if (cfg::limit::MAX_WATTS > 0.0f && p.has_vbus)
+        ratio = fmaxf(ratio, p.watts / cfg::limit::MAX_WATTS);
 
-        vTaskDelayUntil(&last_wake, loop_ticks_); ///< Pace loop.
+    if (ratio > 1.0f)
+        limit_pct_ = fminf(limit_pct_, bridge_pct_[0] / ratio); ///< Scale the applied duty back onto the envelope.
+    else if (ratio < cfg::limit::RELEASE_RATIO)
+        limit_pct_ += cfg::limit::RELEASE_PCT_S * frame_dt;
+
+    limit_pct_ = fminf(fmaxf(limit_pct_, cfg::limit::FLOOR_PCT), kMaxPct);
+    return limit_pct_;
+}
+
+// Sample the encoder and advance the speed loop.
+float HOT_IRAM PowerDriveHandler::updateSpeedLoop(float setpoint_rpm, uint64_t now) noexcept
+{
+    if (encoder_ == nullptr || !encoder_->ready())
+        return 0.0f; ///< Open loop: no measurement, no trim.
+
+    const SpeedEncoder::Reading r = encoder_->read(now);
+    if (r.window_us == 0)
+        return measured_rpm_; ///< Rejected sample: hold the previous trim and speed.
+
+    if (current_pct_ <= kMinPct)
+    {
+        pid_.reset(); ///< Stopped: don't wind up against a stationary shaft.
+        trim_pct_ = 0.0f;
     }
-}
\ No newline at end of file
+    else
+    {
+        const q16_t dt_q16 = static_cast<q16_t>((static_cast<int64_t>(r.window_us) << 16) / 1000000LL);
+        const float out = from_q16(pid_.update(to_q16(setpoint_rpm), r.rpm_q16, dt_q16));
+        trim_pct_ = (setpoint_rpm < 0.0f) ? -out : out; ///< Signed rpm error → duty magnitude (more reverse speed = more duty).
+    }
+
+    return from_q16(r.rpm_q16);
+}
+
+// Park: stop the pacing timer, block until a new control frame or the beat, then restart it.
+void PowerDriveHandler::park() noexcept
+{
+    const auto group = static_cast<timer_group_t>(cfg::drive::TIMER_GROUP);
+    const auto index = static_cast<timer_idx_t>(cfg::drive::TIMER_INDEX);
+
+    if (pacing_ == Pacing::HwTimer)
+        timer_pause(group, index);
+
+    lock_.release();                                      ///< Standstill: the chip may slow down or sleep.
+    bus_->wait_newer(ctl_seq_, to_ticks_ms(kParkBeatMs)); ///< One-shot subscription: only a parked loop takes ControlBus wakeups.
+    woke_ = bus_->sequence() != ctl_seq_;
+    if (woke_)
+        lock_.acquire(); ///< Full clock before the step that applies it (a beat steps at whatever clock it finds).
+
+    if (pacing_ == Pacing::HwTimer)
+    {
+        ulTaskNotifyTake(pdTRUE, 0); ///< Drop alarms that landed before the pause.
+        timer_set_counter_value(group, index, 0);
+        timer_start(group, index); ///< First alarm one period after this step.
+    }
+    timing_.pause();     ///< The parked gap is not a period.
+    last_sample_us_ = 0; ///< The wake step samples and publishes: telemetry answers every frame, even one that parks again.
+}
+
+// Configure and start the pacing GPTimer.
+bool PowerDriveHandler::startTimer() noexcept
+{
+    const auto group = static_cast<timer_group_t>(cfg::drive::TIMER_GROUP);
+    const auto index = static_cast<timer_idx_t>(cfg::drive::TIMER_INDEX);
+
+    timer_config_t tc{};
+    tc.divider = kTimerDivider;           ///< 1 tick = 1 µs.
+    tc.counter_dir = TIMER_COUNT_UP;      ///< Count up from 0.
+    tc.counter_en = TIMER_PAUSE;          ///< Start explicitly below.
+    tc.alarm_en = TIMER_ALARM_EN;         ///< Alarm at period_us_.
+    tc.auto_reload = TIMER_AUTORELOAD_EN; ///< Hardware reload: no drift from ISR latency.
+    tc.intr_type = TIMER_INTR_LEVEL;
+
+    if (timer_init(group, index, &tc) != ESP_OK)
+        return false;
+
+    timer_set_counter_value(group, index, 0);
+    timer_set_alarm_value(group, index, period_us_);
+    timer_enable_intr(group, index);
+
+    // The interrupt is allocated on the calling core, i.e. the core this task is pinned to.
+    // HOT_PATH_IRAM: IRAM-safe, so alarms during a flash write still count (as missed) instead of merging.
+    if (timer_isr_callback_add(group, index, &PowerDriveHandler::onTimerISR, this, HOT_PATH_IRAM ? ESP_INTR_FLAG_IRAM : 0) != ESP_OK)
+        return false;
+
+    return timer_start(group, index) == ESP_OK;
+}
+
+// GPTimer alarm ISR.
+bool IRAM_ATTR PowerDriveHandler::onTimerISR(void *self) noexcept
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(static_cast<PowerDriveHandler *>(self)->task_, &woken); ///< Count the alarm.
+    return woken == pdTRUE;                                                        ///< Yield at ISR exit if PDH is now ready.
+}
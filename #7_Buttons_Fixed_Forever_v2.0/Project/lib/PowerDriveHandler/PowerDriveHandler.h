@@ -12,49 +12,321 @@
 #pragma once
 
 #include <app_config.h>
+#include <RtosTask.h>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <ESP32_MCPWM.h>
+#include <driver/timer.h>
+#include <type_traits>
+#include <array>
+#if defined(SIM_HOST)
+#include <SimDevices.h>
+#else
+#include <MotorBackend.h>
+#include <McpwmArray.h>
+#endif
 #include <ControlBus.h>
+#include <TelemetryBus.h>
+#include <FaultBus.h>
+#include <PowerBus.h>
+#include <LoopStats.h>
+#include <HotPath.h>
+#include <LatencyTrace.h>
+#include <StageCost.h>
+#include <FixedPid.h>
+#include <SlewEngine.h>
+#include <Cadence.h>
+#include <Heartbeat.h>
+#include <PowerManager/PowerManager.h>
+#include <SpeedEncoder/SpeedEncoder.h>
+
+#if defined(SIM_HOST)
+/// @brief Host simulation: the motor + encoder plant stands in for every backend (same members, see MotorBackend.h).
+using DriveBackend = sim::Motor;
+#else
+/// @brief Drive backend selected by cfg::motor::BACKEND (bound at compile time: no virtual call per step).
+using DriveBackend = std::conditional_t<
+    cfg::motor::BACKEND == cfg::motor::Backend::Ledc, motor::LedcBackend<cfg::motor::LEDC_BITS>,
+    std::conditional_t<
+        cfg::motor::BACKEND == cfg::motor::Backend::RmtServo, motor::RmtServoBackend<>,
+        std::conditional_t<cfg::motor::BACKEND == cfg::motor::Backend::McpwmArray, motor::McpwmArray<cfg::motor::BRIDGES>,
+                           motor::McpwmBackend<cfg::motor::CENTER_ALIGNED ? motor::Alignment::Center : motor::Alignment::Edge,
+                                               cfg::motor::DEADTIME>>>>;
+#endif
 
 /**
  * @brief Selects the power level and drives the motor.
+ *
+ * The control update can be paced two ways:
+ *  - Tick: vTaskDelayUntil on the FreeRTOS tick (original behaviour, ≥1 ms).
+ *  - HwTimer: a GPTimer alarm ISR notifies the task every period_us, so the
+ *    loop runs at a fixed rate (1 kHz by default) independent of the tick.
+ *
+ * In both modes the ramp (SlewEngine) steps by the measured time since the
+ * previous update (now_us() delta), and every period is recorded in a LoopTimer.
+ *
+ * With a SpeedEncoder attached, the ramped throttle becomes a speed setpoint
+ * (cfg::encoder::MAX_RPM at 100 %). The ramped percent is kept as the
+ * feed-forward duty and a fixed-point PI(D) adds a bounded trim every
+ * cfg::encoder::WINDOW_US, so the same command holds the same speed across
+ * battery voltage and load. Telemetry is published at that same cadence.
+ *
+ * With a FaultBus attached, a latched trip (FaultGuard) coasts the backend
+ * once, resets the ramp and speed loop, and holds until the latch clears;
+ * the ramp then restarts from 0. The bridge is already off in hardware by
+ * then: this only stops the loop from commanding it.
+ *
+ * With a PowerBus attached, telemetry carries the latest Vbus / current frame,
+ * and cfg::limit adds an envelope: every new frame is checked against
+ * MAX_AMPS / MAX_WATTS and the duty ceiling is cut to applied × limit /
+ * measured (current tracks duty closely at a given speed, so one frame
+ * lands on the limit). The ceiling then recovers at RELEASE_PCT_S once
+ * back inside the envelope. The ramp is held at the ceiling while
+ * limited, so lifting the limit resumes the normal ramp rather than a jump.
+ *
+ * Every step checks how old its inputs are (the buses stamp each publish):
+ * a ControlBus frame older than cfg::fresh::CONTROL_MS is read as throttle 0
+ * (ControlCore republishes every tick::HEARTBEAT_MS, so an old frame means it
+ * stopped), and with the envelope on, a PowerBus frame older than
+ * POWER_FRAMES frames drops the ceiling to cfg::limit::FLOOR_PCT until frames
+ * return. Both ages are kept as histograms (controlAge() / powerAge()).
+ *
+ * The throttle is signed: negative drives CCW, capped at
+ * cfg::drive::REVERSE_MAX_PCT. A sign change never reaches the other leg
+ * directly. The duty ramps to 0 at REVERSE_DECEL_PCT_S, the bridge then
+ * brakes on both low sides (REVERSE_BRAKE) or coasts until STOP_HOLD_MS
+ * after the last non-zero duty (sooner once an encoder reads below
+ * STOP_RPM), and stays fully off for the dead time before the new direction
+ * ramps up from 0. A reversal from standstill only pays the dead time;
+ * asking for the old direction again mid-sequence resumes from where the
+ * duty is.
+ *
+ * At standstill (zero command and duty, no reversal or hold running, shaft
+ * below STOP_RPM) for cfg::cadence::DRIVE_PARK_MS, the loop parks: the
+ * pacing timer stops and the task blocks until ControlCore publishes, or
+ * cfg::cadence::DRIVE_BEAT_MS passes (one step keeps telemetry and the
+ * encoder alive). A new frame is stepped as soon as it wakes the task, and
+ * the timer restarts from there. Parked gaps are kept out of loopStats().
+ * The "drive" pm::Lock (full clock, no light sleep) is held whenever the
+ * loop is not parked; a frame that wakes it takes the lock back before its
+ * step, and that wake → step latency goes to pm::woke().
  */
-class PowerDriveHandler
+class PowerDriveHandler : public rtos::Task<PowerDriveHandler>
 {
 public:
+    /// @brief How the control loop is paced.
+    enum class Pacing : std::uint8_t
+    {
+        Tick = 0, ///< vTaskDelayUntil.
+        HwTimer   ///< GPTimer alarm → task notification.
+    };
+
+    /// @brief Direction-change sequence.
+    enum class Phase : std::uint8_t
+    {
+        Drive = 0, ///< Ramped duty in dir_.
+        Stopping,  ///< Ramping to 0 ahead of a reversal.
+        Holding,   ///< Brake (or coast) until the motor has stopped.
+        DeadTime   ///< Bridge off before the other leg.
+    };
+
     /**
      * @brief Construct with motor driver and input bus.
      *
-     * @param motor Motor driver (non-owning).
+     * @param motor Drive backend, begun and in coast (non-owning).
      * @param bus Control snapshot bus (non-owning).
-     * @param period_ms FreeRTOS tick interval used to pace the run loop (in milliseconds).
+     * @param telemetry Telemetry bus for measured speed / duty (non-owning).
+     * @param encoder Speed encoder (non-owning; nullptr → open loop).
+     * @param fault Fault bus (non-owning; nullptr → no protection input).
+     * @param power Power bus (non-owning; nullptr → no Vbus / current in telemetry).
+     * @param period_us Control period (microseconds; Tick pacing rounds to whole ticks).
+     * @param pacing Loop pacing (defaults to cfg::drive::HW_TIMER).
      */
-    PowerDriveHandler(IMotorDriver &motor, ControlBus &bus, uint32_t period_ms = cfg::tick::LOOP_MS) noexcept
-        : motor_(&motor), bus_(&bus), loop_ticks_(to_ticks_ms(period_ms)) {}
+    PowerDriveHandler(DriveBackend &motor, ControlBus &bus, TelemetryBus &telemetry, SpeedEncoder *encoder = nullptr,
+                      FaultBus *fault = nullptr, PowerBus *power = nullptr, uint32_t period_us = cfg::drive::PERIOD_US,
+                      Pacing pacing = cfg::drive::HW_TIMER ? Pacing::HwTimer : Pacing::Tick) noexcept
+        : motor_(&motor), bus_(&bus), telemetry_(&telemetry), encoder_(encoder), fault_(fault), power_(power),
+          period_us_(period_us),
+          loop_ticks_(to_ticks_ms(period_us / 1000U) > 0 ? to_ticks_ms(period_us / 1000U) : 1),
+          pacing_(pacing), timing_(period_us) {}
 
-    /**
-     * @brief FreeRTOS task trampoline. Call with `pvParameters = this`.
-     */
-    static inline void task(void *self) noexcept
-    {
-        static_cast<PowerDriveHandler *>(self)->run();
-    }
+    /// @brief Measured loop period / jitter statistics.
+    [[nodiscard]] LoopStats loopStats() const noexcept { return timing_.stats(); }
+
+    /// @brief Clear the loop statistics on the next wakeup (safe from any task).
+    void resetLoopStats() noexcept { reset_.store(true, std::memory_order_relaxed); }
+
+    /// @brief Rate tier: Active while driving, Park at standstill (any task).
+    [[nodiscard]] const Cadence &cadence() const noexcept { return cadence_; }
+
+    /// @brief Hold the loop at full rate even at standstill (jitter benches measure a running loop; any task).
+    void keepAwake(bool on) noexcept { awake_.store(on, std::memory_order_relaxed); }
+
+    /// @brief Cap the duty at cfg::supervisor::DEGRADE_PCT (true) or lift the cap (Supervisor; any task).
+    void degrade(bool on) noexcept { limp_.store(on, std::memory_order_relaxed); }
+
+    /// @brief Loop heartbeat (Supervisor).
+    [[nodiscard]] const Heartbeat &heartbeat() const noexcept { return beat_; }
+
+    /// @brief Age of every ControlBus frame stepped on, against cfg::fresh::CONTROL_MS (any task).
+    [[nodiscard]] const snapshot::Freshness &controlAge() const noexcept { return control_age_; }
+
+    /// @brief Age of the PowerBus frame behind every envelope step (envelope on only; any task).
+    [[nodiscard]] const snapshot::Freshness &powerAge() const noexcept { return power_age_; }
 
 private:
+    friend class rtos::Task<PowerDriveHandler>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Drive; ///< Filter for this class's log* sites.
+
     /**
      * @brief Main run loop.
      */
     void run() noexcept;
 
+    /**
+     * @brief One control update: clamp target, ramp, speed trim, drive.
+     *
+     * @param dt_us Measured time since the previous update (µs, ≤ kMaxDtUs).
+     * @param now Time of this update (µs).
+     */
+    void step(uint32_t dt_us, uint64_t now) noexcept;
+
+    /**
+     * @brief Advance the direction-change sequence (owns the bridge while it runs).
+     *
+     * @param want Direction the command asks for.
+     * @param dt_us Measured time since the previous update (µs).
+     * @param now Time of this update (µs).
+     * @return true If the sequence drove the bridge this step (false → normal drive in dir_).
+     */
+    bool sequenceReversal(Dir want, uint32_t dt_us, uint64_t now) noexcept;
+
+    /**
+     * @brief Enter a sequence phase and set its bridge state (brake / coast).
+     *
+     * @param p New phase.
+     * @param now Time of this update (µs).
+     */
+    void enterPhase(Phase p, uint64_t now) noexcept;
+
+    /**
+     * @brief Latched trip: coast once, reset the ramp and speed loop, keep telemetry alive.
+     *
+     * @param cur Control frame of this update.
+     * @param now Time of this update (µs).
+     */
+    void holdFaulted(const ControlSnapshot &cur, uint64_t now) noexcept;
+
+    /**
+     * @brief Fill the common telemetry fields (power frame, loop state, stamps) and publish.
+     *
+     * @param t Telemetry with speed / duty already set.
+     * @param cur Control frame of this update.
+     * @param now Time of this update (µs).
+     */
+    void publishTelemetry(TelemetrySnapshot &t, const ControlSnapshot &cur, uint64_t now) noexcept;
+
+    /**
+     * @brief Advance the current / power envelope on a new PowerBus frame.
+     *
+     * @param now Time of this update (µs).
+     * @return float Duty ceiling (%; kMaxPct when no limit applies).
+     */
+    float updateLimit(uint64_t now) noexcept;
+
+    /**
+     * @brief Sample the encoder and advance the speed loop.
+     *
+     * @param setpoint_rpm Ramped speed setpoint (signed rpm, negative in reverse: the encoder's convention).
+     * @param now Sample time (µs).
+     * @return float Measured speed (rpm; 0 without a valid sample).
+     */
+    float updateSpeedLoop(float setpoint_rpm, uint64_t now) noexcept;
+
+    /// @brief Park: stop the pacing timer, block until a new control frame or the beat, then restart it.
+    void park() noexcept;
+
+    /**
+     * @brief Configure and start the pacing GPTimer (interrupt lands on the calling core).
+     *
+     * @return true If the timer is running.
+     */
+    bool startTimer() noexcept;
+
+    /// @brief GPTimer alarm ISR. Arg is `this`; returns true if a yield is needed.
+    static bool onTimerISR(void *self) noexcept;
+
     // ---- Tuning knobs ---- //
     static constexpr float kRampRatePctPerSec = 40.0f; ///< %/s: 0→100% in 2.5s (↑ faster, ↓ smoother).
     static constexpr float kMinPct = 0.0f;             ///< Lower clamp for percent.
     static constexpr float kMaxPct = 100.0f;           ///< Upper clamp for percent.
-    static constexpr Dir kDir = Dir::CW;               ///< Direction parameter.
+    static constexpr Dir kForward = Dir::CW;           ///< Positive throttle.
+    static constexpr Dir kReverse = Dir::CCW;          ///< Negative throttle.
+    static constexpr uint32_t kMaxDtUs = 50000;        ///< Cap dt after a stall so one step can't jump the ramp.
+    static constexpr uint32_t kTimerDivider = 80;      ///< 80 MHz APB / 80 → 1 µs timer resolution.
+
+    // ---- Direction changes ---- //
+    static constexpr uint64_t kHoldUs = cfg::drive::STOP_HOLD_MS * 1000ULL;                          ///< Brake / coast hold after the last drive.
+    static constexpr uint32_t kDeadUs = std::max(cfg::drive::DEADTIME_US, cfg::motor::MIN_PHASE_US); ///< Off gap.
+
+    // ---- Envelope ---- //
+    static constexpr bool kLimitOn = cfg::limit::ENABLED && (cfg::limit::MAX_AMPS > 0.0f || cfg::limit::MAX_WATTS > 0.0f);
+
+    // ---- Freshness budgets ---- //
+    static constexpr uint32_t kControlMaxAgeUs = cfg::fresh::CONTROL_MS * 1000U; ///< ControlBus (0 → none).
+    static constexpr uint32_t kPowerMaxAgeUs = static_cast<uint32_t>(
+        (uint64_t{cfg::fresh::POWER_FRAMES} * cfg::adc::FRAME_SAMPLES * 1000000ULL) / cfg::adc::SAMPLE_HZ); ///< PowerBus.
+
+    // ---- Speed loop ---- //
+    static constexpr float kRpmPerPct = cfg::encoder::MAX_RPM / 100.0f; ///< Setpoint scale.
+    static constexpr uint32_t kSampleUs = cfg::encoder::WINDOW_US;      ///< Speed sample / telemetry period.
+
+    // ---- Adaptive cadence ---- //
+    static constexpr uint32_t kParkBeatMs = cfg::cadence::DRIVE_BEAT_MS; ///< Longest parked block.
+
+    using BridgeDuty = std::array<float, DriveBackend::kChannels>; ///< One duty per bridge.
+    using Ramp = BasicSlewEngine<real_t>;                          ///< Throttle ramp in the control-path number type.
 
     // ---- Internal state ---- //
-    IMotorDriver *motor_{nullptr}; ///< Non-owning motor driver.
-    ControlBus *bus_{nullptr};     ///< Non-owning input bus.
-    TickType_t loop_ticks_{0};     ///< Delay (in ticks) between loop iterations.
-    float current_pct_{0.0f};      ///< Current percent (0..100).
-};
\ No newline at end of file
+    DriveBackend *motor_{nullptr};     ///< Non-owning drive backend.
+    ControlBus *bus_{nullptr};         ///< Non-owning input bus.
+    TelemetryBus *telemetry_{nullptr}; ///< Non-owning telemetry bus.
+    SpeedEncoder *encoder_{nullptr};   ///< Non-owning encoder (nullptr → open loop).
+    FaultBus *fault_{nullptr};         ///< Non-owning fault bus (nullptr → ignored).
+    bool faulted_{false};              ///< Holding off for a latched trip.
+    PowerBus *power_{nullptr};         ///< Non-owning power bus (nullptr → no Vbus / current).
+    uint32_t period_us_{0};            ///< Control period (µs).
+    TickType_t loop_ticks_{0};         ///< Delay (in ticks) between loop iterations (Tick pacing).
+    Pacing pacing_{Pacing::Tick};      ///< Selected pacing.
+    TaskHandle_t task_{nullptr};       ///< Own task handle (timer ISR notification target).
+    LoopTimer timing_;                 ///< Period / jitter statistics.
+    std::atomic<bool> reset_{false};   ///< resetLoopStats() requested.
+    std::atomic<bool> awake_{false};   ///< keepAwake(): never park.
+    std::atomic<bool> limp_{false};    ///< degrade(): duty capped at DEGRADE_PCT.
+    Heartbeat beat_{"PDHandler"};      ///< One beat per loop pass.
+    float current_pct_{0.0f};          ///< Current percent (0..100): ramped command / feed-forward duty.
+    Ramp ramp_{{cfg::drive::RAMP_SCURVE ? Ramp::Profile::SCurve : Ramp::Profile::Linear, real_t{kRampRatePctPerSec},
+                real_t{cfg::drive::RAMP_ACCEL_PCT_S2}}};                               ///< Throttle ramp.
+    Ramp stop_ramp_{{Ramp::Profile::Linear, real_t{cfg::drive::REVERSE_DECEL_PCT_S}}}; ///< Ramp-down ahead of a reversal.
+    BridgeDuty bridge_pct_{};                                                          ///< Duty per bridge, sent as one batch.
+    Dir dir_{kForward};                                                                ///< Direction the bridge drives in.
+    Phase phase_{Phase::Drive};                                                        ///< Direction-change sequence phase.
+    uint64_t phase_us_{0};                                                             ///< Time phase_ was entered.
+    uint64_t last_drive_us_{0};                                                        ///< Last step with a non-zero duty (hold reference).
+    float trim_pct_{0.0f};                                                             ///< Speed-loop correction added to current_pct_.
+    float measured_rpm_{0.0f};                                                         ///< Last valid encoder speed (rpm).
+    uint64_t last_sample_us_{0};                                                       ///< Time of the previous speed sample.
+    uint64_t last_origin_us_{0};                                                       ///< Origin of the last control frame applied (latency trace).
+    float limit_pct_{kMaxPct};                                                         ///< Envelope duty ceiling (%).
+    bool limited_{false};                                                              ///< Ceiling held the duty down on the last step.
+    uint64_t last_power_us_{0};                                                        ///< Stamp of the last PowerBus frame used by the limiter.
+    snapshot::Freshness control_age_{"control", kControlMaxAgeUs};                     ///< ControlBus age at each step.
+    snapshot::Freshness power_age_{"power", kPowerMaxAgeUs};                           ///< PowerBus age at each envelope step.
+    Cadence cadence_{0, cfg::cadence::DRIVE_PARK_MS, cfg::cadence::DRIVE_PARK_MS};     ///< Standstill → Park (no boost / idle tier).
+    ControlBus::seq_t ctl_seq_{};                                                      ///< Sequence of the control frame last stepped.
+    pm::Lock lock_{"drive"};                                                           ///< Held while not parked.
+    bool woke_{false};                                                                 ///< The last park ended on a control frame.
+    FixedPid pid_{{to_q16(cfg::encoder::KP), to_q16(cfg::encoder::KI), to_q16(cfg::encoder::KD)},
+                  to_q16(-cfg::encoder::TRIM_PCT), to_q16(cfg::encoder::TRIM_PCT)}; ///< Speed PI(D), % duty trim.
+};
@@ -0,0 +1,192 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of power management (esp_pm configuration, locks, GPIO wake sources, wake latency).
+ *
+ * @file PowerManager.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "PowerManager.h"
+#include <InputBus.h>
+#include <driver/gpio.h>
+#include <esp_idf_version.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+
+namespace
+{
+#if ESP_IDF_VERSION_MAJOR >= 5
+    using PmConfig = esp_pm_config_t;
+#else
+    using PmConfig = esp_pm_config_esp32s3_t;
+#endif
+
+    /// @brief Peripherals that keep running on their own clock between task wakeups: no light sleep with any of them.
+    constexpr bool kClocked = cfg::espnow::ENABLED || cfg::bridge::ROLE != cfg::bridge::Role::Off ||
+                              cfg::telemetry::ENABLED || cfg::ota::ENABLED || cfg::matrix::ENABLED;
+
+    /// @brief The receiver line wakes the chip (a UART receiver on a pin).
+    constexpr bool kRcWake = cfg::power::RC_WAKE && cfg::rc::PROTOCOL != cfg::rc::Protocol::EspNow && cfg::rc::UART_RX >= 0;
+
+    /// @brief Start-bit level on the receiver pin (SBUS is inverted: idles low).
+    constexpr gpio_int_type_t kRcWakeLevel =
+        (cfg::rc::PROTOCOL == cfg::rc::Protocol::Sbus) ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL;
+
+    static_assert(cfg::power::MIN_MHZ >= 80, "Below 80 MHz APB follows the CPU clock: UART baud and the drive GPTimer would drift.");
+    static_assert(cfg::power::MIN_MHZ <= cfg::power::MAX_MHZ, "MIN_MHZ must not exceed MAX_MHZ.");
+
+    std::atomic<bool> s_active{false};  ///< esp_pm configured.
+    std::atomic<bool> s_sleep{false};   ///< Automatic light sleep on.
+    std::atomic<uint32_t> s_held{0};    ///< Locks held (all owners).
+    std::atomic<bool> s_quiet{false};   ///< No lock held at some point since the last woke() (the system could sleep).
+    std::atomic<uint32_t> s_wakes{0};   ///< Stats::wakes.
+    std::atomic<uint32_t> s_last_us{0}; ///< Stats::last_us.
+    std::atomic<uint32_t> s_max_us{0};  ///< Stats::max_us.
+    std::atomic<uint32_t> s_over{0};    ///< Stats::over.
+} // namespace
+
+namespace pm
+{
+    static constexpr logx::Module kLogModule = logx::Module::Power; ///< Filter for this module's log* sites.
+}
+
+// Hold the lock.
+void pm::Lock::acquire() noexcept
+{
+    if (held_.load(std::memory_order_relaxed) || !s_active.load(std::memory_order_relaxed))
+        return;
+
+    if (handle_ == nullptr)
+    {
+        esp_pm_lock_handle_t h = nullptr;
+        const esp_pm_lock_type_t type = (hold_ == Hold::CpuMax) ? ESP_PM_CPU_FREQ_MAX : ESP_PM_NO_LIGHT_SLEEP;
+        if (esp_pm_lock_create(type, 0, name_, &h) != ESP_OK)
+            return; ///< Out of memory: run without (no worse than no power management).
+        handle_ = h;
+    }
+
+    esp_pm_lock_acquire(handle_);
+    held_.store(true, std::memory_order_relaxed);
+    s_held.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Drop the lock.
+void pm::Lock::release() noexcept
+{
+    if (!held_.load(std::memory_order_relaxed))
+        return;
+
+    esp_pm_lock_release(handle_);
+    held_.store(false, std::memory_order_relaxed);
+    if (s_held.fetch_sub(1, std::memory_order_relaxed) == 1)
+        s_quiet.store(true, std::memory_order_relaxed); ///< Last one out: the idle task may sleep from here.
+}
+
+// Configure DFS / light sleep and the wake sources.
+bool pm::begin() noexcept
+{
+    if constexpr (!cfg::power::ENABLED)
+        return false;
+
+    PmConfig c{};
+    c.max_freq_mhz = static_cast<int>(cfg::power::MAX_MHZ);
+    c.min_freq_mhz = static_cast<int>(cfg::power::MIN_MHZ);
+    c.light_sleep_enable = cfg::power::LIGHT_SLEEP && !kClocked;
+    if (cfg::power::LIGHT_SLEEP && kClocked)
+        logInfo("Power: light sleep off (ESP-NOW / bridge / telemetry / OTA / matrix need their clocks), DFS only.");
+
+    esp_err_t err = esp_pm_configure(&c);
+    if (err != ESP_OK && c.light_sleep_enable)
+    {
+        logWarn("Power: light sleep unavailable (CONFIG_FREERTOS_USE_TICKLESS_IDLE off?), DFS only.");
+        c.light_sleep_enable = false;
+        err = esp_pm_configure(&c);
+    }
+    if (err != ESP_OK)
+    {
+        logError("Power: esp_pm_configure failed (%d), running at full clock.", static_cast<int>(err));
+        return false;
+    }
+
+    if (c.light_sleep_enable)
+    {
+        if constexpr (kRcWake)
+            gpio_wakeup_enable(static_cast<gpio_num_t>(cfg::rc::UART_RX), kRcWakeLevel); ///< Start bit (no CPU interrupt on this pin).
+        esp_sleep_enable_gpio_wakeup(); ///< Button pins are armed by StateManager (armButtons()).
+    }
+
+    s_active.store(true, std::memory_order_relaxed);
+    s_sleep.store(c.light_sleep_enable, std::memory_order_relaxed);
+    logInfo("Power: DFS %u-%u MHz, light sleep %s.", static_cast<unsigned>(cfg::power::MIN_MHZ),
+            static_cast<unsigned>(cfg::power::MAX_MHZ), c.light_sleep_enable ? "on" : "off");
+    return true;
+}
+
+// True if esp_pm is configured.
+bool pm::active() noexcept { return s_active.load(std::memory_order_relaxed); }
+
+// True if automatic light sleep is on.
+bool pm::lightSleep() noexcept { return s_sleep.load(std::memory_order_relaxed); }
+
+// Arm every button pin at the level opposite its current one.
+void pm::armButtons() noexcept
+{
+    if (!lightSleep())
+        return;
+
+    for (std::size_t i = 0; i < NUM_BUTTONS; ++i)
+    {
+        const auto pin = static_cast<gpio_num_t>(kButtonPins[i]);
+        const gpio_int_type_t level = gpio_get_level(pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL;
+        gpio_wakeup_enable(pin, level); ///< Sets the pin's interrupt type too: a level that is already there fires at once.
+        gpio_intr_enable(pin);
+    }
+}
+
+// Mask the button pin interrupts until the next armButtons().
+void IRAM_ATTR pm::maskButtonsISR() noexcept
+{
+    for (std::size_t i = 0; i < NUM_BUTTONS; ++i)
+        gpio_intr_disable(static_cast<gpio_num_t>(kButtonPins[i])); ///< Flash-resident: fine unless CONFIG_ARDUINO_ISR_IRAM.
+}
+
+// A control frame woke the parked drive loop and was just applied.
+void pm::woke(uint64_t origin_us, uint64_t now) noexcept
+{
+    if (!s_quiet.exchange(false, std::memory_order_relaxed))
+        return; ///< A lock was held throughout: the chip never slept, nothing to measure.
+
+    const uint32_t us = (now > origin_us) ? static_cast<uint32_t>(now - origin_us) : 0U;
+    s_last_us.store(us, std::memory_order_relaxed);
+    if (us > s_max_us.load(std::memory_order_relaxed))
+        s_max_us.store(us, std::memory_order_relaxed); ///< Single writer (PowerDriveHandler).
+    if (us > cfg::power::WAKE_BUDGET_US)
+        s_over.fetch_add(1, std::memory_order_relaxed);
+    s_wakes.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Wake latency statistics.
+pm::Stats pm::stats() noexcept
+{
+    Stats s{};
+    s.wakes = s_wakes.load(std::memory_order_relaxed);
+    s.last_us = s_last_us.load(std::memory_order_relaxed);
+    s.max_us = s_max_us.load(std::memory_order_relaxed);
+    s.over = s_over.load(std::memory_order_relaxed);
+    return s;
+}
+
+// Clear the wake latency statistics.
+void pm::resetStats() noexcept
+{
+    s_wakes.store(0, std::memory_order_relaxed);
+    s_last_us.store(0, std::memory_order_relaxed);
+    s_max_us.store(0, std::memory_order_relaxed);
+    s_over.store(0, std::memory_order_relaxed);
+}
+
+// Locks currently held.
+uint32_t pm::held() noexcept { return s_held.load(std::memory_order_relaxed); }
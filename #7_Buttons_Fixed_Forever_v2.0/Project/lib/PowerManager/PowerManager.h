@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ *
+ * @brief Power management: DFS and automatic light sleep, held off by locks only while deadline tasks run.
+ *
+ * @file PowerManager.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <atomic>
+#include <cstdint>
+
+struct esp_pm_lock; ///< IDF lock object (esp_pm_lock_handle_t points to one).
+
+/**
+ * @brief Power management for the whole firmware.
+ *
+ * begin() configures esp_pm: the CPU clock scales between
+ * cfg::power::MIN_MHZ and MAX_MHZ, and with LIGHT_SLEEP the idle task puts
+ * the chip into light sleep whenever no lock is held and nothing is due for a
+ * few ticks. Locks come from the tasks with deadlines, never from a timer:
+ *  - PowerDriveHandler holds "drive" from its first step until it parks at
+ *    standstill, and takes it back on the frame that wakes it.
+ *  - RcPublisher holds "rc" while a transmitter is live (until its Cadence
+ *    parks, cfg::cadence::PARK_AFTER_MS after the link dropped).
+ *  - LightsService holds "lights" while any LEDC output is on (LEDC stops in
+ *    light sleep: indicators would freeze mid-flash).
+ * Anything that runs on its own clock (ESP-NOW, the board bridge, the
+ * telemetry / OTA UART, the key-matrix scan timer) keeps light sleep off at
+ * compile time; DFS still runs.
+ *
+ * Wake sources are level-triggered GPIO wakes: every BUTTON_LIST pin, armed at
+ * the level opposite its current one by StateManager after each scan (see
+ * armButtons()), and cfg::rc::UART_RX at its start-bit level. The S3 only
+ * wakes on UART0 / UART1 RX, and the receiver is on UART2, so the start bit
+ * wakes the chip and that first frame is lost; the next one (one receiver
+ * frame period later) is parsed normally.
+ *
+ * Wake latency: PowerDriveHandler reports every frame that woke it from park
+ * (woke()). If the system had been free to sleep since the park, the time
+ * from the frame's origin_us (the button edge ISR or the RC frame stamp) to
+ * the first step that applies it is recorded in stats() and checked against
+ * cfg::power::WAKE_BUDGET_US. The light-sleep exit itself (a few hundred µs)
+ * comes before the origin stamp and is not in the figure.
+ *
+ * MIN_MHZ ≥ 80 keeps APB at 80 MHz while awake: UART baud dividers, the
+ * GPTimer pacing the drive loop and the LEDC / MCPWM clocks never see a
+ * frequency switch. Without CONFIG_PM_ENABLE (or tickless idle for light
+ * sleep) begin() logs what it could not enable and every lock is a no-op.
+ *
+ * @note A USB-Serial-JTAG console drops off the host while the chip sleeps;
+ *       set LIGHT_SLEEP false on the bench.
+ */
+namespace pm
+{
+    /// @brief What a held lock keeps the system from doing.
+    enum class Hold : uint8_t
+    {
+        CpuMax = 0, ///< Full clock, no light sleep (deadline tasks).
+        NoSleep     ///< Any clock, no light sleep (outputs that need their peripheral clock).
+    };
+
+    /// @brief Wake-to-first-control-frame statistics.
+    struct Stats
+    {
+        uint32_t wakes{0};   ///< Frames that woke a parked drive loop after the system was free to sleep.
+        uint32_t last_us{0}; ///< Most recent wake → applied latency (µs).
+        uint32_t max_us{0};  ///< Worst latency (µs).
+        uint32_t over{0};    ///< Wakes over cfg::power::WAKE_BUDGET_US.
+    };
+
+    /**
+     * @brief One named esp_pm lock owned by one task.
+     *
+     * acquire() / release() are idempotent and only called by the owner, so
+     * a task can state what it needs every iteration without counting. The
+     * IDF lock is created on the first acquire().
+     */
+    class Lock
+    {
+    public:
+        /**
+         * @brief Construct (no IDF call).
+         *
+         * @param name Lock name (esp_pm_dump_locks(), console).
+         * @param hold What the lock prevents while held.
+         */
+        explicit Lock(const char *name, Hold hold = Hold::CpuMax) noexcept : name_(name), hold_(hold) {}
+
+        /// @brief Hold the lock (no-op if already held or power management is off).
+        void acquire() noexcept;
+
+        /// @brief Drop the lock (no-op if not held).
+        void release() noexcept;
+
+        /// @brief True while held (any task).
+        [[nodiscard]] bool held() const noexcept { return held_.load(std::memory_order_relaxed); }
+
+        /// @brief Lock name.
+        [[nodiscard]] const char *name() const noexcept { return name_; }
+
+    private:
+        const char *name_;              ///< Lock name.
+        Hold hold_;                     ///< Lock type.
+        esp_pm_lock *handle_{nullptr};  ///< IDF lock (created on first acquire).
+        std::atomic<bool> held_{false}; ///< Currently held.
+    };
+
+    /**
+     * @brief Configure DFS / light sleep and the wake sources (call once from setup(), before the tasks start).
+     *
+     * @return true If esp_pm accepted the configuration (false → full clock, locks are no-ops).
+     */
+    bool begin() noexcept;
+
+    /// @brief True if esp_pm is configured (DFS at least).
+    [[nodiscard]] bool active() noexcept;
+
+    /// @brief True if automatic light sleep is on (StateManager arms level wakes on the button pins).
+    [[nodiscard]] bool lightSleep() noexcept;
+
+    /// @brief Arm every BUTTON_LIST pin's wake / interrupt at the level opposite its current one (task context).
+    void armButtons() noexcept;
+
+    /// @brief Mask the button pin interrupts until the next armButtons() (edge ISR: a level stays asserted).
+    void maskButtonsISR() noexcept;
+
+    /**
+     * @brief A control frame woke the parked drive loop and was just applied.
+     *
+     * @param origin_us Frame origin (edge / RC stamp).
+     * @param now Time of the step that applied it (µs).
+     */
+    void woke(uint64_t origin_us, uint64_t now) noexcept;
+
+    /// @brief Wake latency statistics (any task).
+    [[nodiscard]] Stats stats() noexcept;
+
+    /// @brief Clear the wake latency statistics.
+    void resetStats() noexcept;
+
+    /// @brief Locks currently held (all owners).
+    [[nodiscard]] uint32_t held() noexcept;
+} ///< Namespace pm.
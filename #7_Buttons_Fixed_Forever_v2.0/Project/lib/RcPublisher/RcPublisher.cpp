@@ -1,7 +1,7 @@
 /**
  * MIT License
  *
- * @brief Implementation of RC publisher (iBUS → RcLink → SnapshotBus).
+ * @brief Implementation of RC publisher (iBUS / SBUS / CRSF / ESP-NOW → SnapshotBus).
  *
  * @file RcPublisher.cpp
  * @author Little Man Builds (Darren Osborne)
@@ -10,79 +10,171 @@
  */
 
 #include "RcPublisher.h"
-
-// Short alias for SnapshotRTOS helpers.
-namespace srt = snapshot::rtos;
+#include <Calibration/Calibration.h>
+#include <algorithm>
 
 // Constructor.
-RcPublisher::RcPublisher(uint32_t period_ms, float epsilon, uint32_t min_interval_ms) noexcept
-    : period_ms_{period_ms}, eps_{epsilon}, min_interval_ms_{min_interval_ms}
+RcPublisher::RcPublisher(uint32_t period_ms, float epsilon, uint32_t min_interval_ms, Wake wake) noexcept
+    : loop_ticks_{to_ticks_ms(period_ms)},
+      idle_ticks_{to_ticks_ms(cfg::rc::RX_IDLE_MS) > 0 ? to_ticks_ms(cfg::rc::RX_IDLE_MS) : 1},
+      quiet_ticks_{std::max(to_ticks_ms(cfg::cadence::RC_IDLE_MS), std::max(loop_ticks_, idle_ticks_))}, wake_{wake},
+      eps_{epsilon}, min_interval_ms_{min_interval_ms}, timing_{period_ms * 1000U}
 {
 }
 
-// Configure RCLink (axes, switches, etc.).
+// Start the selected receiver.
 void RcPublisher::begin() noexcept
 {
-    rclink_.begin(Serial2, cfg::rc::BAUD, cfg::rc::UART_RX, cfg::rc::UART_TX); ///< Start iBUS UART on Serial2.
+    src_.begin(); ///< Start the receiver (UART on Serial2, or ESP-NOW).
+
+    if constexpr (Source::kUart)
+    {
+        // One RX-timeout callback per frame: wakes the task in UartEvent mode and counts iBUS frames in either mode.
+        Serial2.setRxTimeout(cfg::rc::RX_TIMEOUT_SYM);                   ///< Inter-frame gap → RX timeout event.
+        Serial2.onReceive([this]() { onRx(); }, /*onlyOnTimeout=*/true); ///< One callback per frame, not per FIFO chunk.
+    }
+    else
+    {
+        src_.onFrame([](void *self) { static_cast<RcPublisher *>(self)->onRx(); }, this); ///< One call per accepted packet.
+    }
+}
+
+// Role mapping used by every source.
+const std::array<rc_batch::RoleSpec, static_cast<size_t>(RC::Count)> &RcPublisher::roles() noexcept
+{
+    return calib::active().roles;
+}
+
+// Configure RCLink (axes, switches, etc.).
+void RcPublisher::IbusSource::begin() noexcept
+{
+    link.begin(Serial2, cfg::rc::BAUD, cfg::rc::UART_RX, cfg::rc::UART_TX); ///< Start iBUS UART on Serial2.
 
     RC_CONFIG(RC, cfg);          ///< Build configuration.
     RC_CFG_MAP_DEFAULT(RC, cfg); ///< Map roles in declared order to channels.
 
-    // Axes.
-    cfg.axis(RC::steering).raw(1000, 2000, 1500).deadband_us(8).out(-100.f, 100.f).done();
-    cfg.axis(RC::direction).raw(1000, 2000, 1500).deadband_us(8).out(-100.f, 100.f).done();
-    cfg.axis(RC::speed).raw(1000, 2000, 1000).deadband_us(8).out(0.f, 100.f).done();
-    cfg.axis(RC::indicators).raw(1000, 2000, 1500).deadband_us(8).out(-100.f, 100.f).done();
-    cfg.axis(RC::volume).raw(1000, 2000, 1500).deadband_us(4).out(0.f, 100.f).done();
-    cfg.axis(RC::power).raw(1000, 2000, 1500).deadband_us(4).out(0.f, 100.f).done();
-
-    // Switches.
-    cfg.sw(RC::override).raw_levels({1000, 2000}).values({0.f, 1.f}).done();
-    cfg.sw(RC::lights).raw_levels({1000, 2000}).values({0.f, 1.f}).done();
-    cfg.sw(RC::mode).raw_levels({1000, 1500, 2000}).values({0.f, 1.f, 2.f}).done();
-    cfg.sw(RC::obstacle).raw_levels({1000, 2000}).values({0.f, 1.f}).done();
-
-    // Failsafe policies.
-    cfg.setFailsafePolicy(RC::steering, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::direction, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::speed, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::indicators, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::volume, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::power, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::override, rc::Failsafe::Mode::Value, 1); ///< Override car settings.
-    cfg.setFailsafePolicy(RC::lights, rc::Failsafe::Mode::Value, 0);
-    cfg.setFailsafePolicy(RC::mode, rc::Failsafe::Mode::Value, 0); ///< Default mode.
-    cfg.setFailsafePolicy(RC::obstacle, rc::Failsafe::Mode::Value, 0);
+    // Axes / switches and their failsafe values, straight from the calibration table.
+    const auto &spec = roles();
+    for (size_t i = 0; i < kRoles; ++i)
+    {
+        const RC role = static_cast<RC>(i);
+        const rc_batch::RoleSpec &r = spec[i];
+        if (r.kind == rc_batch::RoleSpec::Kind::Axis)
+            cfg.axis(role).raw(r.raw_min, r.raw_max, r.raw_center).deadband_us(r.deadband).out(r.out_min, r.out_max).done();
+        else if (r.levels >= 3)
+            cfg.sw(role)
+                .raw_levels({r.raw_levels[0], r.raw_levels[1], r.raw_levels[2]})
+                .values({r.values[0], r.values[1], r.values[2]})
+                .done();
+        else
+            cfg.sw(role).raw_levels({r.raw_levels[0], r.raw_levels[1]}).values({r.values[0], r.values[1]}).done();
+        cfg.setFailsafePolicy(role, rc::Failsafe::Mode::Value, static_cast<int>(r.failsafe));
+    }
 
     // Link-level failsafe timing.
-    cfg.setLinkTimeout(50); ///< 50 ms instead of default (200 ms).
-
-    // Receiver failsafe signature (±2, hold 50 ms).
-    RC_SET_FS_SIGNATURE_SELECTED(RC, rclink_, /* tol */ 2, /* hold_ms */ 50,
-                                 {{RC::steering, +100},
-                                  {RC::direction, +100},
-                                  {RC::speed, +100},
-                                  {RC::indicators, -100}});
-
-    rclink_.apply_rxfs_outputs(true); ///< Apply RX failsafe outputs when RX indicates failsafe.
-
-    rclink_.apply_config(cfg); ///< Apply configuration.
-
-    RcPublisher::Reader reader{&rclink_}; ///< Adapter: RcLink → float channels for the publisher.
-
-    srt::Policy pol{};  ///< Publishing policy (change gate + min interval).
-    pol.epsilon = eps_; ///< Only publish if a channel moves > epsilon.
-    pol.min_interval_us = (min_interval_ms_ > 0)
-                              ? static_cast<uint32_t>(min_interval_ms_) * 1000u ///< Conversion: works in microseconds.
-                              : 0u;                                             ///< Or always publish if set to 0.
-
-    srt::start_publisher<static_cast<size_t>(RC::Count), RcSnapshot>(
-        buses::rc(), ///< The bus that snapshots flow into.
-        reader,      ///< RcLink-backed reader.
-        pol,         ///< Publish policy.
-        "RcPub",     ///< Task name (shows up in FreeRTOS debug).
-        4096,        ///< Stack size (words → ~16 KB).
-        2,           ///< Task priority.
-        period_ms_   ///< Polling period in milliseconds.
-    );
-}
\ No newline at end of file
+    const calib::RcLinkCal &lc = calib::active().link;
+    cfg.setLinkTimeout(lc.link_timeout_ms); ///< cfg::rc::LINK_TIMEOUT_MS unless recalibrated.
+
+    // Receiver failsafe signature (roles fixed here; tolerance, hold time and values from the calibration).
+    RC_SET_FS_SIGNATURE_SELECTED(RC, link, lc.sig_tol, lc.sig_hold_ms,
+                                 {{RC::steering, lc.sig[0]},
+                                  {RC::direction, lc.sig[1]},
+                                  {RC::speed, lc.sig[2]},
+                                  {RC::indicators, lc.sig[3]}});
+
+    link.apply_rxfs_outputs(true); ///< Apply RX failsafe outputs when RX indicates failsafe.
+
+    link.apply_config(cfg); ///< Apply configuration.
+}
+
+// Main run loop.
+void RcPublisher::run() noexcept
+{
+    configASSERT(loop_ticks_ > 0); ///< Timing must be configured.
+
+    RcBus &bus = buses::rc(); ///< The bus that snapshots flow into.
+
+    task_.store(xTaskGetCurrentTaskHandle(), std::memory_order_release); ///< RX callback target.
+
+    TickType_t last_wake = xTaskGetTickCount(); ///< Reference tick for periodic task scheduling.
+
+    for (;;)
+    {
+        const uint64_t now = now_us();
+        if (wake_ == Wake::Poll)
+            timing_.tick(now); ///< Period / overrun statistics.
+        reader_.update();      ///< Pull latest data from UART.
+
+        const bool failsafe = !reader_.ok(); ///< Link health.
+        if (!failsafe)
+            cadence_.touch(now); ///< A live transmitter is the input: full rate.
+        meter_.frames(src_.frames(), now);
+        meter_.link(failsafe);
+        if ((now - stats_us_) >= static_cast<uint64_t>(cfg::rc::STATS_MS) * 1000ULL)
+        {
+            meter_.crcErrors(src_.crcErrors(), Source::kHasCrc);
+            buses::rcLink().publish(meter_.sample(now));
+            stats_us_ = now;
+        }
+
+        if (shouldPublish(failsafe, now))
+        {
+            RcSnapshot &s = bus.begin_write();        ///< Back buffer: decode in place (no stack frame).
+            reader_.read(s.out.data(), s.out.size()); ///< Whole frame, one pass.
+            s.failsafe = failsafe;
+            s.stamp_us = now; ///< Timestamp (µs).
+            bus.commit();     ///< Wakes subscribers.
+
+            has_pub_ = true;
+            pub_failsafe_ = failsafe;
+            pub_us_ = now;
+        }
+
+        const cadence::Tier tier = cadence_.tier(now);
+        if (tier == cadence::Tier::Park)
+            lock_.release(); ///< No transmitter: the chip may sleep until a start bit.
+        else
+            lock_.acquire();
+
+        if (wake_ == Wake::Poll)
+        {
+            const bool quiet = tier == cadence::Tier::Idle || tier == cadence::Tier::Park;
+            if (quiet)
+                timing_.pause(); ///< Slow on purpose: not an overrun.
+            const TickType_t ticks = quiet ? quiet_ticks_ : loop_ticks_;
+            beat_.beat(now, Heartbeat::ticksUs(ticks));
+            vTaskDelayUntil(&last_wake, ticks); ///< Pace loop.
+        }
+        else
+        {
+            const TickType_t ticks = (tier == cadence::Tier::Park) ? quiet_ticks_ : idle_ticks_;
+            beat_.beat(now, Heartbeat::ticksUs(ticks));
+            ulTaskNotifyTake(pdTRUE, ticks); ///< Next frame end, or the idle fallback.
+        }
+    }
+}
+
+// UART RX callback: a frame just ended.
+void RcPublisher::onRx() noexcept
+{
+    src_.onBurst(); ///< Frame counter (iBUS).
+    if (wake_ != Wake::UartEvent)
+        return;
+
+    TaskHandle_t t = task_.load(std::memory_order_acquire);
+    if (t != nullptr)
+        xTaskNotifyGive(t); ///< Runs in the UART event / Wi-Fi task, not an ISR.
+}
+
+// Change gate.
+bool RcPublisher::shouldPublish(bool failsafe, uint64_t now) const noexcept
+{
+    if (!has_pub_ || failsafe != pub_failsafe_)
+        return true; ///< First frame / link state change.
+
+    if (min_interval_ms_ > 0 && (now - pub_us_) >= static_cast<uint64_t>(min_interval_ms_) * 1000ULL)
+        return true; ///< Heartbeat due.
+
+    // RcLink values are integers, so |delta| > eps_ ⇔ |delta| > floor(eps_).
+    return reader_.moved(static_cast<int32_t>(eps_)); ///< Channel moved beyond the gate.
+}
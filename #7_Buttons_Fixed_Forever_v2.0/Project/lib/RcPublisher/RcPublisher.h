@@ -1,7 +1,7 @@
 /**
  * MIT License
  *
- * @brief RC publisher: iBUS → RCLink → SnapshotBus (RCBus).
+ * @brief RC publisher: iBUS (RCLink) / SBUS / CRSF / ESP-NOW → SnapshotBus (RCBus).
  *
  * @file RcPublisher.h
  * @author Little Man Builds (Darren Osborne)
@@ -12,77 +12,284 @@
 #pragma once
 
 #include <app_config.h>
+#include <atomic>
+#include <RtosTask.h>
 #include <cstdint>
 #include <cstddef>
+#include <type_traits>
 #include <RCLink.h>
+#include <SbusTransport/SbusTransport.h>
+#include <CrsfTransport/CrsfTransport.h>
+#include <EspNowLink/EspNowLink.h>
 #include <SnapshotBus.h>
-#include <SnapshotRTOS.h>
 #include <RcBus.h>
+#include <RcLinkBus.h>
+#include <RcBatch.h>
+#include <LoopStats.h>
+#include <Cadence.h>
+#include <Heartbeat.h>
+#include <PowerManager/PowerManager.h>
 
 /**
  * @brief Remote control listener task.
+ *
+ * Polls the receiver and gates each frame on its integer channel values first;
+ * only frames that pass are mapped (one batch pass, rc_batch::map) straight
+ * into the RcBus back buffer and committed, which wakes subscribers
+ * (ControlCore). Unchanged frames cost one compare and nothing else.
+ *
+ * In Wake::UartEvent mode the task sleeps until the UART driver reports the
+ * end of a frame (RX timeout after the burst), so a frame is parsed and
+ * published as soon as its last byte lands rather than up to a poll period
+ * later. It still wakes every cfg::rc::RX_IDLE_MS so RcLink's link timeout
+ * and the heartbeat keep running while the receiver is silent.
+ *
+ * A Cadence follows the link: with no transmitter for
+ * cfg::cadence::IDLE_AFTER_MS, Poll mode slows to cfg::cadence::RC_IDLE_MS
+ * and, once parked, UartEvent mode stretches its silent wake to the same
+ * period (the first frame still wakes it at once). A good frame puts both
+ * back on their normal rate. The task holds the "rc" pm::Lock (full clock,
+ * no light sleep) until it parks; a sleeping chip is woken by the start bit
+ * on cfg::rc::UART_RX (see PowerManager.h).
+ *
+ * The receiver protocol is chosen at compile time (cfg::rc::PROTOCOL). iBUS
+ * goes through RcLink; SBUS and CRSF / ELRS decode straight from the UART
+ * and are mapped to the same integer role values by rc_batch::Mapper using
+ * roles(), so everything from the change gate onward is protocol-agnostic.
+ * ESP-NOW (EspNowTransport) is mapped the same way; it has no UART, so the
+ * UartEvent wake comes from its packet hook instead of the RX timeout.
+ * roles() comes from the calibration blob (calib::begin() must run first),
+ * and the iBUS RcLink config is built from the same table, so recalibrating
+ * is a partition write rather than a firmware rebuild.
+ *
+ * Link statistics (frame rate, integrity failures, inter-frame gaps, time
+ * since the last good frame, failsafe entries) are published on
+ * buses::rcLink() every cfg::rc::STATS_MS.
  */
-class RcPublisher
+class RcPublisher : public rtos::Task<RcPublisher>
 {
 public:
+    /// @brief How the run loop is woken.
+    enum class Wake : std::uint8_t
+    {
+        Poll = 0, ///< Fixed cadence (period_ms).
+        UartEvent ///< UART RX-timeout callback per frame + RX_IDLE_MS fallback.
+    };
+
     /**
      * @brief Construct with change-notification settings.
      *
      * @param period_ms FreeRTOS tick interval used to pace the run loop (in milliseconds).
      * @param epsilon Publish if any |delta| > epsilon (0 → always on change).
      * @param min_interval_ms Publish at least every this many ms (0 → disabled).
+     * @param wake Wake mode (defaults to cfg::rc::RX_EVENT).
      */
-    explicit RcPublisher(uint32_t period_ms = cfg::tick::LOOP_MS, float epsilon = 0,
-                         uint32_t min_interval_ms = 0) noexcept;
+    explicit RcPublisher(uint32_t period_ms = cfg::tick::LOOP_MS, float epsilon = 0, uint32_t min_interval_ms = 0,
+                         Wake wake = cfg::rc::RX_EVENT ? Wake::UartEvent : Wake::Poll) noexcept;
 
     /**
-     * @brief Configure RCLink (axes, switches, etc.).
+     * @brief Configure RCLink (axes, switches, etc.) from calib::active().
      */
     void begin() noexcept;
 
+    /// @brief Measured loop period / overrun statistics (poll mode; empty in event mode).
+    [[nodiscard]] LoopStats loopStats() const noexcept { return timing_.stats(); }
+
+    /// @brief Selected wake mode.
+    [[nodiscard]] Wake wake() const noexcept { return wake_; }
+
+    /// @brief Rate tier (any task).
+    [[nodiscard]] const Cadence &cadence() const noexcept { return cadence_; }
+
+    /// @brief Loop heartbeat (Supervisor).
+    [[nodiscard]] const Heartbeat &heartbeat() const noexcept { return beat_; }
+
+    /// @brief Role mapping for every source (calib::active(): the flash blob, or the compiled defaults).
+    static const std::array<rc_batch::RoleSpec, static_cast<size_t>(RC::Count)> &roles() noexcept;
+
 private:
+    friend class rtos::Task<RcPublisher>; ///< Task entry calls run().
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /// @brief RX callback (UART event task / Wi-Fi task): a frame just ended.
+    void onRx() noexcept;
+
+    /**
+     * @brief Change gate, evaluated on the raw frame before anything is decoded.
+     *
+     * @param failsafe Current link state.
+     * @param now Current time (µs).
+     * @return true If any channel moved more than eps_, failsafe toggled, or the heartbeat is due.
+     */
+    bool shouldPublish(bool failsafe, uint64_t now) const noexcept;
+
+    static constexpr size_t kRoles = static_cast<size_t>(RC::Count); ///< Total channels defined by RC enum.
+
     // ---- Aliases ---- //
     using Transport = rc::RcIbusTransport;
     using Link = rc::RcLink<Transport, RC>;
 
+    // ---- Receiver sources (update / vals / ok) ---- //
+
+    /// @brief iBUS through RcLink (role mapping, failsafe signature and link timeout live in RcLink).
+    struct IbusSource
+    {
+        static constexpr bool kHasCrc = false; ///< iBUS checksum failures stay inside RcLink.
+        static constexpr bool kUart = true;    ///< Frames arrive on Serial2.
+
+        Transport ibus{};                ///< iBUS transport (must outlive Link).
+        Link link{ibus};                 ///< RcLink bound to iBUS.
+        std::atomic<uint32_t> bursts{0}; ///< UART RX-timeout events (one per iBUS frame).
+
+        /// @brief Start the UART and apply the RcLink configuration.
+        void begin() noexcept;
+
+        /// @brief Pull latest data from UART and refresh RcLink's frame/state.
+        void update() { link.update(); }
+
+        /// @brief Mapped role values (no frame copy).
+        const int16_t *vals() const { return link.frame().vals; }
+
+        /// @brief UART callback: one frame-sized burst ended.
+        void onBurst() { bursts.fetch_add(1, std::memory_order_relaxed); }
+
+        /// @brief Packet hook: none (frames end on the UART RX timeout).
+        void onFrame(void (*)(void *), void *) noexcept {}
+
+        /// @brief Frames received since begin() (counted from UART bursts; RcLink exposes no frame counter).
+        uint32_t frames() const { return bursts.load(std::memory_order_relaxed); }
+
+        /// @brief Not measured for iBUS (see kHasCrc).
+        uint32_t crcErrors() const { return 0; }
+
+        /// @brief Health check: true → link is OK (not in failsafe).
+        bool ok() const
+        {
+            const auto &st = link.status();                    ///< Current RX/protocol status.
+            return !(st.rx_failsafe_sig || st.proto_failsafe); ///< If either asserts failsafe → not OK.
+        }
+    };
+
+    /// @brief SBUS / CRSF / ESP-NOW decoded in place and mapped by roles() (vals only recomputed on a new frame or link change).
+    template <typename Proto>
+    struct MappedSource
+    {
+        static constexpr bool kHasCrc = true;                                  ///< CRSF: CRC-8; SBUS: footer check; ESP-NOW: rejected packets.
+        static constexpr bool kUart = !std::is_same_v<Proto, EspNowTransport>; ///< ESP-NOW packets come from the Wi-Fi task.
+
+        Proto proto{};                        ///< Protocol decoder.
+        rc_batch::Mapper<kRoles> mapper{};    ///< Precomputed role tables.
+        std::array<int16_t, kRoles> values{}; ///< Mapped role values.
+        bool lost{true};                      ///< Link state of values.
+
+        /// @brief Start the receiver and build the role tables (roles start at their failsafe values).
+        void begin() noexcept
+        {
+            if constexpr (kUart)
+                proto.begin(Serial2, cfg::rc::UART_RX, cfg::rc::UART_TX);
+            else
+                proto.begin();
+            mapper.build(roles());
+            mapper.map(proto.channels(), 0, true, values.data());
+        }
+
+        /// @brief Decode waiting bytes; remap on a new frame or a link state change.
+        void update()
+        {
+            const uint64_t now = now_us();
+            const bool fresh = proto.update(now);
+            const bool down = proto.failsafe(now);
+            if (fresh || down != lost)
+                mapper.map(proto.channels(), Proto::count(), down, values.data());
+            lost = down;
+        }
+
+        /// @brief Mapped role values.
+        const int16_t *vals() const { return values.data(); }
+
+        /// @brief UART callback: nothing to do (the decoder counts frames itself).
+        void onBurst() {}
+
+        /// @brief Packet hook (ESP-NOW only: UART protocols end frames on the RX timeout).
+        void onFrame(void (*hook)(void *), void *ctx) noexcept
+        {
+            if constexpr (!kUart)
+                proto.onFrame(hook, ctx);
+        }
+
+        /// @brief Good frames decoded since begin().
+        uint32_t frames() const { return proto.frames(); }
+
+        /// @brief Frames rejected on an integrity check.
+        uint32_t crcErrors() const { return proto.crcErrors(); }
+
+        /// @brief Health check: true → link is OK (not in failsafe).
+        bool ok() const { return !lost; }
+    };
+
+    using Source = std::conditional_t<
+        cfg::rc::PROTOCOL == cfg::rc::Protocol::Sbus, MappedSource<SbusTransport>,
+        std::conditional_t<cfg::rc::PROTOCOL == cfg::rc::Protocol::Crsf, MappedSource<CrsfTransport>,
+                           std::conditional_t<cfg::rc::PROTOCOL == cfg::rc::Protocol::EspNow,
+                                              MappedSource<EspNowTransport>, IbusSource>>>;
+
     // ---- Internal state ---- //
-    Transport ibus_{};           ///< iBUS transport (must outlive Link).
-    Link rclink_{ibus_};         ///< RcLink bound to iBUS.
-    TickType_t period_ms_{0};    ///< Delay (in ticks) between loop iterations.
-    float eps_{};                ///< Change gate: publish when any |delta| exceeds this (0.0f = always publish).
-    uint32_t min_interval_ms_{}; ///< Heartbeat interval (milliseconds): publish at least this often (0 = disabled).
+    Source src_{};                            ///< Receiver selected by cfg::rc::PROTOCOL.
+    TickType_t loop_ticks_{0};                ///< Delay (in ticks) between loop iterations.
+    TickType_t idle_ticks_{1};                ///< Event mode: longest block without RX data.
+    TickType_t quiet_ticks_{1};               ///< No transmitter: poll period, or the parked event-mode block.
+    Cadence cadence_{0};                      ///< Rate tier (activity = link up; no boost).
+    pm::Lock lock_{"rc"};                     ///< Held until the cadence parks.
+    Wake wake_{Wake::Poll};                   ///< Selected wake mode.
+    std::atomic<TaskHandle_t> task_{nullptr}; ///< Own task handle (RX callback notification target).
+    float eps_{};                             ///< Change gate: publish when any |delta| exceeds this (0.0f = any change).
+    uint32_t min_interval_ms_{};              ///< Heartbeat interval (milliseconds): publish at least this often (0 = disabled).
+    bool has_pub_{false};                     ///< True once a frame has been published.
+    bool pub_failsafe_{false};                ///< Failsafe state of the last published frame.
+    uint64_t pub_us_{0};                      ///< Stamp of the last published frame (µs).
+    LoopTimer timing_;                        ///< Period / overrun statistics.
+    Heartbeat beat_{"RcPub"};                 ///< One beat per pass.
+    LinkMeter meter_;                         ///< Link statistics (buses::rcLink()).
+    uint64_t stats_us_{0};                    ///< Stamp of the last RcLinkBus publish (µs).
 
-    // ---- Reader that adapts RcLink to SnapshotRTOS ---- //
+    // ---- Reader that adapts the receiver to real_t channels ---- //
     struct Reader
     {
-        Link *link{nullptr}; ///< RcLink instance that already speaks iBUS and maps channels to RC roles.
+        static constexpr size_t kCount = kRoles; ///< Total channels defined by RC enum.
+
+        Source *src{nullptr};              ///< Receiver already mapping channels to RC roles (integer units).
+        rc_batch::Table<kCount> table{};   ///< Q16 scale / offset per role (identity: publish mapped units).
+        std::array<int16_t, kCount> ref{}; ///< Channel values of the last published frame (change gate).
 
         /// @brief Poll the receiver and decode fresh bytes.
         void update()
         {
-            link->update(); ///< Pull latest data from UART and refesh RcLink's frame/state.
+            src->update(); ///< Pull latest data from UART and refresh the mapped frame/state.
         }
 
-        /// @brief Copy channels in the publish buffer.
-        void read(float *dst, size_t n)
+        /// @brief True if any channel moved more than @p eps counts since the last read().
+        bool moved(int32_t eps) const
+        {
+            return rc_batch::moved(src->vals(), ref.data(), kCount, eps);
+        }
+
+        /// @brief Map every channel into the publish buffer in one pass and make it the gate reference.
+        void read(real_t *dst, size_t n)
         {
             if (!dst || n == 0)
                 return; ///< No destination / nothing to write.
 
-            const auto fr = link->frame();                   ///< Current mapped values.
-            const size_t M = static_cast<size_t>(RC::Count); ///< Total channels defined by RC enum.
-            const size_t m = (n < M) ? n : M;                ///< Copy only what fits into dst (destination).
-
-            // RcLink stores channels values as int16_t → publish as float (avoids per channel scaling).
-            for (size_t i = 0; i < m; ++i)
-                dst[i] = static_cast<float>(fr.vals[i]); ///< int16_t → float.
+            const int16_t *vals = src->vals(); ///< Current mapped values (no frame copy).
+            rc_batch::map(vals, dst, n, table);
+            for (size_t i = 0; i < kCount; ++i)
+                ref[i] = vals[i];
         }
 
         /// @brief Health check: true → link is OK (not in failsafe).
-        bool ok() const
-        {
-            const auto &st = link->status();                   ///< Current RX/protocol status.
-            return !(st.rx_failsafe_sig || st.proto_failsafe); ///< If either asserts failsafe → not OK.
-        }
+        bool ok() const { return src->ok(); }
     };
+
+    Reader reader_{&src_}; ///< Adapter: receiver → real_t channels for the run loop.
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of SbusTransport (SBUS frame decoding).
+ *
+ * @file SbusTransport.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "SbusTransport.h"
+#include <cstring>
+#include <RcBatch.h>
+
+// Configure the UART (inverted 8E2).
+bool SbusTransport::begin(HardwareSerial &port, int rx, int tx) noexcept
+{
+    port_ = &port;
+    port.begin(kBaud, SERIAL_8E2, rx, tx, /*invert=*/true); ///< SBUS is inverted UART.
+    ch_.fill(1500);
+    len_ = 0;
+    return true;
+}
+
+// Consume every waiting byte; decode complete frames.
+bool SbusTransport::update(uint64_t now_us) noexcept
+{
+    if (port_ == nullptr)
+        return false;
+
+    bool fresh = false;
+    for (;;)
+    {
+        const int avail = port_->available();
+        if (avail <= 0)
+            break;
+
+        const std::size_t want = kFrameLen - len_;
+        const std::size_t got = static_cast<std::size_t>(avail);
+        const std::size_t n = port_->read(buf_.data() + len_, (got < want) ? got : want);
+        if (n == 0)
+            break;
+        len_ += n;
+
+        // Resync: drop bytes until the buffer starts with a header.
+        if (buf_[0] != kHeader)
+        {
+            const uint8_t *h = static_cast<const uint8_t *>(memchr(buf_.data(), kHeader, len_));
+            const std::size_t skip = (h != nullptr) ? static_cast<std::size_t>(h - buf_.data()) : len_;
+            memmove(buf_.data(), buf_.data() + skip, len_ - skip);
+            len_ -= skip;
+            continue;
+        }
+
+        if (len_ < kFrameLen)
+            continue;
+
+        const uint8_t foot = buf_[kFrameLen - 1];
+        if (foot == kFooter || (foot & 0x0F) == 0x04)
+        {
+            decode(now_us);
+            fresh = true;
+            len_ = 0;
+        }
+        else
+        {
+            ++bad_;
+            memmove(buf_.data(), buf_.data() + 1, kFrameLen - 1); ///< False header: slide by one.
+            len_ = kFrameLen - 1;
+        }
+    }
+    return fresh;
+}
+
+// Unpack a validated frame.
+void SbusTransport::decode(uint64_t now_us) noexcept
+{
+    rc_batch::unpack11_us(buf_.data() + 1, ch_.data()); ///< 22 data bytes; the flags byte follows.
+
+    const uint8_t flags = buf_[23];
+    ch_[16] = (flags & 0x01) ? 2000 : 1000; ///< Digital channel 17.
+    ch_[17] = (flags & 0x02) ? 2000 : 1000; ///< Digital channel 18.
+    if (flags & 0x04)
+        ++lost_;
+    rx_failsafe_ = (flags & 0x08) != 0;
+
+    last_frame_us_ = now_us;
+    ++frames_;
+}
+
+// Failsafe: receiver flag or link timeout.
+bool SbusTransport::failsafe(uint64_t now_us) const noexcept
+{
+    if (frames_ == 0)
+        return true;
+    return rx_failsafe_ || (now_us - last_frame_us_) > static_cast<uint64_t>(cfg::rc::LINK_TIMEOUT_MS) * 1000ULL;
+}
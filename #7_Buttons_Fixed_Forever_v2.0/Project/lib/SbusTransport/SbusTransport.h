@@ -0,0 +1,91 @@
+/**
+ * MIT License
+ *
+ * @brief SBUS receiver transport (100 kbaud 8E2 inverted, 16 + 2 channels).
+ *
+ * @file SbusTransport.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Decodes SBUS frames straight from the UART into a channel array.
+ *
+ * Bytes are read into one 25-byte frame buffer and the 11-bit channels are
+ * unpacked from it in place; there is no intermediate frame copy. Channels
+ * are reported in iBUS-equivalent microseconds (172 → 988, 992 → 1500,
+ * 1811 → 2012) so the same role mapping applies to every protocol.
+ */
+class SbusTransport
+{
+public:
+    static constexpr std::size_t kChannels = 18; ///< 16 proportional + 2 digital.
+    static constexpr uint32_t kBaud = 100000;    ///< SBUS line rate.
+
+    /**
+     * @brief Configure the UART (inverted 8E2).
+     *
+     * @param port UART to read from.
+     * @param rx RX pin.
+     * @param tx TX pin (-1 → unused).
+     * @return true If the port was started.
+     */
+    bool begin(HardwareSerial &port, int rx, int tx) noexcept;
+
+    /**
+     * @brief Consume every waiting byte; decode complete frames.
+     *
+     * @param now_us Current time (µs).
+     * @return true If at least one new frame was decoded.
+     */
+    bool update(uint64_t now_us) noexcept;
+
+    /// @brief Latest channel values (µs-equivalent).
+    [[nodiscard]] const uint16_t *channels() const noexcept { return ch_.data(); }
+
+    /// @brief Number of channels in channels().
+    [[nodiscard]] static constexpr std::size_t count() noexcept { return kChannels; }
+
+    /**
+     * @brief True if the receiver flags failsafe or no frame arrived within the link timeout.
+     *
+     * @param now_us Current time (µs).
+     */
+    [[nodiscard]] bool failsafe(uint64_t now_us) const noexcept;
+
+    /// @brief Frames decoded since begin().
+    [[nodiscard]] uint32_t frames() const noexcept { return frames_; }
+
+    /// @brief Frames the receiver flagged as lost (radio-level drops).
+    [[nodiscard]] uint32_t lostFrames() const noexcept { return lost_; }
+
+    /// @brief Frames rejected on a bad footer (SBUS has no checksum; this is its only integrity check).
+    [[nodiscard]] uint32_t crcErrors() const noexcept { return bad_; }
+
+private:
+    static constexpr std::size_t kFrameLen = 25; ///< Header + 22 data + flags + footer.
+    static constexpr uint8_t kHeader = 0x0F;     ///< Frame start byte.
+    static constexpr uint8_t kFooter = 0x00;     ///< Frame end byte (SBUS2 variants: 0x04/0x14/0x24/0x34).
+
+    /// @brief Unpack buf_ (a validated frame) into ch_.
+    void decode(uint64_t now_us) noexcept;
+
+    // ---- Internal state ---- //
+    HardwareSerial *port_{nullptr};        ///< Non-owning UART.
+    std::array<uint8_t, kFrameLen> buf_{}; ///< Frame being assembled.
+    std::size_t len_{0};                   ///< Bytes in buf_.
+    std::array<uint16_t, kChannels> ch_{}; ///< Decoded channels (µs).
+    bool rx_failsafe_{true};               ///< Receiver failsafe flag from the last frame.
+    uint64_t last_frame_us_{0};            ///< Time of the last good frame.
+    uint32_t frames_{0};                   ///< Good frames.
+    uint32_t lost_{0};                     ///< Frames flagged lost by the receiver.
+    uint32_t bad_{0};                      ///< Frames rejected on a bad footer.
+};
@@ -0,0 +1,110 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of SpeedEncoder (PCNT speed encoder).
+ *
+ * @file SpeedEncoder.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "SpeedEncoder.h"
+
+// Configure the PCNT unit, glitch filter and overflow ISR.
+bool SpeedEncoder::begin() noexcept
+{
+    pcnt_config_t pc{};
+    pc.pulse_gpio_num = pin_a_;
+    pc.ctrl_gpio_num = (pin_b_ >= 0) ? pin_b_ : PCNT_PIN_NOT_USED;
+    pc.channel = PCNT_CHANNEL_0;
+    pc.unit = unit_;
+    pc.pos_mode = PCNT_COUNT_INC;      ///< Count A rising edges...
+    pc.neg_mode = PCNT_COUNT_DIS;      ///< ...not falling (x1 decoding).
+    pc.lctrl_mode = PCNT_MODE_REVERSE; ///< B low → count down.
+    pc.hctrl_mode = PCNT_MODE_KEEP;    ///< B high → count up.
+    pc.counter_h_lim = kLimit;
+    pc.counter_l_lim = -kLimit;
+
+    if (pcnt_unit_config(&pc) != ESP_OK)
+        return false;
+
+    // Glitch filter is in APB cycles (80 per µs), 10-bit.
+    const uint32_t filt = (cfg::encoder::GLITCH_NS * 80U) / 1000U;
+    pcnt_set_filter_value(unit_, static_cast<uint16_t>(filt < 1023U ? filt : 1023U));
+    pcnt_filter_enable(unit_);
+
+    pcnt_event_enable(unit_, PCNT_EVT_H_LIM);
+    pcnt_event_enable(unit_, PCNT_EVT_L_LIM);
+
+    pcnt_counter_pause(unit_);
+    pcnt_counter_clear(unit_);
+
+    // The ISR service is shared by all units; already installed is fine.
+    const esp_err_t svc = pcnt_isr_service_install(0);
+    if (svc != ESP_OK && svc != ESP_ERR_INVALID_STATE)
+        return false;
+    if (pcnt_isr_handler_add(unit_, &SpeedEncoder::onLimitISR, this) != ESP_OK)
+        return false;
+
+    pcnt_counter_resume(unit_);
+
+    last_count_ = 0;
+    last_us_ = 0;
+    ready_ = true;
+    logInfo("SpeedEncoder: PCNT unit %d on A=%d B=%d (%u cpr).", static_cast<int>(unit_), pin_a_, pin_b_,
+            static_cast<unsigned>(cpr_));
+    return true;
+}
+
+// Signed edge count since begin().
+int32_t SpeedEncoder::count() const noexcept
+{
+    for (;;)
+    {
+        const int32_t base = overflow_.load(std::memory_order_acquire);
+        int16_t raw = 0;
+        pcnt_get_counter_value(unit_, &raw);
+        if (overflow_.load(std::memory_order_acquire) == base)
+            return base + raw; ///< No wrap folded in while reading.
+    }
+}
+
+// Speed since the previous read().
+SpeedEncoder::Reading SpeedEncoder::read(uint64_t now_us) noexcept
+{
+    Reading r{};
+    if (!ready_)
+        return r;
+
+    const int32_t c = count();
+    const int32_t delta = c - last_count_;
+    const uint64_t window = now_us - last_us_;
+    const bool first = (last_us_ == 0);
+
+    last_count_ = c;
+    last_us_ = now_us;
+
+    // A wrap that fired between the hardware reset and its ISR shows up as a ±kLimit jump: drop that one sample.
+    if (first || window == 0 || delta > kLimit / 2 || delta < -kLimit / 2)
+        return r;
+
+    // rpm = counts · 60e6 / (cpr · window_us), computed in Q16.16 with a 64-bit intermediate.
+    const int64_t num = static_cast<int64_t>(delta) * (60000000LL << 16); ///< Scale, not shift: delta < 0 in reverse.
+    r.rpm_q16 = static_cast<q16_t>(num / static_cast<int64_t>(static_cast<uint64_t>(cpr_) * window));
+    r.window_us = static_cast<uint32_t>(window);
+    return r;
+}
+
+// PCNT limit-event ISR.
+void SpeedEncoder::onLimitISR(void *self)
+{
+    auto *enc = static_cast<SpeedEncoder *>(self);
+    uint32_t status = 0;
+    pcnt_get_event_status(enc->unit_, &status);
+
+    if (status & PCNT_EVT_H_LIM)
+        enc->overflow_.fetch_add(kLimit, std::memory_order_release);
+    else if (status & PCNT_EVT_L_LIM)
+        enc->overflow_.fetch_sub(kLimit, std::memory_order_release);
+}
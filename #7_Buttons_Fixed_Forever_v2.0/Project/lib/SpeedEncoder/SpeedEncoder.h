@@ -0,0 +1,90 @@
+/**
+ * MIT License
+ *
+ * @brief Quadrature / tach speed encoder on the ESP32 PCNT peripheral.
+ *
+ * @file SpeedEncoder.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <atomic>
+#include <cstdint>
+#include <driver/pcnt.h>
+#include <FixedPid.h>
+
+/**
+ * @brief Counts encoder edges in hardware and converts them to shaft speed.
+ *
+ * Channel A rising edges are counted by a PCNT unit; channel B (optional)
+ * sets the count direction. The 16-bit hardware counter is extended to 32
+ * bits by a limit-event ISR, so read() only has to diff two totals.
+ */
+class SpeedEncoder
+{
+public:
+    /// @brief One speed sample.
+    struct Reading
+    {
+        q16_t rpm_q16{0};      ///< Shaft speed over the window (Q16.16 rpm, signed).
+        uint32_t window_us{0}; ///< Window length (µs); 0 → no valid sample.
+    };
+
+    /**
+     * @brief Construct with pin mapping and resolution.
+     *
+     * @param pin_a Pulse input (counted edges).
+     * @param pin_b Direction input (-1 → single-channel tach, always counts up).
+     * @param counts_per_rev Counted edges per shaft revolution.
+     * @param unit PCNT unit to claim (0..3).
+     */
+    explicit SpeedEncoder(int pin_a = cfg::encoder::PIN_A, int pin_b = cfg::encoder::PIN_B,
+                          uint32_t counts_per_rev = cfg::encoder::COUNTS_PER_REV,
+                          int unit = cfg::encoder::PCNT_UNIT) noexcept
+        : pin_a_(pin_a), pin_b_(pin_b), cpr_(counts_per_rev ? counts_per_rev : 1),
+          unit_(static_cast<pcnt_unit_t>(unit)) {}
+
+    /**
+     * @brief Configure the PCNT unit, glitch filter and overflow ISR.
+     *
+     * @return true If the counter is running.
+     */
+    bool begin() noexcept;
+
+    /**
+     * @brief Signed edge count since begin() (32-bit extended).
+     */
+    [[nodiscard]] int32_t count() const noexcept;
+
+    /**
+     * @brief Speed since the previous read().
+     *
+     * @param now_us Monotonic time (µs).
+     * @return Reading window_us == 0 on the first call or if the sample was rejected.
+     */
+    Reading read(uint64_t now_us) noexcept;
+
+    /// @brief True once begin() succeeded.
+    [[nodiscard]] bool ready() const noexcept { return ready_; }
+
+private:
+    static constexpr logx::Module kLogModule = logx::Module::Drive; ///< Filter for this class's log* sites.
+
+    /// @brief PCNT limit-event ISR: fold a counter wrap into overflow_.
+    static void onLimitISR(void *self);
+
+    static constexpr int16_t kLimit = 30000; ///< Hardware counter wraps to 0 at ±kLimit.
+
+    int pin_a_{-1};                    ///< Pulse GPIO.
+    int pin_b_{-1};                    ///< Direction GPIO (-1 → unused).
+    uint32_t cpr_{1};                  ///< Counted edges per revolution.
+    pcnt_unit_t unit_{PCNT_UNIT_0};    ///< Claimed PCNT unit.
+    std::atomic<int32_t> overflow_{0}; ///< Accumulated wraps (counts).
+    int32_t last_count_{0};            ///< Count at previous read().
+    uint64_t last_us_{0};              ///< Time of previous read() (0 → none).
+    bool ready_{false};                ///< begin() succeeded.
+};
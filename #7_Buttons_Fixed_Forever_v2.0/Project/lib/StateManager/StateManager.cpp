@@ -10,16 +10,22 @@
  */
 
 #include "StateManager.h"
+#include <algorithm>
 
 // Construct with references to the button handler and snapshot bus.
-StateManager::StateManager(IButtonHandler &buttons, InputBus &bus, uint32_t period_ms) noexcept
-    : buttons_(&buttons), bus_(&bus), loop_ticks_(to_ticks_ms(period_ms))
+StateManager::StateManager(IButtonHandler &buttons, InputBus &bus, uint32_t period_ms, ScanMode mode,
+                           ButtonEventQueue *events) noexcept
+    : buttons_(&buttons), bus_(&bus), events_(events), loop_ticks_(to_ticks_ms(period_ms)),
+      boost_ticks_(std::max<TickType_t>(std::min(to_ticks_ms(cfg::cadence::SM_BOOST_MS), loop_ticks_), 1)),
+      idle_ticks_(std::max(to_ticks_ms(cfg::cadence::SM_IDLE_MS), loop_ticks_)), mode_(mode), timing_(period_ms * 1000U)
 {
     // Seed the bus once, so consumers have a valid first snapshot.
     InputState s{};
-    buttons.snapshot(s.buttons); ///< Fill bitset with current debounced levels.
-    s.stamp_ms = millis();       ///< Timestamp (ms).
-    bus.publish(s);              ///< Initial publish.
+    buttons.snapshot(s.buttons);                               ///< Fill bitset with current debounced levels.
+    s.origin_us = now_us();                                    ///< Origin stamp (µs).
+    s.stamp_ms = static_cast<uint32_t>(s.origin_us / 1000ULL); ///< Same clock, in ms.
+    bus.publish(s);                                            ///< Initial publish.
+    last_pub_ = s;                                             ///< Gate reference.
 }
 
 // Main run loop.
@@ -28,17 +34,161 @@ void StateManager::run() noexcept
     configASSERT(buttons_ != nullptr && bus_ != nullptr); ///< Sanity check: buttons_ and bus_ must be valid.
     configASSERT(loop_ticks_ > 0);                        ///< Timing must be configured.
 
+    if (mode_ == ScanMode::Interrupt)
+        runInterrupt();
+    else
+        runPolled();
+}
+
+// Poll mode: update + publish every loop_ticks_ (faster after a change, slower when quiet).
+void StateManager::runPolled() noexcept
+{
     TickType_t last_wake = xTaskGetTickCount(); ///< Reference tick for periodic task scheduling.
 
     for (;;)
     {
-        buttons_->update(); ///< Update state.
+        const uint64_t now = now_us();
+        timing_.tick(now); ///< Period / overrun statistics.
+
+        buttons_->update();    ///< Update state.
+        publishIfChanged(now); ///< Gestures + publish (on change / heartbeat); origin = this pass.
+        if (last_pub_.buttons.any() || gestures_.nextDeadline() != 0)
+            cadence_.touch(now); ///< A held button must see its release (and long press) at full rate.
+
+        const cadence::Tier tier = cadence_.tier(now);
+        const TickType_t ticks = (tier == cadence::Tier::Boost)    ? boost_ticks_
+                                 : (tier == cadence::Tier::Active) ? loop_ticks_
+                                                                   : idle_ticks_; ///< No wake source here: Park polls like Idle.
+        if (ticks != loop_ticks_)
+            timing_.pause(); ///< Off-nominal period on purpose: keep it out of the overrun statistics.
+        beat_.beat(now, Heartbeat::ticksUs(ticks));
+        vTaskDelayUntil(&last_wake, ticks); ///< Pace loop.
+    }
+}
+
+// Interrupt mode: block until an edge, settle through debounce, then block again.
+void StateManager::runInterrupt() noexcept
+{
+    task_ = xTaskGetCurrentTaskHandle(); ///< ISR notification target (set before arming).
+
+    for (std::size_t i = 0; i < NUM_BUTTONS; ++i)
+        attachInterruptArg(kButtonPins[i], &StateManager::onEdgeISR, this, CHANGE); ///< Any edge wakes us.
+    level_wake_ = pm::lightSleep();
+    if (level_wake_)
+        pm::armButtons(); ///< Same handler, level type: also wakes the chip from light sleep.
+
+    const TickType_t idle_wait = (kHeartbeatMs > 0) ? to_ticks_ms(kHeartbeatMs) : portMAX_DELAY; ///< Idle block.
+
+    uint32_t last_edge_ms = 0;   ///< Time of the most recent raw edge.
+    TickType_t wait = idle_wait; ///< Block until the first edge (or heartbeat).
+
+    for (;;)
+    {
+        beat_.beat(now_us(), Heartbeat::ticksUs(wait)); ///< No heartbeat / settle pending → unbounded: not supervised.
+        const uint32_t edges = ulTaskNotifyTake(pdTRUE, wait); ///< Edge count since last wake (0 → settle timeout).
+        const uint32_t now_ms = millis();
+        if (level_wake_)
+            pm::armButtons(); ///< Opposite of the levels now on the pins (the ISR masked them).
 
-        InputState s{};                ///< Build a fresh snapshot.
-        buttons_->snapshot(s.buttons); ///< Copy debounced levels to bitset.
-        s.stamp_ms = millis();         ///< Timestamp (ms).
-        bus_->publish(s);              ///< Publish to the bus.
+        if (edges > 0)
+            last_edge_ms = now_ms; ///< Every bounce restarts the settle window.
 
-        vTaskDelayUntil(&last_wake, loop_ticks_); ///< Pace loop.
+        buttons_->update();                      ///< Feed the debouncer this raw transition (or the settled level).
+        publishIfChanged(burstOrigin(now_us())); ///< Gestures + publish (on change / heartbeat).
+
+        // Sleep until the debouncer can commit, or block until the next edge.
+        const uint32_t since_ms = now_ms - last_edge_ms;
+        if (since_ms < kSettleMs)
+        {
+            wait = to_ticks_ms(kSettleMs - since_ms);
+        }
+        else
+        {
+            wait = idle_wait;
+            edge_lo_.store(0, std::memory_order_relaxed); ///< Burst settled: next edge starts a new origin.
+        }
+
+        // A held button also needs a wake at its long-press threshold.
+        const uint64_t due = gestures_.nextDeadline();
+        if (due != 0)
+        {
+            const uint64_t now = now_us();
+            const TickType_t t = (due > now) ? to_ticks_ms(static_cast<uint32_t>((due - now + 999) / 1000)) : 0;
+            wait = (t < wait) ? ((t > 0) ? t : 1) : wait;
+        }
     }
-}
\ No newline at end of file
+}
+
+// Sample debounced levels, run the gestures; publish on change or when the heartbeat is due.
+bool StateManager::publishIfChanged(uint64_t origin_us) noexcept
+{
+    const uint64_t now = now_us();
+
+    InputState s{};                ///< Build a fresh snapshot.
+    buttons_->snapshot(s.buttons); ///< Copy debounced levels to bitset.
+
+    const bool edge = (s.buttons != last_pub_.buttons);
+    s.origin_us = edge ? origin_us : now;                      ///< Heartbeats (and Long on its own) carry no edge.
+    s.stamp_ms = static_cast<uint32_t>(s.origin_us / 1000ULL); ///< Same clock, in ms.
+
+    // ---- Gestures: once per scan, for every consumer ---- //
+    const auto sink = [this](const ButtonEvent &e) { emit(e); };
+    if (edge)
+        gestures_.edges(last_pub_.buttons, s.buttons, s.origin_us, sink);
+    gestures_.poll(now, sink); ///< Long presses.
+    s.taps = gestures_.taps();
+    s.doubles = gestures_.doubles();
+    s.held = gestures_.held();
+    s.chords = gestures_.chords();
+
+    const bool changed = edge || s.taps != last_pub_.taps || s.doubles != last_pub_.doubles || s.held != last_pub_.held ||
+                         s.chords != last_pub_.chords;
+    const bool beat = (kHeartbeatMs > 0) && (static_cast<uint32_t>(now / 1000ULL) - last_pub_.stamp_ms >= kHeartbeatMs);
+    if (!changed && !beat)
+        return false; ///< Nothing new: skip the copy and the consumer wakeups.
+
+    bus_->publish(s); ///< Publish to the bus.
+    last_pub_ = s;
+    if (changed)
+        cadence_.touch(now); ///< Boost: the next edge of a tap or chord follows within milliseconds.
+
+    if (edge)
+        trace::mark(trace::Stage::InputBus, s.origin_us); ///< Edge → InputBus.
+    return true;
+}
+
+// Queue one classified event.
+void StateManager::emit(const ButtonEvent &e) noexcept
+{
+    if (events_ != nullptr)
+        events_->push(e); ///< Never blocks; a full queue counts the drop.
+}
+
+// Full origin time of the current edge burst.
+uint64_t StateManager::burstOrigin(uint64_t now) const noexcept
+{
+    const uint32_t lo = edge_lo_.load(std::memory_order_relaxed);
+    if (lo == 0)
+        return now; ///< No edge recorded (e.g. update() committed a level on its own).
+
+    return now - static_cast<uint32_t>(static_cast<uint32_t>(now) - lo); ///< Age fits in 32 bits (< 71 min).
+}
+
+// GPIO edge ISR (shared by all button pins).
+void IRAM_ATTR StateManager::onEdgeISR(void *self) noexcept
+{
+    auto *sm = static_cast<StateManager *>(self);
+    if (sm->task_ == nullptr)
+        return; ///< Not armed yet.
+
+    if (sm->level_wake_)
+        pm::maskButtonsISR(); ///< A level stays asserted: quiet until the task re-arms.
+
+    uint32_t none = 0;
+    const uint32_t t = static_cast<uint32_t>(now_us()) | 1U;                  ///< Never 0 (0 → "no edge").
+    sm->edge_lo_.compare_exchange_strong(none, t, std::memory_order_relaxed); ///< Keep only the first edge of a burst.
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(sm->task_, &woken); ///< Count the edge; task drains with ulTaskNotifyTake.
+    portYIELD_FROM_ISR(woken);                 ///< Switch now if StateManager outranks the interrupted task.
+}
@@ -12,40 +12,134 @@
 #pragma once
 
 #include <app_config.h>
+#include <RtosTask.h>
+#include <atomic>
 #include <Universal_Button.h>
 #include <InputBus.h>
+#include <ButtonEvents.h>
+#include <GestureEngine.h>
 #include <RcBus.h>
+#include <LatencyTrace.h>
+#include <LoopStats.h>
+#include <Cadence.h>
+#include <Heartbeat.h>
+#include <PowerManager/PowerManager.h>
 
 /**
  * @brief Manages input scanning and publishes snapshots to an input bus.
+ *
+ * Two wake modes are supported:
+ *  - Poll: update() every period_ms (original behaviour), adapted by a
+ *    Cadence: every cfg::cadence::SM_BOOST_MS just after a change,
+ *    period_ms while a button is down or a gesture is pending, and
+ *    cfg::cadence::SM_IDLE_MS once nothing has moved for IDLE_AFTER_MS.
+ *  - Interrupt: GPIO edge ISRs for every BUTTON_LIST pin notify the task,
+ *    which re-samples once the debounce window has settled and otherwise blocks.
+ *    Light sleep only wakes on GPIO levels, so with pm::lightSleep() the pins
+ *    are armed at the level opposite their current one instead (the ISR masks
+ *    them, each wake re-arms them): every change still fires exactly like an
+ *    edge, asleep or awake.
+ *
+ * In both modes a frame is only published when the debounced bitset or a
+ * gesture bit changes, plus an optional heartbeat (cfg::tick::HEARTBEAT_MS) so consumers can see the
+ * producer is alive.
+ *
+ * Changed frames carry origin_us = time of the first raw edge of the burst
+ * (interrupt mode) or of the sampling pass (poll mode), and record the
+ * edge → InputBus latency in trace::latency().
+ *
+ * Every scan also runs the GestureEngine: its gesture bits (taps, doubles,
+ * held, chords) ride in the published InputState, and every edge and
+ * gesture is pushed to a ButtonEventQueue as press / release / short / long
+ * / double / chord events with the same origin stamp. In interrupt mode the
+ * task additionally wakes at the next long-press threshold of a held button.
  */
-class StateManager
+class StateManager : public rtos::Task<StateManager>
 {
 public:
+    /// @brief How the run loop is woken.
+    enum class ScanMode : std::uint8_t
+    {
+        Poll = 0, ///< Fixed cadence (period_ms).
+        Interrupt ///< GPIO edges + debounce settle timeout.
+    };
+
     /**
      * @brief Construct with references to the button handler and snapshot bus.
      *
      * @param buttons IButtonHandler instance.
      * @param bus Snapshot bus to publish InputState frames to.
      * @param period_ms FreeRTOS tick interval used to pace the run loop (in milliseconds).
+     * @param mode Wake mode (defaults to cfg::button::BTN_IRQ_WAKE).
+     * @param events Queue for discrete button events (nullptr → levels only).
      */
-    StateManager(IButtonHandler &buttons, InputBus &bus, uint32_t period_ms = cfg::tick::LOOP_MS) noexcept;
+    StateManager(IButtonHandler &buttons, InputBus &bus, uint32_t period_ms = cfg::tick::LOOP_MS,
+                 ScanMode mode = cfg::button::BTN_IRQ_WAKE ? ScanMode::Interrupt : ScanMode::Poll,
+                 ButtonEventQueue *events = &buses::buttonEvents()) noexcept;
 
-    /**
-     * @brief FreeRTOS task trampoline. Call with `pvParameters = this`.
-     */
-    static inline void task(void *self) noexcept
-    {
-        static_cast<StateManager *>(self)->run();
-    }
+    /// @brief Measured loop period / overrun statistics (poll mode at period_ms only; empty in interrupt mode).
+    [[nodiscard]] LoopStats loopStats() const noexcept { return timing_.stats(); }
+
+    /// @brief Poll-mode rate tier (any task).
+    [[nodiscard]] const Cadence &cadence() const noexcept { return cadence_; }
+
+    /// @brief Loop heartbeat (Supervisor).
+    [[nodiscard]] const Heartbeat &heartbeat() const noexcept { return beat_; }
 
 private:
+    friend class rtos::Task<StateManager>; ///< Task entry calls run().
+
     /// @brief Main run loop.
     void run() noexcept;
 
+    /// @brief Poll mode: update + publish every loop_ticks_.
+    void runPolled() noexcept;
+
+    /// @brief Interrupt mode: block until an edge, settle through debounce, then block again.
+    void runInterrupt() noexcept;
+
+    /**
+     * @brief Sample debounced levels, run the gestures; publish on change or when the heartbeat is due.
+     *
+     * @param origin_us Origin stamp for a changed frame (heartbeats use the current time).
+     * @return true If a frame was published.
+     */
+    bool publishIfChanged(uint64_t origin_us) noexcept;
+
+    /**
+     * @brief Full origin time of the current edge burst.
+     *
+     * @param now Current time (µs).
+     * @return uint64_t First-edge time, or @p now if no edge is pending.
+     */
+    uint64_t burstOrigin(uint64_t now) const noexcept;
+
+    /// @brief Queue one classified event (drops are counted by the queue; no queue → dropped).
+    void emit(const ButtonEvent &e) noexcept;
+
+    /// @brief GPIO edge ISR (shared by all button pins). Arg is `this`.
+    static void onEdgeISR(void *self) noexcept;
+
 private:
+    // ---- Tuning knobs ---- //
+    static constexpr uint32_t kSettleMs =
+        cfg::button::BTN_DEBOUNCE_MS + cfg::button::BTN_SETTLE_MARGIN_MS; ///< Edge → stable sample delay (ms).
+    static constexpr uint32_t kHeartbeatMs = cfg::tick::HEARTBEAT_MS;     ///< Republish unchanged state this often (0 = never).
+
     // ---- Internal state ---- //
-    IButtonHandler *buttons_{nullptr}; ///< Non-owning; provides update() and snapshot().
-    InputBus *bus_{nullptr};           ///< Non-owning; receives published InputState frames.
-    TickType_t loop_ticks_{0};         ///< Delay (in ticks) between loop iterations.
-};
\ No newline at end of file
+    IButtonHandler *buttons_{nullptr};                             ///< Non-owning; provides update() and snapshot().
+    InputBus *bus_{nullptr};                                       ///< Non-owning; receives published InputState frames.
+    ButtonEventQueue *events_{nullptr};                            ///< Non-owning; receives classified button events (optional).
+    GestureEngine<NUM_BUTTONS, NUM_CHORDS> gestures_{kChordMasks}; ///< Edge → short / long / double / chord.
+    TickType_t loop_ticks_{0};                                     ///< Delay (in ticks) between loop iterations.
+    TickType_t boost_ticks_{0};                                    ///< Poll delay while boosted.
+    TickType_t idle_ticks_{0};                                     ///< Poll delay while idle / parked.
+    Cadence cadence_{};                                            ///< Poll-mode rate tier.
+    ScanMode mode_{ScanMode::Poll};                                ///< Selected wake mode.
+    TaskHandle_t task_{nullptr};                                   ///< Own task handle (ISR notification target).
+    bool level_wake_{false};                                       ///< Pins armed by level (pm::armButtons()), not by edge.
+    std::atomic<uint32_t> edge_lo_{0};                             ///< Low 32 bits of now_us() at the burst's first edge (0 → none).
+    InputState last_pub_{};                                        ///< Last frame published (change gate + heartbeat reference).
+    LoopTimer timing_;                                             ///< Poll-mode period / overrun statistics.
+    Heartbeat beat_{"StateManager"};                               ///< One beat per scan / wake.
+};
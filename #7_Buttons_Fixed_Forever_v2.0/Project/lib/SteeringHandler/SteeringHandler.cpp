@@ -0,0 +1,82 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of SteeringHandler (ControlBus → RMT servo pulse).
+ *
+ * @file SteeringHandler.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "SteeringHandler.h"
+
+namespace
+{
+    /// @brief Servo settings from cfg::steering (reversible: left of centre is Dir::CCW).
+    motor::Config servoConfig(int pin) noexcept
+    {
+        motor::Config c{};
+        c.servo_pin = pin;
+        c.rmt_ch = static_cast<rmt_channel_t>(cfg::steering::RMT_CH);
+        c.neutral_us = cfg::steering::CENTER_US;
+        c.span_us = cfg::steering::SPAN_US;
+        c.reversible = true;
+        return c;
+    }
+} // namespace
+
+// Construct with the control bus (no hardware access).
+SteeringHandler::SteeringHandler(ControlBus &bus, int pin) noexcept : bus_(&bus), pin_(pin), servo_(servoConfig(pin)) {}
+
+// Install the RMT channel and centre the servo.
+bool SteeringHandler::begin() noexcept
+{
+    if (!servo_.begin())
+        return false;
+
+    logInfo("SteeringHandler: pin %d, RMT %u, %u Hz, %u ± %u us.", pin_, static_cast<unsigned>(cfg::steering::RMT_CH),
+            static_cast<unsigned>(cfg::steering::FRAME_HZ), static_cast<unsigned>(cfg::steering::CENTER_US),
+            static_cast<unsigned>(cfg::steering::SPAN_US));
+    return true;
+}
+
+// Main run loop.
+void SteeringHandler::run() noexcept
+{
+    configASSERT(bus_ != nullptr); ///< Sanity check: bus_ must be valid.
+
+    auto sub = bus_->subscribe(); ///< Woken on every ControlBus publish.
+    configASSERT(sub.valid());
+    ControlSnapshot last = bus_->peek();
+    apply(last); ///< Start from the current frame, not a stale centre.
+
+    for (;;)
+    {
+        // ControlCore heartbeats keep this waking even with the stick still. While the frame
+        // carries a steering trend, also wake every STEER_MS to move along it between frames.
+        const TickType_t wait = (last.steer_rate != 0) ? to_ticks_ms(cfg::smooth::STEER_MS) : portMAX_DELAY;
+        if (sub.wait(wait))
+            sub.take(last);
+        apply(last);
+    }
+}
+
+// Move the servo to a control frame's steering command.
+void SteeringHandler::apply(const ControlSnapshot &c) noexcept
+{
+    const float lim = cfg::steering::LIMIT_PCT;
+    float pct = fminf(fmaxf(num::to_float(c.steerAt(now_us())), -lim), lim); ///< Predicted to now (steer_cmd when steer_rate is 0).
+    if (cfg::steering::REVERSED)
+        pct = -pct;
+
+    servo_.drive(fabsf(pct), (pct < 0.0f) ? Dir::CCW : Dir::CW); ///< Rewrites the RMT item only if the width changed.
+    applied_pct_ = pct;
+
+    if (c.origin_us != last_origin_us_)
+    {
+        last_origin_us_ = c.origin_us;
+        if (c.origin_src == ControlSnapshot::Source::Rc)
+            trace::mark(trace::Stage::SteerRc, c.origin_us); ///< First application of this RC frame → servo.
+    }
+}
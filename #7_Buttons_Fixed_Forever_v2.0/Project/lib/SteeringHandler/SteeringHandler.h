@@ -0,0 +1,82 @@
+/**
+ * MIT License
+ *
+ * @brief Steering servo output: ControlSnapshot::steer_cmd → RMT servo pulse, applied on every publish.
+ *
+ * @file SteeringHandler.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <cstdint>
+#include <MotorBackend.h>
+#include <ControlBus.h>
+#include <LatencyTrace.h>
+
+/**
+ * @brief Drives the steering servo from ControlBus.
+ *
+ * Event-driven, unlike PowerDriveHandler's fixed tick: the task sleeps on
+ * its ControlBus subscription and rewrites the pulse as soon as a frame
+ * lands, so stick-to-servo latency is one context switch plus at most one
+ * servo frame (the RMT finishes the pulse in flight, then loops the new one).
+ * While a frame carries a steering trend (steer_rate ≠ 0), the task also
+ * wakes every cfg::smooth::STEER_MS and moves the pulse along
+ * ControlSnapshot::steerAt(), so the servo tracks between RC frames.
+ *
+ * The pulse comes from motor::RmtServoBackend (1 µs RMT ticks, looped in
+ * hardware at cfg::steering::FRAME_HZ), so the CPU is only involved when
+ * the width changes: CENTER_US ± steer_cmd × SPAN_US / 100.
+ */
+class SteeringHandler : public rtos::Task<SteeringHandler>
+{
+public:
+    static_assert(cfg::steering::FRAME_HZ >= 50 && cfg::steering::FRAME_HZ <= 333, "Servo frame rate: 50..333 Hz.");
+
+    /// @brief Servo pulse generator (frame period from cfg::steering::FRAME_HZ).
+    using Servo = motor::RmtServoBackend<1000000UL / cfg::steering::FRAME_HZ>;
+
+    /**
+     * @brief Construct with the control bus (no hardware access).
+     *
+     * @param bus Control bus to follow (non-owning).
+     * @param pin Servo signal pin (-1 → none).
+     */
+    explicit SteeringHandler(ControlBus &bus, int pin = cfg::steering::PIN) noexcept;
+
+    /**
+     * @brief Install the RMT channel and centre the servo.
+     *
+     * @return true If the pulse is running.
+     */
+    bool begin() noexcept;
+
+    /// @brief Current pulse offset from centre (± %, after limit / reversal).
+    [[nodiscard]] float steerPct() const noexcept { return applied_pct_; }
+
+private:
+    friend class rtos::Task<SteeringHandler>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Steering; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /**
+     * @brief Move the servo to a control frame's steering command.
+     *
+     * @param c Control frame.
+     */
+    void apply(const ControlSnapshot &c) noexcept;
+
+    ControlBus *bus_{nullptr};   ///< Non-owning control bus.
+    int pin_{-1};                ///< Servo signal pin.
+    Servo servo_;                ///< RMT pulse generator.
+    float applied_pct_{0.0f};    ///< Last applied offset (%).
+    uint64_t last_origin_us_{0}; ///< Origin of the last frame applied (latency trace).
+};
@@ -0,0 +1,180 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of Supervisor (heartbeat deadlines, stalls and the configured response).
+ *
+ * @file Supervisor.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "Supervisor.h"
+#include <esp_idf_version.h>
+#include <esp_task_wdt.h>
+
+namespace
+{
+    static_assert(cfg::supervisor::PERIOD_MS > 0, "PERIOD_MS must be non-zero.");
+    static_assert(cfg::supervisor::TWDT_S * 1000U > cfg::supervisor::STALL_MS,
+                  "The task watchdog must outlast a stall, or the Supervisor never gets to respond.");
+}
+
+// Start / reconfigure the task watchdog.
+bool Supervisor::begin() noexcept
+{
+    if constexpr (!cfg::supervisor::ENABLED || !cfg::supervisor::TWDT)
+        return false;
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_task_wdt_config_t wdt{};
+    wdt.timeout_ms = cfg::supervisor::TWDT_S * 1000U;
+    wdt.idle_core_mask = 0;
+#ifdef CONFIG_ESP_TASK_WDT_CHECK_IDLE_TASK_CPU0
+    wdt.idle_core_mask |= 1U << 0;
+#endif
+#ifdef CONFIG_ESP_TASK_WDT_CHECK_IDLE_TASK_CPU1
+    wdt.idle_core_mask |= 1U << 1;
+#endif
+    wdt.trigger_panic = true;
+    esp_err_t err = esp_task_wdt_reconfigure(&wdt);
+    if (err == ESP_ERR_INVALID_STATE)
+        err = esp_task_wdt_init(&wdt); ///< Not started by the core (CONFIG_ESP_TASK_WDT_INIT off).
+#else
+    const esp_err_t err = esp_task_wdt_init(cfg::supervisor::TWDT_S, true); ///< Reconfigures when already running.
+#endif
+
+    if (err != ESP_OK)
+    {
+        logWarn("Supervisor: task watchdog refused (%d); heartbeats only.", static_cast<int>(err));
+        return false;
+    }
+    logInfo("Supervisor: task watchdog %u s, panic on timeout.", static_cast<unsigned>(cfg::supervisor::TWDT_S));
+    return true;
+}
+
+// Supervise a task's heartbeat.
+bool Supervisor::watch(const Heartbeat &hb) noexcept
+{
+    if (count_ >= entries_.size())
+        return false;
+
+    Entry &e = entries_[count_++];
+    e.hb = &hb;
+    e.seen_misses = hb.misses();
+    return true;
+}
+
+// Main run loop.
+void Supervisor::run() noexcept
+{
+    configASSERT(bus_ != nullptr); ///< Sanity check: bus_ must be valid.
+
+    TickType_t last_wake = xTaskGetTickCount(); ///< Reference tick for periodic task scheduling.
+    const TickType_t loop_ticks = to_ticks_ms(cfg::supervisor::PERIOD_MS) > 0 ? to_ticks_ms(cfg::supervisor::PERIOD_MS) : 1;
+    HealthSnapshot s{};
+    healthy_since_ = now_us();
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last_wake, loop_ticks); ///< Pace loop.
+
+        const uint64_t now = now_us();
+        const bool incident = scan(now, s);
+        respond(incident, now);
+
+        s.degraded = degraded_;
+        s.incidents = incidents_;
+        s.stamp_us = now;
+        bus_->publish(s);
+    }
+}
+
+// Read every heartbeat.
+bool Supervisor::scan(uint64_t now, HealthSnapshot &out) noexcept
+{
+    const uint32_t now32 = static_cast<uint32_t>(now);
+    const uint32_t stall_us = cfg::supervisor::STALL_MS * 1000U;
+    bool incident = false;
+
+    out.count = static_cast<uint8_t>(count_);
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        Entry &e = entries_[i];
+        TaskHealth &h = out.tasks[i];
+
+        const uint32_t beats = e.hb->beats(); ///< Acquire first: last() / due() are at least this fresh.
+        const uint32_t last = e.hb->last();
+        const uint32_t due = e.hb->due();
+        const uint32_t misses = e.hb->misses();
+
+        const uint32_t age = (beats != 0) ? now32 - last : 0;
+        const bool stalled = beats != 0 && due != 0 && age > due + stall_us; ///< Not yet running / unbounded wait: never stalled.
+
+        if (stalled && !e.stalled)
+        {
+            ++e.stalls;
+            incident = true;
+            logWarn("Supervisor: %s stalled (%lu us since its beat, due within %lu us).", e.hb->name(),
+                    static_cast<unsigned long>(age), static_cast<unsigned long>(due));
+        }
+        else if (!stalled && e.stalled)
+            logInfo("Supervisor: %s beating again.", e.hb->name());
+        e.stalled = stalled;
+
+        const uint32_t new_misses = misses - e.seen_misses;
+        e.seen_misses = misses;
+        if (new_misses >= cfg::supervisor::MISS_LIMIT)
+        {
+            incident = true;
+            logWarn("Supervisor: %s missed %lu deadlines in %lu ms.", e.hb->name(), static_cast<unsigned long>(new_misses),
+                    static_cast<unsigned long>(cfg::supervisor::PERIOD_MS));
+        }
+
+        h.name = e.hb->name();
+        h.beats = beats;
+        h.misses = misses;
+        h.stalls = e.stalls;
+        h.age_us = age;
+        h.due_us = due;
+        h.max_gap_us = e.hb->maxGap();
+        h.stalled = stalled;
+    }
+    return incident;
+}
+
+// Apply cfg::supervisor::RESPONSE.
+void Supervisor::respond(bool incident, uint64_t now) noexcept
+{
+    using cfg::supervisor::Response;
+
+    bool any_stalled = false;
+    for (std::size_t i = 0; i < count_; ++i)
+        any_stalled |= entries_[i].stalled;
+
+    if (incident)
+    {
+        ++incidents_;
+        if (cfg::supervisor::RESPONSE != Response::Log && !degraded_ && degrade_ != nullptr)
+        {
+            degrade_(true);
+            degraded_ = true;
+            logWarn("Supervisor: drive degraded to %.0f%%.", static_cast<double>(cfg::supervisor::DEGRADE_PCT));
+        }
+        if (cfg::supervisor::RESPONSE == Response::Coast && coast_ != nullptr)
+            coast_(); ///< Once per incident; the trip latches on its own.
+    }
+
+    if (incident || any_stalled)
+    {
+        healthy_since_ = now;
+        return;
+    }
+
+    if (degraded_ && (now - healthy_since_) >= static_cast<uint64_t>(cfg::supervisor::RECOVER_MS) * 1000ULL)
+    {
+        degrade_(false);
+        degraded_ = false;
+        logInfo("Supervisor: healthy for %lu ms, drive restored.", static_cast<unsigned long>(cfg::supervisor::RECOVER_MS));
+    }
+}
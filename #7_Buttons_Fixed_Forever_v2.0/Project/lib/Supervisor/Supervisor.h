@@ -0,0 +1,120 @@
+/**
+ * MIT License
+ *
+ * @brief Manager-task supervision: heartbeat deadlines, stalls, task watchdog and the configured response.
+ *
+ * @file Supervisor.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <HealthBus.h>
+#include <Heartbeat.h>
+
+/**
+ * @brief Watches every manager's Heartbeat and answers a stall.
+ *
+ * Each supervised task beats once per iteration with the longest it expects
+ * to block (see Heartbeat). Every cfg::supervisor::PERIOD_MS this task reads
+ * them all and publishes a HealthSnapshot. An incident is a task with no beat
+ * STALL_MS past the one due, or MISS_LIMIT late beats inside one scan; the
+ * response is cfg::supervisor::RESPONSE:
+ *  - Log: one console line per incident.
+ *  - Degrade: also call the degrade hook (PowerDriveHandler caps its duty at
+ *    DEGRADE_PCT); lifted once every task has been healthy for RECOVER_MS.
+ *  - Coast: also call the coast hook once per incident (FaultGuard::force():
+ *    EN low, latched until 'fault clear').
+ *
+ * begin() starts (or reconfigures) the ESP-IDF task watchdog with
+ * cfg::supervisor::TWDT_S; the tasks subscribe themselves from their own
+ * beats. The watchdog is the backstop for a hang the supervisor cannot act on
+ * (interrupts off, the supervisor itself starved): it panics and restarts.
+ *
+ * @note Watch the heartbeats before the task starts; the Heartbeats must
+ *       outlive the supervisor.
+ */
+class Supervisor : public rtos::Task<Supervisor>
+{
+public:
+    using DegradeFn = void (*)(bool on); ///< Cap (true) / restore (false) drive duty.
+    using CoastFn = void (*)();          ///< Force the bridge off.
+
+    /**
+     * @brief Construct with the output bus.
+     *
+     * @param bus Bus to publish task health to.
+     */
+    explicit Supervisor(HealthBus &bus) noexcept : bus_(&bus) {}
+
+    /**
+     * @brief Start / reconfigure the task watchdog (call once from setup(), before the managers run).
+     *
+     * @return true If the watchdog runs with cfg::supervisor::TWDT_S (false → disabled or IDF refused).
+     */
+    bool begin() noexcept;
+
+    /**
+     * @brief Supervise a task's heartbeat (call before the supervisor task starts).
+     *
+     * @param hb Heartbeat owned by the task.
+     * @return true If registered (false → table full).
+     */
+    bool watch(const Heartbeat &hb) noexcept;
+
+    /// @brief Hook for Response::Degrade and Coast.
+    void onDegrade(DegradeFn fn) noexcept { degrade_ = fn; }
+
+    /// @brief Hook for Response::Coast.
+    void onCoast(CoastFn fn) noexcept { coast_ = fn; }
+
+private:
+    friend class rtos::Task<Supervisor>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Supervisor; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /**
+     * @brief Read every heartbeat into @p out.
+     *
+     * @param now Scan time (µs).
+     * @param out Snapshot to fill.
+     * @return true If this scan found an incident.
+     */
+    bool scan(uint64_t now, HealthSnapshot &out) noexcept;
+
+    /**
+     * @brief Apply cfg::supervisor::RESPONSE.
+     *
+     * @param incident This scan found an incident.
+     * @param now Scan time (µs).
+     */
+    void respond(bool incident, uint64_t now) noexcept;
+
+    struct Entry
+    {
+        const Heartbeat *hb{nullptr}; ///< Watched heartbeat.
+        uint32_t seen_misses{0};      ///< Misses at the previous scan.
+        uint32_t stalls{0};           ///< Stalls found.
+        bool stalled{false};          ///< Stalled at the previous scan.
+    };
+
+    // ---- Internal state ---- //
+    HealthBus *bus_{nullptr};                                ///< Output bus.
+    std::array<Entry, HealthSnapshot::kMaxTasks> entries_{}; ///< Watched heartbeats.
+    std::size_t count_{0};                                   ///< Used entries.
+    DegradeFn degrade_{nullptr};                             ///< Degrade hook.
+    CoastFn coast_{nullptr};                                 ///< Coast hook.
+    bool degraded_{false};                                   ///< Degrade hook engaged.
+    uint16_t incidents_{0};                                  ///< Incidents since boot.
+    uint64_t healthy_since_{0};                              ///< Latest incident-free run start (µs).
+};
@@ -0,0 +1,111 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of TaskProfiler (per-task stack / CPU / overrun sampling).
+ *
+ * @file TaskProfiler.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "TaskProfiler.h"
+
+// Watch a task.
+bool TaskProfiler::watch(TaskHandle_t handle, uint32_t stack_words, StatsFn stats, const void *owner) noexcept
+{
+    if (handle == nullptr || count_ >= entries_.size())
+        return false;
+
+    Entry &e = entries_[count_++];
+    e.handle = handle;
+    e.stack_words = stack_words;
+    e.stats = stats;
+    e.owner = owner;
+    return true;
+}
+
+// Main run loop.
+void TaskProfiler::run() noexcept
+{
+    configASSERT(bus_ != nullptr); ///< Sanity check: bus_ must be valid.
+
+    if (self_stack_words_ > 0)
+        watch(xTaskGetCurrentTaskHandle(), self_stack_words_); ///< Own stack, registered from our own context.
+
+    TickType_t last_wake = xTaskGetTickCount(); ///< Reference tick for periodic task scheduling.
+    ProfileSnapshot s{};
+
+    sample(s); ///< Prime the run-time baselines; the first CPU figures cover one full period.
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last_wake, loop_ticks_); ///< Pace loop.
+
+        sample(s);
+        bus_->publish(s);
+    }
+}
+
+// Take one sample of every watched task.
+void TaskProfiler::sample(ProfileSnapshot &out) noexcept
+{
+    out.count = static_cast<uint8_t>(count_);
+    out.stamp_us = now_us();
+    out.heap_free = ESP.getFreeHeap();
+    out.heap_min_free = ESP.getMinFreeHeap();
+
+#if configGENERATE_RUN_TIME_STATS
+    const uint32_t total = portGET_RUN_TIME_COUNTER_VALUE();
+    const uint32_t d_total = total - last_total_; ///< Wraps cleanly (unsigned).
+    last_total_ = total;
+    out.run_time_stats = true;
+
+    TaskStatus_t st{};
+    for (std::size_t c = 0; c < ProfileSnapshot::kCores; ++c)
+    {
+        vTaskGetInfo(xTaskGetIdleTaskHandleForCPU(c), &st, pdFALSE, eReady);
+        const uint32_t d_idle = st.ulRunTimeCounter - last_idle_[c];
+        last_idle_[c] = st.ulRunTimeCounter;
+
+        const uint32_t idle_pm = (d_total > 0) ? static_cast<uint32_t>((uint64_t{d_idle} * 1000U) / d_total) : 1000U;
+        out.core_load_permille[c] = static_cast<uint16_t>((idle_pm < 1000U) ? 1000U - idle_pm : 0U);
+    }
+#endif
+
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        Entry &e = entries_[i];
+        TaskProfile &p = out.tasks[i];
+
+        p.name = pcTaskGetName(e.handle);
+        p.stack_words = e.stack_words;
+        p.stack_free_words = uxTaskGetStackHighWaterMark(e.handle);
+        p.priority = static_cast<uint8_t>(uxTaskPriorityGet(e.handle));
+
+        const BaseType_t core = xTaskGetAffinity(e.handle);
+        p.core = TaskProfile::kAnyCore; ///< tskNO_AFFINITY.
+        if (core >= 0 && core < static_cast<BaseType_t>(ProfileSnapshot::kCores))
+            p.core = static_cast<uint8_t>(core);
+
+#if configGENERATE_RUN_TIME_STATS
+        vTaskGetInfo(e.handle, &st, pdFALSE, eReady);
+        const uint32_t d_run = st.ulRunTimeCounter - e.last_run;
+        e.last_run = st.ulRunTimeCounter;
+
+        const uint32_t pm = (d_total > 0) ? static_cast<uint32_t>((uint64_t{d_run} * 1000U) / d_total) : 0U;
+        p.cpu_permille = static_cast<uint16_t>((pm < 1000U) ? pm : 1000U);
+#endif
+
+        p.has_loop = (e.stats != nullptr);
+        if (p.has_loop)
+            p.loop = e.stats(e.owner);
+
+        if (!e.warned && p.stack_free_words < cfg::profiler::STACK_WARN_WORDS)
+        {
+            e.warned = true; ///< Once per task: the high-water mark never recovers.
+            logWarn("[prof] %s stack low: %u of %u words free", p.name,
+                    static_cast<unsigned>(p.stack_free_words), static_cast<unsigned>(p.stack_words));
+        }
+    }
+}
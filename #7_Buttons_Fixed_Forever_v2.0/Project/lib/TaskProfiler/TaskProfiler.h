@@ -0,0 +1,122 @@
+/**
+ * MIT License
+ *
+ * @brief Periodic RTOS task profiler: stack high-water, CPU share and loop overruns.
+ *
+ * @file TaskProfiler.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <RtosTask.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ProfileBus.h>
+#include <LoopStats.h>
+
+/**
+ * @brief Samples every watched task and publishes a ProfileSnapshot.
+ *
+ * Tasks are registered with watch() during setup(), after they are created.
+ * Every period the profiler reads:
+ *  - uxTaskGetStackHighWaterMark() for each task (free words at the deepest point);
+ *  - per-task and idle-task run-time counters, when the build has
+ *    configGENERATE_RUN_TIME_STATS (otherwise cpu_permille = TaskProfile::kNoCpu);
+ *  - the owner's LoopStats, for managers that keep a LoopTimer.
+ * The task sizes itself into the snapshot too, so its own stack is measured.
+ *
+ * @note LoopStats are read from another task without locking. The fields are
+ *       word-sized counters, so a sample can be one iteration stale but never
+ *       torn; that is fine for sizing decisions.
+ */
+class TaskProfiler : public rtos::Task<TaskProfiler>
+{
+public:
+    /// @brief Loop statistics accessor (@p owner is the pointer given to watch()).
+    using StatsFn = LoopStats (*)(const void *owner);
+
+    /**
+     * @brief Construct with the output bus.
+     *
+     * @param bus Bus to publish samples to.
+     * @param stack_words Stack the profiler task is created with (words; 0 → don't watch itself).
+     * @param period_ms Sample interval (milliseconds).
+     */
+    explicit TaskProfiler(ProfileBus &bus, uint32_t stack_words = 0,
+                          uint32_t period_ms = cfg::profiler::PERIOD_MS) noexcept
+        : bus_(&bus), self_stack_words_(stack_words),
+          loop_ticks_(to_ticks_ms(period_ms) > 0 ? to_ticks_ms(period_ms) : 1) {}
+
+    /**
+     * @brief Watch a task (call before the profiler task starts).
+     *
+     * @param handle Task handle (nullptr is ignored).
+     * @param stack_words Stack size the task was created with (words).
+     * @param stats Optional loop statistics accessor.
+     * @param owner Passed to @p stats.
+     * @return true If registered (false → table full or null handle).
+     */
+    bool watch(TaskHandle_t handle, uint32_t stack_words, StatsFn stats = nullptr,
+               const void *owner = nullptr) noexcept;
+
+    /**
+     * @brief Watch a task whose owner exposes `LoopStats loopStats() const`.
+     *
+     * @tparam Owner Manager type (e.g. PowerDriveHandler).
+     * @param handle Task handle.
+     * @param stack_words Stack size the task was created with (words).
+     * @param owner Manager instance (must outlive the profiler).
+     * @return true If registered.
+     */
+    template <typename Owner>
+    bool watch(TaskHandle_t handle, uint32_t stack_words, const Owner &owner) noexcept
+    {
+        return watch(handle, stack_words, &TaskProfiler::statsOf<Owner>, &owner);
+    }
+
+private:
+    friend class rtos::Task<TaskProfiler>; ///< Task entry calls run().
+
+    static constexpr logx::Module kLogModule = logx::Module::Supervisor; ///< Filter for this class's log* sites.
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    /**
+     * @brief Take one sample of every watched task into @p out.
+     *
+     * @param out Snapshot to fill.
+     */
+    void sample(ProfileSnapshot &out) noexcept;
+
+    /// @brief Type-erased LoopStats accessor used by watch(handle, stack, owner).
+    template <typename Owner>
+    static LoopStats statsOf(const void *owner) noexcept
+    {
+        return static_cast<const Owner *>(owner)->loopStats();
+    }
+
+    struct Entry
+    {
+        TaskHandle_t handle{nullptr}; ///< Watched task.
+        uint32_t stack_words{0};      ///< Created stack size (words).
+        StatsFn stats{nullptr};       ///< Loop statistics accessor (optional).
+        const void *owner{nullptr};   ///< Accessor argument.
+        uint32_t last_run{0};         ///< Run-time counter at the previous sample.
+        bool warned{false};           ///< Low-stack warning already logged.
+    };
+
+    // ---- Internal state ---- //
+    ProfileBus *bus_{nullptr};                                  ///< Output bus.
+    std::array<Entry, ProfileSnapshot::kMaxTasks> entries_{};   ///< Watched tasks.
+    std::size_t count_{0};                                      ///< Used entries.
+    uint32_t self_stack_words_{0};                              ///< Own stack size (0 → not watched).
+    TickType_t loop_ticks_{1};                                  ///< Delay (in ticks) between samples.
+    uint32_t last_total_{0};                                    ///< Run-time clock at the previous sample.
+    std::array<uint32_t, ProfileSnapshot::kCores> last_idle_{}; ///< Idle-task run time per core at the previous sample.
+};
@@ -0,0 +1,183 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of TelemetryStream (COBS + CRC-16 framing, non-blocking UART writer).
+ *
+ * @file TelemetryStream.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "TelemetryStream.h"
+
+// ---- Framing ---- //
+
+// CRC-16/CCITT-FALSE.
+uint16_t telem::crc16(const uint8_t *p, std::size_t n, uint16_t crc) noexcept
+{
+    while (n-- > 0)
+    {
+        crc ^= static_cast<uint16_t>(*p++) << 8;
+        for (int b = 0; b < 8; ++b)
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+// COBS-encode and append the delimiter.
+std::size_t telem::cobsEncode(const uint8_t *src, std::size_t n, uint8_t *dst) noexcept
+{
+    std::size_t code_at = 0; ///< Where the current block's code byte goes.
+    std::size_t w = 1;
+    uint8_t code = 1;
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (src[i] == 0)
+        {
+            dst[code_at] = code; ///< Zero ends a block.
+            code_at = w++;
+            code = 1;
+            continue;
+        }
+
+        dst[w++] = src[i];
+        if (++code == 0xFF)
+        {
+            dst[code_at] = code; ///< Full 254-byte block.
+            code_at = w++;
+            code = 1;
+        }
+    }
+    dst[code_at] = code;
+    dst[w++] = 0x00; ///< Frame delimiter.
+    return w;
+}
+
+// Build one complete frame.
+std::size_t telem::encodeFrame(uint8_t schema, uint8_t seq, const void *payload, std::size_t len, uint8_t *out) noexcept
+{
+    if (len > kMaxPayload)
+        return 0;
+
+    uint8_t body[kMaxBody];
+    body[0] = schema;
+    body[1] = seq;
+    body[2] = static_cast<uint8_t>(len);
+    memcpy(body + 3, payload, len);
+
+    const uint16_t crc = crc16(body, len + 3);
+    body[len + 3] = static_cast<uint8_t>(crc);
+    body[len + 4] = static_cast<uint8_t>(crc >> 8);
+    return cobsEncode(body, len + 5, out);
+}
+
+// COBS-decode one frame.
+std::size_t telem::cobsDecode(const uint8_t *src, std::size_t n, uint8_t *dst) noexcept
+{
+    std::size_t r = 0;
+    std::size_t w = 0;
+    while (r < n)
+    {
+        const uint8_t code = src[r++];
+        if (code == 0 || r + code - 1 > n)
+            return 0; ///< Stray delimiter, or a block running past the end.
+        for (uint8_t i = 1; i < code; ++i)
+            dst[w++] = src[r++]; ///< w never passes r: in place is safe.
+        if (code != 0xFF && r < n)
+            dst[w++] = 0x00; ///< A short block stood for a zero (not after the last one).
+    }
+    return w;
+}
+
+// Decode one frame in place.
+bool telem::decodeFrame(uint8_t *buf, std::size_t n, Frame &out) noexcept
+{
+    const std::size_t m = cobsDecode(buf, n, buf);
+    if (m < 5 || m != static_cast<std::size_t>(buf[2]) + 5)
+        return false;
+    const uint16_t crc = static_cast<uint16_t>(buf[m - 2] | (buf[m - 1] << 8));
+    if (crc16(buf, m - 2) != crc)
+        return false;
+    out.schema = buf[0];
+    out.seq = buf[1];
+    out.len = buf[2];
+    out.payload = buf + 3;
+    return true;
+}
+
+// ---- TelemetryStream ---- //
+
+// Start the UART.
+void TelemetryStream::begin(uint32_t baud, int tx, uint32_t tx_buffer) noexcept
+{
+    port_->setTxBufferSize(tx_buffer); ///< Must precede begin().
+    port_->begin(baud, SERIAL_8N1, /*rx=*/-1, tx);
+}
+
+// Watch a bus.
+bool TelemetryStream::add(Tap &tap) noexcept
+{
+    if (n_taps_ >= kMaxTaps)
+        return false;
+    taps_[n_taps_++] = &tap;
+    return true;
+}
+
+// Frame and send one payload now.
+bool TelemetryStream::send(uint8_t schema, const void *payload, std::size_t len) noexcept
+{
+    const uint8_t seq = seq_.fetch_add(1, std::memory_order_relaxed);
+    if (log_ != nullptr && len <= sizeof(telem::LogRecord::payload))
+    {
+        telem::LogRecord r{};
+        r.schema = schema;
+        r.len = static_cast<uint8_t>(len);
+        r.seq = seq;
+        memcpy(r.payload, payload, len);
+        log_->append(&r); ///< Never blocks; drops are counted by the log.
+    }
+
+    uint8_t frame[telem::kMaxFrame];
+    const std::size_t n = telem::encodeFrame(schema, seq, payload, len, frame);
+    if (n == 0 || static_cast<std::size_t>(port_->availableForWrite()) < n)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false; ///< Never wait on the UART; the decoder sees the seq gap.
+    }
+
+    port_->write(frame, n);
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Main run loop.
+void TelemetryStream::run() noexcept
+{
+    for (std::size_t i = 0; i < n_taps_; ++i)
+        taps_[i]->attach(); ///< Subscriptions belong to this task.
+
+    uint64_t described_us = 0;
+    bool described = false;
+    for (;;)
+    {
+        const uint64_t now = now_us();
+        if (!described || now - described_us >= describe_us_)
+        {
+            for (std::size_t i = 0; i < n_taps_; ++i)
+                taps_[i]->describe(*this); ///< Repeated: a decoder may join mid-stream, and the flash log wraps.
+            described_us = now;
+            described = true;
+        }
+
+        bool any = false;
+        for (std::size_t i = 0; i < n_taps_; ++i)
+            any = any || taps_[i]->fresh();
+        if (!any)
+            ulTaskNotifyTake(pdTRUE, idle_ticks_); ///< Any tapped publish wakes us.
+
+        for (std::size_t i = 0; i < n_taps_; ++i)
+            taps_[i]->poll(*this);
+    }
+}
@@ -0,0 +1,352 @@
+/**
+ * MIT License
+ *
+ * @brief Binary telemetry streaming: any bus payload → COBS + CRC-16 frames on a UART.
+ *
+ * @file TelemetryStream.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <Arduino.h>
+#include <RtosTask.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <TelemetryBus.h>
+#include <RcBus.h>
+#include <RcLinkBus.h>
+#include <ControlBus.h>
+#include <InputBus.h>
+#include <BusSchema.h>
+#include <FlashLog/FlashLog.h>
+
+namespace telem
+{
+    // ---- Wire format ---- //
+    //
+    // frame   = COBS(body) 0x00
+    // body    = schema:u8 seq:u8 len:u8 payload[len] crc:u16le
+    // crc     = CRC-16/CCITT-FALSE over schema..payload
+    // payload = the bus struct as laid out in memory (little-endian, natural alignment);
+    //           tools/telemetry_decode.py holds the matching layouts, keyed by (schema, len).
+    //           PackedTap payloads are wire::Codec layouts instead (schema = wire::Fields<T>::kId),
+    //           announced by descriptor frames (schema wire::kDescribeId, one field each) that
+    //           the decoder builds the layout from.
+
+    static constexpr std::size_t kMaxPayload = 250;                         ///< Largest payload (len is one byte).
+    static constexpr std::size_t kMaxBody = kMaxPayload + 5;                ///< Header + payload + CRC.
+    static constexpr std::size_t kMaxFrame = kMaxBody + kMaxBody / 254 + 2; ///< COBS overhead + delimiter.
+
+    /**
+     * @brief Schema id per payload type (specialise for every streamed struct).
+     *
+     * Ids are part of the wire format: never reuse one for a different layout.
+     */
+    template <typename T>
+    struct Schema;
+
+    template <>
+    struct Schema<TelemetrySnapshot>
+    {
+        static constexpr uint8_t kId = 1; ///< Drive telemetry.
+    };
+
+    template <>
+    struct Schema<RcSnapshot>
+    {
+        static constexpr uint8_t kId = cfg::numeric::FIXED_POINT ? 5 : 2; ///< Mapped RC frame (5: Q16 real_t).
+    };
+
+    template <>
+    struct Schema<ControlSnapshot>
+    {
+        static constexpr uint8_t kId = cfg::numeric::FIXED_POINT ? 6 : 3; ///< Resolved control commands (6: Q16 real_t).
+    };
+
+    template <>
+    struct Schema<RcLinkSnapshot>
+    {
+        static constexpr uint8_t kId = 4; ///< Receiver link statistics.
+    };
+
+    // Packed layouts (wire::Fields, BusSchema.h) take ids 0 and 7 up.
+    static_assert(Schema<RcSnapshot>::kId < wire::Fields<InputState>::kId && Schema<ControlSnapshot>::kId < wire::Fields<InputState>::kId,
+                  "Raw and packed schema ids overlap.");
+
+    // Decoder layouts (tools/telemetry_decode.py SCHEMAS) assume these sizes: update both together.
+    static_assert(sizeof(TelemetrySnapshot) == 40, "TelemetrySnapshot layout changed: update the decoder.");
+    static_assert(sizeof(RcSnapshot) == 56, "RcSnapshot layout changed: update the decoder.");
+    static_assert(sizeof(ControlSnapshot) == 32, "ControlSnapshot layout changed: update the decoder.");
+    static_assert(sizeof(RcLinkSnapshot) == 80, "RcLinkSnapshot layout changed: update the decoder.");
+
+    /**
+     * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+     *
+     * @param p Data.
+     * @param n Length.
+     * @param crc Running value (chain calls by passing the previous result).
+     */
+    uint16_t crc16(const uint8_t *p, std::size_t n, uint16_t crc = 0xFFFF) noexcept;
+
+    /**
+     * @brief COBS-encode @p n bytes and append the 0x00 delimiter.
+     *
+     * @param src Input.
+     * @param n Input length.
+     * @param dst Output (≥ n + n / 254 + 2 bytes).
+     * @return std::size_t Bytes written, delimiter included.
+     */
+    std::size_t cobsEncode(const uint8_t *src, std::size_t n, uint8_t *dst) noexcept;
+
+    /**
+     * @brief Build one complete frame.
+     *
+     * @param schema Schema id.
+     * @param seq Sequence number (wraps; lets the decoder count gaps).
+     * @param payload Payload bytes.
+     * @param len Payload length (≤ kMaxPayload).
+     * @param out Output buffer (≥ kMaxFrame).
+     * @return std::size_t Frame length (0 if @p len is too large).
+     */
+    std::size_t encodeFrame(uint8_t schema, uint8_t seq, const void *payload, std::size_t len, uint8_t *out) noexcept;
+
+    /**
+     * @brief COBS-decode one frame (delimiter already stripped).
+     *
+     * @param src Input.
+     * @param n Input length.
+     * @param dst Output (≥ n bytes; may be @p src: decoding in place is safe).
+     * @return std::size_t Bytes written (0 if @p src is not valid COBS).
+     */
+    std::size_t cobsDecode(const uint8_t *src, std::size_t n, uint8_t *dst) noexcept;
+
+    /// @brief One received frame (payload points into the caller's buffer).
+    struct Frame
+    {
+        uint8_t schema{0};               ///< Schema id.
+        uint8_t seq{0};                  ///< Sender's sequence number.
+        std::size_t len{0};              ///< Payload length.
+        const uint8_t *payload{nullptr}; ///< Payload bytes.
+    };
+
+    /**
+     * @brief Decode one frame in place (the inverse of encodeFrame(), delimiter stripped).
+     *
+     * @param buf Frame bytes; overwritten with the decoded body.
+     * @param n Frame length.
+     * @param out Decoded frame.
+     * @return true If the frame is valid COBS, its length matches and the CRC checks.
+     */
+    bool decodeFrame(uint8_t *buf, std::size_t n, Frame &out) noexcept;
+
+    /// @brief One payload as mirrored into a FlashLog (fixed size; larger payloads are not mirrored).
+    struct LogRecord
+    {
+        uint8_t schema;                              ///< Schema id.
+        uint8_t len;                                 ///< Payload bytes used.
+        uint8_t seq;                                 ///< Frame sequence number (shared with the UART stream).
+        uint8_t reserved;                            ///< Zero.
+        uint8_t payload[flashlog::kRecordBytes - 4]; ///< Payload bytes (0-padded).
+    };
+
+    static_assert(sizeof(LogRecord) == flashlog::kRecordBytes, "LogRecord must fill one FlashLog record.");
+    static_assert(wire::kMaxDescribe <= sizeof(LogRecord::payload), "Descriptor frames must fit a LogRecord (decoding a log needs them).");
+} ///< Namespace telem.
+
+/**
+ * @brief Low-priority task that streams bus payloads as binary frames.
+ *
+ * Each watched bus gets a Tap (subscription + schema id). The task sleeps
+ * until any tapped bus publishes, copies each fresh payload once, frames it
+ * and writes it only if the UART TX buffer has room, so producers never wait
+ * on logging and a slow link drops frames (counted) instead of stretching
+ * anyone's loop. Decode on the host with tools/telemetry_decode.py.
+ *
+ * With mirror() set, every payload that fits a telem::LogRecord is also
+ * appended to a FlashLog, so a run is recorded in full whatever the UART
+ * keeps up with (read back with tools/flashlog_read.py).
+ */
+class TelemetryStream : public rtos::Task<TelemetryStream>
+{
+public:
+    static constexpr std::size_t kMaxTaps = 6; ///< Watched buses.
+
+    /**
+     * @brief One watched bus (type-erased so the stream can hold a mixed list).
+     */
+    class Tap
+    {
+    public:
+        virtual ~Tap() = default;
+
+        /// @brief Subscribe from the streaming task (subscriptions belong to the calling task).
+        virtual void attach() noexcept = 0;
+
+        /// @brief True if the bus published since the last poll().
+        [[nodiscard]] virtual bool fresh() const noexcept = 0;
+
+        /// @brief Copy the latest payload and send it if it's new.
+        virtual void poll(TelemetryStream &out) noexcept = 0;
+
+        /// @brief Send the payload's layout (packed taps; raw layouts live in the decoder).
+        virtual void describe(TelemetryStream &out) noexcept { (void)out; }
+    };
+
+    /**
+     * @brief Tap on a SignalBus / ViewBus.
+     *
+     * @tparam Bus Bus type; Bus::value_type needs a telem::Schema.
+     */
+    template <typename Bus>
+    class BusTap final : public Tap
+    {
+    public:
+        using T = typename Bus::value_type;
+        static_assert(std::is_trivially_copyable_v<T>, "Streamed payloads are sent as raw bytes.");
+        static_assert(sizeof(T) <= telem::kMaxPayload, "Payload too large for one telemetry frame.");
+
+        /// @brief Watch @p bus (non-owning).
+        explicit BusTap(Bus &bus) noexcept : bus_(&bus) {}
+
+        void attach() noexcept override { sub_ = bus_->subscribe(); }
+
+        [[nodiscard]] bool fresh() const noexcept override { return sub_.fresh(); }
+
+        void poll(TelemetryStream &out) noexcept override
+        {
+            T v{};
+            if (sub_.take(v))
+                out.send(telem::Schema<T>::kId, &v, sizeof(v));
+        }
+
+    private:
+        Bus *bus_;                          ///< Non-owning bus.
+        snapshot::Subscription<Bus> sub_{}; ///< Streaming task's subscription.
+    };
+
+    /**
+     * @brief Tap that streams the packed wire::Codec layout instead of the raw struct.
+     *
+     * Payloads shrink to the field table (bits for flags, scaled int16 for
+     * commands and RC roles), and the table itself goes out as descriptor
+     * frames at start and every cfg::telemetry::DESCRIBE_MS, so a BUTTON_LIST
+     * or RC_ROLES edit needs no decoder change.
+     *
+     * @tparam Bus Bus type; Bus::value_type needs a wire::Fields specialisation.
+     */
+    template <typename Bus>
+    class PackedTap final : public Tap
+    {
+    public:
+        using T = typename Bus::value_type;
+        using Codec = wire::Codec<T>;
+        static_assert(Codec::kBytes <= telem::kMaxPayload, "Packed payload too large for one telemetry frame.");
+
+        /// @brief Watch @p bus (non-owning).
+        explicit PackedTap(Bus &bus) noexcept : bus_(&bus) {}
+
+        void attach() noexcept override { sub_ = bus_->subscribe(); }
+
+        [[nodiscard]] bool fresh() const noexcept override { return sub_.fresh(); }
+
+        void poll(TelemetryStream &out) noexcept override
+        {
+            T v{};
+            if (!sub_.take(v))
+                return;
+            uint8_t p[Codec::kBytes];
+            Codec::encode(v, p);
+            out.send(Codec::kId, p, sizeof(p));
+        }
+
+        void describe(TelemetryStream &out) noexcept override
+        {
+            uint8_t p[wire::kMaxDescribe];
+            for (std::size_t i = 0; i <= Codec::kCount; ++i)
+                out.send(wire::kDescribeId, p, wire::describe<T>(i, p)); ///< Fields, then the table name.
+        }
+
+    private:
+        Bus *bus_;                          ///< Non-owning bus.
+        snapshot::Subscription<Bus> sub_{}; ///< Streaming task's subscription.
+    };
+
+    /// @brief Tap for a bus with both layouts: packed or raw per cfg::telemetry::PACKED.
+    template <typename Bus>
+    using StreamTap = std::conditional_t<cfg::telemetry::PACKED, PackedTap<Bus>, BusTap<Bus>>;
+
+    /**
+     * @brief Construct for a UART.
+     *
+     * @param port UART to stream on (begun by begin()).
+     * @param idle_ms Longest sleep without any publish (ms).
+     * @param describe_ms Descriptor repeat interval (ms; packed taps).
+     */
+    explicit TelemetryStream(HardwareSerial &port, uint32_t idle_ms = cfg::telemetry::IDLE_MS,
+                             uint32_t describe_ms = cfg::telemetry::DESCRIBE_MS) noexcept
+        : port_(&port), idle_ticks_(to_ticks_ms(idle_ms) > 0 ? to_ticks_ms(idle_ms) : 1), describe_us_(1000ULL * describe_ms) {}
+
+    /**
+     * @brief Start the UART (TX only).
+     *
+     * @param baud Line rate.
+     * @param tx TX pin.
+     * @param tx_buffer TX ring size (bytes); bounds how far the stream can run ahead of the wire.
+     */
+    void begin(uint32_t baud = cfg::telemetry::BAUD, int tx = cfg::telemetry::TX_PIN,
+               uint32_t tx_buffer = cfg::telemetry::TX_BUFFER) noexcept;
+
+    /**
+     * @brief Watch a bus (call before the task starts; @p tap must outlive the stream).
+     *
+     * @return true If there was a free slot.
+     */
+    bool add(Tap &tap) noexcept;
+
+    /**
+     * @brief Also append payloads to a flash log (call before the task starts).
+     *
+     * @param log Log to mirror into (non-owning).
+     */
+    void mirror(FlashLog &log) noexcept { log_ = &log; }
+
+    /**
+     * @brief Frame and send one payload now (non-blocking; any task).
+     *
+     * @param schema Schema id.
+     * @param payload Bytes.
+     * @param len Length (≤ telem::kMaxPayload).
+     * @return true If the whole frame fit in the TX buffer.
+     */
+    bool send(uint8_t schema, const void *payload, std::size_t len) noexcept;
+
+    /// @brief Frames written.
+    [[nodiscard]] uint32_t frames() const noexcept { return frames_.load(std::memory_order_relaxed); }
+
+    /// @brief Frames dropped for lack of TX room.
+    [[nodiscard]] uint32_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    friend class rtos::Task<TelemetryStream>; ///< Task entry calls run().
+
+    /// @brief Main run loop.
+    void run() noexcept;
+
+    HardwareSerial *port_{nullptr};      ///< Non-owning UART.
+    TickType_t idle_ticks_{1};           ///< Longest block without a publish.
+    uint64_t describe_us_{0};            ///< Descriptor repeat interval.
+    std::array<Tap *, kMaxTaps> taps_{}; ///< Watched buses.
+    std::size_t n_taps_{0};              ///< Used taps.
+    FlashLog *log_{nullptr};             ///< Optional flash mirror.
+    std::atomic<uint8_t> seq_{0};        ///< Next frame sequence number.
+    std::atomic<uint32_t> frames_{0};    ///< Frames written.
+    std::atomic<uint32_t> dropped_{0};   ///< Frames dropped (TX full).
+};
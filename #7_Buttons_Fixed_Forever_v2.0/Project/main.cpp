@@ -14,71 +14,1177 @@
 #include <RcPublisher/RcPublisher.h>
 #include <ControlCore/ControlCore.h>
 #include <PowerDriveHandler/PowerDriveHandler.h>
+#include <SteeringHandler/SteeringHandler.h>
+#include <SpeedEncoder/SpeedEncoder.h>
+#include <AdcService/AdcService.h>
+#include <FaultGuard/FaultGuard.h>
+#include <LightsService/LightsService.h>
+#include <DebugConsole/DebugConsole.h>
+#include <TaskProfiler/TaskProfiler.h>
+#include <PortButtons/PortButtons.h>
+#include <KeyMatrix/KeyMatrix.h>
+#include <TelemetryStream/TelemetryStream.h>
+#include <FlightRecorder/FlightRecorder.h>
+#include <BusReplay/BusReplay.h>
+#include <FlashLog/FlashLog.h>
+#include <Calibration/Calibration.h>
+#include <OtaService/OtaService.h>
+#include <EspNowLink/EspNowLink.h>
+#include <BusBridge/BusBridge.h>
+#include <PowerManager/PowerManager.h>
+#include <AutoTuner/AutoTuner.h>
+#include <Supervisor/Supervisor.h>
+#include <ButtonBench/ButtonBench.h>
+#include <TaskGraph.h>
+#include <StaticPool.h>
+#include <BootTimeline.h>
+#include <LatencyTrace.h>
+#include <StageCost.h>
 
 /**
  * @brief Constants and type definitions.
  * @note On ESP32/FreeRTOS, stack size is in words (4 bytes each), not bytes.
  */
-constexpr int SM_STACK = 2048;  ///< Memory allocated to state manager (~8 KB).
-constexpr int CC_STACK = 4096;  ///< Memory allocated to control core (~16 KB).
-constexpr int PDH_STACK = 4096; ///< Memory allocated to power drive handler (~16 KB).
+constexpr int SM_STACK = 2048;   ///< Memory allocated to state manager (~8 KB).
+constexpr int RC_STACK = 4096;   ///< Memory allocated to RC publisher (~16 KB).
+constexpr int CC_STACK = 4096;   ///< Memory allocated to control core (~16 KB).
+constexpr int PDH_STACK = 4096;  ///< Memory allocated to power drive handler (~16 KB).
+constexpr int STR_STACK = 2048;  ///< Memory allocated to steering handler (~8 KB).
+constexpr int ADC_STACK = 2048;  ///< Memory allocated to ADC service (~8 KB).
+constexpr int FG_STACK = 2048;   ///< Memory allocated to fault guard (~8 KB).
+constexpr int CON_STACK = 3072;  ///< Memory allocated to debug console (~12 KB).
+constexpr int LOG_STACK = 3072;  ///< Memory allocated to deferred log drain (~12 KB).
+constexpr int PROF_STACK = 2048; ///< Memory allocated to task profiler (~8 KB).
+constexpr int TEL_STACK = 3072;  ///< Memory allocated to telemetry stream (~12 KB).
+constexpr int REC_STACK = 3072;  ///< Memory allocated to flight recorder (~12 KB).
+constexpr int FLOG_STACK = 3072; ///< Memory allocated to flash log writer (~12 KB).
+constexpr int LITE_STACK = 2048; ///< Memory allocated to lights service (~8 KB).
+constexpr int OTA_STACK = 3072;  ///< Memory allocated to OTA service (~12 KB).
+constexpr int RPL_STACK = 3072;  ///< Memory allocated to bus replay (~12 KB).
+constexpr int ESPN_STACK = 3072; ///< Memory allocated to ESP-NOW telemetry (~12 KB).
+constexpr int BRG_STACK = 3072;  ///< Memory allocated to bus bridge (~12 KB).
+constexpr int TUNE_STACK = 2048; ///< Memory allocated to auto-tuner (~8 KB).
+constexpr int SUP_STACK = 2048;  ///< Memory allocated to supervisor (~8 KB).
 
-constexpr UBaseType_t SM_PRI = 1;  ///< Task priority 1.
-constexpr UBaseType_t CC_PRI = 2;  ///< Task priority 2.
-constexpr UBaseType_t PDH_PRI = 3; ///< Task priority 3.
+constexpr int ALL_STACKS = SM_STACK + RC_STACK + CC_STACK + PDH_STACK + STR_STACK + ADC_STACK + FG_STACK + CON_STACK + LOG_STACK +
+                         PROF_STACK + TEL_STACK + REC_STACK + FLOG_STACK + LITE_STACK + OTA_STACK + RPL_STACK + ESPN_STACK +
+                         BRG_STACK + TUNE_STACK + SUP_STACK; ///< Every task at once (upper bound for the pool).
+static_assert(!cfg::memory::STATIC_TASKS || static_cast<uint32_t>(ALL_STACKS) <= cfg::memory::STACK_POOL,
+              "Task stacks exceed cfg::memory::STACK_POOL.");
+
+constexpr UBaseType_t LOG_PRI = 1; ///< Task priority 1 (tasks above it drop logs rather than wait).
 
 /**
  * @brief Global RTOS handles and queues.
  */
-TaskHandle_t sm_t = nullptr;  ///< State manager logic task handle.
-TaskHandle_t cc_t = nullptr;  ///< Control core logic task handle.
-TaskHandle_t pdh_t = nullptr; ///< Power drive handler logic task handle.
+TaskHandle_t sm_t = nullptr;   ///< State manager logic task handle.
+TaskHandle_t rc_t = nullptr;   ///< RC publisher task handle.
+TaskHandle_t cc_t = nullptr;   ///< Control core logic task handle.
+TaskHandle_t pdh_t = nullptr;  ///< Power drive handler logic task handle.
+TaskHandle_t str_t = nullptr;  ///< Steering handler task handle.
+TaskHandle_t adc_t = nullptr;  ///< ADC service task handle.
+TaskHandle_t fg_t = nullptr;   ///< Fault guard task handle.
+TaskHandle_t con_t = nullptr;  ///< Debug console task handle.
+TaskHandle_t log_t = nullptr;  ///< Deferred log drain task handle.
+TaskHandle_t prof_t = nullptr; ///< Task profiler handle.
+TaskHandle_t tel_t = nullptr;  ///< Telemetry stream handle.
+TaskHandle_t rec_t = nullptr;  ///< Flight recorder handle.
+TaskHandle_t flog_t = nullptr; ///< Flash log writer handle.
+TaskHandle_t lite_t = nullptr; ///< Lights service handle.
+TaskHandle_t ota_t = nullptr;  ///< OTA service handle.
+TaskHandle_t rpl_t = nullptr;  ///< Bus replay handle.
+TaskHandle_t espn_t = nullptr; ///< ESP-NOW telemetry handle.
+TaskHandle_t brg_t = nullptr;  ///< Bus bridge handle.
+TaskHandle_t tune_t = nullptr; ///< Auto-tuner handle.
+TaskHandle_t sup_t = nullptr;  ///< Supervisor handle.
+
+TelemetryStream telemetry(Serial1); ///< Binary bus stream (cfg::telemetry).
+EspNowTelemetry radio;              ///< Batched telemetry to the pit station (cfg::espnow).
+FlightRecorder *recorder = nullptr; ///< Black box (cfg::recorder; null when disabled or begin() failed).
+FlashLog *rawlog = nullptr;         ///< Telemetry flash mirror (cfg::flashlog; null when disabled or begin() failed).
+FaultGuard *guard = nullptr;        ///< Bridge protection (cfg::fault; null when disabled or nothing to arm).
+PowerDriveHandler *drive = nullptr; ///< Drive loop (jitter bench, OTA pacing).
+ControlCore *arbiter = nullptr;     ///< Input arbitration (null when ControlCore doesn't run on this board).
+OtaService *updater = nullptr;      ///< OTA receiver (cfg::ota; null when disabled or no slot).
+BusReplay *player = nullptr;        ///< Dump player (cfg::replay; null when disabled or no partition).
+BusBridge *peer = nullptr;          ///< Link to the other board (cfg::bridge; null on a single board).
+AutoTuner tuner;                    ///< Core / priority tuning runs and the saved plan (cfg::tune).
+
+/// @brief Adaptive loops listed by the 'cadence' command (null → not running on this board).
+struct CadenceRow
+{
+  const char *name;
+  const Cadence *cadence;
+};
+std::array<CadenceRow, 3> cadences{{{"StateManager", nullptr}, {"RcPub", nullptr}, {"PDHandler", nullptr}}};
+
+static_assert(!(cfg::ota::ENABLED && cfg::telemetry::ENABLED), "OTA and the telemetry stream share Serial1: enable one.");
+static_assert(!(cfg::replay::ENABLED && cfg::recorder::ENABLED), "The recorder erases the dump slots BusReplay plays: enable one.");
+static_assert(cfg::rc::PROTOCOL != cfg::rc::Protocol::EspNow || cfg::espnow::ENABLED, "RC over ESP-NOW needs cfg::espnow::ENABLED.");
+static_assert(cfg::bridge::UART == 1 || cfg::bridge::UART == 2, "cfg::bridge::UART is Serial1 or Serial2.");
+static_assert(cfg::bridge::ROLE == cfg::bridge::Role::Off || cfg::bridge::UART != 1 || !(cfg::telemetry::ENABLED || cfg::ota::ENABLED),
+              "The bridge on Serial1 needs the telemetry stream and OTA off.");
+static_assert(cfg::bridge::ROLE != cfg::bridge::Role::Front || cfg::bridge::UART != 2, "Serial2 is the front board's receiver UART.");
+static_assert(cfg::bridge::ROLE == cfg::bridge::Role::Off || !cfg::replay::ENABLED, "BusReplay and the bridge both publish the pipeline buses: enable one.");
+
+// Arduino core hook: keep a freshly updated image pending-verify until OtaService confirms it.
+extern "C" bool verifyRollbackLater() { return cfg::ota::ENABLED; }
+
+// ---- Debug console commands ---- //
+static void cmdLatency(const char *args)
+{
+  if (strcmp(args, "reset") == 0)
+  {
+    trace::latency().reset();
+    debugln("Latency trace cleared.");
+    return;
+  }
+  trace::latency().dump();
+}
+
+static void cmdCost(const char *args)
+{
+  if (strcmp(args, "reset") == 0)
+  {
+    trace::cost().reset();
+    debugln("Stage cost cleared.");
+    return;
+  }
+  trace::cost().dump();
+}
+
+static void cmdTasks(const char *)
+{
+  const ProfileSnapshot p = buses::profile().peek();
+  if (p.count == 0)
+  {
+    debugln("No profile sample yet.");
+    return;
+  }
+
+  debugln("task          stack   free  cpu‰ pri core overruns   max_us   p99_us");
+  for (std::size_t i = 0; i < p.count; ++i)
+  {
+    const TaskProfile &t = p.tasks[i];
+    debugf("%-12s %6u %6u ", t.name, static_cast<unsigned>(t.stack_words), static_cast<unsigned>(t.stack_free_words));
+    if (t.cpu_permille == TaskProfile::kNoCpu)
+      debugf("%5s ", "-");
+    else
+      debugf("%5u ", static_cast<unsigned>(t.cpu_permille));
+    debugf("%3u %4s ", static_cast<unsigned>(t.priority), (t.core == 0) ? "0" : (t.core == 1) ? "1" : "any");
+    if (t.has_loop)
+      debugfln("%8u %8u %8u", static_cast<unsigned>(t.loop.overruns), static_cast<unsigned>(t.loop.max_us), static_cast<unsigned>(t.loop.p99_us));
+    else
+      debugfln("%8s %8s %8s", "-", "-", "-");
+  }
+
+  if (p.run_time_stats)
+    debugfln("core load: %u‰ / %u‰", static_cast<unsigned>(p.core_load_permille[0]), static_cast<unsigned>(p.core_load_permille[1]));
+  debugfln("heap: %u free, %u min free", static_cast<unsigned>(p.heap_free), static_cast<unsigned>(p.heap_min_free));
+}
+
+static void cmdLink(const char *)
+{
+  const RcLinkSnapshot l = buses::rcLink().peek();
+  if (l.stamp_us == 0)
+  {
+    debugln("No link sample yet.");
+    return;
+  }
+
+  debugf("frames %u  rate %.1f Hz  ", static_cast<unsigned>(l.frames), l.rate_hz);
+  if (l.has_crc)
+    debugf("crc errors %u  ", static_cast<unsigned>(l.crc_errors));
+  debugfln("since good %u ms", static_cast<unsigned>(l.since_good_ms));
+  debugfln("failsafe %s  entries %u  max gap %u us", l.failsafe ? "yes" : "no", static_cast<unsigned>(l.failsafe_entries),
+           static_cast<unsigned>(l.gap_max_us));
+
+  debug("gap ms:");
+  for (std::size_t i = 0; i < RcLinkSnapshot::kGapBins; ++i)
+  {
+    if (i < RcLinkSnapshot::kGapEdgesUs.size())
+      debugf(" <%.1f:%u", RcLinkSnapshot::kGapEdgesUs[i] / 1000.0f, static_cast<unsigned>(l.gap_hist[i]));
+    else
+      debugf(" more:%u", static_cast<unsigned>(l.gap_hist[i]));
+  }
+  debugln("");
+}
+
+static void cmdTelem(const char *)
+{
+  if constexpr (!cfg::telemetry::ENABLED)
+  {
+    debugln("Telemetry stream disabled (cfg::telemetry::ENABLED).");
+    return;
+  }
+  debugfln("frames %u  dropped %u", static_cast<unsigned>(telemetry.frames()), static_cast<unsigned>(telemetry.dropped()));
+  if (rawlog != nullptr)
+    debugfln("flash log: %u KB written  %u dropped  %u late erases  %u KB erased ahead",
+             static_cast<unsigned>(rawlog->bytesWritten() / 1024), static_cast<unsigned>(rawlog->dropped()),
+             static_cast<unsigned>(rawlog->lateErases()), static_cast<unsigned>(rawlog->aheadSectors() * 4));
+}
+
+static void cmdEspNow(const char *)
+{
+  if constexpr (!cfg::espnow::ENABLED)
+  {
+    debugln("ESP-NOW link disabled (cfg::espnow::ENABLED).");
+    return;
+  }
+  const espnow::Stats st = espnow::stats();
+  debugfln("rc: %u packets  %u rejected", static_cast<unsigned>(st.rc_packets), static_cast<unsigned>(st.rc_rejected));
+  debugfln("telemetry: %u packets (%u entries)  %u failed  %u dropped", static_cast<unsigned>(st.tx_packets),
+           static_cast<unsigned>(radio.entries()), static_cast<unsigned>(st.tx_failed), static_cast<unsigned>(st.tx_dropped));
+}
+
+static void cmdBridge(const char *)
+{
+  if (peer == nullptr)
+  {
+    debugln("Bus bridge not running (cfg::bridge::ROLE).");
+    return;
+  }
+  const bridge::Stats st = peer->stats();
+  const uint32_t seen = st.rx_frames + st.rx_lost;
+  debugfln("link %s  %u losses  rtt %u us (min %u  max %u)  peer clock %+lld us", st.up ? "up" : "DOWN",
+           static_cast<unsigned>(st.link_losses), static_cast<unsigned>(st.rtt_us), static_cast<unsigned>(st.rtt_min_us),
+           static_cast<unsigned>(st.rtt_max_us), static_cast<long long>(st.offset_us));
+  debugfln("tx: %u frames (%u keys)  %u dropped", static_cast<unsigned>(st.tx_frames), static_cast<unsigned>(st.tx_keys),
+           static_cast<unsigned>(st.tx_dropped));
+  debugfln("rx: %u frames  %u lost (%.2f %%)  %u bad  %u stale  %u mismatched", static_cast<unsigned>(st.rx_frames),
+           static_cast<unsigned>(st.rx_lost), seen ? 100.0 * st.rx_lost / seen : 0.0, static_cast<unsigned>(st.rx_bad),
+           static_cast<unsigned>(st.rx_stale), static_cast<unsigned>(st.rx_mismatch));
+}
+
+static void cmdCadence(const char *)
+{
+  if constexpr (!cfg::cadence::ENABLED)
+  {
+    debugln("Adaptive cadence disabled (cfg::cadence::ENABLED).");
+    return;
+  }
+  for (const CadenceRow &r : cadences)
+    if (r.cadence != nullptr)
+      debugfln("%-12s %-6s %u parks", r.name, cadence::to_name(r.cadence->current()), static_cast<unsigned>(r.cadence->parks()));
+}
+
+static void cmdPower(const char *args)
+{
+  if (strcmp(args, "reset") == 0)
+  {
+    pm::resetStats();
+    return;
+  }
+  if (!pm::active())
+  {
+    debugln("Power management off (cfg::power::ENABLED or CONFIG_PM_ENABLE): full clock, no sleep.");
+    return;
+  }
+  const pm::Stats s = pm::stats();
+  debugfln("CPU %u MHz (DFS %u-%u), light sleep %s, %u locks held", static_cast<unsigned>(getCpuFrequencyMhz()),
+           static_cast<unsigned>(cfg::power::MIN_MHZ), static_cast<unsigned>(cfg::power::MAX_MHZ),
+           pm::lightSleep() ? "on" : "off", static_cast<unsigned>(pm::held()));
+  debugfln("wake -> first drive step: %u wakes  last %u us  max %u us  over the %u us budget %u", static_cast<unsigned>(s.wakes),
+           static_cast<unsigned>(s.last_us), static_cast<unsigned>(s.max_us),
+           static_cast<unsigned>(cfg::power::WAKE_BUDGET_US), static_cast<unsigned>(s.over));
+}
+
+static void cmdTune(const char *args)
+{
+  if constexpr (!cfg::tune::ENABLED)
+  {
+    debugln("Auto-tuner disabled (cfg::tune::ENABLED).");
+    return;
+  }
+  if (strcmp(args, "start") == 0)
+    tuner.start(); ///< Restarts the chip on success.
+  else if (strcmp(args, "clear") == 0)
+  {
+    tuner.clear();
+    debugln("Tune: plan dropped; the graph's own plan applies from the next boot.");
+  }
+  else
+    tuner.report();
+}
+
+static void cmdHealth(const char *)
+{
+  if constexpr (!cfg::supervisor::ENABLED)
+  {
+    debugln("Supervisor disabled (cfg::supervisor::ENABLED).");
+    return;
+  }
+
+  const HealthSnapshot h = buses::health().peek();
+  debugfln("%u incidents  drive %s", static_cast<unsigned>(h.incidents), h.degraded ? "DEGRADED" : "normal");
+  for (std::size_t i = 0; i < h.count; ++i)
+  {
+    const TaskHealth &t = h.tasks[i];
+    debugfln("%-13s %9u beats  %6u misses  %3u stalls  age %7u us  due %7u us  max gap %7u us%s", t.name,
+             static_cast<unsigned>(t.beats), static_cast<unsigned>(t.misses), static_cast<unsigned>(t.stalls),
+             static_cast<unsigned>(t.age_us), static_cast<unsigned>(t.due_us), static_cast<unsigned>(t.max_gap_us),
+             t.stalled ? "  STALLED" : "");
+  }
+}
+
+// One consumer's freshness line.
+static void printAge(const char *consumer, const snapshot::Freshness &f)
+{
+  const snapshot::Freshness::Stats s = f.stats();
+  debugfln("%-12s %-8s %9u reads  %7u stale  p99 <= %7u us  max %8u us  budget %7u us", consumer, f.name(),
+           static_cast<unsigned>(s.reads), static_cast<unsigned>(s.stale), static_cast<unsigned>(s.p99_us),
+           static_cast<unsigned>(s.max_us), static_cast<unsigned>(s.budget_us));
+}
+
+// One bus's age line.
+static void printBusAge(const char *name, uint32_t age_us)
+{
+  if (age_us == snapshot::kNeverPublished)
+    debugfln("%-12s never published", name);
+  else
+    debugfln("%-12s %8u us since the last publish", name, static_cast<unsigned>(age_us));
+}
+
+static void cmdAge(const char *)
+{
+  const uint64_t now = now_us();
+  printBusAge("RcBus", buses::rc().age_us(now));
+  printBusAge("TelemetryBus", buses::telemetry().age_us(now));
+  printBusAge("PowerBus", buses::power().age_us(now));
+  printBusAge("FaultBus", buses::fault().age_us(now));
+  printBusAge("HealthBus", buses::health().age_us(now));
+
+  if (arbiter != nullptr)
+    printAge("ControlCore", arbiter->rcAge());
+  if (drive != nullptr)
+  {
+    printAge("PDHandler", drive->controlAge());
+    printAge("PDHandler", drive->powerAge());
+  }
+}
+
+static void cmdBoot(const char *)
+{
+  boot::report();
+}
+
+static void cmdMem(const char *)
+{
+  mem::report();
+}
+
+// One PDHandler loop statistics line.
+static void printLoop(const char *label, const LoopStats &s)
+{
+  debugfln("%-6s %6u periods of %u us  min %5u  p99 %5u  max %6u us  overruns %u", label, static_cast<unsigned>(s.count),
+           static_cast<unsigned>(s.nominal_us), static_cast<unsigned>(s.min_us), static_cast<unsigned>(s.p99_us),
+           static_cast<unsigned>(s.max_us), static_cast<unsigned>(s.overruns));
+}
+
+static void cmdJitter(const char *args)
+{
+  if (drive == nullptr)
+    return;
+  if (strcmp(args, "erase") != 0)
+  {
+    printLoop("PDH", drive->loopStats());
+    return;
+  }
+
+  using namespace cfg::hotpath;
+  const uint32_t bytes = BENCH_SECTORS * 4096U;
+  const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, BENCH_PARTITION);
+  if (part == nullptr || part->size < bytes)
+  {
+    debugfln("No '%s' data partition of at least %u KB (cfg::hotpath::BENCH_PARTITION).", BENCH_PARTITION,
+             static_cast<unsigned>(bytes / 1024));
+    return;
+  }
+
+  // Same window twice: the loop alone, then with the cache stalled by sector erases.
+  const TickType_t window = to_ticks_ms(BENCH_MS);
+  drive->keepAwake(true);                                 ///< A parked loop has no periods to measure.
+  vTaskDelay(to_ticks_ms(cfg::cadence::DRIVE_BEAT_MS) + 1); ///< A parked loop sees it on its next beat.
+  drive->resetLoopStats();
+  vTaskDelay(window);
+  const LoopStats idle = drive->loopStats();
+
+  drive->resetLoopStats();
+  vTaskDelay(1); ///< Reset lands on the loop's next wakeup.
+  const uint64_t t0 = now_us();
+  const esp_err_t err = esp_partition_erase_range(part, 0, bytes);
+  const uint32_t erase_us = static_cast<uint32_t>(now_us() - t0);
+  vTaskDelay(window);
+  const LoopStats busy = drive->loopStats();
+  drive->keepAwake(false);
+
+  printLoop("idle", idle);
+  printLoop("erase", busy);
+  const bool flat = err == ESP_OK && busy.overruns <= idle.overruns && busy.max_us <= idle.max_us + JITTER_TOL_US;
+  debugfln("%u sectors erased in %u us%s: jitter %s", static_cast<unsigned>(BENCH_SECTORS), static_cast<unsigned>(erase_us),
+           (err == ESP_OK) ? "" : " (erase failed)", flat ? "flat, PASS" : "NOT flat, FAIL");
+}
+
+static void cmdBench(const char *)
+{
+  if constexpr (!cfg::bench::ENABLED)
+  {
+    debugln("Button bench disabled (cfg::bench::ENABLED).");
+    return;
+  }
+  bench::buttons();
+}
+
+static void cmdOta(const char *)
+{
+  if (updater == nullptr)
+  {
+    debugln("OTA not running (cfg::ota::ENABLED / OTA partitions).");
+    return;
+  }
+  const ota::Status s = updater->status();
+  static constexpr const char *kState[] = {"idle", "baseline", "receiving", "done", "failed"};
+  debugfln("running '%s'%s  next '%s'  state %s  error %s", updater->running(), updater->pendingVerify() ? " (pending verify)" : "",
+           updater->target(), kState[static_cast<uint8_t>(s.state)], ota::to_name(s.error));
+  if (s.size == 0)
+    return;
+  debugfln("%u / %u B  gap %u ms  %u bursts (%u costly, longest %u us)", static_cast<unsigned>(s.received),
+           static_cast<unsigned>(s.size), static_cast<unsigned>(s.gap_ms), static_cast<unsigned>(s.bursts),
+           static_cast<unsigned>(s.costly), static_cast<unsigned>(s.burst_max_us));
+  printLoop("before", s.before);
+  printLoop("during", s.state == ota::State::Receiving ? drive->loopStats() : s.during);
+}
+
+static void cmdBlackBox(const char *args)
+{
+  if (recorder == nullptr)
+  {
+    debugln("Flight recorder not running (cfg::recorder::ENABLED / partition / PSRAM).");
+    return;
+  }
+  if (strcmp(args, "mark") == 0)
+  {
+    recorder->trigger(blackbox::Reason::Manual);
+    debugfln("Dump armed (written in %u ms).", static_cast<unsigned>(cfg::recorder::POST_MS));
+    return;
+  }
+
+  debugfln("%u slots, %u dumps this boot", static_cast<unsigned>(recorder->slots()), static_cast<unsigned>(recorder->dumps()));
+  for (uint32_t s = 0; s < recorder->slots(); ++s)
+  {
+    blackbox::DumpHeader h{};
+    if (!recorder->header(s, h))
+      continue;
+    debugfln("  slot %2u  #%-4u %-8s %5u records  code %u  @%llu us%s", static_cast<unsigned>(s), static_cast<unsigned>(h.seq),
+             blackbox::to_name(static_cast<blackbox::Reason>(h.reason)), static_cast<unsigned>(h.count),
+             static_cast<unsigned>(h.code), static_cast<unsigned long long>(h.trigger_us),
+             (h.commit == blackbox::kCommitted) ? "" : "  (torn)");
+  }
+}
+
+static void cmdReplay(const char *args)
+{
+  if (player == nullptr)
+  {
+    debugln("Bus replay not running (cfg::replay::ENABLED / partition).");
+    return;
+  }
+
+  // "[seq] [fast]" plays; no arguments lists the dumps and the last playback.
+  if (*args != '\0')
+  {
+    char *rest = nullptr;
+    const uint32_t seq = static_cast<uint32_t>(strtoul(args, &rest, 10));
+    while (*rest == ' ')
+      ++rest;
+    const replay::Pace pace = (strcmp(rest, "fast") == 0) ? replay::Pace::Fast : replay::Pace::Recorded;
+    if (player->play(seq, pace))
+      debugfln("Playback started (%s pace, into %s).", replay::to_name(pace),
+               (player->target() == cfg::replay::Target::Drive) ? "PDHandler" : "ControlCore");
+    else
+      debugln(player->busy() ? "Playback already running." : "No such dump.");
+    return;
+  }
+
+  for (uint32_t b = 0; b < player->blocks(); ++b)
+  {
+    blackbox::DumpHeader h{};
+    if (player->header(b, h))
+      debugfln("  #%-4u %-8s %5u records%s", static_cast<unsigned>(h.seq), blackbox::to_name(static_cast<blackbox::Reason>(h.reason)),
+               static_cast<unsigned>(h.count), (h.commit == blackbox::kCommitted) ? "" : "  (torn)");
+  }
+  if (player->busy())
+  {
+    debugln("Playback running.");
+    return;
+  }
+
+  const replay::Report &r = player->report();
+  if (r.seq == 0)
+    return;
+  debugfln("last: #%u %s  %u records over %u ms (from %u ms) in %u ms  late max %u us", static_cast<unsigned>(r.seq),
+           replay::to_name(r.pace), static_cast<unsigned>(r.records), static_cast<unsigned>(r.span_us / 1000),
+           static_cast<unsigned>(r.first_us / 1000), static_cast<unsigned>(r.took_us / 1000), static_cast<unsigned>(r.late_max_us));
+  debugfln("      %u published  %u unanswered  %u / %u diverged (first at record %u)", static_cast<unsigned>(r.published),
+           static_cast<unsigned>(r.unanswered), static_cast<unsigned>(r.diverged), static_cast<unsigned>(r.compared),
+           static_cast<unsigned>(r.first_diverged));
+  trace::cost().dump();
+}
+
+static void cmdFault(const char *args)
+{
+  if (guard == nullptr)
+  {
+    debugln("Fault guard not running (cfg::fault::ENABLED / FAULT_PIN / cfg::adc).");
+    return;
+  }
+  if (strcmp(args, "clear") == 0)
+  {
+    debugln(guard->clear() ? "Clear requested." : "Refused: fault input still asserted or Vbus above CLEAR_VOLTS.");
+    return;
+  }
+
+  const FaultSnapshot f = buses::fault().peek();
+  debugfln("latched %s  active %s  trips %u  last @%llu us  Vbus %.2f V%s", FaultSnapshot::causeName(f.latched),
+           FaultSnapshot::causeName(f.active), static_cast<unsigned>(f.trips), static_cast<unsigned long long>(f.trip_us),
+           static_cast<double>(f.vbus_v), guard->monitoring() ? "" : " (not monitored)");
+}
+
+static void cmdLog(const char *args)
+{
+  // "<module|all> <level>" sets the runtime level; no arguments lists both gates per module.
+  if (*args != '\0')
+  {
+    char name[16]{};
+    const char *space = strchr(args, ' ');
+    const std::size_t len = (space != nullptr) ? static_cast<std::size_t>(space - args) : strlen(args);
+    logx::Level lvl{};
+    logx::Module m{};
+    const bool all = (len == 3 && strncmp(args, "all", 3) == 0);
+    if (len < sizeof(name))
+      memcpy(name, args, len);
+    if (space == nullptr || len >= sizeof(name) || (!all && !logx::parse(name, m)) || !logx::parse(space + 1, lvl))
+    {
+      debugln("Usage: log <module|all> <off|error|warn|info|debug|trace>");
+      return;
+    }
+    for (std::size_t i = 0; i < logx::kModules; ++i)
+      if (all || static_cast<logx::Module>(i) == m)
+        logx::setLevel(static_cast<logx::Module>(i), lvl);
+  }
+
+  debugln("  module      level  compiled");
+  for (std::size_t i = 0; i < logx::kModules; ++i)
+    debugfln("  %-10s  %-5s  %s", logx::kModuleNames[i], logx::kLevelNames[static_cast<std::size_t>(logx::level(static_cast<logx::Module>(i)))],
+             logx::kLevelNames[static_cast<std::size_t>(cfg::logging::MODULE[i])]);
+}
+
+// Register the bridge outputs a trip must drop (EN pins; MCPWM timers for hardware fault detect).
+static void attachFaultOutputs(FaultGuard &g)
+{
+  if constexpr (cfg::motor::BACKEND == cfg::motor::Backend::McpwmArray)
+  {
+    for (std::size_t i = 0; i < cfg::motor::BRIDGES; ++i)
+    {
+      g.killPin(cfg::motor::BRIDGE_EN[i]);
+      g.mcpwmTimer(i < 3 ? MCPWM_UNIT_0 : MCPWM_UNIT_1, static_cast<mcpwm_timer_t>(i % 3));
+    }
+  }
+  else
+  {
+    g.killPin(cfg::motor::EN_PIN); ///< RmtServo has no EN: the ESC sees neutral once PowerDriveHandler coasts.
+    if constexpr (cfg::motor::BACKEND == cfg::motor::Backend::Mcpwm)
+      g.mcpwmTimer(MCPWM_UNIT_0, MCPWM_TIMER_0); ///< motor::Config default unit, timer 0.
+  }
+}
+
+// Bridge hooks: the peer's stamps move into this board's clock (0 stays "no stamp").
+static uint64_t toLocal(uint64_t peer_us, int64_t offset_us)
+{
+  return peer_us == 0 ? 0 : static_cast<uint64_t>(static_cast<int64_t>(peer_us) - offset_us);
+}
+
+static void restampControl(ControlSnapshot &c, int64_t offset_us)
+{
+  c.origin_us = toLocal(c.origin_us, offset_us);
+  c.stamp_ms = static_cast<uint32_t>(c.origin_us / 1000ULL);
+}
+
+static void restampTelemetry(TelemetrySnapshot &t, int64_t offset_us)
+{
+  t.stamp_us = toLocal(t.stamp_us, offset_us);
+  t.origin_us = toLocal(t.origin_us, offset_us);
+}
+
+// Front board silent: the rear board holds what ControlCore's failsafe would publish.
+static void safeControl(ControlSnapshot &c)
+{
+  c.throttle_cmd_pct = 0.0f;
+  c.steer_cmd = 0.0f;
+  c.horn_cmd = false;
+  c.indicator_cmd = ControlSnapshot::Indicator::Hazard;
+  c.lights_cmd = true;
+  c.authority = ControlSnapshot::Authority::Failsafe;
+}
+
+// Build the drive backend (McpwmArray also takes the bridge table).
+template <typename B>
+static B makeDriveBackend(const motor::Config &mc)
+{
+  if constexpr (B::kChannels > 1)
+  {
+    std::array<typename B::Bridge, B::kChannels> bridges{};
+    for (std::size_t i = 0; i < B::kChannels; ++i)
+      bridges[i] = {cfg::motor::BRIDGE_RPWM[i], cfg::motor::BRIDGE_LPWM[i], cfg::motor::BRIDGE_EN[i]};
+    return B(bridges, mc);
+  }
+  else
+    return B(mc);
+}
 
 void setup()
 {
-  // ---- Start serial monitor ---- //
+  // ==== Stage 0: bridge in coast before anything else (EN + PWM pins low) ==== //
+  if (cfg::motor::BACKEND == cfg::motor::Backend::McpwmArray)
+    for (std::size_t i = 0; i < cfg::motor::BRIDGES; ++i)
+      boot::holdBridgeOff(cfg::motor::BRIDGE_EN[i], cfg::motor::BRIDGE_RPWM[i], cfg::motor::BRIDGE_LPWM[i]);
+  else
+    boot::holdBridgeOff(cfg::motor::EN_PIN, cfg::motor::RPWM_PIN, cfg::motor::LPWM_PIN);
+
+  // ---- Serial + deferred log (no monitor wait: boot output queues in the log ring) ---- //
   Serial.begin(115200);
-  delay(200);
 
-  debugln("===== Startup =====");
+#if DEBUGGING && DEBUG_DEFERRED
+  if constexpr (cfg::memory::STATIC_TASKS)
+  {
+    mem::Stack logStack{};
+    configASSERT(mem::stacks().take(LOG_STACK, logStack));
+    configASSERT(dlog::start(logStack.stack, logStack.tcb, LOG_STACK, LOG_PRI, /*Core=*/0, &log_t));
+  }
+  else
+    configASSERT(dlog::start(LOG_STACK, LOG_PRI, /*Core=*/0, &log_t)); ///< debug*() stop blocking on the UART from here on.
+#endif
+
+  // ---- Power management (before any task: the deadline tasks take their locks from their first iteration) ---- //
+  pm::begin();
+
+  // ==== Stage 1: inputs, RC, control and drive (everything "drivable" depends on) ==== //
+
+  // ---- Calibration (mapped in place; compiled defaults if the partition is blank) ---- //
+  calib::begin();
+  const calib::ButtonCal &btnCal = calib::active().buttons;
 
   // ---- Shared inputBus ---- //
   static InputBus inputBus{};
   static ControlBus controlBus{};
 
   // ---- Button setup ---- //
-  const ButtonTimingConfig kTiming{cfg::button::BTN_DEBOUNCE_MS, cfg::button::BTN_SHORT_MS,
-                                   cfg::button::BTN_LONG_MS};
+  const ButtonTimingConfig kTiming{btnCal.debounce_ms, btnCal.short_ms, btnCal.long_ms};
   static Button btnHandler = makeButtons(kTiming);
 
-  // ---- Motor setup ---- //
-  static Motor driveMotor;
+  // Word-at-a-time alternative: same pins, one GPIO register read + bit-parallel debounce per update().
+  static GpioPortReader portReader;
+  static PortButtons<NUM_BUTTONS, GpioPortReader> portButtons(portReader, btnCal.debounce_ms);
+  if constexpr (cfg::button::BTN_PORT_SCAN)
+  {
+    portReader.begin(kButtonPins, NUM_BUTTONS);
+    portButtons.begin();
+  }
+
+  // Key matrix: timer-scanned rows / columns, ghost-blocked, debounced the same way.
+  static KeyMatrix keyMatrix(cfg::matrix::ROW_PINS, std::size(cfg::matrix::ROW_PINS), cfg::matrix::COL_PINS,
+                             std::size(cfg::matrix::COL_PINS));
+  static PortButtons<NUM_BUTTONS, KeyMatrix> matrixButtons(keyMatrix, btnCal.debounce_ms, /*active_low=*/false);
+  if constexpr (cfg::matrix::ENABLED)
+  {
+    if (!keyMatrix.begin())
+      logError("KeyMatrix: GPTimer unavailable, matrix not scanning.");
+    matrixButtons.begin();
+  }
+
+  IButtonHandler &buttons = cfg::matrix::ENABLED ? static_cast<IButtonHandler &>(matrixButtons)
+                            : cfg::button::BTN_PORT_SCAN ? static_cast<IButtonHandler &>(portButtons)
+                            : btnHandler;
+
+  // ---- Motor setup (the backend takes the pins over in coast) ---- //
+  motor::Config mc{};
+  mc.rpwm_pin = cfg::motor::RPWM_PIN;
+  mc.lpwm_pin = cfg::motor::LPWM_PIN;
+  mc.en_pin = cfg::motor::EN_PIN;
+  mc.pwm_hz = cfg::motor::PWM_FREQ_HZ;
+  mc.servo_pin = cfg::motor::SERVO_PIN;
+  mc.neutral_us = cfg::motor::SERVO_NEUTRAL_US;
+  mc.span_us = cfg::motor::SERVO_SPAN_US;
+  mc.reversible = cfg::motor::SERVO_REVERSIBLE;
+  mc.behavior = MotorBehaviorConfig{
+      FreewheelMode::HiZ, ///< coast() = EN low; PowerDriveHandler brakes on the low sides itself.
+      /* soft_brake_hz   */ cfg::motor::SOFT_BRAKE_HZ,
+      /* dither_pwm      */ 0,
+      /* default_soft    */ 0,
+      /* min_phase_us    */ cfg::motor::MIN_PHASE_US,
+      /* dither_coast_hi_z */ true};
 
-  MotorMCPWMConfig hw{};
-  hw.rpwm_pin = cfg::motor::RPWM_PIN;
-  hw.lpwm_pin = cfg::motor::LPWM_PIN;
-  hw.en_pin = cfg::motor::EN_PIN;
+  const bool inputsHere = cfg::bridge::ROLE != cfg::bridge::Role::Rear; ///< Buttons, receiver and ControlCore run on this board.
+  const bool driveHere = cfg::bridge::ROLE != cfg::bridge::Role::Front; ///< PowerDriveHandler runs on this board.
 
-  driveMotor.setup(hw);
+  static DriveBackend driveMotor = makeDriveBackend<DriveBackend>(mc);
+  if (driveHere)
+  {
+    configASSERT(driveMotor.begin()); ///< Stays in coast until PowerDriveHandler's first step.
+    logInfo("Motor: %s backend.", DriveBackend::kLabel);
+  }
+
+  // ---- Power sensing (ADC1 DMA: Vbus / current frames, no conversions on the control core) ---- //
+  static AdcService adcService(buses::power());
+  PowerBus *powerBus = nullptr; ///< nullptr → no Vbus / current for FaultGuard and telemetry.
+  if constexpr (cfg::adc::ENABLED)
+  {
+    if (adcService.begin())
+      powerBus = &buses::power();
+    else
+      logWarn("AdcService: no ADC1 pin or DMA setup failed, power sensing off.");
+  }
+  if (cfg::limit::ENABLED && (powerBus == nullptr || cfg::adc::CURRENT_PIN < 0))
+    logWarn("Limit: no current frames, throttle envelope off.");
+
+  // ---- Bridge protection (fault input / Vbus trip the bridge off without waiting for a task) ---- //
+  static FaultGuard faultGuard(buses::fault(), cfg::fault::FAULT_PIN, cfg::fault::ACTIVE_LOW, powerBus);
+  FaultBus *faultBus = nullptr; ///< nullptr → PowerDriveHandler ignores faults.
+  if constexpr (cfg::fault::ENABLED)
+  {
+    attachFaultOutputs(faultGuard); ///< After driveMotor.begin(): MCPWM fault actions need the timers configured.
+    faultGuard.onTrip([](uint8_t causes)
+                      {
+                        if (recorder != nullptr)
+                          recorder->trigger(blackbox::Reason::Fault, causes); ///< Bridge already off: dump is safe.
+                      });
+    if (faultGuard.begin())
+    {
+      guard = &faultGuard;
+      faultBus = &buses::fault();
+    }
+    else
+      logWarn("FaultGuard: no fault pin or Vbus monitor, bridge unprotected.");
+  }
+
+  // ---- Steering servo (optional; RMT loops the pulse, the task only rewrites its width) ---- //
+  static SteeringHandler steering(controlBus);
+  bool steer = false; ///< True once the servo pulse runs.
+  if constexpr (cfg::steering::ENABLED)
+  {
+    steer = steering.begin();
+    if (!steer)
+      logWarn("SteeringHandler: no servo pin or RMT setup failed, steering off.");
+  }
+
+  // ---- Speed encoder (optional) ---- //
+  static SpeedEncoder encoder;
+  SpeedEncoder *speedEnc = nullptr; ///< nullptr → PowerDriveHandler stays open loop.
+  if (cfg::encoder::ENABLED)
+  {
+    if (encoder.begin())
+      speedEnc = &encoder;
+    else
+      logWarn("SpeedEncoder: PCNT setup failed, running open loop.");
+  }
 
   // ---- Managers ---- //
-  static StateManager sm(btnHandler, inputBus); ///< Defaults to cfg::tick::LOOP_MS.
-  static RcPublisher rcp;
-  static ControlCore cc(inputBus, controlBus);
-  static PowerDriveHandler pdh(driveMotor, controlBus); ///< Defaults to cfg::tick::LOOP_MS.
-
-  // ---- Start publishers ---- //
-  rcp.begin();
-
-  // ---- FreeRTOS tasks ----
-  configASSERT(xTaskCreatePinnedToCore(StateManager::task, "StateManager", SM_STACK, &sm, SM_PRI, &sm_t, /*Core=*/0) == pdPASS);
-  delay(50);
-  configASSERT(xTaskCreatePinnedToCore(ControlCore::task, "ControlCore", CC_STACK, &cc, CC_PRI, &cc_t, /*Core=*/0) == pdPASS);
-  delay(50);
-  configASSERT(xTaskCreatePinnedToCore(PowerDriveHandler::task, "PDHandler", PDH_STACK, &pdh, PDH_PRI, &pdh_t, /*Core=*/1) == pdPASS);
-  delay(50);
-
-  debugln("All RTOS tasks started!");
+  static StateManager sm(buttons, inputBus, cfg::tick::LOOP_MS,
+                         (cfg::button::BTN_IRQ_WAKE && !cfg::matrix::ENABLED) ? StateManager::ScanMode::Interrupt
+                                                                                : StateManager::ScanMode::Poll); ///< Matrix keys have no edge IRQs.
+  static RcPublisher rcp{cfg::tick::LOOP_MS, 0.0f, cfg::rc::HEARTBEAT_MS};                                       ///< Publish on change + heartbeat.
+  static ControlCore cc(inputBus, buses::rc(), controlBus);
+  static PowerDriveHandler pdh(driveMotor, controlBus, buses::telemetry(), speedEnc, faultBus, powerBus); ///< Defaults to cfg::drive::PERIOD_US.
+  if (driveHere)
+  {
+    drive = &pdh;
+    cadences[2].cadence = &pdh.cadence();
+  }
+
+  // ---- Bus replay (bench: a FlightRecorder dump stands in for the buttons + receiver, or for ControlCore too) ---- //
+  static BusReplay busReplay(inputBus, buses::rc(), controlBus, buses::telemetry());
+  if constexpr (cfg::replay::ENABLED)
+  {
+    if (busReplay.begin())
+      player = &busReplay;
+    else
+      logInfo("BusReplay: no dump partition, live inputs.");
+  }
+  const bool live = player == nullptr && inputsHere;                                                ///< Buttons + receiver publish.
+  const bool control = inputsHere && (live || cfg::replay::TARGET == cfg::replay::Target::Control); ///< ControlCore runs.
+
+  // ---- Bus bridge (two boards: ControlBus crosses to the drive board, TelemetryBus comes back) ---- //
+  static BusBridge busBridge(cfg::bridge::UART == 2 ? Serial2 : Serial1);
+  static BusBridge::BusMirror<ControlBus> ctlOut(controlBus);
+  static BusBridge::BusSink<TelemetryBus> telIn(buses::telemetry(), restampTelemetry);
+  static BusBridge::BusMirror<TelemetryBus> telOut(buses::telemetry());
+  static BusBridge::BusSink<ControlBus> ctlIn(controlBus, restampControl, safeControl); ///< Link loss → stop.
+  if constexpr (cfg::bridge::ROLE != cfg::bridge::Role::Off)
+  {
+    busBridge.begin();
+    if (inputsHere)
+    {
+      busBridge.add(ctlOut);
+      busBridge.add(telIn);
+    }
+    else
+    {
+      busBridge.add(telOut);
+      busBridge.add(ctlIn);
+    }
+    peer = &busBridge;
+    logInfo("Bridge: %s board on Serial%d at %u baud.", inputsHere ? "front" : "rear", cfg::bridge::UART,
+            static_cast<unsigned>(cfg::bridge::BAUD));
+  }
+
+  // ---- ESP-NOW (radio up before the receiver: RC may arrive over it) ---- //
+  bool radioUp = false; ///< True once ESP-NOW runs.
+  if constexpr (cfg::espnow::ENABLED)
+  {
+    radioUp = espnow::start();
+    if (!radioUp)
+      logError("EspNow: start failed, no wireless link.");
+  }
+
+  // ---- Configure publishers (tasks start with the graph below) ---- //
+  if (live)
+  {
+    rcp.begin();
+    if (!cfg::button::BTN_IRQ_WAKE || cfg::matrix::ENABLED)
+      cadences[0].cadence = &sm.cadence(); ///< Poll mode only: interrupt mode already blocks between edges.
+    cadences[1].cadence = &rcp.cadence();
+  }
+
+  // ---- Critical tasks (priorities / cores derived from timing; see rtos::TaskGraph) ---- //
+  static rtos::TaskGraph<> critical;
+  if (live)
+  {
+    critical.add("StateManager", sm, SM_STACK).every_ms(cfg::tick::LOOP_MS).budget_us(200).writes(inputBus).handle(&sm_t);
+    auto &rcNode = critical.add("RcPub", rcp, RC_STACK).budget_us(300).writes(buses::rc()).handle(&rc_t);
+    if (rcp.wake() == RcPublisher::Wake::UartEvent)
+      rcNode.deadline_us(1000); ///< Frame-driven: publish within 1 ms of the last byte.
+    else
+      rcNode.every_ms(cfg::tick::LOOP_MS);
+  }
+  else if (player != nullptr)
+  {
+    auto &rplNode = critical.add("Replay", busReplay, RPL_STACK)
+                        .priority(cfg::replay::PRIORITY) ///< Fixed: every record is answered before the next one.
+                        .pin(0)                          ///< Flash reads stay off the PDHandler core.
+                        .handle(&rpl_t);
+    if (control)
+      rplNode.writes(inputBus).writes(buses::rc());
+    else
+      rplNode.writes(controlBus);
+  }
+  if (control)
+  {
+    arbiter = &cc;
+    auto &ccNode = critical.add("ControlCore", cc, CC_STACK)
+                       .deadline_us(2000) ///< Event-driven: must turn an input around well inside one input period.
+                       .budget_us(100)
+                       .reads(inputBus)
+                       .reads(buses::rc())
+                       .writes(controlBus)
+                       .handle(&cc_t);
+    if (radioUp)
+      ccNode.pin(1); ///< The Wi-Fi stack owns core 0 while the radio runs.
+  }
+  if (peer != nullptr)
+  {
+    auto &brgNode = critical.add("Bridge", busBridge, BRG_STACK)
+                        .deadline_us(1000) ///< Event-driven: a publish or a received burst crosses within 1 ms.
+                        .budget_us(100)
+                        .pin(0) ///< With the UART event task, off the PDHandler core.
+                        .handle(&brg_t);
+    if (inputsHere)
+      brgNode.reads(controlBus).writes(buses::telemetry());
+    else
+      brgNode.reads(buses::telemetry()).writes(controlBus);
+  }
+  if (driveHere)
+    critical.add("PDHandler", pdh, PDH_STACK)
+        .every_us(cfg::drive::PERIOD_US)
+        .budget_us(150)
+        .pin(1) ///< Motor timer ISR + MCPWM stay off the input core.
+        .reads(controlBus)
+        .reads(buses::fault())
+        .reads(buses::power())
+        .writes(buses::telemetry())
+        .handle(&pdh_t);
+  if (steer)
+    critical.add("Steering", steering, STR_STACK)
+        .deadline_us(1000) ///< Event-driven: a new steer_cmd reaches the servo within the next RMT frame.
+        .budget_us(50)
+        .pin(0) ///< Off the motor core: the PDHandler tick never delays a steering update.
+        .reads(controlBus)
+        .handle(&str_t);
+  if (powerBus != nullptr)
+    critical.add("AdcService", adcService, ADC_STACK)
+        .every_us(adcService.periodUs()) ///< Paced by the DMA frame interrupt.
+        .budget_us(40)
+        .pin(0) ///< Frame reduction stays off the motor core.
+        .writes(buses::power())
+        .handle(&adc_t);
+  if (guard != nullptr)
+    critical.add("FaultGuard", faultGuard, FG_STACK)
+        .priority(cfg::fault::PRIORITY) ///< Fixed: publishes trips ahead of everything it protects.
+        .pin(1)                         ///< With PDHandler; the fault ISR was allocated on this core in setup().
+        .reads(buses::power())
+        .writes(buses::fault())
+        .handle(&fg_t);
+  static Supervisor supervisor(buses::health());
+  if constexpr (cfg::supervisor::ENABLED)
+    supervisor.begin(); ///< Watchdog timeout set before the first beat subscribes a task.
+  tuner.begin();
+  tuner.apply(critical);          ///< Trial due or saved plan: core / priority corrections on the declarations above.
+  configASSERT(critical.start()); ///< Consumers first; no fixed start-up delays.
+  tuner.observe(critical);        ///< Baseline trial: what the graph chose on its own.
+  boot::mark(boot::Mark::Critical);
+
+  // Drivable = PowerDriveHandler's first step (its first publish carries the step time).
+  const TickType_t wait = to_ticks_ms(cfg::boot::DRIVABLE_WAIT_MS);
+  for (TickType_t t = 0; buses::telemetry().peek().stamp_us == 0 && t < wait; ++t)
+    vTaskDelay(1);
+  const uint64_t first_step_us = buses::telemetry().peek().stamp_us;
+  if (first_step_us != 0)
+    boot::mark(boot::Mark::Drivable, first_step_us);
+
+  // ==== Stage 2: diagnostics and logging (nothing above waits for these) ==== //
+
+  // ---- Debug console ---- //
+  static DebugConsole console;
+  console.add("lat", cmdLatency, "Latency histograms per stage ('lat reset' clears).");
+  console.add("cost", cmdCost, "CPU time per ControlCore / PDHandler activation ('cost reset' clears).");
+  console.add("tasks", cmdTasks, "Per-task stack high-water, CPU share and loop overruns.");
+  console.add("link", cmdLink, "Receiver frame rate, CRC errors, inter-frame gaps and failsafe entries.");
+  console.add("telem", cmdTelem, "Binary telemetry frames sent / dropped.");
+  console.add("espnow", cmdEspNow, "ESP-NOW RC packets in and telemetry packets out.");
+  console.add("bbox", cmdBlackBox, "Flight recorder dumps in flash ('bbox mark' arms a manual dump).");
+  console.add("replay", cmdReplay, "Play a recorder dump into the pipeline ('replay [seq] [fast]'; no args: dumps + last result).");
+  console.add("bridge", cmdBridge, "Board-to-board link: round trip, peer clock, frames sent / lost / dropped.");
+  console.add("cadence", cmdCadence, "Adaptive loop rate per task (boost / active / idle / park) and park count.");
+  console.add("power", cmdPower, "CPU clock, light sleep, held locks and wake-to-drive latency ('power reset' clears).");
+  console.add("tune", cmdTune, "Core / priority auto-tuner: trials and saved plan ('tune start' runs, restarting per trial; 'tune clear').");
+  console.add("boot", cmdBoot, "Boot timeline up to drivable.");
+  console.add("bench", cmdBench, "Button update() / snapshot() CPU cycles per backend for 1..64 inputs, for_each_edge cost.");
+  console.add("jitter", cmdJitter, "PDHandler loop jitter ('jitter erase' measures it while flash sectors erase).");
+  console.add("mem", cmdMem, "Memory map: static buses / rings / stacks and heap per capability.");
+  console.add("ota", cmdOta, "OTA slot, transfer progress and drive loop jitter before vs during the update.");
+  console.add("age", cmdAge, "Bus ages now, and each consumer's frame-age histogram against its freshness budget.");
+  console.add("health", cmdHealth, "Supervised tasks: heartbeats, deadline misses, stalls and the degrade state.");
+  console.add("fault", cmdFault, "Bridge protection state and Vbus ('fault clear' re-arms after a trip).");
+  console.add("log", cmdLog, "Log level per module, runtime and compiled-in ('log <module|all> <level>' sets it).");
+
+  // ---- Service tasks (background, or fixed just above it: never outrank stage 1) ---- //
+  static rtos::TaskGraph<> services;
+  services.add("Console", console, CON_STACK).pin(0).handle(&con_t);
+
+  // ---- Indicators / headlights / horn (LEDC runs the patterns; the task only reacts to mode changes) ---- //
+  static LightsService lights(controlBus);
+  if constexpr (cfg::lights::ENABLED)
+  {
+    if (lights.begin())
+      services.add("Lights", lights, LITE_STACK).pin(0).reads(controlBus).handle(&lite_t);
+  }
+
+  static TaskProfiler profiler(buses::profile(), PROF_STACK);
+  if constexpr (cfg::profiler::ENABLED)
+    services.add("Profiler", profiler, PROF_STACK).pin(0).writes(buses::profile()).handle(&prof_t);
+
+  // ---- Binary telemetry (lowest priority; never blocks a producer) ---- //
+  static TelemetryStream::StreamTap<TelemetryBus> telTap(buses::telemetry());
+  static TelemetryStream::StreamTap<RcBus> rcTap(buses::rc());
+  static TelemetryStream::StreamTap<ControlBus> ctlTap(controlBus);
+  static TelemetryStream::BusTap<RcLinkBus> linkTap(buses::rcLink());
+  static TelemetryStream::PackedTap<InputBus> inTap(inputBus); ///< Packed only (no raw decoder layout).
+  static FlashLog flashLog;
+  if constexpr (cfg::telemetry::ENABLED)
+  {
+    telemetry.begin();
+    telemetry.add(telTap);
+    telemetry.add(rcTap);
+    telemetry.add(ctlTap);
+    telemetry.add(linkTap);
+    if constexpr (cfg::telemetry::PACKED)
+      telemetry.add(inTap);
+    services.add("Telemetry", telemetry, TEL_STACK)
+        .pin(0)
+        .reads(buses::telemetry())
+        .reads(buses::rc())
+        .reads(controlBus)
+        .reads(buses::rcLink())
+        .reads(inputBus)
+        .handle(&tel_t);
+
+    if (cfg::flashlog::ENABLED && flashLog.begin())
+    {
+      rawlog = &flashLog;
+      flashLog.eraseWhen([] { return buses::telemetry().peek().duty_pct == 0.0f; }); ///< Erase ahead only while the motor is idle (duty is signed: reverse is < 0).
+      telemetry.mirror(flashLog);
+      services.add("FlashLog", flashLog, FLOG_STACK).pin(0).handle(&flog_t); ///< Off the PowerDriveHandler core.
+    }
+  }
+
+  // ---- ESP-NOW telemetry (one batched packet per period, queued to the Wi-Fi task on core 0) ---- //
+  static EspNowTelemetry::PackedTap<TelemetryBus> radioTelTap(buses::telemetry());
+  static EspNowTelemetry::PackedTap<ControlBus> radioCtlTap(controlBus);
+  static EspNowTelemetry::PackedTap<RcBus> radioRcTap(buses::rc());
+  if (radioUp)
+  {
+    radio.add(radioTelTap);
+    radio.add(radioCtlTap);
+    radio.add(radioRcTap);
+    services.add("EspNow", radio, ESPN_STACK)
+        .priority(cfg::espnow::PRIORITY)
+        .pin(0) ///< With the Wi-Fi stack: the control core never runs radio code.
+        .reads(buses::telemetry())
+        .reads(controlBus)
+        .reads(buses::rc())
+        .handle(&espn_t);
+  }
+
+  // ---- Flight recorder (dumps the last seconds of inputs on failsafe / fault / panic) ---- //
+  static FlightRecorder flightRecorder(inputBus, buses::rc(), controlBus);
+  if constexpr (cfg::recorder::ENABLED)
+  {
+    if (flightRecorder.begin()) ///< May write a recovered panic dump: runs after the drive is already safe.
+    {
+      recorder = &flightRecorder;
+      services.add("Recorder", flightRecorder, REC_STACK)
+          .priority(cfg::recorder::PRIORITY)
+          .pin(0)
+          .reads(inputBus)
+          .reads(buses::rc())
+          .reads(controlBus)
+          .handle(&rec_t);
+    }
+  }
+
+  // ---- OTA update (throttled flash bursts into the inactive slot; shares Serial1 with telemetry) ---- //
+  static OtaService otaService(Serial1);
+  if constexpr (cfg::ota::ENABLED)
+  {
+    otaService.writeWhen([] { return buses::telemetry().peek().duty_pct == 0.0f; }); ///< Flash bursts only at zero duty.
+    otaService.watch([] { return drive->loopStats(); },
+                     []
+                     {
+                       drive->keepAwake(true); ///< Transfers run at zero duty: measure a running loop, not a parked one.
+                       drive->resetLoopStats();
+                     });
+    otaService.healthyWhen([]
+                           {
+                             const uint64_t at = buses::telemetry().peek().stamp_us;
+                             return at != 0 && now_us() - at < (cfg::cadence::DRIVE_BEAT_MS + 100U) * 1000U &&
+                                    buses::fault().peek().latched == FaultSnapshot::None;
+                           }); ///< Drive loop publishing, bridge not tripped.
+    if (otaService.begin())
+    {
+      updater = &otaService;
+      services.add("OTA", otaService, OTA_STACK).pin(0).handle(&ota_t); ///< Off the PowerDriveHandler core.
+    }
+  }
+
+  // ---- Auto-tuner (one trial per boot while a run is in progress) ---- //
+  if constexpr (cfg::tune::ENABLED)
+  {
+    tuner.holdWith([](bool on)
+                   {
+                     if (drive != nullptr)
+                       drive->keepAwake(on); ///< Measure a running drive loop, not a parked one.
+                   });
+    tuner.restartWhen([] { return buses::telemetry().peek().duty_pct == 0.0f; }); ///< Restart only at zero duty.
+    if (tuner.running())
+      services.add("Tuner", tuner, TUNE_STACK).priority(cfg::tune::PRIORITY).pin(0).handle(&tune_t);
+  }
+
+  // ---- Supervisor (control-task heartbeats; a stall or a miss burst → cfg::supervisor::RESPONSE) ---- //
+  if constexpr (cfg::supervisor::ENABLED)
+  {
+    if (live)
+    {
+      supervisor.watch(sm.heartbeat());
+      supervisor.watch(rcp.heartbeat());
+    }
+    if (control)
+      supervisor.watch(cc.heartbeat());
+    if (driveHere)
+      supervisor.watch(pdh.heartbeat());
+    supervisor.onDegrade([](bool on)
+                         {
+                           if (drive != nullptr)
+                             drive->degrade(on);
+                         });
+    supervisor.onCoast([]
+                       {
+                         if (guard != nullptr)
+                           guard->force(FaultSnapshot::Watchdog); ///< EN low, latched until 'fault clear'.
+                         else
+                           logWarn("Supervisor: no fault guard to coast the bridge, degraded only.");
+                       });
+    services.add("Supervisor", supervisor, SUP_STACK)
+        .priority(cfg::supervisor::PRIORITY) ///< Fixed: must outrank every service it could be starved by.
+        .pin(0)                              ///< Off the PDHandler core: a spinning drive loop cannot hide itself.
+        .writes(buses::health())
+        .handle(&sup_t);
+  }
+
+  configASSERT(services.create());
+
+  // ---- Task profiler (sizes stacks / balances cores from measurements) ---- //
+  if constexpr (cfg::profiler::ENABLED)
+  {
+    profiler.watch(sm_t, SM_STACK, sm);
+    profiler.watch(cc_t, CC_STACK);
+    profiler.watch(pdh_t, PDH_STACK, pdh);
+    profiler.watch(str_t, STR_STACK);
+    profiler.watch(adc_t, ADC_STACK);
+    profiler.watch(fg_t, FG_STACK);
+    profiler.watch(rc_t, RC_STACK, rcp);
+    profiler.watch(con_t, CON_STACK);
+    profiler.watch(log_t, LOG_STACK); ///< Ignored when the drain isn't running (null handle).
+    profiler.watch(tel_t, TEL_STACK);
+    profiler.watch(rec_t, REC_STACK);
+    profiler.watch(flog_t, FLOG_STACK);
+    profiler.watch(lite_t, LITE_STACK);
+    profiler.watch(ota_t, OTA_STACK);
+    profiler.watch(rpl_t, RPL_STACK);
+    profiler.watch(espn_t, ESPN_STACK);
+    profiler.watch(brg_t, BRG_STACK);
+    profiler.watch(tune_t, TUNE_STACK);
+    profiler.watch(sup_t, SUP_STACK);
+  }
+
+  services.release();
+  boot::mark(boot::Mark::Services);
+
+  // ---- Memory map (everything above is static or allocated by now; seal() marks the end of boot) ---- //
+  mem::region("InputBus", inputBus);
+  mem::region("ControlBus", controlBus);
+  mem::region("RcBus", buses::rc());
+  mem::region("RcLinkBus", buses::rcLink());
+  mem::region("TelemetryBus", buses::telemetry());
+  mem::region("PowerBus", buses::power());
+  mem::region("FaultBus", buses::fault());
+  mem::region("ProfileBus", buses::profile());
+  mem::region("HealthBus", buses::health());
+  mem::region("latency", trace::latency());
+#if DEBUGGING && DEBUG_DEFERRED
+  mem::region("dlog", dlog::sink());
+#endif
+  mem::region("telemetry", telemetry);
+  mem::region("flashlog", flashLog);
+  mem::region("ota", otaService);
+  mem::region("replay", busReplay);
+  mem::region("espnow", radio);
+  mem::region("bridge", busBridge);
+  mem::seal();
+
+  critical.print();
+  services.print();
+  boot::report();
+  mem::report();
+  logInfo("All RTOS tasks started!");
 }
 
 /**
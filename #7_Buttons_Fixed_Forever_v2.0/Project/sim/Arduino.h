@@ -0,0 +1,228 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: the Arduino-ESP32 subset the pipeline uses (time, GPIO, HardwareSerial) on SimKernel.
+ *
+ * @file Arduino.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <esp_attr.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+#define OUTPUT_OPEN_DRAIN 0x13
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define DEC 10
+#define HEX 16
+
+#define SERIAL_8N1 0x800001c
+#define SERIAL_8E2 0x800003e
+
+#define digitalPinToInterrupt(p) (p)
+
+// ---- Time (virtual) ---- //
+
+inline unsigned long micros() { return static_cast<unsigned long>(esp_timer_get_time()); }
+inline unsigned long millis() { return static_cast<unsigned long>(esp_timer_get_time() / 1000); }
+inline void delay(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+inline void delayMicroseconds(uint32_t us) { sim::spend(us); } ///< Busy-wait: holds the (only) CPU.
+
+// ---- GPIO (levels set by the simulation; edges run attached ISRs) ---- //
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+void attachInterruptArg(uint8_t pin, void (*isr)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+// ---- Print / Stream / HardwareSerial ---- //
+
+/// @brief Arduino Print: formatting on top of write().
+class Print
+{
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t *buf, size_t n)
+    {
+        size_t i = 0;
+        while (i < n && write(buf[i]) == 1)
+            ++i;
+        return i;
+    }
+
+    size_t write(const char *s) { return (s != nullptr) ? write(reinterpret_cast<const uint8_t *>(s), strlen(s)) : 0; }
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int v, int base = DEC) { return print(static_cast<long long>(v), base); }
+    size_t print(unsigned v, int base = DEC) { return print(static_cast<unsigned long long>(v), base); }
+    size_t print(long v, int base = DEC) { return print(static_cast<long long>(v), base); }
+    size_t print(unsigned long v, int base = DEC) { return print(static_cast<unsigned long long>(v), base); }
+    size_t print(long long v, int base = DEC) { return (base == HEX) ? printf("%llx", v) : printf("%lld", v); }
+    size_t print(unsigned long long v, int base = DEC) { return (base == HEX) ? printf("%llx", v) : printf("%llu", v); }
+    size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+
+    size_t println() { return write("\r\n"); }
+
+    template <typename T>
+    size_t println(const T &v)
+    {
+        const size_t n = print(v);
+        return n + println();
+    }
+
+    size_t println(double v, int digits) { return print(v, digits) + println(); }
+
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buf[256];
+        va_list ap;
+        va_start(ap, fmt);
+        const int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (n <= 0)
+            return 0;
+        return write(reinterpret_cast<const uint8_t *>(buf), (static_cast<size_t>(n) < sizeof(buf)) ? n : sizeof(buf) - 1);
+    }
+};
+
+/// @brief Arduino Stream: byte input on top of Print.
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    size_t readBytes(uint8_t *buf, size_t n)
+    {
+        size_t i = 0;
+        for (int c; i < n && (c = read()) >= 0; ++i)
+            buf[i] = static_cast<uint8_t>(c);
+        return i;
+    }
+
+    size_t readBytes(char *buf, size_t n) { return readBytes(reinterpret_cast<uint8_t *>(buf), n); }
+};
+
+using OnReceiveCb = std::function<void(void)>; ///< Arduino-ESP32 UART RX callback.
+
+/**
+ * @brief UART model: the simulation inject()s received bytes; writes go to stdout (UART0) or a byte counter.
+ *
+ * inject() appends to the RX buffer (bytes past setRxBufferSize() are
+ * dropped and counted, as the driver would) and then runs the onReceive()
+ * callback once, i.e. one RX-timeout event per injected burst.
+ */
+class HardwareSerial : public Stream
+{
+public:
+    explicit HardwareSerial(int uart) noexcept : uart_(uart), echo_(uart == 0) {}
+
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rx = -1, int8_t tx = -1, bool invert = false,
+               unsigned long timeout_ms = 20000UL, uint8_t rxfifo_full = 112);
+    void end() { begun_ = false; }
+
+    int available() override { return static_cast<int>(rx_.size()); }
+    int read() override;
+    int peek() override { return rx_.empty() ? -1 : rx_.front(); }
+    size_t read(uint8_t *buf, size_t n) { return readBytes(buf, n); }
+
+    using Print::write;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t n) override;
+    int availableForWrite() { return static_cast<int>(tx_cap_); }
+    void flush();
+
+    size_t setRxBufferSize(size_t n)
+    {
+        rx_cap_ = n;
+        return n;
+    }
+    size_t setTxBufferSize(size_t n)
+    {
+        tx_cap_ = n;
+        return n;
+    }
+    void onReceive(OnReceiveCb cb, bool only_on_timeout = false)
+    {
+        (void)only_on_timeout;
+        on_rx_ = std::move(cb);
+    }
+    bool setRxTimeout(uint8_t symbols)
+    {
+        (void)symbols;
+        return true;
+    }
+    bool setRxFIFOFull(uint8_t bytes)
+    {
+        (void)bytes;
+        return true;
+    }
+    uint32_t baudRate() const { return baud_; }
+    operator bool() const { return true; }
+
+    // ---- Simulation side ---- //
+
+    /**
+     * @brief Bytes arriving on RX (one burst → one onReceive callback).
+     *
+     * @param data Bytes.
+     * @param n Count.
+     * @return size_t Bytes stored (the rest overflowed).
+     */
+    size_t inject(const uint8_t *data, size_t n);
+
+    /// @brief RX bytes dropped on a full buffer.
+    [[nodiscard]] uint32_t overflows() const noexcept { return overflows_; }
+
+    /// @brief TX bytes written.
+    [[nodiscard]] uint64_t sent() const noexcept { return sent_; }
+
+    /// @brief Route TX to stdout.
+    void echo(bool on) noexcept { echo_ = on; }
+
+private:
+    int uart_{0};            ///< UART number.
+    bool begun_{false};      ///< begin() called.
+    bool echo_{false};       ///< TX → stdout.
+    uint32_t baud_{0};       ///< Line rate.
+    std::deque<uint8_t> rx_; ///< RX buffer.
+    size_t rx_cap_{256};     ///< RX buffer size (Arduino default).
+    size_t tx_cap_{128};     ///< Reported TX space.
+    OnReceiveCb on_rx_;      ///< RX callback.
+    uint32_t overflows_{0};  ///< Dropped RX bytes.
+    uint64_t sent_{0};       ///< TX bytes.
+};
+
+extern HardwareSerial Serial;  ///< Console (stdout).
+extern HardwareSerial Serial1; ///< Telemetry / OTA (counted).
+extern HardwareSerial Serial2; ///< Receiver (inject() RC frames).
@@ -0,0 +1,206 @@
+/**
+ * MIT License
+ *
+ * @brief Host check: the Q16.16 control-path kernels against their float twins.
+ *
+ * cfg::numeric::FIXED_POINT builds the control path on fixed::Q16 for the
+ * FPU-less targets; the host (and the classic ESP32) runs it on float. The
+ * two must not drift apart, so each kernel runs once per type over the same
+ * input and the worst gap is held to a stated tolerance:
+ *
+ *   BasicSlewEngine  ≤ 1.0 %-pt  The dominant error is the 1 ms tick: Q16
+ *                                rounds it to 66/65536 s (+0.7 %), so the
+ *                                fixed ramp runs 0.7 % fast and leads by up
+ *                                to 0.7 % of the swing mid-ramp. Both must
+ *                                land on the same target.
+ *   rc_batch::map    ≤ 2^-23     Relative to max(1, |out|): both share the
+ *                                Q16.16 product, so the float result may only
+ *                                be that product rounded to float (one ulp).
+ *   BasicAlphaBeta   ≤ 0.1 %-pt  Value; rate ≤ 1 %/s + 0.5 % of |rate|.
+ *                                Q16 rounds α·residual and β/dt each step;
+ *                                the track pulls both back to the samples.
+ *
+ * Run with: ./pipeline_sim --check-fixed (exit status 1 if any fails).
+ *
+ * @file FixedCheck.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "FixedCheck.h"
+
+#include <app_config.h>
+#include <AlphaBeta.h>
+#include <FixedPoint.h>
+#include <RcBatch.h>
+#include <SlewEngine.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+    using Q16 = fixed::Q16;
+
+    constexpr float kSlewTolPct = 1.0f;                 ///< Ramp: worst |float − Q16| (%-pt).
+    constexpr float kMapTol = 1.0f / 8388608.0f;        ///< RC map: worst |float − Q16| / max(1, |Q16|).
+    constexpr float kTrackTolPct = 0.1f;                ///< Tracker value: worst |float − Q16| (%-pt).
+    constexpr float kRateTol = 1.0f;                    ///< Tracker rate: worst |float − Q16| floor (%/s) ...
+    constexpr float kRateTolRel = 0.005f;               ///< ... plus this share of |rate|.
+    constexpr float kRampRatePctPerSec = 40.0f;         ///< PowerDriveHandler::kRampRatePctPerSec.
+    constexpr uint32_t kTickUs = cfg::drive::PERIOD_US; ///< Ramp step (µs).
+
+    /// @brief One PASS / FAIL line with the worst gap and its limit.
+    bool report(bool pass, const char *what, float worst, float tol, const char *unit)
+    {
+        std::printf("%s  %s (worst %.3g %s, limit %.3g)\n", pass ? "PASS" : "FAIL", what, worst, unit, tol);
+        return pass;
+    }
+
+    /**
+     * @brief Drive a float and a Q16 ramp through the same target script; worst |float − Q16| (%-pt).
+     *
+     * Script: 0 → 100, retarget to 50 mid-ramp, back up to 100, down to 30,
+     * through 0 to −60 and back to 0, each held long enough to settle.
+     * A final value that differs at all counts as a miss.
+     */
+    float slewGap(BasicSlewEngine<float>::Profile profile, float rate, float accel)
+    {
+        BasicSlewEngine<float> f{{profile, rate, accel}};
+        const auto qp = (profile == BasicSlewEngine<float>::Profile::SCurve) ? BasicSlewEngine<Q16>::Profile::SCurve
+                                                                             : BasicSlewEngine<Q16>::Profile::Linear;
+        BasicSlewEngine<Q16> q{{qp, Q16{rate}, Q16{accel}}};
+
+        struct Leg
+        {
+            float target; ///< Target (%).
+            uint32_t ms;  ///< Time held (ms).
+        };
+        constexpr Leg kScript[] = {{100.0f, 1200}, {50.0f, 3000}, {100.0f, 4000}, {30.0f, 5000}, {-60.0f, 8000}, {0.0f, 6000}};
+
+        const float dt_f = num::seconds<float>(kTickUs);
+        const Q16 dt_q = num::seconds<Q16>(kTickUs);
+        float worst = 0.0f;
+        for (const Leg &leg : kScript)
+        {
+            f.setTarget(leg.target);
+            q.setTarget(Q16{leg.target});
+            for (uint32_t t = 0; t < leg.ms * 1000U; t += kTickUs)
+            {
+                const float a = f.step(dt_f).pct;
+                const float b = num::to_float(q.step(dt_q).pct);
+                worst = std::fmax(worst, std::fabs(a - b));
+            }
+        }
+        return (num::to_float(q.value()) == f.value() && q.settled() == f.settled()) ? worst : INFINITY;
+    }
+
+    /// @brief Map every int16 through a float and a Q16 table; worst |float − Q16| / max(1, |Q16|).
+    float mapGap()
+    {
+        constexpr std::size_t kCh = 4;
+        rc_batch::Table<kCh> t{};     ///< Ch 0: identity (RcPublisher's default).
+        t.set(1, 0.5f, 0.0f);         ///< Half scale.
+        t.set(2, -0.25f, 12.5f);      ///< Inverted with a bias.
+        t.set(3, 0.1f, -7.0f / 3.0f); ///< Gain and bias with no short binary form.
+
+        float worst = 0.0f;
+        for (int32_t v = INT16_MIN; v <= INT16_MAX; ++v)
+        {
+            int16_t src[kCh];
+            for (std::size_t i = 0; i < kCh; ++i)
+                src[i] = static_cast<int16_t>(v);
+            float a[kCh];
+            Q16 b[kCh];
+            rc_batch::map(src, a, kCh, t);
+            rc_batch::map(src, b, kCh, t);
+            for (std::size_t i = 0; i < kCh; ++i)
+            {
+                const double exact = static_cast<double>(b[i].raw()) / Q16::kOne; ///< Q16 in full: no float rounding.
+                const double gap = std::fabs(a[i] - exact) / std::fmax(1.0, std::fabs(exact));
+                worst = std::fmax(worst, static_cast<float>(gap));
+            }
+        }
+        return worst;
+    }
+
+    /// @brief Worst gaps of one tracker run.
+    struct TrackGap
+    {
+        float value; ///< Worst |float − Q16| value (%-pt).
+        float rate;  ///< Worst |float − Q16| rate over its limit, kRateTol + kRateTolRel·|rate| (≤ 1 → pass).
+    };
+
+    /**
+     * @brief Feed a float and a Q16 tracker the same jittery stick; compare value and rate per sample.
+     *
+     * A stick sweeping ±100 % at two speeds, sampled every 7 ms ± 3 ms with
+     * ±1 % noise, a burst of back-to-back frames (< min_dt_us) and a gap
+     * past max_gap_us. Deterministic (LCG), so a failure reproduces.
+     */
+    TrackGap trackGap()
+    {
+        const BasicAlphaBeta<float>::Config cf{cfg::smooth::ALPHA, cfg::smooth::BETA, cfg::smooth::MAX_RATE,
+                                               cfg::smooth::MIN_DT_US, cfg::smooth::RESET_MS * 1000U};
+        const BasicAlphaBeta<Q16>::Config cq{Q16{cfg::smooth::ALPHA}, Q16{cfg::smooth::BETA}, Q16{cfg::smooth::MAX_RATE},
+                                             cfg::smooth::MIN_DT_US, cfg::smooth::RESET_MS * 1000U};
+        BasicAlphaBeta<float> f{cf};
+        BasicAlphaBeta<Q16> q{cq};
+
+        uint32_t seed = 0x2545F491u;
+        const auto rnd = [&seed](int32_t lo, int32_t hi) ///< Uniform in [lo, hi].
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + static_cast<int32_t>((seed >> 8) % static_cast<uint32_t>(hi - lo + 1));
+        };
+
+        TrackGap g{0.0f, 0.0f};
+        uint64_t stamp = 1000000;
+        for (uint32_t k = 0; k < 4000; ++k)
+        {
+            if (k == 2000)
+                stamp += cfg::smooth::RESET_MS * 1000U + 1; ///< Link stall: both restart the track.
+            else if (k % 500 < 5)
+                stamp += static_cast<uint64_t>(rnd(200, 900)); ///< Back-to-back frames: value correction only.
+            else
+                stamp += static_cast<uint64_t>(rnd(4000, 10000));
+
+            const float t_s = static_cast<float>(stamp) * 1e-6f;
+            const float period = (k < 2000) ? 1.5f : 0.4f;
+            float z = 100.0f * std::sin(6.2831853f * t_s / period) + static_cast<float>(rnd(-100, 100)) * 0.01f;
+            z = std::round(z * 65536.0f) / 65536.0f; ///< Same sample for both: exactly representable in Q16.
+
+            f.update(z, stamp);
+            q.update(Q16{z}, stamp);
+            g.value = std::fmax(g.value, std::fabs(f.value() - q.value().toFloat()));
+            const float dr = std::fabs(f.rate() - q.rate().toFloat());
+            g.rate = std::fmax(g.rate, dr / (kRateTol + kRateTolRel * std::fabs(f.rate())));
+        }
+        return g;
+    }
+} // namespace
+
+namespace sim
+{
+    bool checkFixed() noexcept
+    {
+        using Profile = BasicSlewEngine<float>::Profile;
+        bool ok = true;
+
+        const float lin = slewGap(Profile::Linear, kRampRatePctPerSec, cfg::drive::RAMP_ACCEL_PCT_S2);
+        ok &= report(lin <= kSlewTolPct, "SlewEngine linear ramp: Q16 tracks float", lin, kSlewTolPct, "%-pt");
+        const float scurve = slewGap(Profile::SCurve, kRampRatePctPerSec, cfg::drive::RAMP_ACCEL_PCT_S2);
+        ok &= report(scurve <= kSlewTolPct, "SlewEngine S-curve ramp: Q16 tracks float", scurve, kSlewTolPct, "%-pt");
+        const float stop = slewGap(Profile::Linear, cfg::drive::REVERSE_DECEL_PCT_S, cfg::drive::RAMP_ACCEL_PCT_S2);
+        ok &= report(stop <= kSlewTolPct, "SlewEngine reversal ramp-down: Q16 tracks float", stop, kSlewTolPct, "%-pt");
+
+        const float map = mapGap();
+        ok &= report(map <= kMapTol, "rc_batch::map: Q16 matches float over every int16", map, kMapTol, "rel");
+
+        const TrackGap tr = trackGap();
+        ok &= report(tr.value <= kTrackTolPct, "AlphaBeta value: Q16 tracks float", tr.value, kTrackTolPct, "%-pt");
+        ok &= report(tr.rate <= 1.0f, "AlphaBeta rate: Q16 tracks float", tr.rate, 1.0f, "x (1 %/s + 0.5 % of |rate|)");
+        return ok;
+    }
+} ///< Namespace sim.
@@ -0,0 +1,27 @@
+/**
+ * MIT License
+ *
+ * @brief Host check: the Q16.16 control-path kernels against their float twins.
+ *
+ * @file FixedCheck.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+namespace sim
+{
+    /**
+     * @brief Run the float and fixed::Q16 builds of each real_t kernel over the same input and compare.
+     *
+     * Covers BasicSlewEngine (the PowerDriveHandler ramps), rc_batch::map (the
+     * RcPublisher table) and BasicAlphaBeta (the ControlCore trackers), each
+     * with the firmware's settings. Prints one PASS / FAIL line per kernel
+     * with the worst deviation seen and the tolerance it was held to.
+     *
+     * @return true if every kernel stayed within its tolerance.
+     */
+    bool checkFixed() noexcept;
+} ///< Namespace sim.
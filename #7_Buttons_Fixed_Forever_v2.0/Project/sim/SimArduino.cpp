@@ -0,0 +1,136 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the host Arduino shim (GPIO levels + edge ISRs, HardwareSerial).
+ *
+ * @file SimArduino.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include <Arduino.h>
+#include <SimDevices.h>
+#include <array>
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+
+namespace
+{
+    constexpr std::size_t kPins = 49; ///< GPIO0..48 (ESP32-S3).
+
+    /// @brief One GPIO.
+    struct Pin
+    {
+        uint8_t level{HIGH};          ///< Input / output level (idle high: pull-ups).
+        int mode{0};                  ///< RISING / FALLING / CHANGE (0 → no ISR).
+        void (*isr)(void *){nullptr}; ///< attachInterruptArg() handler.
+        void *arg{nullptr};           ///< Handler argument.
+    };
+
+    std::array<Pin, kPins> s_pins{}; ///< Pin table (only touched by the running task).
+
+    /// @brief Pin @p pin, or nullptr when out of range.
+    Pin *pinAt(uint8_t pin) noexcept { return (pin < kPins) ? &s_pins[pin] : nullptr; }
+} // namespace
+
+// ---- GPIO ---- //
+
+// Pin modes are not modelled.
+void pinMode(uint8_t, uint8_t) {}
+
+// Drive an output (no ISR: outputs are not looped back).
+void digitalWrite(uint8_t pin, uint8_t level)
+{
+    if (Pin *p = pinAt(pin))
+        p->level = level ? HIGH : LOW;
+}
+
+// Read a level.
+int digitalRead(uint8_t pin)
+{
+    const Pin *p = pinAt(pin);
+    return (p != nullptr) ? p->level : LOW;
+}
+
+// Register an edge ISR.
+void attachInterruptArg(uint8_t pin, void (*isr)(void *), void *arg, int mode)
+{
+    if (Pin *p = pinAt(pin))
+    {
+        p->isr = isr;
+        p->arg = arg;
+        p->mode = mode;
+    }
+}
+
+// Remove an edge ISR.
+void detachInterrupt(uint8_t pin)
+{
+    if (Pin *p = pinAt(pin))
+        p->isr = nullptr;
+}
+
+// Drive an input; run the ISR on a matching edge.
+void sim::gpioSet(uint8_t pin, int level) noexcept
+{
+    Pin *p = pinAt(pin);
+    if (p == nullptr)
+        return;
+    const uint8_t was = p->level;
+    p->level = level ? HIGH : LOW;
+    if (p->isr == nullptr || was == p->level)
+        return;
+    const bool rising = p->level == HIGH;
+    if (p->mode == CHANGE || (rising && p->mode == RISING) || (!rising && p->mode == FALLING))
+        p->isr(p->arg);
+}
+
+// ---- HardwareSerial ---- //
+
+// Open the port (only the rate is kept).
+void HardwareSerial::begin(unsigned long baud, uint32_t, int8_t, int8_t, bool, unsigned long, uint8_t)
+{
+    baud_ = static_cast<uint32_t>(baud);
+    begun_ = true;
+}
+
+// One RX byte.
+int HardwareSerial::read()
+{
+    if (rx_.empty())
+        return -1;
+    const int c = rx_.front();
+    rx_.pop_front();
+    return c;
+}
+
+// TX: stdout (console) or counted.
+size_t HardwareSerial::write(const uint8_t *buf, size_t n)
+{
+    sent_ += n;
+    if (echo_)
+        fwrite(buf, 1, n, stdout);
+    return n;
+}
+
+// Drain TX.
+void HardwareSerial::flush()
+{
+    if (echo_)
+        fflush(stdout);
+}
+
+// Bytes arriving from the line.
+size_t HardwareSerial::inject(const uint8_t *data, size_t n)
+{
+    size_t stored = 0;
+    for (; stored < n && rx_.size() < rx_cap_; ++stored)
+        rx_.push_back(data[stored]);
+    overflows_ += static_cast<uint32_t>(n - stored);
+    if (on_rx_)
+        on_rx_(); ///< RX timeout: the frame has ended.
+    return stored;
+}
@@ -0,0 +1,226 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the simulated hardware (motor plant, button pins, RC transmitter).
+ *
+ * @file SimDevices.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "SimDevices.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /// @brief Pack 16 µs channels as 11-bit SBUS / CRSF values, LSB first (inverse of rc_batch::unpack11_us()).
+    void pack11(const uint16_t *us, uint8_t *out) noexcept
+    {
+        memset(out, 0, 22);
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            int32_t v = 992 + ((static_cast<int32_t>(us[i]) - 1500) * 8) / 5; ///< 1500 µs → 992, 5/8 µs per count.
+            v = (v < 0) ? 0 : ((v > 0x7FF) ? 0x7FF : v);
+            const std::size_t bit = i * 11;
+            for (std::size_t b = 0; b < 11; ++b)
+                if ((v >> b) & 1)
+                    out[(bit + b) >> 3] |= static_cast<uint8_t>(1U << ((bit + b) & 7));
+        }
+    }
+
+    /// @brief CRC-8/DVB-S2 (CRSF).
+    uint8_t crc8(const uint8_t *p, std::size_t n) noexcept
+    {
+        uint8_t crc = 0;
+        while (n-- > 0)
+        {
+            crc ^= *p++;
+            for (int b = 0; b < 8; ++b)
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0xD5) : static_cast<uint8_t>(crc << 1);
+        }
+        return crc;
+    }
+} // namespace
+
+// ---- Motor ---- //
+
+// Claim the (simulated) bridge: coast from rest.
+bool sim::Motor::begin() noexcept
+{
+    last_us_ = now_us();
+    mode_ = Mode::Coast;
+    duty_ = 0.0f;
+    leg_ = 0;
+    return true;
+}
+
+// Drive one leg at pct.
+void sim::Motor::drive(float pct, Dir dir) noexcept
+{
+    advance();
+    ++cmds_;
+    pct = (pct < 0.0f) ? 0.0f : ((pct > 100.0f) ? 100.0f : pct);
+    const int8_t leg = (pct > 0.0f) ? ((dir == Dir::CW) ? 1 : -1) : 0;
+    if (leg != 0 && leg_ != 0 && leg != leg_)
+        ++flips_; ///< Opposite leg straight from driving: no off / brake interval.
+    leg_ = leg;
+    mode_ = Mode::Drive; ///< Zero duty on a leg is slow decay, not coast.
+    duty_ = (dir == Dir::CW) ? pct : -pct;
+}
+
+// Batch form: one plant, so the bridges are averaged.
+void sim::Motor::setSpeedPercent(const std::array<float, kChannels> &pct, Dir dir) noexcept
+{
+    float sum = 0.0f;
+    for (float p : pct)
+        sum += p;
+    drive(sum / static_cast<float>(kChannels), dir);
+}
+
+// Every switch off.
+void sim::Motor::coast() noexcept
+{
+    advance();
+    ++cmds_;
+    mode_ = Mode::Coast;
+    duty_ = 0.0f;
+    leg_ = 0;
+}
+
+// Both low sides on.
+void sim::Motor::brake() noexcept
+{
+    advance();
+    ++cmds_;
+    ++brakes_;
+    mode_ = Mode::Brake;
+    duty_ = 0.0f;
+    leg_ = 0;
+}
+
+// Set the load.
+void sim::Motor::load(float fraction) noexcept
+{
+    advance();
+    load_ = (fraction < 0.0f) ? 0.0f : ((fraction > 1.0f) ? 1.0f : fraction);
+}
+
+// Shaft speed now.
+float sim::Motor::rpm() noexcept
+{
+    advance();
+    return rpm_;
+}
+
+// Encoder edges now.
+int64_t sim::Motor::edges() noexcept
+{
+    advance();
+    return static_cast<int64_t>(std::floor(turns_ * cfg::encoder::COUNTS_PER_REV));
+}
+
+// Exact first-order step from last_us_ to now.
+void sim::Motor::advance() noexcept
+{
+    const uint64_t now = now_us();
+    if (now <= last_us_)
+        return;
+    const double dt = static_cast<double>(now - last_us_) * 1e-6;
+    last_us_ = now;
+
+    const double target = (mode_ == Mode::Drive) ? (duty_ / 100.0) * kFreeRpm * (1.0 - load_) : 0.0;
+    const double tau = (mode_ == Mode::Drive) ? kTauDriveS : ((mode_ == Mode::Brake) ? kTauBrakeS : kTauCoastS);
+    const double a = std::exp(-dt / tau);
+    const double from = rpm_;
+
+    turns_ += (target * dt + (from - target) * tau * (1.0 - a)) / 60.0; ///< ∫ rpm dt, in revolutions.
+    rpm_ = static_cast<float>(target + (from - target) * a);
+    peak_rpm_ = std::fmax(peak_rpm_, std::fabs(rpm_)); ///< Monotonic between commands: the endpoint is the peak.
+}
+
+// ---- PinReader ---- //
+
+// Bind pins, released.
+void sim::PinReader::begin(const uint8_t *pins, std::size_t n) noexcept
+{
+    n_ = (n < kMaxInputs) ? n : kMaxInputs;
+    for (std::size_t i = 0; i < n_; ++i)
+    {
+        pins_[i] = pins[i];
+        gpioSet(pins[i], HIGH);
+    }
+}
+
+// Gather levels.
+uint64_t sim::PinReader::read() const noexcept
+{
+    uint64_t w = 0;
+    for (std::size_t i = 0; i < n_; ++i)
+        if (digitalRead(pins_[i]) == HIGH)
+            w |= uint64_t{1} << i;
+    return w;
+}
+
+// ---- RcTransmitter ---- //
+
+// Start the transmit task.
+void sim::RcTransmitter::start(unsigned priority) noexcept { (void)spawn(&RcTransmitter::task, this, "rc_tx", priority); }
+
+// One frame per kFrameUs, on a fixed grid.
+void sim::RcTransmitter::task(void *self)
+{
+    auto *tx = static_cast<RcTransmitter *>(self);
+    uint8_t frame[32];
+    uint64_t next = now_us();
+    for (;;)
+    {
+        const bool silent = tx->drop_ || (tx->fs_ && cfg::rc::PROTOCOL != cfg::rc::Protocol::Sbus);
+        if (!silent)
+        {
+            Serial2.inject(frame, tx->encode(frame));
+            ++tx->frames_;
+        }
+        next += kFrameUs;
+        sleepUntil(next);
+    }
+}
+
+// Encode the stick table.
+std::size_t sim::RcTransmitter::encode(uint8_t *out) const noexcept
+{
+    if constexpr (cfg::rc::PROTOCOL == cfg::rc::Protocol::Sbus)
+    {
+        out[0] = 0x0F;
+        pack11(us_.data(), out + 1);
+        out[23] = fs_ ? 0x08 : 0x00; ///< Bit 3: receiver failsafe.
+        out[24] = 0x00;
+        return 25;
+    }
+    else if constexpr (cfg::rc::PROTOCOL == cfg::rc::Protocol::Crsf)
+    {
+        out[0] = 0xC8; ///< Flight controller address.
+        out[1] = 24;   ///< Type + 22 payload + CRC.
+        out[2] = 0x16; ///< RC_CHANNELS_PACKED.
+        pack11(us_.data(), out + 3);
+        out[25] = crc8(out + 2, 23);
+        return 26;
+    }
+    else
+    {
+        out[0] = 0x20; ///< iBUS: 32-byte frame.
+        out[1] = 0x40; ///< Servo command.
+        for (std::size_t i = 0; i < 14; ++i)
+        {
+            out[2 + 2 * i] = static_cast<uint8_t>(us_[i] & 0xFF);
+            out[3 + 2 * i] = static_cast<uint8_t>(us_[i] >> 8);
+        }
+        uint16_t sum = 0xFFFF;
+        for (std::size_t i = 0; i < 30; ++i)
+            sum = static_cast<uint16_t>(sum - out[i]);
+        out[30] = static_cast<uint8_t>(sum & 0xFF);
+        out[31] = static_cast<uint8_t>(sum >> 8);
+        return 32;
+    }
+}
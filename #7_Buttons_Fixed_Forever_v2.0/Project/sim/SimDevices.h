@@ -0,0 +1,227 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: the hardware around the pipeline (motor + encoder plant, button pins, RC transmitter).
+ *
+ * @file SimDevices.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <app_config.h>
+#include <Arduino.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Motor direction (ESP32_MCPWM's enum; that library is not part of the host build).
+enum class Dir : uint8_t
+{
+    CW = 0, ///< Forward.
+    CCW     ///< Reverse.
+};
+
+namespace sim
+{
+    // ---- Stimulus side of the shims ---- //
+
+    /**
+     * @brief Drive a GPIO input to @p level; a matching edge runs the attachInterruptArg() ISR at once.
+     *
+     * @param pin GPIO number.
+     * @param level LOW / HIGH.
+     */
+    void gpioSet(uint8_t pin, int level) noexcept;
+
+    using EdgeSource = int64_t (*)(void *arg); ///< Cumulative signed edge count at now_us().
+
+    /**
+     * @brief Feed a PCNT unit from @p src (pulled whenever the unit is read, so no per-edge events).
+     *
+     * @param unit PCNT unit number.
+     * @param src Edge source.
+     * @param arg Source argument.
+     */
+    void pcntSource(int unit, EdgeSource src, void *arg) noexcept;
+
+    /**
+     * @brief Back data partition @p label with a RAM copy of the image file @p path (esptool read_flash format).
+     *
+     * A missing or short file reads as erased flash from where it ends.
+     *
+     * @param label Partition label.
+     * @param path Image file.
+     * @param size Partition size (0 → the file's size, rounded up to 64 KB).
+     * @return true If registered (false: duplicate label, no size, or the table is full).
+     */
+    bool partitionImage(const char *label, const char *path, uint32_t size = 0) noexcept;
+
+    /// @brief Write every written-to partition back to its image file (false on an I/O error).
+    bool partitionSave() noexcept;
+
+    // ---- Drive backend ---- //
+
+    /**
+     * @brief DriveBackend stand-in: records every command and runs a first-order motor + encoder plant.
+     *
+     * Speed relaxes exponentially towards duty × kFreeRpm × (1 − load) with a
+     * time constant per bridge state (drive / brake / coast). The plant is
+     * integrated exactly, lazily, whenever it is commanded or read, so it adds
+     * no events to the kernel. edges() is the x1 encoder count the PCNT shim
+     * pulls (attach() wires it).
+     *
+     * hardFlips() counts drive commands that reverse the bridge with no
+     * coast / brake / zero duty in between; PowerDriveHandler's reversal
+     * sequence should keep it at 0.
+     */
+    class Motor
+    {
+    public:
+        static constexpr const char *kLabel = "SIM"; ///< Log label.
+        static constexpr std::size_t kChannels =
+            (cfg::motor::BACKEND == cfg::motor::Backend::McpwmArray) ? cfg::motor::BRIDGES : 1; ///< Outputs per batch.
+
+        static constexpr float kFreeRpm = cfg::encoder::MAX_RPM * 1.25f; ///< 100 % duty, no load.
+        static constexpr float kTauDriveS = 0.15f;                       ///< Driven / slow-decay time constant.
+        static constexpr float kTauBrakeS = 0.05f;                       ///< Shorted-winding time constant.
+        static constexpr float kTauCoastS = 0.60f;                       ///< Free-wheel time constant.
+
+        bool begin() noexcept;
+        void drive(float pct, Dir dir) noexcept;
+        void setSpeedPercent(const std::array<float, kChannels> &pct, Dir dir) noexcept;
+        void coast() noexcept;
+        void brake() noexcept;
+        void end() noexcept { coast(); }
+
+        /// @brief Feed PCNT unit @p unit from this plant.
+        void attach(int unit) noexcept { pcntSource(unit, &Motor::edgesOf, this); }
+
+        /// @brief Set the load (0 → none, 1 → stalled).
+        void load(float fraction) noexcept;
+
+        [[nodiscard]] float rpm() noexcept;                                  ///< Shaft speed now (signed).
+        [[nodiscard]] int64_t edges() noexcept;                              ///< Encoder edges since begin() (signed).
+        [[nodiscard]] float duty() const noexcept { return duty_; }          ///< Last applied duty (signed %).
+        [[nodiscard]] uint64_t commands() const noexcept { return cmds_; }   ///< Backend calls.
+        [[nodiscard]] uint32_t hardFlips() const noexcept { return flips_; } ///< Unsequenced reversals.
+        [[nodiscard]] uint32_t brakes() const noexcept { return brakes_; }   ///< brake() calls.
+        [[nodiscard]] float peakRpm() const noexcept { return peak_rpm_; }   ///< Highest |rpm| seen.
+
+    private:
+        enum class Mode : uint8_t
+        {
+            Coast = 0, ///< Every switch off.
+            Drive,     ///< PWM on one leg.
+            Brake      ///< Both low sides on.
+        };
+
+        /// @brief Integrate the plant up to now_us().
+        void advance() noexcept;
+
+        static int64_t edgesOf(void *self) { return static_cast<Motor *>(self)->edges(); }
+
+    private:
+        Mode mode_{Mode::Coast}; ///< Bridge state.
+        float duty_{0.0f};       ///< Signed duty (%).
+        float rpm_{0.0f};        ///< Signed speed.
+        float load_{0.0f};       ///< Load fraction.
+        double turns_{0.0};      ///< Signed revolutions.
+        uint64_t last_us_{0};    ///< Plant time.
+        uint64_t cmds_{0};       ///< Backend calls.
+        uint32_t flips_{0};      ///< Unsequenced reversals.
+        uint32_t brakes_{0};     ///< brake() calls.
+        float peak_rpm_{0.0f};   ///< Highest |rpm|.
+        int8_t leg_{0};          ///< Last driven leg (+1 / −1; 0 → released since).
+    };
+
+    // ---- Buttons ---- //
+
+    /**
+     * @brief PortButtons reader over simulated GPIO levels (the GpioPortReader of the host build).
+     *
+     * With PortButtons<N, PinReader> this is the mock IButtonHandler: a
+     * scenario flips pins with gpioSet(), which drives both the polled levels
+     * and StateManager's edge ISRs.
+     */
+    class PinReader
+    {
+    public:
+        static constexpr std::size_t kMaxInputs = 64; ///< Inputs per reader.
+
+        /**
+         * @brief Bind @p n pins, idle high (pull-ups, active-low buttons).
+         *
+         * @param pins GPIO numbers in button order (copied).
+         * @param n Pin count (≤ kMaxInputs).
+         */
+        void begin(const uint8_t *pins, std::size_t n) noexcept;
+
+        /// @brief Level of every input (bit i = pin i high).
+        [[nodiscard]] uint64_t read() const noexcept;
+
+    private:
+        std::array<uint8_t, kMaxInputs> pins_{}; ///< GPIO per input.
+        std::size_t n_{0};                       ///< Inputs.
+    };
+
+    // ---- Receiver ---- //
+
+    /**
+     * @brief Scripted RC transmitter: encodes the stick table as cfg::rc::PROTOCOL frames into Serial2.
+     *
+     * A task sends one frame per kFrameUs (iBUS 7 ms, SBUS 14 ms, CRSF 4 ms),
+     * each as one inject() burst, so RcPublisher sees the same one-callback-
+     * per-frame pattern as the UART RX timeout gives on the target. drop()
+     * stops transmitting (link loss); failsafe() keeps sending SBUS frames
+     * with the receiver failsafe flag set (other protocols: same as drop()).
+     */
+    class RcTransmitter
+    {
+    public:
+        static constexpr std::size_t kChannels = 16; ///< Channels sent (iBUS: first 14).
+        static constexpr uint32_t kFrameUs =
+            (cfg::rc::PROTOCOL == cfg::rc::Protocol::Sbus) ? 14000U
+                                                           : ((cfg::rc::PROTOCOL == cfg::rc::Protocol::Crsf) ? 4000U : 7000U);
+
+        /// @brief All channels centred (1500 µs).
+        RcTransmitter() noexcept { us_.fill(1500); }
+
+        /**
+         * @brief Start the transmit task.
+         *
+         * @param priority Task priority (above the receiver's, as the UART hardware is).
+         */
+        void start(unsigned priority) noexcept;
+
+        /// @brief Set channel @p ch to @p us (988..2012).
+        void set(std::size_t ch, uint16_t us) noexcept { us_[ch] = us; }
+
+        /// @brief Channel @p ch.
+        [[nodiscard]] uint16_t get(std::size_t ch) const noexcept { return us_[ch]; }
+
+        /// @brief Stop (true) or resume (false) transmitting.
+        void drop(bool on) noexcept { drop_ = on; }
+
+        /// @brief Receiver failsafe flag (SBUS) / stop sending (iBUS, CRSF).
+        void failsafe(bool on) noexcept { fs_ = on; }
+
+        /// @brief Frames sent.
+        [[nodiscard]] uint64_t frames() const noexcept { return frames_; }
+
+    private:
+        /// @brief Transmit task entry.
+        static void task(void *self);
+
+        /// @brief Encode the current table; returns the frame length.
+        std::size_t encode(uint8_t *out) const noexcept;
+
+    private:
+        std::array<uint16_t, kChannels> us_{}; ///< Stick table (µs).
+        bool drop_{false};                     ///< Not transmitting.
+        bool fs_{false};                       ///< Failsafe flag.
+        uint64_t frames_{0};                   ///< Frames sent.
+    };
+} ///< Namespace sim.
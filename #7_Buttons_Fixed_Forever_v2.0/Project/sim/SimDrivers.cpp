@@ -0,0 +1,320 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the host GPTimer and PCNT shims.
+ *
+ * @file SimDrivers.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include <driver/pcnt.h>
+#include <driver/timer.h>
+#include <SimDevices.h>
+#include <SimKernel.h>
+#include <array>
+
+namespace
+{
+    // ---- GPTimer ---- //
+
+    /// @brief One timer.
+    struct Timer
+    {
+        bool init{false};         ///< timer_init() ran.
+        timer_config_t cfg{};     ///< Configuration.
+        uint64_t alarm{0};        ///< Alarm value (timer ticks).
+        timer_isr_t isr{nullptr}; ///< Alarm callback.
+        void *arg{nullptr};       ///< Callback argument.
+        int id{-1};               ///< Kernel alarm (-1 → stopped).
+    };
+
+    std::array<std::array<Timer, TIMER_MAX>, TIMER_GROUP_MAX> s_timers{}; ///< Both groups.
+
+    /// @brief Timer slot, or nullptr when out of range.
+    Timer *timerAt(timer_group_t g, timer_idx_t i) noexcept
+    {
+        return (g >= 0 && g < TIMER_GROUP_MAX && i >= 0 && i < TIMER_MAX) ? &s_timers[g][i] : nullptr;
+    }
+
+    /// @brief Kernel alarm → the registered callback (the "yield" result is moot: the kernel dispatches by priority).
+    void onAlarm(void *slot)
+    {
+        Timer *t = static_cast<Timer *>(slot);
+        if (t->isr != nullptr)
+            (void)t->isr(t->arg);
+    }
+
+    // ---- PCNT ---- //
+
+    /// @brief One counter unit.
+    struct Unit
+    {
+        bool init{false};             ///< pcnt_unit_config() ran.
+        bool running{false};          ///< Counting.
+        int16_t count{0};             ///< Counter.
+        int16_t h_lim{INT16_MAX};     ///< Wrap high.
+        int16_t l_lim{INT16_MIN};     ///< Wrap low.
+        uint32_t events{0};           ///< Enabled events.
+        uint32_t status{0};           ///< Last event.
+        void (*isr)(void *){nullptr}; ///< Limit handler.
+        void *arg{nullptr};           ///< Handler argument.
+        sim::EdgeSource src{nullptr}; ///< Edge source.
+        void *src_arg{nullptr};       ///< Source argument.
+        int64_t seen{0};              ///< Source total at the last sync.
+    };
+
+    std::array<Unit, PCNT_UNIT_MAX> s_units{}; ///< Every unit.
+    bool s_service{false};                     ///< pcnt_isr_service_install() ran.
+
+    /// @brief Unit slot, or nullptr when out of range.
+    Unit *unitAt(pcnt_unit_t u) noexcept { return (u >= 0 && u < PCNT_UNIT_MAX) ? &s_units[u] : nullptr; }
+
+    /// @brief Pull new edges from the source; each limit crossing resets the counter and runs the handler.
+    void sync(Unit &u) noexcept
+    {
+        if (u.src == nullptr)
+            return;
+        const int64_t total = u.src(u.src_arg);
+        int64_t d = total - u.seen;
+        u.seen = total;
+        if (!u.running)
+            return; ///< Paused: edges are lost, as on the hardware.
+
+        while (d != 0)
+        {
+            const bool up = d > 0;
+            const int64_t room = up ? (u.h_lim - u.count) : (u.count - u.l_lim);
+            const int64_t step = up ? d : -d;
+            if (step < room)
+            {
+                u.count = static_cast<int16_t>(u.count + d);
+                return;
+            }
+            d += up ? -room : room;
+            u.count = 0;
+            u.status = up ? PCNT_EVT_H_LIM : PCNT_EVT_L_LIM;
+            if ((u.events & u.status) != 0 && u.isr != nullptr)
+                u.isr(u.arg); ///< Before the caller sees the reset count, as the ISR would be.
+        }
+    }
+} // namespace
+
+// ---- GPTimer ---- //
+
+// Configure a timer.
+esp_err_t timer_init(timer_group_t group, timer_idx_t idx, const timer_config_t *config)
+{
+    Timer *t = timerAt(group, idx);
+    if (t == nullptr || config == nullptr || config->divider < 2)
+        return ESP_ERR_INVALID_ARG;
+    t->cfg = *config;
+    t->init = true;
+    return ESP_OK;
+}
+
+// Counter value (the kernel alarm starts each period at 0).
+esp_err_t timer_set_counter_value(timer_group_t group, timer_idx_t idx, uint64_t)
+{
+    return (timerAt(group, idx) != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+// Alarm value in timer ticks.
+esp_err_t timer_set_alarm_value(timer_group_t group, timer_idx_t idx, uint64_t value)
+{
+    Timer *t = timerAt(group, idx);
+    if (t == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    t->alarm = value;
+    return ESP_OK;
+}
+
+// Interrupt enable (implied by a callback).
+esp_err_t timer_enable_intr(timer_group_t group, timer_idx_t idx)
+{
+    return (timerAt(group, idx) != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+// Register the alarm callback.
+esp_err_t timer_isr_callback_add(timer_group_t group, timer_idx_t idx, timer_isr_t isr, void *arg, int)
+{
+    Timer *t = timerAt(group, idx);
+    if (t == nullptr || !t->init)
+        return ESP_ERR_INVALID_STATE;
+    t->isr = isr;
+    t->arg = arg;
+    return ESP_OK;
+}
+
+// Drop the alarm callback.
+esp_err_t timer_isr_callback_remove(timer_group_t group, timer_idx_t idx)
+{
+    Timer *t = timerAt(group, idx);
+    if (t == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    t->isr = nullptr;
+    return ESP_OK;
+}
+
+// Start: an auto-reload alarm becomes a periodic kernel alarm (one-shot alarms are not modelled).
+esp_err_t timer_start(timer_group_t group, timer_idx_t idx)
+{
+    Timer *t = timerAt(group, idx);
+    if (t == nullptr || !t->init)
+        return ESP_ERR_INVALID_STATE;
+    if (t->id >= 0)
+        return ESP_OK;
+    if (t->cfg.alarm_en != TIMER_ALARM_EN)
+        return ESP_OK; ///< Free-running counter with no events.
+    if (t->cfg.auto_reload != TIMER_AUTORELOAD_EN || t->alarm == 0)
+        return ESP_ERR_NOT_SUPPORTED;
+
+    const uint64_t period_us = (t->alarm * t->cfg.divider) / 80U; ///< 80 MHz APB.
+    t->id = sim::alarm(static_cast<uint32_t>(period_us > 0 ? period_us : 1), &onAlarm, t);
+    return (t->id >= 0) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+// Stop.
+esp_err_t timer_pause(timer_group_t group, timer_idx_t idx)
+{
+    Timer *t = timerAt(group, idx);
+    if (t == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    sim::cancel(t->id);
+    t->id = -1;
+    return ESP_OK;
+}
+
+// Stop and forget.
+esp_err_t timer_deinit(timer_group_t group, timer_idx_t idx)
+{
+    const esp_err_t err = timer_pause(group, idx);
+    if (err == ESP_OK)
+        *timerAt(group, idx) = Timer{};
+    return err;
+}
+
+// ---- PCNT ---- //
+
+// Attach an edge source.
+void sim::pcntSource(int unit, EdgeSource src, void *arg) noexcept
+{
+    Unit *u = unitAt(static_cast<pcnt_unit_t>(unit));
+    if (u == nullptr)
+        return;
+    u->src = src;
+    u->src_arg = arg;
+    u->seen = (src != nullptr) ? src(arg) : 0;
+}
+
+// Configure a unit (paused until resumed).
+esp_err_t pcnt_unit_config(const pcnt_config_t *config)
+{
+    Unit *u = (config != nullptr) ? unitAt(config->unit) : nullptr;
+    if (u == nullptr || config->counter_h_lim <= 0 || config->counter_l_lim >= 0)
+        return ESP_ERR_INVALID_ARG;
+    u->h_lim = config->counter_h_lim;
+    u->l_lim = config->counter_l_lim;
+    u->count = 0;
+    u->init = true;
+    return ESP_OK;
+}
+
+// Glitch filter (edges come from a model: nothing to filter).
+esp_err_t pcnt_set_filter_value(pcnt_unit_t unit, uint16_t) { return (unitAt(unit) != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG; }
+esp_err_t pcnt_filter_enable(pcnt_unit_t unit) { return (unitAt(unit) != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG; }
+
+// Enable an event.
+esp_err_t pcnt_event_enable(pcnt_unit_t unit, pcnt_evt_type_t evt)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    u->events |= static_cast<uint32_t>(evt);
+    return ESP_OK;
+}
+
+// Pause counting.
+esp_err_t pcnt_counter_pause(pcnt_unit_t unit)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    sync(*u);
+    u->running = false;
+    return ESP_OK;
+}
+
+// Resume counting.
+esp_err_t pcnt_counter_resume(pcnt_unit_t unit)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr || !u->init)
+        return ESP_ERR_INVALID_STATE;
+    sync(*u); ///< Drop edges from while paused.
+    u->running = true;
+    return ESP_OK;
+}
+
+// Zero the counter.
+esp_err_t pcnt_counter_clear(pcnt_unit_t unit)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    sync(*u);
+    u->count = 0;
+    return ESP_OK;
+}
+
+// Current count.
+esp_err_t pcnt_get_counter_value(pcnt_unit_t unit, int16_t *count)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr || count == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    sync(*u);
+    *count = u->count;
+    return ESP_OK;
+}
+
+// Last event.
+esp_err_t pcnt_get_event_status(pcnt_unit_t unit, uint32_t *status)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr || status == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    *status = u->status;
+    return ESP_OK;
+}
+
+// Shared ISR service (second install → ESP_ERR_INVALID_STATE, as in IDF).
+esp_err_t pcnt_isr_service_install(int)
+{
+    if (s_service)
+        return ESP_ERR_INVALID_STATE;
+    s_service = true;
+    return ESP_OK;
+}
+
+// Per-unit limit handler.
+esp_err_t pcnt_isr_handler_add(pcnt_unit_t unit, void (*isr)(void *), void *arg)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr || !s_service)
+        return ESP_ERR_INVALID_STATE;
+    u->isr = isr;
+    u->arg = arg;
+    return ESP_OK;
+}
+
+// Drop the handler.
+esp_err_t pcnt_isr_handler_remove(pcnt_unit_t unit)
+{
+    Unit *u = unitAt(unit);
+    if (u == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    u->isr = nullptr;
+    return ESP_OK;
+}
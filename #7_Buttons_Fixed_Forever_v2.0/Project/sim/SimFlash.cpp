@@ -0,0 +1,165 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the host partition shim (image files held in RAM, NOR write / erase rules).
+ *
+ * @file SimFlash.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include <esp_partition.h>
+#include <SimDevices.h>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t kSector = 4096;  ///< Erase granularity.
+    constexpr uint32_t kBlock = 65536;  ///< Image sizes round up to this.
+    constexpr std::size_t kImages = 4;  ///< Registered partitions.
+
+    /// @brief One partition image.
+    struct Image
+    {
+        esp_partition_t part{};    ///< Table entry handed to callers.
+        std::string path;          ///< Backing file.
+        std::vector<uint8_t> data; ///< Contents.
+        bool dirty{false};         ///< Written / erased since loading.
+    };
+
+    std::array<Image, kImages> s_images{}; ///< Registered partitions.
+    std::size_t s_count = 0;               ///< Used entries.
+
+    /// @brief Image behind @p part, or nullptr for a pointer this shim never handed out.
+    Image *imageOf(const esp_partition_t *part) noexcept
+    {
+        for (std::size_t i = 0; i < s_count; ++i)
+            if (&s_images[i].part == part)
+                return &s_images[i];
+        return nullptr;
+    }
+
+    /// @brief True if [offset, offset + size) lies inside @p img.
+    bool inside(const Image &img, size_t offset, size_t size) noexcept
+    {
+        return offset <= img.data.size() && size <= img.data.size() - offset;
+    }
+} // namespace
+
+// Register a partition image.
+bool sim::partitionImage(const char *label, const char *path, uint32_t size) noexcept
+{
+    if (s_count >= kImages || esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label) != nullptr)
+        return false;
+
+    std::vector<uint8_t> bytes;
+    if (FILE *f = std::fopen(path, "rb"))
+    {
+        uint8_t buf[kSector];
+        for (size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;)
+            bytes.insert(bytes.end(), buf, buf + n);
+        std::fclose(f);
+    }
+    if (size == 0)
+        size = static_cast<uint32_t>((bytes.size() + kBlock - 1) / kBlock * kBlock);
+    if (size == 0)
+        return false;
+    bytes.resize(size, 0xFF); ///< Past the end of the file → erased.
+
+    Image &img = s_images[s_count++];
+    img.part.type = ESP_PARTITION_TYPE_DATA;
+    img.part.subtype = ESP_PARTITION_SUBTYPE_ANY;
+    img.part.size = size;
+    std::snprintf(img.part.label, sizeof(img.part.label), "%s", label);
+    img.path = path;
+    img.data = std::move(bytes);
+    return true;
+}
+
+// Write dirty images back.
+bool sim::partitionSave() noexcept
+{
+    bool ok = true;
+    for (std::size_t i = 0; i < s_count; ++i)
+    {
+        Image &img = s_images[i];
+        if (!img.dirty)
+            continue;
+        FILE *f = std::fopen(img.path.c_str(), "wb");
+        ok = f != nullptr && std::fwrite(img.data.data(), 1, img.data.size(), f) == img.data.size() && ok;
+        if (f != nullptr)
+            ok = std::fclose(f) == 0 && ok;
+        img.dirty = false;
+    }
+    return ok;
+}
+
+// ---- esp_partition.h ---- //
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label)
+{
+    (void)subtype;
+    for (std::size_t i = 0; i < s_count; ++i)
+        if (s_images[i].part.type == type && (label == nullptr || std::strcmp(s_images[i].part.label, label) == 0))
+            return &s_images[i].part;
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size)
+{
+    const Image *img = imageOf(part);
+    if (img == nullptr || dst == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    if (!inside(*img, offset, size))
+        return ESP_ERR_INVALID_SIZE;
+    std::memcpy(dst, img->data.data() + offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size)
+{
+    Image *img = imageOf(part);
+    if (img == nullptr || src == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    if (!inside(*img, offset, size))
+        return ESP_ERR_INVALID_SIZE;
+    const auto *in = static_cast<const uint8_t *>(src);
+    for (size_t i = 0; i < size; ++i)
+        img->data[offset + i] &= in[i]; ///< NOR flash: programming only clears bits.
+    img->dirty = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size)
+{
+    Image *img = imageOf(part);
+    if (img == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    if (offset % kSector != 0 || size % kSector != 0)
+        return ESP_ERR_INVALID_ARG;
+    if (!inside(*img, offset, size))
+        return ESP_ERR_INVALID_SIZE;
+    std::memset(img->data.data() + offset, 0xFF, size);
+    img->dirty = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *part, size_t offset, size_t size, esp_partition_mmap_memory_t memory,
+                             const void **out, esp_partition_mmap_handle_t *handle)
+{
+    (void)memory;
+    const Image *img = imageOf(part);
+    if (img == nullptr || out == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    if (!inside(*img, offset, size))
+        return ESP_ERR_INVALID_SIZE;
+    *out = img->data.data() + offset;
+    if (handle != nullptr)
+        *handle = 0;
+    return ESP_OK;
+}
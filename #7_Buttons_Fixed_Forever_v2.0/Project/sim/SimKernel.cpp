@@ -0,0 +1,423 @@
+/**
+ * MIT License
+ *
+ * @brief Implementation of the host simulation kernel (one task at a time on a virtual clock).
+ *
+ * @file SimKernel.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include "SimKernel.h"
+#include <array>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Simulated task.
+struct tskTaskControlBlock
+{
+    const char *name{""};                ///< Task name.
+    unsigned priority{0};                ///< Priority.
+    sim::Entry entry{nullptr};           ///< Task function.
+    void *arg{nullptr};                  ///< Task parameter.
+    sim::State state{sim::State::Ready}; ///< Scheduler state.
+    int64_t seq{0};                      ///< Ready order within a priority (lower first).
+    bool yielding{false};                ///< Let every other ready task go first.
+    uint64_t wake_us{sim::kForever};     ///< Timeout of the current block.
+    bool waiting{false};                 ///< Blocked on a notification.
+    bool notified{false};                ///< Notification pending.
+    uint32_t value{0};                   ///< Notification value.
+    std::condition_variable cv;          ///< Dispatch signal.
+};
+
+namespace
+{
+    constexpr std::size_t kMaxAlarms = 8; ///< Hardware timer models.
+
+    /// @brief Periodic alarm.
+    struct Alarm
+    {
+        bool active{false};     ///< Armed.
+        uint32_t period_us{0};  ///< Period.
+        uint64_t next_us{0};    ///< Next expiry.
+        sim::Entry fn{nullptr}; ///< Callback (ISR context).
+        void *arg{nullptr};     ///< Callback argument.
+    };
+
+    /// @brief Scheduler state (leaked on purpose: parked task threads still reference it at exit).
+    struct Kernel
+    {
+        std::mutex m;                         ///< Guards everything below.
+        std::condition_variable done;         ///< run() wakes when the window has elapsed.
+        bool finished{true};                  ///< No run() window open.
+        uint64_t end_us{0};                   ///< End of the current run() window.
+        std::vector<sim::Handle> tasks;       ///< Every task, creation order.
+        sim::Handle current{nullptr};         ///< Task holding the CPU.
+        uint64_t now_us{0};                   ///< Virtual time.
+        int64_t order{0};                     ///< Ready-queue sequence.
+        int64_t front{0};                     ///< Preempted tasks go ahead of their priority.
+        std::array<Alarm, kMaxAlarms> alarms; ///< Timer models.
+        sim::Counters counters;               ///< Benchmark counters.
+    };
+
+    Kernel &k() noexcept
+    {
+        static Kernel *kernel = new Kernel(); ///< Never destroyed.
+        return *kernel;
+    }
+
+    thread_local sim::Handle me = nullptr; ///< Task owning this thread.
+    thread_local bool in_isr = false;      ///< Inside an alarm callback.
+
+    /// @brief Mark @p t ready at the back of its priority.
+    void makeReady(sim::Handle t) noexcept
+    {
+        t->state = sim::State::Ready;
+        t->seq = ++k().order;
+        t->wake_us = sim::kForever;
+        t->waiting = false;
+    }
+
+    /// @brief Highest-priority ready task, FIFO; yielding tasks only when nothing else is ready.
+    sim::Handle pick() noexcept
+    {
+        sim::Handle best = nullptr;
+        sim::Handle yielded = nullptr;
+        for (sim::Handle t : k().tasks)
+        {
+            if (t->state != sim::State::Ready)
+                continue;
+            sim::Handle &slot = t->yielding ? yielded : best;
+            if (slot == nullptr || t->priority > slot->priority || (t->priority == slot->priority && t->seq < slot->seq))
+                slot = t;
+        }
+        sim::Handle t = (best != nullptr) ? best : yielded;
+        if (t != nullptr)
+            t->yielding = false;
+        return t;
+    }
+
+    /// @brief Earliest timed wakeup or alarm (lock held).
+    uint64_t nextEvent() noexcept
+    {
+        uint64_t next = sim::kForever;
+        for (sim::Handle t : k().tasks)
+            if (t->state == sim::State::Blocked && t->wake_us < next)
+                next = t->wake_us;
+        for (const Alarm &a : k().alarms)
+            if (a.active && a.next_us < next)
+                next = a.next_us;
+        return next;
+    }
+
+    /**
+     * @brief Pick and dispatch the next task, advancing the clock through idle time (lock held).
+     *
+     * Runs on whichever thread gives up the CPU, so handing over costs one
+     * thread switch, and none when the same task is next (a periodic loop
+     * waking itself). Alarm callbacks run here too, with the lock released.
+     * Returns once some task holds the CPU (possibly the caller) or the run()
+     * window has ended.
+     */
+    void reschedule(std::unique_lock<std::mutex> &lk) noexcept
+    {
+        k().current = nullptr;
+        for (;;)
+        {
+            if (sim::Handle t = pick())
+            {
+                t->state = sim::State::Running;
+                k().current = t;
+                ++k().counters.switches;
+                if (t != me)
+                    t->cv.notify_one();
+                return;
+            }
+
+            // Nothing ready: jump to the next event.
+            const uint64_t next = nextEvent();
+            if (next == sim::kForever || next > k().end_us)
+            {
+                k().now_us = (k().end_us > k().now_us) ? k().end_us : k().now_us;
+                k().finished = true;
+                k().done.notify_one();
+                return;
+            }
+            if (next > k().now_us)
+            {
+                k().now_us = next;
+                ++k().counters.jumps;
+            }
+
+            // Alarms first (one call per expired period, so a late task sees every missed one).
+            for (Alarm &a : k().alarms)
+            {
+                while (a.active && a.next_us <= k().now_us)
+                {
+                    a.next_us += a.period_us;
+                    ++k().counters.alarms;
+                    const sim::Entry fn = a.fn;
+                    void *arg = a.arg;
+                    lk.unlock(); ///< No task runs meanwhile; the callback's notify() takes the lock itself.
+                    in_isr = true;
+                    fn(arg);
+                    in_isr = false;
+                    lk.lock();
+                }
+            }
+            for (sim::Handle t : k().tasks)
+                if (t->state == sim::State::Blocked && t->wake_us <= k().now_us)
+                    makeReady(t); ///< Timed out.
+        }
+    }
+
+    /// @brief Give up the CPU and wait to be dispatched again (lock held; the caller has set its state).
+    void switchOut(std::unique_lock<std::mutex> &lk) noexcept
+    {
+        sim::Handle t = me;
+        reschedule(lk);
+        t->cv.wait(lk, [t] { return k().current == t; });
+    }
+
+    /// @brief Block the caller on a notification for up to @p timeout_us (lock held).
+    void blockOnNotify(std::unique_lock<std::mutex> &lk, uint64_t timeout_us) noexcept
+    {
+        me->waiting = true;
+        me->wake_us = (timeout_us == sim::kForever) ? sim::kForever : k().now_us + timeout_us;
+        me->state = (timeout_us == sim::kForever) ? sim::State::Suspended : sim::State::Blocked;
+        switchOut(lk);
+        me->waiting = false;
+    }
+
+    /// @brief Step aside if a higher-priority task became ready (lock held; task context only).
+    void preempt(std::unique_lock<std::mutex> &lk) noexcept
+    {
+        if (me == nullptr || in_isr)
+            return;
+        for (sim::Handle t : k().tasks)
+        {
+            if (t->state == sim::State::Ready && t->priority > me->priority)
+            {
+                me->state = sim::State::Ready;
+                me->seq = --k().front; ///< Resumes ahead of its peers, as a preempted FreeRTOS task does.
+                switchOut(lk);
+                return;
+            }
+        }
+    }
+} // namespace
+
+namespace sim
+{
+    // Virtual time.
+    uint64_t now_us() noexcept
+    {
+        std::lock_guard<std::mutex> lk(k().m);
+        return k().now_us;
+    }
+
+    // Create a task.
+    Handle spawn(Entry entry, void *arg, const char *name, unsigned priority) noexcept
+    {
+        Handle t = new tskTaskControlBlock();
+        t->name = name;
+        t->priority = priority;
+        t->entry = entry;
+        t->arg = arg;
+
+        std::unique_lock<std::mutex> lk(k().m);
+        makeReady(t);
+        k().tasks.push_back(t);
+
+        std::thread([t]
+                    {
+                        std::unique_lock<std::mutex> tl(k().m);
+                        t->cv.wait(tl, [t] { return k().current == t; });
+                        me = t;
+                        tl.unlock();
+                        t->entry(t->arg);
+                        sim::exit(); ///< Entries normally never return.
+                    })
+            .detach();
+
+        preempt(lk);
+        return t;
+    }
+
+    // Calling task.
+    Handle self() noexcept { return me; }
+
+    // Block until wake_us.
+    void sleepUntil(uint64_t wake_us) noexcept
+    {
+        assert(me != nullptr && !in_isr);
+        std::unique_lock<std::mutex> lk(k().m);
+        if (wake_us <= k().now_us)
+            return;
+        me->state = State::Blocked;
+        me->wake_us = wake_us;
+        switchOut(lk);
+    }
+
+    // Let every other ready task run first.
+    void yield() noexcept
+    {
+        if (me == nullptr || in_isr)
+            return;
+        std::unique_lock<std::mutex> lk(k().m);
+        me->state = State::Ready;
+        me->seq = ++k().order;
+        me->yielding = true;
+        switchOut(lk);
+    }
+
+    // Hold the CPU for us of virtual time.
+    void spend(uint32_t us) noexcept
+    {
+        std::lock_guard<std::mutex> lk(k().m);
+        k().now_us += us; ///< Alarms and timeouts that fall due meanwhile fire once the task blocks.
+    }
+
+    // ulTaskNotifyTake().
+    uint32_t take(bool clear, uint64_t timeout_us) noexcept
+    {
+        assert(me != nullptr && !in_isr);
+        std::unique_lock<std::mutex> lk(k().m);
+        if (me->value == 0 && timeout_us > 0)
+            blockOnNotify(lk, timeout_us);
+        const uint32_t v = me->value;
+        if (v != 0)
+            me->value = clear ? 0 : v - 1;
+        me->notified = false;
+        return v;
+    }
+
+    // xTaskNotifyWait().
+    bool wait(uint32_t clear_entry, uint32_t clear_exit, uint32_t *value, uint64_t timeout_us) noexcept
+    {
+        assert(me != nullptr && !in_isr);
+        std::unique_lock<std::mutex> lk(k().m);
+        if (!me->notified)
+        {
+            me->value &= ~clear_entry;
+            if (timeout_us > 0)
+                blockOnNotify(lk, timeout_us);
+        }
+        if (value != nullptr)
+            *value = me->value;
+        const bool got = me->notified;
+        if (got)
+            me->value &= ~clear_exit;
+        me->notified = false;
+        return got;
+    }
+
+    // xTaskNotify().
+    bool notify(Handle t, uint32_t value, Action action) noexcept
+    {
+        if (t == nullptr)
+            return false;
+        std::unique_lock<std::mutex> lk(k().m);
+        switch (action)
+        {
+        case Action::SetBits:
+            t->value |= value;
+            break;
+        case Action::Increment:
+            ++t->value;
+            break;
+        case Action::Overwrite:
+            t->value = value;
+            break;
+        case Action::NoOverwrite:
+            if (t->notified)
+                return false;
+            t->value = value;
+            break;
+        case Action::None:
+        default:
+            break;
+        }
+        t->notified = true;
+
+        if (t->waiting)
+        {
+            makeReady(t);
+            preempt(lk);
+        }
+        return true;
+    }
+
+    // End the calling task.
+    void exit() noexcept
+    {
+        assert(me != nullptr);
+        std::unique_lock<std::mutex> lk(k().m);
+        me->state = State::Deleted;
+        reschedule(lk);
+        for (;;)
+            me->cv.wait(lk); ///< Never dispatched again.
+    }
+
+    // True inside an alarm callback.
+    bool inIsr() noexcept { return in_isr; }
+
+    // Task state.
+    State state(Handle t) noexcept
+    {
+        std::lock_guard<std::mutex> lk(k().m);
+        return t->state;
+    }
+
+    // Task priority.
+    unsigned priority(Handle t) noexcept { return (t != nullptr) ? t->priority : 0; }
+
+    // Task name.
+    const char *name(Handle t) noexcept { return (t != nullptr) ? t->name : ""; }
+
+    // Start a periodic alarm.
+    int alarm(uint32_t period_us, Entry fn, void *arg) noexcept
+    {
+        assert(period_us > 0 && fn != nullptr);
+        std::lock_guard<std::mutex> lk(k().m);
+        for (std::size_t i = 0; i < kMaxAlarms; ++i)
+        {
+            Alarm &a = k().alarms[i];
+            if (a.active)
+                continue;
+            a = Alarm{true, period_us, k().now_us + period_us, fn, arg};
+            return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    // Stop an alarm.
+    void cancel(int id) noexcept
+    {
+        std::lock_guard<std::mutex> lk(k().m);
+        if (id >= 0 && static_cast<std::size_t>(id) < kMaxAlarms)
+            k().alarms[static_cast<std::size_t>(id)].active = false;
+    }
+
+    // Run the scheduler for duration_us.
+    void run(uint64_t duration_us) noexcept
+    {
+        assert(me == nullptr);
+        std::unique_lock<std::mutex> lk(k().m);
+        k().end_us = k().now_us + duration_us;
+        k().finished = false;
+        reschedule(lk); ///< Tasks hand the CPU to each other from here on.
+        k().done.wait(lk, [] { return k().finished; });
+    }
+
+    // Scheduler counters.
+    Counters counters() noexcept
+    {
+        std::lock_guard<std::mutex> lk(k().m);
+        return k().counters;
+    }
+} ///< Namespace sim.
@@ -0,0 +1,166 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation kernel: FreeRTOS-style tasks on std::thread, run one at a time on a virtual clock.
+ *
+ * @file SimKernel.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct tskTaskControlBlock; ///< Simulated task (FreeRTOS's opaque handle type).
+
+/**
+ * @brief Discrete-event scheduler behind the sim/ FreeRTOS, Arduino and IDF shims.
+ *
+ * Every task is a std::thread, but only one holds the CPU at a time: a task
+ * runs until it blocks (delay, notification wait) or yields, then picks the
+ * next task itself and hands the CPU over (no thread switch at all when it is
+ * next again). When nothing is ready, the clock jumps straight to the
+ * earliest wakeup, so idle time costs nothing and a 1 kHz loop runs as fast
+ * as its own code does. Tasks ready at the same instant run highest priority first,
+ * FIFO within a priority; a notification that readies a higher-priority task
+ * preempts the sender, as on the target.
+ *
+ * Code takes no virtual time: a task's work happens at one instant unless it
+ * calls spend() (delayMicroseconds() does). Alarms model hardware timers;
+ * their callbacks run between tasks with inIsr() true.
+ *
+ * One core, cooperative: this is for throughput, ordering and control-law
+ * results, not for cache / cross-core timing (run those on the target).
+ */
+namespace sim
+{
+    using Entry = void (*)(void *);       ///< Task / alarm entry.
+    using Handle = tskTaskControlBlock *; ///< Task handle.
+
+    constexpr uint64_t kForever = UINT64_MAX; ///< Block with no timeout.
+
+    /// @brief Task state as eTaskGetState() reports it.
+    enum class State : uint8_t
+    {
+        Ready = 0, ///< Runnable.
+        Running,   ///< Holds the CPU.
+        Blocked,   ///< Waiting with a timeout.
+        Suspended, ///< Waiting with no timeout.
+        Deleted    ///< Returned / deleted.
+    };
+
+    /// @brief xTaskNotify() actions.
+    enum class Action : uint8_t
+    {
+        None = 0,   ///< Only mark notified.
+        SetBits,    ///< value |= bits.
+        Increment,  ///< ++value.
+        Overwrite,  ///< value = v.
+        NoOverwrite ///< value = v unless already notified.
+    };
+
+    /// @brief Scheduler counters (benchmark output).
+    struct Counters
+    {
+        uint64_t switches{0}; ///< Tasks dispatched.
+        uint64_t alarms{0};   ///< Alarm callbacks fired.
+        uint64_t jumps{0};    ///< Idle clock advances.
+    };
+
+    /// @brief Virtual time (µs since start).
+    [[nodiscard]] uint64_t now_us() noexcept;
+
+    /**
+     * @brief Create a task (ready at the current instant).
+     *
+     * @param entry Task function.
+     * @param arg Task parameter.
+     * @param name Task name (static storage).
+     * @param priority Priority (higher runs first).
+     * @return Handle New task.
+     */
+    Handle spawn(Entry entry, void *arg, const char *name, unsigned priority) noexcept;
+
+    /// @brief Calling task (nullptr on the scheduler / main thread).
+    [[nodiscard]] Handle self() noexcept;
+
+    /// @brief Block the calling task until @p wake_us (returns at once if it has passed).
+    void sleepUntil(uint64_t wake_us) noexcept;
+
+    /// @brief Let every other ready task run at this instant first.
+    void yield() noexcept;
+
+    /// @brief Hold the CPU for @p us of virtual time (busy-wait / modelled work).
+    void spend(uint32_t us) noexcept;
+
+    /**
+     * @brief ulTaskNotifyTake(): block until the notification count is non-zero.
+     *
+     * @param clear Zero the count (true) or decrement it.
+     * @param timeout_us Longest block (0 → poll, kForever → none).
+     * @return uint32_t Count before it was taken (0 → timed out).
+     */
+    uint32_t take(bool clear, uint64_t timeout_us) noexcept;
+
+    /**
+     * @brief xTaskNotifyWait(): block until notified.
+     *
+     * @param clear_entry Bits cleared on entry (when not already notified).
+     * @param clear_exit Bits cleared on a successful exit.
+     * @param value Receives the value (nullable).
+     * @param timeout_us Longest block (0 → poll, kForever → none).
+     * @return true If a notification was received.
+     */
+    bool wait(uint32_t clear_entry, uint32_t clear_exit, uint32_t *value, uint64_t timeout_us) noexcept;
+
+    /**
+     * @brief Notify a task (xTaskNotify(); Action::Increment = xTaskNotifyGive()).
+     *
+     * @param t Task to notify.
+     * @param value Bits / value for the action.
+     * @param action What to do to the value.
+     * @return false Only for NoOverwrite on a task already notified.
+     */
+    bool notify(Handle t, uint32_t value, Action action) noexcept;
+
+    /// @brief End the calling task (vTaskDelete(nullptr); does not return).
+    [[noreturn]] void exit() noexcept;
+
+    /// @brief True inside an alarm callback.
+    [[nodiscard]] bool inIsr() noexcept;
+
+    /// @brief Task state.
+    [[nodiscard]] State state(Handle t) noexcept;
+
+    /// @brief Task priority.
+    [[nodiscard]] unsigned priority(Handle t) noexcept;
+
+    /// @brief Task name.
+    [[nodiscard]] const char *name(Handle t) noexcept;
+
+    /**
+     * @brief Start a periodic alarm (hardware timer model).
+     *
+     * @param period_us Period (µs, > 0).
+     * @param fn Callback (ISR context).
+     * @param arg Callback argument.
+     * @return int Alarm id (-1 → table full).
+     */
+    int alarm(uint32_t period_us, Entry fn, void *arg) noexcept;
+
+    /// @brief Stop an alarm.
+    void cancel(int id) noexcept;
+
+    /**
+     * @brief Run the scheduler for @p duration_us of virtual time (main thread only).
+     *
+     * @param duration_us Virtual time to advance.
+     */
+    void run(uint64_t duration_us) noexcept;
+
+    /// @brief Scheduler counters.
+    [[nodiscard]] Counters counters() noexcept;
+} ///< Namespace sim.
@@ -0,0 +1,31 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: TwoWire with no devices on the bus (every transfer NACKs).
+ *
+ * @file Wire.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief I2C master with an empty bus.
+class TwoWire
+{
+public:
+    bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t) {}
+    size_t write(uint8_t) { return 1; }
+    uint8_t endTransmission(bool = true) { return 2; } ///< Address NACK.
+    uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+};
+
+inline TwoWire Wire; ///< Bus 0.
@@ -0,0 +1,32 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: GPIO interrupt-type / wake API (levels read through the Arduino shim; types ignored).
+ *
+ * @file gpio.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_err.h>
+
+typedef int gpio_num_t; ///< Pin number.
+
+typedef enum
+{
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL
+} gpio_int_type_t;
+
+inline int gpio_get_level(gpio_num_t pin) { return digitalRead(static_cast<uint8_t>(pin)); }
+inline esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return ESP_OK; }
+inline esp_err_t gpio_intr_enable(gpio_num_t) { return ESP_OK; }
+inline esp_err_t gpio_intr_disable(gpio_num_t) { return ESP_OK; }
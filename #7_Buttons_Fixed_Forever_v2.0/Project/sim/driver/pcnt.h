@@ -0,0 +1,83 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: legacy PCNT API; units count edges pulled from a sim::pcntSource() (e.g. sim::Motor).
+ *
+ * @file pcnt.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <esp_err.h>
+
+typedef enum
+{
+    PCNT_UNIT_0 = 0,
+    PCNT_UNIT_1,
+    PCNT_UNIT_2,
+    PCNT_UNIT_3,
+    PCNT_UNIT_MAX
+} pcnt_unit_t;
+
+typedef enum
+{
+    PCNT_CHANNEL_0 = 0,
+    PCNT_CHANNEL_1
+} pcnt_channel_t;
+
+typedef enum
+{
+    PCNT_MODE_KEEP = 0,
+    PCNT_MODE_REVERSE,
+    PCNT_MODE_DISABLE
+} pcnt_ctrl_mode_t;
+
+typedef enum
+{
+    PCNT_COUNT_DIS = 0,
+    PCNT_COUNT_INC,
+    PCNT_COUNT_DEC
+} pcnt_count_mode_t;
+
+typedef enum
+{
+    PCNT_EVT_THRES_1 = 1 << 2,
+    PCNT_EVT_THRES_0 = 1 << 3,
+    PCNT_EVT_L_LIM = 1 << 4,
+    PCNT_EVT_H_LIM = 1 << 5,
+    PCNT_EVT_ZERO = 1 << 6
+} pcnt_evt_type_t;
+
+#define PCNT_PIN_NOT_USED (-1)
+
+/// @brief Unit / channel configuration (limits and the pulse pin matter here).
+typedef struct
+{
+    int pulse_gpio_num;          ///< Pulse input.
+    int ctrl_gpio_num;           ///< Direction input.
+    pcnt_ctrl_mode_t lctrl_mode; ///< Control low.
+    pcnt_ctrl_mode_t hctrl_mode; ///< Control high.
+    pcnt_count_mode_t pos_mode;  ///< Rising edge.
+    pcnt_count_mode_t neg_mode;  ///< Falling edge.
+    int16_t counter_h_lim;       ///< Wrap high.
+    int16_t counter_l_lim;       ///< Wrap low.
+    pcnt_unit_t unit;            ///< Unit.
+    pcnt_channel_t channel;      ///< Channel.
+} pcnt_config_t;
+
+esp_err_t pcnt_unit_config(const pcnt_config_t *config);
+esp_err_t pcnt_set_filter_value(pcnt_unit_t unit, uint16_t value);
+esp_err_t pcnt_filter_enable(pcnt_unit_t unit);
+esp_err_t pcnt_event_enable(pcnt_unit_t unit, pcnt_evt_type_t evt);
+esp_err_t pcnt_counter_pause(pcnt_unit_t unit);
+esp_err_t pcnt_counter_resume(pcnt_unit_t unit);
+esp_err_t pcnt_counter_clear(pcnt_unit_t unit);
+esp_err_t pcnt_get_counter_value(pcnt_unit_t unit, int16_t *count);
+esp_err_t pcnt_get_event_status(pcnt_unit_t unit, uint32_t *status);
+esp_err_t pcnt_isr_service_install(int flags);
+esp_err_t pcnt_isr_handler_add(pcnt_unit_t unit, void (*isr)(void *), void *arg);
+esp_err_t pcnt_isr_handler_remove(pcnt_unit_t unit);
@@ -0,0 +1,82 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: legacy GPTimer API; a started alarm with auto-reload becomes a SimKernel alarm.
+ *
+ * @file timer.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <esp_err.h>
+#include <esp_intr_alloc.h>
+
+typedef enum
+{
+    TIMER_GROUP_0 = 0,
+    TIMER_GROUP_1,
+    TIMER_GROUP_MAX
+} timer_group_t;
+
+typedef enum
+{
+    TIMER_0 = 0,
+    TIMER_1,
+    TIMER_MAX
+} timer_idx_t;
+
+typedef enum
+{
+    TIMER_ALARM_DIS = 0,
+    TIMER_ALARM_EN
+} timer_alarm_t;
+
+typedef enum
+{
+    TIMER_PAUSE = 0,
+    TIMER_START
+} timer_start_t;
+
+typedef enum
+{
+    TIMER_INTR_LEVEL = 0
+} timer_intr_mode_t;
+
+typedef enum
+{
+    TIMER_COUNT_DOWN = 0,
+    TIMER_COUNT_UP
+} timer_count_dir_t;
+
+typedef enum
+{
+    TIMER_AUTORELOAD_DIS = 0,
+    TIMER_AUTORELOAD_EN
+} timer_autoreload_t;
+
+/// @brief Timer configuration (only divider, alarm and auto-reload matter here).
+typedef struct
+{
+    timer_alarm_t alarm_en;         ///< Alarm enable.
+    timer_start_t counter_en;       ///< Start on init.
+    timer_intr_mode_t intr_type;    ///< Interrupt mode.
+    timer_count_dir_t counter_dir;  ///< Count direction.
+    timer_autoreload_t auto_reload; ///< Reload on alarm.
+    uint32_t divider;               ///< 80 MHz APB divider (2..65536).
+} timer_config_t;
+
+typedef bool (*timer_isr_t)(void *); ///< Alarm callback (returns "yield needed").
+
+esp_err_t timer_init(timer_group_t group, timer_idx_t idx, const timer_config_t *config);
+esp_err_t timer_set_counter_value(timer_group_t group, timer_idx_t idx, uint64_t value);
+esp_err_t timer_set_alarm_value(timer_group_t group, timer_idx_t idx, uint64_t value);
+esp_err_t timer_enable_intr(timer_group_t group, timer_idx_t idx);
+esp_err_t timer_isr_callback_add(timer_group_t group, timer_idx_t idx, timer_isr_t isr, void *arg, int flags);
+esp_err_t timer_isr_callback_remove(timer_group_t group, timer_idx_t idx);
+esp_err_t timer_start(timer_group_t group, timer_idx_t idx);
+esp_err_t timer_pause(timer_group_t group, timer_idx_t idx);
+esp_err_t timer_deinit(timer_group_t group, timer_idx_t idx);
@@ -0,0 +1,18 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: section attributes (IRAM / DRAM / PSRAM placement) are no-ops on the host.
+ *
+ * @file esp_attr.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define EXT_RAM_ATTR
+#define EXT_RAM_NOINIT_ATTR
@@ -0,0 +1,28 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: capability heap on malloc; the size queries report 0 (no ESP32 heap to map).
+ *
+ * @file esp_heap_caps.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline void *heap_caps_malloc(size_t size, uint32_t) { return std::malloc(size); }
+inline void heap_caps_free(void *p) { std::free(p); }
+inline size_t heap_caps_get_free_size(uint32_t) { return 0; }
+inline size_t heap_caps_get_minimum_free_size(uint32_t) { return 0; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 0; }
+inline size_t heap_caps_get_total_size(uint32_t) { return 0; }
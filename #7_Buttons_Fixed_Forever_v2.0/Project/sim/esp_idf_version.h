@@ -0,0 +1,16 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: IDF version the shims follow (4.4, as in Arduino-ESP32 2.x).
+ *
+ * @file esp_idf_version.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#define ESP_IDF_VERSION_MAJOR 4
+#define ESP_IDF_VERSION_MINOR 4
+#define ESP_IDF_VERSION_PATCH 0
@@ -0,0 +1,15 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: interrupt allocation flags (accepted and ignored).
+ *
+ * @file esp_intr_alloc.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+#define ESP_INTR_FLAG_IRAM (1 << 10)
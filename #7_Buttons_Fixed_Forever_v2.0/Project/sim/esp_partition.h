@@ -0,0 +1,59 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: partitions exist only when registered with sim::partitionImage() (RAM copies of image files).
+ *
+ * @file esp_partition.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <esp_err.h>
+
+typedef enum
+{
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01
+} esp_partition_type_t;
+
+typedef enum
+{
+    ESP_PARTITION_SUBTYPE_DATA_OTA = 0x00,
+    ESP_PARTITION_SUBTYPE_DATA_COREDUMP = 0x03,
+    ESP_PARTITION_SUBTYPE_DATA_SPIFFS = 0x82,
+    ESP_PARTITION_SUBTYPE_ANY = 0xff
+} esp_partition_subtype_t;
+
+typedef enum
+{
+    ESP_PARTITION_MMAP_DATA = 0,
+    ESP_PARTITION_MMAP_INST
+} esp_partition_mmap_memory_t;
+
+typedef uint32_t esp_partition_mmap_handle_t; ///< Mapping handle.
+
+/// @brief Partition table entry.
+typedef struct
+{
+    esp_partition_type_t type;       ///< App / data.
+    esp_partition_subtype_t subtype; ///< Subtype.
+    uint32_t address;                ///< Flash offset.
+    uint32_t size;                   ///< Bytes.
+    char label[17];                  ///< Name.
+    bool encrypted;                  ///< Flash encryption.
+} esp_partition_t;
+
+// Unregistered labels are not found, so callers take their compiled defaults (calibration, OTA, ...).
+// Registered ones behave like NOR flash: writes only clear bits, erases are sector-aligned.
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label);
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size);
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size);
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size);
+esp_err_t esp_partition_mmap(const esp_partition_t *part, size_t offset, size_t size, esp_partition_mmap_memory_t memory,
+                             const void **out, esp_partition_mmap_handle_t *handle);
+inline void esp_partition_munmap(esp_partition_mmap_handle_t) {}
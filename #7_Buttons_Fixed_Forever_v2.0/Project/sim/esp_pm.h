@@ -0,0 +1,36 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: power management API (not supported: PowerManager runs at "full clock", locks are no-ops).
+ *
+ * @file esp_pm.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+typedef enum
+{
+    ESP_PM_CPU_FREQ_MAX = 0,
+    ESP_PM_APB_FREQ_MAX,
+    ESP_PM_NO_LIGHT_SLEEP
+} esp_pm_lock_type_t;
+
+/// @brief DFS / light sleep configuration.
+typedef struct
+{
+    int max_freq_mhz;        ///< Clock with a CPU_FREQ_MAX lock held.
+    int min_freq_mhz;        ///< Idle clock.
+    bool light_sleep_enable; ///< Enter light sleep when idle.
+} esp_pm_config_esp32s3_t;
+
+typedef struct esp_pm_lock *esp_pm_lock_handle_t;
+
+inline esp_err_t esp_pm_configure(const void *) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_pm_lock_create(esp_pm_lock_type_t, int, const char *, esp_pm_lock_handle_t *) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t) { return ESP_ERR_NOT_SUPPORTED; }
@@ -0,0 +1,27 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: the ROM CRC-32 (IEEE 802.3, little-endian, same conditioning as the ROM).
+ *
+ * @file esp_rom_crc.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief esp_rom_crc32_le(): ~crc in, ~crc out, reflected polynomial 0xEDB88320.
+inline uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        crc ^= buf[i];
+        for (int b = 0; b < 8; ++b)
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+    }
+    return ~crc;
+}
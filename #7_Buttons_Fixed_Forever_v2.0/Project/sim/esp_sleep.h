@@ -0,0 +1,16 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: sleep wake-source API (accepted and ignored: the host never sleeps).
+ *
+ * @file esp_sleep.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-15
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
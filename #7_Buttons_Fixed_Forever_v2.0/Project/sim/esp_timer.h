@@ -0,0 +1,18 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: esp_timer_get_time() on SimKernel's virtual clock (now_us() follows it).
+ *
+ * @file esp_timer.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <SimKernel.h>
+
+/// @brief Virtual µs since the simulation started.
+inline int64_t esp_timer_get_time() { return static_cast<int64_t>(sim::now_us()); }
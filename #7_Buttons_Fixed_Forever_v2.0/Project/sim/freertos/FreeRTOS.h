@@ -0,0 +1,41 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: FreeRTOS configuration and base macros (1 kHz tick on SimKernel's clock).
+ *
+ * @file FreeRTOS.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "portmacro.h"
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 25
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+
+/// @brief Invariant check: abort with the location (sanitizers then print the stack).
+#define configASSERT(x)                                                                   \
+    do                                                                                    \
+    {                                                                                     \
+        if (!(x))                                                                         \
+        {                                                                                 \
+            std::fprintf(stderr, "configASSERT(%s) failed at %s:%d\n", #x, __FILE__, __LINE__); \
+            std::abort();                                                                 \
+        }                                                                                 \
+    } while (0)
+
+#include "task.h"
@@ -0,0 +1,42 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: FreeRTOS port layer (types, critical sections, ISR context) on SimKernel.
+ *
+ * @file portmacro.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <SimKernel.h>
+
+typedef uint32_t TickType_t;  ///< 32-bit ticks, as on the ESP32 port.
+typedef int BaseType_t;       ///< Native signed word.
+typedef unsigned UBaseType_t; ///< Native unsigned word.
+typedef uint8_t StackType_t;  ///< ESP-IDF counts stack depth in bytes.
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portNUM_PROCESSORS 2 ///< TaskGraph still plans two cores; the kernel runs one task at a time.
+
+/// @brief Spinlock placeholder: one task runs at a time and alarms only fire between tasks.
+typedef struct
+{
+    uint32_t owner; ///< Unused.
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+#define portYIELD_FROM_ISR(woken) ((void)(woken)) ///< The kernel dispatches by priority once the alarm returns.
+
+/// @brief True inside a simulated timer alarm.
+inline BaseType_t xPortInIsrContext() { return sim::inIsr() ? 1 : 0; }
+
+/// @brief Core of the caller (always 0).
+inline BaseType_t xPortGetCoreID() { return 0; }
@@ -0,0 +1,201 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: FreeRTOS task, delay and direct-to-task notification API on SimKernel.
+ *
+ * @file task.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef tskTaskControlBlock *TaskHandle_t; ///< Simulated task.
+typedef void (*TaskFunction_t)(void *);    ///< Task entry.
+
+/// @brief Static TCB storage (unused by the kernel; keeps StaticPool's layout compiling).
+typedef struct
+{
+    uint8_t reserved[64]; ///< Opaque.
+} StaticTask_t;
+
+typedef enum
+{
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+#define taskYIELD() sim::yield()
+#define taskENTER_CRITICAL(mux) portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux) portEXIT_CRITICAL(mux)
+
+namespace sim
+{
+    constexpr uint64_t kTickUs = 1000000U / configTICK_RATE_HZ; ///< One tick (µs).
+
+    /// @brief Relative timeout for a block of @p ticks: to the tick boundary @p ticks from now, as the tick ISR would.
+    inline uint64_t ticksToUs(TickType_t ticks) noexcept
+    {
+        if (ticks == portMAX_DELAY)
+            return kForever;
+        if (ticks == 0)
+            return 0;
+        const uint64_t now = now_us();
+        return (now / kTickUs + ticks) * kTickUs - now;
+    }
+
+    /// @brief FreeRTOS notify action → kernel action.
+    inline Action toAction(eNotifyAction a) noexcept
+    {
+        switch (a)
+        {
+        case eSetBits:
+            return Action::SetBits;
+        case eIncrement:
+            return Action::Increment;
+        case eSetValueWithOverwrite:
+            return Action::Overwrite;
+        case eSetValueWithoutOverwrite:
+            return Action::NoOverwrite;
+        case eNoAction:
+        default:
+            return Action::None;
+        }
+    }
+} ///< Namespace sim.
+
+// ---- Creation / deletion ---- //
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t entry, const char *name, uint32_t, void *arg, UBaseType_t priority,
+                                          TaskHandle_t *out, BaseType_t)
+{
+    TaskHandle_t t = sim::spawn(entry, arg, name, priority);
+    if (out != nullptr)
+        *out = t;
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t entry, const char *name, uint32_t depth, void *arg, UBaseType_t priority,
+                              TaskHandle_t *out)
+{
+    return xTaskCreatePinnedToCore(entry, name, depth, arg, priority, out, tskNO_AFFINITY);
+}
+
+inline TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t entry, const char *name, uint32_t, void *arg,
+                                                  UBaseType_t priority, StackType_t *, StaticTask_t *, BaseType_t)
+{
+    return sim::spawn(entry, arg, name, priority);
+}
+
+inline TaskHandle_t xTaskCreateStatic(TaskFunction_t entry, const char *name, uint32_t depth, void *arg, UBaseType_t priority,
+                                      StackType_t *stack, StaticTask_t *tcb)
+{
+    return xTaskCreateStaticPinnedToCore(entry, name, depth, arg, priority, stack, tcb, tskNO_AFFINITY);
+}
+
+/// @brief Only self-deletion is modelled (the firmware never deletes another task).
+inline void vTaskDelete(TaskHandle_t t)
+{
+    configASSERT(t == nullptr || t == sim::self());
+    sim::exit();
+}
+
+// ---- Time ---- //
+
+inline TickType_t xTaskGetTickCount() { return static_cast<TickType_t>(sim::now_us() / sim::kTickUs); }
+inline TickType_t xTaskGetTickCountFromISR() { return xTaskGetTickCount(); }
+
+inline void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == 0)
+    {
+        sim::yield();
+        return;
+    }
+    sim::sleepUntil(sim::now_us() + sim::ticksToUs(ticks));
+}
+
+/// @brief Periodic delay; a wake time already passed returns at once (32-bit tick wrap safe).
+inline BaseType_t xTaskDelayUntil(TickType_t *prev, TickType_t increment)
+{
+    *prev += increment;
+    const int32_t ahead = static_cast<int32_t>(*prev - xTaskGetTickCount());
+    if (ahead <= 0)
+        return pdFALSE;
+    const uint64_t now = sim::now_us();
+    sim::sleepUntil((now / sim::kTickUs + static_cast<uint64_t>(ahead)) * sim::kTickUs);
+    return pdTRUE;
+}
+
+inline void vTaskDelayUntil(TickType_t *prev, TickType_t increment) { (void)xTaskDelayUntil(prev, increment); }
+
+// ---- Introspection ---- //
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return sim::self(); }
+inline UBaseType_t uxTaskPriorityGet(TaskHandle_t t) { return sim::priority(t != nullptr ? t : sim::self()); }
+inline const char *pcTaskGetName(TaskHandle_t t) { return sim::name(t != nullptr ? t : sim::self()); }
+
+inline eTaskState eTaskGetState(TaskHandle_t t)
+{
+    if (t == nullptr)
+        return eInvalid;
+    switch (sim::state(t))
+    {
+    case sim::State::Running:
+        return eRunning;
+    case sim::State::Ready:
+        return eReady;
+    case sim::State::Blocked:
+        return eBlocked;
+    case sim::State::Suspended:
+        return eSuspended;
+    case sim::State::Deleted:
+    default:
+        return eDeleted;
+    }
+}
+
+inline void vTaskSuspendAll() {}
+inline BaseType_t xTaskResumeAll() { return pdFALSE; }
+
+// ---- Direct-to-task notifications ---- //
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) { return sim::take(clear != pdFALSE, sim::ticksToUs(ticks)); }
+
+inline BaseType_t xTaskNotifyWait(uint32_t clear_entry, uint32_t clear_exit, uint32_t *value, TickType_t ticks)
+{
+    return sim::wait(clear_entry, clear_exit, value, sim::ticksToUs(ticks)) ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xTaskNotify(TaskHandle_t t, uint32_t value, eNotifyAction action)
+{
+    return sim::notify(t, value, sim::toAction(action)) ? pdPASS : pdFAIL;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t t) { return xTaskNotify(t, 0, eIncrement); }
+
+inline BaseType_t xTaskNotifyFromISR(TaskHandle_t t, uint32_t value, eNotifyAction action, BaseType_t *woken)
+{
+    const bool ok = sim::notify(t, value, sim::toAction(action));
+    if (woken != nullptr)
+        *woken = pdTRUE; ///< Harmless: the kernel picks the next task by priority anyway.
+    return ok ? pdPASS : pdFAIL;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t *woken) { (void)xTaskNotifyFromISR(t, 0, eIncrement, woken); }
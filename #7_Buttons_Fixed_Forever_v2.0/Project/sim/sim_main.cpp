@@ -0,0 +1,394 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation of the stage-1 pipeline: StateManager → ControlCore ← RcPublisher, ControlCore → PowerDriveHandler.
+ *
+ * The managers are the firmware sources, unchanged; sim/ supplies the
+ * FreeRTOS, Arduino and IDF headers on a virtual-clock kernel (SimKernel.h),
+ * the mock button handler (PortButtons over sim::PinReader), the mock drive
+ * backend (sim::Motor, with an encoder plant) and a scripted RC transmitter.
+ * A 20 s scenario loops for --seconds: local throttle from the Accelerator
+ * button, an indicator tap, RC override, a speed ramp, a reversal at full
+ * speed, a link drop, then back to local. Idle time costs nothing, so a
+ * minute of driving takes a fraction of a second.
+ *
+ * The run ends with bus rates, loop statistics, the latency and stage cost
+ * histograms and five checks (exit status 1 if any fails): the
+ * PowerDriveHandler period never overran, no reversal drove the opposite leg
+ * without an off / brake interval, every link drop under Remote reached
+ * Failsafe, the motor actually turned, and a bus frame stamped after the
+ * reader's now reads as fresh (PublishClock).
+ *
+ * Record / replay: --record FILE runs the FlightRecorder on a partition
+ * image (each scenario link drop writes a failsafe dump; FILE is saved at
+ * exit). --replay FILE plays a dump from such an image, or from an esptool
+ * read of the car's partition, instead of the scenario: into ControlCore,
+ * or with --drive into PowerDriveHandler alone, at recorded pace or --fast.
+ * A replay checks that the drive loop never overran, no reversal was hard,
+ * every record was answered and, into ControlCore at recorded pace, that the
+ * output matched the recorded Control frames (dumps recorded from boot only:
+ * a later one starts with latches in an unknown state).
+ *
+ * --check-fixed runs no scenario: it compares the fixed::Q16 build of the
+ * control-path kernels (ramp, RC map, alpha-beta tracker) with the float
+ * one over the same input and fails past the tolerances in FixedCheck.cpp.
+ *
+ * Build (from Project/; external libraries must be on the include path and
+ * host-portable: SnapshotBus, InputModel, Universal_Button, RCLink):
+ *
+ *   g++ -std=gnu++17 -O1 -g -DSIM_HOST -Isim -Iconfig -Iinclude -Ilib -I<libs> -pthread -o pipeline_sim \
+ *       $(find sim lib/StateManager lib/ControlCore lib/PowerDriveHandler lib/RcPublisher lib/SpeedEncoder \
+ *              lib/Calibration lib/SbusTransport lib/CrsfTransport lib/FlightRecorder lib/BusReplay lib/PowerManager \
+ *              -name '*.cpp')
+ *   ./pipeline_sim --seconds 600 [--closed-loop]
+ *   ./pipeline_sim --seconds 60 --record bbox.bin
+ *   ./pipeline_sim --seconds 60 --replay bbox.bin [--seq N] [--fast] [--drive]
+ *   ./pipeline_sim --check-fixed
+ *
+ * Add -fsanitize=address,undefined or -fsanitize=thread for CI. The
+ * scheduler hands the CPU over under a mutex, so a TSan report means a real
+ * race in the shared state, not in the model.
+ *
+ * @file sim_main.cpp
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#include <app_config.h>
+#include <StateManager/StateManager.h>
+#include <RcPublisher/RcPublisher.h>
+#include <ControlCore/ControlCore.h>
+#include <PowerDriveHandler/PowerDriveHandler.h>
+#include <SpeedEncoder/SpeedEncoder.h>
+#include <PortButtons/PortButtons.h>
+#include <Calibration/Calibration.h>
+#include <FlightRecorder/FlightRecorder.h>
+#include <BusReplay/BusReplay.h>
+#include <TaskGraph.h>
+#include <LatencyTrace.h>
+#include <StageCost.h>
+#include <SimDevices.h>
+#include <SimKernel.h>
+#include <FixedCheck.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    constexpr unsigned kDevicePri = configMAX_PRIORITIES - 1; ///< Stimulus tasks: above everything, like the hardware.
+    constexpr unsigned kSetupPri = 1;                         ///< Arduino's loopTask.
+    constexpr uint32_t kCycleMs = 20000;                      ///< Scenario length (repeats).
+    constexpr uint32_t kImageBytes = 40 * blackbox::kBlock;   ///< --record image: 2.5 MB, like the car's spiffs (4 slots).
+    constexpr uint64_t kFromBootUs = 1000000;                 ///< A dump starting this close to boot saw every latch change (divergence is checked).
+
+    // RC channels (roles in declared order, see RcPublisher / calib::kDefaults).
+    constexpr std::size_t kChDirection = 1; ///< > 1500 forward, < 1500 reverse.
+    constexpr std::size_t kChSpeed = 2;     ///< 1000 → 0 %, 2000 → 100 %.
+    constexpr std::size_t kChOverride = 6;  ///< 2000 → Remote authority.
+
+    // ---- Pipeline (built by the setup task, read by main() once run() returns) ---- //
+    InputBus s_input{};
+    ControlBus s_control{};
+    sim::Motor s_motor;
+    sim::RcTransmitter s_tx;
+    PowerDriveHandler *s_pdh = nullptr;
+    bool s_closed = false; ///< --closed-loop: attach the encoder.
+
+    // ---- Record / replay (command line) ---- //
+    bool s_record = false;                                       ///< --record: run the FlightRecorder.
+    bool s_replay = false;                                       ///< --replay: play a dump instead of the scenario.
+    uint32_t s_seq = 0;                                          ///< --seq (0 → newest complete dump).
+    replay::Pace s_pace = replay::Pace::Recorded;                ///< --fast.
+    cfg::replay::Target s_target = cfg::replay::Target::Control; ///< --drive.
+    FlightRecorder *s_rec = nullptr;                             ///< Recorder (--record).
+    BusReplay *s_player = nullptr;                               ///< Player (--replay).
+    bool s_started = false;                                      ///< play() accepted the dump.
+
+    // ---- Scenario bookkeeping ---- //
+    uint32_t s_drops = 0;  ///< Link drops while Remote.
+    uint32_t s_caught = 0; ///< ...that reached Failsafe before the link returned.
+    bool s_remote = false; ///< Authority at the drop.
+
+    /// @brief Press (true) / release button @p b (active low).
+    void press(ButtonIndex b, bool down) { sim::gpioSet(kButtonPins[static_cast<std::size_t>(b)], down ? LOW : HIGH); }
+
+    /// @brief One timeline entry.
+    struct Step
+    {
+        uint32_t at_ms; ///< Offset in the cycle.
+        void (*fn)();   ///< Action.
+    };
+
+    const Step kScript[] = {
+        {0, [] { s_tx.set(kChOverride, 1000); s_tx.set(kChSpeed, 1000); s_tx.set(kChDirection, 1500); }},
+        {500, [] { press(ButtonIndex::Accelerator, true); }},    ///< Local full throttle...
+        {2500, [] { press(ButtonIndex::Accelerator, false); }},  ///< ...then ramp down.
+        {3000, [] { press(ButtonIndex::IndicatorLeft, true); }}, ///< Tap: left indicator latch.
+        {3120, [] { press(ButtonIndex::IndicatorLeft, false); }},
+        {4000, [] { s_tx.set(kChOverride, 2000); s_tx.set(kChDirection, 2000); }}, ///< Remote, forward.
+        {4500, [] { s_tx.set(kChSpeed, 1250); }},
+        {5000, [] { s_tx.set(kChSpeed, 1500); }},
+        {5500, [] { s_tx.set(kChSpeed, 1750); }},
+        {6000, [] { s_tx.set(kChSpeed, 2000); }},
+        {8000, [] { s_tx.set(kChDirection, 1000); }},  ///< Reverse at full speed.
+        {11000, [] { s_tx.set(kChDirection, 2000); }}, ///< And forward again.
+        {13000, [] { s_remote = s_control.peek().authority == ControlSnapshot::Authority::Remote; s_tx.drop(true); }},
+        {13300, [] {
+             if (s_remote)
+             {
+                 ++s_drops;
+                 s_caught += s_control.peek().authority == ControlSnapshot::Authority::Failsafe;
+             }
+             s_tx.drop(false);
+         }},
+        {15000, [] { s_tx.set(kChSpeed, 1000); }},
+        {17000, [] { s_tx.set(kChOverride, 1000); }}, ///< Back to local.
+    };
+
+    /// @brief Run kScript every kCycleMs.
+    void scenarioTask(void *)
+    {
+        for (uint64_t base = now_us();; base += kCycleMs * 1000ULL)
+        {
+            for (const Step &s : kScript)
+            {
+                sim::sleepUntil(base + s.at_ms * 1000ULL);
+                s.fn();
+            }
+            sim::sleepUntil(base + kCycleMs * 1000ULL);
+        }
+    }
+
+    /// @brief Stage 1 of setup(), host edition.
+    void setupTask(void *)
+    {
+        calib::begin(); ///< No partition: compiled defaults.
+        const calib::ButtonCal &btnCal = calib::active().buttons;
+
+        static sim::PinReader pins;
+        static PortButtons<NUM_BUTTONS, sim::PinReader> buttons(pins, btnCal.debounce_ms);
+        pins.begin(kButtonPins, NUM_BUTTONS);
+        buttons.begin();
+
+        configASSERT(s_motor.begin());
+        static SpeedEncoder encoder;
+        SpeedEncoder *speedEnc = nullptr;
+        if (s_closed)
+        {
+            s_motor.attach(cfg::encoder::PCNT_UNIT);
+            if (encoder.begin())
+                speedEnc = &encoder;
+        }
+
+        static StateManager sm(buttons, s_input, cfg::tick::LOOP_MS,
+                               cfg::button::BTN_IRQ_WAKE ? StateManager::ScanMode::Interrupt : StateManager::ScanMode::Poll);
+        static RcPublisher rcp{cfg::tick::LOOP_MS, 0.0f, cfg::rc::HEARTBEAT_MS};
+        static ControlCore cc(s_input, buses::rc(), s_control);
+        static PowerDriveHandler pdh(s_motor, s_control, buses::telemetry(), speedEnc);
+        static BusReplay player(s_input, buses::rc(), s_control, buses::telemetry(), s_target);
+        s_pdh = &pdh;
+        if (s_replay && player.begin())
+            s_player = &player;
+        const bool control = s_player == nullptr || s_target == cfg::replay::Target::Control;
+        if (s_player == nullptr)
+            rcp.begin();
+
+        // Same declarations as main.cpp (the graph assigns the same priorities).
+        static rtos::TaskGraph<> critical;
+        if (s_player == nullptr)
+        {
+            critical.add("StateManager", sm, 2048).every_ms(cfg::tick::LOOP_MS).budget_us(200).writes(s_input);
+            auto &rcNode = critical.add("RcPub", rcp, 4096).budget_us(300).writes(buses::rc());
+            if (rcp.wake() == RcPublisher::Wake::UartEvent)
+                rcNode.deadline_us(1000);
+            else
+                rcNode.every_ms(cfg::tick::LOOP_MS);
+        }
+        else
+        {
+            auto &rplNode = critical.add("Replay", player, 3072).priority(cfg::replay::PRIORITY).pin(0);
+            if (control)
+                rplNode.writes(s_input).writes(buses::rc());
+            else
+                rplNode.writes(s_control);
+        }
+        if (control)
+            critical.add("ControlCore", cc, 4096).deadline_us(2000).budget_us(100).reads(s_input).reads(buses::rc()).writes(s_control);
+        critical.add("PDHandler", pdh, 4096)
+            .every_us(cfg::drive::PERIOD_US)
+            .budget_us(150)
+            .pin(1)
+            .reads(s_control)
+            .writes(buses::telemetry());
+        configASSERT(critical.start());
+        critical.print();
+
+        // Stage 2 in main.cpp: the recorder rides along with the scenario.
+        static FlightRecorder recorder(s_input, buses::rc(), s_control);
+        static rtos::TaskGraph<> services;
+        if (s_record && recorder.begin())
+        {
+            s_rec = &recorder;
+            services.add("Recorder", recorder, 3072).priority(cfg::recorder::PRIORITY).pin(0).reads(s_input).reads(buses::rc()).reads(s_control);
+            configASSERT(services.start());
+        }
+
+        if (s_player != nullptr)
+        {
+            trace::latency().reset();
+            s_started = player.play(s_seq, s_pace);
+            if (!s_started)
+                std::printf("Replay: no dump #%u in the image.\n", static_cast<unsigned>(s_seq));
+        }
+        else
+        {
+            s_tx.start(kDevicePri);
+            (void)sim::spawn(&scenarioTask, nullptr, "scenario", kDevicePri);
+        }
+        vTaskDelete(nullptr);
+    }
+
+    /// @brief One loop statistics line.
+    void printLoop(const char *label, const LoopStats &s)
+    {
+        std::printf("%-6s %8u periods of %u us  min %5u  p99 %5u  max %6u us  overruns %u\n", label,
+                    static_cast<unsigned>(s.count), static_cast<unsigned>(s.nominal_us), static_cast<unsigned>(s.min_us),
+                    static_cast<unsigned>(s.p99_us), static_cast<unsigned>(s.max_us), static_cast<unsigned>(s.overruns));
+    }
+
+    /// @brief One bus line: publishes and rate.
+    void printBus(const char *label, uint64_t seq, double seconds)
+    {
+        std::printf("%-10s %10llu publishes  %9.1f /s\n", label, static_cast<unsigned long long>(seq), seq / seconds);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = 60;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            seconds = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--closed-loop") == 0)
+            s_closed = true;
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            s_record = sim::partitionImage(cfg::recorder::PARTITION, argv[++i], kImageBytes);
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            s_replay = sim::partitionImage(cfg::recorder::PARTITION, argv[++i]);
+            if (!s_replay)
+            {
+                std::fprintf(stderr, "%s: no image\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (strcmp(argv[i], "--seq") == 0 && i + 1 < argc)
+            s_seq = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--fast") == 0)
+            s_pace = replay::Pace::Fast;
+        else if (strcmp(argv[i], "--drive") == 0)
+            s_target = cfg::replay::Target::Drive;
+        else if (strcmp(argv[i], "--check-fixed") == 0)
+            return sim::checkFixed() ? 0 : 1; ///< Kernel check only: no tasks were spawned.
+        else
+        {
+            std::fprintf(stderr,
+                         "usage: %s [--seconds N] [--closed-loop] [--record FILE | --replay FILE [--seq N] [--fast] [--drive]] | --check-fixed\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+    if (s_record && s_replay)
+    {
+        std::fprintf(stderr, "--record and --replay share the partition: pick one\n");
+        return 2;
+    }
+
+    (void)sim::spawn(&setupTask, nullptr, "setup", kSetupPri);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    sim::run(static_cast<uint64_t>(seconds) * 1000000ULL);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // ---- Report (every task is parked: plain reads are safe) ---- //
+    const double simulated = seconds > 0 ? seconds : 1;
+    const sim::Counters k = sim::counters();
+    std::printf("\n%u s simulated in %.3f s wall (%.0fx real time); %llu dispatches, %llu alarms, %llu clock jumps\n",
+                static_cast<unsigned>(seconds), wall, simulated / (wall > 0 ? wall : 1e-9),
+                static_cast<unsigned long long>(k.switches), static_cast<unsigned long long>(k.alarms),
+                static_cast<unsigned long long>(k.jumps));
+
+    printBus("InputBus", s_input.sequence(), simulated);
+    printBus("RcBus", buses::rc().sequence(), simulated);
+    printBus("ControlBus", s_control.sequence(), simulated);
+    printBus("Telemetry", buses::telemetry().sequence(), simulated);
+    std::printf("RC frames  %10llu sent  %u RX overflows\n", static_cast<unsigned long long>(s_tx.frames()),
+                static_cast<unsigned>(Serial2.overflows()));
+
+    const LoopStats pdh = (s_pdh != nullptr) ? s_pdh->loopStats() : LoopStats{};
+    printLoop("PDH", pdh);
+    std::printf("Motor      %10llu commands  %u brakes  %u hard reversals  peak %.0f rpm (%s)\n",
+                static_cast<unsigned long long>(s_motor.commands()), static_cast<unsigned>(s_motor.brakes()),
+                static_cast<unsigned>(s_motor.hardFlips()), s_motor.peakRpm(), s_closed ? "closed loop" : "open loop");
+    std::printf("Link drops %10u under Remote, %u reached Failsafe\n", static_cast<unsigned>(s_drops),
+                static_cast<unsigned>(s_caught));
+    if (s_rec != nullptr)
+        std::printf("Recorder   %10u dumps written%s\n", static_cast<unsigned>(s_rec->dumps()),
+                    sim::partitionSave() ? "" : " (image NOT saved)");
+
+    const replay::Report r = (s_player != nullptr) ? s_player->report() : replay::Report{};
+    const bool played = s_player != nullptr && s_started && !s_player->busy() && r.records > 0;
+    if (s_player != nullptr)
+    {
+        std::printf("Replay     dump #%u %s into %s: %u records over %.3f s (from %.3f s) in %.3f s  late max %u us\n",
+                    static_cast<unsigned>(r.seq), replay::to_name(r.pace),
+                    (s_target == cfg::replay::Target::Drive) ? "PDHandler" : "ControlCore", static_cast<unsigned>(r.records),
+                    r.span_us / 1e6, r.first_us / 1e6, r.took_us / 1e6, static_cast<unsigned>(r.late_max_us));
+        std::printf("           %u published  %u unanswered  %u / %u diverged (first at record %u)%s\n",
+                    static_cast<unsigned>(r.published), static_cast<unsigned>(r.unanswered), static_cast<unsigned>(r.diverged),
+                    static_cast<unsigned>(r.compared), static_cast<unsigned>(r.first_diverged), played ? "" : "  (NOT finished)");
+    }
+    std::printf("\n");
+    trace::latency().dump();
+    std::printf("\n");
+    trace::cost().dump();
+
+    // ---- Checks ---- //
+    bool ok = true;
+    const auto check = [&ok](bool pass, const char *what)
+    {
+        std::printf("%s  %s\n", pass ? "PASS" : "FAIL", what);
+        ok = ok && pass;
+    };
+    check(pdh.count > 0 && pdh.overruns == 0, "PowerDriveHandler period never overran");
+    check(s_motor.hardFlips() == 0, "every reversal went through off / brake first");
+    {
+        // A publish landing after the reader sampled now (RcPublisher racing ControlCore::arbitrate) is the newest
+        // frame, not a wrapped ~71 minute age that fails every budget.
+        static snapshot::SignalBus<ControlSnapshot, 1> bus{};
+        snapshot::Freshness budget{"ahead", 1000};
+        bus.publish(ControlSnapshot{});
+        const uint64_t stamp = now_us();
+        const bool ahead = bus.age_us(stamp - 5) == 0 && budget.check(bus.age_us(stamp - 5)) && budget.stats().max_us == 0;
+        check(ahead && bus.age_us(stamp + 2000) == 2000, "a frame stamped after the reader's now reads as age 0");
+    }
+    if (s_player == nullptr)
+    {
+        check(s_caught == s_drops, "every link drop under Remote reached Failsafe");
+        check(s_motor.peakRpm() > 0.0f, "the motor turned");
+    }
+    else
+    {
+        check(played && r.unanswered == 0, "the whole dump played and every record was answered");
+        if (s_target == cfg::replay::Target::Control && s_pace == replay::Pace::Recorded && r.first_us < kFromBootUs)
+            check(r.diverged == 0, "ControlCore reproduced every recorded Control frame");
+        else if (s_target == cfg::replay::Target::Control && s_pace == replay::Pace::Recorded)
+            std::printf("skip  divergence: the dump starts mid-run, latch state before it unknown\n");
+    }
+    std::fflush(stdout);
+    std::_Exit(ok ? 0 : 1); ///< Task threads stay parked in the kernel: skip static destructors under them.
+}
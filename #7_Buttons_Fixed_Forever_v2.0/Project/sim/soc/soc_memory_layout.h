@@ -0,0 +1,15 @@
+/**
+ * MIT License
+ *
+ * @brief Host simulation: address-range queries (everything is internal RAM).
+ *
+ * @file soc/soc_memory_layout.h
+ * @author Little Man Builds (Darren Osborne)
+ * @date 2026-10-14
+ * @copyright Copyright (c) 2025 Little Man Builds
+ */
+
+#pragma once
+
+inline bool esp_ptr_external_ram(const void *) { return false; }
+inline bool esp_ptr_internal(const void *) { return true; }
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+MIT License
+
+Read a FlashLog partition image back into per-schema CSV files.
+
+@file flashlog_read.py
+@author Little Man Builds (Darren Osborne)
+@date 2026-10-14
+@copyright Copyright (c) 2025 Little Man Builds
+
+Usage:
+    esptool.py read_flash 0xB01000 0x400000 rawlog.bin    # rawlog in custom_dual_16MB.csv
+    flashlog_read.py rawlog.bin                           # summary only
+    flashlog_read.py rawlog.bin --out run                 # run_telemetry.csv, run_rc.csv, ...
+
+Sectors are sorted by sequence number (the log wraps), so rows come out
+oldest first. Records are telem::LogRecord: the same payloads as the UART
+stream (telemetry_decode.SCHEMAS); schemas larger than one record are not
+mirrored. Packed layouts come from the descriptor records anywhere in the
+log (a first pass collects them), so data written before a wrap still decodes.
+"""
+
+import argparse
+import csv
+import struct
+
+from telemetry_decode import DESCRIBE_ID, SCHEMAS, Layouts, unpack
+
+MAGIC = 0x474C4652                   # "RFLG"
+SECTOR = 0x1000
+HEADER = struct.Struct("<IIHHI")     # flashlog::SectorHeader (16 B).
+LOG_HEADER = struct.Struct("<BBBx")  # telem::LogRecord fields before the payload.
+
+
+def sectors(image):
+    """Return [(seq, offset, record_bytes, count)] for every written sector, oldest first."""
+    found = []
+    for off in range(0, len(image) - SECTOR + 1, SECTOR):
+        magic, seq, record_bytes, count, _ = HEADER.unpack_from(image, off)
+        if magic != MAGIC or record_bytes == 0 or HEADER.size + count * record_bytes > SECTOR:
+            continue
+        found.append((seq, off, record_bytes, count))
+    return sorted(found)
+
+
+def records(image, found):
+    """Yield (schema, payload) for every record, oldest first."""
+    for _, off, record_bytes, count in found:
+        for i in range(count):
+            at = off + HEADER.size + i * record_bytes
+            schema, n, _ = LOG_HEADER.unpack_from(image, at)
+            if n > record_bytes - LOG_HEADER.size:
+                yield schema, None
+                continue
+            start = at + LOG_HEADER.size
+            yield schema, image[start:start + n]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("image", help="partition image (esptool read_flash)")
+    ap.add_argument("--out", help="CSV file prefix (default: summary only)")
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    found = sectors(image)
+    if not found:
+        print("no log sectors")
+        return
+
+    gaps = sum(1 for a, b in zip(found, found[1:]) if b[0] != a[0] + 1)
+    total = sum(s[3] for s in found)
+    print(f"{len(found)} sectors  seq {found[0][0]}..{found[-1][0]}  {total} records  {gaps} gaps")
+
+    layouts = Layouts()
+    for schema, payload in records(image, found):
+        if schema == DESCRIBE_ID and payload is not None:
+            layouts.describe(payload)
+
+    files, writers, counts, unknown = [], {}, {}, 0
+    try:
+        for schema, payload in records(image, found):
+            if schema == DESCRIBE_ID:
+                continue
+            packed = layouts.get(schema, len(payload)) if payload is not None else None
+            spec = SCHEMAS.get(schema)
+            if packed is not None:
+                name, cols, row = packed.name, packed.cols, packed.unpack
+            elif spec is not None and payload is not None and struct.calcsize(spec[1]) == len(payload):
+                name, cols, row = spec[0], spec[2], (lambda data, fmt=spec[1]: unpack(fmt, data))
+            else:
+                unknown += 1
+                continue
+            counts[name] = counts.get(name, 0) + 1
+            if args.out is None:
+                continue
+
+            w = writers.get((name, tuple(cols)))
+            if w is None:
+                path = f"{args.out}_{name}.csv"
+                if any(fp.name == path for fp in files):
+                    path = f"{args.out}_{name}_{len(files)}.csv"  # Raw and packed (or two packed) layouts of one table.
+                fp = open(path, "w", newline="")
+                files.append(fp)
+                w = csv.writer(fp)
+                w.writerow(cols)
+                writers[(name, tuple(cols))] = w
+            w.writerow(row(payload))
+    finally:
+        for fp in files:
+            fp.close()
+
+    for name, n in sorted(counts.items()):
+        print(f"  {name:<10} {n:8} records")
+    if unknown:
+        print(f"  {unknown} unknown / oversized records skipped")
+
+
+if __name__ == "__main__":
+    main()
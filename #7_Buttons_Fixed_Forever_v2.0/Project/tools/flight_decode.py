@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+MIT License
+
+Extract FlightRecorder dumps from a flash partition image into CSV.
+
+@file flight_decode.py
+@author Little Man Builds (Darren Osborne)
+@date 2026-10-14
+@copyright Copyright (c) 2025 Little Man Builds
+
+Usage:
+    esptool.py read_flash 0x811000 0x2EF000 bbox.bin      # spiffs in custom_dual_16MB.csv
+    flight_decode.py bbox.bin                             # list dumps
+    flight_decode.py bbox.bin --seq 12 --out crash12      # crash12_input.csv, crash12_rc.csv, crash12_control.csv
+
+Dumps are found on 64 KB boundaries (slots are block-aligned). RC and control
+payloads share their layouts with the telemetry stream (telemetry_decode.SCHEMAS).
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+from telemetry_decode import SCHEMAS, unpack
+
+DUMP_MAGIC = 0x31425246  # "FRB1"
+HEADER = struct.Struct("<IHHIIIB3xIIQ8x")  # blackbox::DumpHeader (48 B).
+RECORD = struct.Struct("<QBB6x56s")        # blackbox::Record (72 B).
+BLOCK = 0x10000
+SECTOR = 0x1000
+
+REASONS = {0: "none", 1: "failsafe", 2: "fault", 3: "panic", 4: "manual"}
+INPUT_V1 = ("input", "<QQ", ["origin_us", "buttons"])  # Input records written before the gesture fields.
+KINDS = {
+    1: ("input", "<6Q", ["origin_us", "buttons", "taps", "doubles", "held", "chords"]),
+    2: ("rc",) + SCHEMAS[2][1:],
+    3: ("control",) + SCHEMAS[3][1:],
+}
+KINDS_Q16 = {  # Dump version 2 (cfg::numeric::FIXED_POINT build): Q16.16 real_t payloads.
+    1: KINDS[1],
+    2: ("rc",) + SCHEMAS[5][1:],
+    3: ("control",) + SCHEMAS[6][1:],
+}
+
+
+def dumps(image):
+    """Yield (offset, header dict) for every dump header in the image."""
+    for off in range(0, len(image) - HEADER.size + 1, BLOCK):
+        f = HEADER.unpack_from(image, off)
+        if f[0] != DUMP_MAGIC or f[2] != RECORD.size or f[5] == 0 or off % f[5] != 0:
+            continue
+        yield off, {
+            "version": f[1], "seq": f[3], "count": f[4], "slot_bytes": f[5],
+            "reason": REASONS.get(f[6], str(f[6])), "code": f[7], "trigger_us": f[9],
+            "complete": f[8] == 0,
+        }
+
+
+def extract(image, off, h, prefix):
+    """Write one CSV per record kind (recorder stamp first, then the payload fields)."""
+    files, writers = [], {}
+    try:
+        base = off + SECTOR
+        for i in range(h["count"]):
+            at = base + i * RECORD.size
+            if at + RECORD.size > len(image):
+                break
+            stamp, kind, n, payload = RECORD.unpack_from(image, at)
+            if stamp == 0xFFFFFFFFFFFFFFFF:
+                break  # Torn dump: erased flash from here on.
+            spec = (KINDS_Q16 if h["version"] >= 2 else KINDS).get(kind)
+            if kind == 1 and n == struct.calcsize(INPUT_V1[1]):
+                spec = INPUT_V1
+            if spec is None or struct.calcsize(spec[1]) != n:
+                continue
+            name, fmt, cols = spec
+            w = writers.get(kind)
+            if w is None:
+                fp = open(f"{prefix}_{name}.csv", "w", newline="")
+                files.append(fp)
+                w = csv.writer(fp)
+                w.writerow(["rec_us"] + cols)
+                writers[kind] = w
+            w.writerow((stamp,) + unpack(fmt, payload[:n]))
+    finally:
+        for fp in files:
+            fp.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("image", help="partition image (esptool read_flash)")
+    ap.add_argument("--seq", type=int, help="dump sequence number to extract (default: list only)")
+    ap.add_argument("--out", default="bbox", help="CSV file prefix")
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    found = sorted(dumps(image), key=lambda d: d[1]["seq"])
+    if args.seq is None:
+        for off, h in found:
+            print(f"#{h['seq']:<4} @0x{off:06x}  {h['reason']:<8} {h['count']:5} records  code {h['code']}"
+                  f"  trigger {h['trigger_us']} us{'' if h['complete'] else '  (torn)'}")
+        return
+
+    for off, h in found:
+        if h["seq"] == args.seq:
+            extract(image, off, h, args.out)
+            return
+    sys.exit(f"dump #{args.seq} not found")
+
+
+if __name__ == "__main__":
+    main()
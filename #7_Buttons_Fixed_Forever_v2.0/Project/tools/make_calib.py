@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+MIT License
+
+Build the calibration blob read in place by lib/Calibration (calib::begin).
+
+@file make_calib.py
+@author Little Man Builds (Darren Osborne)
+@date 2026-10-14
+@copyright Copyright (c) 2025 Little Man Builds
+
+Usage:
+    make_calib.py --template > calib.json                 # compiled defaults as an editable file
+    make_calib.py calib.json -o calib.bin                 # build the blob
+    parttool.py write_partition --partition-name calib --input calib.bin
+    make_calib.py --show calib.bin                        # check a blob (or a read-back partition image)
+
+The JSON only needs the fields being changed; everything else keeps the
+compiled default. An erased calib partition (or a blob with a bad CRC)
+makes the firmware fall back to its compiled defaults.
+"""
+
+import argparse
+import copy
+import json
+import struct
+import sys
+import zlib
+
+from telemetry_decode import RC_ROLES
+
+MAGIC = 0x314C4143  # "CAL1"
+VERSION = 1
+HEADER = struct.Struct("<IHHII")              # calib::Header (16 B).
+ROLE = struct.Struct("<Bxhhhh2xffBx3h3ff")    # rc_batch::RoleSpec (44 B).
+LINK = struct.Struct("<IBxH4h")               # calib::RcLinkCal (16 B).
+BUTTONS = struct.Struct("<HHHxx")             # calib::ButtonCal (8 B).
+SIGNATURE_ROLES = ["steering", "direction", "speed", "indicators"]
+
+
+def axis(lo, hi, center, deadband, out_lo, out_hi, failsafe):
+    return {"kind": "axis", "raw": [lo, hi, center], "deadband_us": deadband, "out": [out_lo, out_hi],
+            "failsafe": failsafe}
+
+
+def switch(levels, values, failsafe):
+    return {"kind": "switch", "raw_levels": levels, "values": values, "failsafe": failsafe}
+
+
+# ---- Compiled defaults (keep in step with kDefaults in lib/Calibration/Calibration.cpp) ---- #
+DEFAULTS = {
+    "roles": {
+        "steering": axis(1000, 2000, 1500, 8, -100.0, 100.0, 0.0),
+        "direction": axis(1000, 2000, 1500, 8, -100.0, 100.0, 0.0),
+        "speed": axis(1000, 2000, 1000, 8, 0.0, 100.0, 0.0),
+        "indicators": axis(1000, 2000, 1500, 8, -100.0, 100.0, 0.0),
+        "volume": axis(1000, 2000, 1500, 4, 0.0, 100.0, 0.0),
+        "power": axis(1000, 2000, 1500, 4, 0.0, 100.0, 0.0),
+        "override": switch([1000, 2000], [0.0, 1.0], 1.0),
+        "lights": switch([1000, 2000], [0.0, 1.0], 0.0),
+        "mode": switch([1000, 1500, 2000], [0.0, 1.0, 2.0], 0.0),
+        "obstacle": switch([1000, 2000], [0.0, 1.0], 0.0),
+    },
+    "link": {"timeout_ms": 50, "signature": {"tol": 2, "hold_ms": 50,
+                                             "values": {"steering": 100, "direction": 100, "speed": 100,
+                                                        "indicators": -100}}},
+    "buttons": {"debounce_ms": 50, "short_ms": 200, "long_ms": 1000},
+}
+
+
+def merge(base, over):
+    """Recursively overlay `over` onto a copy of `base`."""
+    out = copy.deepcopy(base)
+    for k, v in over.items():
+        if isinstance(v, dict) and isinstance(out.get(k), dict):
+            out[k] = merge(out[k], v)
+        else:
+            out[k] = v
+    return out
+
+
+def pack_role(name, r):
+    if r["kind"] == "axis":
+        lo, hi, center = r["raw"]
+        return ROLE.pack(0, lo, hi, center, r["deadband_us"], r["out"][0], r["out"][1], 0, 0, 0, 0, 0.0, 0.0, 0.0,
+                         r["failsafe"])
+    levels, values = list(r["raw_levels"]), list(r["values"])
+    if not 2 <= len(levels) <= 3 or len(values) != len(levels):
+        sys.exit(f"{name}: a switch needs 2 or 3 raw_levels with one value each")
+    n = len(levels)
+    levels += [0] * (3 - n)
+    values += [0.0] * (3 - n)
+    return ROLE.pack(1, 1000, 2000, 1500, 0, -100.0, 100.0, n, *levels, *values, r["failsafe"])
+
+
+def build(c):
+    unknown = set(c["roles"]) - set(RC_ROLES)
+    if unknown:
+        sys.exit(f"unknown roles: {', '.join(sorted(unknown))}")
+    body = b"".join(pack_role(name, c["roles"][name]) for name in RC_ROLES)
+    sig = c["link"]["signature"]
+    body += LINK.pack(c["link"]["timeout_ms"], sig["tol"], sig["hold_ms"], *(sig["values"][r] for r in SIGNATURE_ROLES))
+    b = c["buttons"]
+    body += BUTTONS.pack(b["debounce_ms"], b["short_ms"], b["long_ms"])
+    size = HEADER.size + len(body)
+    return HEADER.pack(MAGIC, VERSION, size, zlib.crc32(body) & 0xFFFFFFFF, 0) + body
+
+
+def show(blob):
+    magic, version, size, crc, _ = HEADER.unpack_from(blob, 0)
+    if magic != MAGIC or version != VERSION or size > len(blob):
+        sys.exit("no valid calibration blob (firmware will use its compiled defaults)")
+    body = blob[HEADER.size:size]
+    good = zlib.crc32(body) & 0xFFFFFFFF == crc
+    print(f"v{version}  {size} B  crc {crc:08x} {'ok' if good else 'BAD (ignored by firmware)'}")
+    for i, name in enumerate(RC_ROLES):
+        f = ROLE.unpack_from(body, i * ROLE.size)
+        if f[0] == 0:
+            print(f"  {name:<11} axis   raw {f[1]}..{f[2]} centre {f[3]} db {f[4]}  out {f[5]:g}..{f[6]:g}  fs {f[14]:g}")
+        else:
+            n = f[7]
+            print(f"  {name:<11} switch {list(f[8:8 + n])} → {[round(v, 3) for v in f[11:11 + n]]}  fs {f[14]:g}")
+    at = len(RC_ROLES) * ROLE.size
+    timeout, tol, hold, *sig = LINK.unpack_from(body, at)
+    print(f"  link timeout {timeout} ms  signature ±{tol} for {hold} ms: {dict(zip(SIGNATURE_ROLES, sig))}")
+    deb, short, long_ = BUTTONS.unpack_from(body, at + LINK.size)
+    print(f"  buttons debounce {deb} ms  short {short} ms  long {long_} ms")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("config", nargs="?", help="JSON overrides (omit for the compiled defaults)")
+    ap.add_argument("-o", "--out", default="calib.bin", help="output blob")
+    ap.add_argument("--template", action="store_true", help="print the defaults as JSON and exit")
+    ap.add_argument("--show", metavar="BLOB", help="decode an existing blob and exit")
+    args = ap.parse_args()
+
+    if args.template:
+        json.dump(DEFAULTS, sys.stdout, indent=2)
+        print()
+        return
+    if args.show:
+        with open(args.show, "rb") as f:
+            show(f.read())
+        return
+
+    c = DEFAULTS
+    if args.config:
+        with open(args.config) as f:
+            c = merge(DEFAULTS, json.load(f))
+    blob = build(c)
+    with open(args.out, "wb") as f:
+        f.write(blob)
+    print(f"{args.out}: {len(blob)} B")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+MIT License
+
+Stream a firmware image to OtaService over its UART (cfg::ota, Serial1).
+
+@file ota_upload.py
+@author Little Man Builds (Darren Osborne)
+@date 2026-10-14
+@copyright Copyright (c) 2025 Little Man Builds
+
+Usage:
+    ota_upload.py /dev/ttyUSB1 .pio/build/esp32s3/firmware.bin    # needs pyserial
+    ota_upload.py /dev/ttyUSB1 firmware.bin --baud 921600 --chunk 4096
+
+Protocol (ota::Header / ota::Reply in OtaService.h): the header goes out,
+the device measures the drive loop for BASELINE_MS and answers R; each
+CHUNK-sized piece is answered with A once it is in flash. W is a keep-alive
+while the device holds a chunk back (motor running), so the wait for A is
+restarted on every W. D means the image verified and was set to boot; E is
+followed by one ota::Error code byte. Use the console 'ota' command for the
+drive loop jitter before vs during the transfer.
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+MAGIC = 0x3141544F                  # "OTA1"
+HEADER = struct.Struct("<III")      # ota::Header (12 B).
+ERRORS = ["none", "no slot", "too big", "begin", "timeout", "write", "crc", "image", "boot"]
+
+
+def expect(port, want, timeout):
+    """Wait for reply byte `want`; W restarts the timeout. Raises on E, silence or anything else."""
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        b = port.read(1)
+        if not b:
+            continue
+        if b == want:
+            return
+        if b == b"W":
+            deadline = time.monotonic() + timeout
+            continue
+        if b == b"E":
+            code = port.read(1)
+            n = code[0] if code else 0
+            raise RuntimeError(f"device error: {ERRORS[n] if n < len(ERRORS) else n}")
+        raise RuntimeError(f"unexpected reply {b!r} (waiting for {want!r})")
+    raise RuntimeError(f"no reply (waiting for {want!r})")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("port", help="serial port wired to cfg::ota::RX_PIN / TX_PIN")
+    ap.add_argument("image", help="application image (firmware.bin)")
+    ap.add_argument("--baud", type=int, default=921600, help="serial line rate (cfg::ota::BAUD)")
+    ap.add_argument("--chunk", type=int, default=4096, help="bytes per chunk (cfg::ota::CHUNK)")
+    ap.add_argument("--timeout", type=float, default=5.0, help="seconds to wait for a reply")
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    import serial  # pyserial
+    with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+        port.reset_input_buffer()
+        port.write(HEADER.pack(MAGIC, len(image), zlib.crc32(image) & 0xFFFFFFFF))
+        expect(port, b"R", args.timeout + 1.0)  # Baseline measurement runs first.
+
+        start = time.monotonic()
+        for off in range(0, len(image), args.chunk):
+            port.write(image[off:off + args.chunk])
+            expect(port, b"A", args.timeout)
+            sys.stdout.write(f"\r{min(off + args.chunk, len(image))} / {len(image)} B")
+            sys.stdout.flush()
+        expect(port, b"D", args.timeout)
+
+    secs = time.monotonic() - start
+    print(f"\ndone: {len(image)} B in {secs:.1f} s ({len(image) / secs / 1024:.1f} KB/s); device reboots when idle")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except RuntimeError as e:
+        print(f"\n{e}", file=sys.stderr)
+        sys.exit(1)
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+"""
+MIT License
+
+Decode the TelemetryStream binary format (COBS + CRC-16 frames) into CSV.
+
+@file telemetry_decode.py
+@author Little Man Builds (Darren Osborne)
+@date 2026-10-14
+@copyright Copyright (c) 2025 Little Man Builds
+
+Usage:
+    telemetry_decode.py /dev/ttyUSB0 --baud 2000000 --out run1   # live (needs pyserial)
+    telemetry_decode.py capture.bin --out run1                    # raw capture file
+
+Writes one CSV per schema (run1_telemetry.csv, run1_rc.csv, ...) and prints
+frame / CRC / sequence-gap counts on exit. Raw layouts must match the structs
+streamed by lib/TelemetryStream (keyed by schema id and payload length).
+Packed layouts (cfg::telemetry::PACKED, include/BusSchema.h) are learned
+from the descriptor frames the stream repeats, so they need no edit here.
+"""
+
+import argparse
+import csv
+import re
+import struct
+import sys
+
+# ---- Schemas (id → name, struct format, column names) ---- #
+RC_ROLES = ["steering", "direction", "speed", "indicators", "volume",
+            "power", "override", "lights", "mode", "obstacle"]
+GAP_BINS = ["lt_2.5ms", "lt_5ms", "lt_7.5ms", "lt_10ms", "lt_15ms", "lt_20ms", "lt_50ms", "lt_100ms", "more"]
+
+SCHEMAS = {
+    1: ("telemetry", "<fffff??2xQQ",
+        ["rpm", "setpoint_rpm", "duty_pct", "vbus_v", "amps", "closed_loop", "limited", "stamp_us", "origin_us"]),
+    2: ("rc", "<10f?7xQ",
+        RC_ROLES + ["failsafe", "stamp_us"]),
+    3: ("control", "<ff?BBBhhQI?3x",
+        ["throttle_cmd_pct", "steer_cmd", "horn_cmd", "indicator_cmd", "authority", "origin_src", "throttle_rate", "steer_rate", "origin_us", "stamp_ms", "lights_cmd"]),
+    4: ("rclink", "<II?3xf9III?3xI4xQ",
+        ["frames", "crc_errors", "has_crc", "rate_hz"] + ["gap_" + b for b in GAP_BINS] +
+        ["gap_max_us", "since_good_ms", "failsafe", "failsafe_entries", "stamp_us"]),
+    # cfg::numeric::FIXED_POINT builds: real_t fields are Q16.16 ("i", scaled by unpack()).
+    5: ("rc", "<10i?7xQ",
+        RC_ROLES + ["failsafe", "stamp_us"]),
+    6: ("control", "<ii?BBBhhQI?3x",
+        ["throttle_cmd_pct", "steer_cmd", "horn_cmd", "indicator_cmd", "authority", "origin_src", "throttle_rate", "steer_rate", "origin_us", "stamp_ms", "lights_cmd"]),
+}
+
+
+# ---- Packed layouts (wire::Codec, include/BusSchema.h) ---- #
+DESCRIBE_ID = 0                           # wire::kDescribeId.
+DESCRIPTOR = struct.Struct("<BIBBBH")     # id hash index count type scale, then the name.
+BIT, U8, I16, I32, U64 = range(5)         # wire::Type.
+WIDTH = {U8: 1, I16: 2, I32: 4, U64: 8}
+CODE = {U8: "B", I16: "h", I32: "i", U64: "Q"}
+
+
+def fnv(h, data):
+    """FNV-1a (32-bit) over bytes."""
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+class Packed:
+    """One wire::Fields table: name, fields [(name, type, scale)], and their offsets."""
+
+    def __init__(self, sid, table, fields):
+        self.sid, self.name, self.fields = sid, table, fields
+        self.cols = [f[0] for f in fields]
+        self.slots = []
+        at, open_byte, bit = 0, 0, 8
+        for _, kind, _ in fields:
+            if kind == BIT:
+                if bit == 8:
+                    open_byte, at, bit = at, at + 1, 0
+                self.slots.append((open_byte, bit))
+                bit += 1
+            else:
+                bit = 8
+                self.slots.append((at, 0))
+                at += WIDTH[kind]
+        self.size = at
+        self.hash = fnv(fnv(2166136261, [sid]), table.encode() + b"\0")  # wire::hash().
+        for name, kind, scale in fields:
+            self.hash = fnv(self.hash, [kind, scale & 0xFF, scale >> 8])
+            self.hash = fnv(self.hash, name.encode() + b"\0")
+
+    def unpack(self, data):
+        row = []
+        for (_, kind, scale), (at, bit) in zip(self.fields, self.slots):
+            if kind == BIT:
+                row.append((data[at] >> bit) & 1)
+                continue
+            (v,) = struct.unpack_from("<" + CODE[kind], data, at)
+            row.append(v / scale if scale != 1 else v)
+        return tuple(row)
+
+
+class Layouts:
+    """Collects descriptor frames into Packed tables (keyed by schema id; a new hash replaces the old table)."""
+
+    def __init__(self):
+        self.pending = {}  # (id, hash) → {index: (name, type, scale)}
+        self.tables = {}   # id → Packed
+        self.rejected = 0
+
+    def describe(self, payload):
+        if len(payload) < DESCRIPTOR.size:
+            self.rejected += 1
+            return
+        sid, h, index, count, kind, scale = DESCRIPTOR.unpack_from(payload)
+        name = payload[DESCRIPTOR.size:].decode("ascii", "replace")
+        known = self.tables.get(sid)
+        if known is not None and known.hash == h:
+            return  # Repeat of a table already built.
+        parts = self.pending.setdefault((sid, h), {})
+        parts[index] = (name, kind, scale)
+        if len(parts) < count + 1:
+            return
+        table = Packed(sid, parts[count][0], [parts[i] for i in range(count)])
+        del self.pending[(sid, h)]
+        if table.hash != h:
+            self.rejected += 1  # Descriptors from two builds mixed up.
+            return
+        self.tables[sid] = table
+
+    def get(self, sid, n):
+        """Packed table for a payload, or None (not described yet / length mismatch)."""
+        t = self.tables.get(sid)
+        return t if t is not None and t.size == n else None
+
+
+def unpack(fmt, data):
+    """struct.unpack, with every "i" (int32) field read as Q16.16."""
+    row = struct.unpack(fmt, data)
+    codes = [c for n, c in re.findall(r"(\d*)([a-zA-Z?])", fmt) if c != "x" for _ in range(int(n or 1))]
+    return tuple(v / 65536.0 if c == "i" else v for v, c in zip(row, codes))
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)."""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    """Decode one COBS frame (delimiter stripped); None if malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    """Splits a byte stream into frames and routes payloads to per-schema CSV writers."""
+
+    def __init__(self, prefix):
+        self.prefix = prefix
+        self.buf = bytearray()
+        self.writers = {}
+        self.files = []
+        self.frames = 0
+        self.bad = 0
+        self.unknown = 0
+        self.gaps = 0
+        self.last_seq = None
+        self.layouts = Layouts()
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            end = self.buf.find(b"\x00")
+            if end < 0:
+                return
+            raw = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if raw:
+                self.frame(raw)
+
+    def frame(self, raw):
+        body = cobs_decode(raw)
+        if body is None or len(body) < 5 or body[2] != len(body) - 5:
+            self.bad += 1
+            return
+        if crc16(body[:-2]) != (body[-2] | (body[-1] << 8)):
+            self.bad += 1
+            return
+
+        schema, seq, n = body[0], body[1], body[2]
+        if self.last_seq is not None:
+            self.gaps += (seq - self.last_seq - 1) & 0xFF  # Frames dropped on the device (TX full).
+        self.last_seq = seq
+        self.frames += 1
+
+        payload = body[3:3 + n]
+        if schema == DESCRIBE_ID:
+            self.layouts.describe(payload)
+            return
+        packed = self.layouts.get(schema, n)
+        if packed is not None:
+            self.writer((schema, packed.hash), packed.name, packed.cols).writerow(packed.unpack(payload))
+            return
+        spec = SCHEMAS.get(schema)
+        if spec is None or struct.calcsize(spec[1]) != n:
+            self.unknown += 1  # Includes packed frames seen before their descriptors.
+            return
+        name, fmt, cols = spec
+        self.writer(schema, name, cols).writerow(unpack(fmt, payload))
+
+    def writer(self, key, name, cols):
+        w = self.writers.get(key)
+        if w is None:
+            path = f"{self.prefix}_{name}.csv"
+            if any(f.name == path for f in self.files):
+                path = f"{self.prefix}_{name}_{len(self.files)}.csv"  # Second layout of one table (firmware changed mid-capture).
+            f = open(path, "w", newline="")
+            self.files.append(f)
+            w = csv.writer(f)
+            w.writerow(cols)
+            self.writers[key] = w
+        return w
+
+    def close(self):
+        for f in self.files:
+            f.close()
+        print(f"frames {self.frames}  bad {self.bad}  unknown {self.unknown}  seq gaps {self.gaps}", file=sys.stderr)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("source", help="serial port or capture file")
+    ap.add_argument("--baud", type=int, default=2000000, help="serial line rate (cfg::telemetry::BAUD)")
+    ap.add_argument("--out", default="telemetry", help="CSV file prefix")
+    args = ap.parse_args()
+
+    dec = Decoder(args.out)
+    try:
+        if args.source.startswith(("/dev/", "COM")):
+            import serial  # pyserial
+            with serial.Serial(args.source, args.baud, timeout=0.1) as port:
+                while True:
+                    dec.feed(port.read(4096))
+        else:
+            with open(args.source, "rb") as f:
+                for chunk in iter(lambda: f.read(65536), b""):
+                    dec.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        dec.close()
+
+
+if __name__ == "__main__":
+    main()